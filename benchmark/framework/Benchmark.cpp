@@ -0,0 +1,467 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file Benchmark.cpp
+
+  \brief A minimal benchmark harness shared by the TerraLib benchmark suites.
+ */
+
+// TerraLib
+#include <terralib/common/CounterRegistry.h>
+#include <terralib/common/PlatformUtils.h>
+#include "Benchmark.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  /*! \brief The summary of the repetitions of a benchmark. */
+  struct BmResult
+  {
+    std::string m_name;
+    std::string m_label;
+    std::string m_error;
+    std::string m_registry;
+    std::size_t m_iterations;
+    std::vector<double> m_nsPerIteration;
+    double m_min;
+    double m_median;
+    double m_mean;
+    double m_stddev;
+    double m_itemsPerSecond;
+    double m_bytesPerSecond;
+  };
+
+  std::vector<std::pair<std::string, BmFunction> >& GetBenchmarks()
+  {
+    static std::vector<std::pair<std::string, BmFunction> > benchmarks;
+
+    return benchmarks;
+  }
+
+  void RunOnce(const BmFunction& function, std::size_t iterations, BmState& state)
+  {
+    state = BmState(iterations);
+
+    function(state);
+
+    state.pauseTiming();
+  }
+
+  void WriteString(std::ostream& os, const std::string& s)
+  {
+    os << '"';
+
+    for(std::size_t i = 0; i < s.size(); ++i)
+    {
+      if(s[i] == '"' || s[i] == '\\')
+        os << '\\';
+
+      os << s[i];
+    }
+
+    os << '"';
+  }
+
+  BmResult Run(const std::string& name, const BmFunction& function, double minTime, std::size_t repetitions)
+  {
+    BmResult result;
+    result.m_name = name;
+    result.m_iterations = 1;
+    result.m_min = result.m_median = result.m_mean = result.m_stddev = 0.0;
+    result.m_itemsPerSecond = result.m_bytesPerSecond = 0.0;
+
+    try
+    {
+      BmState state(1);
+
+// calibrate the number of iterations of a repetition (the last calibration run is the warm-up)
+      while(true)
+      {
+        RunOnce(function, result.m_iterations, state);
+
+        const double elapsed = state.getElapsed();
+
+        if(elapsed >= minTime || result.m_iterations >= 1000000000)
+          break;
+
+        double factor = (elapsed > 1.0e-9) ? (1.4 * minTime / elapsed) : 10.0;
+
+        factor = std::min(std::max(factor, 1.5), 10.0);
+
+        result.m_iterations = static_cast<std::size_t>(std::ceil(static_cast<double>(result.m_iterations) * factor));
+      }
+
+      std::vector<BmState> states;
+
+      for(std::size_t i = 0; i < repetitions; ++i)
+      {
+        RunOnce(function, result.m_iterations, state);
+
+        states.push_back(state);
+
+        result.m_nsPerIteration.push_back(state.getElapsed() * 1.0e9 / static_cast<double>(result.m_iterations));
+      }
+
+      std::vector<double> sorted(result.m_nsPerIteration);
+      std::sort(sorted.begin(), sorted.end());
+
+      const std::size_t n = sorted.size();
+
+      result.m_min = sorted[0];
+      result.m_median = (n % 2) ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+
+      for(std::size_t i = 0; i < n; ++i)
+        result.m_mean += sorted[i];
+
+      result.m_mean /= static_cast<double>(n);
+
+      for(std::size_t i = 0; i < n; ++i)
+        result.m_stddev += (sorted[i] - result.m_mean) * (sorted[i] - result.m_mean);
+
+      result.m_stddev = (n > 1) ? std::sqrt(result.m_stddev / static_cast<double>(n - 1)) : 0.0;
+
+// the throughput of the median repetition
+      const double seconds = result.m_median * static_cast<double>(result.m_iterations) * 1.0e-9;
+
+      if(seconds > 0.0)
+      {
+        result.m_itemsPerSecond = static_cast<double>(states.back().getItemsProcessed()) / seconds;
+        result.m_bytesPerSecond = static_cast<double>(states.back().getBytesProcessed()) / seconds;
+      }
+
+      result.m_label = states.back().getLabel();
+    }
+    catch(const std::exception& e)
+    {
+      result.m_error = e.what();
+    }
+    catch(...)
+    {
+      result.m_error = "unknown error";
+    }
+
+    return result;
+  }
+
+  /*! \brief It indents the lines of a JSON document, except the first one. */
+  std::string Indent(const std::string& json, const std::string& indent)
+  {
+    std::string result;
+
+    std::size_t end = json.size();
+
+    while(end > 0 && json[end - 1] == '\n')
+      --end;
+
+    for(std::size_t i = 0; i < end; ++i)
+    {
+      result += json[i];
+
+      if(json[i] == '\n')
+        result += indent;
+    }
+
+    return result;
+  }
+
+  void WriteJSON(std::ostream& os, const std::string& suite, const std::vector<BmResult>& results,
+                 double minTime, std::size_t repetitions)
+  {
+    char date[64];
+    std::time_t now = std::time(0);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os.precision(6);
+    os << std::fixed;
+
+    os << "{\n  \"suite\": ";
+    WriteString(os, suite);
+    os << ",\n  \"date\": \"" << date << "\",\n";
+    os << "  \"processors\": " << te::common::GetPhysProcNumber() << ",\n";
+#ifdef NDEBUG
+    os << "  \"build\": \"release\",\n";
+#else
+    os << "  \"build\": \"debug\",\n";
+#endif
+    os << "  \"min_time\": " << minTime << ",\n";
+    os << "  \"repetitions\": " << repetitions << ",\n";
+    os << "  \"benchmarks\": [";
+
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+      const BmResult& r = results[i];
+
+      os << (i ? ",\n" : "\n") << "    {\n      \"name\": ";
+      WriteString(os, r.m_name);
+
+      if(!r.m_error.empty())
+      {
+        os << ",\n      \"error\": ";
+        WriteString(os, r.m_error);
+        os << "\n    }";
+        continue;
+      }
+
+      os << ",\n      \"label\": ";
+      WriteString(os, r.m_label);
+      os << ",\n      \"iterations\": " << r.m_iterations;
+      os << ",\n      \"ns_per_iteration\": { \"min\": " << r.m_min << ", \"median\": " << r.m_median
+         << ", \"mean\": " << r.m_mean << ", \"stddev\": " << r.m_stddev << " }";
+      os << ",\n      \"items_per_second\": " << r.m_itemsPerSecond;
+      os << ",\n      \"bytes_per_second\": " << r.m_bytesPerSecond;
+      os << ",\n      \"registry\": " << Indent(r.m_registry, "      ");
+      os << "\n    }";
+    }
+
+    os << (results.empty() ? "]\n" : "\n  ]\n") << "}\n";
+  }
+
+  std::string FormatTime(double ns)
+  {
+    char buffer[32];
+
+    if(ns < 1.0e3)
+      std::sprintf(buffer, "%.1f ns", ns);
+    else if(ns < 1.0e6)
+      std::sprintf(buffer, "%.2f us", ns * 1.0e-3);
+    else if(ns < 1.0e9)
+      std::sprintf(buffer, "%.2f ms", ns * 1.0e-6);
+    else
+      std::sprintf(buffer, "%.3f s", ns * 1.0e-9);
+
+    return buffer;
+  }
+}
+
+BmState::BmState(std::size_t iterations)
+  : m_iterations(iterations),
+    m_done(0),
+    m_running(false),
+    m_elapsed(0.0),
+    m_items(0),
+    m_bytes(0)
+{
+}
+
+std::size_t BmState::getIterations() const
+{
+  return m_iterations;
+}
+
+void BmState::pauseTiming()
+{
+  if(!m_running)
+    return;
+
+  m_elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+  m_running = false;
+}
+
+void BmState::resumeTiming()
+{
+  if(m_running)
+    return;
+
+  m_start = std::chrono::steady_clock::now();
+  m_running = true;
+}
+
+void BmState::setItemsProcessed(long long items)
+{
+  m_items = items;
+}
+
+void BmState::setBytesProcessed(long long bytes)
+{
+  m_bytes = bytes;
+}
+
+void BmState::setLabel(const std::string& label)
+{
+  m_label = label;
+}
+
+double BmState::getElapsed() const
+{
+  return m_elapsed;
+}
+
+long long BmState::getItemsProcessed() const
+{
+  return m_items;
+}
+
+long long BmState::getBytesProcessed() const
+{
+  return m_bytes;
+}
+
+const std::string& BmState::getLabel() const
+{
+  return m_label;
+}
+
+bool BmRegister(const std::string& name, const BmFunction& function)
+{
+  GetBenchmarks().push_back(std::make_pair(name, function));
+
+  return true;
+}
+
+void BmDoNotOptimize(const void* value)
+{
+#if defined(__GNUC__)
+  // an empty asm that reads the pointer and may touch any memory
+  __asm__ __volatile__("" : : "r"(value) : "memory");
+#else
+  static const void* volatile sink = 0;
+
+  sink = value;
+  value = sink;
+#endif
+}
+
+int BmMain(int argc, char** argv, const std::string& suite)
+{
+  std::string filter;
+  std::string output;
+  double minTime = 0.2;
+  std::size_t repetitions = 5;
+  bool list = false;
+
+  for(int i = 1; i < argc; ++i)
+  {
+    const std::string arg(argv[i]);
+
+    if(arg.compare(0, 9, "--filter=") == 0)
+      filter = arg.substr(9);
+    else if(arg.compare(0, 11, "--min-time=") == 0)
+      minTime = std::max(std::atof(arg.substr(11).c_str()), 0.0);
+    else if(arg.compare(0, 14, "--repetitions=") == 0)
+      repetitions = static_cast<std::size_t>(std::max(std::atoi(arg.substr(14).c_str()), 1));
+    else if(arg.compare(0, 9, "--output=") == 0)
+      output = arg.substr(9);
+    else if(arg == "--list")
+      list = true;
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [--filter=TEXT] [--min-time=SECONDS] [--repetitions=N] [--output=FILE] [--list]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<std::pair<std::string, BmFunction> >& benchmarks = GetBenchmarks();
+
+  std::vector<BmResult> results;
+
+  bool failed = false;
+
+  if(!list)
+  {
+    char header[256];
+    std::sprintf(header, "%-48s %14s %14s %12s", "benchmark", "time", "stddev", "iterations");
+
+    std::cerr << header << std::endl;
+  }
+
+  for(std::size_t i = 0; i < benchmarks.size(); ++i)
+  {
+    const std::string& name = benchmarks[i].first;
+
+    if(!filter.empty() && name.find(filter) == std::string::npos)
+      continue;
+
+    if(list)
+    {
+      std::cout << name << std::endl;
+      continue;
+    }
+
+    te::common::CounterRegistry::getInstance().reset();
+
+    BmResult r = Run(name, benchmarks[i].second, minTime, repetitions);
+
+// the counters and timers published by the library during the benchmark
+    r.m_registry = te::common::CounterRegistry::getInstance().toJSON();
+
+    char line[256];
+
+    if(r.m_error.empty())
+    {
+      std::sprintf(line, "%-48s %14s %14s %12lu", name.c_str(), FormatTime(r.m_median).c_str(),
+                   FormatTime(r.m_stddev).c_str(), static_cast<unsigned long>(r.m_iterations));
+
+      std::cerr << line;
+
+      if(r.m_itemsPerSecond > 0.0)
+        std::cerr << "  " << static_cast<long long>(r.m_itemsPerSecond) << " items/s";
+
+      if(r.m_bytesPerSecond > 0.0)
+        std::cerr << "  " << static_cast<long long>(r.m_bytesPerSecond / (1024.0 * 1024.0)) << " MiB/s";
+
+      if(!r.m_label.empty())
+        std::cerr << "  " << r.m_label;
+
+      std::cerr << std::endl;
+    }
+    else
+    {
+      failed = true;
+
+      std::cerr << name << ": ERROR: " << r.m_error << std::endl;
+    }
+
+    results.push_back(r);
+  }
+
+  if(list)
+    return EXIT_SUCCESS;
+
+  if(output == "-")
+  {
+    WriteJSON(std::cout, suite, results, minTime, repetitions);
+  }
+  else if(!output.empty())
+  {
+    std::ofstream file(output.c_str());
+
+    if(!file)
+    {
+      std::cerr << "Could not open the output file: " << output << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    WriteJSON(file, suite, results, minTime, repetitions);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file Benchmark.h
+
+  \brief A minimal benchmark harness shared by the TerraLib benchmark suites.
+
+  Each suite is an executable that registers its benchmarks with TE_BENCHMARK
+  and calls BmMain. The benchmark function does its setup and then runs the
+  measured code while BmState::keepRunning() returns true:
+
+  \code
+  void BmWKBRead(BmState& state)
+  {
+    std::vector<char> wkb = ...;           // not measured
+
+    while(state.keepRunning())
+      delete te::gm::WKBReader::read(&wkb[0]);
+
+    state.setItemsProcessed(state.getIterations());
+  }
+
+  TE_BENCHMARK("geometry.wkb.read", BmWKBRead);
+  \endcode
+
+  The number of iterations is calibrated so each repetition runs for a minimum
+  time, and the time per iteration of the repetitions is summarized (minimum,
+  median, mean and standard deviation). The results are printed as a table and
+  can be saved as JSON, together with the counters and timers published in the
+  te::common::CounterRegistry during the run.
+
+  Command line options:
+  <ul>
+  <li>--filter=TEXT: only runs the benchmarks whose name contains TEXT;</li>
+  <li>--min-time=SECONDS: the minimum time of a repetition (default: 0.2);</li>
+  <li>--repetitions=N: the number of repetitions (default: 5);</li>
+  <li>--output=FILE: saves the results as JSON in FILE ("-" for the standard output);</li>
+  <li>--list: lists the benchmarks.</li>
+  </ul>
+ */
+
+#ifndef __TERRALIB_BENCHMARK_INTERNAL_BENCHMARK_H
+#define __TERRALIB_BENCHMARK_INTERNAL_BENCHMARK_H
+
+// STL
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+// Boost
+#include <boost/function.hpp>
+
+/*!
+  \class BmState
+
+  \brief The state of a benchmark run: the number of iterations and the measured time.
+ */
+class BmState
+{
+  public:
+
+    /*!
+      \brief Constructor.
+
+      \param iterations The number of iterations to be run.
+     */
+    explicit BmState(std::size_t iterations);
+
+    /*!
+      \brief It returns true while there are iterations to be run.
+
+      \note The clock starts at the first call and stops when it returns false.
+     */
+    bool keepRunning()
+    {
+      if(m_done == 0 && !m_running)
+        resumeTiming();
+
+      if(m_done < m_iterations)
+      {
+        ++m_done;
+        return true;
+      }
+
+      pauseTiming();
+
+      return false;
+    }
+
+    /*! \brief It returns the number of iterations to be run. */
+    std::size_t getIterations() const;
+
+    /*! \brief It stops the clock, for per iteration setup that must not be measured. */
+    void pauseTiming();
+
+    /*! \brief It restarts the clock. */
+    void resumeTiming();
+
+    /*! \brief It sets the number of items (features, pixels, ...) processed by all the iterations. */
+    void setItemsProcessed(long long items);
+
+    /*! \brief It sets the number of bytes processed by all the iterations. */
+    void setBytesProcessed(long long bytes);
+
+    /*! \brief It sets a label describing the benchmark input. */
+    void setLabel(const std::string& label);
+
+    /*! \brief It returns the measured time, in seconds. */
+    double getElapsed() const;
+
+    long long getItemsProcessed() const;
+
+    long long getBytesProcessed() const;
+
+    const std::string& getLabel() const;
+
+  private:
+
+    std::size_t m_iterations;                             //!< The number of iterations.
+    std::size_t m_done;                                   //!< The number of iterations started.
+    bool m_running;                                       //!< True if the clock is running.
+    std::chrono::steady_clock::time_point m_start;        //!< The time the clock was started.
+    double m_elapsed;                                     //!< The measured time, in seconds.
+    long long m_items;                                    //!< The number of items processed.
+    long long m_bytes;                                    //!< The number of bytes processed.
+    std::string m_label;                                  //!< The input description.
+};
+
+/*! \brief A benchmark function. */
+typedef boost::function<void (BmState&)> BmFunction;
+
+/*!
+  \brief It registers a benchmark.
+
+  \param name     The benchmark name: dot separated, starting with the module name.
+  \param function The benchmark function.
+
+  \return Always true (used for the static registration).
+ */
+bool BmRegister(const std::string& name, const BmFunction& function);
+
+/*!
+  \brief It runs the registered benchmarks.
+
+  \param argc  The number of command line arguments.
+  \param argv  The command line arguments.
+  \param suite The suite name.
+
+  \return EXIT_SUCCESS or EXIT_FAILURE if a benchmark has thrown an exception.
+ */
+int BmMain(int argc, char** argv, const std::string& suite);
+
+/*!
+  \brief It prevents the compiler from discarding a value computed by the measured code.
+
+  \param value The value.
+ */
+void BmDoNotOptimize(const void* value);
+
+#define TE_BENCHMARK_CONCAT_IMPL(a, b) a ## b
+#define TE_BENCHMARK_CONCAT(a, b) TE_BENCHMARK_CONCAT_IMPL(a, b)
+
+/*!
+  \def TE_BENCHMARK
+
+  \brief It registers a benchmark function with the given name.
+ */
+#define TE_BENCHMARK(name, function) \
+  static const bool TE_BENCHMARK_CONCAT(bm_registered_, __LINE__) = BmRegister(name, function)
+
+#endif  // __TERRALIB_BENCHMARK_INTERNAL_BENCHMARK_H
@@ -0,0 +1,130 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file GeometryGenerator.cpp
+
+  \brief Generators of synthetic vector data for the benchmarks.
+ */
+
+// TerraLib
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/LinearRing.h>
+#include <terralib/geometry/Polygon.h>
+#include "GeometryGenerator.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+te::gm::Polygon* BmMakePolygon(std::mt19937& rng, double cx, double cy, double radius, std::size_t nVertices, int srid)
+{
+  static const double pi = 3.14159265358979323846;
+
+  nVertices = std::max<std::size_t>(nVertices, 3);
+
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> step(0.0, 0.08);
+
+// increasing angles, with some jitter
+  std::vector<double> angles(nVertices);
+
+  for(std::size_t i = 0; i < nVertices; ++i)
+    angles[i] = 2.0 * pi * (static_cast<double>(i) + 0.8 * uniform(rng)) / static_cast<double>(nVertices);
+
+  std::sort(angles.begin(), angles.end());
+
+// the distances follow a bounded random walk
+  te::gm::LinearRing* ring = new te::gm::LinearRing(nVertices + 1, te::gm::LineStringType, srid);
+
+  double r = 1.0;
+
+  for(std::size_t i = 0; i < nVertices; ++i)
+  {
+    r = std::min(std::max(r + step(rng), 0.4), 1.6);
+
+    ring->setPoint(i, cx + radius * r * std::cos(angles[i]), cy + radius * r * std::sin(angles[i]));
+  }
+
+  ring->setPoint(nVertices, ring->getX(0), ring->getY(0));
+
+  te::gm::Polygon* polygon = new te::gm::Polygon(0, te::gm::PolygonType, srid);
+  polygon->push_back(ring);
+  polygon->computeMBR(false);
+
+  return polygon;
+}
+
+void BmMakePolygons(std::size_t n, const te::gm::Envelope& extent, std::size_t nVertices, unsigned int seed,
+                    std::vector<te::gm::Geometry*>& polygons)
+{
+  std::mt19937 rng(seed);
+
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> gaussian(0.0, 1.0);
+
+  const double w = extent.getWidth();
+  const double h = extent.getHeight();
+
+// the median radius gives about one polygon per cell of a regular partition of the extent
+  const double medianRadius = 0.5 * std::sqrt(w * h / static_cast<double>(std::max<std::size_t>(n, 1)));
+
+  std::lognormal_distribution<double> size(std::log(medianRadius), 0.6);
+  std::poisson_distribution<int> vertices(static_cast<double>(std::max<std::size_t>(nVertices, 3)));
+
+// cluster centers
+  const std::size_t nClusters = 8;
+
+  std::vector<double> clusterX(nClusters);
+  std::vector<double> clusterY(nClusters);
+
+  for(std::size_t i = 0; i < nClusters; ++i)
+  {
+    clusterX[i] = extent.m_llx + w * uniform(rng);
+    clusterY[i] = extent.m_lly + h * uniform(rng);
+  }
+
+  polygons.reserve(polygons.size() + n);
+
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    double x = 0.0;
+    double y = 0.0;
+
+    if(uniform(rng) < 0.7)
+    {
+      const std::size_t c = static_cast<std::size_t>(uniform(rng) * nClusters) % nClusters;
+
+      x = clusterX[c] + 0.08 * w * gaussian(rng);
+      y = clusterY[c] + 0.08 * h * gaussian(rng);
+    }
+    else
+    {
+      x = extent.m_llx + w * uniform(rng);
+      y = extent.m_lly + h * uniform(rng);
+    }
+
+    x = std::min(std::max(x, extent.m_llx), extent.m_urx);
+    y = std::min(std::max(y, extent.m_lly), extent.m_ury);
+
+    const std::size_t nv = static_cast<std::size_t>(std::max(vertices(rng), 3));
+
+    polygons.push_back(BmMakePolygon(rng, x, y, size(rng), nv));
+  }
+}
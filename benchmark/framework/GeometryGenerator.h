@@ -0,0 +1,78 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file GeometryGenerator.h
+
+  \brief Generators of synthetic vector data for the benchmarks.
+ */
+
+#ifndef __TERRALIB_BENCHMARK_INTERNAL_GEOMETRYGENERATOR_H
+#define __TERRALIB_BENCHMARK_INTERNAL_GEOMETRYGENERATOR_H
+
+// STL
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace te
+{
+  namespace gm
+  {
+    class Envelope;
+    class Geometry;
+    class Polygon;
+  }
+}
+
+/*!
+  \brief It creates a random star shaped polygon, without self-intersections.
+
+  The vertices are placed at increasing angles around the center, at a distance
+  that follows a random walk, so the boundary looks like a digitized parcel or
+  administrative border instead of a regular polygon.
+
+  \param rng       The random number generator.
+  \param cx        The center x coordinate.
+  \param cy        The center y coordinate.
+  \param radius    The mean distance of the vertices to the center.
+  \param nVertices The number of vertices (at least 3).
+  \param srid      The polygon SRS.
+
+  \return The polygon. The caller takes its ownership.
+ */
+te::gm::Polygon* BmMakePolygon(std::mt19937& rng, double cx, double cy, double radius, std::size_t nVertices, int srid = 0);
+
+/*!
+  \brief It creates a set of random polygons.
+
+  Most polygons are grouped in clusters and the others are spread over the extent;
+  the sizes follow a log-normal distribution, so there are many small polygons,
+  some large ones, and a realistic amount of overlaps.
+
+  \param n         The number of polygons.
+  \param extent    The extent of the polygons centers.
+  \param nVertices The mean number of vertices of each polygon.
+  \param seed      The seed of the random number generator.
+  \param polygons  The polygons are appended to this vector. The caller takes their ownership.
+ */
+void BmMakePolygons(std::size_t n, const te::gm::Envelope& extent, std::size_t nVertices, unsigned int seed,
+                    std::vector<te::gm::Geometry*>& polygons);
+
+#endif  // __TERRALIB_BENCHMARK_INTERNAL_GEOMETRYGENERATOR_H
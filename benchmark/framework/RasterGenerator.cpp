@@ -0,0 +1,266 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file RasterGenerator.cpp
+
+  \brief Generators of synthetic rasters for the benchmarks.
+ */
+
+// TerraLib
+#include <terralib/datatype/Enums.h>
+#include <terralib/geometry/Envelope.h>
+#include <terralib/raster/BandProperty.h>
+#include <terralib/raster/Grid.h>
+#include <terralib/raster/Raster.h>
+#include <terralib/raster/RasterFactory.h>
+#include "RasterGenerator.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const double BmResolution = 30.0;
+
+  te::rst::Raster* MakeRaster(unsigned int nRows, unsigned int nCols, unsigned int nBands, int type, unsigned int blockSize)
+  {
+    std::vector<te::rst::BandProperty*> bands;
+
+    for(unsigned int b = 0; b < nBands; ++b)
+    {
+      te::rst::BandProperty* bp = new te::rst::BandProperty(b, type);
+
+      if(blockSize > 0)
+      {
+        bp->m_blkw = static_cast<int>(blockSize);
+        bp->m_blkh = static_cast<int>(blockSize);
+        bp->m_nblocksx = static_cast<int>((nCols + blockSize - 1) / blockSize);
+        bp->m_nblocksy = static_cast<int>((nRows + blockSize - 1) / blockSize);
+      }
+
+      bands.push_back(bp);
+    }
+
+    te::gm::Envelope* mbr = new te::gm::Envelope(0.0, 0.0, nCols * BmResolution, nRows * BmResolution);
+
+    return te::rst::RasterFactory::make("MEM", new te::rst::Grid(nCols, nRows, mbr), bands, std::map<std::string, std::string>());
+  }
+
+  /*! \brief It computes a fractal surface, in [0, 1], with the diamond-square algorithm. */
+  void DiamondSquare(unsigned int nRows, unsigned int nCols, double roughness, unsigned int seed, std::vector<double>& surface)
+  {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    unsigned int size = 1;
+
+    while(size + 1 < std::max(nRows, nCols))
+      size *= 2;
+
+    const unsigned int n = size + 1;
+
+    std::vector<double> h(static_cast<std::size_t>(n) * n, 0.0);
+
+#define TE_BM_H(r, c) h[static_cast<std::size_t>(r) * n + (c)]
+
+    TE_BM_H(0, 0) = uniform(rng);
+    TE_BM_H(0, size) = uniform(rng);
+    TE_BM_H(size, 0) = uniform(rng);
+    TE_BM_H(size, size) = uniform(rng);
+
+    double amplitude = 1.0;
+
+    for(unsigned int step = size; step > 1; step /= 2)
+    {
+      const unsigned int half = step / 2;
+
+// diamond step
+      for(unsigned int r = half; r < n; r += step)
+        for(unsigned int c = half; c < n; c += step)
+          TE_BM_H(r, c) = 0.25 * (TE_BM_H(r - half, c - half) + TE_BM_H(r - half, c + half) +
+                                  TE_BM_H(r + half, c - half) + TE_BM_H(r + half, c + half)) + amplitude * uniform(rng);
+
+// square step
+      for(unsigned int r = 0; r < n; r += half)
+      {
+        for(unsigned int c = (r / half) % 2 ? 0 : half; c < n; c += step)
+        {
+          double sum = 0.0;
+          int count = 0;
+
+          if(r >= half) { sum += TE_BM_H(r - half, c); ++count; }
+          if(r + half < n) { sum += TE_BM_H(r + half, c); ++count; }
+          if(c >= half) { sum += TE_BM_H(r, c - half); ++count; }
+          if(c + half < n) { sum += TE_BM_H(r, c + half); ++count; }
+
+          TE_BM_H(r, c) = sum / count + amplitude * uniform(rng);
+        }
+      }
+
+      amplitude *= roughness;
+    }
+
+// crop and normalize
+    surface.resize(static_cast<std::size_t>(nRows) * nCols);
+
+    for(unsigned int r = 0; r < nRows; ++r)
+      for(unsigned int c = 0; c < nCols; ++c)
+        surface[static_cast<std::size_t>(r) * nCols + c] = TE_BM_H(r, c);
+
+#undef TE_BM_H
+
+    const double minValue = *std::min_element(surface.begin(), surface.end());
+    const double maxValue = *std::max_element(surface.begin(), surface.end());
+    const double range = (maxValue > minValue) ? (maxValue - minValue) : 1.0;
+
+    for(std::size_t i = 0; i < surface.size(); ++i)
+      surface[i] = (surface[i] - minValue) / range;
+  }
+}
+
+te::rst::Raster* BmMakeFractalDEM(unsigned int nRows, unsigned int nCols, double roughness, unsigned int seed,
+                                  unsigned int blockSize)
+{
+  std::vector<double> surface;
+  DiamondSquare(nRows, nCols, roughness, seed, surface);
+
+  std::auto_ptr<te::rst::Raster> raster(MakeRaster(nRows, nCols, 1, te::dt::FLOAT_TYPE, blockSize));
+
+  for(unsigned int r = 0; r < nRows; ++r)
+    for(unsigned int c = 0; c < nCols; ++c)
+      raster->setValue(c, r, 1000.0 * surface[static_cast<std::size_t>(r) * nCols + c], 0);
+
+  return raster.release();
+}
+
+te::rst::Raster* BmMakeImage(unsigned int nRows, unsigned int nCols, unsigned int nBands, unsigned int seed,
+                             unsigned int blockSize)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> noise(0.0, 4.0);
+
+// terrain, used for the shading, and two surfaces that distort the patches borders
+  std::vector<double> terrain;
+  DiamondSquare(nRows, nCols, 0.55, seed + 1, terrain);
+
+  std::vector<double> distortionX;
+  DiamondSquare(nRows, nCols, 0.65, seed + 2, distortionX);
+
+  std::vector<double> distortionY;
+  DiamondSquare(nRows, nCols, 0.65, seed + 3, distortionY);
+
+// the land cover classes and their spectral signatures
+  const unsigned int nClasses = 8;
+
+  std::vector<std::vector<double> > signatures(nClasses, std::vector<double>(nBands));
+
+  for(unsigned int k = 0; k < nClasses; ++k)
+    for(unsigned int b = 0; b < nBands; ++b)
+      signatures[k][b] = 30.0 + 170.0 * uniform(rng);
+
+// the patches: a perturbed Voronoi partition, about one patch for each 40 x 40 pixels
+  const std::size_t nPatches = std::max<std::size_t>(4, static_cast<std::size_t>(nRows) * nCols / 1600);
+
+  std::vector<double> px(nPatches);
+  std::vector<double> py(nPatches);
+  std::vector<unsigned int> pclass(nPatches);
+
+  for(std::size_t i = 0; i < nPatches; ++i)
+  {
+    px[i] = uniform(rng) * nCols;
+    py[i] = uniform(rng) * nRows;
+    pclass[i] = static_cast<unsigned int>(uniform(rng) * nClasses) % nClasses;
+  }
+
+// the patches are binned in a grid of cells, so only the neighbor cells are searched
+  const double cellSize = 40.0;
+  const int gridCols = static_cast<int>(std::ceil(nCols / cellSize)) + 1;
+  const int gridRows = static_cast<int>(std::ceil(nRows / cellSize)) + 1;
+
+  std::vector<std::vector<std::size_t> > cells(static_cast<std::size_t>(gridCols) * gridRows);
+
+  for(std::size_t i = 0; i < nPatches; ++i)
+    cells[static_cast<std::size_t>(py[i] / cellSize) * gridCols + static_cast<std::size_t>(px[i] / cellSize)].push_back(i);
+
+  std::auto_ptr<te::rst::Raster> raster(MakeRaster(nRows, nCols, nBands, te::dt::UCHAR_TYPE, blockSize));
+
+  for(unsigned int r = 0; r < nRows; ++r)
+  {
+    for(unsigned int c = 0; c < nCols; ++c)
+    {
+      const std::size_t pos = static_cast<std::size_t>(r) * nCols + c;
+
+      const double x = c + 25.0 * (distortionX[pos] - 0.5);
+      const double y = r + 25.0 * (distortionY[pos] - 0.5);
+
+// nearest patch in the neighbor cells (growing the search if needed)
+      const int cc = std::min(std::max(static_cast<int>(x / cellSize), 0), gridCols - 1);
+      const int cr = std::min(std::max(static_cast<int>(y / cellSize), 0), gridRows - 1);
+
+      std::size_t nearest = 0;
+      double best = -1.0;
+
+      for(int radius = 1; best < 0.0 || radius <= 2; ++radius)
+      {
+        for(int gr = std::max(cr - radius, 0); gr <= std::min(cr + radius, gridRows - 1); ++gr)
+        {
+          for(int gc = std::max(cc - radius, 0); gc <= std::min(cc + radius, gridCols - 1); ++gc)
+          {
+            const std::vector<std::size_t>& cell = cells[static_cast<std::size_t>(gr) * gridCols + gc];
+
+            for(std::size_t i = 0; i < cell.size(); ++i)
+            {
+              const double d = (px[cell[i]] - x) * (px[cell[i]] - x) + (py[cell[i]] - y) * (py[cell[i]] - y);
+
+              if(best < 0.0 || d < best)
+              {
+                best = d;
+                nearest = cell[i];
+              }
+            }
+          }
+        }
+
+        if(radius > gridCols + gridRows)
+          break;
+      }
+
+// shading from the terrain slope
+      const double dzdx = terrain[static_cast<std::size_t>(r) * nCols + std::min(c + 1, nCols - 1)] - terrain[static_cast<std::size_t>(r) * nCols + (c > 0 ? c - 1 : 0)];
+      const double dzdy = terrain[static_cast<std::size_t>(std::min(r + 1, nRows - 1)) * nCols + c] - terrain[static_cast<std::size_t>(r > 0 ? r - 1 : 0) * nCols + c];
+
+      const double shade = std::min(std::max(1.0 + 8.0 * (dzdx - dzdy), 0.7), 1.3);
+
+      const std::vector<double>& signature = signatures[pclass[nearest]];
+
+      for(unsigned int b = 0; b < nBands; ++b)
+        raster->setValue(c, r, std::min(std::max(signature[b] * shade + noise(rng), 0.0), 255.0), b);
+    }
+  }
+
+  return raster.release();
+}
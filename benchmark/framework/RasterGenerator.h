@@ -0,0 +1,68 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file RasterGenerator.h
+
+  \brief Generators of synthetic rasters for the benchmarks.
+
+  The rasters are created by the in-memory driver ("MEM"). When blockSize is
+  greater than 0 the bands are tiled with square blocks of that size, otherwise
+  each band is a single block.
+ */
+
+#ifndef __TERRALIB_BENCHMARK_INTERNAL_RASTERGENERATOR_H
+#define __TERRALIB_BENCHMARK_INTERNAL_RASTERGENERATOR_H
+
+namespace te { namespace rst { class Raster; } }
+
+/*!
+  \brief It creates a fractal digital elevation model with the diamond-square algorithm.
+
+  \param nRows     The number of rows.
+  \param nCols     The number of columns.
+  \param roughness The terrain roughness, in ]0, 1[: higher values give rougher terrains.
+  \param seed      The seed of the random number generator.
+  \param blockSize The block width and height (0 for an untiled raster).
+
+  \return A single band raster of 32 bits floating point elevations, between 0 and 1000 meters,
+          with a resolution of 30 meters. The caller takes its ownership.
+ */
+te::rst::Raster* BmMakeFractalDEM(unsigned int nRows, unsigned int nCols, double roughness, unsigned int seed,
+                                  unsigned int blockSize = 0);
+
+/*!
+  \brief It creates a multi-band image of a synthetic landscape.
+
+  The landscape is a set of land cover patches with irregular borders, each one with
+  a spectral signature, modulated by the shading of a fractal terrain and by noise,
+  so it has the structure expected by the segmentation and classification algorithms.
+
+  \param nRows     The number of rows.
+  \param nCols     The number of columns.
+  \param nBands    The number of bands.
+  \param seed      The seed of the random number generator.
+  \param blockSize The block width and height (0 for an untiled raster).
+
+  \return A raster of 8 bits unsigned bands, with a resolution of 30 meters. The caller takes its ownership.
+ */
+te::rst::Raster* BmMakeImage(unsigned int nRows, unsigned int nCols, unsigned int nBands, unsigned int seed,
+                             unsigned int blockSize = 0);
+
+#endif  // __TERRALIB_BENCHMARK_INTERNAL_RASTERGENERATOR_H
@@ -0,0 +1,151 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file benchmark/geometry/BmGeometry.cpp
+
+  \brief Benchmarks of the geometry parsing and serialization (WKB and WKT).
+ */
+
+// TerraLib
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/Geometry.h>
+#include <terralib/geometry/WKBReader.h>
+#include <terralib/geometry/WKBWriter.h>
+#include <terralib/geometry/WKTReader.h>
+#include "../framework/Benchmark.h"
+#include "../framework/GeometryGenerator.h"
+
+// STL
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  /*! \brief The polygons shared by the benchmarks: 2000 polygons with 64 vertices in the mean. */
+  const std::vector<te::gm::Geometry*>& GetPolygons()
+  {
+    static std::vector<te::gm::Geometry*> polygons;
+
+    if(polygons.empty())
+      BmMakePolygons(2000, te::gm::Envelope(0.0, 0.0, 100000.0, 100000.0), 64, 42, polygons);
+
+    return polygons;
+  }
+
+  long long GetNumberOfBytes(const std::vector<std::string>& values)
+  {
+    long long n = 0;
+
+    for(std::size_t i = 0; i < values.size(); ++i)
+      n += static_cast<long long>(values[i].size());
+
+    return n;
+  }
+}
+
+void BmWKBRead(BmState& state)
+{
+  const std::vector<te::gm::Geometry*>& polygons = GetPolygons();
+
+  std::vector<std::string> wkbs(polygons.size());
+
+  for(std::size_t i = 0; i < polygons.size(); ++i)
+  {
+    wkbs[i].resize(polygons[i]->getWkbSize());
+    te::gm::WKBWriter::write(polygons[i], &wkbs[i][0]);
+  }
+
+  while(state.keepRunning())
+  {
+    for(std::size_t i = 0; i < wkbs.size(); ++i)
+      delete te::gm::WKBReader::read(wkbs[i].c_str());
+  }
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * wkbs.size()));
+  state.setBytesProcessed(static_cast<long long>(state.getIterations()) * GetNumberOfBytes(wkbs));
+  state.setLabel("2000 polygons");
+}
+
+void BmWKBWrite(BmState& state)
+{
+  const std::vector<te::gm::Geometry*>& polygons = GetPolygons();
+
+  std::vector<std::string> wkbs(polygons.size());
+
+  for(std::size_t i = 0; i < polygons.size(); ++i)
+    wkbs[i].resize(polygons[i]->getWkbSize());
+
+  while(state.keepRunning())
+  {
+    for(std::size_t i = 0; i < polygons.size(); ++i)
+      te::gm::WKBWriter::write(polygons[i], &wkbs[i][0]);
+
+    BmDoNotOptimize(&wkbs[0][0]);
+  }
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * polygons.size()));
+  state.setBytesProcessed(static_cast<long long>(state.getIterations()) * GetNumberOfBytes(wkbs));
+  state.setLabel("2000 polygons");
+}
+
+void BmWKTRead(BmState& state)
+{
+  const std::vector<te::gm::Geometry*>& polygons = GetPolygons();
+
+  std::vector<std::string> wkts(polygons.size());
+
+  for(std::size_t i = 0; i < polygons.size(); ++i)
+    wkts[i] = polygons[i]->asText();
+
+  while(state.keepRunning())
+  {
+    for(std::size_t i = 0; i < wkts.size(); ++i)
+      delete te::gm::WKTReader::read(wkts[i].c_str());
+  }
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * wkts.size()));
+  state.setBytesProcessed(static_cast<long long>(state.getIterations()) * GetNumberOfBytes(wkts));
+  state.setLabel("2000 polygons");
+}
+
+void BmWKTWrite(BmState& state)
+{
+  const std::vector<te::gm::Geometry*>& polygons = GetPolygons();
+
+  std::vector<std::string> wkts(polygons.size());
+
+  while(state.keepRunning())
+  {
+    for(std::size_t i = 0; i < polygons.size(); ++i)
+      wkts[i] = polygons[i]->asText();
+
+    BmDoNotOptimize(&wkts[0]);
+  }
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * polygons.size()));
+  state.setBytesProcessed(static_cast<long long>(state.getIterations()) * GetNumberOfBytes(wkts));
+  state.setLabel("2000 polygons");
+}
+
+TE_BENCHMARK("geometry.wkb.read", BmWKBRead);
+TE_BENCHMARK("geometry.wkb.write", BmWKBWrite);
+TE_BENCHMARK("geometry.wkt.read", BmWKTRead);
+TE_BENCHMARK("geometry.wkt.write", BmWKTWrite);
@@ -0,0 +1,133 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file benchmark/maptools/BmRendering.cpp
+
+  \brief Benchmarks of the map rendering: geometry drawing on a Qt canvas and generalization.
+ */
+
+// TerraLib
+#include <terralib/color/RGBAColor.h>
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/Geometry.h>
+#include <terralib/maptools/Utils.h>
+#include <terralib/qt/widgets/canvas/Canvas.h>
+#include "../framework/Benchmark.h"
+#include "../framework/GeometryGenerator.h"
+
+// STL
+#include <memory>
+#include <vector>
+
+namespace
+{
+  const te::gm::Envelope BmExtent(0.0, 0.0, 100000.0, 100000.0);
+  const int BmCanvasSize = 1024;
+
+  /*! \brief 5000 polygons with 256 vertices in the mean: many more vertices than pixels. */
+  const std::vector<te::gm::Geometry*>& GetPolygons()
+  {
+    static std::vector<te::gm::Geometry*> polygons;
+
+    if(polygons.empty())
+      BmMakePolygons(5000, BmExtent, 256, 21, polygons);
+
+    return polygons;
+  }
+
+  void Draw(BmState& state, bool generalize)
+  {
+    const std::vector<te::gm::Geometry*>& polygons = GetPolygons();
+
+    te::qt::widgets::Canvas canvas(BmCanvasSize, BmCanvasSize, QInternal::Image);
+    canvas.setWindow(BmExtent.m_llx, BmExtent.m_lly, BmExtent.m_urx, BmExtent.m_ury);
+    canvas.setPolygonFillColor(te::color::RGBAColor(120, 180, 90, 255));
+    canvas.setPolygonContourColor(te::color::RGBAColor(40, 40, 40, 255));
+
+    const double pixelSize = BmExtent.getWidth() / BmCanvasSize;
+
+    while(state.keepRunning())
+    {
+      canvas.clear();
+
+      for(std::size_t i = 0; i < polygons.size(); ++i)
+      {
+        if(!generalize)
+        {
+          canvas.draw(polygons[i]);
+          continue;
+        }
+
+// the renderer generalizes a copy of each geometry read from the data set
+        std::auto_ptr<te::gm::Geometry> g(static_cast<te::gm::Geometry*>(polygons[i]->clone()));
+        te::map::GeneralizeGeometry(g.get(), BmExtent.m_llx, BmExtent.m_lly, pixelSize);
+        canvas.draw(g.get());
+      }
+    }
+
+    state.setItemsProcessed(static_cast<long long>(state.getIterations() * polygons.size()));
+    state.setLabel("5000 polygons on a 1024 x 1024 image");
+  }
+}
+
+void BmDrawPolygons(BmState& state)
+{
+  Draw(state, false);
+}
+
+void BmDrawGeneralizedPolygons(BmState& state)
+{
+  Draw(state, true);
+}
+
+void BmGeneralize(BmState& state)
+{
+  const std::vector<te::gm::Geometry*>& polygons = GetPolygons();
+
+  const double pixelSize = BmExtent.getWidth() / BmCanvasSize;
+
+  std::vector<te::gm::Geometry*> copies(polygons.size(), 0);
+
+  while(state.keepRunning())
+  {
+    state.pauseTiming();
+
+    for(std::size_t i = 0; i < polygons.size(); ++i)
+    {
+      delete copies[i];
+      copies[i] = static_cast<te::gm::Geometry*>(polygons[i]->clone());
+    }
+
+    state.resumeTiming();
+
+    for(std::size_t i = 0; i < copies.size(); ++i)
+      te::map::GeneralizeGeometry(copies[i], BmExtent.m_llx, BmExtent.m_lly, pixelSize);
+  }
+
+  for(std::size_t i = 0; i < copies.size(); ++i)
+    delete copies[i];
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * polygons.size()));
+  state.setLabel("5000 polygons, cells of one pixel of a 1024 x 1024 image");
+}
+
+TE_BENCHMARK("maptools.draw.polygons", BmDrawPolygons);
+TE_BENCHMARK("maptools.draw.polygons.generalized", BmDrawGeneralizedPolygons);
+TE_BENCHMARK("maptools.generalize", BmGeneralize);
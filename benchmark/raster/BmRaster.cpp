@@ -0,0 +1,250 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file benchmark/raster/BmRaster.cpp
+
+  \brief Benchmarks of the raster block I/O, pixel access and interpolation.
+ */
+
+// TerraLib
+#include <terralib/memory/CachedRaster.h>
+#include <terralib/raster/Band.h>
+#include <terralib/raster/BandProperty.h>
+#include <terralib/raster/Enums.h>
+#include <terralib/raster/Interpolator.h>
+#include <terralib/raster/Raster.h>
+#include "../framework/Benchmark.h"
+#include "../framework/RasterGenerator.h"
+
+// STL
+#include <algorithm>
+#include <complex>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+  const unsigned int BmRasterSize = 2048;
+  const unsigned int BmBlockSize = 256;
+
+  /*! \brief A 2048 x 2048 fractal DEM, untiled (blocks of one line) or tiled (256 x 256 blocks). */
+  te::rst::Raster* GetDEM(bool tiled)
+  {
+    static std::auto_ptr<te::rst::Raster> untiledDEM;
+    static std::auto_ptr<te::rst::Raster> tiledDEM;
+
+    std::auto_ptr<te::rst::Raster>& dem = tiled ? tiledDEM : untiledDEM;
+
+    if(dem.get() == 0)
+      dem.reset(BmMakeFractalDEM(BmRasterSize, BmRasterSize, 0.55, 3, tiled ? BmBlockSize : 0));
+
+    return dem.get();
+  }
+
+  void BlockRead(BmState& state, bool tiled)
+  {
+    te::rst::Band* band = GetDEM(tiled)->getBand(0);
+    const te::rst::BandProperty* prop = band->getProperty();
+
+    std::vector<unsigned char> buffer(band->getBlockSize());
+
+    while(state.keepRunning())
+    {
+      for(int y = 0; y < prop->m_nblocksy; ++y)
+        for(int x = 0; x < prop->m_nblocksx; ++x)
+          band->read(x, y, &buffer[0]);
+
+      BmDoNotOptimize(&buffer[0]);
+    }
+
+    const long long nblocks = static_cast<long long>(prop->m_nblocksx) * prop->m_nblocksy;
+
+    state.setItemsProcessed(static_cast<long long>(state.getIterations()) * nblocks);
+    state.setBytesProcessed(static_cast<long long>(state.getIterations()) * nblocks * band->getBlockSize());
+  }
+
+  void BlockWrite(BmState& state, bool tiled)
+  {
+    te::rst::Band* band = GetDEM(tiled)->getBand(0);
+    const te::rst::BandProperty* prop = band->getProperty();
+
+    std::vector<unsigned char> buffer(band->getBlockSize());
+
+    while(state.keepRunning())
+    {
+      for(int y = 0; y < prop->m_nblocksy; ++y)
+      {
+        for(int x = 0; x < prop->m_nblocksx; ++x)
+        {
+          band->read(x, y, &buffer[0]);
+          band->write(x, y, &buffer[0]);
+        }
+      }
+    }
+
+    const long long nblocks = static_cast<long long>(prop->m_nblocksx) * prop->m_nblocksy;
+
+    state.setItemsProcessed(static_cast<long long>(state.getIterations()) * nblocks);
+    state.setBytesProcessed(static_cast<long long>(state.getIterations()) * nblocks * band->getBlockSize());
+  }
+
+  void Interpolate(BmState& state, int method)
+  {
+    te::rst::Raster* dem = GetDEM(true);
+
+    te::rst::Interpolator interpolator(dem, method);
+
+// random positions, each one near the previous, as in a reprojection
+    std::vector<std::pair<double, double> > positions;
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> step(-2.0, 2.0);
+
+    double c = 0.5 * BmRasterSize;
+    double r = 0.5 * BmRasterSize;
+
+    for(std::size_t i = 0; i < 100000; ++i)
+    {
+      c = std::min(std::max(c + step(rng), 2.0), BmRasterSize - 3.0);
+      r = std::min(std::max(r + step(rng), 2.0), BmRasterSize - 3.0);
+      positions.push_back(std::make_pair(c, r));
+    }
+
+    std::complex<double> value;
+    double sum = 0.0;
+
+    while(state.keepRunning())
+    {
+      for(std::size_t i = 0; i < positions.size(); ++i)
+      {
+        interpolator.getValue(positions[i].first, positions[i].second, value, 0);
+        sum += value.real();
+      }
+    }
+
+    BmDoNotOptimize(&sum);
+
+    state.setItemsProcessed(static_cast<long long>(state.getIterations() * positions.size()));
+    state.setLabel("100000 positions");
+  }
+}
+
+void BmBlockReadUntiled(BmState& state)
+{
+  BlockRead(state, false);
+  state.setLabel("2048 x 2048 float32, blocks of one line");
+}
+
+void BmBlockReadTiled(BmState& state)
+{
+  BlockRead(state, true);
+  state.setLabel("2048 x 2048 float32, 256 x 256 blocks");
+}
+
+void BmBlockWriteUntiled(BmState& state)
+{
+  BlockWrite(state, false);
+  state.setLabel("2048 x 2048 float32, blocks of one line");
+}
+
+void BmBlockWriteTiled(BmState& state)
+{
+  BlockWrite(state, true);
+  state.setLabel("2048 x 2048 float32, 256 x 256 blocks");
+}
+
+void BmGetValue(BmState& state)
+{
+  te::rst::Raster* dem = GetDEM(true);
+
+  double value = 0.0;
+  double sum = 0.0;
+
+  while(state.keepRunning())
+  {
+    for(unsigned int r = 0; r < BmRasterSize; ++r)
+    {
+      for(unsigned int c = 0; c < BmRasterSize; ++c)
+      {
+        dem->getValue(c, r, value, 0);
+        sum += value;
+      }
+    }
+  }
+
+  BmDoNotOptimize(&sum);
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations()) * BmRasterSize * BmRasterSize);
+  state.setLabel("2048 x 2048 float32, 256 x 256 blocks");
+}
+
+void BmCachedRasterGetValue(BmState& state)
+{
+  te::rst::Raster* dem = GetDEM(true);
+
+// a cache of one row of blocks: a row major scan reads each block once
+  te::mem::CachedRaster cached(BmRasterSize / BmBlockSize + 1, *dem, 0);
+
+  double value = 0.0;
+  double sum = 0.0;
+
+  while(state.keepRunning())
+  {
+    for(unsigned int r = 0; r < BmRasterSize; ++r)
+    {
+      for(unsigned int c = 0; c < BmRasterSize; ++c)
+      {
+        cached.getValue(c, r, value, 0);
+        sum += value;
+      }
+    }
+  }
+
+  BmDoNotOptimize(&sum);
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations()) * BmRasterSize * BmRasterSize);
+  state.setLabel("2048 x 2048 float32, 256 x 256 blocks");
+}
+
+void BmInterpolatorNearest(BmState& state)
+{
+  Interpolate(state, te::rst::NearestNeighbor);
+}
+
+void BmInterpolatorBilinear(BmState& state)
+{
+  Interpolate(state, te::rst::Bilinear);
+}
+
+void BmInterpolatorBicubic(BmState& state)
+{
+  Interpolate(state, te::rst::Bicubic);
+}
+
+TE_BENCHMARK("raster.block.read.untiled", BmBlockReadUntiled);
+TE_BENCHMARK("raster.block.read.tiled", BmBlockReadTiled);
+TE_BENCHMARK("raster.block.write.untiled", BmBlockWriteUntiled);
+TE_BENCHMARK("raster.block.write.tiled", BmBlockWriteTiled);
+TE_BENCHMARK("raster.getvalue", BmGetValue);
+TE_BENCHMARK("raster.cachedraster.getvalue", BmCachedRasterGetValue);
+TE_BENCHMARK("raster.interpolator.nearest", BmInterpolatorNearest);
+TE_BENCHMARK("raster.interpolator.bilinear", BmInterpolatorBilinear);
+TE_BENCHMARK("raster.interpolator.bicubic", BmInterpolatorBicubic);
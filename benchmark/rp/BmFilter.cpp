@@ -0,0 +1,112 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file benchmark/rp/BmFilter.cpp
+
+  \brief Benchmarks of the image filters.
+ */
+
+// TerraLib
+#include <terralib/common/Exception.h>
+#include <terralib/raster/Raster.h>
+#include <terralib/rp/Filter.h>
+#include "../framework/Benchmark.h"
+#include "../framework/RasterGenerator.h"
+
+// STL
+#include <memory>
+#include <string>
+
+namespace
+{
+  const unsigned int BmImageSize = 1024;
+
+  /*! \brief A 1024 x 1024 image with 3 bands and 256 x 256 blocks. */
+  te::rst::Raster* GetImage()
+  {
+    static std::auto_ptr<te::rst::Raster> image;
+
+    if(image.get() == 0)
+      image.reset(BmMakeImage(BmImageSize, BmImageSize, 3, 17, 256));
+
+    return image.get();
+  }
+
+  void ApplyFilter(BmState& state, te::rp::Filter::InputParameters::FilterType filterType,
+                   bool threaded)
+  {
+    te::rp::Filter::InputParameters inputParameters;
+    inputParameters.m_filterType = filterType;
+    inputParameters.m_inRasterPtr = GetImage();
+    inputParameters.m_inRasterBands.push_back(0);
+    inputParameters.m_inRasterBands.push_back(1);
+    inputParameters.m_inRasterBands.push_back(2);
+    inputParameters.m_windowH = 5;
+    inputParameters.m_windowW = 5;
+    inputParameters.m_enableProgress = false;
+    inputParameters.m_enableMultiThread = threaded;
+
+    while(state.keepRunning())
+    {
+      te::rp::Filter::OutputParameters outputParameters;
+      outputParameters.m_rType = "MEM";
+
+      te::rp::Filter filter;
+
+      if(!filter.initialize(inputParameters) || !filter.execute(outputParameters))
+        throw te::common::Exception("The filtering has failed.");
+
+      state.pauseTiming();   // the output raster destruction is not measured
+      outputParameters.m_outputRasterPtr.reset();
+      state.resumeTiming();
+    }
+
+    state.setItemsProcessed(static_cast<long long>(state.getIterations()) * BmImageSize * BmImageSize);
+  }
+}
+
+void BmFilterMeanSerial(BmState& state)
+{
+  ApplyFilter(state, te::rp::Filter::InputParameters::MeanFilterT, false);
+  state.setLabel("1024 x 1024 x 3 uchar, 5 x 5 window, one thread");
+}
+
+void BmFilterMeanThreaded(BmState& state)
+{
+  ApplyFilter(state, te::rp::Filter::InputParameters::MeanFilterT, true);
+  state.setLabel("1024 x 1024 x 3 uchar, 5 x 5 window, all processors");
+}
+
+void BmFilterMedianSerial(BmState& state)
+{
+  ApplyFilter(state, te::rp::Filter::InputParameters::MedianFilterT, false);
+  state.setLabel("1024 x 1024 x 3 uchar, 5 x 5 window, one thread");
+}
+
+void BmFilterMedianThreaded(BmState& state)
+{
+  ApplyFilter(state, te::rp::Filter::InputParameters::MedianFilterT, true);
+  state.setLabel("1024 x 1024 x 3 uchar, 5 x 5 window, all processors");
+}
+
+TE_BENCHMARK("rp.filter.mean.serial", BmFilterMeanSerial);
+TE_BENCHMARK("rp.filter.mean.threaded", BmFilterMeanThreaded);
+TE_BENCHMARK("rp.filter.median.serial", BmFilterMedianSerial);
+TE_BENCHMARK("rp.filter.median.threaded", BmFilterMedianThreaded);
@@ -0,0 +1,112 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file benchmark/rp/BmSegmenter.cpp
+
+  \brief Benchmarks of the region growing segmentation.
+ */
+
+// TerraLib
+#include <terralib/common/Exception.h>
+#include <terralib/raster/Raster.h>
+#include <terralib/rp/Segmenter.h>
+#include <terralib/rp/SegmenterRegionGrowingMeanStrategy.h>
+#include "../framework/Benchmark.h"
+#include "../framework/RasterGenerator.h"
+
+// STL
+#include <memory>
+#include <string>
+
+namespace
+{
+  const unsigned int BmImageSize = 512;
+
+  /*! \brief A 512 x 512 image with 3 bands. */
+  te::rst::Raster* GetImage()
+  {
+    static std::auto_ptr<te::rst::Raster> image;
+
+    if(image.get() == 0)
+      image.reset(BmMakeImage(BmImageSize, BmImageSize, 3, 11));
+
+    return image.get();
+  }
+
+  void Segment(BmState& state, bool threaded, bool blocks)
+  {
+    te::rp::SegmenterRegionGrowingMeanStrategy::Parameters strategyParameters;
+    strategyParameters.m_minSegmentSize = 20;
+    strategyParameters.m_segmentsSimilarityThreshold = 0.1;
+
+    te::rp::Segmenter::InputParameters inputParameters;
+    inputParameters.m_inputRasterPtr = GetImage();
+    inputParameters.m_inputRasterBands.push_back(0);
+    inputParameters.m_inputRasterBands.push_back(1);
+    inputParameters.m_inputRasterBands.push_back(2);
+    inputParameters.m_enableThreadedProcessing = threaded;
+    inputParameters.m_maxSegThreads = 0;
+    inputParameters.m_enableBlockProcessing = blocks;
+    inputParameters.m_blocksOverlapPercent = blocks ? 10 : 0;
+    inputParameters.m_maxBlockSize = blocks ? 128 : 0;
+    inputParameters.m_strategyName = "RegionGrowingMean";
+    inputParameters.setSegStrategyParams(strategyParameters);
+    inputParameters.m_enableProgress = false;
+
+    while(state.keepRunning())
+    {
+      te::rp::Segmenter::OutputParameters outputParameters;
+      outputParameters.m_rType = "MEM";
+
+      te::rp::Segmenter segmenter;
+
+      if(!segmenter.initialize(inputParameters) || !segmenter.execute(outputParameters))
+        throw te::common::Exception("The segmentation has failed.");
+
+      state.pauseTiming();   // the output raster destruction is not measured
+      outputParameters.m_outputRasterPtr.reset();
+      state.resumeTiming();
+    }
+
+    state.setItemsProcessed(static_cast<long long>(state.getIterations()) * BmImageSize * BmImageSize);
+  }
+}
+
+void BmSegmenterSerial(BmState& state)
+{
+  Segment(state, false, false);
+  state.setLabel("512 x 512 x 3 uchar, one block, one thread");
+}
+
+void BmSegmenterBlocksSerial(BmState& state)
+{
+  Segment(state, false, true);
+  state.setLabel("512 x 512 x 3 uchar, 128 x 128 blocks, one thread");
+}
+
+void BmSegmenterBlocksThreaded(BmState& state)
+{
+  Segment(state, true, true);
+  state.setLabel("512 x 512 x 3 uchar, 128 x 128 blocks, all processors");
+}
+
+TE_BENCHMARK("rp.segmenter.regiongrowing.serial", BmSegmenterSerial);
+TE_BENCHMARK("rp.segmenter.regiongrowing.blocks.serial", BmSegmenterBlocksSerial);
+TE_BENCHMARK("rp.segmenter.regiongrowing.blocks.threaded", BmSegmenterBlocksThreaded);
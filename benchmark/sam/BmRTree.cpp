@@ -0,0 +1,136 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file benchmark/sam/BmRTree.cpp
+
+  \brief Benchmarks of the R-tree construction and window queries.
+ */
+
+// TerraLib
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/Geometry.h>
+#include <terralib/sam/rtree/Index.h>
+#include "../framework/Benchmark.h"
+#include "../framework/GeometryGenerator.h"
+
+// STL
+#include <random>
+#include <vector>
+
+namespace
+{
+  const te::gm::Envelope BmExtent(0.0, 0.0, 100000.0, 100000.0);
+
+  /*! \brief The boxes of 50000 polygons. */
+  const std::vector<te::gm::Envelope>& GetBoxes()
+  {
+    static std::vector<te::gm::Envelope> boxes;
+
+    if(boxes.empty())
+    {
+      std::vector<te::gm::Geometry*> polygons;
+      BmMakePolygons(50000, BmExtent, 16, 7, polygons);
+
+      for(std::size_t i = 0; i < polygons.size(); ++i)
+      {
+        boxes.push_back(*polygons[i]->getMBR());
+        delete polygons[i];
+      }
+    }
+
+    return boxes;
+  }
+
+  /*! \brief Query windows covering about 0.01% of the extent, with the same distribution of the data. */
+  void MakeWindows(std::size_t n, std::vector<te::gm::Envelope>& windows)
+  {
+    const std::vector<te::gm::Envelope>& boxes = GetBoxes();
+
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<std::size_t> pick(0, boxes.size() - 1);
+
+    const double half = 0.005 * BmExtent.getWidth();
+
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      const te::gm::Envelope& b = boxes[pick(rng)];
+
+      const double x = 0.5 * (b.m_llx + b.m_urx);
+      const double y = 0.5 * (b.m_lly + b.m_ury);
+
+      windows.push_back(te::gm::Envelope(x - half, y - half, x + half, y + half));
+    }
+  }
+}
+
+void BmRTreeBuild(BmState& state)
+{
+  const std::vector<te::gm::Envelope>& boxes = GetBoxes();
+
+  while(state.keepRunning())
+  {
+    state.resumeTiming();
+
+    te::sam::rtree::Index<std::size_t, 8> index;
+
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+      index.insert(boxes[i], i);
+
+    state.pauseTiming();   // the index destruction is not measured
+  }
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * boxes.size()));
+  state.setLabel("50000 boxes");
+}
+
+void BmRTreeQuery(BmState& state)
+{
+  const std::vector<te::gm::Envelope>& boxes = GetBoxes();
+
+  te::sam::rtree::Index<std::size_t, 8> index;
+
+  for(std::size_t i = 0; i < boxes.size(); ++i)
+    index.insert(boxes[i], i);
+
+  std::vector<te::gm::Envelope> windows;
+  MakeWindows(1000, windows);
+
+  std::vector<std::size_t> report;
+
+  long long found = 0;
+
+  while(state.keepRunning())
+  {
+    for(std::size_t i = 0; i < windows.size(); ++i)
+    {
+      report.clear();
+      index.search(windows[i], report);
+      found += static_cast<long long>(report.size());
+    }
+  }
+
+  BmDoNotOptimize(&found);
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * windows.size()));
+  state.setLabel("1000 windows on 50000 boxes");
+}
+
+TE_BENCHMARK("sam.rtree.build", BmRTreeBuild);
+TE_BENCHMARK("sam.rtree.query", BmRTreeQuery);
@@ -0,0 +1,122 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file benchmark/vp/BmOverlay.cpp
+
+  \brief Benchmarks of the geometric kernels of the overlay operations.
+
+  The vector processing operations read and write data sources, so these
+  benchmarks measure the parts that dominate their time on in-memory
+  geometries: the candidate pairs search and the pairwise intersection of
+  the intersection operation, and the cascaded union of the dissolve.
+ */
+
+// TerraLib
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/Geometry.h>
+#include <terralib/sam/rtree/Index.h>
+#include <terralib/vp/Utils.h>
+#include "../framework/Benchmark.h"
+#include "../framework/GeometryGenerator.h"
+
+// STL
+#include <memory>
+#include <vector>
+
+namespace
+{
+  const te::gm::Envelope BmExtent(0.0, 0.0, 100000.0, 100000.0);
+
+  const std::vector<te::gm::Geometry*>& GetLayer(int layer)
+  {
+    static std::vector<te::gm::Geometry*> layers[2];
+
+    if(layers[layer].empty())
+      BmMakePolygons(1000, BmExtent, 32, 100 + layer, layers[layer]);
+
+    return layers[layer];
+  }
+}
+
+void BmIntersection(BmState& state)
+{
+  const std::vector<te::gm::Geometry*>& first = GetLayer(0);
+  const std::vector<te::gm::Geometry*>& second = GetLayer(1);
+
+  long long nresults = 0;
+
+  while(state.keepRunning())
+  {
+    te::sam::rtree::Index<std::size_t, 8> index;
+
+    for(std::size_t i = 0; i < second.size(); ++i)
+      index.insert(*second[i]->getMBR(), i);
+
+    std::vector<std::size_t> candidates;
+
+    for(std::size_t i = 0; i < first.size(); ++i)
+    {
+      candidates.clear();
+      index.search(*first[i]->getMBR(), candidates);
+
+      for(std::size_t j = 0; j < candidates.size(); ++j)
+      {
+        const te::gm::Geometry* other = second[candidates[j]];
+
+        if(!first[i]->intersects(other))
+          continue;
+
+        std::auto_ptr<te::gm::Geometry> result(first[i]->intersection(other));
+        ++nresults;
+      }
+    }
+  }
+
+  BmDoNotOptimize(&nresults);
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * first.size()));
+  state.setLabel("1000 x 1000 polygons");
+}
+
+void BmCascadedUnion(BmState& state)
+{
+  const std::vector<te::gm::Geometry*>& polygons = GetLayer(0);
+
+  std::vector<te::gm::Geometry*> geoms;
+
+  while(state.keepRunning())
+  {
+// the union takes the ownership of the operands, so they are cloned without measuring
+    state.pauseTiming();
+
+    for(std::size_t i = 0; i < polygons.size(); ++i)
+      geoms.push_back(static_cast<te::gm::Geometry*>(polygons[i]->clone()));
+
+    state.resumeTiming();
+
+    std::auto_ptr<te::gm::Geometry> result(te::vp::GetCascadedUnion(geoms));
+  }
+
+  state.setItemsProcessed(static_cast<long long>(state.getIterations() * polygons.size()));
+  state.setLabel("1000 polygons");
+}
+
+TE_BENCHMARK("vp.intersection", BmIntersection);
+TE_BENCHMARK("vp.cascadedunion", BmCascadedUnion);
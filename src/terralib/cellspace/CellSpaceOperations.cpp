@@ -24,6 +24,7 @@
 */
 
 // Terralib
+#include "../common/PlatformUtils.h"
 #include "../common/progress/TaskProgress.h"
 #include "../dataaccess.h"
 #include "../datatype/SimpleProperty.h"
@@ -38,12 +39,38 @@
 #include "../raster.h"
 #include "../sam.h"
 #include "CellSpaceOperations.h"
+#include "ScanlineMask.h"
 
 #include <stdio.h>
 
+// STL
+#include <algorithm>
+
+// Boost
+#include <boost/thread.hpp>
+
 const int BLOCKSIZE = 10000;
 
+te::cellspace::CellularSpacesOperations::RowBandsJobT::RowBandsJobT()
+  : m_source(0),
+    m_dataSetType(0),
+    m_mask(0),
+    m_resX(0),
+    m_resY(0),
+    m_maxcols(0),
+    m_maxrows(0),
+    m_bandRows(1),
+    m_srid(0),
+    m_type(CELLSPACE_POLYGONS),
+    m_nextRow(0),
+    m_abort(false),
+    m_task(0)
+{
+}
+
 te::cellspace::CellularSpacesOperations::CellularSpacesOperations()
+  : m_scanline(false),
+    m_threadsNumber(0)
 {
 }
 
@@ -65,11 +92,9 @@ void te::cellspace::CellularSpacesOperations::createCellSpace(te::da::DataSource
       maxrows = (int)ceil((env.m_ury-env.m_lly)/resY);
 
   bool useMask = false;
-  std::auto_ptr<te::da::DataSet> refDs;
   if(layerBase.get())
   {
-    refDs = layerBase->getData();
-    useMask=true;
+    useMask = true;
 
     if (layerBase->getSchema()->hasRaster())
     {
@@ -79,23 +104,79 @@ void te::cellspace::CellularSpacesOperations::createCellSpace(te::da::DataSource
 
   std::auto_ptr<te::da::DataSetType> outputDataSetType(createCellularDataSetType(name, srid, type));
 
+  std::map<std::string, std::string> options;
+
+  if(m_scanline)
+  {
+    std::auto_ptr<ScanlineMask> mask;
+    if(useMask)
+      mask.reset(getScanlineMask(layerBase, env, resX, resY));
+
+    if(!useMask || mask.get())
+    {
+      std::unique_ptr<te::da::DataSource> source = te::da::DataSourceFactory::make(outputSource->getAccessDriver(), outputSource->getConnInfo());
+      source->open();
+
+      source->createDataSet(outputDataSetType.get(), options);
+
+      te::common::TaskProgress task("Processing Cellular Spaces...");
+      task.setTotalSteps(maxrows);
+      task.useTimer(true);
+      task.useMultiThread(true);
+
+      RowBandsJobT job;
+      job.m_source = source.get();
+      job.m_dataSetType = outputDataSetType.get();
+      job.m_mask = mask.get();
+      job.m_env = env;
+      job.m_resX = resX;
+      job.m_resY = resY;
+      job.m_maxcols = maxcols;
+      job.m_maxrows = maxrows;
+      job.m_bandRows = std::max(1, BLOCKSIZE / std::max(1, maxcols));
+      job.m_srid = srid;
+      job.m_type = type;
+      job.m_task = &task;
+
+      std::size_t threadsNumber = m_threadsNumber ? m_threadsNumber : std::max<std::size_t>(1, te::common::GetPhysProcNumber());
+
+      boost::thread_group threads;
+
+      for(std::size_t i = 0; i < threadsNumber; ++i)
+        threads.add_thread(new boost::thread(createRowBandsThreadEntry, this, &job));
+
+      threads.join_all();
+
+      source->close();
+
+      if(!job.m_errorMessage.empty())
+        throw te::common::Exception(job.m_errorMessage);
+
+      return;
+    }
+  }
+
+  std::auto_ptr<te::da::DataSet> refDs;
   std::auto_ptr<te::sam::rtree::Index<size_t, 8> > rtree;
   if(useMask)
+  {
+    refDs = layerBase->getData();
     rtree.reset(getRtree(layerBase));
+  }
 
   te::common::TaskProgress task("Processing Cellular Spaces...");
   task.setTotalSteps(maxrows);
   task.useTimer(true);
 
-  te::mem::DataSet* outputDataSet = new te::mem::DataSet(outputDataSetType.get());
+  std::auto_ptr<te::mem::DataSet> outputDataSet(new te::mem::DataSet(outputDataSetType.get()));
 
   // Output
   std::unique_ptr<te::da::DataSource> source = te::da::DataSourceFactory::make(outputSource->getAccessDriver(), outputSource->getConnInfo());
   source->open();
 
-  std::map<std::string, std::string> options;
+  source->createDataSet(outputDataSetType.get(), options);
 
-  std::size_t count = 0;
+  std::size_t geomPos = useMask ? te::da::GetFirstSpatialPropertyPos(refDs.get()) : 0;
 
   double x, y;
   for(int lin = 0; lin < maxrows; ++lin)
@@ -110,17 +191,17 @@ void te::cellspace::CellularSpacesOperations::createCellSpace(te::da::DataSource
     {
       x = env.m_llx+(col*resX);
 
-      te::gm::Envelope* env = new te::gm::Envelope(x, y, x+resX, y+resY);
+      te::gm::Envelope cellEnv(x, y, x+resX, y+resY);
 
       std::auto_ptr<te::gm::Geometry> geom;
       if(type == CELLSPACE_POLYGONS)
       {
-        geom.reset(te::gm::GetGeomFromEnvelope(env, srid));
+        geom.reset(te::gm::GetGeomFromEnvelope(&cellEnv, srid));
       }
       else if(type == CELLSPACE_POINTS)
       {
-        double pX = env->m_llx +( (env->m_urx - env->m_llx) / 2);
-        double pY = env->m_lly +( (env->m_ury - env->m_lly) / 2);
+        double pX = cellEnv.m_llx +( (cellEnv.m_urx - cellEnv.m_llx) / 2);
+        double pY = cellEnv.m_lly +( (cellEnv.m_ury - cellEnv.m_lly) / 2);
         geom.reset(new te::gm::Point(pX, pY, srid));
       }
       
@@ -129,63 +210,198 @@ void te::cellspace::CellularSpacesOperations::createCellSpace(te::da::DataSource
         std::vector<size_t> report;
         rtree->search(*geom->getMBR(), report);
 
-        std::size_t geomPos = te::da::GetFirstSpatialPropertyPos(refDs.get());
-
-        if(!report.empty())
+        for(std::size_t i = 0; i < report.size(); ++i)
         {
-          for(std::size_t i = 0; i < report.size(); ++i)
-          {
-            refDs->move(report[i]);
+          refDs->move(report[i]);
 
-            std::auto_ptr<te::gm::Geometry> g = refDs->getGeometry(geomPos);
-            g->setSRID(srid);
+          std::auto_ptr<te::gm::Geometry> g = refDs->getGeometry(geomPos);
+          g->setSRID(srid);
 
-            if(geom->intersects(g.get()))
-            {
-              addCell(outputDataSet, col, lin, geom.release());
-              break;
-            }
+          if(geom->intersects(g.get()))
+          {
+            addCell(outputDataSet.get(), col, lin, geom.release());
+            break;
           }
         }
       }
       else
       {
-        addCell(outputDataSet, col, lin, geom.release());
+        addCell(outputDataSet.get(), col, lin, geom.release());
       }
 
-      if (count == 0)
+      if (outputDataSet->size() >= static_cast<std::size_t>(BLOCKSIZE))
       {
-        source->createDataSet(outputDataSetType.get(), options);
-        source->add(outputDataSetType->getName(), outputDataSet, options);
+        outputDataSet->moveBeforeFirst();
+        source->add(outputDataSetType->getName(), outputDataSet.get(), options);
 
-        delete outputDataSet;
-
-        outputDataSet = new te::mem::DataSet(outputDataSetType.get());
+        outputDataSet.reset(new te::mem::DataSet(outputDataSetType.get()));
       }
+    }
+
+    task.pulse();
+  }
+
+  if (outputDataSet->size() > 0)
+  {
+    outputDataSet->moveBeforeFirst();
+    source->add(outputDataSetType->getName(), outputDataSet.get(), options);
+  }
+
+  source->close();
+}
+
+void te::cellspace::CellularSpacesOperations::setScanlineMode(const bool& enabled)
+{
+  m_scanline = enabled;
+}
+
+void te::cellspace::CellularSpacesOperations::setThreadsNumber(const std::size_t& threadsNumber)
+{
+  m_threadsNumber = threadsNumber;
+}
+
+void te::cellspace::CellularSpacesOperations::createRowBand(RowBandsJobT* job, const int firstRow, const int lastRow)
+{
+  std::auto_ptr<te::mem::DataSet> block(new te::mem::DataSet(job->m_dataSetType));
+
+  std::vector<std::pair<int, int> > columns;
+
+  for(int row = firstRow; row <= lastRow; ++row)
+  {
+    columns.clear();
+
+    if(job->m_mask == 0)
+      columns.push_back(std::make_pair(0, job->m_maxcols - 1));
+    else if(job->m_type == CELLSPACE_POLYGONS)
+      job->m_mask->getCellColumns(row, columns);
+    else
+      job->m_mask->getCenterColumns(row, columns);
+
+    double y = job->m_env.m_lly + (row * job->m_resY);
 
-      if ((count / BLOCKSIZE) >= 1)
+    for(std::size_t i = 0; i < columns.size(); ++i)
+    {
+      for(int col = columns[i].first; col <= columns[i].second; ++col)
       {
-        source->add(outputDataSetType->getName(), outputDataSet, options);
+        double x = job->m_env.m_llx + (col * job->m_resX);
+
+        te::gm::Geometry* geom = 0;
+
+        if(job->m_type == CELLSPACE_POLYGONS)
+        {
+          te::gm::Envelope cellEnv(x, y, x + job->m_resX, y + job->m_resY);
+          geom = te::gm::GetGeomFromEnvelope(&cellEnv, job->m_srid);
+        }
+        else
+        {
+          geom = new te::gm::Point(x + job->m_resX / 2, y + job->m_resY / 2, job->m_srid);
+        }
 
-        delete outputDataSet;
+        addCell(block.get(), col, row, geom);
 
-        outputDataSet = new te::mem::DataSet(outputDataSetType.get());
+        if(block->size() >= static_cast<std::size_t>(BLOCKSIZE))
+        {
+          saveBlock(job, block.get());
+
+          block.reset(new te::mem::DataSet(job->m_dataSetType));
+        }
       }
+    }
+  }
+
+  if(block->size() > 0)
+    saveBlock(job, block.get());
+}
 
-      ++count;
+void te::cellspace::CellularSpacesOperations::saveBlock(RowBandsJobT* job, te::mem::DataSet* block)
+{
+  std::map<std::string, std::string> options;
+
+  boost::lock_guard<boost::mutex> lock(job->m_mtxIO);
+
+  block->moveBeforeFirst();
+
+  job->m_source->add(job->m_dataSetType->getName(), block, options);
+}
+
+void te::cellspace::CellularSpacesOperations::createRowBandsThreadEntry(CellularSpacesOperations* op, RowBandsJobT* job)
+{
+  while(true)
+  {
+    int firstRow = 0;
+    int lastRow = 0;
+
+    {
+      boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+      if(job->m_abort || job->m_nextRow >= job->m_maxrows)
+        return;
+
+      firstRow = job->m_nextRow;
+      lastRow = std::min(firstRow + job->m_bandRows, job->m_maxrows) - 1;
+      job->m_nextRow = lastRow + 1;
     }
 
-    task.pulse();
+    try
+    {
+      op->createRowBand(job, firstRow, lastRow);
+
+      boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+      for(int row = firstRow; row <= lastRow; ++row)
+        job->m_task->pulse();
+
+      if(!job->m_task->isActive())
+      {
+        job->m_abort = true;
+
+        if(job->m_errorMessage.empty())
+          job->m_errorMessage = TE_TR("Operation canceled!");
+
+        return;
+      }
+    }
+    catch(const std::exception& e)
+    {
+      boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+      job->m_abort = true;
+
+      if(job->m_errorMessage.empty())
+        job->m_errorMessage = e.what();
+
+      return;
+    }
   }
+}
+
+te::cellspace::ScanlineMask* te::cellspace::CellularSpacesOperations::getScanlineMask(te::map::AbstractLayerPtr layerBase,
+                                                                                     const te::gm::Envelope& env,
+                                                                                     const double& resX,
+                                                                                     const double& resY)
+{
+  std::auto_ptr<ScanlineMask> mask(new ScanlineMask(env, resX, resY));
+
+  std::auto_ptr<te::da::DataSet> ds = layerBase->getData();
+
+  std::size_t geomPos = te::da::GetFirstSpatialPropertyPos(ds.get());
 
-  if (outputDataSet)
+  ds->moveBeforeFirst();
+
+  while(ds->moveNext())
   {
-    source->add(outputDataSetType->getName(), outputDataSet, options);
+    if(ds->isNull(geomPos))
+      continue;
 
-    delete outputDataSet;
+    std::auto_ptr<te::gm::Geometry> geom = ds->getGeometry(geomPos);
+
+    if(!ScanlineMask::isSupported(geom.get()))
+      return 0;
+
+    mask->add(geom.get());
   }
 
-  source->close();
+  return mask.release();
 }
 
 void te::cellspace::CellularSpacesOperations::addCell(te::mem::DataSet* ds, int col, int row, te::gm::Geometry* geom)
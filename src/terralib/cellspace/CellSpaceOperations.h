@@ -28,16 +28,29 @@
 
 // TerraLib
 #include "../dataaccess/datasource/DataSourceInfo.h"
+#include "../geometry/Envelope.h"
 #include "../maptools/AbstractLayer.h"
 #include "Config.h"
 
+// STL
+#include <string>
+
+// Boost
+#include <boost/thread/mutex.hpp>
+
 namespace te
 {
 
-  namespace ds
+  namespace common
+  {
+    class TaskProgress;
+  }
+
+  namespace da
   {
     class DataSetType;
     class DataSet;
+    class DataSource;
   }
 
   namespace gm
@@ -58,6 +71,8 @@ namespace te
 
   namespace cellspace
   {
+    class ScanlineMask;
+
     /*!
       \class CellularSpacesOperations
 
@@ -88,6 +103,12 @@ namespace te
           \param env       The bouding box of the cell space.
           \param srid      The spatial reference for the bouding box.
           \param type      The type of cell space to be created.
+          \param layerBase The mask layer (optional).
+
+          \note In the scanline mode the mask is rasterized once into column intervals for each row
+                and the covered rows are produced by a pool of threads, each one writing its cells
+                in blocks. Masks with non-polygonal or curved geometries are processed by the
+                geometry test mode.
         */
         void createCellSpace(te::da::DataSourceInfoPtr outputSource,
                              const std::string& name,
@@ -97,8 +118,68 @@ namespace te
                              const int srid,
                              CellSpaceType type,
                              te::map::AbstractLayerPtr layerBase);
+
+        /*!
+          \brief It enables the scanline mode (default: false).
+        */
+        void setScanlineMode(const bool& enabled);
+
+        /*!
+          \brief It sets the number of worker threads of the scanline mode (default: 0 - the number of physical processors).
+        */
+        void setThreadsNumber(const std::size_t& threadsNumber);
+
       private:
 
+        /*! \brief The state shared by the scanline mode workers. */
+        class RowBandsJobT
+        {
+          public:
+
+            te::da::DataSource* m_source;                 //!< The output data source.
+            te::da::DataSetType* m_dataSetType;           //!< The output dataset type.
+            const ScanlineMask* m_mask;                   //!< The rasterized mask (NULL if all cells are created).
+            te::gm::Envelope m_env;                       //!< The cellular space bounding box.
+            double m_resX;                                //!< The cells resolution in x-dimension.
+            double m_resY;                                //!< The cells resolution in y-dimension.
+            int m_maxcols;                                //!< The number of columns.
+            int m_maxrows;                                //!< The number of rows.
+            int m_bandRows;                               //!< The number of rows of each band.
+            int m_srid;                                   //!< The cells SRID.
+            CellSpaceType m_type;                         //!< The cells type.
+
+            int m_nextRow;                                //!< The first row of the next band.
+            bool m_abort;                                 //!< Stop the workers.
+            std::string m_errorMessage;                   //!< The first error raised by a worker.
+            te::common::TaskProgress* m_task;             //!< The progress of the running operation.
+
+            boost::mutex m_mtx;                           //!< It protects the bands queue and the status.
+            boost::mutex m_mtxIO;                         //!< It serializes the data source access.
+
+            RowBandsJobT();
+        };
+
+        /*!
+          \brief It creates the cells of a row band, saving them in blocks.
+        */
+        void createRowBand(RowBandsJobT* job, const int firstRow, const int lastRow);
+
+        /*!
+          \brief It saves a block of cells.
+        */
+        void saveBlock(RowBandsJobT* job, te::mem::DataSet* block);
+
+        /*! \brief The scanline mode worker threads entry. */
+        static void createRowBandsThreadEntry(CellularSpacesOperations* op, RowBandsJobT* job);
+
+        /*!
+          \brief It reads the mask layer into a scanline mask.
+
+          \return The mask or NULL if the layer has geometries not supported by it.
+        */
+        ScanlineMask* getScanlineMask(te::map::AbstractLayerPtr layerBase, const te::gm::Envelope& env,
+                                      const double& resX, const double& resY);
+
         /*!
           \brief Add a cell in the memory dataset
 
@@ -128,6 +209,9 @@ namespace te
           \return The DataSetType created.
         */
         te::da::DataSetType* createCellularDataSetType(const std::string& name, int srid, CellSpaceType type);
+
+        bool m_scanline;                                  //!< Use the scanline mode.
+        std::size_t m_threadsNumber;                      //!< The number of worker threads of the scanline mode.
     };
   }
 }
@@ -0,0 +1,303 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/cellspace/ScanlineMask.cpp
+
+  \brief Mask polygons rasterized into column intervals for each row of a cellular space.
+*/
+
+// TerraLib
+#include "../common/Exception.h"
+#include "../core/translator/Translator.h"
+#include "../geometry/CurvePolygon.h"
+#include "../geometry/GeometryCollection.h"
+#include "../geometry/LineString.h"
+#include "ScanlineMask.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  void MergeIntervals(std::vector<std::pair<double, double> >& intervals)
+  {
+    if(intervals.empty())
+      return;
+
+    std::sort(intervals.begin(), intervals.end());
+
+    std::size_t last = 0;
+
+    for(std::size_t i = 1; i < intervals.size(); ++i)
+    {
+      if(intervals[i].first <= intervals[last].second)
+        intervals[last].second = std::max(intervals[last].second, intervals[i].second);
+      else
+        intervals[++last] = intervals[i];
+    }
+
+    intervals.resize(last + 1);
+  }
+
+  void AddColumns(int first, int last, const int ncols, std::vector<std::pair<int, int> >& columns)
+  {
+    first = std::max(first, 0);
+    last = std::min(last, ncols - 1);
+
+    if(first > last)
+      return;
+
+    if(!columns.empty() && first <= columns.back().second + 1)
+      columns.back().second = std::max(columns.back().second, last);
+    else
+      columns.push_back(std::make_pair(first, last));
+  }
+}
+
+te::cellspace::ScanlineMask::ScanlineMask(const te::gm::Envelope& env, const double& resX, const double& resY)
+  : m_env(env),
+    m_resX(resX),
+    m_resY(resY),
+    m_ncols(0),
+    m_nrows(0),
+    m_npolygons(0)
+{
+  if(!env.isValid() || resX <= 0.0 || resY <= 0.0)
+    throw te::common::Exception(TE_TR("Invalid cellular space bounding box or resolution!"));
+
+  m_ncols = (int)ceil((env.m_urx - env.m_llx) / resX);
+  m_nrows = (int)ceil((env.m_ury - env.m_lly) / resY);
+
+  m_rowEdges.resize(m_nrows);
+}
+
+te::cellspace::ScanlineMask::~ScanlineMask()
+{
+}
+
+bool te::cellspace::ScanlineMask::isSupported(const te::gm::Geometry* geom)
+{
+  if(geom == 0)
+    return false;
+
+  const te::gm::CurvePolygon* poly = dynamic_cast<const te::gm::CurvePolygon*>(geom);
+
+  if(poly)
+  {
+    for(std::size_t i = 0; i < poly->getNumRings(); ++i)
+    {
+      if(dynamic_cast<const te::gm::LineString*>(poly->getRingN(i)) == 0)
+        return false;
+    }
+
+    return true;
+  }
+
+  const te::gm::GeometryCollection* gc = dynamic_cast<const te::gm::GeometryCollection*>(geom);
+
+  if(gc == 0)
+    return false;
+
+  for(std::size_t i = 0; i < gc->getNumGeometries(); ++i)
+  {
+    if(!isSupported(gc->getGeometryN(i)))
+      return false;
+  }
+
+  return true;
+}
+
+void te::cellspace::ScanlineMask::add(const te::gm::Geometry* geom)
+{
+  if(!isSupported(geom))
+    throw te::common::Exception(TE_TR("The scanline mask supports only polygons with linear rings!"));
+
+  const te::gm::CurvePolygon* poly = dynamic_cast<const te::gm::CurvePolygon*>(geom);
+
+  if(poly)
+  {
+    for(std::size_t i = 0; i < poly->getNumRings(); ++i)
+      addRing(static_cast<const te::gm::LineString*>(poly->getRingN(i)), m_npolygons);
+
+    ++m_npolygons;
+
+    return;
+  }
+
+  const te::gm::GeometryCollection* gc = static_cast<const te::gm::GeometryCollection*>(geom);
+
+  for(std::size_t i = 0; i < gc->getNumGeometries(); ++i)
+    add(gc->getGeometryN(i));
+}
+
+int te::cellspace::ScanlineMask::getNumberOfColumns() const
+{
+  return m_ncols;
+}
+
+int te::cellspace::ScanlineMask::getNumberOfRows() const
+{
+  return m_nrows;
+}
+
+void te::cellspace::ScanlineMask::getCellColumns(const int row, std::vector<std::pair<int, int> >& columns) const
+{
+  columns.clear();
+
+  std::vector<std::pair<double, double> > intervals;
+  getIntervals(row, false, intervals);
+
+  for(std::size_t i = 0; i < intervals.size(); ++i)
+  {
+    int first = (int)ceil((intervals[i].first - m_env.m_llx) / m_resX) - 1;
+    int last = (int)floor((intervals[i].second - m_env.m_llx) / m_resX);
+
+    AddColumns(first, last, m_ncols, columns);
+  }
+}
+
+void te::cellspace::ScanlineMask::getCenterColumns(const int row, std::vector<std::pair<int, int> >& columns) const
+{
+  columns.clear();
+
+  std::vector<std::pair<double, double> > intervals;
+  getIntervals(row, true, intervals);
+
+  for(std::size_t i = 0; i < intervals.size(); ++i)
+  {
+    int first = (int)ceil((intervals[i].first - m_env.m_llx) / m_resX - 0.5);
+    int last = (int)floor((intervals[i].second - m_env.m_llx) / m_resX - 0.5);
+
+    AddColumns(first, last, m_ncols, columns);
+  }
+}
+
+void te::cellspace::ScanlineMask::addRing(const te::gm::LineString* ring, const std::size_t& polygon)
+{
+  std::size_t npts = ring->size();
+
+  for(std::size_t i = 1; i < npts; ++i)
+  {
+    double x0 = ring->getX(i - 1);
+    double y0 = ring->getY(i - 1);
+    double x1 = ring->getX(i);
+    double y1 = ring->getY(i);
+
+    if(x0 == x1 && y0 == y1)
+      continue;
+
+    int first = (int)ceil((std::min(y0, y1) - m_env.m_lly) / m_resY) - 1;
+    int last = (int)floor((std::max(y0, y1) - m_env.m_lly) / m_resY);
+
+    first = std::max(first, 0);
+    last = std::min(last, m_nrows - 1);
+
+    if(first > last)
+      continue;
+
+    std::size_t pos = m_edges.size();
+    m_edges.push_back(EdgeT(x0, y0, x1, y1, polygon));
+
+    for(int r = first; r <= last; ++r)
+      m_rowEdges[r].push_back(pos);
+  }
+}
+
+void te::cellspace::ScanlineMask::getIntervals(const int row, const bool centers, std::vector<std::pair<double, double> >& intervals) const
+{
+  intervals.clear();
+
+  if(row < 0 || row >= m_nrows)
+    return;
+
+  const double sy0 = m_env.m_lly + row * m_resY;
+  const double sy1 = sy0 + m_resY;
+  const double yc = sy0 + m_resY / 2.0;
+
+  const std::vector<std::size_t>& rowEdges = m_rowEdges[row];
+
+  // crossings of the row center line by polygon
+  std::vector<std::pair<std::size_t, double> > crossings;
+
+  for(std::size_t i = 0; i < rowEdges.size(); ++i)
+  {
+    const EdgeT& e = m_edges[rowEdges[i]];
+
+    if(e.m_y0 == e.m_y1)
+    {
+      // horizontal edges are boundary only
+      if(centers ? (e.m_y0 == yc) : (e.m_y0 >= sy0 && e.m_y0 <= sy1))
+        intervals.push_back(std::make_pair(std::min(e.m_x0, e.m_x1), std::max(e.m_x0, e.m_x1)));
+
+      continue;
+    }
+
+    if(centers)
+    {
+      if(e.m_y0 == yc)
+        intervals.push_back(std::make_pair(e.m_x0, e.m_x0));
+    }
+    else
+    {
+      // the edge piece inside the row strip
+      double ta = (sy0 - e.m_y0) / (e.m_y1 - e.m_y0);
+      double tb = (sy1 - e.m_y0) / (e.m_y1 - e.m_y0);
+
+      double tmin = std::max(0.0, std::min(ta, tb));
+      double tmax = std::min(1.0, std::max(ta, tb));
+
+      if(tmin <= tmax)
+      {
+        double xa = e.m_x0 + tmin * (e.m_x1 - e.m_x0);
+        double xb = e.m_x0 + tmax * (e.m_x1 - e.m_x0);
+
+        intervals.push_back(std::make_pair(std::min(xa, xb), std::max(xa, xb)));
+      }
+    }
+
+    if((e.m_y0 > yc) != (e.m_y1 > yc))
+    {
+      double x = e.m_x0 + (yc - e.m_y0) * (e.m_x1 - e.m_x0) / (e.m_y1 - e.m_y0);
+
+      crossings.push_back(std::make_pair(e.m_polygon, x));
+    }
+  }
+
+  // even-odd interior spans of each polygon
+  std::sort(crossings.begin(), crossings.end());
+
+  std::size_t i = 0;
+
+  while(i + 1 < crossings.size())
+  {
+    if(crossings[i].first != crossings[i + 1].first)
+    {
+      ++i;
+      continue;
+    }
+
+    intervals.push_back(std::make_pair(crossings[i].second, crossings[i + 1].second));
+
+    i += 2;
+  }
+
+  MergeIntervals(intervals);
+}
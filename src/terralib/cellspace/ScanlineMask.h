@@ -0,0 +1,157 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/cellspace/ScanlineMask.h
+
+  \brief Mask polygons rasterized into column intervals for each row of a cellular space.
+*/
+
+#ifndef __TERRALIB_CELLSPACE_INTERNAL_SCANLINEMASK_H
+#define __TERRALIB_CELLSPACE_INTERNAL_SCANLINEMASK_H
+
+// TerraLib
+#include "../geometry/Envelope.h"
+#include "Config.h"
+
+// STL
+#include <utility>
+#include <vector>
+
+// Boost
+#include <boost/noncopyable.hpp>
+
+namespace te
+{
+  namespace gm
+  {
+    class Geometry;
+    class LineString;
+  }
+
+  namespace cellspace
+  {
+    /*!
+      \class ScanlineMask
+
+      \brief Mask polygons rasterized into column intervals for each row of a cellular space.
+
+      \details The polygon edges are bucketed by the rows they cross. The covered columns of a row
+               are computed from the edges of its bucket only: the x-ranges of the edge pieces inside
+               the row strip plus the even-odd interior spans at the row center line. The masks
+               are never touched again after being added.
+
+      \note Once all masks are added, the query methods can be called concurrently.
+    */
+    class TECELLSPACEEXPORT ScanlineMask : public boost::noncopyable
+    {
+      public:
+
+        /*!
+          \brief Constructor.
+
+          \param env  The cellular space bounding box (its lower-left corner is the first cell one).
+          \param resX The cells resolution in x-dimension.
+          \param resY The cells resolution in y-dimension.
+        */
+        ScanlineMask(const te::gm::Envelope& env, const double& resX, const double& resY);
+
+        ~ScanlineMask();
+
+        /*!
+          \brief It checks if the geometry can be added to the mask (polygons made of linear rings and collections of them).
+        */
+        static bool isSupported(const te::gm::Geometry* geom);
+
+        /*!
+          \brief It adds the edges of a mask geometry.
+
+          \exception te::common::Exception If the geometry is not supported.
+        */
+        void add(const te::gm::Geometry* geom);
+
+        /*! \brief It returns the number of columns of the cellular space. */
+        int getNumberOfColumns() const;
+
+        /*! \brief It returns the number of rows of the cellular space. */
+        int getNumberOfRows() const;
+
+        /*!
+          \brief It returns the columns of the cells touching the mask (boundaries included) in a row.
+
+          \param row     The row number.
+          \param columns The sorted and disjoint ranges of columns (both limits included).
+        */
+        void getCellColumns(const int row, std::vector<std::pair<int, int> >& columns) const;
+
+        /*!
+          \brief It returns the columns of the cells whose center is covered by the mask (boundaries included) in a row.
+
+          \param row     The row number.
+          \param columns The sorted and disjoint ranges of columns (both limits included).
+        */
+        void getCenterColumns(const int row, std::vector<std::pair<int, int> >& columns) const;
+
+      protected:
+
+        /*! \brief A mask polygon edge. */
+        class EdgeT
+        {
+          public:
+
+            double m_x0;            //!< The first vertex x-coordinate.
+            double m_y0;            //!< The first vertex y-coordinate.
+            double m_x1;            //!< The second vertex x-coordinate.
+            double m_y1;            //!< The second vertex y-coordinate.
+            std::size_t m_polygon;  //!< The polygon owning the edge.
+
+            EdgeT(double x0, double y0, double x1, double y1, std::size_t polygon)
+              : m_x0(x0), m_y0(y0), m_x1(x1), m_y1(y1), m_polygon(polygon)
+            {
+            }
+        };
+
+        /*!
+          \brief It adds the edges of a polygon ring.
+        */
+        void addRing(const te::gm::LineString* ring, const std::size_t& polygon);
+
+        /*!
+          \brief It computes the covered x-intervals of a row, sorted and merged.
+
+          \param row     The row number.
+          \param centers If true only the row center line is considered, otherwise the whole row strip.
+        */
+        void getIntervals(const int row, const bool centers, std::vector<std::pair<double, double> >& intervals) const;
+
+      private:
+
+        te::gm::Envelope m_env;                               //!< The cellular space bounding box.
+        double m_resX;                                        //!< The cells resolution in x-dimension.
+        double m_resY;                                        //!< The cells resolution in y-dimension.
+        int m_ncols;                                          //!< The number of columns.
+        int m_nrows;                                          //!< The number of rows.
+        std::size_t m_npolygons;                              //!< The number of added polygons.
+        std::vector<EdgeT> m_edges;                           //!< The mask edges.
+        std::vector<std::vector<std::size_t> > m_rowEdges;    //!< The edges crossing each row.
+    };
+  } // end namespace cellspace
+} // end namespace te
+
+#endif // __TERRALIB_CELLSPACE_INTERNAL_SCANLINEMASK_H
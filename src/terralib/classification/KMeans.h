@@ -108,6 +108,11 @@ namespace te
                       std::vector<unsigned int>& classification,
                       const bool enableProgressInterface) throw(te::cl::Exception);
 
+        /*!
+          \brief Returns the trained means (index 0 is unused, classes are labeled from 1 to K).
+        */
+        const std::vector<std::vector<double> >& getMeans() const;
+
       protected:
 
         unsigned int getClassification(std::vector<double> values);
@@ -336,6 +341,12 @@ bool te::cl::KMeans<TTRAIN, TCLASSIFY>::classify(TCLASSIFY& itBegin, TCLASSIFY&
   return true;
 }
 
+template<class TTRAIN, class TCLASSIFY>
+const std::vector<std::vector<double> >& te::cl::KMeans<TTRAIN, TCLASSIFY>::getMeans() const
+{
+  return m_KMeans;
+}
+
 template<class TTRAIN, class TCLASSIFY>
 unsigned int te::cl::KMeans<TTRAIN, TCLASSIFY>::getClassification(std::vector<double> values)
 {
@@ -34,6 +34,7 @@
 #include "common/ByteSwapUtils.h"
 #include "common/Comparators.h"
 #include "common/Config.h"
+#include "common/CounterRegistry.h"
 #include "common/Distance.h"
 #include "common/Enums.h"
 #include "common/Exception.h"
@@ -55,6 +56,7 @@
 #include "common/Visitor.h"
 #include "common/progress/AbstractProgressViewer.h"
 #include "common/progress/ConsoleProgressViewer.h"
+#include "common/progress/ProgressCounter.h"
 #include "common/progress/ProgressManager.h"
 #include "common/progress/ProgressTimer.h"
 #include "common/progress/TaskProgress.h"
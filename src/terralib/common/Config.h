@@ -32,6 +32,13 @@
 
 #define TE_PROTOCOL_DEFAULT_PORTS_FILE "protocol/protocolPorts.txt"
 
+/*!
+  \def TE_COMMON_PROGRESS_BATCH_SIZE
+
+  \brief The default number of steps accumulated by a progress counter before updating its task.
+*/
+#define TE_COMMON_PROGRESS_BATCH_SIZE 1024
+
 /** @name DLL/LIB Module
  *  Flags for building TerraLib as a DLL or as a Static Library
  */
@@ -0,0 +1,150 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/common/CounterRegistry.cpp
+
+  \brief A registry of named counters and timers published by the algorithms.
+ */
+
+// TerraLib
+#include "CounterRegistry.h"
+
+// STL
+#include <cstdio>
+#include <sstream>
+
+// Boost
+#include <boost/thread/lock_guard.hpp>
+
+namespace te
+{
+  namespace common
+  {
+    /*! \brief It writes a string as a JSON string. */
+    inline void WriteJSONString(std::ostream& os, const std::string& s)
+    {
+      os << '"';
+
+      for(std::size_t i = 0; i < s.size(); ++i)
+      {
+        const char c = s[i];
+
+        if(c == '"' || c == '\\')
+        {
+          os << '\\' << c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          std::sprintf(buffer, "\\u%04x", static_cast<int>(c));
+          os << buffer;
+        }
+        else
+        {
+          os << c;
+        }
+      }
+
+      os << '"';
+    }
+  }
+}
+
+te::common::Counter& te::common::CounterRegistry::getCounter(const std::string& name)
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  boost::shared_ptr<Counter>& c = m_counters[name];
+
+  if(c.get() == 0)
+    c.reset(new Counter);
+
+  return *c;
+}
+
+te::common::Timer& te::common::CounterRegistry::getTimer(const std::string& name)
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  boost::shared_ptr<Timer>& t = m_timers[name];
+
+  if(t.get() == 0)
+    t.reset(new Timer);
+
+  return *t;
+}
+
+void te::common::CounterRegistry::add(const std::string& name, long long value)
+{
+  getCounter(name).add(value);
+}
+
+void te::common::CounterRegistry::reset()
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  for(std::map<std::string, boost::shared_ptr<Counter> >::iterator it = m_counters.begin(); it != m_counters.end(); ++it)
+    it->second->reset();
+
+  for(std::map<std::string, boost::shared_ptr<Timer> >::iterator it = m_timers.begin(); it != m_timers.end(); ++it)
+    it->second->reset();
+}
+
+std::string te::common::CounterRegistry::toJSON() const
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  std::ostringstream os;
+  os.precision(9);
+
+  os << "{\n  \"counters\": {";
+
+  for(std::map<std::string, boost::shared_ptr<Counter> >::const_iterator it = m_counters.begin(); it != m_counters.end(); ++it)
+  {
+    os << (it == m_counters.begin() ? "\n    " : ",\n    ");
+    WriteJSONString(os, it->first);
+    os << ": " << it->second->getValue();
+  }
+
+  os << (m_counters.empty() ? "},\n" : "\n  },\n");
+
+  os << "  \"timers\": {";
+
+  for(std::map<std::string, boost::shared_ptr<Timer> >::const_iterator it = m_timers.begin(); it != m_timers.end(); ++it)
+  {
+    os << (it == m_timers.begin() ? "\n    " : ",\n    ");
+    WriteJSONString(os, it->first);
+    os << ": { \"seconds\": " << it->second->getSeconds() << ", \"count\": " << it->second->getCount() << " }";
+  }
+
+  os << (m_timers.empty() ? "}\n" : "\n  }\n");
+
+  os << "}\n";
+
+  return os.str();
+}
+
+te::common::CounterRegistry::CounterRegistry()
+{
+}
+
+te::common::CounterRegistry::~CounterRegistry()
+{
+}
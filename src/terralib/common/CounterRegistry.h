@@ -0,0 +1,285 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/common/CounterRegistry.h
+
+  \brief A registry of named counters and timers published by the algorithms.
+ */
+
+#ifndef __TERRALIB_COMMON_INTERNAL_COUNTERREGISTRY_H
+#define __TERRALIB_COMMON_INTERNAL_COUNTERREGISTRY_H
+
+// TerraLib
+#include "Config.h"
+#include "Singleton.h"
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+
+// Boost
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace te
+{
+  namespace common
+  {
+    /*!
+      \class Counter
+
+      \brief A named counter (items processed, bytes read, ...) that can be incremented by several threads.
+
+      \ingroup common
+     */
+    class Counter : public boost::noncopyable
+    {
+      public:
+
+        /*! \brief Constructor. */
+        Counter()
+          : m_value(0)
+        {
+        }
+
+        /*!
+          \brief It adds a value to the counter.
+
+          \param value The value to be added.
+         */
+        void add(long long value = 1)
+        {
+          m_value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        /*! \brief It returns the counter value. */
+        long long getValue() const
+        {
+          return m_value.load(std::memory_order_relaxed);
+        }
+
+        /*! \brief It sets the counter value to zero. */
+        void reset()
+        {
+          m_value = 0;
+        }
+
+      private:
+
+        std::atomic<long long> m_value;   //!< The counter value.
+    };
+
+    /*!
+      \class Timer
+
+      \brief A named timer that accumulates the elapsed time of the runs of a stage.
+
+      \ingroup common
+
+      \sa ScopedTimer
+     */
+    class Timer : public boost::noncopyable
+    {
+      public:
+
+        /*! \brief Constructor. */
+        Timer()
+          : m_nanoseconds(0),
+            m_count(0)
+        {
+        }
+
+        /*!
+          \brief It adds the elapsed time of a run.
+
+          \param nanoseconds The elapsed time, in nanoseconds.
+         */
+        void add(long long nanoseconds)
+        {
+          m_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+          m_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /*! \brief It returns the total elapsed time, in seconds. */
+        double getSeconds() const
+        {
+          return static_cast<double>(m_nanoseconds.load(std::memory_order_relaxed)) * 1.0e-9;
+        }
+
+        /*! \brief It returns the number of runs. */
+        long long getCount() const
+        {
+          return m_count.load(std::memory_order_relaxed);
+        }
+
+        /*! \brief It sets the elapsed time and the number of runs to zero. */
+        void reset()
+        {
+          m_nanoseconds = 0;
+          m_count = 0;
+        }
+
+      private:
+
+        std::atomic<long long> m_nanoseconds;   //!< The total elapsed time.
+        std::atomic<long long> m_count;         //!< The number of runs.
+    };
+
+    /*!
+      \class CounterRegistry
+
+      \brief A registry of named counters and timers published by the algorithms.
+
+      \details The counters and timers are created on the first request and live until the
+               registry is destroyed, so the algorithms can keep a reference to them and
+               update them without locking. After a run the registry can be dumped as JSON:
+
+      \code
+      {
+        "counters": { "vp.dissolve.features": 1200 },
+        "timers": { "vp.dissolve.union": { "seconds": 0.25, "count": 4 } }
+      }
+      \endcode
+
+      \note The names are dot separated, starting with the module name.
+
+      \ingroup common
+
+      \sa Counter, Timer, ScopedTimer
+     */
+    class TECOMMONEXPORT CounterRegistry : public te::common::Singleton<CounterRegistry>
+    {
+      friend class te::common::Singleton<CounterRegistry>;
+
+      public:
+
+        /*!
+          \brief It returns the counter with the given name, creating it if needed.
+
+          \param name The counter name.
+
+          \return The counter.
+         */
+        Counter& getCounter(const std::string& name);
+
+        /*!
+          \brief It returns the timer with the given name, creating it if needed.
+
+          \param name The timer name.
+
+          \return The timer.
+         */
+        Timer& getTimer(const std::string& name);
+
+        /*!
+          \brief It adds a value to the counter with the given name.
+
+          \param name  The counter name.
+          \param value The value to be added.
+         */
+        void add(const std::string& name, long long value = 1);
+
+        /*! \brief It sets all the counters and timers to zero. */
+        void reset();
+
+        /*!
+          \brief It returns the counters and timers as a JSON document.
+
+          \return The JSON document.
+         */
+        std::string toJSON() const;
+
+      protected:
+
+        /*! \brief Constructor. */
+        CounterRegistry();
+
+        /*! \brief Destructor. */
+        ~CounterRegistry();
+
+      private:
+
+        std::map<std::string, boost::shared_ptr<Counter> > m_counters;   //!< The counters.
+        std::map<std::string, boost::shared_ptr<Timer> > m_timers;       //!< The timers.
+        mutable boost::mutex m_mtx;                                      //!< It protects the maps.
+    };
+
+    /*!
+      \class ScopedTimer
+
+      \brief It adds the time elapsed between its construction and destruction to a timer.
+
+      \code
+      {
+        te::common::ScopedTimer t("vp.dissolve.union");
+
+        ...
+      }
+      \endcode
+
+      \ingroup common
+
+      \sa Timer, CounterRegistry
+     */
+    class ScopedTimer : public boost::noncopyable
+    {
+      public:
+
+        /*!
+          \brief Constructor.
+
+          \param timer The timer.
+         */
+        explicit ScopedTimer(Timer& timer)
+          : m_timer(timer),
+            m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        /*!
+          \brief Constructor.
+
+          \param name The name of a timer of the registry.
+         */
+        explicit ScopedTimer(const std::string& name)
+          : m_timer(CounterRegistry::getInstance().getTimer(name)),
+            m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        /*! \brief Destructor. It adds the elapsed time to the timer. */
+        ~ScopedTimer()
+        {
+          m_timer.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+      private:
+
+        Timer& m_timer;                                     //!< The timer.
+        std::chrono::steady_clock::time_point m_start;      //!< The start time.
+    };
+
+  } // end namespace common
+}   // end namespace te
+
+#endif  // __TERRALIB_COMMON_INTERNAL_COUNTERREGISTRY_H
@@ -32,6 +32,10 @@
 // STL
 #include <map>
 
+// Boost
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+
 namespace te
 {
   namespace common
@@ -54,6 +58,10 @@ namespace te
 
       At destruction time, it will release the memory pointed by the registered factories.
 
+      Insertion, removal and lookup are serialized by an internal mutex, so plugins
+      may register factories while other threads look them up. Iterating with
+      begin() and end() is not protected.
+
       If you are creating a plugin that registers a factory, see the Abstract
       and Parameterized abstract factory notes about memory management.
 
@@ -167,6 +175,7 @@ namespace te
       private:
         
         std::map<TFACTORYKEY, TFACTORY*, TKEYCOMPARE> m_factoryMap;  //!< The internal dictionary map:  key => factory.
+        mutable boost::mutex m_mtx;                                   //!< It guards the dictionary map.
     };
 
     template<class TFACTORY, class TFACTORYKEY, class TKEYCOMPARE> inline
@@ -196,6 +205,8 @@ namespace te
       if(factory == 0)
         throw Exception(TE_TR("Could not insert the given factory into the dictionary. The factory is a NULL object!"));
 
+      boost::lock_guard<boost::mutex> lock(m_mtx);
+
       typename std::map<TFACTORYKEY, TFACTORY*, TKEYCOMPARE>::const_iterator it = m_factoryMap.find(factoryKey);
 
       if(it != m_factoryMap.end())
@@ -207,6 +218,8 @@ namespace te
     template<class TFACTORY, class TFACTORYKEY, class TKEYCOMPARE> inline
     void FactoryDictionary<TFACTORY, TFACTORYKEY, TKEYCOMPARE>::remove(const TFACTORYKEY& factoryKey)
     {
+      boost::lock_guard<boost::mutex> lock(m_mtx);
+
       typename std::map<TFACTORYKEY, TFACTORY*, TKEYCOMPARE>::iterator it = m_factoryMap.find(factoryKey);
 
       if(it != m_factoryMap.end())
@@ -218,6 +231,8 @@ namespace te
     template<class TFACTORY, class TFACTORYKEY, class TKEYCOMPARE> inline
     TFACTORY* FactoryDictionary<TFACTORY, TFACTORYKEY, TKEYCOMPARE>::find(const TFACTORYKEY& factoryKey) const
     {
+      boost::lock_guard<boost::mutex> lock(m_mtx);
+
       typename std::map<TFACTORYKEY, TFACTORY*, TKEYCOMPARE>::const_iterator it = m_factoryMap.find(factoryKey);
 
       if(it == m_factoryMap.end())
@@ -241,6 +256,8 @@ namespace te
     template<class TFACTORY, class TFACTORYKEY, class TKEYCOMPARE> inline
     std::size_t FactoryDictionary<TFACTORY, TFACTORYKEY, TKEYCOMPARE>::size() const
     {
+      boost::lock_guard<boost::mutex> lock(m_mtx);
+
       return m_factoryMap.size();
     }
 
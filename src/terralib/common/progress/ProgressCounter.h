@@ -0,0 +1,128 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/common/progress/ProgressCounter.h
+
+  \brief A local counter of steps that updates a task progress in batches.
+ */
+
+#ifndef __TERRALIB_COMMON_PROGRESS_INTERNAL_PROGRESSCOUNTER_H
+#define __TERRALIB_COMMON_PROGRESS_INTERNAL_PROGRESSCOUNTER_H
+
+// TerraLib
+#include "../Config.h"
+#include "TaskProgress.h"
+
+// Boost
+#include <boost/noncopyable.hpp>
+
+namespace te
+{
+  namespace common
+  {
+    /*!
+      \class ProgressCounter
+
+      \brief A local counter of steps that updates a task progress in batches.
+
+      \details It is meant to be used in per item loops: each thread keeps its own
+               counter and the steps are added to the task once every batch, so the
+               loop does not pay for the task update at each item.
+
+      \code
+      te::common::ProgressCounter counter(task);
+
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        if(!counter.isActive())
+          break;
+
+        ...
+
+        counter.pulse();
+      }
+      \endcode
+
+      \ingroup common
+
+      \sa TaskProgress
+    */
+    class ProgressCounter : public boost::noncopyable
+    {
+      public:
+
+        /*!
+          \brief Constructor.
+
+          \param task      The task progress updated by the counter.
+          \param batchSize The number of steps accumulated before updating the task.
+        */
+        explicit ProgressCounter(TaskProgress& task, int batchSize = TE_COMMON_PROGRESS_BATCH_SIZE)
+          : m_task(task),
+            m_batchSize(batchSize > 0 ? batchSize : 1),
+            m_steps(0)
+        {
+        }
+
+        /*! \brief Destructor. It adds the remaining steps to the task. */
+        ~ProgressCounter()
+        {
+          flush();
+        }
+
+        /*! \brief It adds one step, updating the task when the batch is complete. */
+        void pulse()
+        {
+          if(++m_steps >= m_batchSize)
+            flush();
+        }
+
+        /*! \brief It adds the accumulated steps to the task. */
+        void flush()
+        {
+          if(m_steps == 0)
+            return;
+
+          m_task.pulse(m_steps);
+
+          m_steps = 0;
+        }
+
+        /*!
+          \brief It returns true if the task was not cancelled.
+
+          \return True if the task is active.
+        */
+        bool isActive() const
+        {
+          return m_task.isActive();
+        }
+
+      private:
+
+        TaskProgress& m_task;   //!< The task progress.
+        int m_batchSize;        //!< The number of steps of a batch.
+        int m_steps;            //!< The steps not yet added to the task.
+    };
+
+  } // end namespace common
+}   // end namespace te
+
+#endif //__TERRALIB_COMMON_PROGRESS_INTERNAL_PROGRESSCOUNTER_H
@@ -28,11 +28,19 @@
 #include "ProgressTimer.h"
 #include "TaskProgress.h"
 
+// STL
+#include <algorithm>
+#include <limits>
+
+// Boost
+#include <boost/thread/lock_guard.hpp>
+
 te::common::TaskProgress::TaskProgress(const std::string& message, unsigned int type, int totalSteps)
   : m_id(-1),
     m_type(type),
     m_totalSteps(totalSteps),
     m_currentStep(0),
+    m_nextStep(0),
     m_currentPropStep(0),
     m_message(message),
     m_hasToUpdate(false),
@@ -74,7 +82,13 @@ void te::common::TaskProgress::setTotalSteps(int value)
   if(value <= 0)
     return;
 
-  m_totalSteps = value;
+  {
+    boost::lock_guard<boost::mutex> lock(m_mtx);
+
+    m_totalSteps = value;
+
+    updateNextStep();
+  }
 
   if(m_timer)
   {
@@ -99,46 +113,39 @@ int te::common::TaskProgress::getCurrentStep() const
 
 void te::common::TaskProgress::setCurrentStep(int value)
 {
-  if(m_isActive)
-  {
-    m_hasToUpdate = true;
+  if(!m_isActive)
+    return;
 
-    if(m_totalSteps > 0)
-    {
-      m_currentStep = value;
-      int val = m_currentStep;
-
-      double aux = static_cast<double>(m_currentStep) / static_cast<double>(m_totalSteps);
-      val = static_cast<int>(100.0 * aux);
-
-      if(val > m_currentPropStep)
-        m_currentPropStep = val;
-      else
-      {
-        m_hasToUpdate = false;
-      }
-    }
+  m_currentStep = value;
 
-    if(m_timer)
-      m_timer->tick();
-
-    // inform the progress manager singleton that the current value has changed
-    if (m_hasToUpdate)
-    {
-      te::common::ProgressManager::getInstance().updateValue(m_id);
+  if(m_timer)
+    m_timer->tick();
 
-      if (m_timer)
-        setMessage(m_timer->getMessage());
-    }
-  }
+  // the progress manager is only notified when the proportional value changes
+  if(m_timer || value >= m_nextStep.load(std::memory_order_relaxed))
+    notify(value);
 }
 
 void te::common::TaskProgress::pulse()
 {
-  // increment by one current value
-  int val = getCurrentStep();
+  pulse(1);
+}
+
+void te::common::TaskProgress::pulse(int steps)
+{
+  if(!m_isActive)
+    return;
 
-  setCurrentStep(++val);
+  int value = m_currentStep.fetch_add(steps) + steps;
+
+  if(m_timer)
+  {
+    for(int i = 0; i < steps; ++i)
+      m_timer->tick();
+  }
+
+  if(m_timer || value >= m_nextStep.load(std::memory_order_relaxed))
+    notify(value);
 }
 
 const std::string& te::common::TaskProgress::getMessage() const
@@ -199,3 +206,53 @@ bool te::common::TaskProgress::hasToUpdate() const
 {
   return m_hasToUpdate;
 }
+
+void te::common::TaskProgress::notify(int value)
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  if(!m_isActive)
+    return;
+
+  m_hasToUpdate = true;
+
+  if(m_totalSteps > 0)
+  {
+    double aux = static_cast<double>(value) / static_cast<double>(m_totalSteps);
+    int val = static_cast<int>(100.0 * aux);
+
+    if(val > m_currentPropStep)
+    {
+      m_currentPropStep = val;
+
+      updateNextStep();
+    }
+    else
+    {
+      m_hasToUpdate = false;
+    }
+  }
+
+  // inform the progress manager singleton that the current value has changed
+  if(m_hasToUpdate)
+  {
+    te::common::ProgressManager::getInstance().updateValue(m_id);
+
+    if(m_timer)
+      setMessage(m_timer->getMessage());
+  }
+}
+
+void te::common::TaskProgress::updateNextStep()
+{
+  if(m_totalSteps <= 0)
+  {
+    m_nextStep = 0;
+    return;
+  }
+
+  // the smallest step whose proportional value is greater than the current one
+  long long next = (static_cast<long long>(m_currentPropStep + 1) * m_totalSteps + 99) / 100;
+
+  m_nextStep = static_cast<int>(std::min<long long>(next, std::numeric_limits<int>::max()));
+}
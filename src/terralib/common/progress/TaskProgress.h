@@ -30,8 +30,13 @@
 #include "../Config.h"
 
 // STL
+#include <atomic>
 #include <string>
 
+// Boost
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
 namespace te
 {
   namespace common
@@ -46,11 +51,16 @@ namespace te
 
       \ingroup common
 
-      \sa ProgressTimer, ProgressManager
+      \note The current step and the active flag are atomic, so several threads can pulse
+            the same task. The progress manager is only notified when the proportional
+            value changes: the other pulses are just an atomic increment. For per item
+            loops use a ProgressCounter, that accumulates the steps locally.
+
+      \sa ProgressTimer, ProgressManager, ProgressCounter
 
       \todo ProgressTimer is NOT working if TaskProgress is in multithread mode.
     */
-    class TECOMMONEXPORT TaskProgress
+    class TECOMMONEXPORT TaskProgress : public boost::noncopyable
     {
       public:
 
@@ -124,9 +134,16 @@ namespace te
         */
         void setCurrentStep(int value);
 
-        /*! \brief Calls setCurrentStep() function using getCurrentStep() + 1. */
+        /*! \brief It adds one step to the current step. */
         void pulse();
 
+        /*!
+          \brief It adds a number of steps to the current step.
+
+          \param steps The number of steps.
+        */
+        void pulse(int steps);
+
         /*!
           \brief Get the task message.
 
@@ -174,17 +191,31 @@ namespace te
 
       protected:
 
-        int m_id;                   //!< Task identification.
-        unsigned int m_type;        //!< Task type.
-        int m_totalSteps;           //!< Task total steps.
-        int m_currentStep;          //!< Task current step.
-        int m_currentPropStep;      //!< Current proportinal step.
-        std::string m_message;      //!< Task message.
-        bool m_hasToUpdate;         //!< Flag used to indicate the update status.
-        bool m_isActive;            //!< Flag used to indicate the task status.
-        bool m_isMultiThread;       //!< Flag used to indicate the thread mode.
-        bool m_useTimer;            //!< Flag used to indicate the timer status.
-        ProgressTimer* m_timer;     //!< Progress timer instance.
+        /*!
+          \brief It updates the proportional value and notifies the progress manager if it has changed.
+
+          \param value The current step.
+        */
+        void notify(int value);
+
+        /*! \brief It computes the first step that changes the proportional value. */
+        void updateNextStep();
+
+      protected:
+
+        int m_id;                           //!< Task identification.
+        unsigned int m_type;                //!< Task type.
+        int m_totalSteps;                   //!< Task total steps.
+        std::atomic<int> m_currentStep;     //!< Task current step.
+        std::atomic<int> m_nextStep;        //!< The first step that changes the proportional value.
+        int m_currentPropStep;              //!< Current proportinal step.
+        std::string m_message;              //!< Task message.
+        bool m_hasToUpdate;                 //!< Flag used to indicate the update status.
+        std::atomic<bool> m_isActive;       //!< Flag used to indicate the task status.
+        bool m_isMultiThread;               //!< Flag used to indicate the thread mode.
+        bool m_useTimer;                    //!< Flag used to indicate the timer status.
+        ProgressTimer* m_timer;             //!< Progress timer instance.
+        boost::mutex m_mtx;                 //!< It serializes the notifications.
     };
 
   } // end namespace common
@@ -30,6 +30,13 @@
 // TerraLib
 #include "../Defines.h"
 
+/*!
+  \def TE_CORE_LOGGER_QUEUE_SIZE
+
+  \brief The default number of messages that the asynchronous logger queue can hold.
+*/
+#define TE_CORE_LOGGER_QUEUE_SIZE 8192
+
 #ifdef WIN32
   #ifdef TECOREDLL
     #define TECOREEXPORT TE_DLL_EXPORT
@@ -32,30 +32,206 @@
 #include "../Exception.h"
 #include "../translator/Translator.h"
 
+// STL
+#include <chrono>
+#include <map>
+#include <memory>
+
 // Boost
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/format.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/lockfree/queue.hpp>
 #include <boost/log/attributes/current_process_name.hpp>
 #include <boost/log/attributes/current_thread_id.hpp>
+#include <boost/log/attributes/mutable_constant.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
 #include <boost/log/sources/severity_channel_logger.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/utility/setup/file.hpp>
 #include <boost/log/utility/setup/from_stream.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 BOOST_LOG_ATTRIBUTE_KEYWORD(channel, "Channel", std::string)
 
 
+namespace
+{
+  typedef boost::log::sources::severity_channel_logger_mt<boost::log::trivial::severity_level, std::string> severity_channel_logger;
+
+  /*! \brief A message waiting in the asynchronous queue. */
+  struct Record
+  {
+    std::string m_message;
+    std::string m_channel;
+    boost::log::trivial::severity_level m_severity;
+    boost::posix_time::ptime m_time;
+  };
+
+  /*! \brief The rate limit of a channel: the number of messages logged in the current second. */
+  struct RateLimit
+  {
+    RateLimit(std::size_t maxMessages)
+      : m_maxMessages(maxMessages),
+        m_second(0),
+        m_count(0)
+    {
+    }
+
+    std::size_t m_maxMessages;
+    std::atomic<long long> m_second;
+    std::atomic<std::size_t> m_count;
+  };
+
+  boost::log::trivial::severity_level ToBoostSeverity(te::core::Logger::severity_level severity)
+  {
+    switch(severity)
+    {
+      case te::core::Logger::severity_level::trace :
+        return boost::log::trivial::trace;
+      case te::core::Logger::severity_level::debug :
+        return boost::log::trivial::debug;
+      case te::core::Logger::severity_level::info :
+        return boost::log::trivial::info;
+      case te::core::Logger::severity_level::warning :
+        return boost::log::trivial::warning;
+      case te::core::Logger::severity_level::error :
+        return boost::log::trivial::error;
+      case te::core::Logger::severity_level::fatal :
+        return boost::log::trivial::fatal;
+      default:
+        throw te::InvalidArgumentException() << te::ErrorDescription(TE_TR("Invalid severity level."));
+    }
+  }
+}
+
 struct te::core::Logger::Impl
 {
+  Impl()
+    : m_timeStamp(boost::posix_time::ptime()),
+      m_async(false),
+      m_running(false),
+      m_queued(0),
+      m_written(0),
+      m_dropped(0),
+      m_hasRateLimits(false)
+  {
+    m_writerLogger.add_attribute("TimeStamp", m_timeStamp);
+  }
+
+  /*! \brief It returns false if the message exceeds the rate limit of its channel. */
+  bool acquire(const std::string& channel);
+
+  /*! \brief It writes the queued messages, returning false if the queue was empty. */
+  bool drain();
+
+  /*! \brief The writer thread: it writes the queued messages until the asynchronous mode is stopped. */
+  void write();
+
   /*! \brief Multi-Thread severity logger*/
-  boost::log::sources::severity_channel_logger_mt<boost::log::trivial::severity_level, std::string>  m_logger;
+  severity_channel_logger m_logger;
 
   /*! \brief Logger list */
   std::vector< std::string > m_logger_list;
+
+  /*! \brief The logger used by the writer thread, with the time of the log calls as time stamp. */
+  severity_channel_logger m_writerLogger;
+
+  /*! \brief The time stamp of the message being written by the writer thread. */
+  boost::log::attributes::mutable_constant<boost::posix_time::ptime> m_timeStamp;
+
+  std::unique_ptr<boost::lockfree::queue<Record*, boost::lockfree::fixed_sized<true> > > m_queue;   //!< The asynchronous queue.
+  boost::thread m_writer;                                       //!< The writer thread.
+  std::atomic<bool> m_async;                                    //!< True if the messages are queued.
+  std::atomic<bool> m_running;                                  //!< False when the writer thread must stop.
+  std::atomic<unsigned long long> m_queued;                     //!< The number of queued messages.
+  std::atomic<unsigned long long> m_written;                    //!< The number of written queued messages.
+  std::atomic<unsigned long long> m_dropped;                    //!< The number of dropped messages.
+  boost::mutex m_mtx;                                           //!< The mutex of the condition variables.
+  boost::condition_variable m_queuedCond;                       //!< It wakes the writer thread up.
+  boost::condition_variable m_writtenCond;                      //!< It wakes the threads waiting in flush up.
+
+  std::map<std::string, std::shared_ptr<RateLimit> > m_rateLimits;   //!< The rate limits of the channels.
+  std::atomic<bool> m_hasRateLimits;                                  //!< True if there is a rate limit.
+  mutable boost::shared_mutex m_rateLimitsMtx;                        //!< It protects the rate limits.
 };
 
+bool te::core::Logger::Impl::acquire(const std::string& channel)
+{
+  if(!m_hasRateLimits.load(std::memory_order_relaxed))
+    return true;
+
+  boost::shared_lock<boost::shared_mutex> lock(m_rateLimitsMtx);
+
+  std::map<std::string, std::shared_ptr<RateLimit> >::const_iterator it = m_rateLimits.find(channel);
+
+  if(it == m_rateLimits.end())
+    return true;
+
+  RateLimit& limit = *it->second;
+
+  const long long second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  long long current = limit.m_second.load(std::memory_order_relaxed);
+
+// the first message of a new second restarts the count
+  if(current != second && limit.m_second.compare_exchange_strong(current, second))
+    limit.m_count.store(0, std::memory_order_relaxed);
+
+  return limit.m_count.fetch_add(1, std::memory_order_relaxed) < limit.m_maxMessages;
+}
+
+bool te::core::Logger::Impl::drain()
+{
+  Record* record = nullptr;
+
+  bool written = false;
+
+  while(m_queue->pop(record))
+  {
+    std::unique_ptr<Record> r(record);
+
+    m_timeStamp.set(r->m_time);
+
+    BOOST_LOG_CHANNEL_SEV(m_writerLogger, r->m_channel, r->m_severity) << r->m_message;
+
+    m_written.fetch_add(1);
+
+    written = true;
+  }
+
+  if(written)
+  {
+    boost::lock_guard<boost::mutex> lock(m_mtx);
+    m_writtenCond.notify_all();
+  }
+
+  return written;
+}
+
+void te::core::Logger::Impl::write()
+{
+  while(true)
+  {
+    const bool running = m_running.load();
+
+    if(drain())
+      continue;
+
+    if(!running)
+      break;
+
+// the producers do not signal each message, so the queue is polled while it is empty
+    boost::unique_lock<boost::mutex> lock(m_mtx);
+    m_queuedCond.timed_wait(lock, boost::posix_time::milliseconds(10));
+  }
+}
+
 te::core::Logger& te::core::Logger::instance()
 {
   static Logger instance;
@@ -121,7 +297,8 @@ void te::core::Logger::removeAllLoggers()
 }
 
 te::core::Logger::Logger() :
-  m_pimpl(nullptr)
+  m_pimpl(nullptr),
+  m_severity(static_cast<int>(severity_level::trace))
 {
   boost::log::register_simple_formatter_factory< boost::log::trivial::severity_level, char >("Severity");
 
@@ -138,39 +315,135 @@ te::core::Logger::Logger() :
 
 te::core::Logger::~Logger()
 {
+  stopAsync();
+
   delete m_pimpl;
 }
 
 
 void te::core::Logger::log(const std::string& message, const std::string& channel,  severity_level severity)
 {
-  boost::log::trivial::severity_level boost_severity;
-  switch(severity)
+  const boost::log::trivial::severity_level boost_severity = ToBoostSeverity(severity);
+
+  if(!isEnabled(severity))
+    return;
+
+  if(!m_pimpl->acquire(channel))
   {
-    case severity_level::trace :
-      boost_severity = boost::log::trivial::trace;
-      break;
-    case severity_level::debug :
-      boost_severity = boost::log::trivial::debug;
-      break;
-    case severity_level::info :
-      boost_severity = boost::log::trivial::info;
-      break;
-    case severity_level::warning :
-      boost_severity = boost::log::trivial::warning;
-      break;
-    case severity_level::error :
-      boost_severity = boost::log::trivial::error;
-      break;
-    case severity_level::fatal :
-      boost_severity = boost::log::trivial::fatal;
-      break;
-    default:
-      throw InvalidArgumentException() << ErrorDescription(TE_TR("Invalid severity level."));
-      break;
+    m_pimpl->m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  if(m_pimpl->m_async.load(std::memory_order_acquire))
+  {
+// the fatal messages are written right away, after the previous ones
+    if(severity == severity_level::fatal)
+    {
+      flush();
+    }
+    else
+    {
+      std::unique_ptr<Record> r(new Record);
+      r->m_message = message;
+      r->m_channel = channel;
+      r->m_severity = boost_severity;
+      r->m_time = boost::posix_time::microsec_clock::local_time();
+
+      if(m_pimpl->m_queue->bounded_push(r.get()))
+      {
+        r.release();
+        m_pimpl->m_queued.fetch_add(1);
+      }
+      else
+      {
+        m_pimpl->m_dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      return;
+    }
   }
 
   BOOST_LOG_CHANNEL_SEV(m_pimpl->m_logger, channel, boost_severity) << message;
 }
 
+void te::core::Logger::setSeverityLevel(severity_level severity)
+{
+  m_severity.store(static_cast<int>(severity));
+}
+
+te::core::Logger::severity_level te::core::Logger::getSeverityLevel() const
+{
+  return static_cast<severity_level>(m_severity.load());
+}
+
+void te::core::Logger::startAsync(std::size_t queueSize)
+{
+  if(isAsync())
+    return;
+
+  if(queueSize == 0 || queueSize > 65534)
+    throw te::InvalidArgumentException() << te::ErrorDescription(TE_TR("The logger queue size must be between 1 and 65534."));
+
+  m_pimpl->m_queue.reset(new boost::lockfree::queue<Record*, boost::lockfree::fixed_sized<true> >(queueSize));
+  m_pimpl->m_running = true;
+  m_pimpl->m_writer = boost::thread(&Impl::write, m_pimpl);
+  m_pimpl->m_async.store(true, std::memory_order_release);
+}
+
+void te::core::Logger::stopAsync()
+{
+  if(!isAsync())
+    return;
+
+  m_pimpl->m_async.store(false, std::memory_order_release);
+  m_pimpl->m_running = false;
+
+  {
+    boost::lock_guard<boost::mutex> lock(m_pimpl->m_mtx);
+    m_pimpl->m_queuedCond.notify_one();
+  }
+
+  m_pimpl->m_writer.join();
+
+// the messages queued while the writer was stopping
+  m_pimpl->drain();
+
+  m_pimpl->m_queue.reset();
+}
+
+bool te::core::Logger::isAsync() const
+{
+  return m_pimpl->m_async.load();
+}
+
+void te::core::Logger::flush()
+{
+  if(!isAsync())
+    return;
 
+  const unsigned long long queued = m_pimpl->m_queued.load();
+
+  boost::unique_lock<boost::mutex> lock(m_pimpl->m_mtx);
+
+  m_pimpl->m_queuedCond.notify_one();
+
+  while(m_pimpl->m_written.load() < queued)
+    m_pimpl->m_writtenCond.timed_wait(lock, boost::posix_time::milliseconds(10));
+}
+
+void te::core::Logger::setRateLimit(const std::string& channel, std::size_t maxMessagesPerSecond)
+{
+  boost::unique_lock<boost::shared_mutex> lock(m_pimpl->m_rateLimitsMtx);
+
+  if(maxMessagesPerSecond == 0)
+    m_pimpl->m_rateLimits.erase(channel);
+  else
+    m_pimpl->m_rateLimits[channel].reset(new RateLimit(maxMessagesPerSecond));
+
+  m_pimpl->m_hasRateLimits = !m_pimpl->m_rateLimits.empty();
+}
+
+unsigned long long te::core::Logger::getDroppedMessages() const
+{
+  return m_pimpl->m_dropped.load();
+}
@@ -36,6 +36,11 @@
 #include "../utils/Platform.h"
 #include "../../BuildConfig.h"
 
+// STL
+#include <atomic>
+#include <cstddef>
+#include <string>
+
 #if TE_PLATFORM == TE_PLATFORMCODE_MSWINDOWS
   #define CURRENT_FUNCTION std::string(__FUNCTION__)
 #else
@@ -128,6 +133,80 @@ namespace te
          */
         void removeAllLoggers();
 
+        /*!
+          \brief It sets the minimum severity of the messages that are logged.
+
+          \param severity The minimum severity. The default is trace (all the messages are logged).
+
+          \note The TE_CORE_LOG_* macros check the severity before evaluating the message expression,
+                so the messages of disabled levels are not even formatted.
+         */
+        void setSeverityLevel(severity_level severity);
+
+        /*! \brief It returns the minimum severity of the messages that are logged. */
+        severity_level getSeverityLevel() const;
+
+        /*!
+          \brief It returns true if the messages with the given severity are logged.
+
+          \param severity The severity to be checked.
+
+          \return True if the severity is enabled.
+         */
+        bool isEnabled(severity_level severity) const
+        {
+          return static_cast<int>(severity) >= m_severity.load(std::memory_order_relaxed);
+        }
+
+        /*!
+          \brief It starts the asynchronous mode.
+
+          In this mode the log calls only put the message in a bounded lock-free queue, and
+          a dedicated thread writes the queued messages to the logger sinks. When the queue
+          is full the message is dropped instead of blocking the caller. Fatal messages are
+          never queued: the queue is flushed and they are written by the caller.
+
+          \param queueSize The maximum number of queued messages (up to 65534).
+
+          \note It must not be called concurrently with the log calls: start the asynchronous
+                mode after adding the loggers, at the application startup.
+
+          \note The TimeStamp attribute of the queued messages is the time of the log call,
+                but the ThreadID attribute is the one of the writer thread.
+         */
+        void startAsync(std::size_t queueSize = TE_CORE_LOGGER_QUEUE_SIZE);
+
+        /*!
+          \brief It writes the queued messages and stops the writer thread.
+
+          \note It must not be called concurrently with the log calls.
+         */
+        void stopAsync();
+
+        /*! \brief It returns true if the asynchronous mode is active. */
+        bool isAsync() const;
+
+        /*! \brief It blocks until all the messages queued before the call are written. */
+        void flush();
+
+        /*!
+          \brief It limits the number of messages per second of a channel.
+
+          The messages above the limit in each second are dropped. It is meant for the
+          algorithms that may log a warning per feature.
+
+          \param channel              The channel name.
+          \param maxMessagesPerSecond The maximum number of messages per second (0 removes the limit).
+         */
+        void setRateLimit(const std::string& channel, std::size_t maxMessagesPerSecond);
+
+        /*!
+          \brief It returns the number of dropped messages, because of a full queue or a rate limit.
+
+          \return The number of dropped messages since the logger was created.
+         */
+        unsigned long long getDroppedMessages() const;
+
       private:
 
         /*! \brief Singleton constructor must be private or protected. */
@@ -148,6 +227,8 @@ namespace te
 
         Impl* m_pimpl;
 
+        std::atomic<int> m_severity;   //!< The minimum severity of the logged messages.
+
 
     };
   } //end namespace core
@@ -207,7 +288,9 @@ namespace te
   \param message The message to be logged.
  */
 #ifdef TERRALIB_LOGGER_TRACE_ENABLED
-  #define TE_CORE_LOG_TRACE(channel, message) te::core::Logger::instance().log(message, channel ,te::core::Logger::severity_level::trace)
+  #define TE_CORE_LOG_TRACE(channel, message) \
+    (te::core::Logger::instance().isEnabled(te::core::Logger::severity_level::trace) ? \
+     te::core::Logger::instance().log(message, channel, te::core::Logger::severity_level::trace) : (void)0)
 #else
   #define TE_CORE_LOG_TRACE(channel, message) ((void)0)
 #endif
@@ -221,7 +304,9 @@ namespace te
   \param message The message to be logged.
  */
 #ifdef TERRALIB_LOGGER_DEBUG_ENABLED
-  #define TE_CORE_LOG_DEBUG(channel, message) te::core::Logger::instance().log(message, channel ,te::core::Logger::severity_level::debug)
+  #define TE_CORE_LOG_DEBUG(channel, message) \
+    (te::core::Logger::instance().isEnabled(te::core::Logger::severity_level::debug) ? \
+     te::core::Logger::instance().log(message, channel, te::core::Logger::severity_level::debug) : (void)0)
 #else
   #define TE_CORE_LOG_DEBUG(channel, message) ((void)0)
 #endif
@@ -235,7 +320,9 @@ namespace te
   \param message The message to be logged.
  */
 #ifdef TERRALIB_LOGGER_INFO_ENABLED
-  #define TE_CORE_LOG_INFO(channel, message) te::core::Logger::instance().log(message, channel ,te::core::Logger::severity_level::info)
+  #define TE_CORE_LOG_INFO(channel, message) \
+    (te::core::Logger::instance().isEnabled(te::core::Logger::severity_level::info) ? \
+     te::core::Logger::instance().log(message, channel, te::core::Logger::severity_level::info) : (void)0)
 #else
   #define TE_CORE_LOG_INFO(channel, message) ((void)0)
 #endif
@@ -249,7 +336,9 @@ namespace te
   \param message The message to be logged.
  */
 #ifdef TERRALIB_LOGGER_WARN_ENABLED
-  #define TE_CORE_LOG_WARN(channel, message) te::core::Logger::instance().log(message, channel ,te::core::Logger::severity_level::warning)
+  #define TE_CORE_LOG_WARN(channel, message) \
+    (te::core::Logger::instance().isEnabled(te::core::Logger::severity_level::warning) ? \
+     te::core::Logger::instance().log(message, channel, te::core::Logger::severity_level::warning) : (void)0)
 #else
   #define TE_CORE_LOG_WARN(channel, message) ((void)0)
 #endif
@@ -263,7 +352,9 @@ namespace te
   \param message The message to be logged.
  */
 #ifdef TERRALIB_LOGGER_ERROR_ENABLED
-  #define TE_CORE_LOG_ERROR(channel, message) te::core::Logger::instance().log(message, channel ,te::core::Logger::severity_level::error)
+  #define TE_CORE_LOG_ERROR(channel, message) \
+    (te::core::Logger::instance().isEnabled(te::core::Logger::severity_level::error) ? \
+     te::core::Logger::instance().log(message, channel, te::core::Logger::severity_level::error) : (void)0)
 #else
   #define TE_CORE_LOG_ERROR(channel, message) ((void)0)
 #endif
@@ -277,7 +368,9 @@ namespace te
   \param message The message to be logged.
  */
 #ifdef TERRALIB_LOGGER_FATAL_ENABLED
-  #define TE_CORE_LOG_FATAL(channel, message) te::core::Logger::instance().log(message, channel ,te::core::Logger::severity_level::fatal)
+  #define TE_CORE_LOG_FATAL(channel, message) \
+    (te::core::Logger::instance().isEnabled(te::core::Logger::severity_level::fatal) ? \
+     te::core::Logger::instance().log(message, channel, te::core::Logger::severity_level::fatal) : (void)0)
 #else
   #define TE_CORE_LOG_FATAL(channel, message) ((void)0)
 #endif
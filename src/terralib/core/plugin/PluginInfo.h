@@ -74,6 +74,7 @@ namespace te
       Provider provider;                         //!< Information about the plugin provider.
       std::vector<std::string> dependencies;     //!< The list of required plugins in order to launch the plugin.
       std::vector<std::string> linked_libraries; //!< The list of linked libraries.
+      std::vector<std::string> provides;         //!< The data source types and factory keys registered by the plugin: used to load it on first use.
       std::vector<Resource> resources;           //!< The list of resources used by plugin.
       std::vector<Parameter> parameters;         //!< Any configuration parameter that can be informed to plugin (map: parameter-name -> parameter-value).
       HostApplication host_application;          //!< Information about the host system. May be used to validate the plugin version.
@@ -37,14 +37,38 @@
 #include "PluginEngineManager.h"
 
 // STL
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <map>
 
 // Boost
 #include <boost/algorithm/string/join.hpp>
 #include <boost/format.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace
+{
+  double SecondsSince(const std::chrono::steady_clock::time_point& start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start).count();
+  }
+}
 
 struct te::core::PluginManager::Impl
 {
+  /*! \brief A plugin whose code was loaded by a worker thread. */
+  struct PreloadedPlugin
+  {
+    std::unique_ptr<AbstractPlugin> plugin;
+    std::exception_ptr error;
+    double load_seconds = 0.0;
+  };
+
   /*! \brief The list of managed plugins: this will be needed to unload
      accordinly the plugins! */
   std::vector<std::shared_ptr<AbstractPlugin> > plugins;
@@ -54,7 +78,19 @@ struct te::core::PluginManager::Impl
   std::vector<PluginInfo> broken_plugins;
   /*! \brief The list of plugins dependencies */
   std::map<std::string, std::vector<std::string> > dependency_map;
-
+  /*! \brief The time spent loading each plugin. */
+  std::vector<PluginLoadTime> load_times;
+  /*! \brief It serializes the plugins loaded on demand. */
+  boost::recursive_mutex resolve_mtx;
+  /*! \brief True while loading the plugin that provides a key. */
+  bool resolving = false;
+
+  void load(PluginManager& manager, const std::string& plugin_name,
+            const bool start, PreloadedPlugin* preloaded);
+  void load_with_dependencies(PluginManager& manager,
+                              const std::string& plugin_name,
+                              const bool start,
+                              std::vector<std::string>& visiting);
   void move_from_unload_to_broken_list(std::size_t plugin_pos);
   void move_from_broken_to_unloaded_list(std::size_t plugin_pos);
 };
@@ -290,159 +326,204 @@ void te::core::PluginManager::remove(const std::string& plugin_name)
 void te::core::PluginManager::load(const std::string& plugin_name,
                                    const bool start)
 {
-  // if plugin is already loaded raise an exception
-  if(isLoaded(plugin_name))
-  {
-    boost::format err_msg(TE_TR("The plugin '%1%' is already loaded."));
+  m_pimpl->load(*this, plugin_name, start, nullptr);
+}
 
-    throw InvalidArgumentException()
-        << ErrorDescription((err_msg % plugin_name).str());
-  }
+void te::core::PluginManager::load(const std::vector<std::string>& plugin_names,
+                                   const bool start, std::size_t nthreads)
+{
+  std::vector<PluginInfo> pending;
 
-  // if plugin is not in the broken list nor in the unloaded list raise an
-  // exception
-  if(!isBroken(plugin_name) && !isUnloaded(plugin_name))
+  for(const std::string& plugin_name : plugin_names)
   {
-    boost::format err_msg(
-        TE_TR("The plugin '%1%' is not registered in the manager."));
-
-    throw InvalidArgumentException()
-        << ErrorDescription((err_msg % plugin_name).str());
+    if(!isLoaded(plugin_name))
+      pending.push_back(getPluginInfo(plugin_name));
   }
 
-  // in which list and position is the plugin_info?
-  bool found_in_unloaded_list = false;
-  bool found_in_broken_list = false;
+  if(nthreads == 0)
+    nthreads = std::max(boost::thread::hardware_concurrency(), 1u);
 
-  std::size_t plugin_pos = 0;
+  std::vector<std::string> failed;
 
-  for(; plugin_pos != m_pimpl->unloaded_plugins.size(); ++plugin_pos)
+  while(!pending.empty())
   {
-    if(m_pimpl->unloaded_plugins[plugin_pos].name == plugin_name)
-    {
-      found_in_unloaded_list = true;
-      break;
-    }
-  }
+    // split the pending plugins in the ones ready to be loaded, the ones
+    // waiting for a plugin in the list and the ones missing a dependency
+    std::vector<PluginInfo> level;
+    std::vector<PluginInfo> waiting;
+    std::vector<std::string> blocked;
 
-  if(!found_in_unloaded_list)
-  {
-    for(plugin_pos = 0; plugin_pos != m_pimpl->broken_plugins.size();
-        ++plugin_pos)
+    for(const PluginInfo& pinfo : pending)
     {
-      if(m_pimpl->broken_plugins[plugin_pos].name == plugin_name)
+      bool ready = true;
+      bool missing = false;
+
+      for(const std::string& plugin_dependency : pinfo.dependencies)
       {
-        found_in_broken_list = true;
-        break;
+        if(isLoaded(plugin_dependency))
+          continue;
+
+        ready = false;
+
+        if(std::find_if(pending.begin(), pending.end(),
+                        [&plugin_dependency](const PluginInfo& p) {
+                          return p.name == plugin_dependency;
+                        }) == pending.end())
+          missing = true;
       }
+
+      if(ready)
+        level.push_back(pinfo);
+      else if(missing)
+        blocked.push_back(pinfo.name);
+      else
+        waiting.push_back(pinfo);
     }
 
-    if(!found_in_broken_list)
+    // if no plugin is ready, the remaining ones depend on each other
+    if(level.empty())
     {
-      boost::format err_msg(TE_TR("Could not find plugin: '%1%'."));
+      for(const PluginInfo& pinfo : waiting)
+        blocked.push_back(pinfo.name);
 
-      throw OutOfRangeException()
-          << ErrorDescription((err_msg % plugin_name).str());
+      waiting.clear();
     }
-  }
 
-  // get plugin_info (make a temp copy to avoid loose references!)
-  PluginInfo pinfo = found_in_unloaded_list
-                         ? m_pimpl->unloaded_plugins[plugin_pos]
-                         : m_pimpl->broken_plugins[plugin_pos];
+    // the single load reports the missing dependencies and moves the plugin
+    // to the broken list
+    for(const std::string& plugin_name : blocked)
+    {
+      try
+      {
+        m_pimpl->load(*this, plugin_name, start, nullptr);
+      }
+      catch(...)
+      {
+        failed.push_back(plugin_name);
+      }
+    }
 
-  // check if required plugins is already loaded
-  std::vector<std::string> missing_deps;
-  for(const std::string& plugin_dependency : pinfo.dependencies)
-  {
-    if(!isLoaded(plugin_dependency))
-      missing_deps.push_back(plugin_dependency);
-  }
-  if(!missing_deps.empty())
-  {
-    if(found_in_unloaded_list)
-      m_pimpl->move_from_unload_to_broken_list(plugin_pos);
+    // load the code of the plugins of this level in parallel...
+    std::vector<Impl::PreloadedPlugin> preloaded(level.size());
+    std::atomic<std::size_t> next_plugin(0);
 
-    boost::format err_msg(
-        TE_TR("Plugin '%1%' has the following dependency: '%2%'."));
+    auto load_code = [&level, &preloaded, &next_plugin]()
+    {
+      for(std::size_t i = next_plugin++; i < level.size(); i = next_plugin++)
+      {
+        const auto t0 = std::chrono::steady_clock::now();
 
-    throw PluginLoadException()
-        << ErrorDescription((err_msg % plugin_name %
-                             boost::algorithm::join(missing_deps, ", ")).str());
-  }
+        try
+        {
+          AbstractPluginEngine& engine =
+              PluginEngineManager::instance().get(level[i].engine);
 
-  std::unique_ptr<AbstractPlugin> plugin(nullptr);
+          preloaded[i].plugin = engine.load(level[i]);
+        }
+        catch(...)
+        {
+          preloaded[i].error = std::current_exception();
+        }
 
-  try
-  {
-    // if everything is ready for loading the plugin let's call the underlying
-    // engine to load the plugin
-    AbstractPluginEngine& engine =
-        PluginEngineManager::instance().get(pinfo.engine);
+        preloaded[i].load_seconds = SecondsSince(t0);
+      }
+    };
 
-    plugin = engine.load(pinfo);
+    const std::size_t nworkers = std::min(nthreads, level.size());
 
-    if(plugin.get() == nullptr)
+    if(nworkers > 1)
     {
-      boost::format err_msg(TE_TR("Could not load plugin: '%1%'."));
-
-      throw PluginLoadException()
-          << ErrorDescription((err_msg % plugin_name).str());
-    }
-
-    if(start)
-      plugin->startup();
-
-    m_pimpl->dependency_map[pinfo.name] = {};
+      boost::thread_group workers;
 
-    for(const std::string& plugin_dependency : pinfo.dependencies)
-      m_pimpl->dependency_map[plugin_dependency].push_back(pinfo.name);
+      for(std::size_t i = 1; i < nworkers; ++i)
+        workers.create_thread(load_code);
 
-    m_pimpl->plugins.push_back(
-        std::shared_ptr<AbstractPlugin>(plugin.release()));
+      load_code();
 
-    if(found_in_unloaded_list)
-    {
-      m_pimpl->unloaded_plugins.erase(m_pimpl->unloaded_plugins.begin() +
-                                      plugin_pos);
+      workers.join_all();
     }
-    else if(found_in_broken_list)
+    else
     {
-      m_pimpl->broken_plugins.erase(m_pimpl->broken_plugins.begin() +
-                                    plugin_pos);
+      load_code();
     }
-    else
+
+    // ...and start them in order in this thread
+    for(std::size_t i = 0; i != level.size(); ++i)
     {
-      boost::format err_msg(
-          TE_TR("Unexpected error after loading plugin: '%1%'."));
-      throw PluginLoadException()
-          << ErrorDescription((err_msg % plugin_name).str());
+      try
+      {
+        m_pimpl->load(*this, level[i].name, start, &preloaded[i]);
+      }
+      catch(...)
+      {
+        failed.push_back(level[i].name);
+      }
     }
+
+    pending.swap(waiting);
   }
-  catch(const boost::exception& e)
+
+  if(!failed.empty())
   {
-    // WARNING: if plugin goes out-of scope the exception thrown exception is
-    // not valid this is why we make a copy here
-    if(found_in_unloaded_list)
-      m_pimpl->move_from_unload_to_broken_list(plugin_pos);
+    boost::format err_msg(
+        TE_TR("Could not load the following plugins:\n\n%1%"));
 
-    if(const std::string* d = boost::get_error_info<ErrorDescription>(e))
-    {
-      throw PluginLoadException() << ErrorDescription(*d);
-    }
-    else
-    {
-      boost::format err_msg(TE_TR("Unknown error loading plugin: %1%."));
-      throw PluginLoadException()
-          << ErrorDescription((err_msg % pinfo.name).str());
-    }
+    throw PluginLoadException() << ErrorDescription(
+        (err_msg % boost::algorithm::join(failed, "\n")).str());
+  }
+}
+
+void te::core::PluginManager::loadWithDependencies(
+    const std::string& plugin_name, const bool start)
+{
+  std::vector<std::string> visiting;
+
+  m_pimpl->load_with_dependencies(*this, plugin_name, start, visiting);
+}
+
+bool te::core::PluginManager::resolve(const std::string& key)
+{
+  boost::lock_guard<boost::recursive_mutex> lock(m_pimpl->resolve_mtx);
+
+  // only the plugins waiting to be loaded are tried: a broken plugin is not
+  // loaded again at each lookup of a missing key
+  auto it = std::find_if(m_pimpl->unloaded_plugins.begin(),
+                         m_pimpl->unloaded_plugins.end(),
+                         [&key](const PluginInfo& p) {
+                           return std::find(p.provides.begin(),
+                                            p.provides.end(),
+                                            key) != p.provides.end();
+                         });
+
+  if(it == m_pimpl->unloaded_plugins.end())
+    return false;
+
+  const std::string plugin_name = it->name;
+
+  const bool resolving = m_pimpl->resolving;
+
+  m_pimpl->resolving = true;
+
+  try
+  {
+    loadWithDependencies(plugin_name, true);
   }
   catch(...)
   {
-    boost::format err_msg(TE_TR("Unknown error loading plugin: %1%."));
-    throw PluginLoadException()
-        << ErrorDescription((err_msg % pinfo.name).str());
+    m_pimpl->resolving = resolving;
+
+    return false;
   }
+
+  m_pimpl->resolving = resolving;
+
+  return true;
+}
+
+std::vector<te::core::PluginLoadTime> te::core::PluginManager::getLoadTimes()
+    const
+{
+  return m_pimpl->load_times;
 }
 
 void te::core::PluginManager::start(const std::string& plugin_name)
@@ -559,6 +640,7 @@ void te::core::PluginManager::clear()
   m_pimpl->broken_plugins.clear();
   m_pimpl->dependency_map.clear();
   m_pimpl->unloaded_plugins.clear();
+  m_pimpl->load_times.clear();
 }
 
 te::core::PluginManager& te::core::PluginManager::instance()
@@ -578,6 +660,229 @@ te::core::PluginManager::~PluginManager()
   delete m_pimpl;
 }
 
+void te::core::PluginManager::Impl::load(PluginManager& manager,
+                                         const std::string& plugin_name,
+                                         const bool start,
+                                         PreloadedPlugin* preloaded)
+{
+  // if plugin is already loaded raise an exception
+  if(manager.isLoaded(plugin_name))
+  {
+    boost::format err_msg(TE_TR("The plugin '%1%' is already loaded."));
+
+    throw InvalidArgumentException()
+        << ErrorDescription((err_msg % plugin_name).str());
+  }
+
+  // if plugin is not in the broken list nor in the unloaded list raise an
+  // exception
+  if(!manager.isBroken(plugin_name) && !manager.isUnloaded(plugin_name))
+  {
+    boost::format err_msg(
+        TE_TR("The plugin '%1%' is not registered in the manager."));
+
+    throw InvalidArgumentException()
+        << ErrorDescription((err_msg % plugin_name).str());
+  }
+
+  // in which list and position is the plugin_info?
+  bool found_in_unloaded_list = false;
+  bool found_in_broken_list = false;
+
+  std::size_t plugin_pos = 0;
+
+  for(; plugin_pos != unloaded_plugins.size(); ++plugin_pos)
+  {
+    if(unloaded_plugins[plugin_pos].name == plugin_name)
+    {
+      found_in_unloaded_list = true;
+      break;
+    }
+  }
+
+  if(!found_in_unloaded_list)
+  {
+    for(plugin_pos = 0; plugin_pos != broken_plugins.size();
+        ++plugin_pos)
+    {
+      if(broken_plugins[plugin_pos].name == plugin_name)
+      {
+        found_in_broken_list = true;
+        break;
+      }
+    }
+
+    if(!found_in_broken_list)
+    {
+      boost::format err_msg(TE_TR("Could not find plugin: '%1%'."));
+
+      throw OutOfRangeException()
+          << ErrorDescription((err_msg % plugin_name).str());
+    }
+  }
+
+  // get plugin_info (make a temp copy to avoid loose references!)
+  PluginInfo pinfo = found_in_unloaded_list
+                         ? unloaded_plugins[plugin_pos]
+                         : broken_plugins[plugin_pos];
+
+  // check if required plugins is already loaded
+  std::vector<std::string> missing_deps;
+  for(const std::string& plugin_dependency : pinfo.dependencies)
+  {
+    if(!manager.isLoaded(plugin_dependency))
+      missing_deps.push_back(plugin_dependency);
+  }
+  if(!missing_deps.empty())
+  {
+    if(found_in_unloaded_list)
+      move_from_unload_to_broken_list(plugin_pos);
+
+    boost::format err_msg(
+        TE_TR("Plugin '%1%' has the following dependency: '%2%'."));
+
+    throw PluginLoadException()
+        << ErrorDescription((err_msg % plugin_name %
+                             boost::algorithm::join(missing_deps, ", ")).str());
+  }
+
+  std::unique_ptr<AbstractPlugin> plugin(nullptr);
+
+  try
+  {
+    PluginLoadTime load_time = {pinfo.name, 0.0, 0.0, resolving};
+
+    if(preloaded == nullptr)
+    {
+      // if everything is ready for loading the plugin let's call the
+      // underlying engine to load the plugin
+      const auto t0 = std::chrono::steady_clock::now();
+
+      AbstractPluginEngine& engine =
+          PluginEngineManager::instance().get(pinfo.engine);
+
+      plugin = engine.load(pinfo);
+
+      load_time.load_seconds = SecondsSince(t0);
+    }
+    else
+    {
+      // the code was already loaded by a worker thread
+      load_time.load_seconds = preloaded->load_seconds;
+
+      if(preloaded->error)
+        std::rethrow_exception(preloaded->error);
+
+      plugin = std::move(preloaded->plugin);
+    }
+
+    if(plugin.get() == nullptr)
+    {
+      boost::format err_msg(TE_TR("Could not load plugin: '%1%'."));
+
+      throw PluginLoadException()
+          << ErrorDescription((err_msg % plugin_name).str());
+    }
+
+    if(start)
+    {
+      const auto t0 = std::chrono::steady_clock::now();
+
+      plugin->startup();
+
+      load_time.startup_seconds = SecondsSince(t0);
+    }
+
+    dependency_map[pinfo.name] = {};
+
+    for(const std::string& plugin_dependency : pinfo.dependencies)
+      dependency_map[plugin_dependency].push_back(pinfo.name);
+
+    plugins.push_back(
+        std::shared_ptr<AbstractPlugin>(plugin.release()));
+
+    load_times.push_back(load_time);
+
+    if(found_in_unloaded_list)
+    {
+      unloaded_plugins.erase(unloaded_plugins.begin() +
+                                      plugin_pos);
+    }
+    else if(found_in_broken_list)
+    {
+      broken_plugins.erase(broken_plugins.begin() +
+                                    plugin_pos);
+    }
+    else
+    {
+      boost::format err_msg(
+          TE_TR("Unexpected error after loading plugin: '%1%'."));
+      throw PluginLoadException()
+          << ErrorDescription((err_msg % plugin_name).str());
+    }
+  }
+  catch(const boost::exception& e)
+  {
+    // WARNING: if plugin goes out-of scope the exception thrown exception is
+    // not valid this is why we make a copy here
+    if(found_in_unloaded_list)
+      move_from_unload_to_broken_list(plugin_pos);
+
+    if(const std::string* d = boost::get_error_info<ErrorDescription>(e))
+    {
+      throw PluginLoadException() << ErrorDescription(*d);
+    }
+    else
+    {
+      boost::format err_msg(TE_TR("Unknown error loading plugin: %1%."));
+      throw PluginLoadException()
+          << ErrorDescription((err_msg % pinfo.name).str());
+    }
+  }
+  catch(...)
+  {
+    boost::format err_msg(TE_TR("Unknown error loading plugin: %1%."));
+    throw PluginLoadException()
+        << ErrorDescription((err_msg % pinfo.name).str());
+  }
+}
+
+void te::core::PluginManager::Impl::load_with_dependencies(
+    PluginManager& manager, const std::string& plugin_name, const bool start,
+    std::vector<std::string>& visiting)
+{
+  if(manager.isLoaded(plugin_name))
+    return;
+
+  if(std::find(visiting.begin(), visiting.end(), plugin_name) !=
+     visiting.end())
+  {
+    visiting.push_back(plugin_name);
+
+    boost::format err_msg(
+        TE_TR("The plugin '%1%' depends on itself: %2%."));
+
+    throw PluginCyclicDependencyException() << ErrorDescription(
+        (err_msg % plugin_name % boost::algorithm::join(visiting, " -> "))
+            .str());
+  }
+
+  visiting.push_back(plugin_name);
+
+  // the dependencies not registered are reported by the plugin load
+  const PluginInfo pinfo = manager.getPluginInfo(plugin_name);
+
+  for(const std::string& plugin_dependency : pinfo.dependencies)
+  {
+    if(manager.exists(plugin_dependency))
+      load_with_dependencies(manager, plugin_dependency, start, visiting);
+  }
+
+  load(manager, plugin_name, start, nullptr);
+
+  visiting.pop_back();
+}
+
 void te::core::PluginManager::Impl::move_from_unload_to_broken_list(
     std::size_t plugin_pos)
 {
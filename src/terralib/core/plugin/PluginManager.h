@@ -35,15 +35,35 @@
 #include "../Config.h"
 #include "PluginInfo.h"
 
+// STL
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace te
 {
   namespace core
   {
+    /*! \brief The time spent loading a plugin. */
+    struct PluginLoadTime
+    {
+      std::string name;         //!< The plugin name.
+      double load_seconds;      //!< The time spent loading the plugin's code (shared library and entry point).
+      double startup_seconds;   //!< The time spent in the plugin's startup.
+      bool on_demand;           //!< True if the plugin was loaded on the first use of a key it provides.
+    };
+
     /*!
       \class PluginManager
       \brief A singleton for managing plugins.
 
-      \note Methods in this class are not thread-safe.
+      The plugins can be loaded all at once, when the application starts, or
+      only registered and then loaded on demand: the first time a data source
+      type or factory key is not found, the module that owns the factory calls
+      resolve() and the plugin that provides the key is loaded with its
+      dependencies.
+
+      \note Methods in this class are not thread-safe, except resolve().
      */
     class TECOREEXPORT PluginManager
     {
@@ -168,6 +188,72 @@ namespace te
        */
       void load(const std::string& plugin_name, const bool start = true);
 
+      /*!
+        \brief It loads a set of plugins, loading the code of the independent
+        plugins in parallel.
+
+        The plugins are loaded by dependency levels: the shared libraries of
+        the plugins whose dependencies are already loaded are loaded by a pool
+        of threads and then they are started in order by the calling thread,
+        as their startup usually registers factories in global tables.
+
+        \param plugin_names The plugins to be loaded. Their dependencies must
+        be loaded or be in the list.
+        \param start        If true the plugins are started after being
+        loaded.
+        \param nthreads     The number of threads (0 for the number of
+        hardware threads, 1 for a sequential load).
+
+        \exception te::core::PluginLoadException It throws an exception listing
+        the plugins that could not be loaded, after trying to load all the
+        others. These plugins are moved to the broken list.
+
+        \note The plugins already loaded are skipped.
+       */
+      void load(const std::vector<std::string>& plugin_names,
+                const bool start = true, std::size_t nthreads = 0);
+
+      /*!
+        \brief It loads a plugin after loading its registered dependencies
+        that are not loaded yet.
+
+        \param plugin_name The plugin to be loaded.
+        \param start       If true the plugins are started after being loaded.
+
+        \exception te::core::PluginLoadException It throws an exception if the
+        plugin or one of its dependencies can not be loaded.
+        \exception te::core::PluginCyclicDependencyException If the
+        dependencies have a cycle.
+       */
+      void loadWithDependencies(const std::string& plugin_name,
+                                const bool start = true);
+
+      /*!
+        \brief It loads the plugin that provides the given data source type or
+        factory key, if there is one registered and not loaded yet.
+
+        The factories call this method when a key is not found, so an
+        application can just register the plugins at startup and pay for a
+        plugin only when it is used.
+
+        \param key A data source type or a factory key (see
+        PluginInfo::provides).
+
+        \return True if a plugin was loaded and started, false if there is no
+        plugin providing the key waiting to be loaded or if it failed to load
+        (it is moved to the broken list and not tried again).
+
+        \note This method can be called by several threads: the loads are
+        serialized.
+       */
+      bool resolve(const std::string& key);
+
+      /*!
+        \brief It returns the time spent loading each plugin, in the order
+        the plugins were loaded.
+       */
+      std::vector<PluginLoadTime> getLoadTimes() const;
+
       /*!
         \brief Start a loaded plugin.
 
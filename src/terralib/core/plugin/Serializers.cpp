@@ -70,6 +70,16 @@ te::core::PluginInfo te::core::JSONPluginInfoSerializer(
   for (const boost::property_tree::ptree::value_type& v :
        doc.get_child("dependencies"))
     plugin.dependencies.push_back(v.second.get_value<std::string>());
+
+  boost::optional<boost::property_tree::ptree&> provides =
+      doc.get_child_optional("provides");
+
+  if(provides)
+  {
+    for(const boost::property_tree::ptree::value_type& v : *provides)
+      plugin.provides.push_back(v.second.get_value<std::string>());
+  }
+
   for(const boost::property_tree::ptree::value_type& v :
        doc.get_child("resources"))
   {
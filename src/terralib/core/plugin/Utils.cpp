@@ -37,6 +37,10 @@
 #include "PluginEngineManager.h"
 #include "PluginManager.h"
 
+// STL
+#include <algorithm>
+#include <sstream>
+
 // Boost
 #include <boost/algorithm/string/join.hpp>
 #include <boost/format.hpp>
@@ -134,7 +138,7 @@ std::vector<te::core::PluginInfo> te::core::plugin::TopologicalSort(
   return sortedPlugins;
 }
 
-void te::core::plugin::LoadAll(bool start)
+void te::core::plugin::LoadAll(bool start, std::size_t nthreads)
 {
   te::core::PluginManager::instance().clear();
 
@@ -143,19 +147,34 @@ void te::core::plugin::LoadAll(bool start)
   v_pInfo = te::core::plugin::TopologicalSort(v_pInfo);
 
   std::vector<std::string> failToLoad;
+  std::vector<std::string> toLoad;
 
   for(const te::core::PluginInfo& pinfo : v_pInfo)
   {
     try
     {
       te::core::PluginManager::instance().insert(pinfo);
-      te::core::PluginManager::instance().load(pinfo.name, start);
+      toLoad.push_back(pinfo.name);
     }
     catch(...)
     {
       failToLoad.push_back(pinfo.name);
     }
   }
+
+  try
+  {
+    te::core::PluginManager::instance().load(toLoad, start, nthreads);
+  }
+  catch(...)
+  {
+    for(const std::string& plugin_name : toLoad)
+    {
+      if(!te::core::PluginManager::instance().isLoaded(plugin_name))
+        failToLoad.push_back(plugin_name);
+    }
+  }
+
   if(failToLoad.size() > 0)
   {
     boost::format err_msg(
@@ -166,6 +185,51 @@ void te::core::plugin::LoadAll(bool start)
   }
 }
 
+void te::core::plugin::RegisterAll()
+{
+  te::core::PluginManager::instance().clear();
+
+  std::vector<te::core::PluginInfo> v_pInfo = te::core::DefaultPluginFinder();
+
+  for(const te::core::PluginInfo& pinfo : v_pInfo)
+    te::core::PluginManager::instance().insert(pinfo);
+}
+
+std::string te::core::plugin::LoadTimeReport()
+{
+  std::vector<te::core::PluginLoadTime> times =
+      te::core::PluginManager::instance().getLoadTimes();
+
+  std::stable_sort(times.begin(), times.end(),
+                   [](const PluginLoadTime& a, const PluginLoadTime& b) {
+                     return a.load_seconds + a.startup_seconds >
+                            b.load_seconds + b.startup_seconds;
+                   });
+
+  std::ostringstream report;
+
+  report << boost::format("%-32s %12s %12s %12s  %s\n") % TE_TR("Plugin") %
+                TE_TR("Load (s)") % TE_TR("Startup (s)") % TE_TR("Total (s)") %
+                TE_TR("Mode");
+
+  double total = 0.0;
+
+  for(const PluginLoadTime& t : times)
+  {
+    report << boost::format("%-32s %12.4f %12.4f %12.4f  %s\n") % t.name %
+                  t.load_seconds % t.startup_seconds %
+                  (t.load_seconds + t.startup_seconds) %
+                  (t.on_demand ? TE_TR("on demand") : TE_TR("startup"));
+
+    total += t.load_seconds + t.startup_seconds;
+  }
+
+  report << boost::format("%-32s %12s %12s %12.4f\n") % TE_TR("Total") % "" %
+                "" % total;
+
+  return report.str();
+}
+
 void te::core::plugin::UnloadAll()
 {
   std::vector<te::core::PluginInfo> pVec =
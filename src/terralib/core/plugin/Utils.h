@@ -37,6 +37,7 @@
 #include "PluginInfo.h"
 
 // STL
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -55,7 +56,31 @@ namespace te
       TECOREEXPORT std::vector<PluginInfo> TopologicalSort(
           const std::vector<PluginInfo>& v_pinfo);
 
-      TECOREEXPORT void LoadAll(bool start = true);
+      /*!
+        \brief It finds, registers and loads all the plugins.
+
+        \param start    If true the plugins are started after being loaded.
+        \param nthreads The number of threads loading the plugin libraries
+        (0 for the number of hardware threads, 1 for a sequential load).
+
+        \exception te::core::PluginLoadException It throws an exception
+        listing the plugins that could not be loaded.
+       */
+      TECOREEXPORT void LoadAll(bool start = true, std::size_t nthreads = 0);
+
+      /*!
+        \brief It finds and registers all the plugins without loading them.
+
+        The plugins are loaded on demand, when a data source type or factory
+        key they provide is first used (see PluginManager::resolve).
+       */
+      TECOREEXPORT void RegisterAll();
+
+      /*!
+        \brief It returns a table with the time spent loading and starting
+        each plugin, slowest first, to track the startup cost.
+       */
+      TECOREEXPORT std::string LoadTimeReport();
 
       TECOREEXPORT void UnloadAll();
 
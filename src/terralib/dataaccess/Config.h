@@ -63,6 +63,13 @@
 */
 #define TERRALIB_POOL_DEFAULT_MONITORING_TIME 60
 
+/*!
+  \def TE_DA_FILTER_BATCH_SIZE
+  
+  \brief The number of dataset items evaluated at once by a compiled filter program.
+*/
+#define TE_DA_FILTER_BATCH_SIZE 1024
+
 //@}
 
 /** @name DLL/LIB Module
@@ -24,6 +24,7 @@
 */
 
 // TerraLib
+#include "../../BuildConfig.h"
 #include "../../core/encoding/CharEncoding.h"
 #include "../../datatype/DataConverterManager.h"
 #include "../../datatype/SimpleData.h"
@@ -31,9 +32,14 @@
 #include "../../geometry/PointM.h"
 #include "../../geometry/PointZ.h"
 #include "../../geometry/PointZM.h"
+#include "../../geometry/Utils.h"
 #include "AttributeConverters.h"
 #include "DataSet.h"
 
+#ifdef TERRALIB_MOD_SRS_ENABLED
+#include "../../srs/Converter.h"
+#endif
+
 // STL
 #include <cassert>
 #include <memory>
@@ -114,43 +120,87 @@ te::dt::AbstractData* te::da::XYZMToPointConverter(DataSet* dataset, const std::
 }
 
 te::dt::AbstractData* te::da::PointToXConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
+{
+  return new te::dt::Double(PointToXValue(dataset, indexes));
+}
+
+te::dt::AbstractData* te::da::PointToYConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
+{
+  return new te::dt::Double(PointToYValue(dataset, indexes));
+}
+
+te::dt::AbstractData* te::da::PointToZConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
+{
+  return new te::dt::Double(PointToZValue(dataset, indexes));
+}
+
+te::dt::AbstractData* te::da::PointToMConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
+{
+  return new te::dt::Double(PointToMValue(dataset, indexes));
+}
+
+double te::da::PointToXValue(DataSet* dataset, const std::vector<std::size_t>& indexes)
 {
   assert(dataset);
   assert(indexes.size() == 1);
 
-  te::gm::Point* pt = static_cast<te::gm::Point*>(dataset->getGeometry(indexes[0]).get());
+  std::auto_ptr<te::gm::Geometry> geom(dataset->getGeometry(indexes[0]));
 
-  return new te::dt::Double(pt->getX());
+  return static_cast<te::gm::Point*>(geom.get())->getX();
 }
 
-te::dt::AbstractData* te::da::PointToYConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
+double te::da::PointToYValue(DataSet* dataset, const std::vector<std::size_t>& indexes)
 {
   assert(dataset);
   assert(indexes.size() == 1);
 
-  te::gm::Point* pt = static_cast<te::gm::Point*>(dataset->getGeometry(indexes[0]).get());
+  std::auto_ptr<te::gm::Geometry> geom(dataset->getGeometry(indexes[0]));
 
-  return new te::dt::Double(pt->getY());
+  return static_cast<te::gm::Point*>(geom.get())->getY();
 }
 
-te::dt::AbstractData* te::da::PointToZConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
+double te::da::PointToZValue(DataSet* dataset, const std::vector<std::size_t>& indexes)
 {
   assert(dataset);
   assert(indexes.size() == 1);
 
-  te::gm::Point* pt = static_cast<te::gm::Point*>(dataset->getGeometry(indexes[0]).get());
+  std::auto_ptr<te::gm::Geometry> geom(dataset->getGeometry(indexes[0]));
 
-  return new te::dt::Double(pt->getZ());
+  return static_cast<te::gm::Point*>(geom.get())->getZ();
 }
 
-te::dt::AbstractData* te::da::PointToMConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
+double te::da::PointToMValue(DataSet* dataset, const std::vector<std::size_t>& indexes)
 {
   assert(dataset);
   assert(indexes.size() == 1);
 
-  te::gm::Point* pt = static_cast<te::gm::Point*>(dataset->getGeometry(indexes[0]).get());
+  std::auto_ptr<te::gm::Geometry> geom(dataset->getGeometry(indexes[0]));
+
+  return static_cast<te::gm::Point*>(geom.get())->getM();
+}
+
+te::da::DoubleAttributeConverter te::da::GetDoubleAttributeConverter(const AttributeConverter& conv)
+{
+  typedef te::dt::AbstractData* (*ConverterFunction)(DataSet*, const std::vector<std::size_t>&, int);
+
+  const ConverterFunction* f = conv.target<ConverterFunction>();
+
+  if(f == 0)
+    return DoubleAttributeConverter();
 
-  return new te::dt::Double(pt->getM());
+  if(*f == PointToXConverter)
+    return PointToXValue;
+
+  if(*f == PointToYConverter)
+    return PointToYValue;
+
+  if(*f == PointToZConverter)
+    return PointToZValue;
+
+  if(*f == PointToMConverter)
+    return PointToMValue;
+
+  return DoubleAttributeConverter();
 }
 
 te::dt::AbstractData* te::da::TupleToStringConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
@@ -197,7 +247,7 @@ te::dt::AbstractData* te::da::CharEncodingConverter::operator()(DataSet* dataset
   }
 }
 
-te::dt::AbstractData* te::da::SRIDAssociation::operator()(DataSet* dataset, const std::vector<std::size_t>& indexes, int dstType)
+te::dt::AbstractData* te::da::SRIDAssociation::operator()(DataSet* dataset, const std::vector<std::size_t>& indexes, int /*dstType*/)
 {
   assert(indexes.size() == 1);
 
@@ -208,13 +258,38 @@ te::dt::AbstractData* te::da::SRIDAssociation::operator()(DataSet* dataset, cons
   std::auto_ptr<te::gm::Geometry> geom(dataset->getGeometry(indexes[0]));
   assert(geom.get());
 
+  associate(geom.get());
+
+  return geom.release();
+}
+
+void te::da::SRIDAssociation::associate(te::gm::Geometry* geom)
+{
+  assert(geom);
+
   //set input srid
   if (m_inputSRID != TE_UNKNOWN_SRS)
     geom->setSRID(m_inputSRID);
 
   //convert if necessary
-  if (m_outputSRID != TE_UNKNOWN_SRS && m_inputSRID != TE_UNKNOWN_SRS && m_inputSRID != m_outputSRID)
-    geom->transform(m_outputSRID);
+  if (m_outputSRID == TE_UNKNOWN_SRS || m_inputSRID == TE_UNKNOWN_SRS || m_inputSRID == m_outputSRID)
+    return;
 
-  return geom.release();
+#ifdef TERRALIB_MOD_SRS_ENABLED
+  if (!m_converter.get())
+    m_converter.reset(new te::srs::Converter(m_inputSRID, m_outputSRID));
+
+  te::gm::Transform(geom, *m_converter);
+#else
+  geom->transform(m_outputSRID);
+#endif
+}
+
+void te::da::SRIDAssociation::associate(const std::vector<te::gm::Geometry*>& geoms)
+{
+  for (std::size_t i = 0; i < geoms.size(); ++i)
+  {
+    if (geoms[i])
+      associate(geoms[i]);
+  }
 }
@@ -33,6 +33,7 @@
 
 // Boost
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 
 // STL
 #include <vector>
@@ -45,6 +46,16 @@ namespace te
     class AbstractData;
   }
 
+  namespace gm
+  {
+    class Geometry;
+  }
+
+  namespace srs
+  {
+    class Converter;
+  }
+
   namespace da
   {
 // Forward declarations
@@ -81,6 +92,31 @@ namespace te
 
     TEDATAACCESSEXPORT te::dt::AbstractData* PointToMConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int dstType);
 
+    /*!
+      \brief The type of typed attribute converter functions whose destination is a floating point property.
+
+      They receive the same input parameters of an AttributeConverter and return the converted
+      value directly, without allocating a te::dt::AbstractData. The adapted properties must not be null.
+    */
+    typedef boost::function2<double, DataSet*, const std::vector<std::size_t>&> DoubleAttributeConverter;
+
+    TEDATAACCESSEXPORT double PointToXValue(DataSet* dataset, const std::vector<std::size_t>& indexes);
+
+    TEDATAACCESSEXPORT double PointToYValue(DataSet* dataset, const std::vector<std::size_t>& indexes);
+
+    TEDATAACCESSEXPORT double PointToZValue(DataSet* dataset, const std::vector<std::size_t>& indexes);
+
+    TEDATAACCESSEXPORT double PointToMValue(DataSet* dataset, const std::vector<std::size_t>& indexes);
+
+    /*!
+      \brief It returns the typed version of a registered attribute converter function.
+
+      \param conv The attribute converter.
+
+      \return The typed converter or an empty function if the converter has no typed version.
+    */
+    TEDATAACCESSEXPORT DoubleAttributeConverter GetDoubleAttributeConverter(const AttributeConverter& conv);
+
     TEDATAACCESSEXPORT te::dt::AbstractData* TupleToStringConverter(DataSet* dataset, const std::vector<std::size_t>& indexes, int dstType);
 
     struct TEDATAACCESSEXPORT CharEncodingConverter
@@ -97,6 +133,12 @@ namespace te
       te::core::EncodingType m_toCode;
     };
 
+    /*!
+      \brief It associates an SRID to the adapted geometries, converting them to an output SRID if needed.
+
+      The SRS converter is created once and reused for all the geometries, instead of calling
+      te::gm::Geometry::transform (which sets up a new converter) for each one.
+    */
     struct TEDATAACCESSEXPORT SRIDAssociation
     {
       SRIDAssociation(const int& inputSRID, const int& outputSRID = TE_UNKNOWN_SRS) :
@@ -109,8 +151,23 @@ namespace te
 
       te::dt::AbstractData* operator()(DataSet* dataset, const std::vector<std::size_t>& indexes, int dstType);
 
+      /*!
+        \brief It associates the input SRID to the geometry and converts it to the output SRID if needed.
+
+        \param geom The geometry to be changed.
+      */
+      void associate(te::gm::Geometry* geom);
+
+      /*!
+        \brief It associates the input SRID to a batch of geometries, converting them to the output SRID if needed.
+
+        \param geoms The geometries to be changed (null pointers are skipped).
+      */
+      void associate(const std::vector<te::gm::Geometry*>& geoms);
+
       int m_inputSRID;
       int m_outputSRID;
+      boost::shared_ptr<te::srs::Converter> m_converter;  //!< The SRS converter, created on the first conversion.
     };
 
   } // end namespace da
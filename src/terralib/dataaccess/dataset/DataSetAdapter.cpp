@@ -47,6 +47,24 @@
 #include <cassert>
 #include <memory>
 
+namespace
+{
+  /*! \brief It checks if the converter returns the adaptee values unchanged when the data types are the same. */
+  bool IsIdentityConverter(const te::da::AttributeConverter& conv)
+  {
+    typedef te::dt::AbstractData* (*ConverterFunction)(te::da::DataSet*, const std::vector<std::size_t>&, int);
+
+    const ConverterFunction* f = conv.target<ConverterFunction>();
+
+    if(f != 0)
+      return *f == te::da::GenericAttributeConverter;
+
+    const te::da::CharEncodingConverter* cec = conv.target<te::da::CharEncodingConverter>();
+
+    return (cec != 0) && (cec->m_toCode == te::core::EncodingType::UTF8);
+  }
+}
+
 te::da::DataSetAdapter::DataSetAdapter(DataSet* dataset, bool isOwner)
   : m_ds(dataset, isOwner)
 {
@@ -159,6 +177,9 @@ bool te::da::DataSetAdapter::isAfterEnd() const
 
 char te::da::DataSetAdapter::getChar(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getChar(m_passThrough[i]);
+
   std::auto_ptr<te::dt::Char> data(static_cast<te::dt::Char*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -166,6 +187,9 @@ char te::da::DataSetAdapter::getChar(std::size_t i) const
 
 unsigned char te::da::DataSetAdapter::getUChar(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getUChar(m_passThrough[i]);
+
   std::auto_ptr<te::dt::UChar> data(static_cast<te::dt::UChar*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -173,6 +197,9 @@ unsigned char te::da::DataSetAdapter::getUChar(std::size_t i) const
 
 boost::int16_t te::da::DataSetAdapter::getInt16(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getInt16(m_passThrough[i]);
+
   std::auto_ptr<te::dt::Int16> data(static_cast<te::dt::Int16*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -180,6 +207,9 @@ boost::int16_t te::da::DataSetAdapter::getInt16(std::size_t i) const
 
 boost::int32_t te::da::DataSetAdapter::getInt32(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getInt32(m_passThrough[i]);
+
   std::auto_ptr<te::dt::Int32> data(static_cast<te::dt::Int32*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -187,6 +217,9 @@ boost::int32_t te::da::DataSetAdapter::getInt32(std::size_t i) const
 
 boost::int64_t te::da::DataSetAdapter::getInt64(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getInt64(m_passThrough[i]);
+
   std::auto_ptr<te::dt::Int64> data(static_cast<te::dt::Int64*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -194,6 +227,9 @@ boost::int64_t te::da::DataSetAdapter::getInt64(std::size_t i) const
 
 bool te::da::DataSetAdapter::getBool(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getBool(m_passThrough[i]);
+
   std::auto_ptr<te::dt::Boolean> data(static_cast<te::dt::Boolean*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -201,6 +237,9 @@ bool te::da::DataSetAdapter::getBool(std::size_t i) const
 
 float te::da::DataSetAdapter::getFloat(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getFloat(m_passThrough[i]);
+
   std::auto_ptr<te::dt::Float> data(static_cast<te::dt::Float*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -208,6 +247,12 @@ float te::da::DataSetAdapter::getFloat(std::size_t i) const
 
 double te::da::DataSetAdapter::getDouble(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getDouble(m_passThrough[i]);
+
+  if(!m_doubleConverters[i].empty())
+    return m_doubleConverters[i](m_ds.get(), m_propertyIndexes[i]);
+
   std::auto_ptr<te::dt::Double> data(static_cast<te::dt::Double*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -215,6 +260,9 @@ double te::da::DataSetAdapter::getDouble(std::size_t i) const
 
 std::string te::da::DataSetAdapter::getNumeric(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getNumeric(m_passThrough[i]);
+
   std::auto_ptr<te::dt::Numeric> data(static_cast<te::dt::Numeric*>(getAdaptedValue(i)));
 
   return data->getValue();
@@ -222,37 +270,58 @@ std::string te::da::DataSetAdapter::getNumeric(std::size_t i) const
 
 std::string te::da::DataSetAdapter::getString(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getString(m_passThrough[i]);
+
   std::auto_ptr<te::dt::String> data(static_cast<te::dt::String*>(getAdaptedValue(i)));
   return data->getValue();
 }
 
 std::auto_ptr<te::dt::ByteArray> te::da::DataSetAdapter::getByteArray(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getByteArray(m_passThrough[i]);
+
   return std::auto_ptr<te::dt::ByteArray>(static_cast<te::dt::ByteArray*>(getAdaptedValue(i)));
 }
 
 std::auto_ptr<te::gm::Geometry> te::da::DataSetAdapter::getGeometry(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getGeometry(m_passThrough[i]);
+
   return std::auto_ptr<te::gm::Geometry>(static_cast<te::gm::Geometry*>(getAdaptedValue(i)));
 }
 
 std::auto_ptr<te::rst::Raster> te::da::DataSetAdapter::getRaster(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getRaster(m_passThrough[i]);
+
   return std::auto_ptr<te::rst::Raster>(static_cast<te::rst::Raster*>(getAdaptedValue(i)));
 }
 
 std::auto_ptr<te::dt::DateTime> te::da::DataSetAdapter::getDateTime(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getDateTime(m_passThrough[i]);
+
   return std::auto_ptr<te::dt::DateTime>(static_cast<te::dt::DateTime*>(getAdaptedValue(i)));
 }
 
 std::auto_ptr<te::dt::Array> te::da::DataSetAdapter::getArray(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->getArray(m_passThrough[i]);
+
   return std::auto_ptr<te::dt::Array>(static_cast<te::dt::Array*>(getAdaptedValue(i)));
 }
 
 bool te::da::DataSetAdapter::isNull(std::size_t i) const
 {
+  if(m_passThrough[i] != std::string::npos)
+    return m_ds->isNull(m_passThrough[i]);
+
   std::auto_ptr<te::dt::AbstractData> data(getAdaptedValue(i));
 
   return data.get() == 0;
@@ -272,6 +341,19 @@ void te::da::DataSetAdapter::add(const std::string& newPropertyName,
   m_pnames.push_back(newPropertyName);
   m_propertyIndexes.push_back(adaptedPropertyPos);
   m_converters.push_back(conv);
+  m_doubleConverters.push_back(GetDoubleAttributeConverter(conv));
+
+  if((adaptedPropertyPos.size() == 1) &&
+     (m_ds->getPropertyDataType(adaptedPropertyPos[0]) == newPropertyType) &&
+     IsIdentityConverter(conv))
+    m_passThrough.push_back(adaptedPropertyPos[0]);
+  else
+    m_passThrough.push_back(std::string::npos);
+}
+
+bool te::da::DataSetAdapter::isPassThrough(std::size_t i) const
+{
+  return m_passThrough[i] != std::string::npos;
 }
 
 te::dt::AbstractData* te::da::DataSetAdapter::getAdaptedValue(std::size_t i) const
@@ -160,10 +160,27 @@ namespace te
         */
         te::da::DataSet* getAdaptee() const;
 
+        /*!
+          \brief It adds an adapted property.
+
+          \param newPropertyName    The adapted property name.
+          \param newPropertyType    The adapted property data type.
+          \param adaptedPropertyPos The positions of the adaptee properties used to build the adapted values.
+          \param conv               The function used to build the adapted values.
+
+          \note Properties that are a single adaptee property with the same data type, adapted by GenericAttributeConverter
+                (or by a CharEncodingConverter to UTF-8), are read directly from the adaptee, without converting each value.
+          \note Point coordinates properties (PointToXConverter, ...) are read by getDouble without allocating the adapted values.
+        */
         void add(const std::string& newPropertyName,
                  int newPropertyType,
                  const std::vector<std::size_t>& adaptedPropertyPos,
                  AttributeConverter conv);
+
+        /*!
+          \brief It returns true if the given property is read directly from the adaptee.
+        */
+        bool isPassThrough(std::size_t i) const;
         //@}
 
       private:
@@ -184,6 +201,8 @@ namespace te
         te::common::Holder<DataSet> m_ds;                         //!< A pointer to the DataSet that will be handled by adapter
         std::vector<std::vector<std::size_t> > m_propertyIndexes; //!< A vector that stores the adapted property indexes.
         std::vector<AttributeConverter> m_converters;             //!< A vector that stores the attribute converters functions.
+        std::vector<DoubleAttributeConverter> m_doubleConverters; //!< The typed converters of the floating point properties (empty when not available).
+        std::vector<std::size_t> m_passThrough;                   //!< The adaptee position of the properties read without conversion (std::string::npos for the converted ones).
     };
 
   } // end namespace da
@@ -24,6 +24,7 @@
 */
 
 // TerraLib
+#include "../../core/plugin/PluginManager.h"
 #include "../../core/translator/Translator.h"
 #include "../../core/uri/URI.h"
 #include "DataSource.h"
@@ -31,21 +32,45 @@
 
 // Boost
 #include <boost/format.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
 
 std::map<std::string, te::da::DataSourceFactory::FactoryFnctType>
 te::da::DataSourceFactory::sm_factories;
 
+namespace
+{
+  /*!
+    \brief It guards the factory table.
+
+    Plugins started on demand register their factories while other threads
+    may be looking up the table. The lock must not be held across
+    PluginManager::resolve(), because the plugin startup calls add().
+  */
+  boost::mutex& FactoriesMutex()
+  {
+    static boost::mutex mtx;
+    return mtx;
+  }
+}
+
 std::unique_ptr<te::da::DataSource> te::da::DataSourceFactory::make(const std::string& driver, const te::core::URI& connInfo)
 {
   std::unique_ptr<DataSource> ds;
   if (connInfo.isValid())
   {
-    std::map<std::string, FactoryFnctType>::const_iterator it = sm_factories.find(driver);
+    FactoryFnctType f;
+
+    bool found = get(driver, f);
 
-    if (it == sm_factories.end())
+// the plugin that provides the driver may be registered but not loaded yet
+    if(!found && te::core::PluginManager::instance().resolve(driver))
+      found = get(driver, f);
+
+    if (!found)
       throw Exception((boost::format(TE_TR("Could not find a data source factory named: %1!")) % connInfo.path()).str());
 
-    ds.reset(sm_factories[driver](connInfo));
+    ds.reset(f(connInfo));
   }
 
   return ds;
@@ -64,15 +89,34 @@ std::unique_ptr<te::da::DataSource> te::da::DataSourceFactory::make(const std::s
   return ds;
 }
 
-bool te::da::DataSourceFactory::find(const std::string& dsType)
+bool te::da::DataSourceFactory::get(const std::string& dsType, FactoryFnctType& f)
 {
+  boost::lock_guard<boost::mutex> lock(FactoriesMutex());
+
   std::map<std::string, FactoryFnctType>::const_iterator it = sm_factories.find(dsType);
-  
-  return (it != sm_factories.end());
+
+  if(it == sm_factories.end())
+    return false;
+
+  f = it->second;
+
+  return true;
+}
+
+bool te::da::DataSourceFactory::find(const std::string& dsType)
+{
+  FactoryFnctType f;
+
+  if(get(dsType, f))
+    return true;
+
+  return te::core::PluginManager::instance().resolve(dsType) && get(dsType, f);
 }
 
 void te::da::DataSourceFactory::add(const std::string& dsType, FactoryFnctType f)
 {
+  boost::lock_guard<boost::mutex> lock(FactoriesMutex());
+
   std::map<std::string, FactoryFnctType>::const_iterator it = sm_factories.find(dsType);
 
   if(it != sm_factories.end())
@@ -83,6 +127,8 @@ void te::da::DataSourceFactory::add(const std::string& dsType, FactoryFnctType f
 
 void te::da::DataSourceFactory::remove(const std::string& dsType)
 {
+  boost::lock_guard<boost::mutex> lock(FactoriesMutex());
+
   std::map<std::string, FactoryFnctType>::iterator it = sm_factories.find(dsType);
 
   if(it == sm_factories.end())
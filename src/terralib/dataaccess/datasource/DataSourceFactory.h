@@ -74,6 +74,16 @@ namespace te
 
       private:
 
+        /*!
+          \brief It copies the factory function registered for the given type, if any.
+
+          \param dsType The data source type.
+          \param f      The output factory function.
+
+          \return True if a factory is registered for the type.
+        */
+        static bool get(const std::string& dsType, FactoryFnctType& f);
+
         static std::map<std::string, FactoryFnctType> sm_factories;
     };
   }   // end namespace da
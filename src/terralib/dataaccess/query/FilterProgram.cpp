@@ -0,0 +1,1392 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/dataaccess/query/FilterProgram.cpp
+
+  \brief A filter expression compiled to a flat program evaluated over batches of dataset items.
+*/
+
+// TerraLib
+#include "../../core/translator/Translator.h"
+#include "../../datatype/AbstractData.h"
+#include "../../datatype/Enums.h"
+#include "../../geometry/Geometry.h"
+#include "../../geometry/Utils.h"
+#include "../dataset/DataSet.h"
+#include "../utils/Utils.h"
+#include "../Exception.h"
+#include "FilterProgram.h"
+#include "Function.h"
+#include "FunctionNames.h"
+#include "In.h"
+#include "Like.h"
+#include "Literal.h"
+#include "LiteralBool.h"
+#include "LiteralEnvelope.h"
+#include "LiteralGeom.h"
+#include "PropertyName.h"
+
+// STL
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+// Boost
+#include <boost/lexical_cast.hpp>
+
+namespace te
+{
+  namespace da
+  {
+    /*! \brief The values of a number operand for the items of a batch. */
+    struct FilterNumberRef
+    {
+      const double* m_values;
+      const char* m_nulls;
+      double m_constant;
+      bool m_scalar;
+
+      bool isNull(std::size_t r) const { return !m_scalar && m_nulls[r]; }
+
+      double get(std::size_t r) const { return m_scalar ? m_constant : m_values[r]; }
+    };
+
+    /*! \brief The values of a string operand for the items of a batch. */
+    struct FilterStringRef
+    {
+      const std::string* m_values;
+      const char* m_nulls;
+      bool m_scalar;
+
+      bool isNull(std::size_t r) const { return !m_scalar && m_nulls[r]; }
+
+      const std::string& get(std::size_t r) const { return m_scalar ? *m_values : m_values[r]; }
+    };
+
+    struct FilterEQ { template<class T> bool operator()(const T& a, const T& b) const { return a == b; } };
+    struct FilterNE { template<class T> bool operator()(const T& a, const T& b) const { return a != b; } };
+    struct FilterLT { template<class T> bool operator()(const T& a, const T& b) const { return a < b; } };
+    struct FilterLE { template<class T> bool operator()(const T& a, const T& b) const { return a <= b; } };
+    struct FilterGT { template<class T> bool operator()(const T& a, const T& b) const { return b < a; } };
+    struct FilterGE { template<class T> bool operator()(const T& a, const T& b) const { return b <= a; } };
+
+    template<class REF, class CMP>
+    void FilterCompare(const REF& a, const REF& b, const std::vector<std::size_t>& in, std::vector<std::size_t>& out)
+    {
+      CMP cmp;
+
+      for(std::size_t i = 0; i < in.size(); ++i)
+      {
+        const std::size_t r = in[i];
+
+        if(a.isNull(r) || b.isNull(r))
+          continue;
+
+        if(cmp(a.get(r), b.get(r)))
+          out.push_back(r);
+      }
+    }
+
+    template<class REF>
+    void FilterCompare(int op, const REF& a, const REF& b, const std::vector<std::size_t>& in, std::vector<std::size_t>& out)
+    {
+      switch(op)
+      {
+        case 0: FilterCompare<REF, FilterEQ>(a, b, in, out); break;
+        case 1: FilterCompare<REF, FilterNE>(a, b, in, out); break;
+        case 2: FilterCompare<REF, FilterLT>(a, b, in, out); break;
+        case 3: FilterCompare<REF, FilterLE>(a, b, in, out); break;
+        case 4: FilterCompare<REF, FilterGT>(a, b, in, out); break;
+        default: FilterCompare<REF, FilterGE>(a, b, in, out);
+      }
+    }
+
+    /*! \brief It reads a number property; it returns false if the value can not be converted. */
+    bool FilterReadNumber(const DataSet* dataset, std::size_t pos, int type, double& value)
+    {
+      switch(type)
+      {
+        case te::dt::CHAR_TYPE:
+          value = dataset->getChar(pos);
+          return true;
+
+        case te::dt::UCHAR_TYPE:
+          value = dataset->getUChar(pos);
+          return true;
+
+        case te::dt::INT16_TYPE:
+          value = dataset->getInt16(pos);
+          return true;
+
+        case te::dt::INT32_TYPE:
+          value = dataset->getInt32(pos);
+          return true;
+
+        case te::dt::INT64_TYPE:
+          value = static_cast<double>(dataset->getInt64(pos));
+          return true;
+
+        case te::dt::BOOLEAN_TYPE:
+          value = dataset->getBool(pos) ? 1.0 : 0.0;
+          return true;
+
+        case te::dt::FLOAT_TYPE:
+          value = dataset->getFloat(pos);
+          return true;
+
+        case te::dt::DOUBLE_TYPE:
+          value = dataset->getDouble(pos);
+          return true;
+
+        default:
+          try
+          {
+            value = boost::lexical_cast<double>(dataset->getNumeric(pos));
+            return true;
+          }
+          catch(const boost::bad_lexical_cast&)
+          {
+            return false;
+          }
+      }
+    }
+
+    /*! \brief It returns true if the type is loaded as a number. */
+    bool FilterIsNumberType(int type)
+    {
+      return type == te::dt::CHAR_TYPE || type == te::dt::UCHAR_TYPE || type == te::dt::INT16_TYPE ||
+             type == te::dt::INT32_TYPE || type == te::dt::INT64_TYPE || type == te::dt::BOOLEAN_TYPE ||
+             type == te::dt::FLOAT_TYPE || type == te::dt::DOUBLE_TYPE || type == te::dt::NUMERIC_TYPE;
+    }
+  }
+}
+
+/*!
+  \class te::da::FilterProgram::Batch
+
+  \brief The loaded columns and the intermediate values of a batch of items.
+*/
+class te::da::FilterProgram::Batch
+{
+  public:
+
+    Batch(const FilterProgram& program, std::size_t capacity)
+      : m_dataset(0),
+        m_size(0)
+    {
+      const std::size_t ncols = program.m_columns.size();
+
+      m_positions.resize(capacity);
+      m_numbers.resize(ncols);
+      m_strings.resize(ncols);
+      m_geometries.resize(ncols);
+      m_loaded.resize(ncols);
+      m_nulls.resize(ncols);
+
+      for(std::size_t i = 0; i < ncols; ++i)
+      {
+        m_nulls[i].resize(capacity, 1);
+
+        switch(program.m_columns[i].m_kind)
+        {
+          case 0:
+            m_numbers[i].resize(capacity);
+          break;
+
+          case 1:
+            m_strings[i].resize(capacity);
+          break;
+
+          default:
+            m_geometries[i].resize(capacity, 0);
+            m_loaded[i].resize(capacity, 0);
+        }
+      }
+
+      const std::size_t nvalues = program.m_values.size();
+
+      m_valueNumbers.resize(nvalues);
+      m_valueNulls.resize(nvalues);
+
+      for(std::size_t i = 0; i < nvalues; ++i)
+      {
+        ValueCode code = program.m_values[i].m_code;
+
+        if(code == ADD || code == SUB || code == MUL || code == DIV)
+        {
+          m_valueNumbers[i].resize(capacity);
+          m_valueNulls[i].resize(capacity);
+        }
+      }
+    }
+
+    ~Batch()
+    {
+      clear();
+    }
+
+    void clear()
+    {
+      for(std::size_t i = 0; i < m_geometries.size(); ++i)
+      {
+        for(std::size_t j = 0; j < m_size && j < m_geometries[i].size(); ++j)
+        {
+          delete m_geometries[i][j];
+          m_geometries[i][j] = 0;
+          m_loaded[i][j] = 0;
+        }
+      }
+
+      m_size = 0;
+    }
+
+    DataSet* m_dataset;                                       //!< The dataset used to read the geometries on demand, if any.
+    std::size_t m_size;                                       //!< The number of items in the batch.
+    std::vector<std::size_t> m_positions;                     //!< The dataset positions of the items.
+    std::vector<std::vector<double> > m_numbers;              //!< The number columns.
+    std::vector<std::vector<std::string> > m_strings;         //!< The string columns.
+    std::vector<std::vector<te::gm::Geometry*> > m_geometries;//!< The geometry columns.
+    std::vector<std::vector<char> > m_loaded;                 //!< The geometries already read.
+    std::vector<std::vector<char> > m_nulls;                  //!< The null flags of the columns.
+    std::vector<std::vector<double> > m_valueNumbers;         //!< The results of the arithmetic instructions.
+    std::vector<std::vector<char> > m_valueNulls;             //!< The null flags of the arithmetic results.
+};
+
+te::da::FilterProgram::FilterProgram(const Expression& e, const DataSet* dataset)
+  : m_dataset(dataset),
+    m_hasGeometries(false)
+{
+  assert(dataset);
+
+  compilePredicate(&e, false);
+
+  m_dataset = 0;
+}
+
+te::da::FilterProgram::~FilterProgram()
+{
+}
+
+void te::da::FilterProgram::select(DataSet* dataset, std::vector<std::size_t>& positions, std::size_t batchSize) const
+{
+  assert(dataset);
+
+  batchSize = std::max<std::size_t>(batchSize, 1);
+
+  Batch batch(*this, batchSize);
+
+  // with random access the geometries are read only for the items reaching a spatial predicate
+  const bool lazy = m_hasGeometries && dataset->getTraverseType() == te::common::RANDOM;
+
+  if(lazy)
+    batch.m_dataset = dataset;
+
+  std::vector<std::size_t> in, out;
+  in.reserve(batchSize);
+  out.reserve(batchSize);
+
+  std::size_t pos = 0;
+
+  dataset->moveBeforeFirst();
+
+  bool more = dataset->moveNext();
+
+  while(more)
+  {
+    batch.clear();
+
+    while(more && batch.m_size < batchSize)
+    {
+      load(dataset, batch, batch.m_size, !lazy);
+
+      batch.m_positions[batch.m_size] = pos;
+
+      ++batch.m_size;
+      ++pos;
+
+      more = dataset->moveNext();
+    }
+
+    in.resize(batch.m_size);
+
+    for(std::size_t i = 0; i < batch.m_size; ++i)
+      in[i] = i;
+
+    out.clear();
+
+    evaluate(m_predicates.size() - 1, batch, in, out);
+
+    for(std::size_t i = 0; i < out.size(); ++i)
+      positions.push_back(batch.m_positions[out[i]]);
+
+    // the geometries read on demand moved the dataset: it is restored to the next item
+    if(lazy && more)
+      more = dataset->move(pos);
+  }
+
+  batch.clear();
+}
+
+bool te::da::FilterProgram::evaluate(const DataSet* dataset) const
+{
+  assert(dataset);
+
+  Batch batch(*this, 1);
+
+  load(dataset, batch, 0, true);
+
+  batch.m_size = 1;
+
+  std::vector<std::size_t> in(1, 0), out;
+
+  evaluate(m_predicates.size() - 1, batch, in, out);
+
+  return !out.empty();
+}
+
+std::size_t te::da::FilterProgram::getNumberOfPredicates() const
+{
+  return m_predicates.size();
+}
+
+std::size_t te::da::FilterProgram::getNumberOfValues() const
+{
+  return m_values.size();
+}
+
+std::size_t te::da::FilterProgram::compilePredicate(const Expression* e, bool negated)
+{
+  if(e == 0)
+    throw Exception(TE_TR("The filter has an empty expression!"));
+
+  PredicateInstruction p;
+  p.m_negated = false;
+  p.m_op = 0;
+  p.m_a = 0;
+  p.m_b = 0;
+
+  const LiteralBool* lbool = dynamic_cast<const LiteralBool*>(e);
+
+  if(lbool)
+  {
+    bool value = lbool->getValue()->toString() == "1";
+
+    p.m_code = (value != negated) ? ALL : NONE;
+
+    return addPredicate(p);
+  }
+
+  const PropertyName* pname = dynamic_cast<const PropertyName*>(e);
+
+  if(pname)
+  {
+    bool isString = false;
+
+    p.m_code = IS_TRUE;
+    p.m_negated = negated;
+    p.m_a = compileValue(e, isString);
+
+    if(isString)
+      throw Exception(TE_TR("A string property can not be used as a condition!"));
+
+    return addPredicate(p);
+  }
+
+  const Function* f = dynamic_cast<const Function*>(e);
+
+  if(f == 0)
+    throw Exception(TE_TR("The expression is not supported by the filter program!"));
+
+  const std::string& name = f->getName();
+
+  if(name == FunctionNames::sm_And || name == FunctionNames::sm_Or)
+  {
+    // NOT (A AND B) is compiled as (NOT A) OR (NOT B)
+    bool isAnd = (name == FunctionNames::sm_And);
+
+    p.m_code = (isAnd != negated) ? AND : OR;
+
+    for(std::size_t i = 0; i < f->getNumArgs(); ++i)
+    {
+      std::size_t child = compilePredicate(f->getArg(i), negated);
+
+      // nested operators of the same kind are flattened
+      if(m_predicates[child].m_code == p.m_code)
+        p.m_children.insert(p.m_children.end(), m_predicates[child].m_children.begin(), m_predicates[child].m_children.end());
+      else
+        p.m_children.push_back(child);
+    }
+
+    return addPredicate(p);
+  }
+
+  if(name == FunctionNames::sm_Not)
+  {
+    if(f->getNumArgs() != 1)
+      throw Exception(TE_TR("The NOT operator must have one argument!"));
+
+    return compilePredicate(f->getArg(0), !negated);
+  }
+
+  if(name == FunctionNames::sm_EqualTo)
+    return compileComparison(f, negated ? NE : EQ, false);
+
+  if(name == FunctionNames::sm_NotEqualTo)
+    return compileComparison(f, negated ? EQ : NE, false);
+
+  if(name == FunctionNames::sm_LessThan)
+    return compileComparison(f, negated ? GE : LT, false);
+
+  if(name == FunctionNames::sm_LessThanOrEqualTo)
+    return compileComparison(f, negated ? GT : LE, false);
+
+  if(name == FunctionNames::sm_GreaterThan)
+    return compileComparison(f, negated ? LE : GT, false);
+
+  if(name == FunctionNames::sm_GreaterThanOrEqualTo)
+    return compileComparison(f, negated ? LT : GE, false);
+
+  if(name == FunctionNames::sm_IsNull)
+  {
+    if(f->getNumArgs() != 1)
+      throw Exception(TE_TR("The IS NULL operator must have one argument!"));
+
+    bool isString = false;
+
+    p.m_code = IS_NULL;
+    p.m_negated = negated;
+    p.m_a = compileValue(f->getArg(0), isString);
+    p.m_b = isString ? 1 : 0;
+
+    return addPredicate(p);
+  }
+
+  if(name == FunctionNames::sm_Like)
+    return compileLike(e, negated);
+
+  if(name == FunctionNames::sm_In)
+    return compileIn(e, negated);
+
+  return compileSpatial(f, negated);
+}
+
+std::size_t te::da::FilterProgram::compileValue(const Expression* e, bool& isString)
+{
+  if(e == 0)
+    throw Exception(TE_TR("The filter has an empty expression!"));
+
+  ValueInstruction v;
+  v.m_column = 0;
+  v.m_a = 0;
+  v.m_b = 0;
+
+  const PropertyName* pname = dynamic_cast<const PropertyName*>(e);
+
+  if(pname)
+  {
+    std::size_t pos = te::da::GetPropertyPos(m_dataset, pname->getName());
+
+    // a property may be qualified by its dataset name
+    if(pos == std::string::npos)
+    {
+      std::size_t dot = pname->getName().rfind('.');
+
+      if(dot != std::string::npos)
+        pos = te::da::GetPropertyPos(m_dataset, pname->getName().substr(dot + 1));
+    }
+
+    if(pos == std::string::npos)
+      throw Exception(TE_TR("The filter references an unknown property!"));
+
+    int type = m_dataset->getPropertyDataType(pos);
+
+    if(FilterIsNumberType(type))
+    {
+      isString = false;
+      v.m_code = LOAD_NUMBER;
+      v.m_column = addColumn(m_dataset->getPropertyName(pos), 0);
+    }
+    else if(type == te::dt::STRING_TYPE)
+    {
+      isString = true;
+      v.m_code = LOAD_STRING;
+      v.m_column = addColumn(m_dataset->getPropertyName(pos), 1);
+    }
+    else
+    {
+      throw Exception(TE_TR("The type of a property used in the filter is not supported!"));
+    }
+
+    m_values.push_back(v);
+
+    return m_values.size() - 1;
+  }
+
+  const Literal* literal = dynamic_cast<const Literal*>(e);
+
+  if(literal && dynamic_cast<const LiteralGeom*>(e) == 0)
+  {
+    const te::dt::AbstractData* data = literal->getValue();
+
+    if(data == 0)
+      throw Exception(TE_TR("The filter has an empty literal!"));
+
+    int type = data->getTypeCode();
+
+    if(type == te::dt::STRING_TYPE)
+    {
+      isString = true;
+      v.m_code = CONST_STRING;
+      v.m_column = m_strings.size();
+      m_strings.push_back(data->toString());
+    }
+    else if(FilterIsNumberType(type))
+    {
+      double value = 0.0;
+
+      try
+      {
+        value = boost::lexical_cast<double>(data->toString());
+      }
+      catch(const boost::bad_lexical_cast&)
+      {
+        throw Exception(TE_TR("A literal of the filter could not be converted to a number!"));
+      }
+
+      isString = false;
+      v.m_code = CONST_NUMBER;
+      v.m_column = m_numbers.size();
+      m_numbers.push_back(value);
+    }
+    else
+    {
+      throw Exception(TE_TR("The type of a literal used in the filter is not supported!"));
+    }
+
+    m_values.push_back(v);
+
+    return m_values.size() - 1;
+  }
+
+  const Function* f = dynamic_cast<const Function*>(e);
+
+  if(f && f->getNumArgs() == 2)
+  {
+    const std::string& name = f->getName();
+
+    if(name == FunctionNames::sm_Add)
+      v.m_code = ADD;
+    else if(name == FunctionNames::sm_Sub)
+      v.m_code = SUB;
+    else if(name == FunctionNames::sm_Mul)
+      v.m_code = MUL;
+    else if(name == FunctionNames::sm_Div)
+      v.m_code = DIV;
+    else
+      throw Exception(TE_TR("The expression is not supported by the filter program!"));
+
+    bool s1 = false;
+    bool s2 = false;
+
+    v.m_a = compileValue(f->getArg(0), s1);
+    v.m_b = compileValue(f->getArg(1), s2);
+
+    if(s1 || s2)
+      throw Exception(TE_TR("The arithmetic operators can only be used with numbers!"));
+
+    isString = false;
+
+    m_values.push_back(v);
+
+    return m_values.size() - 1;
+  }
+
+  throw Exception(TE_TR("The expression is not supported by the filter program!"));
+}
+
+std::size_t te::da::FilterProgram::compileComparison(const Function* f, int op, bool negated)
+{
+  if(f->getNumArgs() != 2)
+    throw Exception(TE_TR("A comparison operator must have two arguments!"));
+
+  bool s1 = false;
+  bool s2 = false;
+
+  std::size_t a = compileValue(f->getArg(0), s1);
+  std::size_t b = compileValue(f->getArg(1), s2);
+
+  // a numeric string literal compared to a number is converted
+  if(s1 != s2)
+  {
+    std::size_t& str = s1 ? a : b;
+
+    if(m_values[str].m_code != CONST_STRING)
+      throw Exception(TE_TR("A string can not be compared to a number!"));
+
+    double value = 0.0;
+
+    try
+    {
+      value = boost::lexical_cast<double>(m_strings[m_values[str].m_column]);
+    }
+    catch(const boost::bad_lexical_cast&)
+    {
+      throw Exception(TE_TR("A string can not be compared to a number!"));
+    }
+
+    m_values[str].m_code = CONST_NUMBER;
+    m_values[str].m_column = m_numbers.size();
+    m_numbers.push_back(value);
+
+    s1 = s2 = false;
+  }
+
+  PredicateInstruction p;
+  p.m_code = s1 ? CMP_STRING : CMP_NUMBER;
+  p.m_negated = negated;
+  p.m_op = op;
+  p.m_a = a;
+  p.m_b = b;
+
+  return addPredicate(p);
+}
+
+std::size_t te::da::FilterProgram::compileSpatial(const Function* f, bool negated)
+{
+  const std::string& name = f->getName();
+
+  int op = 0;
+
+  if(name == FunctionNames::sm_ST_Intersects)
+    op = S_INTERSECTS;
+  else if(name == FunctionNames::sm_ST_Disjoint)
+    op = S_DISJOINT;
+  else if(name == FunctionNames::sm_ST_Touches)
+    op = S_TOUCHES;
+  else if(name == FunctionNames::sm_ST_Crosses)
+    op = S_CROSSES;
+  else if(name == FunctionNames::sm_ST_Within)
+    op = S_WITHIN;
+  else if(name == FunctionNames::sm_ST_Contains)
+    op = S_CONTAINS;
+  else if(name == FunctionNames::sm_ST_Overlaps)
+    op = S_OVERLAPS;
+  else if(name == FunctionNames::sm_ST_Equals)
+    op = S_EQUALS;
+  else if(name == FunctionNames::sm_ST_EnvelopeIntersects)
+    op = S_ENVELOPE_INTERSECTS;
+  else
+    throw Exception(TE_TR("The expression is not supported by the filter program!"));
+
+  if(f->getNumArgs() != 2)
+    throw Exception(TE_TR("A spatial operator must have two arguments!"));
+
+  const Expression* arg1 = f->getArg(0);
+  const Expression* arg2 = f->getArg(1);
+
+  const PropertyName* pname = dynamic_cast<const PropertyName*>(arg1);
+
+  if(pname == 0)
+  {
+    // the literal is the first argument: the relation is reversed
+    std::swap(arg1, arg2);
+
+    pname = dynamic_cast<const PropertyName*>(arg1);
+
+    if(op == S_WITHIN)
+      op = S_CONTAINS;
+    else if(op == S_CONTAINS)
+      op = S_WITHIN;
+  }
+
+  if(pname == 0)
+    throw Exception(TE_TR("A spatial operator of the filter must reference a geometry property!"));
+
+  std::size_t pos = te::da::GetPropertyPos(m_dataset, pname->getName());
+
+  if(pos == std::string::npos || m_dataset->getPropertyDataType(pos) != te::dt::GEOMETRY_TYPE)
+    throw Exception(TE_TR("A spatial operator of the filter must reference a geometry property!"));
+
+  GeometryConstant gc;
+
+  const LiteralEnvelope* lenv = dynamic_cast<const LiteralEnvelope*>(arg2);
+  const LiteralGeom* lgeom = dynamic_cast<const LiteralGeom*>(arg2);
+
+  if(lenv && lenv->getValue())
+  {
+    gc.m_mbr = *lenv->getValue();
+
+    if(op != S_ENVELOPE_INTERSECTS)
+      gc.m_geom.reset(te::gm::GetGeomFromEnvelope(lenv->getValue(), lenv->getSRID()));
+  }
+  else if(lgeom && dynamic_cast<const te::gm::Geometry*>(lgeom->getValue()))
+  {
+    gc.m_geom.reset(static_cast<te::gm::Geometry*>(lgeom->getValue()->clone()));
+    gc.m_mbr = *gc.m_geom->getMBR();
+  }
+  else
+  {
+    throw Exception(TE_TR("A spatial operator of the filter must have a literal geometry or envelope!"));
+  }
+
+  // the constant geometry is compared to many items: its GEOS representation is kept
+  if(gc.m_geom.get())
+    gc.m_geom->enableGEOSCache();
+
+  m_geometries.push_back(gc);
+
+  PredicateInstruction p;
+  p.m_code = SPATIAL;
+  p.m_negated = negated;
+  p.m_op = op;
+  p.m_a = addColumn(m_dataset->getPropertyName(pos), 2);
+  p.m_b = m_geometries.size() - 1;
+
+  m_hasGeometries = true;
+
+  return addPredicate(p);
+}
+
+std::size_t te::da::FilterProgram::compileLike(const Expression* e, bool negated)
+{
+  Like* like = const_cast<Like*>(dynamic_cast<const Like*>(e));
+
+  if(like == 0)
+    throw Exception(TE_TR("The expression is not supported by the filter program!"));
+
+  bool isString = false;
+
+  std::size_t value = compileValue(like->getString(), isString);
+
+  if(!isString)
+    throw Exception(TE_TR("The LIKE operator can only be used with strings!"));
+
+  const std::string& pattern = like->getPattern();
+  const std::string& wildCard = like->getWildCard();
+  const std::string& singleChar = like->getSingleChar();
+  const std::string& escapeChar = like->getEscapeChar();
+
+  Pattern p;
+
+  std::size_t i = 0;
+
+  while(i < pattern.size())
+  {
+    if(!escapeChar.empty() && pattern.compare(i, escapeChar.size(), escapeChar) == 0 && i + escapeChar.size() < pattern.size())
+    {
+      i += escapeChar.size();
+      p.m_chars.push_back(pattern[i]);
+      p.m_kinds.push_back(0);
+      ++i;
+    }
+    else if(!wildCard.empty() && pattern.compare(i, wildCard.size(), wildCard) == 0)
+    {
+      p.m_chars.push_back('%');
+      p.m_kinds.push_back(1);
+      i += wildCard.size();
+    }
+    else if(!singleChar.empty() && pattern.compare(i, singleChar.size(), singleChar) == 0)
+    {
+      p.m_chars.push_back('_');
+      p.m_kinds.push_back(2);
+      i += singleChar.size();
+    }
+    else
+    {
+      p.m_chars.push_back(pattern[i]);
+      p.m_kinds.push_back(0);
+      ++i;
+    }
+  }
+
+  m_patterns.push_back(p);
+
+  PredicateInstruction pi;
+  pi.m_code = LIKE;
+  pi.m_negated = negated;
+  pi.m_op = 0;
+  pi.m_a = value;
+  pi.m_b = m_patterns.size() - 1;
+
+  return addPredicate(pi);
+}
+
+std::size_t te::da::FilterProgram::compileIn(const Expression* e, bool negated)
+{
+  const In* in = dynamic_cast<const In*>(e);
+
+  if(in == 0 || in->getPropertyName() == 0)
+    throw Exception(TE_TR("The expression is not supported by the filter program!"));
+
+  bool isString = false;
+
+  std::size_t value = compileValue(in->getPropertyName(), isString);
+
+  PredicateInstruction p;
+  p.m_code = isString ? IN_STRING : IN_NUMBER;
+  p.m_negated = negated;
+  p.m_op = 0;
+  p.m_a = value;
+
+  std::vector<double> numbers;
+  std::vector<std::string> strings;
+
+  for(std::size_t i = 0; i < in->getNumArgs(); ++i)
+  {
+    const Literal* literal = dynamic_cast<const Literal*>(in->getArg(i));
+
+    if(literal == 0 || literal->getValue() == 0)
+      throw Exception(TE_TR("The IN operator of the filter must have a list of literals!"));
+
+    std::string str = literal->getValue()->toString();
+
+    if(isString)
+    {
+      strings.push_back(str);
+      continue;
+    }
+
+    try
+    {
+      numbers.push_back(boost::lexical_cast<double>(str));
+    }
+    catch(const boost::bad_lexical_cast&)
+    {
+      throw Exception(TE_TR("A literal of the filter could not be converted to a number!"));
+    }
+  }
+
+  if(isString)
+  {
+    std::sort(strings.begin(), strings.end());
+    p.m_b = m_stringSets.size();
+    m_stringSets.push_back(strings);
+  }
+  else
+  {
+    std::sort(numbers.begin(), numbers.end());
+    p.m_b = m_numberSets.size();
+    m_numberSets.push_back(numbers);
+  }
+
+  return addPredicate(p);
+}
+
+std::size_t te::da::FilterProgram::addColumn(const std::string& name, int kind)
+{
+  std::size_t pos = te::da::GetPropertyPos(m_dataset, name);
+
+  for(std::size_t i = 0; i < m_columns.size(); ++i)
+  {
+    if(m_columns[i].m_pos == pos)
+      return i;
+  }
+
+  ColumnInfo c;
+  c.m_pos = pos;
+  c.m_type = m_dataset->getPropertyDataType(pos);
+  c.m_kind = kind;
+
+  m_columns.push_back(c);
+
+  return m_columns.size() - 1;
+}
+
+std::size_t te::da::FilterProgram::addPredicate(const PredicateInstruction& p)
+{
+  m_predicates.push_back(p);
+
+  return m_predicates.size() - 1;
+}
+
+void te::da::FilterProgram::evaluate(std::size_t pred, Batch& batch, const std::vector<std::size_t>& in, std::vector<std::size_t>& out) const
+{
+  const PredicateInstruction& p = m_predicates[pred];
+
+  switch(p.m_code)
+  {
+    case ALL:
+      out.insert(out.end(), in.begin(), in.end());
+    return;
+
+    case NONE:
+    return;
+
+    case AND:
+    {
+      std::vector<std::size_t> current(in), next;
+
+      for(std::size_t i = 0; i < p.m_children.size() && !current.empty(); ++i)
+      {
+        next.clear();
+        evaluate(p.m_children[i], batch, current, next);
+        current.swap(next);
+      }
+
+      out.insert(out.end(), current.begin(), current.end());
+    }
+    return;
+
+    case OR:
+    {
+      std::vector<std::size_t> remaining(in), selected, found, aux;
+
+      for(std::size_t i = 0; i < p.m_children.size() && !remaining.empty(); ++i)
+      {
+        found.clear();
+        evaluate(p.m_children[i], batch, remaining, found);
+
+        if(found.empty())
+          continue;
+
+        aux.clear();
+        std::set_union(selected.begin(), selected.end(), found.begin(), found.end(), std::back_inserter(aux));
+        selected.swap(aux);
+
+        aux.clear();
+        std::set_difference(remaining.begin(), remaining.end(), found.begin(), found.end(), std::back_inserter(aux));
+        remaining.swap(aux);
+      }
+
+      out.insert(out.end(), selected.begin(), selected.end());
+    }
+    return;
+
+    case CMP_NUMBER:
+    {
+      evaluateNumber(p.m_a, batch, in);
+      evaluateNumber(p.m_b, batch, in);
+
+      FilterNumberRef a, b;
+
+      for(int k = 0; k < 2; ++k)
+      {
+        const ValueInstruction& v = m_values[k == 0 ? p.m_a : p.m_b];
+        FilterNumberRef& ref = (k == 0) ? a : b;
+
+        ref.m_scalar = (v.m_code == CONST_NUMBER);
+        ref.m_constant = ref.m_scalar ? m_numbers[v.m_column] : 0.0;
+        ref.m_values = 0;
+        ref.m_nulls = 0;
+
+        if(v.m_code == LOAD_NUMBER)
+        {
+          ref.m_values = &batch.m_numbers[v.m_column][0];
+          ref.m_nulls = &batch.m_nulls[v.m_column][0];
+        }
+        else if(!ref.m_scalar)
+        {
+          const std::size_t slot = (k == 0) ? p.m_a : p.m_b;
+          ref.m_values = &batch.m_valueNumbers[slot][0];
+          ref.m_nulls = &batch.m_valueNulls[slot][0];
+        }
+      }
+
+      FilterCompare(p.m_op, a, b, in, out);
+    }
+    return;
+
+    case CMP_STRING:
+    {
+      FilterStringRef a, b;
+
+      for(int k = 0; k < 2; ++k)
+      {
+        const ValueInstruction& v = m_values[k == 0 ? p.m_a : p.m_b];
+        FilterStringRef& ref = (k == 0) ? a : b;
+
+        ref.m_scalar = (v.m_code == CONST_STRING);
+
+        if(ref.m_scalar)
+        {
+          ref.m_values = &m_strings[v.m_column];
+          ref.m_nulls = 0;
+        }
+        else
+        {
+          ref.m_values = &batch.m_strings[v.m_column][0];
+          ref.m_nulls = &batch.m_nulls[v.m_column][0];
+        }
+      }
+
+      FilterCompare(p.m_op, a, b, in, out);
+    }
+    return;
+
+    case IS_NULL:
+    {
+      const ValueInstruction& v = m_values[p.m_a];
+
+      if(v.m_code == CONST_NUMBER || v.m_code == CONST_STRING)
+      {
+        if(p.m_negated)
+          out.insert(out.end(), in.begin(), in.end());
+
+        return;
+      }
+
+      const char* nulls = 0;
+
+      if(v.m_code == LOAD_NUMBER || v.m_code == LOAD_STRING)
+      {
+        nulls = &batch.m_nulls[v.m_column][0];
+      }
+      else
+      {
+        evaluateNumber(p.m_a, batch, in);
+        nulls = &batch.m_valueNulls[p.m_a][0];
+      }
+
+      for(std::size_t i = 0; i < in.size(); ++i)
+      {
+        if((nulls[in[i]] != 0) != p.m_negated)
+          out.push_back(in[i]);
+      }
+    }
+    return;
+
+    case IS_TRUE:
+    {
+      const ValueInstruction& v = m_values[p.m_a];
+
+      const double* values = &batch.m_numbers[v.m_column][0];
+      const char* nulls = &batch.m_nulls[v.m_column][0];
+
+      for(std::size_t i = 0; i < in.size(); ++i)
+      {
+        const std::size_t r = in[i];
+
+        if(!nulls[r] && ((values[r] != 0.0) != p.m_negated))
+          out.push_back(r);
+      }
+    }
+    return;
+
+    case LIKE:
+    {
+      const ValueInstruction& v = m_values[p.m_a];
+      const Pattern& pattern = m_patterns[p.m_b];
+
+      if(v.m_code == CONST_STRING)
+      {
+        if(Match(pattern, m_strings[v.m_column]) != p.m_negated)
+          out.insert(out.end(), in.begin(), in.end());
+
+        return;
+      }
+
+      const std::vector<std::string>& values = batch.m_strings[v.m_column];
+      const char* nulls = &batch.m_nulls[v.m_column][0];
+
+      for(std::size_t i = 0; i < in.size(); ++i)
+      {
+        const std::size_t r = in[i];
+
+        if(!nulls[r] && (Match(pattern, values[r]) != p.m_negated))
+          out.push_back(r);
+      }
+    }
+    return;
+
+    case IN_NUMBER:
+    {
+      evaluateNumber(p.m_a, batch, in);
+
+      const ValueInstruction& v = m_values[p.m_a];
+      const std::vector<double>& set = m_numberSets[p.m_b];
+
+      const double* values = (v.m_code == LOAD_NUMBER) ? &batch.m_numbers[v.m_column][0] : &batch.m_valueNumbers[p.m_a][0];
+      const char* nulls = (v.m_code == LOAD_NUMBER) ? &batch.m_nulls[v.m_column][0] : &batch.m_valueNulls[p.m_a][0];
+
+      for(std::size_t i = 0; i < in.size(); ++i)
+      {
+        const std::size_t r = in[i];
+
+        if(!nulls[r] && (std::binary_search(set.begin(), set.end(), values[r]) != p.m_negated))
+          out.push_back(r);
+      }
+    }
+    return;
+
+    case IN_STRING:
+    {
+      const ValueInstruction& v = m_values[p.m_a];
+      const std::vector<std::string>& set = m_stringSets[p.m_b];
+
+      const std::vector<std::string>& values = batch.m_strings[v.m_column];
+      const char* nulls = &batch.m_nulls[v.m_column][0];
+
+      for(std::size_t i = 0; i < in.size(); ++i)
+      {
+        const std::size_t r = in[i];
+
+        if(!nulls[r] && (std::binary_search(set.begin(), set.end(), values[r]) != p.m_negated))
+          out.push_back(r);
+      }
+    }
+    return;
+
+    case SPATIAL:
+    {
+      const GeometryConstant& gc = m_geometries[p.m_b];
+
+      // the geometries of the selected items are read (when the dataset can be accessed on demand,
+      // they were not read with the batch). Their bounding rectangles decide most of the items
+      // without computing the exact relation.
+      loadGeometries(p.m_a, batch, in);
+
+      const std::vector<te::gm::Geometry*>& geoms = batch.m_geometries[p.m_a];
+
+      for(std::size_t i = 0; i < in.size(); ++i)
+      {
+        const std::size_t r = in[i];
+
+        te::gm::Geometry* g = geoms[r];
+
+        if(g == 0)
+          continue;
+
+        const te::gm::Envelope* mbr = g->getMBR();
+
+        bool decided = true;
+        bool result = false;
+
+        switch(p.m_op)
+        {
+          case S_ENVELOPE_INTERSECTS:
+            result = mbr->intersects(gc.m_mbr);
+          break;
+
+          case S_DISJOINT:
+            result = !mbr->intersects(gc.m_mbr);
+            decided = result;
+          break;
+
+          case S_WITHIN:
+            decided = !gc.m_mbr.contains(*mbr);
+          break;
+
+          case S_CONTAINS:
+            decided = !mbr->contains(gc.m_mbr);
+          break;
+
+          default:
+            decided = !mbr->intersects(gc.m_mbr);
+        }
+
+        if(!decided)
+        {
+          if(g->getSRID() != gc.m_geom->getSRID())
+            g->setSRID(gc.m_geom->getSRID());
+
+          // the constant geometry is the receiver, so its cached GEOS representation is used
+          switch(p.m_op)
+          {
+            case S_INTERSECTS: result = gc.m_geom->intersects(g); break;
+            case S_DISJOINT: result = gc.m_geom->disjoint(g); break;
+            case S_TOUCHES: result = gc.m_geom->touches(g); break;
+            case S_CROSSES: result = gc.m_geom->crosses(g); break;
+            case S_WITHIN: result = gc.m_geom->contains(g); break;
+            case S_CONTAINS: result = gc.m_geom->within(g); break;
+            case S_OVERLAPS: result = gc.m_geom->overlaps(g); break;
+            default: result = gc.m_geom->equals(g);
+          }
+        }
+
+        if(result != p.m_negated)
+          out.push_back(r);
+      }
+    }
+    return;
+  }
+}
+
+void te::da::FilterProgram::evaluateNumber(std::size_t value, Batch& batch, const std::vector<std::size_t>& rows) const
+{
+  const ValueInstruction& v = m_values[value];
+
+  if(v.m_code != ADD && v.m_code != SUB && v.m_code != MUL && v.m_code != DIV)
+    return;
+
+  evaluateNumber(v.m_a, batch, rows);
+  evaluateNumber(v.m_b, batch, rows);
+
+  FilterNumberRef ops[2];
+
+  for(int k = 0; k < 2; ++k)
+  {
+    const std::size_t slot = (k == 0) ? v.m_a : v.m_b;
+    const ValueInstruction& o = m_values[slot];
+
+    ops[k].m_scalar = (o.m_code == CONST_NUMBER);
+    ops[k].m_constant = ops[k].m_scalar ? m_numbers[o.m_column] : 0.0;
+    ops[k].m_values = 0;
+    ops[k].m_nulls = 0;
+
+    if(o.m_code == LOAD_NUMBER)
+    {
+      ops[k].m_values = &batch.m_numbers[o.m_column][0];
+      ops[k].m_nulls = &batch.m_nulls[o.m_column][0];
+    }
+    else if(!ops[k].m_scalar)
+    {
+      ops[k].m_values = &batch.m_valueNumbers[slot][0];
+      ops[k].m_nulls = &batch.m_valueNulls[slot][0];
+    }
+  }
+
+  std::vector<double>& result = batch.m_valueNumbers[value];
+  std::vector<char>& nulls = batch.m_valueNulls[value];
+
+  for(std::size_t i = 0; i < rows.size(); ++i)
+  {
+    const std::size_t r = rows[i];
+
+    if(ops[0].isNull(r) || ops[1].isNull(r))
+    {
+      nulls[r] = 1;
+      continue;
+    }
+
+    const double a = ops[0].get(r);
+    const double b = ops[1].get(r);
+
+    nulls[r] = 0;
+
+    switch(v.m_code)
+    {
+      case ADD: result[r] = a + b; break;
+      case SUB: result[r] = a - b; break;
+      case MUL: result[r] = a * b; break;
+      default:
+        if(b == 0.0)
+          nulls[r] = 1;
+        else
+          result[r] = a / b;
+    }
+  }
+}
+
+void te::da::FilterProgram::evaluateString(std::size_t /*value*/, Batch& /*batch*/, const std::vector<std::size_t>& /*rows*/) const
+{
+// the string values are only loaded or constant: there is nothing to compute
+}
+
+void te::da::FilterProgram::load(const DataSet* dataset, Batch& batch, std::size_t row, bool withGeometries) const
+{
+  for(std::size_t i = 0; i < m_columns.size(); ++i)
+  {
+    const ColumnInfo& c = m_columns[i];
+
+    if(c.m_kind == 2 && !withGeometries)
+      continue;
+
+    if(dataset->isNull(c.m_pos))
+    {
+      batch.m_nulls[i][row] = 1;
+
+      if(c.m_kind == 2)
+        batch.m_loaded[i][row] = 1;
+
+      continue;
+    }
+
+    switch(c.m_kind)
+    {
+      case 0:
+        batch.m_nulls[i][row] = FilterReadNumber(dataset, c.m_pos, c.m_type, batch.m_numbers[i][row]) ? 0 : 1;
+      break;
+
+      case 1:
+        batch.m_strings[i][row] = dataset->getString(c.m_pos);
+        batch.m_nulls[i][row] = 0;
+      break;
+
+      default:
+        batch.m_geometries[i][row] = dataset->getGeometry(c.m_pos).release();
+        batch.m_loaded[i][row] = 1;
+        batch.m_nulls[i][row] = (batch.m_geometries[i][row] == 0) ? 1 : 0;
+    }
+  }
+}
+
+void te::da::FilterProgram::loadGeometries(std::size_t column, Batch& batch, const std::vector<std::size_t>& rows) const
+{
+  if(batch.m_dataset == 0)
+    return;
+
+  const std::size_t pos = m_columns[column].m_pos;
+
+  for(std::size_t i = 0; i < rows.size(); ++i)
+  {
+    const std::size_t r = rows[i];
+
+    if(batch.m_loaded[column][r])
+      continue;
+
+    batch.m_loaded[column][r] = 1;
+
+    if(!batch.m_dataset->move(batch.m_positions[r]) || batch.m_dataset->isNull(pos))
+      continue;
+
+    batch.m_geometries[column][r] = batch.m_dataset->getGeometry(pos).release();
+    batch.m_nulls[column][r] = (batch.m_geometries[column][r] == 0) ? 1 : 0;
+  }
+}
+
+bool te::da::FilterProgram::Match(const Pattern& p, const std::string& s)
+{
+  // iterative glob matching with backtracking to the last any sequence token
+  std::size_t pi = 0;
+  std::size_t si = 0;
+  std::size_t starP = std::string::npos;
+  std::size_t starS = 0;
+
+  const std::size_t np = p.m_chars.size();
+  const std::size_t ns = s.size();
+
+  while(si < ns)
+  {
+    if(pi < np && p.m_kinds[pi] == 1)
+    {
+      starP = pi++;
+      starS = si;
+    }
+    else if(pi < np && (p.m_kinds[pi] == 2 || p.m_chars[pi] == s[si]))
+    {
+      ++pi;
+      ++si;
+    }
+    else if(starP != std::string::npos)
+    {
+      pi = starP + 1;
+      si = ++starS;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  while(pi < np && p.m_kinds[pi] == 1)
+    ++pi;
+
+  return pi == np;
+}
@@ -0,0 +1,271 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/dataaccess/query/FilterProgram.h
+
+  \brief A filter expression compiled to a flat program evaluated over batches of dataset items.
+*/
+
+#ifndef __TERRALIB_DATAACCESS_INTERNAL_FILTERPROGRAM_H
+#define __TERRALIB_DATAACCESS_INTERNAL_FILTERPROGRAM_H
+
+// TerraLib
+#include "../../geometry/Envelope.h"
+#include "../Config.h"
+
+// STL
+#include <string>
+#include <vector>
+
+// Boost
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace te
+{
+  namespace gm { class Geometry; }
+
+  namespace da
+  {
+// Forward declarations
+    class DataSet;
+    class Expression;
+    class Function;
+
+    /*!
+      \class FilterProgram
+
+      \brief A filter expression compiled to a flat program evaluated over batches of dataset items.
+
+      \details The expression tree is translated once to two arrays of typed instructions:
+               value instructions (property loads, constants and arithmetic) and predicate
+               instructions (comparisons, IS NULL, LIKE, IN, spatial relations, AND and OR).
+
+               The items are read in batches: the referenced properties are loaded into typed
+               columns and each predicate refines a selection vector with the positions of the
+               batch items still satisfying the filter. So AND and OR are short-circuited: the
+               second operand of an AND is only evaluated for the items satisfying the first one.
+               The spatial predicates compare the bounding rectangles before computing the exact
+               relation. For datasets with random access, the geometries are only read for the
+               items still selected when a spatial predicate is evaluated (for instance, those
+               satisfying the attribute operands placed before it in an AND).
+
+               NOT is pushed down to the predicates at compile time, giving the SQL semantics:
+               a comparison with a null value is never satisfied.
+
+               The supported expressions are: AND, OR, NOT, the relational operators, +, -, *, /,
+               IS NULL, LIKE, IN and the spatial relations ST_Intersects, ST_Disjoint, ST_Touches,
+               ST_Crosses, ST_Within, ST_Contains, ST_Overlaps, ST_Equals and ST_EnvelopeIntersects
+               between a geometry property and a literal geometry or envelope (in the dataset SRS).
+
+      \note The constant geometries keep their GEOS representation cached between the items, so a
+            FilterProgram must not be evaluated by several threads at the same time.
+    */
+    class TEDATAACCESSEXPORT FilterProgram : public boost::noncopyable
+    {
+      public:
+
+        /*!
+          \brief It compiles an expression for the properties of a dataset.
+
+          \param e       The filter expression.
+          \param dataset The dataset that will be filtered (only its properties are used).
+
+          \exception Exception It throws an exception if the expression is not supported, so the
+                               caller can fallback to another evaluation strategy.
+        */
+        FilterProgram(const Expression& e, const DataSet* dataset);
+
+        /*! \brief Destructor. */
+        ~FilterProgram();
+
+        /*!
+          \brief It evaluates the filter over all the items of a dataset.
+
+          \param dataset   The dataset, traversed from its first item.
+          \param positions The positions of the items satisfying the filter are appended to it.
+          \param batchSize The number of items evaluated at once.
+        */
+        void select(DataSet* dataset, std::vector<std::size_t>& positions,
+                    std::size_t batchSize = TE_DA_FILTER_BATCH_SIZE) const;
+
+        /*!
+          \brief It evaluates the filter for the current item of a dataset.
+
+          \param dataset The dataset.
+
+          \return True if the current item satisfies the filter.
+        */
+        bool evaluate(const DataSet* dataset) const;
+
+        /*! \brief It returns the number of predicate instructions. */
+        std::size_t getNumberOfPredicates() const;
+
+        /*! \brief It returns the number of value instructions. */
+        std::size_t getNumberOfValues() const;
+
+      protected:
+
+        /*! \brief The value instruction codes. */
+        enum ValueCode
+        {
+          LOAD_NUMBER,
+          LOAD_STRING,
+          CONST_NUMBER,
+          CONST_STRING,
+          ADD,
+          SUB,
+          MUL,
+          DIV
+        };
+
+        /*! \brief The predicate instruction codes. */
+        enum PredicateCode
+        {
+          ALL,
+          NONE,
+          AND,
+          OR,
+          CMP_NUMBER,
+          CMP_STRING,
+          IS_NULL,
+          IS_TRUE,
+          LIKE,
+          IN_NUMBER,
+          IN_STRING,
+          SPATIAL
+        };
+
+        /*! \brief The comparison operators. */
+        enum CompareOp
+        {
+          EQ,
+          NE,
+          LT,
+          LE,
+          GT,
+          GE
+        };
+
+        /*! \brief The spatial relations. */
+        enum SpatialOp
+        {
+          S_INTERSECTS,
+          S_DISJOINT,
+          S_TOUCHES,
+          S_CROSSES,
+          S_WITHIN,
+          S_CONTAINS,
+          S_OVERLAPS,
+          S_EQUALS,
+          S_ENVELOPE_INTERSECTS
+        };
+
+        /*! \brief A value instruction: it computes a number or a string for each selected item. */
+        struct ValueInstruction
+        {
+          ValueCode m_code;
+          std::size_t m_column;   //!< The loaded column or the constant index.
+          std::size_t m_a;        //!< The first operand value.
+          std::size_t m_b;        //!< The second operand value.
+        };
+
+        /*! \brief A predicate instruction: it selects the items satisfying a condition. */
+        struct PredicateInstruction
+        {
+          PredicateCode m_code;
+          bool m_negated;                         //!< If true, the items with a non-null value not satisfying the condition are selected.
+          int m_op;                               //!< The comparison operator or the spatial relation.
+          std::size_t m_a;                        //!< The first value, the column or the constant geometry.
+          std::size_t m_b;                        //!< The second value or the pattern/set index.
+          std::vector<std::size_t> m_children;    //!< The operands of AND and OR.
+        };
+
+        /*! \brief A column of the dataset referenced by the program. */
+        struct ColumnInfo
+        {
+          std::size_t m_pos;      //!< The property position in the dataset.
+          int m_type;             //!< The property data type.
+          int m_kind;             //!< The loaded kind: 0 number, 1 string or 2 geometry.
+        };
+
+        /*! \brief A constant geometry used by the spatial predicates. */
+        struct GeometryConstant
+        {
+          boost::shared_ptr<te::gm::Geometry> m_geom;   //!< The geometry (NULL for an envelope used only by ST_EnvelopeIntersects).
+          te::gm::Envelope m_mbr;                       //!< The geometry bounding rectangle.
+        };
+
+        /*! \brief A LIKE pattern split in tokens. */
+        struct Pattern
+        {
+          std::string m_chars;                //!< The pattern characters, with the escapes resolved.
+          std::vector<char> m_kinds;          //!< For each character: 0 literal, 1 any sequence or 2 any single character.
+        };
+
+        class Batch;
+
+        std::size_t compilePredicate(const Expression* e, bool negated);
+
+        std::size_t compileValue(const Expression* e, bool& isString);
+
+        std::size_t compileComparison(const Function* f, int op, bool negated);
+
+        std::size_t compileSpatial(const Function* f, bool negated);
+
+        std::size_t compileLike(const Expression* e, bool negated);
+
+        std::size_t compileIn(const Expression* e, bool negated);
+
+        std::size_t addColumn(const std::string& name, int kind);
+
+        std::size_t addPredicate(const PredicateInstruction& p);
+
+        void evaluate(std::size_t pred, Batch& batch, const std::vector<std::size_t>& in, std::vector<std::size_t>& out) const;
+
+        void evaluateNumber(std::size_t value, Batch& batch, const std::vector<std::size_t>& rows) const;
+
+        void evaluateString(std::size_t value, Batch& batch, const std::vector<std::size_t>& rows) const;
+
+        void load(const DataSet* dataset, Batch& batch, std::size_t row, bool withGeometries) const;
+
+        void loadGeometries(std::size_t column, Batch& batch, const std::vector<std::size_t>& rows) const;
+
+        static bool Match(const Pattern& p, const std::string& s);
+
+      private:
+
+        const DataSet* m_dataset;                       //!< The dataset whose properties are resolved, only set while compiling.
+        std::vector<ColumnInfo> m_columns;              //!< The referenced columns.
+        std::vector<ValueInstruction> m_values;         //!< The value instructions.
+        std::vector<PredicateInstruction> m_predicates; //!< The predicate instructions, the last one is the filter.
+        std::vector<double> m_numbers;                  //!< The number constants.
+        std::vector<std::string> m_strings;             //!< The string constants.
+        std::vector<GeometryConstant> m_geometries;     //!< The geometry constants.
+        std::vector<Pattern> m_patterns;                //!< The LIKE patterns.
+        std::vector<std::vector<double> > m_numberSets; //!< The sorted sets of numbers of the IN predicates.
+        std::vector<std::vector<std::string> > m_stringSets; //!< The sorted sets of strings of the IN predicates.
+        bool m_hasGeometries;                           //!< True if a geometry column is referenced.
+    };
+
+  } // end namespace da
+}   // end namespace te
+
+#endif  // __TERRALIB_DATAACCESS_INTERNAL_FILTERPROGRAM_H
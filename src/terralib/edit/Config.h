@@ -34,6 +34,12 @@
 
 #define TE_EDIT_FEATURE_CONTOUR_COLOR  255, 0, 0, 255
 
+#define TE_EDIT_SNAP_ITEMS_PER_CELL 4
+
+#define TE_EDIT_SNAP_MAX_CELLS_PER_SEGMENT 64
+
+#define TE_EDIT_SNAP_MAX_GRID_SIZE 2048
+
 /** @name DLL/LIB Module
  *  Flags for building TerraLib as a DLL or as a Static Library
  */
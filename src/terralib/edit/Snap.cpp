@@ -33,6 +33,9 @@
 #include "Snap.h"
 #include "Utils.h"
 
+// Boost
+#include <boost/bind.hpp>
+
 // STL
 #include <cassert>
 #include <memory>
@@ -43,12 +46,16 @@ te::edit::Snap::Snap(const std::string& source, int srid)
     m_nGeometries(0),
     m_maxGeometries(0),
     m_tolerance(16),
-    m_transformer(0)
+    m_transformer(0),
+    m_cancel(false),
+    m_building(false)
 {
 }
 
 te::edit::Snap::~Snap()
 {
+  cancelBuild();
+
   delete m_transformer;
 }
 
@@ -94,7 +101,12 @@ void te::edit::Snap::build(te::da::DataSet* dataset)
 {
   assert(dataset);
 
-  clear();
+  cancelBuild();
+
+  {
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    clear();
+  }
 
   add(dataset);
 }
@@ -103,22 +115,55 @@ void te::edit::Snap::add(te::da::DataSet* dataset)
 {
   assert(dataset);
 
-  std::size_t gpos = te::da::GetFirstPropertyPos(dataset, te::dt::GEOMETRY_TYPE);
+  addGeometries(dataset);
+}
 
-  if(gpos == std::string::npos)
-    return;
+void te::edit::Snap::buildAsync(te::da::DataSet* dataset)
+{
+  assert(dataset);
 
-  while(dataset->moveNext())
+  cancelBuild();
+
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+
+  clear();
+
+  m_cancel = false;
+  m_building = true;
+
+  m_thread = boost::thread(boost::bind(&Snap::runBuild, this, dataset));
+}
+
+bool te::edit::Snap::isBuilding() const
+{
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+
+  return m_building;
+}
+
+void te::edit::Snap::cancelBuild()
+{
   {
-    std::auto_ptr<te::gm::Geometry> g(dataset->getGeometry(gpos));
-    add(g.get());
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    m_cancel = true;
   }
+
+  if(m_thread.joinable())
+    m_thread.join();
+
+  m_cancel = false;
 }
 
 bool te::edit::Snap::search(const te::gm::Coord2D& coord, te::gm::Coord2D& result)
 {
   te::gm::Envelope e = getSearchEnvelope(coord);
 
+  // The cursor must not wait for a geometry being added in background
+  boost::unique_lock<boost::mutex> lock(m_mutex, boost::try_to_lock);
+
+  if(!lock.owns_lock())
+    return false;
+
   return search(e, result);
 }
 
@@ -145,3 +190,43 @@ te::gm::Envelope te::edit::Snap::getSearchEnvelope(const te::gm::Coord2D& coord)
 
   return e;
 }
+
+void te::edit::Snap::addGeometries(te::da::DataSet* dataset)
+{
+  std::size_t gpos = te::da::GetFirstPropertyPos(dataset, te::dt::GEOMETRY_TYPE);
+
+  if(gpos == std::string::npos)
+    return;
+
+  while(dataset->moveNext())
+  {
+    if(dataset->isNull(gpos))
+      continue;
+
+    std::auto_ptr<te::gm::Geometry> g(dataset->getGeometry(gpos));
+
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    if(m_cancel)
+      return;
+
+    add(g.get());
+  }
+}
+
+void te::edit::Snap::runBuild(te::da::DataSet* dataset)
+{
+  std::auto_ptr<te::da::DataSet> owner(dataset);
+
+  try
+  {
+    addGeometries(dataset);
+  }
+  catch(...)
+  {
+  }
+
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+
+  m_building = false;
+}
@@ -30,6 +30,10 @@
 #include "../srs/Config.h"
 #include "Config.h"
 
+// Boost
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
 // STL
 #include <string>
 
@@ -59,6 +63,10 @@ namespace te
       \class Snap
 
       \brief This class implements geometry snap concept.
+
+      \note The snap can be built in a background thread. Meanwhile, the searches use the
+            geometries already added and give up instead of waiting while a geometry is added.
+            The subclasses must call cancelBuild() in their destructors.
     */
     class TEEDITEXPORT Snap
     {
@@ -88,6 +96,19 @@ namespace te
 
         void add(te::da::DataSet* dataset);
 
+        /*!
+          \brief It builds the snap in a background thread.
+
+          \param dataset The dataset with the snap geometries. The snap will take its ownership.
+        */
+        void buildAsync(te::da::DataSet* dataset);
+
+        /*! \brief It returns true while the snap is being built in background. */
+        bool isBuilding() const;
+
+        /*! \brief It stops the background build, if any, and waits for it. */
+        void cancelBuild();
+
         virtual bool search(const te::gm::Coord2D& coord, te::gm::Coord2D& result);
 
         virtual void add(te::gm::Geometry* geom) = 0;
@@ -102,6 +123,10 @@ namespace te
 
         te::gm::Envelope getSearchEnvelope(const te::gm::Coord2D& coord) const;
 
+        void addGeometries(te::da::DataSet* dataset);
+
+        void runBuild(te::da::DataSet* dataset);
+
         virtual bool search(const te::gm::Envelope& e, te::gm::Coord2D& result) = 0;
 
       protected:
@@ -112,6 +137,10 @@ namespace te
         std::size_t m_maxGeometries;                    //!< The maximum number of geometries that can be added to the snap. If 0, there will be not limit.
         double m_tolerance;                             //!< The tolerance that will be used by the snap. For while, the unit is screen pixels.
         te::map::WorldDeviceTransformer* m_transformer; //!< For transforming from device coordinate to world coordinate and vice-versa.
+        mutable boost::mutex m_mutex;                   //!< It serializes the searches and the geometries added in background.
+        boost::thread m_thread;                         //!< The background build thread.
+        bool m_cancel;                                  //!< It asks the background build to stop.
+        bool m_building;                                //!< True while the background build is running.
     }; 
 
   } // end namespace edit
@@ -0,0 +1,437 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/edit/SnapIndex.cpp
+
+  \brief A uniform grid over the vertices and segments of the snap geometries.
+*/
+
+// TerraLib
+#include "../geometry/Geometry.h"
+#include "../geometry/LineString.h"
+#include "SnapIndex.h"
+#include "Utils.h"
+
+// STL
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+te::edit::SnapIndex::SnapIndex()
+{
+  clear();
+}
+
+te::edit::SnapIndex::~SnapIndex()
+{
+}
+
+void te::edit::SnapIndex::add(te::gm::Geometry* geom)
+{
+  assert(geom);
+
+  std::vector<te::gm::LineString*> lines;
+  GetLines(geom, lines);
+
+  if(lines.empty())
+  {
+    // Points: only vertices
+    std::vector<te::gm::Coord2D> coords;
+    GetCoordinates(geom, coords);
+
+    if(!coords.empty())
+      add(&coords[0], coords.size(), false);
+
+    return;
+  }
+
+  for(std::size_t i = 0; i < lines.size(); ++i)
+  {
+    const std::size_t n = lines[i]->getNPoints();
+
+    std::vector<te::gm::Coord2D> path(n);
+
+    for(std::size_t j = 0; j < n; ++j)
+    {
+      path[j].x = lines[i]->getX(j);
+      path[j].y = lines[i]->getY(j);
+    }
+
+    if(n > 0)
+      add(&path[0], n, true);
+  }
+}
+
+void te::edit::SnapIndex::add(const te::gm::Coord2D* coords, std::size_t n, bool path)
+{
+  if(n == 0)
+    return;
+
+  boost::uint32_t first = static_cast<boost::uint32_t>(m_vertices.size());
+
+  m_vertices.insert(m_vertices.end(), coords, coords + n);
+
+  if(path)
+  {
+    for(std::size_t i = 1; i < n; ++i)
+    {
+      m_segments.push_back(first + static_cast<boost::uint32_t>(i - 1));
+      m_segments.push_back(first + static_cast<boost::uint32_t>(i));
+    }
+  }
+
+  update();
+}
+
+void te::edit::SnapIndex::clear()
+{
+  m_vertices.clear();
+  m_segments.clear();
+
+  m_llx = 0.0;
+  m_lly = 0.0;
+  m_cellSize = 0.0;
+  m_nCols = 0;
+  m_nRows = 0;
+
+  m_vertexCells.clear();
+  m_vertexItems.clear();
+  m_segmentCells.clear();
+  m_segmentItems.clear();
+  m_largeSegments.clear();
+
+  m_nIndexedVertices = 0;
+  m_nIndexedSegments = 0;
+}
+
+std::size_t te::edit::SnapIndex::getNumVertices() const
+{
+  return m_vertices.size();
+}
+
+std::size_t te::edit::SnapIndex::getNumSegments() const
+{
+  return m_segments.size() / 2;
+}
+
+bool te::edit::SnapIndex::nearestVertex(const te::gm::Coord2D& c, double tolerance, te::gm::Coord2D& result) const
+{
+  double minDistance = tolerance * tolerance;
+  std::size_t nearest = std::numeric_limits<std::size_t>::max();
+
+  std::size_t c0, r0, c1, r1;
+
+  if(getCells(c.x - tolerance, c.y - tolerance, c.x + tolerance, c.y + tolerance, c0, r0, c1, r1))
+  {
+    for(std::size_t r = r0; r <= r1; ++r)
+    {
+      for(std::size_t col = c0; col <= c1; ++col)
+      {
+        const std::size_t cell = r * m_nCols + col;
+
+        for(boost::uint32_t k = m_vertexCells[cell]; k < m_vertexCells[cell + 1]; ++k)
+        {
+          const te::gm::Coord2D& v = m_vertices[m_vertexItems[k]];
+
+          const double dx = v.x - c.x;
+          const double dy = v.y - c.y;
+          const double d = dx * dx + dy * dy;
+
+          if(d <= minDistance)
+          {
+            minDistance = d;
+            nearest = m_vertexItems[k];
+          }
+        }
+      }
+    }
+  }
+
+  // The vertices not indexed yet
+  for(std::size_t i = m_nIndexedVertices; i < m_vertices.size(); ++i)
+  {
+    const double dx = m_vertices[i].x - c.x;
+    const double dy = m_vertices[i].y - c.y;
+    const double d = dx * dx + dy * dy;
+
+    if(d <= minDistance)
+    {
+      minDistance = d;
+      nearest = i;
+    }
+  }
+
+  if(nearest == std::numeric_limits<std::size_t>::max())
+    return false;
+
+  result = m_vertices[nearest];
+
+  return true;
+}
+
+bool te::edit::SnapIndex::nearestSegment(const te::gm::Coord2D& c, double tolerance, te::gm::Coord2D& result) const
+{
+  double minDistance = tolerance * tolerance;
+  bool found = false;
+
+  te::gm::Coord2D p;
+
+  std::size_t c0, r0, c1, r1;
+
+  if(getCells(c.x - tolerance, c.y - tolerance, c.x + tolerance, c.y + tolerance, c0, r0, c1, r1))
+  {
+    for(std::size_t r = r0; r <= r1; ++r)
+    {
+      for(std::size_t col = c0; col <= c1; ++col)
+      {
+        const std::size_t cell = r * m_nCols + col;
+
+        for(boost::uint32_t k = m_segmentCells[cell]; k < m_segmentCells[cell + 1]; ++k)
+        {
+          const std::size_t s = m_segmentItems[k];
+
+          double d = SegmentDistance2(c, m_vertices[m_segments[2 * s]], m_vertices[m_segments[2 * s + 1]], p);
+
+          if(d <= minDistance)
+          {
+            minDistance = d;
+            result = p;
+            found = true;
+          }
+        }
+      }
+    }
+  }
+
+  // The segments crossing too many cells and the ones not indexed yet
+  for(std::size_t k = 0; k < m_largeSegments.size(); ++k)
+  {
+    const std::size_t s = m_largeSegments[k];
+
+    double d = SegmentDistance2(c, m_vertices[m_segments[2 * s]], m_vertices[m_segments[2 * s + 1]], p);
+
+    if(d <= minDistance)
+    {
+      minDistance = d;
+      result = p;
+      found = true;
+    }
+  }
+
+  for(std::size_t s = m_nIndexedSegments; s < m_segments.size() / 2; ++s)
+  {
+    double d = SegmentDistance2(c, m_vertices[m_segments[2 * s]], m_vertices[m_segments[2 * s + 1]], p);
+
+    if(d <= minDistance)
+    {
+      minDistance = d;
+      result = p;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+void te::edit::SnapIndex::update()
+{
+  const std::size_t pending = (m_vertices.size() - m_nIndexedVertices) + (m_segments.size() / 2 - m_nIndexedSegments);
+
+  // A linear scan of a few thousand items is still cheap
+  if(pending < std::max<std::size_t>(4096, (m_nIndexedVertices + m_nIndexedSegments) / 4))
+    return;
+
+  build();
+}
+
+void te::edit::SnapIndex::build()
+{
+  const std::size_t nVertices = m_vertices.size();
+  const std::size_t nSegments = m_segments.size() / 2;
+
+  if(nVertices == 0)
+    return;
+
+  // The grid covers the vertices bounding rectangle
+  double llx = m_vertices[0].x;
+  double lly = m_vertices[0].y;
+  double urx = llx;
+  double ury = lly;
+
+  for(std::size_t i = 1; i < nVertices; ++i)
+  {
+    llx = std::min(llx, m_vertices[i].x);
+    lly = std::min(lly, m_vertices[i].y);
+    urx = std::max(urx, m_vertices[i].x);
+    ury = std::max(ury, m_vertices[i].y);
+  }
+
+  double width = urx - llx;
+  double height = ury - lly;
+
+  // The cell size gives a few vertices per cell
+  double nCells = std::max(1.0, static_cast<double>(nVertices) / TE_EDIT_SNAP_ITEMS_PER_CELL);
+
+  m_cellSize = std::sqrt(std::max(width * height, 0.0) / nCells);
+
+  if(m_cellSize <= 0.0)
+    m_cellSize = std::max(width, height) / nCells;
+
+  if(m_cellSize <= 0.0)
+    m_cellSize = 1.0;
+
+  m_cellSize = std::max(m_cellSize, std::max(width, height) / TE_EDIT_SNAP_MAX_GRID_SIZE);
+
+  m_llx = llx;
+  m_lly = lly;
+  m_nCols = static_cast<std::size_t>(width / m_cellSize) + 1;
+  m_nRows = static_cast<std::size_t>(height / m_cellSize) + 1;
+
+  const std::size_t size = m_nCols * m_nRows;
+
+  // Vertices: counting sort by cell
+  std::vector<boost::uint32_t> cellOf(nVertices);
+
+  m_vertexCells.assign(size + 1, 0);
+
+  for(std::size_t i = 0; i < nVertices; ++i)
+  {
+    std::size_t col = std::min(static_cast<std::size_t>((m_vertices[i].x - m_llx) / m_cellSize), m_nCols - 1);
+    std::size_t row = std::min(static_cast<std::size_t>((m_vertices[i].y - m_lly) / m_cellSize), m_nRows - 1);
+
+    cellOf[i] = static_cast<boost::uint32_t>(row * m_nCols + col);
+
+    ++m_vertexCells[cellOf[i] + 1];
+  }
+
+  for(std::size_t i = 0; i < size; ++i)
+    m_vertexCells[i + 1] += m_vertexCells[i];
+
+  m_vertexItems.resize(nVertices);
+
+  {
+    std::vector<boost::uint32_t> next(m_vertexCells.begin(), m_vertexCells.end() - 1);
+
+    for(std::size_t i = 0; i < nVertices; ++i)
+      m_vertexItems[next[cellOf[i]]++] = static_cast<boost::uint32_t>(i);
+  }
+
+  // Segments: each one is registered in the cells covered by its bounding rectangle
+  m_largeSegments.clear();
+  m_segmentCells.assign(size + 1, 0);
+
+  std::vector<char> large(nSegments, 0);
+
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    std::vector<boost::uint32_t> next;
+
+    if(pass == 1)
+    {
+      for(std::size_t i = 0; i < size; ++i)
+        m_segmentCells[i + 1] += m_segmentCells[i];
+
+      m_segmentItems.resize(m_segmentCells[size]);
+
+      next.assign(m_segmentCells.begin(), m_segmentCells.end() - 1);
+    }
+
+    for(std::size_t s = 0; s < nSegments; ++s)
+    {
+      if(large[s])
+        continue;
+
+      const te::gm::Coord2D& a = m_vertices[m_segments[2 * s]];
+      const te::gm::Coord2D& b = m_vertices[m_segments[2 * s + 1]];
+
+      std::size_t c0, r0, c1, r1;
+
+      getCells(std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x), std::max(a.y, b.y), c0, r0, c1, r1);
+
+      if(pass == 0 && (c1 - c0 + 1) * (r1 - r0 + 1) > TE_EDIT_SNAP_MAX_CELLS_PER_SEGMENT)
+      {
+        large[s] = 1;
+        m_largeSegments.push_back(static_cast<boost::uint32_t>(s));
+        continue;
+      }
+
+      for(std::size_t r = r0; r <= r1; ++r)
+      {
+        for(std::size_t col = c0; col <= c1; ++col)
+        {
+          if(pass == 0)
+            ++m_segmentCells[r * m_nCols + col + 1];
+          else
+            m_segmentItems[next[r * m_nCols + col]++] = static_cast<boost::uint32_t>(s);
+        }
+      }
+    }
+  }
+
+  m_nIndexedVertices = nVertices;
+  m_nIndexedSegments = nSegments;
+}
+
+bool te::edit::SnapIndex::getCells(double llx, double lly, double urx, double ury,
+                                   std::size_t& c0, std::size_t& r0, std::size_t& c1, std::size_t& r1) const
+{
+  if(m_nCols == 0 || m_nRows == 0)
+    return false;
+
+  const double maxx = m_llx + m_cellSize * m_nCols;
+  const double maxy = m_lly + m_cellSize * m_nRows;
+
+  if(urx < m_llx || ury < m_lly || llx > maxx || lly > maxy)
+    return false;
+
+  c0 = static_cast<std::size_t>(std::max(0.0, (llx - m_llx) / m_cellSize));
+  r0 = static_cast<std::size_t>(std::max(0.0, (lly - m_lly) / m_cellSize));
+  c1 = static_cast<std::size_t>(std::max(0.0, (urx - m_llx) / m_cellSize));
+  r1 = static_cast<std::size_t>(std::max(0.0, (ury - m_lly) / m_cellSize));
+
+  c0 = std::min(c0, m_nCols - 1);
+  r0 = std::min(r0, m_nRows - 1);
+  c1 = std::min(c1, m_nCols - 1);
+  r1 = std::min(r1, m_nRows - 1);
+
+  return true;
+}
+
+double te::edit::SnapIndex::SegmentDistance2(const te::gm::Coord2D& c, const te::gm::Coord2D& a, const te::gm::Coord2D& b,
+                                             te::gm::Coord2D& nearest)
+{
+  const double dx = b.x - a.x;
+  const double dy = b.y - a.y;
+  const double length2 = dx * dx + dy * dy;
+
+  double t = 0.0;
+
+  if(length2 > 0.0)
+    t = std::min(1.0, std::max(0.0, ((c.x - a.x) * dx + (c.y - a.y) * dy) / length2));
+
+  nearest.x = a.x + t * dx;
+  nearest.y = a.y + t * dy;
+
+  const double ex = c.x - nearest.x;
+  const double ey = c.y - nearest.y;
+
+  return ex * ex + ey * ey;
+}
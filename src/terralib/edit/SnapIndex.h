@@ -0,0 +1,152 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/edit/SnapIndex.h
+
+  \brief A uniform grid over the vertices and segments of the snap geometries.
+*/
+
+#ifndef __TERRALIB_EDIT_INTERNAL_SNAPINDEX_H
+#define __TERRALIB_EDIT_INTERNAL_SNAPINDEX_H
+
+// TerraLib
+#include "../geometry/Coord2D.h"
+#include "Config.h"
+
+// Boost
+#include <boost/cstdint.hpp>
+
+// STL
+#include <vector>
+
+namespace te
+{
+// Forward declarations
+  namespace gm
+  {
+    class Geometry;
+  }
+
+  namespace edit
+  {
+    /*!
+      \class SnapIndex
+
+      \brief A uniform grid over the vertices and segments of the snap geometries.
+
+      \details The vertices are stored in a flat array and the segments as pairs of vertex
+               indexes. The grid keeps, for each cell, a contiguous range of a single array
+               of item indexes, so a search only visits the cells around the searched point.
+
+               The items added after the last grid build are scanned linearly. The grid is
+               rebuilt when they exceed a fraction of the indexed ones, so the geometries can
+               be added incrementally, while the index is being searched.
+
+               The segments crossing too many cells are kept apart and always scanned.
+    */
+    class TEEDITEXPORT SnapIndex
+    {
+      public:
+
+        SnapIndex();
+
+        ~SnapIndex();
+
+        /*! \brief It adds the vertices and the segments of a geometry. */
+        void add(te::gm::Geometry* geom);
+
+        /*!
+          \brief It adds a sequence of vertices.
+
+          \param coords The vertices.
+          \param n      The number of vertices.
+          \param path   If true, the segments between consecutive vertices are also added.
+        */
+        void add(const te::gm::Coord2D* coords, std::size_t n, bool path);
+
+        void clear();
+
+        std::size_t getNumVertices() const;
+
+        std::size_t getNumSegments() const;
+
+        /*!
+          \brief It searches the nearest vertex of a point.
+
+          \param c         The point.
+          \param tolerance The maximum distance.
+          \param result    The nearest vertex, if any.
+
+          \return True if there is a vertex within the tolerance.
+        */
+        bool nearestVertex(const te::gm::Coord2D& c, double tolerance, te::gm::Coord2D& result) const;
+
+        /*!
+          \brief It searches the nearest point of the segments to a point.
+
+          \param c         The point.
+          \param tolerance The maximum distance.
+          \param result    The nearest point on a segment, if any.
+
+          \return True if there is a segment within the tolerance.
+        */
+        bool nearestSegment(const te::gm::Coord2D& c, double tolerance, te::gm::Coord2D& result) const;
+
+      protected:
+
+        /*! \brief It rebuilds the grid if too many items were added since the last build. */
+        void update();
+
+        /*! \brief It builds the grid for all the items. */
+        void build();
+
+        /*! \brief It returns the cells range covered by a rectangle, clipped to the grid. */
+        bool getCells(double llx, double lly, double urx, double ury,
+                      std::size_t& c0, std::size_t& r0, std::size_t& c1, std::size_t& r1) const;
+
+        /*! \brief It returns the squared distance from a point to a segment and the nearest point on it. */
+        static double SegmentDistance2(const te::gm::Coord2D& c, const te::gm::Coord2D& a, const te::gm::Coord2D& b,
+                                       te::gm::Coord2D& nearest);
+
+      private:
+
+        std::vector<te::gm::Coord2D> m_vertices;                //!< The vertices.
+        std::vector<boost::uint32_t> m_segments;                //!< The segments, as pairs of vertex indexes.
+
+        double m_llx;                                           //!< The grid lower left x.
+        double m_lly;                                           //!< The grid lower left y.
+        double m_cellSize;                                      //!< The grid cell size.
+        std::size_t m_nCols;                                    //!< The number of grid columns.
+        std::size_t m_nRows;                                    //!< The number of grid rows.
+
+        std::vector<boost::uint32_t> m_vertexCells;             //!< The start of each cell in m_vertexItems (number of cells + 1).
+        std::vector<boost::uint32_t> m_vertexItems;             //!< The vertex indexes, sorted by cell.
+        std::vector<boost::uint32_t> m_segmentCells;            //!< The start of each cell in m_segmentItems (number of cells + 1).
+        std::vector<boost::uint32_t> m_segmentItems;            //!< The segment indexes, sorted by cell.
+        std::vector<boost::uint32_t> m_largeSegments;           //!< The segments crossing too many cells.
+
+        std::size_t m_nIndexedVertices;                         //!< The number of vertices in the grid.
+        std::size_t m_nIndexedSegments;                         //!< The number of segments in the grid.
+    };
+
+  } // end namespace edit
+}   // end namespace te
+
+#endif  // __TERRALIB_EDIT_INTERNAL_SNAPINDEX_H
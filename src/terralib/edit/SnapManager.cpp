@@ -80,6 +80,13 @@ void te::edit::SnapManager::buildSnap(const std::string& source, int srid, te::d
     snap->build(dataset);
 }
 
+void te::edit::SnapManager::buildSnapAsync(const std::string& source, int srid, te::da::DataSet* dataset)
+{
+  createSnap(source, srid);
+
+  getSnap(source)->buildAsync(dataset);
+}
+
 void te::edit::SnapManager::removeSnap(const std::string& source)
 {
   std::map<std::string, Snap*>::iterator it = m_snaps.find(source);
@@ -77,6 +77,13 @@ namespace te
 
         void buildSnap(const std::string& source, int srid, te::da::DataSet* dataset);
 
+        /*!
+          \brief It builds the snap associated with the given source in a background thread.
+
+          \param dataset The dataset with the snap geometries. The snap will take its ownership.
+        */
+        void buildSnapAsync(const std::string& source, int srid, te::da::DataSet* dataset);
+
         void removeSnap(const std::string& source);
 
         const std::map<std::string, Snap*>& getSnaps() const;
@@ -24,19 +24,22 @@
 */
 
 // TerraLib
+#include "../geometry/Envelope.h"
 #include "SnapVertex.h"
-#include "Utils.h"
 
 // STL
+#include <algorithm>
 #include <cassert>
 
 te::edit::SnapVertex::SnapVertex(const std::string& source, int srid)
-  : Snap(source, srid)
+  : Snap(source, srid),
+    m_snapToSegments(false)
 {
 }
 
 te::edit::SnapVertex::~SnapVertex()
 {
+  cancelBuild();
 }
 
 void te::edit::SnapVertex::add(te::gm::Geometry* geom)
@@ -46,17 +49,7 @@ void te::edit::SnapVertex::add(te::gm::Geometry* geom)
   if(m_maxGeometries > 0 && m_nGeometries >= m_maxGeometries)
     return;
 
-  std::size_t lastPos = m_coords.size();
-
-  // Adding the new coordinates
-  GetCoordinates(geom, m_coords);
-
-  // Indexing...
-  for(std::size_t i = lastPos; i < m_coords.size(); ++i)
-  {
-    te::gm::Envelope e(m_coords[i].x, m_coords[i].y, m_coords[i].x, m_coords[i].y);
-    m_rtree.insert(e, i);
-  }
+  m_index.add(geom);
 
   ++m_nGeometries;
 }
@@ -64,8 +57,7 @@ void te::edit::SnapVertex::add(te::gm::Geometry* geom)
 void te::edit::SnapVertex::clear()
 {
   m_nGeometries = 0;
-  m_coords.clear();
-  m_rtree.clear();
+  m_index.clear();
 }
 
 std::string te::edit::SnapVertex::getName() const
@@ -78,6 +70,16 @@ std::string te::edit::SnapVertex::getDescription() const
   return "Implements vertex search snap.";
 }
 
+void te::edit::SnapVertex::setSnapToSegments(bool on)
+{
+  m_snapToSegments = on;
+}
+
+bool te::edit::SnapVertex::getSnapToSegments() const
+{
+  return m_snapToSegments;
+}
+
 te::edit::Snap* te::edit::SnapVertex::Builder(const std::string& source, int srid)
 {
   return new SnapVertex(source, srid);
@@ -87,40 +89,12 @@ bool te::edit::SnapVertex::search(const te::gm::Envelope& e, te::gm::Coord2D& re
 {
   assert(e.isValid());
 
-  std::vector<std::size_t> report;
-  m_rtree.search(e, report);
-
-  if(report.empty())
-    return false;
-
-  std::size_t snappedPos = report[0];
-
-  if(report.size() > 1)
-  {
-    // Finds the nearest coordinate
-    te::gm::Coord2D center = e.getCenter();
-    double minDistance = std::numeric_limits<double>::max();
-    for(std::size_t i = 1; i < report.size(); ++i)
-    {
-      const te::gm::Coord2D& foundCoord = m_coords[report[i]];
-      double distance = GetDistance(center, foundCoord);
-      if(distance < minDistance)
-      {
-        minDistance = distance;
-        snappedPos = report[i];
-      }
-    }
-  }
-
-  assert(snappedPos < m_coords.size());
-
-  // Gets the snapped coordinate
-  const te::gm::Coord2D& snapped = m_coords[snappedPos];
-
-  // Informs the output
-  result.x = snapped.x;
-  result.y = snapped.y;
-
-  return true;
-}
+  te::gm::Coord2D center = e.getCenter();
 
+  double tolerance = std::max(e.getWidth(), e.getHeight()) / 2.0;
+
+  if(m_index.nearestVertex(center, tolerance, result))
+    return true;
+
+  return m_snapToSegments && m_index.nearestSegment(center, tolerance, result);
+}
@@ -27,11 +27,8 @@
 #define __TERRALIB_EDIT_INTERNAL_SNAPVERTEX_H
 
 // TerraLib
-#include "../sam/rtree/Index.h"
 #include "Snap.h"
-
-// STL
-#include <vector>
+#include "SnapIndex.h"
 
 namespace te
 {
@@ -41,6 +38,9 @@ namespace te
       \class SnapVertex
 
       \brief This class implements a vertex search snap.
+
+      \details The vertices are kept in a uniform grid. Optionally, when there is no vertex
+               within the tolerance, the nearest point on the geometries segments is snapped.
     */
     class TEEDITEXPORT SnapVertex : public Snap
     {
@@ -58,6 +58,11 @@ namespace te
 
         std::string getDescription() const;
 
+        /*! \brief It enables the snap to the nearest segment point when there is no vertex within the tolerance. */
+        void setSnapToSegments(bool on);
+
+        bool getSnapToSegments() const;
+
         static Snap* Builder(const std::string& source, int srid);
 
       protected:
@@ -66,8 +71,8 @@ namespace te
 
       private:
 
-        std::vector<te::gm::Coord2D> m_coords;          //!< The snap coordinates.
-        te::sam::rtree::Index<std::size_t, 8> m_rtree;  //!< Internal index used to retrieve geometries spatially.
+        SnapIndex m_index;                              //!< The snap vertices and segments.
+        bool m_snapToSegments;                          //!< If true, the segments are also snapped.
     };
 
   } // end namespace edit
@@ -25,6 +25,9 @@
 
 // TerraLib
 #include "../../dataaccess/dataset/DataSet.h"
+#include "../../dataaccess/utils/Utils.h"
+#include "../../geometry/GeometryProperty.h"
+#include "../../srs/Config.h"
 #include "../Snap.h"
 #include "../SnapManager.h"
 #include "SnapOptionsDialog.h"
@@ -150,9 +153,27 @@ void te::edit::SnapOptionsDialog::onOkPushButtonPressed()
     {
       if(SnapManager::getInstance().hasSnap(layer->getId()) == false)
       {
-        // Build the snap
-        std::auto_ptr<te::da::DataSet> dataset(layer->getData());
-        SnapManager::getInstance().buildSnap(layer->getId(), layer->getSRID(), dataset.get());
+        // Build the snap with the geometries of the visible extent, in background
+        std::auto_ptr<te::da::DataSet> dataset;
+
+        std::auto_ptr<te::map::LayerSchema> schema(layer->getSchema());
+        te::gm::GeometryProperty* gp = te::da::GetFirstGeomProperty(schema.get());
+
+        if(m_display && gp && m_display->getExtent().isValid())
+        {
+          te::gm::Envelope env(m_display->getExtent());
+
+          if(m_display->getSRID() != TE_UNKNOWN_SRS && layer->getSRID() != TE_UNKNOWN_SRS && m_display->getSRID() != layer->getSRID())
+            env.transform(m_display->getSRID(), layer->getSRID());
+
+          dataset = layer->getData(gp->getName(), &env, te::gm::INTERSECTS);
+        }
+        else
+        {
+          dataset = layer->getData();
+        }
+
+        SnapManager::getInstance().buildSnapAsync(layer->getId(), layer->getSRID(), dataset.release());
 
         if (m_display)
         {
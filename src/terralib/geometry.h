@@ -72,6 +72,7 @@
 #include "geometry/ProjectiveGTFactory.h"
 #include "geometry/RSTGT.h"
 #include "geometry/RSTGTFactory.h"
+#include "geometry/ScopedGEOSCache.h"
 #include "geometry/SecondDegreePolynomialGT.h"
 #include "geometry/SecondDegreePolynomialGTFactory.h"
 #include "geometry/ThirdDegreePolynomialGT.h"
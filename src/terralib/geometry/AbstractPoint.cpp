@@ -68,11 +68,15 @@ const std::string& te::gm::AbstractPoint::getGeometryType() const throw()
 
 void te::gm::AbstractPoint::setSRID(int srid) throw()
 {
+  clearGEOSCache();
+
   m_srid = srid;
 }
 
 void te::gm::AbstractPoint::transform(int srid) throw(te::common::Exception)
 {
+  clearGEOSCache();
+
 #ifdef TERRALIB_MOD_SRS_ENABLED
   if(srid == m_srid)
     return;
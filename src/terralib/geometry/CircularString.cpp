@@ -103,11 +103,15 @@ const std::string& te::gm::CircularString::getGeometryType() const throw()
 
 void te::gm::CircularString::setSRID(int srid) throw()
 {
+  clearGEOSCache();
+
   m_srid = srid;
 }
 
 void te::gm::CircularString::transform(int srid) throw(te::common::Exception)
 {
+  clearGEOSCache();
+
 #ifdef TERRALIB_MOD_SRS_ENABLED
   if(srid == m_srid)
     return;
@@ -192,6 +196,8 @@ bool te::gm::CircularString::isClosed() const
 
 void te::gm::CircularString::setNumCoordinates(std::size_t size)
 {
+  clearGEOSCache();
+
   m_coords.resize(size);
 
   if((m_gType & 0xF00) == 0x300)
@@ -207,6 +213,8 @@ void te::gm::CircularString::setNumCoordinates(std::size_t size)
 
 void te::gm::CircularString::makeEmpty()
 {
+  clearGEOSCache();
+
   m_coords.clear();
   m_zA.clear();
   m_mA.clear();
@@ -230,6 +238,8 @@ te::gm::Point* te::gm::CircularString::getPointN(std::size_t i) const
 
 void te::gm::CircularString::setPointN(std::size_t i, const Point& p)
 {
+  clearGEOSCache();
+
   assert(i < size());
 
   m_coords[i].x = p.getX();
@@ -248,6 +258,8 @@ void te::gm::CircularString::setPointN(std::size_t i, const Point& p)
 
 void te::gm::CircularString::setPoint(std::size_t i, const double& x, const double& y)
 {
+  clearGEOSCache();
+
   assert(i < size());
   m_coords[i].x = x;
   m_coords[i].y = y;
@@ -255,6 +267,8 @@ void te::gm::CircularString::setPoint(std::size_t i, const double& x, const doub
 
 void te::gm::CircularString::setPointZ(std::size_t i, const double& x, const double& y, const double& z)
 {
+  clearGEOSCache();
+
   assert((i < size()) && (m_zA.empty() == false));
   m_coords[i].x = x;
   m_coords[i].y = y;
@@ -263,6 +277,8 @@ void te::gm::CircularString::setPointZ(std::size_t i, const double& x, const dou
 
 void te::gm::CircularString::setPointM(std::size_t i, const double& x, const double& y, const double& m)
 {
+  clearGEOSCache();
+
   assert((i < size()) && (m_mA.empty() == false));
   m_coords[i].x = x;
   m_coords[i].y = y;
@@ -271,6 +287,8 @@ void te::gm::CircularString::setPointM(std::size_t i, const double& x, const dou
 
 void te::gm::CircularString::setPointZM(std::size_t i, const double& x, const double& y, const double& z, const double& m)
 {
+  clearGEOSCache();
+
   assert((i < size()) && (m_zA.empty() == false) && (m_mA.empty() == false));
   m_coords[i].x = x;
   m_coords[i].y = y;
@@ -305,18 +323,24 @@ const double& te::gm::CircularString::getM(std::size_t i) const
 
 void te::gm::CircularString::setX(std::size_t i, const double& x)
 {
+  clearGEOSCache();
+
   assert(i < size());
   m_coords[i].x = x;
 }
 
 void te::gm::CircularString::setY(std::size_t i, const double& y)
 {
+  clearGEOSCache();
+
   assert(i < size());
   m_coords[i].y = y;
 }
 
 void te::gm::CircularString::setZ(std::size_t i, const double& z)
 {
+  clearGEOSCache();
+
   assert((i < size()) && (m_zA.empty() == false));
   m_zA[i] = z;
 }
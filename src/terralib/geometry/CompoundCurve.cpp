@@ -91,11 +91,15 @@ const std::string& te::gm::CompoundCurve::getGeometryType() const throw()
 
 void te::gm::CompoundCurve::setSRID(int srid) throw()
 {
+  clearGEOSCache();
+
   m_srid = srid;
 }
 
 void te::gm::CompoundCurve::transform(int srid) throw(te::common::Exception)
 {
+  clearGEOSCache();
+
 #ifdef TERRALIB_MOD_SRS_ENABLED
   if(srid == m_srid)
     return;
@@ -190,6 +194,8 @@ bool te::gm::CompoundCurve::isClosed() const
 
 void te::gm::CompoundCurve::makeEmpty()
 {
+  clearGEOSCache();
+
   te::common::FreeContents(m_curves);
   m_curves.clear();
 }
@@ -203,5 +209,7 @@ te::gm::Curve* te::gm::CompoundCurve::getCurve(std::size_t i) const
 
 void te::gm::CompoundCurve::add(Curve* c)
 {
+  clearGEOSCache();
+
   m_curves.push_back(c);
 }
@@ -97,6 +97,8 @@ std::size_t te::gm::CurvePolygon::getNumInteriorRings() const
 
 void te::gm::CurvePolygon::setNumRings(std::size_t size)
 {
+  clearGEOSCache();
+
   if(size < m_rings.size())
   {
     std::size_t oldSize = m_rings.size();
@@ -115,6 +117,8 @@ te::gm::Curve* te::gm::CurvePolygon::getInteriorRingN(std::size_t i) const
 
 void te::gm::CurvePolygon::setRingN(std::size_t i, Curve* r)
 {
+  clearGEOSCache();
+
   assert(i < m_rings.size());
   delete m_rings[i];
 
@@ -124,6 +128,8 @@ void te::gm::CurvePolygon::setRingN(std::size_t i, Curve* r)
 
 void te::gm::CurvePolygon::removeRingN(std::size_t i)
 {
+  clearGEOSCache();
+
   assert(i < m_rings.size());
   delete m_rings[i];
   m_rings.erase(m_rings.begin() + i);
@@ -131,18 +137,24 @@ void te::gm::CurvePolygon::removeRingN(std::size_t i)
 
 void te::gm::CurvePolygon::add(Curve* ring)
 {
+  clearGEOSCache();
+
   ring->setSRID(this->getSRID());
   m_rings.push_back(ring);
 }
 
 void te::gm::CurvePolygon::push_back(Curve* ring)
 {
+  clearGEOSCache();
+
   ring->setSRID(this->getSRID());
   m_rings.push_back(ring);
 }
 
 void te::gm::CurvePolygon::clear()
 {
+  clearGEOSCache();
+
   te::common::FreeContents(m_rings);
   m_rings.clear();
 }
@@ -229,6 +241,8 @@ const std::string& te::gm::CurvePolygon::getGeometryType() const throw()
 
 void te::gm::CurvePolygon::setSRID(int srid) throw()
 {
+  clearGEOSCache();
+
   std::size_t n = m_rings.size();
 
   for(std::size_t i = 0; i < n; ++i)
@@ -239,6 +253,8 @@ void te::gm::CurvePolygon::setSRID(int srid) throw()
 
 void te::gm::CurvePolygon::transform(int srid) throw(te::common::Exception)
 {
+  clearGEOSCache();
+
 #ifdef TERRALIB_MOD_SRS_ENABLED
   if(srid == m_srid)
     return;
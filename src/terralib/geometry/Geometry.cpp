@@ -33,6 +33,10 @@
 #include "Geometry.h"
 #include "GEOSReader.h"
 #include "GEOSWriter.h"
+#include "LineString.h"
+#include "MultiPolygon.h"
+#include "Point.h"
+#include "Polygon.h"
 #include "Utils.h"
 #include "WKTReader.h"
 #include "WKTWriter.h"
@@ -40,6 +44,7 @@
 #include "WKBWriter.h"
 
 // STL
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <memory>
@@ -49,30 +54,213 @@
 // GEOS
 #include <geos/geom/Geometry.h>
 #include <geos/geom/IntersectionMatrix.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+#include <geos/geom/prep/PreparedGeometryFactory.h>
 #include <geos/operation/buffer/OffsetCurveBuilder.h>
 #include <geos/operation/union/CascadedPolygonUnion.h>
 #include <geos/util/GEOSException.h>
 #endif
 
+namespace te
+{
+  namespace gm
+  {
+    /*!
+      \class GEOSCache
+
+      \brief The cached GEOS representation of a geometry.
+    */
+    class GEOSCache
+    {
+      public:
+
+#ifdef TERRALIB_GEOS_ENABLED
+        std::auto_ptr<geos::geom::Geometry> m_geom;                         //!< The GEOS geometry.
+        std::auto_ptr<const geos::geom::prep::PreparedGeometry> m_prepared;  //!< The prepared GEOS geometry (built on demand).
+#endif
+    };
+  } // end namespace gm
+}   // end namespace te
+
+namespace
+{
+#ifdef TERRALIB_GEOS_ENABLED
+  /*!
+    \class GEOSGeometryRef
+
+    \brief The GEOS representation of a geometry, borrowed from the geometry cache or owned by the reference.
+  */
+  class GEOSGeometryRef
+  {
+    public:
+
+      GEOSGeometryRef(const te::gm::Geometry* g, te::gm::GEOSCache* cache)
+        : m_geom(0)
+      {
+        if(cache == 0)
+        {
+          m_owned.reset(te::gm::GEOSWriter::write(g));
+          m_geom = m_owned.get();
+          return;
+        }
+
+        if(cache->m_geom.get() == 0)
+          cache->m_geom.reset(te::gm::GEOSWriter::write(g));
+
+        m_geom = cache->m_geom.get();
+      }
+
+      const geos::geom::Geometry* get() const { return m_geom; }
+
+      const geos::geom::Geometry* operator->() const { return m_geom; }
+
+    private:
+
+      std::auto_ptr<geos::geom::Geometry> m_owned;  //!< The converted geometry when the cache is disabled.
+      const geos::geom::Geometry* m_geom;           //!< The GEOS geometry.
+  };
+
+  /*! \brief It returns the cached prepared geometry, building it if needed. */
+  const geos::geom::prep::PreparedGeometry* GetPreparedGeometry(te::gm::GEOSCache* cache, const GEOSGeometryRef& g)
+  {
+    if(cache->m_prepared.get() == 0)
+      cache->m_prepared.reset(geos::geom::prep::PreparedGeometryFactory::prepare(g.get()));
+
+    return cache->m_prepared.get();
+  }
+#endif
+
+  /*! \brief The maximum number of segment pairs tested natively by the line string intersection test. */
+  const std::size_t sg_maxNativeSegmentPairs = 65536;
+
+  /*! \brief It checks if the envelope tests can be applied (empty geometries must be evaluated by GEOS). */
+  inline bool HasEnvelopes(const te::gm::Geometry* g1, const te::gm::Geometry* g2)
+  {
+    return (g1->getNPoints() != 0) && (g2->getNPoints() != 0);
+  }
+
+  /*! \brief It checks if the polygon rings are line strings. */
+  bool HasLinearRings(const te::gm::Polygon* poly)
+  {
+    for(std::size_t i = 0; i < poly->getNumRings(); ++i)
+    {
+      if(dynamic_cast<const te::gm::LineString*>(poly->getRingN(i)) == 0)
+        return false;
+    }
+
+    return true;
+  }
+
+  /*!
+    \brief It computes the location of a point relative to a point, a line string, a polygon or a multipolygon.
+
+    \param pt       The point.
+    \param g        The other geometry.
+    \param location 1 for the geometry interior, 0 for its boundary and -1 for its exterior.
+
+    \return False if the geometry type is not supported by the native test.
+  */
+  bool LocatePointInGeometry(const te::gm::Point* pt, const te::gm::Geometry* g, int& location)
+  {
+    te::gm::Coord2D c(pt->getX(), pt->getY());
+
+    if(const te::gm::Point* gpt = dynamic_cast<const te::gm::Point*>(g))
+    {
+      location = (c.x == gpt->getX() && c.y == gpt->getY()) ? 1 : -1;
+      return true;
+    }
+
+    if(const te::gm::LineString* line = dynamic_cast<const te::gm::LineString*>(g))
+    {
+      location = te::gm::LocatePoint(c, *line);
+      return true;
+    }
+
+    if(const te::gm::Polygon* poly = dynamic_cast<const te::gm::Polygon*>(g))
+    {
+      if(!HasLinearRings(poly))
+        return false;
+
+      location = te::gm::LocatePoint(c, *poly);
+      return true;
+    }
+
+    if(const te::gm::MultiPolygon* mpoly = dynamic_cast<const te::gm::MultiPolygon*>(g))
+    {
+      location = -1;
+
+      for(std::size_t i = 0; i < mpoly->getNumGeometries(); ++i)
+      {
+        const te::gm::Polygon* part = dynamic_cast<const te::gm::Polygon*>(mpoly->getGeometryN(i));
+
+        if(part == 0 || !HasLinearRings(part))
+          return false;
+
+        location = std::max(location, te::gm::LocatePoint(c, *part));
+
+        if(location == 1)
+          break;
+      }
+
+      return true;
+    }
+
+    return false;
+  }
+
+  /*!
+    \brief It checks natively if two geometries intersect, when one of them is a point or both are line strings.
+
+    \return False if the pair is not supported by the native tests.
+  */
+  bool NativeIntersects(const te::gm::Geometry* g1, const te::gm::Geometry* g2, bool& result)
+  {
+    int location = -1;
+
+    const te::gm::Point* pt = dynamic_cast<const te::gm::Point*>(g1);
+
+    if((pt != 0 && LocatePointInGeometry(pt, g2, location)) ||
+       ((pt = dynamic_cast<const te::gm::Point*>(g2)) != 0 && LocatePointInGeometry(pt, g1, location)))
+    {
+      result = (location >= 0);
+      return true;
+    }
+
+    const te::gm::LineString* l1 = dynamic_cast<const te::gm::LineString*>(g1);
+    const te::gm::LineString* l2 = dynamic_cast<const te::gm::LineString*>(g2);
+
+    if(l1 != 0 && l2 != 0 && (l1->getNPoints() * l2->getNPoints() <= sg_maxNativeSegmentPairs))
+    {
+      result = te::gm::LineStringsIntersect(*l1, *l2);
+      return true;
+    }
+
+    return false;
+  }
+}
+
 std::map<std::string, te::gm::GeomType> te::gm::Geometry::sm_geomTypeMap;
 
 te::gm::Geometry::Geometry(GeomType t, int srid, Envelope* mbr) throw()
   : m_gType(t),
     m_srid(srid),
-    m_mbr(mbr)
+    m_mbr(mbr),
+    m_geosCache(0)
 {
 }
 
 te::gm::Geometry::Geometry(const Geometry& rhs) throw()
   : m_gType(rhs.m_gType),
     m_srid(rhs.m_srid),
-    m_mbr(0)
+    m_mbr(0),
+    m_geosCache(0)
 {
 }
 
 te::gm::Geometry::~Geometry()
 {
   delete m_mbr;
+  delete m_geosCache;
 }
 
 te::gm::Geometry& te::gm::Geometry::operator=(const Geometry& rhs) throw()
@@ -86,6 +274,8 @@ te::gm::Geometry& te::gm::Geometry::operator=(const Geometry& rhs) throw()
     delete m_mbr;
 
     m_mbr = rhs.m_mbr ? new Envelope(*rhs.m_mbr) : 0;
+
+    clearGEOSCache();
   }
 
   return *this;
@@ -144,7 +334,7 @@ void te::gm::Geometry::getWkb(char* wkb, te::common::MachineByteOrder byteOrder)
 bool te::gm::Geometry::isEmpty() const throw(std::exception)
 {
 #ifdef TERRALIB_GEOS_ENABLED
-  std::auto_ptr<geos::geom::Geometry> g(GEOSWriter::write(this));
+  GEOSGeometryRef g(this, m_geosCache);
 
   return g->isEmpty();
 
@@ -156,7 +346,7 @@ bool te::gm::Geometry::isEmpty() const throw(std::exception)
 bool te::gm::Geometry::isSimple() const throw(std::exception)
 {
 #ifdef TERRALIB_GEOS_ENABLED
-  std::auto_ptr<geos::geom::Geometry> g(GEOSWriter::write(this));
+  GEOSGeometryRef g(this, m_geosCache);
 
   return g->isSimple();
 
@@ -168,7 +358,7 @@ bool te::gm::Geometry::isSimple() const throw(std::exception)
 bool te::gm::Geometry::isValid() const throw(std::exception)
 {
 #ifdef TERRALIB_GEOS_ENABLED
-  std::auto_ptr<geos::geom::Geometry> g(GEOSWriter::write(this));
+  GEOSGeometryRef g(this, m_geosCache);
 
   return g->isValid();
 
@@ -202,7 +392,7 @@ bool te::gm::Geometry::isMeasured() const throw()
 te::gm::Geometry* te::gm::Geometry::getBoundary() const throw(std::exception)
 {
 #ifdef TERRALIB_GEOS_ENABLED
-  std::auto_ptr<geos::geom::Geometry> g(GEOSWriter::write(this)); 
+  GEOSGeometryRef g(this, m_geosCache);
   std::auto_ptr<geos::geom::Geometry> b(g->getBoundary());
   return GEOSReader::read(b.get());
 
@@ -213,15 +403,18 @@ te::gm::Geometry* te::gm::Geometry::getBoundary() const throw(std::exception)
 
 bool te::gm::Geometry::equals(const Geometry* const rhs, const bool exact) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-  
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs) && !getMBR()->intersects(*rhs->getMBR()))
+    return false;
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   if(exact == true)
     return thisGeom->equalsExact(rhsGeom.get());
@@ -234,15 +427,29 @@ bool te::gm::Geometry::equals(const Geometry* const rhs, const bool exact) const
 
 bool te::gm::Geometry::disjoint(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs))
+  {
+    if(!getMBR()->intersects(*rhs->getMBR()))
+      return true;
+
+    bool result = false;
+
+    if(NativeIntersects(this, rhs, result))
+      return !result;
+  }
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->disjoint(rhsGeom.get());
 
   return thisGeom->disjoint(rhsGeom.get());
 
@@ -253,15 +460,29 @@ bool te::gm::Geometry::disjoint(const Geometry* const rhs) const throw(std::exce
 
 bool te::gm::Geometry::intersects(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs))
+  {
+    if(!getMBR()->intersects(*rhs->getMBR()))
+      return false;
+
+    bool result = false;
+
+    if(NativeIntersects(this, rhs, result))
+      return result;
+  }
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->intersects(rhsGeom.get());
 
   return thisGeom->intersects(rhsGeom.get());
 
@@ -272,15 +493,32 @@ bool te::gm::Geometry::intersects(const Geometry* const rhs) const throw(std::ex
 
 bool te::gm::Geometry::touches(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs))
+  {
+    if(!getMBR()->intersects(*rhs->getMBR()))
+      return false;
+
+    int location = -1;
+
+    const Point* pt = dynamic_cast<const Point*>(this);
+
+    if((pt != 0 && LocatePointInGeometry(pt, rhs, location)) ||
+       ((pt = dynamic_cast<const Point*>(rhs)) != 0 && LocatePointInGeometry(pt, this, location)))
+      return (location == 0);
+  }
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->touches(rhsGeom.get());
 
   return thisGeom->touches(rhsGeom.get());
 
@@ -291,15 +529,21 @@ bool te::gm::Geometry::touches(const Geometry* const rhs) const throw(std::excep
 
 bool te::gm::Geometry::crosses(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs) && !getMBR()->intersects(*rhs->getMBR()))
+    return false;
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->crosses(rhsGeom.get());
 
   return thisGeom->crosses(rhsGeom.get());
 
@@ -310,15 +554,31 @@ bool te::gm::Geometry::crosses(const Geometry* const rhs) const throw(std::excep
 
 bool te::gm::Geometry::within(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs))
+  {
+    if(!getMBR()->within(*rhs->getMBR()))
+      return false;
+
+    int location = -1;
+
+    const Point* pt = dynamic_cast<const Point*>(this);
+
+    if(pt != 0 && LocatePointInGeometry(pt, rhs, location))
+      return (location == 1);
+  }
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->within(rhsGeom.get());
 
   return thisGeom->within(rhsGeom.get());
 
@@ -329,15 +589,31 @@ bool te::gm::Geometry::within(const Geometry* const rhs) const throw(std::except
 
 bool te::gm::Geometry::contains(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs))
+  {
+    if(!getMBR()->contains(*rhs->getMBR()))
+      return false;
+
+    int location = -1;
+
+    const Point* pt = dynamic_cast<const Point*>(rhs);
+
+    if(pt != 0 && LocatePointInGeometry(pt, this, location))
+      return (location == 1);
+  }
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->contains(rhsGeom.get());
 
   return thisGeom->contains(rhsGeom.get());
 
@@ -348,15 +624,21 @@ bool te::gm::Geometry::contains(const Geometry* const rhs) const throw(std::exce
 
 bool te::gm::Geometry::overlaps(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs) && !getMBR()->intersects(*rhs->getMBR()))
+    return false;
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->overlaps(rhsGeom.get());
 
   return thisGeom->overlaps(rhsGeom.get());
 
@@ -375,9 +657,9 @@ bool te::gm::Geometry::relate(const Geometry* const rhs, const std::string& matr
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
     
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
+  GEOSGeometryRef thisGeom(this, m_geosCache);
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   return thisGeom->relate(rhsGeom.get(), matrix);
 
@@ -394,9 +676,9 @@ std::string te::gm::Geometry::relate(const Geometry* const rhs) const throw(std:
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
     
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
+  GEOSGeometryRef thisGeom(this, m_geosCache);
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   std::auto_ptr<geos::geom::IntersectionMatrix> m(thisGeom->relate(rhsGeom.get()));
 
@@ -409,15 +691,31 @@ std::string te::gm::Geometry::relate(const Geometry* const rhs) const throw(std:
 
 bool te::gm::Geometry::covers(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs))
+  {
+    if(!getMBR()->contains(*rhs->getMBR()))
+      return false;
+
+    int location = -1;
+
+    const Point* pt = dynamic_cast<const Point*>(rhs);
+
+    if(pt != 0 && LocatePointInGeometry(pt, this, location))
+      return (location >= 0);
+  }
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->covers(rhsGeom.get());
 
   return thisGeom->covers(rhsGeom.get());
 
@@ -428,15 +726,31 @@ bool te::gm::Geometry::covers(const Geometry* const rhs) const throw(std::except
 
 bool te::gm::Geometry::coveredBy(const Geometry* const rhs) const throw(std::exception)
 {
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs))
+  {
+    if(!getMBR()->within(*rhs->getMBR()))
+      return false;
+
+    int location = -1;
+
+    const Point* pt = dynamic_cast<const Point*>(this);
+
+    if(pt != 0 && LocatePointInGeometry(pt, rhs, location))
+      return (location >= 0);
+  }
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
+
+  if(m_geosCache != 0)
+    return GetPreparedGeometry(m_geosCache, thisGeom)->coveredBy(rhsGeom.get());
 
   return thisGeom->coveredBy(rhsGeom.get());
 
@@ -458,9 +772,9 @@ double te::gm::Geometry::distance(const Geometry* const rhs) const throw(std::ex
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
     
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
+  GEOSGeometryRef thisGeom(this, m_geosCache);
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   return thisGeom->distance(rhsGeom.get());
 
@@ -488,7 +802,7 @@ te::gm::Geometry* te::gm::Geometry::buffer(const double& distance,
                                            BufferCapStyle endCapStyle) const throw(std::exception)
 {
 #ifdef TERRALIB_GEOS_ENABLED
-  std::auto_ptr<geos::geom::Geometry> g(GEOSWriter::write(this));
+  GEOSGeometryRef g(this, m_geosCache);
 
   std::auto_ptr<geos::geom::Geometry> bg(g->buffer(distance, quadrantSegments, static_cast<int>(endCapStyle)));
 
@@ -505,7 +819,7 @@ te::gm::Geometry* te::gm::Geometry::buffer(const double& distance,
 te::gm::Geometry* te::gm::Geometry::convexHull() const throw(std::exception)
 {
 #ifdef TERRALIB_GEOS_ENABLED
-  std::auto_ptr<geos::geom::Geometry> g(GEOSWriter::write(this));
+  GEOSGeometryRef g(this, m_geosCache);
 
   std::auto_ptr<geos::geom::Geometry> hull(g->convexHull());
 
@@ -526,9 +840,9 @@ te::gm::Geometry* te::gm::Geometry::intersection(const Geometry* const rhs) cons
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
     
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
+  GEOSGeometryRef thisGeom(this, m_geosCache);
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   std::auto_ptr<geos::geom::Geometry> intersectionGeom(thisGeom->intersection(rhsGeom.get()));
 
@@ -549,9 +863,9 @@ te::gm::Geometry* te::gm::Geometry::Union(const Geometry* const rhs) const throw
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
   
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
+  GEOSGeometryRef thisGeom(this, m_geosCache);
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   std::auto_ptr<geos::geom::Geometry> unionGeom(thisGeom-> Union(rhsGeom.get()));
 
@@ -572,9 +886,9 @@ te::gm::Geometry* te::gm::Geometry::difference(const Geometry* const rhs) const
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
     
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
+  GEOSGeometryRef thisGeom(this, m_geosCache);
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   std::auto_ptr<geos::geom::Geometry> differenceGeom(thisGeom->difference(rhsGeom.get()));
 
@@ -595,9 +909,9 @@ te::gm::Geometry* te::gm::Geometry::symDifference(const Geometry* const rhs) con
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
     
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
+  GEOSGeometryRef thisGeom(this, m_geosCache);
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   std::auto_ptr<geos::geom::Geometry> symDifferenceGeom(thisGeom->symDifference(rhsGeom.get()));
 
@@ -613,15 +927,18 @@ bool te::gm::Geometry::dWithin(const Geometry* const rhs, const double& distance
 {
   assert(distance >= 0.0);
 
-#ifdef TERRALIB_GEOS_ENABLED
   if( m_srid != rhs->m_srid )
   {
     throw te::common::Exception(TE_TR("this method must not be used with different SRIDs geometries."));
   }
-    
-  std::auto_ptr<geos::geom::Geometry> thisGeom(GEOSWriter::write(this));
 
-  std::auto_ptr<geos::geom::Geometry> rhsGeom(GEOSWriter::write(rhs));
+  if(HasEnvelopes(this, rhs) && (getMBR()->distance(*rhs->getMBR()) > distance))
+    return false;
+
+#ifdef TERRALIB_GEOS_ENABLED
+  GEOSGeometryRef thisGeom(this, m_geosCache);
+
+  GEOSGeometryRef rhsGeom(rhs, rhs->m_geosCache);
 
   return thisGeom->isWithinDistance(rhsGeom.get(), distance);
 
@@ -630,6 +947,27 @@ bool te::gm::Geometry::dWithin(const Geometry* const rhs, const double& distance
 #endif
 }
 
+void te::gm::Geometry::enableGEOSCache() const
+{
+  if(m_geosCache == 0)
+    m_geosCache = new GEOSCache;
+}
+
+void te::gm::Geometry::disableGEOSCache() const
+{
+  delete m_geosCache;
+
+  m_geosCache = 0;
+}
+
+void te::gm::Geometry::releaseGEOSCache() const
+{
+#ifdef TERRALIB_GEOS_ENABLED
+  m_geosCache->m_prepared.reset();
+  m_geosCache->m_geom.reset();
+#endif
+}
+
 te::gm::GeomType te::gm::Geometry::getGeomTypeId(const std::string& gtype)
 {
   std::map<std::string, GeomType>::const_iterator it = sm_geomTypeMap.find(gtype);
@@ -48,6 +48,7 @@ namespace te
   {
 // Forward declarations
     class Envelope;
+    class GEOSCache;
 
     /*!
       \class Geometry
@@ -804,6 +805,56 @@ namespace te
 
         //@}
 
+        /** @name GEOS Cache
+         *  Methods for reusing the GEOS representation of the geometry in successive calls.
+         */
+        //@{
+
+        /*!
+          \brief It enables the cache of the GEOS representation of the geometry.
+
+          When the cache is enabled, the GEOS geometry used by the topological methods
+          (and the prepared geometry used by the spatial relations where this geometry is
+          the left operand) is built in the first call and reused by the next ones, instead
+          of being converted in each call.
+
+          \note The cache is cleared by the geometry setters, transform and setSRID. Changes made
+                to a component through a returned pointer (like getRingN or getGeometryN) are not
+                detected: call clearGEOSCache after them.
+
+          \note The cache is not thread-safe: don't share a geometry with an enabled cache between threads.
+
+          \note TerraLib extended method.
+        */
+        void enableGEOSCache() const;
+
+        /*!
+          \brief It disables the cache of the GEOS representation, releasing the cached objects.
+
+          \note TerraLib extended method.
+        */
+        void disableGEOSCache() const;
+
+        /*!
+          \brief It returns true if the cache of the GEOS representation is enabled.
+
+          \note TerraLib extended method.
+        */
+        bool isGEOSCacheEnabled() const { return m_geosCache != 0; }
+
+        /*!
+          \brief It releases the cached GEOS representation, keeping the cache enabled.
+
+          \note TerraLib extended method.
+        */
+        void clearGEOSCache() const
+        {
+          if(m_geosCache != 0)
+            releaseGEOSCache();
+        }
+
+        //@}
+
         /** @name Auxiliary Methods
          *  Auxiliary Methods.
          */
@@ -875,8 +926,14 @@ namespace te
         GeomType m_gType;         //!< Internal geometry type.
         int m_srid;               //!< The Spatial Reference System code associated to the Geometry.
         mutable Envelope* m_mbr;  //!< The geometry minimum bounding rectangle.
+        mutable GEOSCache* m_geosCache;  //!< The cached GEOS representation (NULL if the cache is disabled).
 
         static std::map<std::string, GeomType> sm_geomTypeMap;  //!< A set of geometry type names (in UPPER CASE).
+
+      private:
+
+        /*! \brief It releases the cached GEOS objects. */
+        void releaseGEOSCache() const;
     };
 	
 	//Typedef 
@@ -96,6 +96,8 @@ const std::string& te::gm::GeometryCollection::getGeometryType() const throw()
 
 void te::gm::GeometryCollection::setSRID(int srid) throw()
 {
+  clearGEOSCache();
+
   std::size_t n = m_geometries.size();
 
   for(std::size_t i = 0; i < n; ++i)
@@ -106,6 +108,8 @@ void te::gm::GeometryCollection::setSRID(int srid) throw()
 
 void te::gm::GeometryCollection::transform(int srid) throw(te::common::Exception)
 {
+  clearGEOSCache();
+
 #ifdef TERRALIB_MOD_SRS_ENABLED
   if(srid == m_srid)
     return;
@@ -167,6 +171,8 @@ std::size_t te::gm::GeometryCollection::getNPoints() const throw()
 
 void te::gm::GeometryCollection::setNumGeometries(std::size_t size)
 {
+  clearGEOSCache();
+
   if(size < m_geometries.size())
   {
     std::size_t oldSize = m_geometries.size();
@@ -191,6 +197,8 @@ te::gm::Geometry* te::gm::GeometryCollection::getGeometryN(std::size_t i)
 
 void te::gm::GeometryCollection::setGeometryN(std::size_t i, Geometry* g)
 {
+  clearGEOSCache();
+
   assert((i < m_geometries.size()) && (m_geometries[i] == 0));
   delete m_geometries[i];
   g->setSRID(this->getSRID());
@@ -199,6 +207,8 @@ void te::gm::GeometryCollection::setGeometryN(std::size_t i, Geometry* g)
 
 void te::gm::GeometryCollection::removeGeometryN(std::size_t i)
 {
+  clearGEOSCache();
+
   assert(i < m_geometries.size());
   delete m_geometries[i];
   m_geometries.erase(m_geometries.begin() + i);
@@ -206,12 +216,16 @@ void te::gm::GeometryCollection::removeGeometryN(std::size_t i)
 
 void te::gm::GeometryCollection::add(Geometry* g)
 {
+  clearGEOSCache();
+
   g->setSRID(this->getSRID());
   m_geometries.push_back(g);
 }
 
 void te::gm::GeometryCollection::clear()
 {
+  clearGEOSCache();
+
   te::common::FreeContents(m_geometries);
   m_geometries.clear();
 }
@@ -175,11 +175,15 @@ const std::string& te::gm::LineString::getGeometryType() const throw()
 
 void te::gm::LineString::setSRID(int srid) throw()
 {
+  clearGEOSCache();
+
   m_srid = srid;
 }
 
 void te::gm::LineString::transform(int srid) throw(te::common::Exception)
 {
+  clearGEOSCache();
+
 #ifdef TERRALIB_MOD_SRS_ENABLED
   if(srid == m_srid)
     return;
@@ -264,6 +268,8 @@ bool te::gm::LineString::isClosed() const
 
 void te::gm::LineString::setNumCoordinates(std::size_t size)
 {
+  clearGEOSCache();
+
   if(size < m_nPts)
   { // just decrease the known capacity... realloc just if needed!
     m_nPts = size;
@@ -309,6 +315,8 @@ void te::gm::LineString::setNumCoordinates(std::size_t size)
 
 void te::gm::LineString::makeEmpty()
 {
+  clearGEOSCache();
+
   free(m_coords);
   free(m_zA);
   free(m_mA);
@@ -338,6 +346,8 @@ te::gm::Point* te::gm::LineString::getPointN(std::size_t i) const
 
 void te::gm::LineString::setPointN(std::size_t i, const Point& p)
 {
+  clearGEOSCache();
+
   assert(i < m_nPts);
 
   m_coords[i].x = p.getX();
@@ -352,6 +362,8 @@ void te::gm::LineString::setPointN(std::size_t i, const Point& p)
 
 void te::gm::LineString::setPoint(std::size_t i, const double& x, const double& y)
 {
+  clearGEOSCache();
+
   assert(i < size());
   m_coords[i].x = x;
   m_coords[i].y = y;
@@ -359,6 +371,8 @@ void te::gm::LineString::setPoint(std::size_t i, const double& x, const double&
 
 void te::gm::LineString::setPointZ(std::size_t i, const double& x, const double& y, const double& z)
 {
+  clearGEOSCache();
+
   assert((i < m_nPts) && (m_zA != 0));
   m_coords[i].x = x;
   m_coords[i].y = y;
@@ -367,6 +381,8 @@ void te::gm::LineString::setPointZ(std::size_t i, const double& x, const double&
 
 void te::gm::LineString::setPointM(std::size_t i, const double& x, const double& y, const double& m)
 {
+  clearGEOSCache();
+
   assert((i < m_nPts) && (m_mA != 0));
   m_coords[i].x = x;
   m_coords[i].y = y;
@@ -375,6 +391,8 @@ void te::gm::LineString::setPointM(std::size_t i, const double& x, const double&
 
 void te::gm::LineString::setPointZM(std::size_t i, const double& x, const double& y, const double& z, const double& m)
 {
+  clearGEOSCache();
+
   assert((i < m_nPts) && (m_zA != 0) && (m_mA != 0));
   m_coords[i].x = x;
   m_coords[i].y = y;
@@ -409,18 +427,24 @@ const double& te::gm::LineString::getM(std::size_t i) const
 
 void te::gm::LineString::setX(std::size_t i, const double& x)
 {
+  clearGEOSCache();
+
   assert(i < size());
   m_coords[i].x = x;
 }
 
 void te::gm::LineString::setY(std::size_t i, const double& y)
 {
+  clearGEOSCache();
+
   assert(i < size());
   m_coords[i].y = y;
 }
 
 void te::gm::LineString::setZ(std::size_t i, const double& z)
 {
+  clearGEOSCache();
+
   assert((i < m_nPts) && (m_zA != 0));
   m_zA[i] = z;
 }
@@ -140,7 +140,7 @@ namespace te
 
           \param x The x-coordinate value for this Point.
         */
-        void setX(const double& x) { m_x = x; }
+        void setX(const double& x) { m_x = x; clearGEOSCache(); }
 
         /*!
           \brief It returns the Point y-coordinate value.
@@ -154,7 +154,7 @@ namespace te
 
           \param y The y-coordinate value for this Point.
         */
-        void setY(const double& y) { m_y = y; }
+        void setY(const double& y) { m_y = y; clearGEOSCache(); }
 
         /*!
           \brief It returns the Point z-coordinate value, if it has one or DoubleNotANumber otherwise.
@@ -142,7 +142,7 @@ namespace te
 
           \param z The z-coordinate value for this Point.
         */
-        void setZ(const double& z) { m_z = z; }
+        void setZ(const double& z) { m_z = z; clearGEOSCache(); }
 
         //@}
 
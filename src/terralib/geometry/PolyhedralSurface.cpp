@@ -72,6 +72,8 @@ te::dt::AbstractData* te::gm::PolyhedralSurface::clone() const
 
 void te::gm::PolyhedralSurface::setNumPatches(std::size_t size)
 {
+  clearGEOSCache();
+
   if(size < m_polygons.size())
   {
     std::size_t oldSize = m_polygons.size();
@@ -90,6 +92,8 @@ te::gm::Polygon* te::gm::PolyhedralSurface::getPatchN(std::size_t i) const
 
 void te::gm::PolyhedralSurface::setPatchN(std::size_t i, Polygon* p)
 {
+  clearGEOSCache();
+
   assert((i < m_polygons.size()) && (m_polygons[i] == 0));
   delete m_polygons[i];
   m_polygons[i] = p;
@@ -112,6 +116,8 @@ const std::string& te::gm::PolyhedralSurface::getGeometryType() const throw()
 
 void te::gm::PolyhedralSurface::setSRID(int srid) throw()
 {
+  clearGEOSCache();
+
   std::size_t n = m_polygons.size();
 
   for(std::size_t i = 0; i < n; ++i)
@@ -122,6 +128,8 @@ void te::gm::PolyhedralSurface::setSRID(int srid) throw()
 
 void te::gm::PolyhedralSurface::transform(int srid) throw(te::common::Exception)
 {
+  clearGEOSCache();
+
 #ifdef TERRALIB_MOD_SRS_ENABLED
   if (srid == m_srid)
     return;
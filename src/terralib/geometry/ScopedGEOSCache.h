@@ -0,0 +1,85 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/geometry/ScopedGEOSCache.h
+
+  \brief An utility class to keep the GEOS representation of a geometry cached during an operation.
+*/
+
+#ifndef __TERRALIB_GEOMETRY_INTERNAL_SCOPEDGEOSCACHE_H
+#define __TERRALIB_GEOMETRY_INTERNAL_SCOPEDGEOSCACHE_H
+
+// TerraLib
+#include "Config.h"
+
+// Boost
+#include <boost/noncopyable.hpp>
+
+namespace te
+{
+  namespace gm
+  {
+// Forward declarations
+    class Geometry;
+
+    /*!
+      \class ScopedGEOSCache
+
+      \brief An utility class to keep the GEOS representation of a geometry cached during an operation.
+
+      The cache is enabled on construction and, if it was not already
+      enabled, it is disabled when the object goes out of scope.
+
+      \code
+      te::gm::ScopedGEOSCache cache(*polygon);
+
+      for(std::size_t i = 0; i < candidates.size(); ++i)
+      {
+        if(polygon->intersects(candidates[i]))  // polygon is converted to GEOS just once
+          ...
+      }
+      \endcode
+
+      \sa Geometry::enableGEOSCache
+    */
+    class TEGEOMEXPORT ScopedGEOSCache : public boost::noncopyable
+    {
+      public:
+
+        /*!
+          \brief Constructor.
+
+          \param g The geometry whose GEOS representation will be cached.
+        */
+        ScopedGEOSCache(const Geometry& g);
+
+        /*! \brief Destructor. */
+        ~ScopedGEOSCache();
+
+      private:
+
+        const Geometry& m_g;    //!< The geometry with the cache enabled.
+        bool m_disable;         //!< A flag that indicates if the cache must be disabled at the end.
+    };
+
+  } // end namespace gm
+}   // end namespace te
+
+#endif  // __TERRALIB_GEOMETRY_INTERNAL_SCOPEDGEOSCACHE_H
@@ -24,7 +24,10 @@
 */
 
 // TerraLib
+#include "../BuildConfig.h"
 #include "../core/translator/Translator.h"
+#include "CompoundCurve.h"
+#include "CurvePolygon.h"
 #include "Envelope.h"
 #include "Exception.h"
 #include "Geometry.h"
@@ -38,9 +41,16 @@
 #include "MultiPolygon.h"
 #include "Point.h"
 #include "Polygon.h"
+#include "PolyhedralSurface.h"
 #include "Utils.h"
 
+#ifdef TERRALIB_MOD_SRS_ENABLED
+#include "../srs/Converter.h"
+#endif
+
 // STL
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 
 #ifdef TERRALIB_GEOS_ENABLED
@@ -187,6 +197,184 @@ template<> bool te::gm::Intersects(const te::gm::Point& point, const te::gm::Env
   return true;
 }
 
+namespace
+{
+  /*! \brief The z-component of the cross product (b - a) x (c - a): positive if c is to the left of the a-b direction. */
+  inline long double Orientation(const te::gm::Coord2D& a, const te::gm::Coord2D& b, const te::gm::Coord2D& c)
+  {
+    return (static_cast<long double>(b.x) - a.x) * (static_cast<long double>(c.y) - a.y) -
+           (static_cast<long double>(b.y) - a.y) * (static_cast<long double>(c.x) - a.x);
+  }
+
+  /*! \brief It checks if a point that is collinear to a segment is inside the segment bounds. */
+  inline bool IsInSegmentBounds(const te::gm::Coord2D& p, const te::gm::Coord2D& a, const te::gm::Coord2D& b)
+  {
+    return (p.x >= std::min(a.x, b.x)) && (p.x <= std::max(a.x, b.x)) &&
+           (p.y >= std::min(a.y, b.y)) && (p.y <= std::max(a.y, b.y));
+  }
+
+  inline bool IsOnSegment(const te::gm::Coord2D& p, const te::gm::Coord2D& a, const te::gm::Coord2D& b)
+  {
+    return IsInSegmentBounds(p, a, b) && (Orientation(a, b, p) == 0);
+  }
+
+  /*! \brief It returns 1 if the point is inside the closed ring, 0 if it is on the ring and -1 if it is outside. */
+  int LocatePointInRing(const te::gm::Coord2D& pt, const te::gm::LineString& ring)
+  {
+    const te::gm::Coord2D* coords = ring.getCoordinates();
+
+    const std::size_t nPts = ring.getNPoints();
+
+    bool inside = false;
+
+    for(std::size_t i = 1; i < nPts; ++i)
+    {
+      const te::gm::Coord2D& a = coords[i - 1];
+      const te::gm::Coord2D& b = coords[i];
+
+      if(IsOnSegment(pt, a, b))
+        return 0;
+
+      // the edge crosses the horizontal line of the point: check if the crossing is on the point right side
+      if((a.y > pt.y) != (b.y > pt.y))
+      {
+        long double o = Orientation(a, b, pt);
+
+        if((b.y > a.y) ? (o > 0) : (o < 0))
+          inside = !inside;
+      }
+    }
+
+    return inside ? 1 : -1;
+  }
+}
+
+int te::gm::LocatePoint(const Coord2D& pt, const Polygon& poly)
+{
+  const std::size_t nRings = poly.getNumRings();
+
+  for(std::size_t i = 0; i < nRings; ++i)
+  {
+    const LineString* ring = dynamic_cast<const LineString*>(poly.getRingN(i));
+
+    if(ring == 0)
+      throw Exception(TE_TR("LocatePoint only supports polygons with linear rings!"));
+
+    int location = LocatePointInRing(pt, *ring);
+
+    if(location == 0)
+      return 0;
+
+    if(i == 0)
+    {
+      if(location < 0)
+        return -1;
+    }
+    else if(location > 0)
+    {
+      return -1;  // inside a hole
+    }
+  }
+
+  return (nRings == 0) ? -1 : 1;
+}
+
+int te::gm::LocatePoint(const Coord2D& pt, const LineString& line)
+{
+  const Coord2D* coords = line.getCoordinates();
+
+  const std::size_t nPts = line.getNPoints();
+
+  if(nPts == 0)
+    return -1;
+
+  if(!line.isClosed() && ((pt == coords[0]) || (pt == coords[nPts - 1])))
+    return 0;
+
+  if(nPts == 1)
+    return (pt == coords[0]) ? 1 : -1;
+
+  for(std::size_t i = 1; i < nPts; ++i)
+  {
+    if(IsOnSegment(pt, coords[i - 1], coords[i]))
+      return 1;
+  }
+
+  return -1;
+}
+
+bool te::gm::SegmentsIntersect(const Coord2D& p1, const Coord2D& p2, const Coord2D& q1, const Coord2D& q2)
+{
+  long double o1 = Orientation(p1, p2, q1);
+  long double o2 = Orientation(p1, p2, q2);
+  long double o3 = Orientation(q1, q2, p1);
+  long double o4 = Orientation(q1, q2, p2);
+
+  if((((o1 > 0) && (o2 < 0)) || ((o1 < 0) && (o2 > 0))) &&
+     (((o3 > 0) && (o4 < 0)) || ((o3 < 0) && (o4 > 0))))
+    return true;
+
+  if((o1 == 0) && IsInSegmentBounds(q1, p1, p2))
+    return true;
+
+  if((o2 == 0) && IsInSegmentBounds(q2, p1, p2))
+    return true;
+
+  if((o3 == 0) && IsInSegmentBounds(p1, q1, q2))
+    return true;
+
+  if((o4 == 0) && IsInSegmentBounds(p2, q1, q2))
+    return true;
+
+  return false;
+}
+
+bool te::gm::LineStringsIntersect(const LineString& l1, const LineString& l2)
+{
+  const Coord2D* c1 = l1.getCoordinates();
+  const Coord2D* c2 = l2.getCoordinates();
+
+  const std::size_t n1 = l1.getNPoints();
+  const std::size_t n2 = l2.getNPoints();
+
+  if((n1 == 0) || (n2 == 0))
+    return false;
+
+  if(n1 == 1)
+    return LocatePoint(c1[0], l2) >= 0;
+
+  if(n2 == 1)
+    return LocatePoint(c2[0], l1) >= 0;
+
+  const Envelope* e2 = l2.getMBR();
+
+  for(std::size_t i = 1; i < n1; ++i)
+  {
+    const Coord2D& p1 = c1[i - 1];
+    const Coord2D& p2 = c1[i];
+
+    Envelope s1(std::min(p1.x, p2.x), std::min(p1.y, p2.y), std::max(p1.x, p2.x), std::max(p1.y, p2.y));
+
+    if(!s1.intersects(*e2))
+      continue;
+
+    for(std::size_t j = 1; j < n2; ++j)
+    {
+      const Coord2D& q1 = c2[j - 1];
+      const Coord2D& q2 = c2[j];
+
+      if((std::max(q1.x, q2.x) < s1.m_llx) || (std::min(q1.x, q2.x) > s1.m_urx) ||
+         (std::max(q1.y, q2.y) < s1.m_lly) || (std::min(q1.y, q2.y) > s1.m_ury))
+        continue;
+
+      if(SegmentsIntersect(p1, p2, q1, q2))
+        return true;
+    }
+  }
+
+  return false;
+}
+
 te::gm::Coord2D* te::gm::locateAlong(const LineString* line, double initial, double final, double target)
 {
   double tTof; // Distance of target to fist point
@@ -707,3 +895,68 @@ te::gm::Geometry* te::gm::SnapToSelf( const te::gm::Geometry* g,
   throw Exception(TE_TR("SnapToSelf routine is supported by GEOS! Please, enable the GEOS support."));
 #endif
 }
+
+#ifdef TERRALIB_MOD_SRS_ENABLED
+namespace
+{
+  void TransformCoordinates(te::gm::Geometry* g, const te::srs::Converter& converter)
+  {
+    if(te::gm::AbstractPoint* pt = dynamic_cast<te::gm::AbstractPoint*>(g))
+    {
+      double x = pt->getX();
+      double y = pt->getY();
+
+      converter.convert(x, y);
+
+      pt->setX(x);
+      pt->setY(y);
+    }
+    else if(te::gm::LineString* line = dynamic_cast<te::gm::LineString*>(g))
+    {
+      double* pt = (double*)(line->getCoordinates());
+
+      converter.convert(pt, &(pt[1]), static_cast<long>(line->size()), 2);
+    }
+    else if(te::gm::CompoundCurve* cc = dynamic_cast<te::gm::CompoundCurve*>(g))
+    {
+      for(std::size_t i = 0; i < cc->size(); ++i)
+        TransformCoordinates(cc->getCurve(i), converter);
+    }
+    else if(te::gm::CurvePolygon* poly = dynamic_cast<te::gm::CurvePolygon*>(g))
+    {
+      for(std::size_t i = 0; i < poly->getNumRings(); ++i)
+        TransformCoordinates(poly->getRingN(i), converter);
+    }
+    else if(te::gm::GeometryCollection* gc = dynamic_cast<te::gm::GeometryCollection*>(g))
+    {
+      for(std::size_t i = 0; i < gc->getNumGeometries(); ++i)
+        TransformCoordinates(gc->getGeometryN(i), converter);
+    }
+    else if(te::gm::PolyhedralSurface* ps = dynamic_cast<te::gm::PolyhedralSurface*>(g))
+    {
+      for(std::size_t i = 0; i < ps->getNumPatches(); ++i)
+        TransformCoordinates(ps->getPatchN(i), converter);
+    }
+    else
+    {
+      // other types (like circular strings) keep their own transformation
+      g->transform(converter.getTargetSRID());
+    }
+  }
+}
+#endif
+
+void te::gm::Transform(te::gm::Geometry* g, const te::srs::Converter& converter)
+{
+#ifdef TERRALIB_MOD_SRS_ENABLED
+  assert(g);
+
+  TransformCoordinates(g, converter);
+
+  g->setSRID(converter.getTargetSRID());
+
+  g->computeMBR(true);
+#else
+  throw Exception(TE_TR("Transform routine is supported by SRS module! Please, enable the SRS support."));
+#endif
+}
@@ -36,6 +36,12 @@
 
 namespace te
 {
+// Forward declarations
+  namespace srs
+  {
+    class Converter;
+  }
+
   namespace gm
   {
 // Forward declarations
@@ -128,6 +134,46 @@ namespace te
     /* \brief Specialized function that checks if point intersects envelope. */
     template<> TEGEOMEXPORT bool Intersects(const te::gm::Point& point, const te::gm::Envelope& e);
 
+    /*!
+      \brief It returns the location of a point relative to a polygon, using a crossing number test.
+
+      \param pt   The point coordinate.
+      \param poly A polygon whose rings are line strings.
+
+      \return 1 if the point is in the polygon interior, 0 if it is on the polygon boundary and -1 if it is in the polygon exterior.
+
+      \exception Exception It throws an exception if a polygon ring is not a line string.
+
+      \note The test is performed in 2D and does not convert the geometries to GEOS.
+    */
+    TEGEOMEXPORT int LocatePoint(const Coord2D& pt, const Polygon& poly);
+
+    /*!
+      \brief It returns the location of a point relative to a line string.
+
+      \param pt   The point coordinate.
+      \param line The line string.
+
+      \return 1 if the point is in the line interior, 0 if it is one of the end points of a not closed line and -1 otherwise.
+
+      \note The test is performed in 2D and does not convert the geometries to GEOS.
+    */
+    TEGEOMEXPORT int LocatePoint(const Coord2D& pt, const LineString& line);
+
+    /*!
+      \brief It checks if two closed segments intersect (including touching end points and collinear overlaps).
+
+      \note The orientation tests are evaluated in long double precision.
+    */
+    TEGEOMEXPORT bool SegmentsIntersect(const Coord2D& p1, const Coord2D& p2, const Coord2D& q1, const Coord2D& q2);
+
+    /*!
+      \brief It checks if two line strings intersect, testing the pairs of segments whose envelopes intersect.
+
+      \note The test is performed in 2D and does not convert the geometries to GEOS.
+    */
+    TEGEOMEXPORT bool LineStringsIntersect(const LineString& l1, const LineString& l2);
+
     /*!
       \brief Make the line interpolation to find a target
      
@@ -252,6 +298,20 @@ namespace te
      */
     TEGEOMEXPORT te::gm::Geometry* SnapToSelf(const te::gm::Geometry* g, const double& snapTolerance, const bool& cleanResult);
 
+    /*!
+      \brief It converts the coordinates of the geometry (and its parts) using an already configured SRS converter.
+
+      Unlike Geometry::transform, which sets up a new converter in each call, this function
+      reuses the given one, so it is suited to transform many geometries between the same SRSs.
+      After the conversion the geometry is associated to the converter target SRID and its MBR is recomputed.
+
+      \param g         The geometry to be transformed (it must be associated to the converter source SRID).
+      \param converter The SRS converter.
+
+      \exception Exception It throws an exception if the SRS support is not enabled.
+    */
+    TEGEOMEXPORT void Transform(te::gm::Geometry* g, const te::srs::Converter& converter);
+
   } // end namespace gm
 }   // end namespace te
 
@@ -42,7 +42,8 @@ te::map::AbstractLayer::AbstractLayer(AbstractLayer* parent)
     m_grouping(0),
     m_chart(0),
     m_compositionMode(te::map::SourceOver),
-    m_encoding(te::core::EncodingType::UTF8)
+    m_encoding(te::core::EncodingType::UTF8),
+    m_version(0)
 {
 }
 
@@ -58,7 +59,8 @@ te::map::AbstractLayer::AbstractLayer(const std::string& id, AbstractLayer* pare
     m_grouping(0),
     m_chart(0),
     m_compositionMode(te::map::SourceOver),
-    m_encoding(te::core::EncodingType::UTF8)
+    m_encoding(te::core::EncodingType::UTF8),
+    m_version(0)
 {
 }
 
@@ -77,7 +79,8 @@ te::map::AbstractLayer::AbstractLayer(const std::string& id,
     m_grouping(0),
     m_chart(0),
     m_compositionMode(te::map::SourceOver),
-    m_encoding(te::core::EncodingType::UTF8)
+    m_encoding(te::core::EncodingType::UTF8),
+    m_version(0)
 {
 }
 
@@ -294,6 +297,7 @@ void te::map::AbstractLayer::setStyle(te::se::Style* style)
 {
   delete m_style;
   m_style = style;
+  ++m_version;
 }
 
 te::se::Style* te::map::AbstractLayer::getSelectionStyle() const
@@ -316,6 +320,7 @@ void te::map::AbstractLayer::setGrouping(te::map::Grouping* grouping)
 {
   delete m_grouping;
   m_grouping = grouping;
+  ++m_version;
 }
 
 te::map::Chart* te::map::AbstractLayer::getChart() const
@@ -327,6 +332,7 @@ void te::map::AbstractLayer::setChart(te::map::Chart* chart)
 {
   delete m_chart;
   m_chart = chart;
+  ++m_version;
 }
 
 const std::string& te::map::AbstractLayer::getGeomPropertyName() const
@@ -337,6 +343,7 @@ const std::string& te::map::AbstractLayer::getGeomPropertyName() const
 void te::map::AbstractLayer::setGeomPropertytName(const std::string& name)
 {
   m_geomPropertyName = name;
+  ++m_version;
 }
 
 te::map::CompositionMode te::map::AbstractLayer::getCompositionMode() const
@@ -361,6 +368,17 @@ void te::map::AbstractLayer::setEncoding(te::core::EncodingType et)
 
 void te::map::AbstractLayer::setOutOfDate()
 {
+  ++m_version;
+}
+
+std::size_t te::map::AbstractLayer::getVersion() const
+{
+  return m_version;
+}
+
+void te::map::AbstractLayer::incrementVersion()
+{
+  ++m_version;
 }
 
 const std::string& te::map::AbstractLayer::getDataSourceId() const
@@ -540,6 +540,24 @@ namespace te
         */
         virtual void setOutOfDate();
 
+        /*!
+          \brief It returns the layer version.
+
+          \return The layer version.
+
+          \note The version changes each time the style, grouping, chart or geometry property
+                of the layer is replaced or the layer is marked out of date, so the images
+                rendered from the layer can be discarded when they are out of date.
+        */
+        std::size_t getVersion() const;
+
+        /*!
+          \brief It increments the layer version.
+
+          \note It must be called after changing the layer style, grouping or chart in place.
+        */
+        void incrementVersion();
+
         /*!
         \brief
 
@@ -586,6 +604,7 @@ namespace te
         std::string m_datasetName;                   //!< The dataset name where we will retrieve the layer objects.
         std::string m_datasourceId;                  //!< DataSource id.
         te::core::EncodingType m_encoding;           //!< The char encoding of the layer;
+        std::size_t m_version;                       //!< The layer version, incremented each time the layer changes the way it is drawn.
     };
 
     typedef boost::intrusive_ptr<AbstractLayer> AbstractLayerPtr;
@@ -25,7 +25,9 @@
 
 // TerraLib
 #include "../color/RGBAColor.h"
+#include "../common/progress/ProgressCounter.h"
 #include "../common/progress/TaskProgress.h"
+#include "../common/CounterRegistry.h"
 #include "../common/Globals.h"
 #include "../common/STLUtils.h"
 #include "../core/translator/Translator.h"
@@ -46,6 +48,7 @@
 #include "../geometry/Envelope.h"
 #include "../geometry/GeometryProperty.h"
 #include "../geometry/Line.h"
+#include "../geometry/Point.h"
 #include "../geometry/MultiPolygon.h"
 #include "../geometry/Polygon.h"
 #include "../geometry/Utils.h"
@@ -90,7 +93,9 @@
 
 
 te::map::AbstractLayerRenderer::AbstractLayerRenderer()
-  : m_index(0)
+  : m_index(0),
+    m_levelOfDetail(true),
+    m_subPixelProxy(true)
 {
 }
 
@@ -301,11 +306,30 @@ void te::map::AbstractLayerRenderer::drawLayerGeometries(AbstractLayer* layer,
         te::da::PropertyName* geometryPropertyName = new te::da::PropertyName(geomPropertyName);
         te::da::ST_Intersects* intersects = new te::da::ST_Intersects(geometryPropertyName, lenv);
 
+        // Keeps the Filter expression to evaluate it here if the data source can not do it
+        std::auto_ptr<te::da::Expression> clientFilter(exp->clone());
+
         // Combining the expressions (Filter expression + extent spatial restriction)
         te::da::And* restriction = new te::da::And(exp, intersects);
 
         /* 2) Calling the layer query method to get the correct restricted data. */
-        dataset = layer->getData(restriction);
+        try
+        {
+          dataset = layer->getData(restriction);
+        }
+        catch(std::exception& /*e*/)
+        {
+          dataset.reset(0);
+        }
+
+        /* 3) Otherwise, the Filter expression is compiled and evaluated over the data inside the extent. */
+        if(dataset.get() == 0)
+        {
+          dataset = layer->getData(geomPropertyName, &bbox, te::gm::INTERSECTS, te::common::RANDOM);
+
+          if(dataset.get())
+            dataset = FilterData(dataset, *clientFilter);
+        }
       }
       catch(std::exception& /*e*/)
       {
@@ -691,6 +715,15 @@ void te::map::AbstractLayerRenderer::drawLayerGroupingMem(AbstractLayer* layer,
       continue;
     }
 
+    // If necessary, geometry remap
+    if(needRemap)
+    {
+      geom->setSRID(layer->getSRID());
+      geom->transform(srid);
+    }
+
+    bool visible = applyLevelOfDetail(geom);
+
     // Gets the set of symbolizers defined on group item
     std::size_t nSymbolizers = symbolizers.size();
 
@@ -699,17 +732,13 @@ void te::map::AbstractLayerRenderer::drawLayerGroupingMem(AbstractLayer* layer,
       // The current symbolizer
       te::se::Symbolizer* symb = symbolizers[j];
 
-      // Let's config the canvas based on the current symbolizer
-      cc.config(symb);
-
-      // If necessary, geometry remap
-      if(needRemap)
+      if(visible)
       {
-        geom->setSRID(layer->getSRID());
-        geom->transform(srid);
-      }
+        // Let's config the canvas based on the current symbolizer
+        cc.config(symb);
 
-      canvas->draw(geom.get());
+        canvas->draw(geom.get());
+      }
 
       if(chart && j == nSymbolizers - 1)
         buildChart(chart, dataset.get(), geom.get());
@@ -745,18 +774,24 @@ void te::map::AbstractLayerRenderer::drawDatSetGeometries(te::da::DataSet* datas
   if((fromSRID != TE_UNKNOWN_SRS) && (toSRID != TE_UNKNOWN_SRS) && (fromSRID != toSRID))
     needRemap = true;
 
+  te::common::ScopedTimer timer(te::common::CounterRegistry::getInstance().getTimer("map.draw.geometries"));
+
+  std::auto_ptr<te::common::ProgressCounter> counter(task ? new te::common::ProgressCounter(*task) : 0);
+
+  long long nGeoms = 0;
+
   do
   {
-    if(task)
+    if(counter.get())
     {
-      if(!task->isActive())
+      if(!counter->isActive())
       {
         *cancel = true;
-        return;
+        break;
       }
 
       // update the draw task
-      task->pulse();
+      counter->pulse();
     }
 
     std::auto_ptr<te::gm::Geometry> geom(0);
@@ -778,16 +813,25 @@ void te::map::AbstractLayerRenderer::drawDatSetGeometries(te::da::DataSet* datas
       geom->transform(toSRID);
     }
 
-    canvas->draw(geom.get());
+    if(applyLevelOfDetail(geom))
+    {
+      canvas->draw(geom.get());
+      ++nGeoms;
+    }
 
     if(chart)
       buildChart(chart, dataset, geom.get());
 
     if(cancel != 0 && (*cancel))
-      return;
+      break;
 
   } while(dataset->moveNext()); // next geometry!
 
+  te::common::CounterRegistry::getInstance().add("map.draw.geometries", nGeoms);
+
+  if(cancel != 0 && (*cancel))
+    return;
+
   // Let's draw the generated charts
   for(std::size_t i = 0; i < m_chartCoordinates.size(); ++i)
   {
@@ -822,18 +866,20 @@ void te::map::AbstractLayerRenderer::drawDatSetTexts(te::da::DataSet* dataset, c
   //rtree for text boxes
   te::sam::rtree::Index<std::size_t, 4> rtree;
 
+  std::auto_ptr<te::common::ProgressCounter> counter(task ? new te::common::ProgressCounter(*task) : 0);
+
   do
   {
-    if (task)
+    if (counter.get())
     {
-      if (!task->isActive())
+      if (!counter->isActive())
       {
         *cancel = true;
         return;
       }
 
       // update the draw task
-      task->pulse();
+      counter->pulse();
     }
 
     std::auto_ptr<te::gm::Geometry> geom(0);
@@ -1037,6 +1083,57 @@ void te::map::AbstractLayerRenderer::buildChart(Chart* chart, te::da::DataSet* d
   m_chartImages.push_back(rgba);
 }
 
+void te::map::AbstractLayerRenderer::setLevelOfDetailEnabled(bool on)
+{
+  m_levelOfDetail = on;
+}
+
+void te::map::AbstractLayerRenderer::setSubPixelProxyEnabled(bool on)
+{
+  m_subPixelProxy = on;
+}
+
+bool te::map::AbstractLayerRenderer::applyLevelOfDetail(std::auto_ptr<te::gm::Geometry>& geom)
+{
+  const double pixelSize = m_transformer.m_mapUnitsPP;
+
+  if(!m_levelOfDetail || !(pixelSize > 0.0))
+    return true;
+
+  te::gm::Dimensionality dimension = geom->getDimension();
+
+  if(dimension == te::gm::P)
+    return true;
+
+  const te::gm::Envelope* mbr = geom->getMBR();
+
+  // culls the sub-pixel geometries
+  if(mbr->getWidth() < pixelSize && mbr->getHeight() < pixelSize)
+  {
+    if(!m_subPixelProxy)
+      return false;
+
+    int srid = geom->getSRID();
+
+    if(dimension == te::gm::A)
+    {
+      geom.reset(te::gm::GetGeomFromEnvelope(mbr, srid));
+    }
+    else
+    {
+      geom.reset(new te::gm::Line(te::gm::Point(mbr->m_llx, mbr->m_lly, srid),
+                                  te::gm::Point(mbr->m_urx, mbr->m_ury, srid),
+                                  te::gm::LineStringType, srid));
+    }
+
+    return true;
+  }
+
+  GeneralizeGeometry(geom.get(), m_transformer.m_wllx, m_transformer.m_wlly, pixelSize * TE_MAP_GENERALIZATION_TOLERANCE);
+
+  return true;
+}
+
 void te::map::AbstractLayerRenderer::reset()
 {
   m_index = 0;
@@ -34,6 +34,7 @@
 #include "WorldDeviceTransformer.h"
 
 // STL
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -87,6 +88,20 @@ namespace te
 
         virtual void draw(AbstractLayer* layer, Canvas* canvas, const te::gm::Envelope& bbox, int srid, const double& scale, bool* cancel);
 
+        /*!
+          \brief It enables or disables the level of detail stage applied to the geometries before drawing them.
+
+          \param on If true, the geometries are generalized to the canvas resolution and the ones smaller than a pixel are culled.
+        */
+        void setLevelOfDetailEnabled(bool on);
+
+        /*!
+          \brief It sets what is drawn for a line or polygon smaller than a pixel.
+
+          \param on If true, a proxy (the diagonal or the envelope of the geometry) is drawn, otherwise the geometry is skipped.
+        */
+        void setSubPixelProxyEnabled(bool on);
+
       protected:
 
         /*!
@@ -177,6 +192,18 @@ namespace te
 
         virtual void buildChart(Chart* chart, te::da::DataSet* dataset, te::gm::Geometry* geom);
 
+        /*!
+          \brief It applies the level of detail of the current canvas resolution to a geometry.
+
+          The lines and polygons smaller than a pixel are replaced by a proxy or culled, and the vertices
+          of the others are generalized using a grid of TE_MAP_GENERALIZATION_TOLERANCE pixels.
+
+          \param geom The geometry, in the canvas SRS. It may be changed or replaced.
+
+          \return False if the geometry must not be drawn.
+        */
+        virtual bool applyLevelOfDetail(std::auto_ptr<te::gm::Geometry>& geom);
+
         virtual void reset();
 
       protected:
@@ -186,6 +213,8 @@ namespace te
         std::size_t m_index;                               // Unsigned int used as r-Tree index.
         std::vector<te::color::RGBAColor**> m_chartImages; // The generated chart images.
         std::vector<te::gm::Coord2D> m_chartCoordinates;   // The generated chart coordinates.
+        bool m_levelOfDetail;                              // If true, the geometries are generalized to the canvas resolution.
+        bool m_subPixelProxy;                              // If true, a proxy is drawn for the geometries smaller than a pixel.
     };
 
   } // end namespace map
@@ -28,6 +28,42 @@
 
 #define TE_MAPTOOLS_MODULE_NAME "te.maptools"
 
+/*!
+  \def TE_MAP_RASTER_GRID_STEP
+
+  \brief The distance, in canvas pixels, between the points where the raster coordinates are exactly computed when a raster is drawn.
+         The coordinates of the other pixels are interpolated.
+*/
+#define TE_MAP_RASTER_GRID_STEP 16
+
+/*!
+  \def TE_MAP_RASTER_BAND_ROWS
+
+  \brief The number of canvas rows of each band filled by the raster drawing threads.
+*/
+#define TE_MAP_RASTER_BAND_ROWS 32
+
+/*!
+  \def TE_MAP_GENERALIZATION_TOLERANCE
+
+  \brief The size, in pixels, of the grid cells used to generalize the geometries before drawing them.
+*/
+#define TE_MAP_GENERALIZATION_TOLERANCE 1.0
+
+/*!
+  \def TE_MAP_TILE_SIZE
+
+  \brief The width and height, in pixels, of the tiles kept by the tile render cache.
+*/
+#define TE_MAP_TILE_SIZE 256
+
+/*!
+  \def TE_MAP_TILE_CACHE_SIZE
+
+  \brief The default maximum number of tiles kept by the tile render cache.
+*/
+#define TE_MAP_TILE_CACHE_SIZE 256
+
 /** @name DLL/LIB Module
  *  Flags for building TerraLib as a DLL or as a Static Library
  */
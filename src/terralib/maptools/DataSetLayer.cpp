@@ -275,4 +275,6 @@ void te::map::DataSetLayer::setOutOfDate()
 {
   delete m_schema;
   m_schema = 0;
+
+  AbstractLayer::setOutOfDate();
 }
@@ -122,3 +122,126 @@ double te::map::AdjustToPrecision(double val, int precision, bool reduce)
 
   return (val + p);
 }
+
+void te::map::GroupingByEqualSteps(double min, double max, int nSteps, std::vector<te::map::GroupingItem*>& legend,
+                                   int precision)
+{
+  if(nSteps < 1)
+    return;
+
+  double slice = (max - min)/double(nSteps);
+
+  for(int i = 0; i < nSteps; ++i)
+  {
+    te::map::GroupingItem* legendItem = new te::map::GroupingItem;
+    legendItem->setLowerLimit(te::common::Convert2String(min + double(i) * slice, precision));
+    legendItem->setUpperLimit(te::common::Convert2String(min + double(i+1) * slice, precision));
+    legend.push_back(legendItem);
+  }
+
+  min = te::map::AdjustToPrecision(min, precision, true);
+  legend[legend.size() - nSteps]->setLowerLimit(te::common::Convert2String(min, precision));
+  max = te::map::AdjustToPrecision(max, precision, false);
+  legend[legend.size() - 1]->setUpperLimit(te::common::Convert2String(max, precision));
+}
+
+void te::map::GroupingByQuantil(const std::vector<double>& breaks, std::vector<te::map::GroupingItem*>& legend,
+                                int precision)
+{
+  if(breaks.empty())
+    return;
+
+  const std::size_t first = legend.size();
+
+  std::size_t i = 0;
+
+  while(i < breaks.size() - 1)
+  {
+    // repeated breaks would give empty groups
+    std::size_t j = i + 1;
+
+    while(j < breaks.size() - 1 && breaks[j] <= breaks[i])
+      ++j;
+
+    te::map::GroupingItem* legendItem = new te::map::GroupingItem;
+    legendItem->setLowerLimit(te::common::Convert2String(breaks[i], precision));
+    legendItem->setUpperLimit(te::common::Convert2String(breaks[j], precision));
+    legend.push_back(legendItem);
+
+    i = j;
+  }
+
+  if(legend.size() == first)
+  {
+    te::map::GroupingItem* legendItem = new te::map::GroupingItem;
+    legendItem->setLowerLimit(te::common::Convert2String(breaks[0], precision));
+    legendItem->setUpperLimit(te::common::Convert2String(breaks[0], precision));
+    legend.push_back(legendItem);
+  }
+
+  double min = te::map::AdjustToPrecision(breaks[0], precision, true);
+  legend[first]->setLowerLimit(te::common::Convert2String(min, precision));
+
+  double max = te::map::AdjustToPrecision(breaks[breaks.size() - 1], precision, false);
+  legend[legend.size() - 1]->setUpperLimit(te::common::Convert2String(max, precision));
+}
+
+void te::map::GroupingByStdDeviation(double min, double max, double mean, double stdDev, double nDevs,
+                                     std::vector<te::map::GroupingItem*>& legend, std::string& meanTitle,
+                                     int precision)
+{
+  double slice = stdDev * nDevs;
+
+  std::vector<te::map::GroupingItem*> aux;
+
+  std::string strMean = te::common::Convert2String(mean, precision);
+
+  double val = mean;
+  while(val - slice > min - slice)
+  {
+    te::map::GroupingItem* legendItem = new te::map::GroupingItem;
+
+    double v = val - slice;
+
+    legendItem->setLowerLimit(te::common::Convert2String(v, precision));
+    legendItem->setUpperLimit(te::common::Convert2String(val, precision));
+    aux.push_back(legendItem);
+    val = v;
+  }
+
+  std::vector<te::map::GroupingItem*>::reverse_iterator sit;
+  for(sit = aux.rbegin(); sit != aux.rend(); ++sit)
+    legend.push_back(*sit);
+
+  meanTitle = "Mean - " + strMean;
+
+  te::map::GroupingItem* legendItemMean = new te::map::GroupingItem;
+  legendItemMean->setLowerLimit(te::common::Convert2String(mean, precision));
+  legendItemMean->setUpperLimit(te::common::Convert2String(mean, precision));
+  legendItemMean->setTitle(meanTitle);
+  legend.push_back(legendItemMean);
+
+  val = mean;
+  while(val + slice < max + slice)
+  {
+    te::map::GroupingItem* legendItem = new te::map::GroupingItem;
+
+    double v = val + slice;
+
+    legendItem->setLowerLimit(te::common::Convert2String(val, precision));
+    legendItem->setUpperLimit(te::common::Convert2String(v, precision));
+    legend.push_back(legendItem);
+
+    val = v;
+  }
+
+  //adjust first and last values
+  //if(legend.size() >= 3)
+  //{
+  //  if(legend[0]->getTitle() != meanTitle)
+  //    legend[0]->setLowerLimit(te::common::Convert2String(min, precision));
+  //  
+  //  if(legend[legend.size()-1]->getTitle() != meanTitle)
+  //    legend[legend.size()-1]->setUpperLimit(te::common::Convert2String(max, precision));
+  //}
+}
@@ -76,6 +76,53 @@ namespace te
     */
     TEMAPEXPORT double AdjustToPrecision(double val, int precision, bool reduce = false);
 
+    /*!
+      \brief It groups the values of a known range using the equal steps algorithm.
+
+      \param min           The minimum value.
+      \param max           The maximum value.
+      \param nSteps        The number of steps.
+      \param legend        The container of legend items.
+      \param precision     The precision to be used in the conversion of the values.
+
+      \output              The groups will be stored in the container of legend items, with no counting of elements.
+    */
+    TEMAPEXPORT void GroupingByEqualSteps(double min, double max, int nSteps, std::vector<te::map::GroupingItem*>& legend,
+                                          int precision = 0);
+
+    /*!
+      \brief It groups the values using precomputed quantile breaks.
+
+      \param breaks        The breaks from the minimum to the maximum value: the nSteps + 1 limits of the slices
+                           (e.g. estimated by a streaming summary of the values).
+      \param legend        The container of legend items.
+      \param precision     The precision to be used in the conversion of the values.
+
+      \output              The groups will be stored in the container of legend items, with no counting of elements.
+
+      \note Repeated breaks are merged, so the number of groups may be lower than the number of slices.
+    */
+    TEMAPEXPORT void GroupingByQuantil(const std::vector<double>& breaks, std::vector<te::map::GroupingItem*>& legend,
+                                       int precision = 0);
+
+    /*!
+      \brief It groups the values of a known distribution using the standard deviation algorithm.
+
+      \param min           The minimum value.
+      \param max           The maximum value.
+      \param mean          The mean value.
+      \param stdDev        The standard deviation.
+      \param nDevs         The number of deviations.
+      \param legend        The container of legend items.
+      \param meanTitle     The title of the mean item.
+      \param precision     The precision to be used in the conversion of the values.
+
+      \output              The groups will be stored in the container of legend items, with no counting of elements.
+    */
+    TEMAPEXPORT void GroupingByStdDeviation(double min, double max, double mean, double stdDev, double nDevs,
+                                            std::vector<te::map::GroupingItem*>& legend, std::string& meanTitle,
+                                            int precision = 0);
+
     /*!
       \brief It groups the values defined by a range of iterators using the equal steps algorithm.
 
@@ -104,20 +151,7 @@ namespace te
         ++it;
       }
 
-      double slice = (max - min)/double(nSteps);
-    
-      for(int i = 0; i < nSteps; ++i)
-      {
-        te::map::GroupingItem* legendItem = new te::map::GroupingItem;
-        legendItem->setLowerLimit(te::common::Convert2String(min + double(i) * slice, precision));
-        legendItem->setUpperLimit(te::common::Convert2String(min + double(i+1) * slice, precision));
-        legend.push_back(legendItem);
-      }
-
-      min = te::map::AdjustToPrecision(min, precision, true);
-      legend[0]->setLowerLimit(te::common::Convert2String(min, precision));
-      max = te::map::AdjustToPrecision(max, precision, false);
-      legend[nSteps-1]->setUpperLimit(te::common::Convert2String(max, precision));
+      GroupingByEqualSteps(min, max, nSteps, legend, precision);
 
       // Set the number of elements for each slice
       if (countElements == true)
@@ -218,61 +252,7 @@ namespace te
       long double var = (sm2 / count) - (mean * mean);
       double stdDev = sqrt(var);
 
-      double slice = stdDev * nDevs;
-
-      std::vector<te::map::GroupingItem*> aux;
-
-      std::string strMean = te::common::Convert2String(mean, precision);
-
-      double val = mean;
-      while(val - slice > min - slice)
-      {
-        te::map::GroupingItem* legendItem = new te::map::GroupingItem;
-
-        double v = val - slice;
-
-        legendItem->setLowerLimit(te::common::Convert2String(v, precision));
-        legendItem->setUpperLimit(te::common::Convert2String(val, precision));
-        aux.push_back(legendItem);
-        val = v;
-      }
-
-      std::vector<te::map::GroupingItem*>::reverse_iterator sit;
-      for(sit = aux.rbegin(); sit != aux.rend(); ++sit)
-        legend.push_back(*sit);
-
-      meanTitle = "Mean - " + strMean;
-
-      te::map::GroupingItem* legendItemMean = new te::map::GroupingItem;
-      legendItemMean->setLowerLimit(te::common::Convert2String(mean, precision));
-      legendItemMean->setUpperLimit(te::common::Convert2String(mean, precision));
-      legendItemMean->setTitle(meanTitle);
-      legend.push_back(legendItemMean);
-
-      val = mean;
-      while(val + slice < max + slice)
-      {
-        te::map::GroupingItem* legendItem = new te::map::GroupingItem;
-
-        double v = val + slice;
-
-        legendItem->setLowerLimit(te::common::Convert2String(val, precision));
-        legendItem->setUpperLimit(te::common::Convert2String(v, precision));
-        legend.push_back(legendItem);
-
-        val = v;
-      }
-
-      //adjust first and last values
-      //if(legend.size() >= 3)
-      //{
-      //  if(legend[0]->getTitle() != meanTitle)
-      //    legend[0]->setLowerLimit(te::common::Convert2String(min, precision));
-      //  
-      //  if(legend[legend.size()-1]->getTitle() != meanTitle)
-      //    legend[legend.size()-1]->setUpperLimit(te::common::Convert2String(max, precision));
-      //}
-
+      GroupingByStdDeviation(min, max, mean, stdDev, nDevs, legend, meanTitle, precision);
 
       // Set the number of elements for each slice
       if (countElements == true)
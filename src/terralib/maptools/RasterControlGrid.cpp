@@ -0,0 +1,63 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/maptools/RasterControlGrid.cpp
+
+  \brief The raster grid coordinates of the canvas pixels, interpolated from a coarse control grid.
+*/
+
+// TerraLib
+#include "../geometry/Coord2D.h"
+#include "../raster/Grid.h"
+#include "../srs/Converter.h"
+#include "RasterControlGrid.h"
+
+// STL
+#include <algorithm>
+#include <limits>
+
+te::map::RasterControlGrid::RasterControlGrid(const te::rst::Grid& canvasGrid, const te::rst::Grid& rasterGrid,
+                                              const te::srs::Converter* converter, unsigned int step)
+  : m_step(std::max(step, 1u)),
+    m_nCols(canvasGrid.getNumberOfColumns() / m_step + 2),
+    m_nRows(canvasGrid.getNumberOfRows() / m_step + 2),
+    m_x(m_nCols * m_nRows),
+    m_y(m_nCols * m_nRows)
+{
+  for(unsigned int r = 0; r < m_nRows; ++r)
+  {
+    for(unsigned int c = 0; c < m_nCols; ++c)
+    {
+      te::gm::Coord2D geo = canvasGrid.gridToGeo(c * m_step, r * m_step);
+
+      std::size_t i = r * m_nCols + c;
+
+      if(converter && !converter->convert(geo.x, geo.y, geo.x, geo.y))
+      {
+        m_x[i] = std::numeric_limits<double>::quiet_NaN();
+        m_y[i] = m_x[i];
+
+        continue;
+      }
+
+      rasterGrid.geoToGrid(geo.x, geo.y, m_x[i], m_y[i]);
+    }
+  }
+}
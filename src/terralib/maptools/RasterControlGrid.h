@@ -0,0 +1,113 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/maptools/RasterControlGrid.h
+
+  \brief The raster grid coordinates of the canvas pixels, interpolated from a coarse control grid.
+*/
+
+#ifndef __TERRALIB_MAPTOOLS_INTERNAL_RASTERCONTROLGRID_H
+#define __TERRALIB_MAPTOOLS_INTERNAL_RASTERCONTROLGRID_H
+
+// TerraLib
+#include "Config.h"
+
+// STL
+#include <cstddef>
+#include <vector>
+
+// Boost
+#include <boost/math/special_functions/fpclassify.hpp>
+
+namespace te
+{
+// Forward declarations
+  namespace rst { class Grid; }
+  namespace srs { class Converter; }
+
+  namespace map
+  {
+    /*!
+      \class RasterControlGrid
+
+      \brief The raster grid coordinates of the canvas pixels, computed exactly for the nodes of
+             a coarse grid over the canvas and bilinearly interpolated inside its cells.
+
+      \details When the canvas and the raster have the same SRS the raster coordinates are an
+               affine function of the canvas pixel, so the interpolated coordinates are exact.
+               With a SRS conversion the interpolation error grows with the square of the step;
+               for TE_MAP_RASTER_GRID_STEP and the usual display scales it stays far below
+               a tenth of a raster pixel.
+    */
+    class TEMAPEXPORT RasterControlGrid
+    {
+      public:
+
+        /*!
+          \brief It computes the raster coordinates of the control grid nodes.
+
+          \param canvasGrid The grid of the canvas pixels.
+          \param rasterGrid The grid of the raster.
+          \param converter  The conversion from the canvas SRS to the raster SRS, or NULL if they are the same.
+          \param step       The distance between the nodes, in canvas pixels.
+        */
+        RasterControlGrid(const te::rst::Grid& canvasGrid, const te::rst::Grid& rasterGrid,
+                          const te::srs::Converter* converter, unsigned int step);
+
+        /*!
+          \brief It returns the raster coordinates of a canvas pixel.
+
+          \param c The canvas column.
+          \param r The canvas row.
+          \param x The raster column.
+          \param y The raster row.
+
+          \return False if the coordinates could not be computed, because a node of the pixel cell could not be converted.
+        */
+        bool get(unsigned int c, unsigned int r, double& x, double& y) const
+        {
+          unsigned int gc = c / m_step;
+          unsigned int gr = r / m_step;
+
+          double fx = static_cast<double>(c - gc * m_step) / m_step;
+          double fy = static_cast<double>(r - gr * m_step) / m_step;
+
+          std::size_t i00 = gr * m_nCols + gc;
+          std::size_t i10 = i00 + m_nCols;
+
+          x = (1.0 - fy) * ((1.0 - fx) * m_x[i00] + fx * m_x[i00 + 1]) + fy * ((1.0 - fx) * m_x[i10] + fx * m_x[i10 + 1]);
+          y = (1.0 - fy) * ((1.0 - fx) * m_y[i00] + fx * m_y[i00 + 1]) + fy * ((1.0 - fx) * m_y[i10] + fx * m_y[i10 + 1]);
+
+          return boost::math::isfinite(x) && boost::math::isfinite(y);
+        }
+
+      private:
+
+        unsigned int m_step;          //!< The distance between the nodes, in canvas pixels.
+        unsigned int m_nCols;         //!< The number of node columns.
+        unsigned int m_nRows;         //!< The number of node rows.
+        std::vector<double> m_x;      //!< The raster column of each node.
+        std::vector<double> m_y;      //!< The raster row of each node.
+    };
+
+  } // end namespace map
+}   // end namespace te
+
+#endif  // __TERRALIB_MAPTOOLS_INTERNAL_RASTERCONTROLGRID_H
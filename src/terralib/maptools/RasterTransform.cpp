@@ -700,4 +700,220 @@ te::color::RGBAColor te::map::RasterTransform::getCategorizedColor(double value)
 te::color::RGBAColor te::map::RasterTransform::getRecodedColor(double value)
 {
   return m_recodeMap[(int)value];
-}
\ No newline at end of file
+}
+bool te::map::RasterTransform::buildLUT()
+{
+  m_lutBands.clear();
+  m_lutFirst.clear();
+  m_lutColors.clear();
+  m_lutChannels.clear();
+  m_lutNoData.clear();
+
+  if(m_rasterIn == 0 || m_RGBAFuncPtr == 0)
+    return false;
+
+  // the bands read by the transformation
+  bool singleBand = true;
+
+  if(m_RGBAFuncPtr == &RasterTransform::getMono2ThreeBand ||
+     m_RGBAFuncPtr == &RasterTransform::getCategorize ||
+     m_RGBAFuncPtr == &RasterTransform::getInterpolate ||
+     m_RGBAFuncPtr == &RasterTransform::getRecode)
+  {
+    m_lutBands.push_back(m_monoBand);
+  }
+  else if(m_RGBAFuncPtr == &RasterTransform::getRed2ThreeBand)
+  {
+    m_lutBands.push_back(m_rgbMap[RED_CHANNEL]);
+  }
+  else if(m_RGBAFuncPtr == &RasterTransform::getGreen2ThreeBand)
+  {
+    m_lutBands.push_back(m_rgbMap[GREEN_CHANNEL]);
+  }
+  else if(m_RGBAFuncPtr == &RasterTransform::getBlue2ThreeBand)
+  {
+    m_lutBands.push_back(m_rgbMap[BLUE_CHANNEL]);
+  }
+  else if(m_RGBAFuncPtr == &RasterTransform::getExtractRGB ||
+          m_RGBAFuncPtr == &RasterTransform::getExtractRGBA)
+  {
+    singleBand = false;
+
+    m_lutBands.push_back(m_rgbMap[RED_CHANNEL]);
+    m_lutBands.push_back(m_rgbMap[GREEN_CHANNEL]);
+    m_lutBands.push_back(m_rgbMap[BLUE_CHANNEL]);
+
+    if(m_RGBAFuncPtr == &RasterTransform::getExtractRGBA)
+      m_lutBands.push_back(m_rgbMap[ALPHA_CHANNEL]);
+  }
+
+  // the range of values of each band
+  std::vector<int> sizes;
+
+  for(std::size_t i = 0; i < m_lutBands.size(); ++i)
+  {
+    if(m_lutBands[i] >= m_rasterIn->getNumberOfBands())
+      break;
+
+    switch(m_rasterIn->getBand(m_lutBands[i])->getProperty()->getType())
+    {
+      case te::dt::CHAR_TYPE:
+        m_lutFirst.push_back(-128);
+        sizes.push_back(256);
+      break;
+
+      case te::dt::UCHAR_TYPE:
+        m_lutFirst.push_back(0);
+        sizes.push_back(256);
+      break;
+
+      case te::dt::INT16_TYPE:
+        m_lutFirst.push_back(-32768);
+        sizes.push_back(65536);
+      break;
+
+      case te::dt::UINT16_TYPE:
+        m_lutFirst.push_back(0);
+        sizes.push_back(65536);
+      break;
+    }
+  }
+
+  if(m_lutBands.empty() || sizes.size() != m_lutBands.size())
+  {
+    m_lutBands.clear();
+    m_lutFirst.clear();
+
+    return false;
+  }
+
+  if(singleBand)
+  {
+    m_lutColors.resize(sizes[0]);
+
+    for(int i = 0; i < sizes[0]; ++i)
+      m_lutColors[i] = getLUTColor(static_cast<double>(m_lutFirst[0] + i), static_cast<int>(m_lutBands[0]));
+
+    return true;
+  }
+
+  const double contrasts[] = { m_rContrast, m_gContrast, m_bContrast, 1. };
+
+  m_lutChannels.resize(m_lutBands.size());
+  m_lutNoData.resize(m_lutBands.size());
+
+  for(std::size_t b = 0; b < m_lutBands.size(); ++b)
+  {
+    m_lutChannels[b].resize(sizes[b]);
+    m_lutNoData[b].resize(sizes[b]);
+
+    for(int i = 0; i < sizes[b]; ++i)
+    {
+      double val = static_cast<double>(m_lutFirst[b] + i);
+
+      m_lutNoData[b][i] = checkNoValue(val, static_cast<int>(m_lutBands[b]));
+
+      // the alpha channel is not stretched
+      if(b < 3)
+        val = (val * m_gain + m_offset) * contrasts[b];
+
+      fixValue(val);
+
+      m_lutChannels[b][i] = static_cast<int>(val);
+    }
+  }
+
+  return true;
+}
+
+te::color::RGBAColor te::map::RasterTransform::applyLUT(const double* values) const
+{
+  std::size_t nBands = m_lutBands.size();
+
+  int idx[4];
+
+  for(std::size_t b = 0; b < nBands; ++b)
+  {
+    idx[b] = static_cast<int>(values[b]) - m_lutFirst[b];
+
+    if(idx[b] < 0)
+      return te::color::RGBAColor();
+  }
+
+  if(!m_lutColors.empty())
+  {
+    if(idx[0] >= static_cast<int>(m_lutColors.size()))
+      return te::color::RGBAColor();
+
+    return m_lutColors[idx[0]];
+  }
+
+  bool noData = true;
+
+  for(std::size_t b = 0; b < nBands; ++b)
+  {
+    if(idx[b] >= static_cast<int>(m_lutChannels[b].size()))
+      return te::color::RGBAColor();
+
+    noData = noData && m_lutNoData[b][idx[b]];
+  }
+
+  if(noData)
+    return te::color::RGBAColor();
+
+  int alpha = static_cast<int>(m_transp);
+
+  if(nBands == 4 && m_lutChannels[3][idx[3]] < m_transp)
+    alpha = m_lutChannels[3][idx[3]];
+
+  return te::color::RGBAColor(m_lutChannels[0][idx[0]], m_lutChannels[1][idx[1]], m_lutChannels[2][idx[2]], alpha);
+}
+
+te::color::RGBAColor te::map::RasterTransform::getLUTColor(double value, int band)
+{
+  if(checkNoValue(value, band))
+    return te::color::RGBAColor();
+
+  if(m_RGBAFuncPtr == &RasterTransform::getCategorize)
+    return getCategorizedColor(value);
+
+  if(m_RGBAFuncPtr == &RasterTransform::getInterpolate)
+    return getInterpolatedColor(value);
+
+  if(m_RGBAFuncPtr == &RasterTransform::getRecode)
+    return getRecodedColor(value);
+
+  int transp = static_cast<int>(m_transp);
+
+  if(m_RGBAFuncPtr == &RasterTransform::getRed2ThreeBand)
+  {
+    value = (value * m_gain + m_offset) * m_rContrast;
+    fixValue(value);
+
+    return te::color::RGBAColor(static_cast<int>(value), 0, 0, transp);
+  }
+
+  if(m_RGBAFuncPtr == &RasterTransform::getGreen2ThreeBand)
+  {
+    value = (value * m_gain + m_offset) * m_gContrast;
+    fixValue(value);
+
+    return te::color::RGBAColor(0, static_cast<int>(value), 0, transp);
+  }
+
+  if(m_RGBAFuncPtr == &RasterTransform::getBlue2ThreeBand)
+  {
+    value = (value * m_gain + m_offset) * m_bContrast;
+    fixValue(value);
+
+    return te::color::RGBAColor(0, 0, static_cast<int>(value), transp);
+  }
+
+  value = (value * m_gain + m_offset) * m_mContrast;
+  fixValue(value);
+
+  if(boost::math::isnan(value))
+    return te::color::RGBAColor();
+
+  return te::color::RGBAColor(static_cast<int>(value), static_cast<int>(value), static_cast<int>(value), transp);
+}
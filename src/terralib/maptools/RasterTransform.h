@@ -32,7 +32,9 @@
 #include "../color/ColorBar.h"
 
 // STL
+#include <cstddef>
 #include <map>
+#include <vector>
 
 namespace te
 {
@@ -230,6 +232,28 @@ namespace te
 
         te::color::RGBAColor apply(double icol, double ilin){return (this->*m_RGBAFuncPtr)(icol,ilin); }
 
+        /*!
+          \brief It precomputes the colors of the selected RGBA transformation for all the values of the input bands.
+
+          \details The lookup tables are only built for 8 and 16 bits integer input bands. They must be
+                   rebuilt if any parameter of the transformation is changed.
+
+          \return True if the lookup tables were built.
+        */
+        bool buildLUT();
+
+        /*! Returns the input bands of the lookup tables, in the order of the values given to applyLUT */
+        const std::vector<std::size_t>& getLUTBands() const { return m_lutBands; }
+
+        /*!
+          \brief It returns the color of a pixel using the lookup tables built by buildLUT.
+
+          \param values The pixel value in each band returned by getLUTBands.
+
+          \note It only reads the lookup tables, so it can be called by several threads at the same time.
+        */
+        te::color::RGBAColor applyLUT(const double* values) const;
+
       protected:
 
         /*! This transformation repeats the value of the first band in input three bands of the output */
@@ -309,6 +333,9 @@ namespace te
         /*! Function used to get the recoded color given a pixel value */
         te::color::RGBAColor getRecodedColor(double value);
 
+        /*! Function used to get the color of a single band transformation given a pixel value */
+        te::color::RGBAColor getLUTColor(double value, int band);
+
       private:
 
         te::rst::Raster* m_rasterIn;              //!< Pointer to a input raster.
@@ -334,6 +361,12 @@ namespace te
         CategorizedMap m_categorizeMap;           //!< Attribute to define the categorized transformation.
         InterpolatedMap m_interpolateMap;         //!< Attribute to define the interpolated transformation.
         RecodedMap m_recodeMap;                  //!< Attribute to define the recoded transformation.
+
+        std::vector<std::size_t> m_lutBands;                    //!< The input bands of the lookup tables.
+        std::vector<int> m_lutFirst;                            //!< The smallest value of each input band type.
+        std::vector<te::color::RGBAColor> m_lutColors;          //!< The colors of a single band transformation indexed by value.
+        std::vector<std::vector<int> > m_lutChannels;           //!< The channel values of a multiple bands transformation indexed by value.
+        std::vector<std::vector<bool> > m_lutNoData;            //!< The no data flags of a multiple bands transformation indexed by value.
     };
 
   } // end namespace map
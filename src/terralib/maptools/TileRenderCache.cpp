@@ -0,0 +1,434 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/maptools/TileRenderCache.cpp
+
+  \brief A cache of rendered layer tiles aligned to a fixed world grid.
+*/
+
+// TerraLib
+#include "../common/progress/TaskProgress.h"
+#include "../common/PlatformUtils.h"
+#include "../common/STLUtils.h"
+#include "../core/translator/Translator.h"
+#include "../geometry/Envelope.h"
+#include "AbstractLayer.h"
+#include "Canvas.h"
+#include "Exception.h"
+#include "TileRenderCache.h"
+#include "WorldDeviceTransformer.h"
+
+// STL
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+// Boost
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+/*! \brief The tiles missing in the cache, rendered by the worker threads. */
+struct te::map::TileRenderCache::RenderJob
+{
+  std::vector<te::gm::Envelope> m_extents;      //!< The extent of each missing tile.
+  std::vector<TilePtr> m_tiles;                 //!< The rendered tiles.
+  std::size_t m_nextTile;                       //!< The next tile to be rendered.
+  bool m_abort;                                 //!< Stop the workers.
+  std::string m_errorMessage;                   //!< The first error raised by a worker.
+  te::common::TaskProgress* m_task;             //!< The rendering progress.
+  boost::mutex m_mtx;                           //!< It protects the tiles queue and the status.
+};
+
+bool te::map::TileRenderCache::TileKey::operator<(const TileKey& rhs) const
+{
+  if(m_layerId != rhs.m_layerId)
+    return m_layerId < rhs.m_layerId;
+
+  if(m_version != rhs.m_version)
+    return m_version < rhs.m_version;
+
+  if(m_srid != rhs.m_srid)
+    return m_srid < rhs.m_srid;
+
+  if(m_level != rhs.m_level)
+    return m_level < rhs.m_level;
+
+  if(m_col != rhs.m_col)
+    return m_col < rhs.m_col;
+
+  return m_row < rhs.m_row;
+}
+
+te::map::TileRenderCache::TileRenderCache(const CanvasCreator& creator,
+                                          int tileSize,
+                                          std::size_t maxTiles,
+                                          std::size_t threads,
+                                          bool concurrentDraw)
+  : m_creator(creator),
+    m_tileSize(std::max(tileSize, 1)),
+    m_maxTiles(std::max<std::size_t>(maxTiles, 1)),
+    m_threads(threads),
+    m_concurrentDraw(concurrentDraw)
+{
+  if(m_threads == 0)
+    m_threads = std::max<std::size_t>(1, te::common::GetPhysProcNumber());
+}
+
+te::map::TileRenderCache::~TileRenderCache()
+{
+}
+
+void te::map::TileRenderCache::draw(AbstractLayer* layer, Canvas* canvas, const te::gm::Envelope& bbox, int srid, const double& scale, bool* cancel)
+{
+  assert(layer);
+  assert(canvas);
+
+  if(!bbox.isValid() || canvas->getWidth() <= 0 || canvas->getHeight() <= 0)
+    return;
+
+  WorldDeviceTransformer transformer(bbox.m_llx, bbox.m_lly, bbox.m_urx, bbox.m_ury, canvas->getWidth(), canvas->getHeight());
+
+  const double res = transformer.m_mapUnitsPP;
+
+  if(res <= 0.0)
+    return;
+
+  const double tileWorld = res * static_cast<double>(m_tileSize);
+
+// the tiles of a level are only reused for the same resolution (up to a rounding error)
+  TileKey key;
+  key.m_layerId = layer->getId();
+  key.m_version = layer->getVersion();
+  key.m_srid = srid;
+  key.m_level = static_cast<long long>(std::floor(std::log(res) * 1048576.0 + 0.5));
+
+  purge(key.m_layerId, key.m_version);
+
+  const long long firstCol = static_cast<long long>(std::floor(transformer.m_wllx / tileWorld));
+  const long long lastCol = static_cast<long long>(std::ceil(transformer.m_wurx / tileWorld)) - 1;
+  const long long firstRow = static_cast<long long>(std::floor(transformer.m_wlly / tileWorld));
+  const long long lastRow = static_cast<long long>(std::ceil(transformer.m_wury / tileWorld)) - 1;
+
+// look up the tiles covering the canvas
+  std::vector<TileKey> keys;
+  std::vector<TilePtr> tiles;
+  std::vector<std::size_t> missing;
+
+  RenderJob job;
+
+  for(long long row = lastRow; row >= firstRow; --row)
+  {
+    for(long long col = firstCol; col <= lastCol; ++col)
+    {
+      key.m_col = col;
+      key.m_row = row;
+
+      keys.push_back(key);
+      tiles.push_back(find(key));
+
+      if(tiles.back().get() != 0)
+        continue;
+
+      missing.push_back(tiles.size() - 1);
+
+      job.m_extents.push_back(te::gm::Envelope(static_cast<double>(col) * tileWorld,
+                                               static_cast<double>(row) * tileWorld,
+                                               static_cast<double>(col + 1) * tileWorld,
+                                               static_cast<double>(row + 1) * tileWorld));
+    }
+  }
+
+// render the missing tiles
+  if(!missing.empty())
+  {
+    te::common::TaskProgress task(TE_TR("Rendering tiles of ") + layer->getTitle(), te::common::TaskProgress::DRAW, static_cast<int>(missing.size()));
+    task.useMultiThread(true);
+
+    job.m_tiles.resize(missing.size());
+    job.m_nextTile = 0;
+    job.m_abort = false;
+    job.m_task = &task;
+
+// the first tile is rendered by this thread: it initializes the layer lazy state (schema, default style) before the workers start
+    renderTiles(&job, layer, srid, scale, cancel);
+
+    const std::size_t threadsNumber = std::min(m_threads, missing.size() - 1);
+
+    if(threadsNumber > 0 && !job.m_abort)
+    {
+      boost::thread_group threads;
+
+      for(std::size_t i = 0; i < threadsNumber; ++i)
+        threads.add_thread(new boost::thread(boost::bind(&TileRenderCache::renderTiles, this, &job, layer, srid, scale, cancel)));
+
+      threads.join_all();
+    }
+
+    if(!job.m_errorMessage.empty())
+      throw Exception(job.m_errorMessage);
+
+    for(std::size_t i = 0; i < missing.size(); ++i)
+    {
+      if(job.m_tiles[i].get() == 0)
+        continue;
+
+      tiles[missing[i]] = job.m_tiles[i];
+
+      insert(keys[missing[i]], job.m_tiles[i]);
+    }
+  }
+
+// compose the tiles in the canvas
+  for(std::size_t i = 0; i < tiles.size(); ++i)
+  {
+    if(tiles[i].get() == 0)
+      continue;
+
+    const double tllx = static_cast<double>(keys[i].m_col) * tileWorld;
+    const double tury = static_cast<double>(keys[i].m_row + 1) * tileWorld;
+
+    const int x = static_cast<int>(std::floor((tllx - transformer.m_wllx) / res + 0.5));
+    const int y = static_cast<int>(std::floor((transformer.m_wury - tury) / res + 0.5));
+
+    canvas->drawImage(x, y, &tiles[i]->m_rows[0], m_tileSize, m_tileSize);
+  }
+}
+
+void te::map::TileRenderCache::invalidate(const std::string& layerId)
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  TileMap::iterator it = m_tiles.begin();
+
+  while(it != m_tiles.end())
+  {
+    if(it->first.m_layerId == layerId)
+    {
+      m_lru.erase(it->second.second);
+      m_tiles.erase(it++);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  m_versions.erase(layerId);
+}
+
+void te::map::TileRenderCache::clear()
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  m_tiles.clear();
+  m_lru.clear();
+  m_versions.clear();
+}
+
+std::size_t te::map::TileRenderCache::size() const
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  return m_tiles.size();
+}
+
+int te::map::TileRenderCache::getTileSize() const
+{
+  return m_tileSize;
+}
+
+te::map::TileRenderCache::TilePtr te::map::TileRenderCache::find(const TileKey& key)
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  TileMap::iterator it = m_tiles.find(key);
+
+  if(it == m_tiles.end())
+    return TilePtr();
+
+// move the tile to the front of the LRU list
+  m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+
+  return it->second.first;
+}
+
+void te::map::TileRenderCache::insert(const TileKey& key, const TilePtr& tile)
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  TileMap::iterator it = m_tiles.find(key);
+
+  if(it != m_tiles.end())
+  {
+    it->second.first = tile;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+    return;
+  }
+
+  m_lru.push_front(key);
+  m_tiles[key] = std::make_pair(tile, m_lru.begin());
+
+// discard the least recently used tiles
+  while(m_tiles.size() > m_maxTiles)
+  {
+    m_tiles.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+}
+
+te::map::TileRenderCache::TilePtr te::map::TileRenderCache::render(RenderJob* job, AbstractLayer* layer, const te::gm::Envelope& extent, int srid, const double& scale, bool* cancel) const
+{
+  std::auto_ptr<Canvas> canvas(m_creator(m_tileSize, m_tileSize));
+
+  if(canvas.get() == 0)
+    throw Exception(TE_TR("Could not create the tile canvas!"));
+
+  canvas->setBackgroundColor(te::color::RGBAColor(0, 0, 0, TE_TRANSPARENT));
+  canvas->clear();
+  canvas->setWindow(extent.m_llx, extent.m_lly, extent.m_urx, extent.m_ury);
+
+  if(m_concurrentDraw)
+  {
+    layer->draw(canvas.get(), extent, srid, scale, cancel);
+  }
+  else
+  {
+    boost::shared_ptr<boost::mutex> drawMtx = getDrawMutex(layer->getId());
+
+    boost::lock_guard<boost::mutex> lock(*drawMtx);
+
+    layer->draw(canvas.get(), extent, srid, scale, cancel);
+  }
+
+// a cancelled tile may be incomplete
+  if((cancel != 0 && *cancel) || !job->m_task->isActive())
+    return TilePtr();
+
+  te::color::RGBAColor** rows = canvas->getImage(0, 0, m_tileSize, m_tileSize);
+
+  if(rows == 0)
+    throw Exception(TE_TR("Could not read the tile canvas image!"));
+
+  TilePtr tile(new Tile);
+
+  tile->m_pixels.resize(static_cast<std::size_t>(m_tileSize) * static_cast<std::size_t>(m_tileSize));
+  tile->m_rows.resize(static_cast<std::size_t>(m_tileSize));
+
+  for(int r = 0; r < m_tileSize; ++r)
+  {
+    te::color::RGBAColor* row = &tile->m_pixels[static_cast<std::size_t>(r) * static_cast<std::size_t>(m_tileSize)];
+
+    std::copy(rows[r], rows[r] + m_tileSize, row);
+
+    tile->m_rows[r] = row;
+  }
+
+  te::common::Free(rows, m_tileSize);
+
+  return tile;
+}
+
+void te::map::TileRenderCache::renderTiles(RenderJob* job, AbstractLayer* layer, int srid, double scale, bool* cancel) const
+{
+  while(true)
+  {
+    std::size_t i = 0;
+
+    {
+      boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+      if(job->m_abort || job->m_nextTile >= job->m_extents.size())
+        return;
+
+      i = job->m_nextTile++;
+    }
+
+    try
+    {
+      TilePtr tile = render(job, layer, job->m_extents[i], srid, scale, cancel);
+
+      boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+      job->m_tiles[i] = tile;
+
+      job->m_task->pulse();
+
+      if(tile.get() == 0 || !job->m_task->isActive())
+      {
+        job->m_abort = true;
+
+        return;
+      }
+
+// the first tile is rendered alone
+      if(i == 0)
+        return;
+    }
+    catch(const std::exception& e)
+    {
+      boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+      job->m_abort = true;
+
+      if(job->m_errorMessage.empty())
+        job->m_errorMessage = e.what();
+
+      return;
+    }
+  }
+}
+
+void te::map::TileRenderCache::purge(const std::string& layerId, std::size_t version)
+{
+  {
+    boost::lock_guard<boost::mutex> lock(m_mtx);
+
+    std::map<std::string, std::size_t>::iterator it = m_versions.find(layerId);
+
+    if(it != m_versions.end() && it->second == version)
+      return;
+
+    if(it == m_versions.end())
+    {
+      m_versions[layerId] = version;
+      return;
+    }
+  }
+
+// the layer has changed: discard the tiles of the previous versions
+  invalidate(layerId);
+
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  m_versions[layerId] = version;
+}
+
+boost::shared_ptr<boost::mutex> te::map::TileRenderCache::getDrawMutex(const std::string& layerId) const
+{
+  boost::lock_guard<boost::mutex> lock(m_mtx);
+
+  boost::shared_ptr<boost::mutex>& drawMtx = m_drawMtxs[layerId];
+
+  if(drawMtx.get() == 0)
+    drawMtx.reset(new boost::mutex);
+
+  return drawMtx;
+}
@@ -0,0 +1,205 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/maptools/TileRenderCache.h
+
+  \brief A cache of rendered layer tiles aligned to a fixed world grid.
+*/
+
+#ifndef __TERRALIB_MAPTOOLS_INTERNAL_TILERENDERCACHE_H
+#define __TERRALIB_MAPTOOLS_INTERNAL_TILERENDERCACHE_H
+
+// TerraLib
+#include "../color/RGBAColor.h"
+#include "Config.h"
+
+// STL
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+// Boost
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace te
+{
+// Forward declaration
+  namespace gm { class Envelope; }
+
+  namespace map
+  {
+// Forward declaration
+    class AbstractLayer;
+    class Canvas;
+
+    /*!
+      \class TileRenderCache
+
+      \brief A cache of rendered layer tiles aligned to a fixed world grid.
+
+      \details For each resolution the world is divided in square tiles of a fixed size in
+               pixels, anchored at the origin of the SRS. To draw a layer, the tiles covering
+               the requested area are looked up in the cache and only the missing ones are
+               rendered, in parallel, each one in its own off-screen canvas. So, while the
+               user pans the map, only the tiles that enter the view are rendered again.
+
+               The tiles are identified by the layer id, the layer version, the SRS, the
+               resolution and the tile column and row. When the layer version changes (see
+               AbstractLayer::getVersion) the tiles of the previous versions are discarded.
+               When the cache is full the least recently used tiles are discarded.
+
+               The cache does not depend on a specific canvas implementation: the off-screen
+               canvases are created by a function given by the application, so it can be
+               shared by the map display and the map exporters.
+
+      \note The labels and charts are clipped at the tile borders.
+
+      \note The calls to AbstractLayer::draw made by the cache for the tiles of a layer are
+            serialized, because most drivers do not support concurrent reads of the same
+            data set. Different layers are still drawn concurrently, as the map display
+            already does, and the canvases are created and copied in parallel. If the
+            drivers of the drawn layers support concurrent reads, the tiles may be drawn
+            concurrently (see the constructor).
+
+      \note The canvas creator is called by the rendering threads, so it must create canvases
+            that can be used outside the GUI thread (an image based canvas, for example).
+
+      \sa AbstractLayer, Canvas
+    */
+    class TEMAPEXPORT TileRenderCache : public boost::noncopyable
+    {
+      public:
+
+        /*! \brief A function that creates an off-screen canvas with the given width and height. */
+        typedef boost::function<Canvas* (int, int)> CanvasCreator;
+
+        /*!
+          \brief Constructor.
+
+          \param creator  The function used to create the tile canvases.
+          \param tileSize The tile width and height, in pixels.
+          \param maxTiles The maximum number of tiles kept in the cache.
+          \param threads  The number of rendering threads. If 0, the number of processors is used.
+          \param concurrentDraw If true, the tiles of a layer are drawn concurrently. Use it only
+                                if the data source drivers support concurrent reads.
+        */
+        TileRenderCache(const CanvasCreator& creator,
+                        int tileSize = TE_MAP_TILE_SIZE,
+                        std::size_t maxTiles = TE_MAP_TILE_CACHE_SIZE,
+                        std::size_t threads = 0,
+                        bool concurrentDraw = false);
+
+        /*! \brief Destructor. */
+        ~TileRenderCache();
+
+        /*!
+          \brief It draws a layer using the cached tiles, rendering the missing ones.
+
+          \param layer  The layer to be drawn.
+          \param canvas The canvas where the layer will be drawn.
+          \param bbox   The interest area to render the layer (in the canvas SRS).
+          \param srid   The SRS to be used to draw the layer objects.
+          \param scale  The current scale of display.
+          \param cancel A pointer to a boolean used to cancel the drawing.
+
+          \exception Exception It throws an exception if a tile can not be rendered.
+
+          \note The rendering is also cancelled when the user cancels the task progress.
+        */
+        void draw(AbstractLayer* layer, Canvas* canvas, const te::gm::Envelope& bbox, int srid, const double& scale, bool* cancel);
+
+        /*!
+          \brief It discards the tiles of a layer.
+
+          \param layerId The layer id.
+        */
+        void invalidate(const std::string& layerId);
+
+        /*! \brief It discards all the tiles. */
+        void clear();
+
+        /*! \brief It returns the number of tiles in the cache. */
+        std::size_t size() const;
+
+        /*! \brief It returns the tile width and height, in pixels. */
+        int getTileSize() const;
+
+      protected:
+
+        /*! \brief The identification of a tile. */
+        struct TileKey
+        {
+          std::string m_layerId;        //!< The layer id.
+          std::size_t m_version;        //!< The layer version.
+          int m_srid;                   //!< The SRS of the tile.
+          long long m_level;            //!< The resolution level.
+          long long m_col;              //!< The tile column.
+          long long m_row;              //!< The tile row.
+
+          bool operator<(const TileKey& rhs) const;
+        };
+
+        /*! \brief A rendered tile. */
+        struct Tile
+        {
+          std::vector<te::color::RGBAColor> m_pixels;   //!< The tile pixels.
+          std::vector<te::color::RGBAColor*> m_rows;    //!< The pointers to the tile rows.
+        };
+
+        typedef boost::shared_ptr<Tile> TilePtr;
+        typedef std::list<TileKey> LRUList;
+        typedef std::map<TileKey, std::pair<TilePtr, LRUList::iterator> > TileMap;
+
+        struct RenderJob;
+
+        TilePtr find(const TileKey& key);
+
+        void insert(const TileKey& key, const TilePtr& tile);
+
+        TilePtr render(RenderJob* job, AbstractLayer* layer, const te::gm::Envelope& extent, int srid, const double& scale, bool* cancel) const;
+
+        void renderTiles(RenderJob* job, AbstractLayer* layer, int srid, double scale, bool* cancel) const;
+
+        void purge(const std::string& layerId, std::size_t version);
+
+        boost::shared_ptr<boost::mutex> getDrawMutex(const std::string& layerId) const;
+
+      private:
+
+        CanvasCreator m_creator;                            //!< The tile canvas creator.
+        int m_tileSize;                                     //!< The tile width and height.
+        std::size_t m_maxTiles;                             //!< The maximum number of tiles.
+        std::size_t m_threads;                              //!< The number of rendering threads.
+        bool m_concurrentDraw;                              //!< If true, the layer draw calls are not serialized.
+        TileMap m_tiles;                                    //!< The cached tiles.
+        LRUList m_lru;                                      //!< The tiles from the most to the least recently used.
+        std::map<std::string, std::size_t> m_versions;      //!< The last version cached for each layer.
+        mutable boost::mutex m_mtx;                         //!< It protects the cache.
+        mutable std::map<std::string, boost::shared_ptr<boost::mutex> > m_drawMtxs;  //!< The mutexes that serialize the draw calls of each layer.
+    };
+
+  } // end namespace map
+}   // end namespace te
+
+#endif  // __TERRALIB_MAPTOOLS_INTERNAL_TILERENDERCACHE_H
@@ -24,14 +24,18 @@
 */
 
 // TerraLib
+#include "../common/PlatformUtils.h"
 #include "../common/progress/TaskProgress.h"
 #include "../core/translator/Translator.h"
 #include "../common/STLUtils.h"
 #include "../common/StringUtils.h"
+#include "../dataaccess/dataset/DataSetCapabilities.h"
 #include "../dataaccess/dataset/DataSetType.h"
+#include "../dataaccess/dataset/FilteredDataSet.h"
 #include "../dataaccess/query/And.h"
 #include "../dataaccess/query/DataSetName.h"
 #include "../dataaccess/query/Field.h"
+#include "../dataaccess/query/FilterProgram.h"
 #include "../dataaccess/query/LiteralEnvelope.h"
 #include "../dataaccess/query/PropertyName.h"
 #include "../dataaccess/query/Select.h"
@@ -39,7 +43,10 @@
 #include "../dataaccess/query/Where.h"
 #include "../dataaccess/utils/Utils.h"
 #include "../fe/Literal.h"
+#include "../geometry/CurvePolygon.h"
+#include "../geometry/GeometryCollection.h"
 #include "../geometry/GeometryProperty.h"
+#include "../geometry/LineString.h"
 #include "../geometry/Utils.h"
 #include "../memory/DataSet.h"
 #include "../raster/Grid.h"
@@ -65,16 +72,20 @@
 #include "DataSetLayer.h"
 #include "Exception.h"
 #include "QueryEncoder.h"
+#include "RasterControlGrid.h"
 #include "RasterTransform.h"
 #include "RasterTransformConfigurer.h"
+#include "TileRenderCache.h"
 #include "Utils.h"
 
 // Boost
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
 
 // STL
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <memory>
 
@@ -300,6 +311,26 @@ te::da::DataSet* te::map::DataSet2Memory(te::da::DataSet* dataset)
   return new te::mem::DataSet(*dataset);
 }
 
+std::auto_ptr<te::da::DataSet> te::map::FilterData(std::auto_ptr<te::da::DataSet> dataset, const te::da::Expression& e)
+{
+  assert(dataset.get());
+
+  // the selected items are accessed by their positions
+  if(dataset->getTraverseType() != te::common::RANDOM)
+    dataset.reset(new te::mem::DataSet(*dataset));
+
+  te::da::FilterProgram program(e, dataset.get());
+
+  std::vector<std::size_t> positions;
+
+  program.select(dataset.get(), positions);
+
+  te::da::DataSetCapabilities capabilities;
+  capabilities.setSupportAll();
+
+  return std::auto_ptr<te::da::DataSet>(new te::da::FilteredDataSet(dataset.release(), capabilities, positions, true));
+}
+
 void te::map::DrawGeometries(te::da::DataSetType* type, te::da::DataSourcePtr ds,
                              Canvas* canvas, const te::gm::Envelope& bbox, int bboxSRID,
                              int srid, te::se::FeatureTypeStyle* style)
@@ -497,6 +528,144 @@ void te::map::DrawRaster(te::da::DataSetType* type, te::da::DataSourcePtr ds, Ca
   DrawRaster(raster.get(), canvas, bbox, bboxSRID, visibleArea, srid, style, scale);
 }
 
+namespace
+{
+  /*! \brief The state shared by the raster drawing threads. */
+  struct RasterDrawJob
+  {
+    te::rst::Raster* m_raster;                    //!< The raster (or overview) being drawn.
+    te::map::RasterTransform* m_transform;        //!< The raster transformation.
+    const te::map::RasterControlGrid* m_grid;     //!< The raster coordinates of the canvas pixels.
+    te::color::RGBAColor** m_rows;                //!< The result image rows.
+    bool m_useLUT;                                //!< If true the colors are taken from the transformation lookup tables.
+    unsigned int m_width;                         //!< The number of canvas columns.
+    unsigned int m_height;                        //!< The number of canvas rows.
+    unsigned int m_nextRow;                       //!< The first row of the next band.
+    bool m_abort;                                 //!< Stop the workers.
+    std::string m_errorMessage;                   //!< The first error raised by a worker.
+    te::common::TaskProgress* m_task;             //!< The drawing progress.
+    boost::mutex m_mtx;                           //!< It protects the bands queue and the status.
+    boost::mutex m_mtxIO;                         //!< It serializes the raster access.
+  };
+
+  void DrawRasterRow(RasterDrawJob* job, unsigned int r, std::vector<unsigned int>& cols,
+                     std::vector<int>& pixels, std::vector<double>& values)
+  {
+    te::color::RGBAColor* row = job->m_rows[r];
+
+    const int nCols = static_cast<int>(job->m_raster->getNumberOfColumns());
+    const int nRows = static_cast<int>(job->m_raster->getNumberOfRows());
+
+    cols.clear();
+    pixels.clear();
+
+    for(unsigned int c = 0; c < job->m_width; ++c)
+    {
+      row[c] = te::color::RGBAColor(0, 0, 0, 0);
+
+      double x, y;
+
+      if(!job->m_grid->get(c, r, x, y))
+        continue;
+
+      int ix = te::rst::Round(x);
+      int iy = te::rst::Round(y);
+
+      if(ix < 0 || ix >= nCols || iy < 0 || iy >= nRows)
+        continue;
+
+      cols.push_back(c);
+      pixels.push_back(ix);
+      pixels.push_back(iy);
+    }
+
+    if(cols.empty())
+      return;
+
+    if(!job->m_useLUT)
+    {
+      boost::lock_guard<boost::mutex> lock(job->m_mtxIO);
+
+      for(std::size_t i = 0; i < cols.size(); ++i)
+        row[cols[i]] = job->m_transform->apply(pixels[2 * i], pixels[2 * i + 1]);
+
+      return;
+    }
+
+    const std::vector<std::size_t>& bands = job->m_transform->getLUTBands();
+
+    const std::size_t nBands = bands.size();
+
+    values.resize(cols.size() * nBands);
+
+    {
+      boost::lock_guard<boost::mutex> lock(job->m_mtxIO);
+
+      for(std::size_t i = 0; i < cols.size(); ++i)
+      {
+        for(std::size_t b = 0; b < nBands; ++b)
+          job->m_raster->getValue(pixels[2 * i], pixels[2 * i + 1], values[i * nBands + b], bands[b]);
+      }
+    }
+
+    for(std::size_t i = 0; i < cols.size(); ++i)
+      row[cols[i]] = job->m_transform->applyLUT(&values[i * nBands]);
+  }
+
+  void DrawRasterThreadEntry(RasterDrawJob* job)
+  {
+    std::vector<unsigned int> cols;
+    std::vector<int> pixels;
+    std::vector<double> values;
+
+    while(true)
+    {
+      unsigned int firstRow = 0;
+      unsigned int lastRow = 0;
+
+      {
+        boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+        if(job->m_abort || job->m_nextRow >= job->m_height)
+          return;
+
+        firstRow = job->m_nextRow;
+        lastRow = std::min(firstRow + TE_MAP_RASTER_BAND_ROWS, job->m_height);
+        job->m_nextRow = lastRow;
+      }
+
+      try
+      {
+        for(unsigned int r = firstRow; r < lastRow; ++r)
+          DrawRasterRow(job, r, cols, pixels, values);
+
+        boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+        for(unsigned int r = firstRow; r < lastRow; ++r)
+          job->m_task->pulse();
+
+        if(!job->m_task->isActive())
+        {
+          job->m_abort = true;
+
+          return;
+        }
+      }
+      catch(const std::exception& e)
+      {
+        boost::lock_guard<boost::mutex> lock(job->m_mtx);
+
+        job->m_abort = true;
+
+        if(job->m_errorMessage.empty())
+          job->m_errorMessage = e.what();
+
+        return;
+      }
+    }
+  }
+}
+
 void te::map::DrawRaster(te::rst::Raster* raster, Canvas* canvas, const te::gm::Envelope& bbox, int bboxSRID,
   const te::gm::Envelope& visibleArea, int srid, te::se::CoverageStyle* style, const double& scale)
 {
@@ -609,78 +778,65 @@ void te::map::DrawRaster(te::rst::Raster* raster, Canvas* canvas, const te::gm::
 
 // create the draw task
   te::common::TaskProgress task(message, te::common::TaskProgress::DRAW, gridCanvas->getNumberOfRows());
-
-// create a RGBA array that will be drawn in the canvas. i.e. This array is the result of the render process.
-  //te::color::RGBAColor** rgba = new te::color::RGBAColor*[gridCanvas->getNumberOfRows()];
-
-// create a RGBA array that will be drawn in the canvas. i.e. This array represents a row of the render process.
-  te::color::RGBAColor** row = new te::color::RGBAColor*[1];
-  te::color::RGBAColor* columns = new te::color::RGBAColor[gridCanvas->getNumberOfColumns()];
-  row[0] = columns;
+  task.useMultiThread(true);
 
 // create a SRS converter
-  std::auto_ptr<te::srs::Converter> converter(new te::srs::Converter());
-    
+  std::auto_ptr<te::srs::Converter> converter;
+
   if(needRemap)
   {
+    converter.reset(new te::srs::Converter());
     converter->setSourceSRID(srid);
     converter->setTargetSRID(bboxSRID);
   }
 
-// fill the result RGBA array
-  for(unsigned int r = 0; r < gridCanvas->getNumberOfRows(); ++r)
-  {
-    for(unsigned int c = 0; c < gridCanvas->getNumberOfColumns(); ++c)
-    {
-      te::gm::Coord2D inputGeo = gridCanvas->gridToGeo(c, r);
-
-      if(needRemap)
-        converter->convert(inputGeo.x, inputGeo.y, inputGeo.x, inputGeo.y);
-
-      te::gm::Coord2D outputGrid = overview->getGrid()->geoToGrid(inputGeo.x, inputGeo.y);
-
-// TODO: round or truncate?
-      int x = te::rst::Round(outputGrid.x);
-      int y = te::rst::Round(outputGrid.y);
+// compute the raster coordinates of the canvas pixels
+  te::map::RasterControlGrid controlGrid(*gridCanvas, *overview->getGrid(), converter.get(), TE_MAP_RASTER_GRID_STEP);
 
-      te::color::RGBAColor color(0, 0, 0, 0);
+  const unsigned int width = gridCanvas->getNumberOfColumns();
+  const unsigned int height = gridCanvas->getNumberOfRows();
 
-      if((x >= 0 && x < (int)(overview->getNumberOfColumns())) &&
-         (y >= 0 && y < (int)(overview->getNumberOfRows())))
-           color = rasterTransform.apply(x, y);
+// create a RGBA array that will be drawn in the canvas. i.e. This array is the result of the render process.
+  std::vector<te::color::RGBAColor> pixels(static_cast<std::size_t>(width) * height);
+  std::vector<te::color::RGBAColor*> rows(height);
 
-      columns[c] = color;
-    }
+  for(unsigned int r = 0; r < height; ++r)
+    rows[r] = &pixels[static_cast<std::size_t>(r) * width];
 
-    //rgba[r] = columns;
+// fill the result RGBA array using row bands
+  RasterDrawJob job;
+  job.m_raster = overview;
+  job.m_transform = &rasterTransform;
+  job.m_grid = &controlGrid;
+  job.m_rows = rows.empty() ? 0 : &rows[0];
+  job.m_useLUT = rasterTransform.buildLUT();
+  job.m_width = width;
+  job.m_height = height;
+  job.m_nextRow = 0;
+  job.m_abort = false;
+  job.m_task = &task;
 
-    if(!task.isActive())
-    {
-// draw the part of result
-      //canvas->drawImage(0, 0, rgba, canvas->getWidth(), r + 1);
-      canvas->drawImage(0, r, row, canvas->getWidth(), 1);
+  std::size_t threadsNumber = std::max<std::size_t>(1, te::common::GetPhysProcNumber());
 
-// free memory
-      //te::common::Free(rgba, r + 1);
-      te::common::Free(row, 1);
-
-      return;
-    }
+  boost::thread_group threads;
 
-    canvas->drawImage(0, r, row, canvas->getWidth(), 1);
+  for(std::size_t i = 0; i < threadsNumber; ++i)
+    threads.add_thread(new boost::thread(DrawRasterThreadEntry, &job));
 
-    task.pulse();
-  }
+  threads.join_all();
 
   if(needDelete)
     delete overview;
 
+  if(!job.m_errorMessage.empty())
+    throw Exception(job.m_errorMessage);
+
 // put the result in the canvas
-  //canvas->drawImage(0, 0, rgba, canvas->getWidth(), canvas->getHeight());
+  if(height != 0)
+    canvas->drawImage(0, 0, &rows[0], width, height);
 
-// free memory
-  //te::common::Free(rgba, gridCanvas->getNumberOfRows());
-  te::common::Free(row, 1);
+  if(job.m_abort)
+    return;
 
 // image outline
   if(rasterSymbolizer->getImageOutline() == 0)
@@ -774,6 +930,27 @@ te::rst::Raster* te::map::GetExtentRaster(te::rst::Raster* raster, int w, int h,
   return rasterOut;
 }
 
+void te::map::DrawLayers(const std::list<te::map::AbstractLayerPtr>& layers, Canvas* canvas, const te::gm::Envelope& bbox,
+                         int srid, const double& scale, bool* cancel, TileRenderCache* cache)
+{
+  assert(canvas);
+
+  std::list<te::map::AbstractLayerPtr> visibleLayers;
+
+  GetVisibleLayers(layers, visibleLayers);
+
+  for(std::list<te::map::AbstractLayerPtr>::reverse_iterator it = visibleLayers.rbegin(); it != visibleLayers.rend(); ++it)
+  {
+    if(cancel != 0 && *cancel)
+      return;
+
+    if(cache != 0)
+      cache->draw(it->get(), canvas, bbox, srid, scale, cancel);
+    else
+      (*it)->draw(canvas, bbox, srid, scale, cancel);
+  }
+}
+
 te::gm::GeomType te::map::GetGeomType(const  te::map::AbstractLayerPtr& layer)
 {
   assert(layer.get());
@@ -891,3 +1068,102 @@ std::string te::map::GetUTMProj4FromZone( int zone )
   return proj4;
 }
 
+
+namespace
+{
+  void GeneralizeLineString(te::gm::LineString* line, double originX, double originY, double cellSize, std::size_t minPoints)
+  {
+    const std::size_t nPoints = line->getNPoints();
+
+    if(nPoints <= minPoints)
+      return;
+
+    te::gm::Coord2D* coords = line->getCoordinates();
+    double* zA = line->getZ();
+    double* mA = line->getM();
+
+    // the cell of the last kept vertex
+    double cellX = std::floor((coords[0].x - originX) / cellSize);
+    double cellY = std::floor((coords[0].y - originY) / cellSize);
+
+    std::size_t nKept = 1;
+
+    for(std::size_t i = 1; i < nPoints - 1; ++i)
+    {
+      double cx = std::floor((coords[i].x - originX) / cellSize);
+      double cy = std::floor((coords[i].y - originY) / cellSize);
+
+      if(cx == cellX && cy == cellY)
+        continue;
+
+      cellX = cx;
+      cellY = cy;
+
+      ++nKept;
+    }
+
+    // the last vertex is always kept
+    ++nKept;
+
+    if(nKept < minPoints || nKept == nPoints)
+      return;
+
+    cellX = std::floor((coords[0].x - originX) / cellSize);
+    cellY = std::floor((coords[0].y - originY) / cellSize);
+
+    std::size_t j = 1;
+
+    for(std::size_t i = 1; i < nPoints; ++i)
+    {
+      if(i < nPoints - 1)
+      {
+        double cx = std::floor((coords[i].x - originX) / cellSize);
+        double cy = std::floor((coords[i].y - originY) / cellSize);
+
+        if(cx == cellX && cy == cellY)
+          continue;
+
+        cellX = cx;
+        cellY = cy;
+      }
+
+      coords[j] = coords[i];
+
+      if(zA)
+        zA[j] = zA[i];
+
+      if(mA)
+        mA[j] = mA[i];
+
+      ++j;
+    }
+
+    line->setNumCoordinates(j);
+  }
+}
+
+void te::map::GeneralizeGeometry(te::gm::Geometry* g, double originX, double originY, double cellSize)
+{
+  if(g == 0 || !(cellSize > 0.0))
+    return;
+
+  if(te::gm::LineString* line = dynamic_cast<te::gm::LineString*>(g))
+  {
+    GeneralizeLineString(line, originX, originY, cellSize, line->isClosed() ? 4 : 2);
+  }
+  else if(te::gm::CurvePolygon* polygon = dynamic_cast<te::gm::CurvePolygon*>(g))
+  {
+    for(std::size_t i = 0; i < polygon->getNumRings(); ++i)
+    {
+      te::gm::LineString* ring = dynamic_cast<te::gm::LineString*>(polygon->getRingN(i));
+
+      if(ring)
+        GeneralizeLineString(ring, originX, originY, cellSize, 4);
+    }
+  }
+  else if(te::gm::GeometryCollection* collection = dynamic_cast<te::gm::GeometryCollection*>(g))
+  {
+    for(std::size_t i = 0; i < collection->getNumGeometries(); ++i)
+      GeneralizeGeometry(collection->getGeometryN(i), originX, originY, cellSize);
+  }
+}
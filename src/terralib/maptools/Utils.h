@@ -39,6 +39,7 @@
 
 // STL
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -54,6 +55,12 @@ namespace te
   {
     class DataSet;
     class DataSetType;
+    class Expression;
+  }
+
+  namespace gm
+  {
+    class Geometry;
   }
 
   namespace rst
@@ -71,6 +78,7 @@ namespace te
   {
 // Forward declaration
     class DataSetLayer;
+    class TileRenderCache;
 
     /*!
       \brief It calculates the extent of selected objects of the given layers in the given SRID.
@@ -196,6 +204,20 @@ namespace te
     */
     TEMAPEXPORT te::da::DataSet* DataSet2Memory(te::da::DataSet* dataset);
 
+    /*!
+      \brief It selects the items of a dataset satisfying an expression evaluated by a compiled te::da::FilterProgram.
+
+      \param dataset The dataset which will provide the items, at before begin. If it can not be randomly accessed, its items are copied to memory.
+      \param e       The filter expression.
+
+      \return A dataset with the selected items.
+
+      \exception Exception It throws an exception if the expression is not supported by te::da::FilterProgram.
+
+      \note It is used to evaluate on the client side the filters that a data source can not process.
+    */
+    TEMAPEXPORT std::auto_ptr<te::da::DataSet> FilterData(std::auto_ptr<te::da::DataSet> dataset, const te::da::Expression& e);
+
     /*!
       \brief It draws the data set geometries in the given canvas using the informed SRID and style.
 
@@ -236,6 +258,23 @@ namespace te
     TEMAPEXPORT te::rst::Raster* GetExtentRaster(te::rst::Raster* raster, int w, int h, const te::gm::Envelope& bbox, int bboxSRID,
                                 const te::gm::Envelope& visibleArea, int srid);
 
+    /*!
+      \brief It draws the visible layers of a list in the given canvas. The first layer is drawn on top.
+
+      It does not depend on a map display, so it can be used to export maps.
+
+      \param layers The layers that will be drawn (the children of the layers are considered).
+      \param canvas The canvas where the layers will be drawn.
+      \param bbox   The interest area to render the layers (in the given SRS).
+      \param srid   The SRS to be used to draw the layers.
+      \param scale  The scale of the drawing.
+      \param cancel A pointer to a boolean used to cancel the drawing (it may be null).
+      \param cache  An optional tile cache. If given, the layers are drawn through it, reusing the tiles already
+                    rendered for the same resolution (by a map display, for example).
+    */
+    TEMAPEXPORT void DrawLayers(const std::list<te::map::AbstractLayerPtr>& layers, Canvas* canvas, const te::gm::Envelope& bbox,
+                                int srid, const double& scale, bool* cancel, TileRenderCache* cache = 0);
+
      /*!
       \brief It gets the geometry type of the given layer.
 
@@ -267,6 +306,21 @@ namespace te
     */
     TEMAPEXPORT int CalculatePlanarZone(te::gm::Envelope latLongBox);
 
+    /*!
+      \brief It removes the vertices of a geometry that fall in the same grid cell as the previous kept vertex.
+
+      With cells of one pixel the drawn shape does not change visibly, and the number of vertices
+      sent to the canvas is limited by the number of pixels crossed by each line. The kept vertices
+      are not moved, the first and the last vertices of each line are always kept and a ring is
+      only simplified if it keeps at least four vertices.
+
+      \param g        The geometry, changed in place (points are not changed).
+      \param originX  The x-coordinate of a corner of the grid.
+      \param originY  The y-coordinate of a corner of the grid.
+      \param cellSize The size of the grid cells, in the geometry units.
+    */
+    TEMAPEXPORT void GeneralizeGeometry(te::gm::Geometry* g, double originX, double originY, double cellSize);
+
   } // end namespace map
 }   // end namespace te
 
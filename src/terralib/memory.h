@@ -30,6 +30,7 @@
 // memory
 #include "memory/Config.h"
 #include "memory/CachedRaster.h"
+#include "memory/ColumnarDataSet.h"
 #include "memory/DataSet.h"
 #include "memory/DataSetItem.h"
 #include "memory/ExpansibleBandBlocksManager.h"
@@ -0,0 +1,1330 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/memory/ColumnarDataSet.cpp
+
+  \brief A random-access dataset stored by columns for the TerraLib In-Memory Data Access driver.
+*/
+
+// TerraLib
+#include "../common/Globals.h"
+#include "../core/translator/Translator.h"
+#include "../dataaccess/dataset/DataSetType.h"
+#include "../dataaccess/utils/Utils.h"
+#include "../datatype/Array.h"
+#include "../datatype/ByteArray.h"
+#include "../datatype/DateTime.h"
+#include "../datatype/Enums.h"
+#include "../datatype/SimpleData.h"
+#include "../geometry/Geometry.h"
+#include "../geometry/WKBReader.h"
+#include "../raster/Raster.h"
+#include "ColumnarDataSet.h"
+#include "Exception.h"
+
+// STL
+#include <cstring>
+#include <limits>
+
+// Boost
+#include <boost/lexical_cast.hpp>
+
+namespace
+{
+  template<class S, class T> inline T ReadAs(const char* p)
+  {
+    S v;
+    memcpy(&v, p, sizeof(S));
+    return static_cast<T>(v);
+  }
+
+  template<class T, class S> inline void WriteAs(char* p, S value)
+  {
+    T v = static_cast<T>(value);
+    memcpy(p, &v, sizeof(T));
+  }
+
+  // It converts a fixed size value of the given type
+  template<class T> T FixedValue(int type, const char* p)
+  {
+    switch(type)
+    {
+      case te::dt::CHAR_TYPE:
+        return ReadAs<char, T>(p);
+
+      case te::dt::UCHAR_TYPE:
+        return ReadAs<unsigned char, T>(p);
+
+      case te::dt::INT16_TYPE:
+        return ReadAs<boost::int16_t, T>(p);
+
+      case te::dt::UINT16_TYPE:
+        return ReadAs<boost::uint16_t, T>(p);
+
+      case te::dt::INT32_TYPE:
+        return ReadAs<boost::int32_t, T>(p);
+
+      case te::dt::UINT32_TYPE:
+        return ReadAs<boost::uint32_t, T>(p);
+
+      case te::dt::INT64_TYPE:
+        return ReadAs<boost::int64_t, T>(p);
+
+      case te::dt::UINT64_TYPE:
+        return ReadAs<boost::uint64_t, T>(p);
+
+      case te::dt::BOOLEAN_TYPE:
+        return ReadAs<bool, T>(p);
+
+      case te::dt::FLOAT_TYPE:
+        return ReadAs<float, T>(p);
+
+      default:
+        return ReadAs<double, T>(p);
+    }
+  }
+
+  // It stores a value converted to the given fixed size type
+  template<class S> void SetFixedValue(int type, char* p, S value)
+  {
+    switch(type)
+    {
+      case te::dt::CHAR_TYPE:
+        WriteAs<char>(p, value);
+      break;
+
+      case te::dt::UCHAR_TYPE:
+        WriteAs<unsigned char>(p, value);
+      break;
+
+      case te::dt::INT16_TYPE:
+        WriteAs<boost::int16_t>(p, value);
+      break;
+
+      case te::dt::UINT16_TYPE:
+        WriteAs<boost::uint16_t>(p, value);
+      break;
+
+      case te::dt::INT32_TYPE:
+        WriteAs<boost::int32_t>(p, value);
+      break;
+
+      case te::dt::UINT32_TYPE:
+        WriteAs<boost::uint32_t>(p, value);
+      break;
+
+      case te::dt::INT64_TYPE:
+        WriteAs<boost::int64_t>(p, value);
+      break;
+
+      case te::dt::UINT64_TYPE:
+        WriteAs<boost::uint64_t>(p, value);
+      break;
+
+      case te::dt::BOOLEAN_TYPE:
+        WriteAs<bool>(p, value != 0);
+      break;
+
+      case te::dt::FLOAT_TYPE:
+        WriteAs<float>(p, value);
+      break;
+
+      default:
+        WriteAs<double>(p, value);
+    }
+  }
+
+  std::size_t FixedWidth(int type)
+  {
+    switch(type)
+    {
+      case te::dt::CHAR_TYPE:
+      case te::dt::UCHAR_TYPE:
+        return 1;
+
+      case te::dt::BOOLEAN_TYPE:
+        return sizeof(bool);
+
+      case te::dt::INT16_TYPE:
+      case te::dt::UINT16_TYPE:
+        return 2;
+
+      case te::dt::INT32_TYPE:
+      case te::dt::UINT32_TYPE:
+      case te::dt::FLOAT_TYPE:
+        return 4;
+
+      case te::dt::INT64_TYPE:
+      case te::dt::UINT64_TYPE:
+      case te::dt::DOUBLE_TYPE:
+        return 8;
+
+      default:
+        return 0;
+    }
+  }
+}
+
+te::mem::ColumnarDataSet::ColumnT::ColumnT(const std::string& name, int type)
+  : m_name(name),
+    m_type(type),
+    m_storage(OBJECT_STORAGE),
+    m_width(FixedWidth(type)),
+    m_nnulls(0),
+    m_garbage(0)
+{
+  if(m_width != 0)
+  {
+    m_storage = FIXED_STORAGE;
+  }
+  else if(type == te::dt::NUMERIC_TYPE || type == te::dt::STRING_TYPE ||
+          type == te::dt::BYTE_ARRAY_TYPE || type == te::dt::GEOMETRY_TYPE)
+  {
+    m_storage = VARIABLE_STORAGE;
+  }
+}
+
+te::mem::ColumnarDataSet::ColumnT::ColumnT(const ColumnT& rhs)
+  : m_name(rhs.m_name),
+    m_type(rhs.m_type),
+    m_storage(rhs.m_storage),
+    m_width(rhs.m_width),
+    m_nulls(rhs.m_nulls),
+    m_nnulls(rhs.m_nnulls),
+    m_fixed(rhs.m_fixed),
+    m_arena(rhs.m_arena),
+    m_offsets(rhs.m_offsets),
+    m_lengths(rhs.m_lengths),
+    m_garbage(rhs.m_garbage),
+    m_mbrs(rhs.m_mbrs),
+    m_srids(rhs.m_srids),
+    m_objects(rhs.m_objects.size(), (te::dt::AbstractData*)0)
+{
+  for(std::size_t i = 0; i < m_objects.size(); ++i)
+  {
+    if(rhs.m_objects[i])
+      m_objects[i] = rhs.m_objects[i]->clone();
+  }
+}
+
+te::mem::ColumnarDataSet::ColumnT::~ColumnT()
+{
+  for(std::size_t i = 0; i < m_objects.size(); ++i)
+    delete m_objects[i];
+}
+
+void te::mem::ColumnarDataSet::ColumnT::push()
+{
+  m_nulls.push_back(true);
+  ++m_nnulls;
+
+  switch(m_storage)
+  {
+    case FIXED_STORAGE:
+      m_fixed.resize(m_fixed.size() + m_width, 0);
+    break;
+
+    case VARIABLE_STORAGE:
+      m_offsets.push_back(0);
+      m_lengths.push_back(0);
+
+      if(m_type == te::dt::GEOMETRY_TYPE)
+      {
+        m_mbrs.push_back(te::gm::Envelope());
+        m_srids.push_back(0);
+      }
+    break;
+
+    default:
+      m_objects.push_back(0);
+  }
+}
+
+void te::mem::ColumnarDataSet::ColumnT::erase(std::size_t item)
+{
+  setNull(item);
+
+  m_nulls.erase(m_nulls.begin() + item);
+  --m_nnulls;
+
+  switch(m_storage)
+  {
+    case FIXED_STORAGE:
+      m_fixed.erase(m_fixed.begin() + item * m_width, m_fixed.begin() + (item + 1) * m_width);
+    break;
+
+    case VARIABLE_STORAGE:
+      m_offsets.erase(m_offsets.begin() + item);
+      m_lengths.erase(m_lengths.begin() + item);
+
+      if(m_type == te::dt::GEOMETRY_TYPE)
+      {
+        m_mbrs.erase(m_mbrs.begin() + item);
+        m_srids.erase(m_srids.begin() + item);
+      }
+    break;
+
+    default:
+      m_objects.erase(m_objects.begin() + item);
+  }
+}
+
+void te::mem::ColumnarDataSet::ColumnT::setBytes(std::size_t item, const char* data, std::size_t size)
+{
+  if(m_nulls[item])
+  {
+    m_nulls[item] = false;
+    --m_nnulls;
+  }
+  else
+  {
+    m_garbage += m_lengths[item];
+  }
+
+  m_offsets[item] = m_arena.size();
+  m_lengths[item] = size;
+
+  m_arena.insert(m_arena.end(), data, data + size);
+}
+
+void te::mem::ColumnarDataSet::ColumnT::setObject(std::size_t item, te::dt::AbstractData* value)
+{
+  setNull(item);
+
+  if(value == 0)
+    return;
+
+  m_objects[item] = value;
+  m_nulls[item] = false;
+  --m_nnulls;
+}
+
+void te::mem::ColumnarDataSet::ColumnT::setNull(std::size_t item)
+{
+  if(m_nulls[item])
+    return;
+
+  m_nulls[item] = true;
+  ++m_nnulls;
+
+  switch(m_storage)
+  {
+    case VARIABLE_STORAGE:
+      m_garbage += m_lengths[item];
+      m_lengths[item] = 0;
+
+      if(m_type == te::dt::GEOMETRY_TYPE)
+        m_mbrs[item] = te::gm::Envelope();
+    break;
+
+    case OBJECT_STORAGE:
+      delete m_objects[item];
+      m_objects[item] = 0;
+    break;
+
+    default:
+    break;
+  }
+}
+
+void te::mem::ColumnarDataSet::ColumnT::compact()
+{
+  if(m_garbage == 0)
+    return;
+
+  std::vector<char> arena;
+  arena.reserve(m_arena.size() - m_garbage);
+
+  for(std::size_t i = 0; i < m_offsets.size(); ++i)
+  {
+    if(m_nulls[i])
+      continue;
+
+    std::size_t offset = arena.size();
+
+    arena.insert(arena.end(), m_arena.begin() + m_offsets[i], m_arena.begin() + m_offsets[i] + m_lengths[i]);
+
+    m_offsets[i] = offset;
+  }
+
+  m_arena.swap(arena);
+  m_garbage = 0;
+}
+
+void te::mem::ColumnarDataSet::ColumnT::reserve(std::size_t nitems)
+{
+  m_nulls.reserve(nitems);
+
+  switch(m_storage)
+  {
+    case FIXED_STORAGE:
+      m_fixed.reserve(nitems * m_width);
+    break;
+
+    case VARIABLE_STORAGE:
+      m_offsets.reserve(nitems);
+      m_lengths.reserve(nitems);
+
+      if(m_type == te::dt::GEOMETRY_TYPE)
+      {
+        m_mbrs.reserve(nitems);
+        m_srids.reserve(nitems);
+      }
+    break;
+
+    default:
+      m_objects.reserve(nitems);
+  }
+}
+
+te::mem::ColumnarDataSet::ColumnarDataSet(const te::da::DataSetType* const dt)
+  : m_size(0),
+    m_i(-1)
+{
+  std::vector<std::string> pnames;
+  std::vector<int> ptypes;
+
+  te::da::GetPropertyInfo(dt, pnames, ptypes);
+
+  for(std::size_t i = 0; i < pnames.size(); ++i)
+    m_columns.push_back(new ColumnT(pnames[i], ptypes[i]));
+}
+
+te::mem::ColumnarDataSet::ColumnarDataSet(te::da::DataSet& rhs)
+  : m_size(0),
+    m_i(-1)
+{
+  const std::size_t np = rhs.getNumProperties();
+
+  for(std::size_t i = 0; i < np; ++i)
+    m_columns.push_back(new ColumnT(rhs.getPropertyName(i), rhs.getPropertyDataType(i)));
+
+  copy(rhs, 0);
+}
+
+te::mem::ColumnarDataSet::ColumnarDataSet(te::da::DataSet& rhs, const std::vector<std::size_t>& properties, std::size_t limit)
+  : m_size(0),
+    m_i(-1)
+{
+  for(std::size_t i = 0; i < properties.size(); ++i)
+    m_columns.push_back(new ColumnT(rhs.getPropertyName(properties[i]), rhs.getPropertyDataType(properties[i])));
+
+  copy(rhs, properties, limit);
+}
+
+te::mem::ColumnarDataSet::ColumnarDataSet(const ColumnarDataSet& rhs)
+  : te::da::DataSet(),
+    m_size(rhs.m_size),
+    m_i(-1)
+{
+  for(std::size_t i = 0; i < rhs.m_columns.size(); ++i)
+    m_columns.push_back(new ColumnT(rhs.m_columns[i]));
+}
+
+te::mem::ColumnarDataSet::~ColumnarDataSet()
+{
+}
+
+void te::mem::ColumnarDataSet::clear()
+{
+  for(std::size_t i = 0; i < m_columns.size(); ++i)
+  {
+    ColumnT* c = new ColumnT(m_columns[i].m_name, m_columns[i].m_type);
+
+    m_columns.replace(i, c);
+  }
+
+  m_size = 0;
+  m_i = -1;
+}
+
+void te::mem::ColumnarDataSet::reserve(std::size_t nitems)
+{
+  for(std::size_t i = 0; i < m_columns.size(); ++i)
+    m_columns[i].reserve(nitems);
+}
+
+void te::mem::ColumnarDataSet::copy(te::da::DataSet& src, std::size_t limit)
+{
+  std::vector<std::size_t> properties;
+
+  const std::size_t np = src.getNumProperties();
+
+  for(std::size_t i = 0; i != np; ++i)
+    properties.push_back(i);
+
+  copy(src, properties, limit);
+}
+
+void te::mem::ColumnarDataSet::copy(te::da::DataSet& src, const std::vector<std::size_t>& properties, std::size_t limit)
+{
+  bool unlimited = true;
+
+  if(limit == 0)
+  {
+    limit = std::numeric_limits<std::size_t>::max();
+  }
+  else
+  {
+    reserve(m_size + limit);
+    unlimited = false;
+  }
+
+  const int current = m_i;
+
+  std::size_t i = 0;
+
+  while((i < limit) && src.moveNext())
+  {
+    addItem();
+
+    copyItem(src, properties);
+
+    ++i;
+  }
+
+  m_i = current;
+
+  if(!unlimited && (i < limit))
+    throw Exception(TE_TR("The source dataset has few items than requested copy limit!"));
+}
+
+void te::mem::ColumnarDataSet::addItem()
+{
+  for(std::size_t i = 0; i < m_columns.size(); ++i)
+    m_columns[i].push();
+
+  m_i = static_cast<int>(m_size);
+
+  ++m_size;
+}
+
+void te::mem::ColumnarDataSet::remove()
+{
+  for(std::size_t i = 0; i < m_columns.size(); ++i)
+    m_columns[i].erase(m_i);
+
+  --m_size;
+}
+
+void te::mem::ColumnarDataSet::add(const std::string& propertyName, std::size_t propertyType, const te::dt::AbstractData* defaultValue)
+{
+  m_columns.push_back(new ColumnT(propertyName, static_cast<int>(propertyType)));
+
+  ColumnT& c = m_columns.back();
+
+  c.reserve(m_size);
+
+  for(std::size_t i = 0; i < m_size; ++i)
+    c.push();
+
+  if(defaultValue == 0 || m_size == 0)
+    return;
+
+  const int current = m_i;
+
+  const std::size_t pos = m_columns.size() - 1;
+
+  for(std::size_t i = 0; i < m_size; ++i)
+  {
+    m_i = static_cast<int>(i);
+    setValue(pos, defaultValue->clone());
+  }
+
+  m_i = current;
+}
+
+void te::mem::ColumnarDataSet::drop(std::size_t pos)
+{
+  m_columns.erase(m_columns.begin() + pos);
+}
+
+void te::mem::ColumnarDataSet::compact()
+{
+  for(std::size_t i = 0; i < m_columns.size(); ++i)
+  {
+    if(m_columns[i].m_storage == VARIABLE_STORAGE)
+      m_columns[i].compact();
+  }
+}
+
+const std::vector<bool>& te::mem::ColumnarDataSet::getNulls(std::size_t pos) const
+{
+  return m_columns[pos].m_nulls;
+}
+
+std::size_t te::mem::ColumnarDataSet::getNumNulls(std::size_t pos) const
+{
+  return m_columns[pos].m_nnulls;
+}
+
+const char* te::mem::ColumnarDataSet::getCharColumn(std::size_t pos) const
+{
+  const ColumnT& c = getColumn(pos, FIXED_STORAGE);
+
+  if(c.m_type != te::dt::CHAR_TYPE)
+    throw Exception(TE_TR("The property is not a char one!"));
+
+  return c.m_fixed.empty() ? 0 : &c.m_fixed[0];
+}
+
+const unsigned char* te::mem::ColumnarDataSet::getUCharColumn(std::size_t pos) const
+{
+  const ColumnT& c = getColumn(pos, FIXED_STORAGE);
+
+  if(c.m_type != te::dt::UCHAR_TYPE)
+    throw Exception(TE_TR("The property is not an unsigned char one!"));
+
+  return c.m_fixed.empty() ? 0 : reinterpret_cast<const unsigned char*>(&c.m_fixed[0]);
+}
+
+const boost::int16_t* te::mem::ColumnarDataSet::getInt16Column(std::size_t pos) const
+{
+  const ColumnT& c = getColumn(pos, FIXED_STORAGE);
+
+  if(c.m_type != te::dt::INT16_TYPE && c.m_type != te::dt::UINT16_TYPE)
+    throw Exception(TE_TR("The property is not a 16 bits integer one!"));
+
+  return c.m_fixed.empty() ? 0 : reinterpret_cast<const boost::int16_t*>(&c.m_fixed[0]);
+}
+
+const boost::int32_t* te::mem::ColumnarDataSet::getInt32Column(std::size_t pos) const
+{
+  const ColumnT& c = getColumn(pos, FIXED_STORAGE);
+
+  if(c.m_type != te::dt::INT32_TYPE && c.m_type != te::dt::UINT32_TYPE)
+    throw Exception(TE_TR("The property is not a 32 bits integer one!"));
+
+  return c.m_fixed.empty() ? 0 : reinterpret_cast<const boost::int32_t*>(&c.m_fixed[0]);
+}
+
+const boost::int64_t* te::mem::ColumnarDataSet::getInt64Column(std::size_t pos) const
+{
+  const ColumnT& c = getColumn(pos, FIXED_STORAGE);
+
+  if(c.m_type != te::dt::INT64_TYPE && c.m_type != te::dt::UINT64_TYPE)
+    throw Exception(TE_TR("The property is not a 64 bits integer one!"));
+
+  return c.m_fixed.empty() ? 0 : reinterpret_cast<const boost::int64_t*>(&c.m_fixed[0]);
+}
+
+const bool* te::mem::ColumnarDataSet::getBoolColumn(std::size_t pos) const
+{
+  const ColumnT& c = getColumn(pos, FIXED_STORAGE);
+
+  if(c.m_type != te::dt::BOOLEAN_TYPE)
+    throw Exception(TE_TR("The property is not a boolean one!"));
+
+  return c.m_fixed.empty() ? 0 : reinterpret_cast<const bool*>(&c.m_fixed[0]);
+}
+
+const float* te::mem::ColumnarDataSet::getFloatColumn(std::size_t pos) const
+{
+  const ColumnT& c = getColumn(pos, FIXED_STORAGE);
+
+  if(c.m_type != te::dt::FLOAT_TYPE)
+    throw Exception(TE_TR("The property is not a float one!"));
+
+  return c.m_fixed.empty() ? 0 : reinterpret_cast<const float*>(&c.m_fixed[0]);
+}
+
+const double* te::mem::ColumnarDataSet::getDoubleColumn(std::size_t pos) const
+{
+  const ColumnT& c = getColumn(pos, FIXED_STORAGE);
+
+  if(c.m_type != te::dt::DOUBLE_TYPE)
+    throw Exception(TE_TR("The property is not a double one!"));
+
+  return c.m_fixed.empty() ? 0 : reinterpret_cast<const double*>(&c.m_fixed[0]);
+}
+
+const char* te::mem::ColumnarDataSet::getBytes(std::size_t pos, std::size_t item, std::size_t& size) const
+{
+  const ColumnT& c = getColumn(pos, VARIABLE_STORAGE);
+
+  size = 0;
+
+  if(c.m_nulls[item])
+    return 0;
+
+  size = c.m_lengths[item];
+
+  return c.m_arena.empty() ? 0 : &c.m_arena[c.m_offsets[item]];
+}
+
+const std::vector<te::gm::Envelope>& te::mem::ColumnarDataSet::getEnvelopes(std::size_t pos) const
+{
+  const ColumnT& c = m_columns[pos];
+
+  if(c.m_type != te::dt::GEOMETRY_TYPE)
+    throw Exception(TE_TR("The property is not a geometry one!"));
+
+  return c.m_mbrs;
+}
+
+void te::mem::ColumnarDataSet::getDoubleValues(std::size_t pos, std::vector<double>& values) const
+{
+  const ColumnT& c = m_columns[pos];
+
+  values.reserve(values.size() + m_size - c.m_nnulls);
+
+  if(c.m_storage == FIXED_STORAGE)
+  {
+    if(c.m_type == te::dt::DOUBLE_TYPE)
+    {
+      for(std::size_t i = 0; i < m_size; ++i)
+      {
+        if(!c.m_nulls[i])
+          values.push_back(ReadAs<double, double>(&c.m_fixed[i * 8]));
+      }
+    }
+    else
+    {
+      for(std::size_t i = 0; i < m_size; ++i)
+      {
+        if(!c.m_nulls[i])
+          values.push_back(FixedValue<double>(c.m_type, &c.m_fixed[i * c.m_width]));
+      }
+    }
+
+    return;
+  }
+
+  if(c.m_type != te::dt::NUMERIC_TYPE)
+    throw Exception(TE_TR("The property is not a numeric one!"));
+
+  for(std::size_t i = 0; i < m_size; ++i)
+  {
+    if(!c.m_nulls[i])
+      values.push_back(boost::lexical_cast<double>(std::string(&c.m_arena[c.m_offsets[i]], c.m_lengths[i])));
+  }
+}
+
+void te::mem::ColumnarDataSet::getStringValues(std::size_t pos, std::vector<std::string>& values) const
+{
+  const ColumnT& c = m_columns[pos];
+
+  values.reserve(values.size() + m_size - c.m_nnulls);
+
+  if(c.m_type == te::dt::STRING_TYPE || c.m_type == te::dt::NUMERIC_TYPE)
+  {
+    for(std::size_t i = 0; i < m_size; ++i)
+    {
+      if(c.m_nulls[i])
+        continue;
+
+      if(c.m_lengths[i] == 0)
+        values.push_back(std::string());
+      else
+        values.push_back(std::string(&c.m_arena[c.m_offsets[i]], c.m_lengths[i]));
+    }
+
+    return;
+  }
+
+  // the other types are converted as the te::da::DataSet::getAsString does
+  ColumnarDataSet* self = const_cast<ColumnarDataSet*>(this);
+
+  const int current = m_i;
+
+  for(std::size_t i = 0; i < m_size; ++i)
+  {
+    if(c.m_nulls[i])
+      continue;
+
+    self->m_i = static_cast<int>(i);
+
+    values.push_back(getAsString(pos));
+  }
+
+  self->m_i = current;
+}
+
+te::common::TraverseType te::mem::ColumnarDataSet::getTraverseType() const
+{
+  return te::common::RANDOM;
+}
+
+te::common::AccessPolicy te::mem::ColumnarDataSet::getAccessPolicy() const
+{
+  return te::common::RWAccess;
+}
+
+std::size_t te::mem::ColumnarDataSet::getNumProperties() const
+{
+  return m_columns.size();
+}
+
+int te::mem::ColumnarDataSet::getPropertyDataType(std::size_t pos) const
+{
+  return m_columns[pos].m_type;
+}
+
+std::string te::mem::ColumnarDataSet::getPropertyName(std::size_t pos) const
+{
+  return m_columns[pos].m_name;
+}
+
+std::string te::mem::ColumnarDataSet::getDatasetNameOfProperty(std::size_t /*pos*/) const
+{
+  throw Exception(TE_TR("Not implemented yet!"));
+}
+
+bool te::mem::ColumnarDataSet::isEmpty() const
+{
+  return m_size == 0;
+}
+
+bool te::mem::ColumnarDataSet::isConnected() const
+{
+  return false;
+}
+
+std::size_t te::mem::ColumnarDataSet::size() const
+{
+  return m_size;
+}
+
+std::auto_ptr<te::gm::Envelope> te::mem::ColumnarDataSet::getExtent(std::size_t i)
+{
+  const std::vector<te::gm::Envelope>& mbrs = getEnvelopes(i);
+
+  std::auto_ptr<te::gm::Envelope> mbr(new te::gm::Envelope);
+
+  const std::vector<bool>& nulls = m_columns[i].m_nulls;
+
+  for(std::size_t ii = 0; ii < m_size; ++ii)
+  {
+    if(!nulls[ii])
+      mbr->Union(mbrs[ii]);
+  }
+
+  return mbr;
+}
+
+bool te::mem::ColumnarDataSet::moveNext()
+{
+  ++m_i;
+  return m_i < static_cast<int>(m_size);
+}
+
+bool te::mem::ColumnarDataSet::movePrevious()
+{
+  --m_i;
+  return m_i >= 0;
+}
+
+bool te::mem::ColumnarDataSet::moveBeforeFirst()
+{
+  m_i = -1;
+  return true;
+}
+
+bool te::mem::ColumnarDataSet::moveFirst()
+{
+  m_i = 0;
+  return m_size != 0;
+}
+
+bool te::mem::ColumnarDataSet::moveLast()
+{
+  m_i = static_cast<int>(m_size) - 1;
+  return m_size != 0;
+}
+
+bool te::mem::ColumnarDataSet::move(std::size_t i)
+{
+  m_i = static_cast<int>(i);
+  return i < m_size;
+}
+
+bool te::mem::ColumnarDataSet::isAtBegin() const
+{
+  return m_i == 0;
+}
+
+bool te::mem::ColumnarDataSet::isBeforeBegin() const
+{
+  return m_i < 0;
+}
+
+bool te::mem::ColumnarDataSet::isAtEnd() const
+{
+  return m_i == (static_cast<int>(m_size) - 1);
+}
+
+bool te::mem::ColumnarDataSet::isAfterEnd() const
+{
+  return m_i >= static_cast<int>(m_size);
+}
+
+char te::mem::ColumnarDataSet::getChar(std::size_t i) const
+{
+  return getNumber<char>(i);
+}
+
+unsigned char te::mem::ColumnarDataSet::getUChar(std::size_t i) const
+{
+  return getNumber<unsigned char>(i);
+}
+
+boost::int16_t te::mem::ColumnarDataSet::getInt16(std::size_t i) const
+{
+  return getNumber<boost::int16_t>(i);
+}
+
+boost::int32_t te::mem::ColumnarDataSet::getInt32(std::size_t i) const
+{
+  return getNumber<boost::int32_t>(i);
+}
+
+boost::int64_t te::mem::ColumnarDataSet::getInt64(std::size_t i) const
+{
+  return getNumber<boost::int64_t>(i);
+}
+
+bool te::mem::ColumnarDataSet::getBool(std::size_t i) const
+{
+  return getNumber<bool>(i);
+}
+
+float te::mem::ColumnarDataSet::getFloat(std::size_t i) const
+{
+  return getNumber<float>(i);
+}
+
+double te::mem::ColumnarDataSet::getDouble(std::size_t i) const
+{
+  return getNumber<double>(i);
+}
+
+std::string te::mem::ColumnarDataSet::getNumeric(std::size_t i) const
+{
+  return getString(i);
+}
+
+std::string te::mem::ColumnarDataSet::getString(std::size_t i) const
+{
+  const ColumnT& c = m_columns[i];
+
+  if(c.m_storage != VARIABLE_STORAGE || c.m_type == te::dt::GEOMETRY_TYPE)
+    return getAsString(i);
+
+  if(c.m_nulls[m_i] || c.m_lengths[m_i] == 0)
+    return std::string();
+
+  return std::string(&c.m_arena[c.m_offsets[m_i]], c.m_lengths[m_i]);
+}
+
+std::auto_ptr<te::dt::ByteArray> te::mem::ColumnarDataSet::getByteArray(std::size_t i) const
+{
+  std::size_t size = 0;
+
+  const char* data = getBytes(i, m_i, size);
+
+  if(data == 0)
+    return std::auto_ptr<te::dt::ByteArray>(0);
+
+  std::auto_ptr<te::dt::ByteArray> value(new te::dt::ByteArray(size));
+
+  value->copy(const_cast<char*>(data), size);
+
+  return value;
+}
+
+std::auto_ptr<te::gm::Geometry> te::mem::ColumnarDataSet::getGeometry(std::size_t i) const
+{
+  const ColumnT& c = getColumn(i, VARIABLE_STORAGE);
+
+  if(c.m_type != te::dt::GEOMETRY_TYPE)
+    throw Exception(TE_TR("The property is not a geometry one!"));
+
+  if(c.m_nulls[m_i])
+    return std::auto_ptr<te::gm::Geometry>(0);
+
+  std::auto_ptr<te::gm::Geometry> geom(te::gm::WKBReader::read(&c.m_arena[c.m_offsets[m_i]]));
+
+  geom->setSRID(c.m_srids[m_i]);
+
+  return geom;
+}
+
+std::auto_ptr<te::rst::Raster> te::mem::ColumnarDataSet::getRaster(std::size_t i) const
+{
+  const ColumnT& c = getColumn(i, OBJECT_STORAGE);
+
+  if(c.m_nulls[m_i])
+    return std::auto_ptr<te::rst::Raster>(0);
+
+  return std::auto_ptr<te::rst::Raster>(static_cast<te::rst::Raster*>(c.m_objects[m_i]->clone()));
+}
+
+std::auto_ptr<te::dt::DateTime> te::mem::ColumnarDataSet::getDateTime(std::size_t i) const
+{
+  const ColumnT& c = getColumn(i, OBJECT_STORAGE);
+
+  if(c.m_nulls[m_i])
+    return std::auto_ptr<te::dt::DateTime>(0);
+
+  return std::auto_ptr<te::dt::DateTime>(static_cast<te::dt::DateTime*>(c.m_objects[m_i]->clone()));
+}
+
+std::auto_ptr<te::dt::Array> te::mem::ColumnarDataSet::getArray(std::size_t i) const
+{
+  const ColumnT& c = getColumn(i, OBJECT_STORAGE);
+
+  if(c.m_nulls[m_i])
+    return std::auto_ptr<te::dt::Array>(0);
+
+  return std::auto_ptr<te::dt::Array>(static_cast<te::dt::Array*>(c.m_objects[m_i]->clone()));
+}
+
+std::auto_ptr<te::dt::AbstractData> te::mem::ColumnarDataSet::getValue(std::size_t i) const
+{
+  const ColumnT& c = m_columns[i];
+
+  if(c.m_nulls[m_i])
+    return std::auto_ptr<te::dt::AbstractData>(0);
+
+  if(c.m_storage == OBJECT_STORAGE)
+    return std::auto_ptr<te::dt::AbstractData>(c.m_objects[m_i]->clone());
+
+  return te::da::DataSet::getValue(i);
+}
+
+bool te::mem::ColumnarDataSet::isNull(std::size_t i) const
+{
+  return m_columns[i].m_nulls[m_i];
+}
+
+void te::mem::ColumnarDataSet::setNull(std::size_t i)
+{
+  m_columns[i].setNull(m_i);
+}
+
+void te::mem::ColumnarDataSet::setChar(std::size_t i, char value)
+{
+  setNumber(i, value);
+}
+
+void te::mem::ColumnarDataSet::setUChar(std::size_t i, unsigned char value)
+{
+  setNumber(i, value);
+}
+
+void te::mem::ColumnarDataSet::setInt16(std::size_t i, boost::int16_t value)
+{
+  setNumber(i, value);
+}
+
+void te::mem::ColumnarDataSet::setInt32(std::size_t i, boost::int32_t value)
+{
+  setNumber(i, value);
+}
+
+void te::mem::ColumnarDataSet::setInt64(std::size_t i, boost::int64_t value)
+{
+  setNumber(i, value);
+}
+
+void te::mem::ColumnarDataSet::setBool(std::size_t i, bool value)
+{
+  setNumber(i, value);
+}
+
+void te::mem::ColumnarDataSet::setFloat(std::size_t i, float value)
+{
+  setNumber(i, value);
+}
+
+void te::mem::ColumnarDataSet::setDouble(std::size_t i, double value)
+{
+  setNumber(i, value);
+}
+
+void te::mem::ColumnarDataSet::setNumeric(std::size_t i, const std::string& value)
+{
+  setString(i, value);
+}
+
+void te::mem::ColumnarDataSet::setString(std::size_t i, const std::string& value)
+{
+  ColumnT& c = m_columns[i];
+
+  if(c.m_storage == FIXED_STORAGE)
+  {
+    setNumber(i, boost::lexical_cast<double>(value));
+    return;
+  }
+
+  if(c.m_type != te::dt::STRING_TYPE && c.m_type != te::dt::NUMERIC_TYPE)
+    throw Exception(TE_TR("The property is not a string one!"));
+
+  c.setBytes(m_i, value.data(), value.size());
+}
+
+void te::mem::ColumnarDataSet::setByteArray(std::size_t i, te::dt::ByteArray* value)
+{
+  std::auto_ptr<te::dt::ByteArray> v(value);
+
+  ColumnT& c = m_columns[i];
+
+  if(c.m_type != te::dt::BYTE_ARRAY_TYPE)
+    throw Exception(TE_TR("The property is not a byte array one!"));
+
+  if(value == 0)
+    c.setNull(m_i);
+  else
+    c.setBytes(m_i, value->getData(), value->bytesUsed());
+}
+
+void te::mem::ColumnarDataSet::setGeometry(std::size_t i, te::gm::Geometry* value)
+{
+  std::auto_ptr<te::gm::Geometry> geom(value);
+
+  ColumnT& c = m_columns[i];
+
+  if(c.m_type != te::dt::GEOMETRY_TYPE)
+    throw Exception(TE_TR("The property is not a geometry one!"));
+
+  if(value == 0)
+  {
+    c.setNull(m_i);
+    return;
+  }
+
+  std::vector<char> wkb(value->getWkbSize());
+
+  value->getWkb(&wkb[0], te::common::Globals::sm_machineByteOrder);
+
+  c.setBytes(m_i, &wkb[0], wkb.size());
+
+  c.m_mbrs[m_i] = *value->getMBR();
+  c.m_srids[m_i] = value->getSRID();
+}
+
+void te::mem::ColumnarDataSet::setRaster(std::size_t i, te::rst::Raster* value)
+{
+  setValue(i, value);
+}
+
+void te::mem::ColumnarDataSet::setDateTime(std::size_t i, te::dt::DateTime* value)
+{
+  setValue(i, value);
+}
+
+void te::mem::ColumnarDataSet::setValue(std::size_t i, te::dt::AbstractData* value)
+{
+  ColumnT& c = m_columns[i];
+
+  if(value == 0)
+  {
+    c.setNull(m_i);
+    return;
+  }
+
+  if(c.m_storage == OBJECT_STORAGE)
+  {
+    c.setObject(m_i, value);
+    return;
+  }
+
+  if(c.m_type == te::dt::GEOMETRY_TYPE)
+  {
+    setGeometry(i, static_cast<te::gm::Geometry*>(value));
+    return;
+  }
+
+  if(c.m_type == te::dt::BYTE_ARRAY_TYPE)
+  {
+    setByteArray(i, static_cast<te::dt::ByteArray*>(value));
+    return;
+  }
+
+  std::auto_ptr<te::dt::AbstractData> v(value);
+
+  switch(value->getTypeCode())
+  {
+    case te::dt::CHAR_TYPE:
+      setNumber(i, static_cast<te::dt::Char*>(value)->getValue());
+    break;
+
+    case te::dt::UCHAR_TYPE:
+      setNumber(i, static_cast<te::dt::UChar*>(value)->getValue());
+    break;
+
+    case te::dt::INT16_TYPE:
+      setNumber(i, static_cast<te::dt::Int16*>(value)->getValue());
+    break;
+
+    case te::dt::UINT16_TYPE:
+      setNumber(i, static_cast<te::dt::UInt16*>(value)->getValue());
+    break;
+
+    case te::dt::INT32_TYPE:
+      setNumber(i, static_cast<te::dt::Int32*>(value)->getValue());
+    break;
+
+    case te::dt::UINT32_TYPE:
+      setNumber(i, static_cast<te::dt::UInt32*>(value)->getValue());
+    break;
+
+    case te::dt::INT64_TYPE:
+      setNumber(i, static_cast<te::dt::Int64*>(value)->getValue());
+    break;
+
+    case te::dt::UINT64_TYPE:
+      setNumber(i, static_cast<te::dt::UInt64*>(value)->getValue());
+    break;
+
+    case te::dt::BOOLEAN_TYPE:
+      setNumber(i, static_cast<te::dt::Boolean*>(value)->getValue());
+    break;
+
+    case te::dt::FLOAT_TYPE:
+      setNumber(i, static_cast<te::dt::Float*>(value)->getValue());
+    break;
+
+    case te::dt::DOUBLE_TYPE:
+      setNumber(i, static_cast<te::dt::Double*>(value)->getValue());
+    break;
+
+    default:
+      setString(i, value->toString());
+  }
+}
+
+const te::mem::ColumnarDataSet::ColumnT& te::mem::ColumnarDataSet::getColumn(std::size_t pos, StorageType storage) const
+{
+  const ColumnT& c = m_columns[pos];
+
+  if(c.m_storage != storage)
+    throw Exception(TE_TR("The property type does not match the requested value type!"));
+
+  return c;
+}
+
+template<class T> T te::mem::ColumnarDataSet::getNumber(std::size_t i) const
+{
+  const ColumnT& c = m_columns[i];
+
+  if(c.m_storage == FIXED_STORAGE)
+    return FixedValue<T>(c.m_type, &c.m_fixed[m_i * c.m_width]);
+
+  if(c.m_type == te::dt::NUMERIC_TYPE || c.m_type == te::dt::STRING_TYPE)
+    return static_cast<T>(boost::lexical_cast<double>(getString(i)));
+
+  throw Exception(TE_TR("The property type does not match the requested value type!"));
+}
+
+template<class T> void te::mem::ColumnarDataSet::setNumber(std::size_t i, T value)
+{
+  ColumnT& c = m_columns[i];
+
+  if(c.m_storage != FIXED_STORAGE)
+  {
+    if(c.m_type != te::dt::NUMERIC_TYPE && c.m_type != te::dt::STRING_TYPE)
+      throw Exception(TE_TR("The property type does not match the given value type!"));
+
+    std::string s = boost::lexical_cast<std::string>(value);
+
+    c.setBytes(m_i, s.data(), s.size());
+
+    return;
+  }
+
+  SetFixedValue(c.m_type, &c.m_fixed[m_i * c.m_width], value);
+
+  if(c.m_nulls[m_i])
+  {
+    c.m_nulls[m_i] = false;
+    --c.m_nnulls;
+  }
+}
+
+void te::mem::ColumnarDataSet::copyItem(te::da::DataSet& src, const std::vector<std::size_t>& properties)
+{
+  const std::size_t nproperties = properties.size();
+
+  for(std::size_t c = 0; c < nproperties; ++c)
+  {
+    const std::size_t p = properties[c];
+
+    if(src.isNull(p))
+      continue;
+
+    switch(m_columns[c].m_type)
+    {
+      case te::dt::CHAR_TYPE:
+        setChar(c, src.getChar(p));
+      break;
+
+      case te::dt::UCHAR_TYPE:
+        setUChar(c, src.getUChar(p));
+      break;
+
+      case te::dt::INT16_TYPE:
+      case te::dt::UINT16_TYPE:
+        setInt16(c, src.getInt16(p));
+      break;
+
+      case te::dt::INT32_TYPE:
+      case te::dt::UINT32_TYPE:
+        setInt32(c, src.getInt32(p));
+      break;
+
+      case te::dt::INT64_TYPE:
+      case te::dt::UINT64_TYPE:
+        setInt64(c, src.getInt64(p));
+      break;
+
+      case te::dt::BOOLEAN_TYPE:
+        setBool(c, src.getBool(p));
+      break;
+
+      case te::dt::FLOAT_TYPE:
+        setFloat(c, src.getFloat(p));
+      break;
+
+      case te::dt::DOUBLE_TYPE:
+        setDouble(c, src.getDouble(p));
+      break;
+
+      case te::dt::NUMERIC_TYPE:
+        setNumeric(c, src.getNumeric(p));
+      break;
+
+      case te::dt::STRING_TYPE:
+        setString(c, src.getString(p));
+      break;
+
+      case te::dt::BYTE_ARRAY_TYPE:
+        setByteArray(c, src.getByteArray(p).release());
+      break;
+
+      case te::dt::GEOMETRY_TYPE:
+        setGeometry(c, src.getGeometry(p).release());
+      break;
+
+      default:
+        setValue(c, src.getValue(p).release());
+    }
+  }
+}
@@ -0,0 +1,437 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/memory/ColumnarDataSet.h
+
+  \brief A random-access dataset stored by columns for the TerraLib In-Memory Data Access driver.
+*/
+
+#ifndef __TERRALIB_MEMORY_INTERNAL_COLUMNARDATASET_H
+#define __TERRALIB_MEMORY_INTERNAL_COLUMNARDATASET_H
+
+// TerraLib
+#include "../dataaccess/dataset/DataSet.h"
+#include "../geometry/Envelope.h"
+#include "Config.h"
+
+// STL
+#include <memory>
+#include <string>
+#include <vector>
+
+// Boost
+#include <boost/ptr_container/ptr_vector.hpp>
+
+namespace te
+{
+  namespace da
+  {
+    class DataSetType;
+  }
+
+  namespace mem
+  {
+    /*!
+      \class ColumnarDataSet
+
+      \brief A random-access dataset stored by columns for the TerraLib In-Memory Data Access driver.
+
+      \details It is an alternative to te::mem::DataSet for large tables. Instead of one object
+               per value, each property is kept in a column made of:
+               <ul>
+               <li>a contiguous array of values, for the fixed size types (numbers, chars and booleans);</li>
+               <li>a byte arena with the offset and length of each value, for strings, numerics,
+                   byte arrays and geometries (kept as WKB, with their MBR and SRID);</li>
+               <li>a list of owned objects, for the remaining types (date and time, arrays, rasters);</li>
+               <li>a null bitmap.</li>
+               </ul>
+               Besides the te::da::DataSet interface, the columns can be read in bulk, without
+               moving the dataset cursor.
+
+      \note Updating a variable size value appends it to the arena; call compact() to release the old values.
+
+      \sa te::mem::DataSet
+    */
+    class TEMEMORYEXPORT ColumnarDataSet : public te::da::DataSet
+    {
+      public:
+
+        /*!
+          \brief It constructs an empty dataset having the schema of the given dataset type.
+
+          \param dt The dataset type. It is used only to get the properties names and types.
+        */
+        explicit ColumnarDataSet(const te::da::DataSetType* const dt);
+
+        /*!
+          \brief It constructs a new dataset from the given dataset, copying all its items.
+
+          \param rhs The source dataset. It will be traversed from its current position.
+        */
+        explicit ColumnarDataSet(te::da::DataSet& rhs);
+
+        /*!
+          \brief It constructs a new dataset from some properties of the given dataset.
+
+          \param rhs        The source dataset. It will be traversed from its current position.
+          \param properties The positions of the properties to be copied.
+          \param limit      The number of items to be copied. Use 0 to copy all items.
+        */
+        ColumnarDataSet(te::da::DataSet& rhs, const std::vector<std::size_t>& properties, std::size_t limit = 0);
+
+        /*! \brief Copy constructor: the columns are deep copied. */
+        ColumnarDataSet(const ColumnarDataSet& rhs);
+
+        /*! \brief Destructor. */
+        ~ColumnarDataSet();
+
+        /*! \brief It removes all the items, keeping the properties. */
+        void clear();
+
+        /*!
+          \brief It reserves room for a number of items in all columns.
+
+          \param nitems The expected number of items.
+        */
+        void reserve(std::size_t nitems);
+
+        /*!
+          \brief It copies up to limit items from the source dataset.
+
+          \param src   The source dataset with the same properties. It will be traversed from its current position.
+          \param limit The number of items to be copied. Use 0 to copy all items.
+
+          \exception Exception It throws an exception if the source has fewer items than the given limit.
+        */
+        void copy(te::da::DataSet& src, std::size_t limit = 0);
+
+        /*!
+          \brief It copies up to limit items from the source dataset, taking only the given properties.
+
+          \param src        The source dataset. It will be traversed from its current position.
+          \param properties The positions of the source properties, in the order of this dataset ones.
+          \param limit      The number of items to be copied. Use 0 to copy all items.
+
+          \exception Exception It throws an exception if the source has fewer items than the given limit.
+        */
+        void copy(te::da::DataSet& src, const std::vector<std::size_t>& properties, std::size_t limit = 0);
+
+        /*! \brief It adds a new item with all values null and moves the cursor to it. */
+        void addItem();
+
+        /*! \brief It removes the current item. */
+        void remove();
+
+        /*!
+          \brief It adds a new property to the dataset.
+
+          \param propertyName The property name.
+          \param propertyType The property data type.
+          \param defaultValue The value of the existing items (NULL for null values). It is not owned.
+        */
+        void add(const std::string& propertyName, std::size_t propertyType, const te::dt::AbstractData* defaultValue = 0);
+
+        /*!
+          \brief It drops a property from the dataset.
+
+          \param pos The property position.
+        */
+        void drop(std::size_t pos);
+
+        /*! \brief It releases the arena space of the variable size values that were overwritten or removed. */
+        void compact();
+
+        /** @name Bulk column access
+         *  Methods to read a whole column without moving the cursor. The arrays have size() values
+         *  and are valid until the dataset is changed. The values of the null items are undefined.
+         */
+        //@{
+
+        /*!
+          \brief It returns the null bitmap of a property.
+
+          \param pos The property position.
+        */
+        const std::vector<bool>& getNulls(std::size_t pos) const;
+
+        /*!
+          \brief It returns the number of null values of a property.
+
+          \param pos The property position.
+        */
+        std::size_t getNumNulls(std::size_t pos) const;
+
+        const char* getCharColumn(std::size_t pos) const;
+
+        const unsigned char* getUCharColumn(std::size_t pos) const;
+
+        /*! \brief It returns the values of an INT16 or UINT16 property. */
+        const boost::int16_t* getInt16Column(std::size_t pos) const;
+
+        /*! \brief It returns the values of an INT32 or UINT32 property. */
+        const boost::int32_t* getInt32Column(std::size_t pos) const;
+
+        /*! \brief It returns the values of an INT64 or UINT64 property. */
+        const boost::int64_t* getInt64Column(std::size_t pos) const;
+
+        const bool* getBoolColumn(std::size_t pos) const;
+
+        const float* getFloatColumn(std::size_t pos) const;
+
+        const double* getDoubleColumn(std::size_t pos) const;
+
+        /*!
+          \brief It returns the raw bytes of a string, numeric, byte array or geometry (WKB) value.
+
+          \param pos  The property position.
+          \param item The item position.
+          \param size The number of bytes of the value.
+
+          \return A pointer to the value bytes inside the column arena, or NULL if the value is null.
+        */
+        const char* getBytes(std::size_t pos, std::size_t item, std::size_t& size) const;
+
+        /*!
+          \brief It returns the MBR of each geometry of a property (invalid envelopes for the null ones).
+
+          \param pos The property position.
+        */
+        const std::vector<te::gm::Envelope>& getEnvelopes(std::size_t pos) const;
+
+        /*!
+          \brief It appends the non-null values of a numeric property converted to double.
+
+          \param pos    The property position.
+          \param values The output values, in the items order.
+
+          \exception Exception It throws an exception if the property is not numeric.
+        */
+        void getDoubleValues(std::size_t pos, std::vector<double>& values) const;
+
+        /*!
+          \brief It appends the non-null values of a property converted to string.
+
+          \param pos    The property position.
+          \param values The output values, in the items order.
+        */
+        void getStringValues(std::size_t pos, std::vector<std::string>& values) const;
+
+        //@}
+
+        te::common::TraverseType getTraverseType() const;
+
+        te::common::AccessPolicy getAccessPolicy() const;
+
+        std::size_t getNumProperties() const;
+
+        int getPropertyDataType(std::size_t pos) const;
+
+        std::string getPropertyName(std::size_t pos) const;
+
+        std::string getDatasetNameOfProperty(std::size_t pos) const;
+
+        bool isEmpty() const;
+
+        bool isConnected() const;
+
+        std::size_t size() const;
+
+        std::auto_ptr<te::gm::Envelope> getExtent(std::size_t i);
+
+        bool moveNext();
+
+        bool movePrevious();
+
+        bool moveBeforeFirst();
+
+        bool moveFirst();
+
+        bool moveLast();
+
+        bool move(std::size_t i);
+
+        bool isAtBegin() const;
+
+        bool isBeforeBegin() const;
+
+        bool isAtEnd() const;
+
+        bool isAfterEnd() const;
+
+        char getChar(std::size_t i) const;
+
+        unsigned char getUChar(std::size_t i) const;
+
+        boost::int16_t getInt16(std::size_t i) const;
+
+        boost::int32_t getInt32(std::size_t i) const;
+
+        boost::int64_t getInt64(std::size_t i) const;
+
+        bool getBool(std::size_t i) const;
+
+        float getFloat(std::size_t i) const;
+
+        double getDouble(std::size_t i) const;
+
+        std::string getNumeric(std::size_t i) const;
+
+        std::string getString(std::size_t i) const;
+
+        std::auto_ptr<te::dt::ByteArray> getByteArray(std::size_t i) const;
+
+        std::auto_ptr<te::gm::Geometry> getGeometry(std::size_t i) const;
+
+        std::auto_ptr<te::rst::Raster> getRaster(std::size_t i) const;
+
+        std::auto_ptr<te::dt::DateTime> getDateTime(std::size_t i) const;
+
+        std::auto_ptr<te::dt::Array> getArray(std::size_t i) const;
+
+        std::auto_ptr<te::dt::AbstractData> getValue(std::size_t i) const;
+
+        bool isNull(std::size_t i) const;
+
+        void setNull(std::size_t i);
+
+        void setChar(std::size_t i, char value);
+
+        void setUChar(std::size_t i, unsigned char value);
+
+        void setInt16(std::size_t i, boost::int16_t value);
+
+        void setInt32(std::size_t i, boost::int32_t value);
+
+        void setInt64(std::size_t i, boost::int64_t value);
+
+        void setBool(std::size_t i, bool value);
+
+        void setFloat(std::size_t i, float value);
+
+        void setDouble(std::size_t i, double value);
+
+        void setNumeric(std::size_t i, const std::string& value);
+
+        void setString(std::size_t i, const std::string& value);
+
+        /*! \note The value is copied and deleted. */
+        void setByteArray(std::size_t i, te::dt::ByteArray* value);
+
+        /*! \note The geometry is encoded as WKB and deleted. */
+        void setGeometry(std::size_t i, te::gm::Geometry* value);
+
+        /*! \note The dataset takes the ownership of the raster. */
+        void setRaster(std::size_t i, te::rst::Raster* value);
+
+        /*! \note The dataset takes the ownership of the date and time. */
+        void setDateTime(std::size_t i, te::dt::DateTime* value);
+
+        /*! \note The dataset takes the ownership of the value. */
+        void setValue(std::size_t i, te::dt::AbstractData* value);
+
+      protected:
+
+        /*! \brief How the values of a column are stored. */
+        enum StorageType
+        {
+          FIXED_STORAGE,      //!< Contiguous array of fixed size values.
+          VARIABLE_STORAGE,   //!< Byte arena with offset and length of each value.
+          OBJECT_STORAGE      //!< Owned objects.
+        };
+
+        /*! \brief The storage of a property. */
+        class ColumnT
+        {
+          public:
+
+            ColumnT(const std::string& name, int type);
+
+            ColumnT(const ColumnT& rhs);
+
+            ~ColumnT();
+
+            /*! \brief It appends a null value. */
+            void push();
+
+            /*! \brief It removes a value. */
+            void erase(std::size_t item);
+
+            /*! \brief It sets the bytes of a variable size value. */
+            void setBytes(std::size_t item, const char* data, std::size_t size);
+
+            /*! \brief It sets an owned object. */
+            void setObject(std::size_t item, te::dt::AbstractData* value);
+
+            /*! \brief It sets a value as null, releasing its storage when possible. */
+            void setNull(std::size_t item);
+
+            /*! \brief It releases the arena space of the old values. */
+            void compact();
+
+            /*! \brief It reserves room for some values. */
+            void reserve(std::size_t nitems);
+
+            std::string m_name;                               //!< The property name.
+            int m_type;                                       //!< The property data type.
+            StorageType m_storage;                            //!< How the values are stored.
+            std::size_t m_width;                              //!< The size of the fixed size values.
+            std::vector<bool> m_nulls;                        //!< The null bitmap.
+            std::size_t m_nnulls;                             //!< The number of null values.
+            std::vector<char> m_fixed;                        //!< The fixed size values.
+            std::vector<char> m_arena;                        //!< The variable size values bytes.
+            std::vector<std::size_t> m_offsets;               //!< The offset of each variable size value.
+            std::vector<std::size_t> m_lengths;               //!< The length of each variable size value.
+            std::size_t m_garbage;                            //!< The arena bytes no longer referenced.
+            std::vector<te::gm::Envelope> m_mbrs;             //!< The MBR of each geometry.
+            std::vector<int> m_srids;                         //!< The SRID of each geometry.
+            std::vector<te::dt::AbstractData*> m_objects;     //!< The owned objects.
+
+          private:
+
+            ColumnT& operator=(const ColumnT& rhs);
+        };
+
+        /*! \brief It returns the column of a property, checking its storage. */
+        const ColumnT& getColumn(std::size_t pos, StorageType storage) const;
+
+        /*! \brief It returns the current value of a fixed size column converted to the given type. */
+        template<class T> T getNumber(std::size_t i) const;
+
+        /*! \brief It sets the current value of a fixed size column converting the given value. */
+        template<class T> void setNumber(std::size_t i, T value);
+
+        /*! \brief It copies the current item of the source dataset. */
+        void copyItem(te::da::DataSet& src, const std::vector<std::size_t>& properties);
+
+      private:
+
+        ColumnarDataSet& operator=(const ColumnarDataSet& rhs);
+
+      protected:
+
+        boost::ptr_vector<ColumnT> m_columns;   //!< The dataset columns.
+        std::size_t m_size;                     //!< The number of items.
+        int m_i;                                //!< The index of the current item.
+    };
+
+  } // end namespace mem
+}   // end namespace te
+
+#endif  // __TERRALIB_MEMORY_INTERNAL_COLUMNARDATASET_H
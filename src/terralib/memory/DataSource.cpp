@@ -37,6 +37,7 @@
 #include "DataSet.h"
 #include "DataSource.h"
 #include "Exception.h"
+#include "Transactor.h"
 
 // Boost
 #include <boost/algorithm/string/case_conv.hpp>
@@ -91,8 +92,7 @@ std::string te::mem::DataSource::getType() const
 
 std::auto_ptr<te::da::DataSourceTransactor> te::mem::DataSource::getTransactor()
 {
-  //return std::auto_ptr<te::da::DataSourceTransactor>(new te::mem::DataSourceTransactor(this));
-  return std::auto_ptr<te::da::DataSourceTransactor>(0);
+  return std::auto_ptr<te::da::DataSourceTransactor>(new te::mem::Transactor(this));
 }
 
 void te::mem::DataSource::open()
@@ -167,7 +167,10 @@ std::auto_ptr<te::da::DataSet> te::mem::DataSource::getDataSet(const std::string
 
   std::map<std::string, te::da::DataSetPtr>::const_iterator it = m_datasets.find(name);
 
-  return std::auto_ptr<te::da::DataSet>(new DataSet(*(it->second), m_deepCopy));
+  // the stored datasets are memory datasets: their items are shared (or copied) without moving their cursor
+  const te::mem::DataSet* dataset = static_cast<const te::mem::DataSet*>(it->second.get());
+
+  return std::auto_ptr<te::da::DataSet>(new DataSet(*dataset, m_deepCopy));
 }
 
 std::vector<std::string> te::mem::DataSource::getDataSetNames()
@@ -25,14 +25,68 @@
 
 // TerraLib
 #include "../core/translator/Translator.h"
+#include "../dataaccess/dataset/DataSetCapabilities.h"
 #include "../dataaccess/dataset/DataSetType.h"
+#include "../dataaccess/dataset/FilteredDataSet.h"
+#include "../dataaccess/query/BinaryFunction.h"
+#include "../dataaccess/query/DataSetName.h"
+#include "../dataaccess/query/Field.h"
+#include "../dataaccess/query/FilterProgram.h"
+#include "../dataaccess/query/FunctionNames.h"
+#include "../dataaccess/query/LiteralEnvelope.h"
+#include "../dataaccess/query/LiteralGeom.h"
+#include "../dataaccess/query/PropertyName.h"
+#include "../dataaccess/query/Select.h"
+#include "../dataaccess/query/Where.h"
 #include "../geometry/Envelope.h"
+#include "../geometry/Geometry.h"
+#include "../srs/Config.h"
 #include "DataSet.h"
 #include "DataSource.h"
 #include "Transactor.h"
 #include "Exception.h"
 
 
+namespace te
+{
+  namespace mem
+  {
+    /*! \brief It returns the name of the function that evaluates a spatial relation. */
+    const std::string& GetSpatialRelationName(te::gm::SpatialRelation r)
+    {
+      switch(r)
+      {
+        case te::gm::INTERSECTS: return te::da::FunctionNames::sm_ST_Intersects;
+        case te::gm::DISJOINT: return te::da::FunctionNames::sm_ST_Disjoint;
+        case te::gm::TOUCHES: return te::da::FunctionNames::sm_ST_Touches;
+        case te::gm::OVERLAPS: return te::da::FunctionNames::sm_ST_Overlaps;
+        case te::gm::CROSSES: return te::da::FunctionNames::sm_ST_Crosses;
+        case te::gm::WITHIN: return te::da::FunctionNames::sm_ST_Within;
+        case te::gm::CONTAINS: return te::da::FunctionNames::sm_ST_Contains;
+        case te::gm::EQUALS: return te::da::FunctionNames::sm_ST_Equals;
+        default:
+          throw Exception(TE_TR("The spatial relation is not supported by the Memory Driver!"));
+      }
+    }
+
+    /*! \brief It selects the items of a dataset satisfying a filter expression. */
+    std::auto_ptr<te::da::DataSet> Filter(std::auto_ptr<te::da::DataSet> dataset, const te::da::Expression& e)
+    {
+      te::da::FilterProgram program(e, dataset.get());
+
+      std::vector<std::size_t> positions;
+
+      program.select(dataset.get(), positions);
+
+      // the memory datasets have random access
+      te::da::DataSetCapabilities capabilities;
+      capabilities.setSupportAll();
+
+      return std::auto_ptr<te::da::DataSet>(new te::da::FilteredDataSet(dataset.release(), capabilities, positions, true));
+    }
+  }
+}
+
 te::mem::Transactor::Transactor(DataSource* ds)
   : m_ds(ds)
 {
@@ -69,7 +123,8 @@ bool te::mem::Transactor::isInTransaction() const
 
 std::auto_ptr<te::da::DataSet> te::mem::Transactor::getDataSet(const std::string& name,
                                                                          te::common::TraverseType travType,
-                                                                         bool /*connected*/) 
+                                                                         bool /*connected*/,
+                                                                         const te::common::AccessPolicy /*accessPolicy*/) 
 {
   return m_ds->getDataSet(name, travType);
 }
@@ -79,9 +134,16 @@ std::auto_ptr<te::da::DataSet> te::mem::Transactor::getDataSet(const std::string
                                                                          const te::gm::Envelope* e,
                                                                          te::gm::SpatialRelation r,
                                                                          te::common::TraverseType travType,
-                                                                         bool /*connected*/)
+                                                                         bool /*connected*/,
+                                                                         const te::common::AccessPolicy /*accessPolicy*/)
 {
-  return std::auto_ptr<te::da::DataSet>(0);
+  if(e == 0)
+    throw Exception(TE_TR("Missing the envelope of the spatial filter!"));
+
+  te::da::BinaryFunction filter(GetSpatialRelationName(r), new te::da::PropertyName(propertyName),
+                                new te::da::LiteralEnvelope(*e, TE_UNKNOWN_SRS));
+
+  return Filter(m_ds->getDataSet(name, travType), filter);
 }
 
 std::auto_ptr<te::da::DataSet> te::mem::Transactor::getDataSet(const std::string& name,
@@ -89,21 +151,56 @@ std::auto_ptr<te::da::DataSet> te::mem::Transactor::getDataSet(const std::string
                                                                          const te::gm::Geometry* g,
                                                                          te::gm::SpatialRelation r,
                                                                          te::common::TraverseType travType,
-                                                                         bool /*connected*/)
+                                                                         bool /*connected*/,
+                                                                         const te::common::AccessPolicy /*accessPolicy*/)
 {
-  return std::auto_ptr<te::da::DataSet>(0);
+  if(g == 0)
+    throw Exception(TE_TR("Missing the geometry of the spatial filter!"));
+
+  te::da::BinaryFunction filter(GetSpatialRelationName(r), new te::da::PropertyName(propertyName),
+                                new te::da::LiteralGeom(*g));
+
+  return Filter(m_ds->getDataSet(name, travType), filter);
 }
 
 std::auto_ptr<te::da::DataSet> te::mem::Transactor::query(const te::da::Select& q, 
                                                                     te::common::TraverseType travType, 
-                                                                    bool /*connected*/)
+                                                                    bool /*connected*/,
+                                                                    const te::common::AccessPolicy /*accessPolicy*/)
 {
-  return std::auto_ptr<te::da::DataSet>(0);
+// only the queries "SELECT * FROM dataset [WHERE filter]" are supported
+  const te::da::From* from = q.getFrom();
+
+  if(from == 0 || from->size() != 1)
+    return std::auto_ptr<te::da::DataSet>(0);
+
+  const te::da::DataSetName* dsName = dynamic_cast<const te::da::DataSetName*>(&(*from)[0]);
+
+  if(dsName == 0)
+    return std::auto_ptr<te::da::DataSet>(0);
+
+  const te::da::Fields* fields = q.getFields();
+
+  if(fields && !fields->empty())
+  {
+    const te::da::PropertyName* p = dynamic_cast<const te::da::PropertyName*>((*fields)[0].getExpression());
+
+    if(fields->size() != 1 || p == 0 || p->getName() != "*")
+      return std::auto_ptr<te::da::DataSet>(0);
+  }
+
+  std::auto_ptr<te::da::DataSet> dataset = m_ds->getDataSet(dsName->getName(), travType);
+
+  if(q.getWhere() == 0 || q.getWhere()->getExp() == 0)
+    return dataset;
+
+  return Filter(dataset, *q.getWhere()->getExp());
 }
 
 std::auto_ptr<te::da::DataSet> te::mem::Transactor::query(const std::string& q,
                                                                     te::common::TraverseType travType, 
-                                                                    bool /*connected*/)
+                                                                    bool /*connected*/,
+                                                                    const te::common::AccessPolicy /*accessPolicy*/)
 {
   return std::auto_ptr<te::da::DataSet>(0);
 }
@@ -8,6 +8,7 @@
 #include "CalculateGrid.h"
 #include "Utils.h"
 
+#include "../../common/progress/ProgressCounter.h"
 #include "../../common/progress/TaskProgress.h"
 #include "../../raster.h"
 #include "../../raster/BandProperty.h"
@@ -121,13 +122,14 @@ bool te::mnt::CalculateGrid::run()
     double zvalue;
 
     te::common::TaskProgress task("Calculating DTM...", te::common::TaskProgress::UNDEFINED, (int)(outputHeight*outputWidth));
+    te::common::ProgressCounter counter(task);
 
     te::gm::Coord2D pg;
     for (unsigned int l = 0; l < outputHeight; l++)
     {
       for (unsigned int c = 0; c < outputWidth; c++)
       {
-        task.pulse();
+        counter.pulse();
         te::gm::Coord2D pg(rx1 + (c * m_resx /*+ m_resx / 2.*/), ry2 - (l * m_resy/* + m_resy / 2.*/));
         te::gm::PointZ pgz(pg.getX(), pg.getY(), m_nodatavalue);
         m_adaptativeTree->nearestNeighborSearch(pg, points, distneighb, nro_neighb);
@@ -431,6 +431,7 @@ void te::qt::plugins::cellspace::CreateCellularSpaceDialog::onCreatePushButtonCl
   }
 
   std::auto_ptr<te::cellspace::CellularSpacesOperations> cellSpaceOp(new te::cellspace::CellularSpacesOperations());
+  cellSpaceOp->setScanlineMode(true);
 
   te::cellspace::CellularSpacesOperations::CellSpaceType type;
 
@@ -30,6 +30,13 @@
 
 #define TE_QTWIDGETS_DEFAULT_TREEVIEW_IDENTATION 10
 
+/*!
+  \def TE_QTWIDGETS_EXACT_GROUPING_MAX_VALUES
+
+  \brief The numeric groupings of layers with up to this number of values are computed from all the values. Larger layers are grouped from a streaming summary.
+*/
+#define TE_QTWIDGETS_EXACT_GROUPING_MAX_VALUES 100000
+
 /** @name DLL/LIB Module
  *  Flags for building TerraLib as a DLL or as a Static Library
  */
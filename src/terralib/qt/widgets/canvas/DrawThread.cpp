@@ -5,11 +5,12 @@
 #include "../../../common/Exception.h"
 #include "../../../geometry/Envelope.h"
 #include "../../../maptools/AbstractLayer.h"
+#include "../../../maptools/TileRenderCache.h"
 #include "../../../srs/Config.h"
 #include "Canvas.h"
 
 te::qt::widgets::DrawThread::DrawThread(QPaintDevice* dev, te::map::AbstractLayer* layer, te::gm::Envelope* env, const QColor& bckGround, int srid, double scale,
-                                        te::map::AlignType hAlign, te::map::AlignType vAlign):
+                                        te::map::AlignType hAlign, te::map::AlignType vAlign, te::map::TileRenderCache* cache):
 QObject(),
 QRunnable(),
 m_device(dev),
@@ -20,6 +21,7 @@ m_srid(srid),
 m_scale(scale),
 m_hAlign(hAlign),
 m_vAlign(vAlign),
+m_cache(cache),
 m_cancel(false)
 {
   setAutoDelete(false);
@@ -38,7 +40,10 @@ void te::qt::widgets::DrawThread::run()
     Canvas canvas(m_device);
     canvas.clear();
 
-    m_layer->draw(&canvas, *m_envelope, m_srid, m_scale, &m_cancel);
+    if(m_cache != 0)
+      m_cache->draw(m_layer, &canvas, *m_envelope, m_srid, m_scale, &m_cancel);
+    else
+      m_layer->draw(&canvas, *m_envelope, m_srid, m_scale, &m_cancel);
 
     if(!m_cancel)
       m_finished = true;
@@ -47,6 +47,7 @@ namespace te
   namespace map
   {
     class AbstractLayer;
+    class TileRenderCache;
   }
 
   namespace qt
@@ -60,7 +61,7 @@ namespace te
       public:
 
         DrawThread(QPaintDevice* dev, te::map::AbstractLayer* layer, te::gm::Envelope* env, const QColor& bckGround, int srid, double scale, 
-                   te::map::AlignType hAlign, te::map::AlignType vAlign);
+                   te::map::AlignType hAlign, te::map::AlignType vAlign, te::map::TileRenderCache* cache = 0);
 
         ~DrawThread();
 
@@ -94,6 +95,8 @@ namespace te
 
         te::map::AlignType m_vAlign;                        //!< The display vertical align.
 
+        te::map::TileRenderCache* m_cache;                  //!< The tile cache used to draw the layer, or null to draw it directly.
+
       public: 
 
         bool m_cancel;
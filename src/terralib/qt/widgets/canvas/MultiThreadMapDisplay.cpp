@@ -27,6 +27,7 @@
 #include "../../../common/STLUtils.h"
 #include "../../../maptools/Utils.h"
 #include "../../../maptools/AbstractLayer.h"
+#include "../../../maptools/TileRenderCache.h"
 #include "../../../se/Style.h"
 #include "MultiThreadMapDisplay.h"
 #include "Canvas.h"
@@ -55,11 +56,19 @@ void RemoveImage(te::map::AbstractLayer* layer, std::map<std::string, QImage*>&
   RemoveImage(lId, imgs);
 }
 
+// The tiles are rendered outside the GUI thread, so they are drawn on images
+te::map::Canvas* CreateTileCanvas(int w, int h)
+{
+  return new te::qt::widgets::Canvas(w, h, QInternal::Image);
+}
+
 te::qt::widgets::MultiThreadMapDisplay::MultiThreadMapDisplay(const QSize& size, const bool& showFeedback, QWidget* parent, Qt::WindowFlags f)
   : te::qt::widgets::MapDisplay(size, parent, f),
     m_showFeedback(showFeedback),
     m_synchronous(false),
-    m_tmger(0)
+    m_tmger(0),
+    m_tileCache(new te::map::TileRenderCache(CreateTileCanvas)),
+    m_useTileCache(true)
 {
   setAttribute(Qt::WA_OpaquePaintEvent, true);
 }
@@ -68,7 +77,9 @@ te::qt::widgets::MultiThreadMapDisplay::MultiThreadMapDisplay(QWidget* parent, c
 : te::qt::widgets::MapDisplay(parent, f),
 m_showFeedback(showFeedback),
 m_synchronous(false),
-m_tmger(0)
+m_tmger(0),
+m_tileCache(new te::map::TileRenderCache(CreateTileCanvas)),
+m_useTileCache(true)
 {
   setAttribute(Qt::WA_OpaquePaintEvent, true);
 }
@@ -167,7 +178,8 @@ void te::qt::widgets::MultiThreadMapDisplay::refresh(bool redraw)
       QImage* img = new QImage(size(), QImage::Format_ARGB32_Premultiplied);
       imgs[lId] = img;
 
-      DrawThread* thread = new DrawThread(imgs[lId], (*it).get(), &m_extent, m_backgroundColor, m_srid, scale, m_hAlign, m_vAlign);
+      DrawThread* thread = new DrawThread(imgs[lId], (*it).get(), &m_extent, m_backgroundColor, m_srid, scale, m_hAlign, m_vAlign,
+                                          m_useTileCache ? m_tileCache.get() : 0);
       m_threads.push_back(thread);
     }
   }
@@ -216,10 +228,25 @@ void te::qt::widgets::MultiThreadMapDisplay::setSynchronous(bool on)
   m_synchronous = on;
 }
 
+void te::qt::widgets::MultiThreadMapDisplay::setTileCacheEnabled(bool on)
+{
+  m_useTileCache = on;
+
+  if(!on)
+    m_tileCache->clear();
+}
+
+te::map::TileRenderCache* te::qt::widgets::MultiThreadMapDisplay::getTileCache() const
+{
+  return m_tileCache.get();
+}
+
 void te::qt::widgets::MultiThreadMapDisplay::updateLayer(te::map::AbstractLayerPtr layer, bool redraw)
 {
   RemoveImage(layer.get(), m_images);
 
+  m_tileCache->invalidate(layer->getId());
+
   if(redraw)
     refresh();
 }
@@ -229,6 +256,8 @@ void te::qt::widgets::MultiThreadMapDisplay::updateLayer(std::vector<te::map::Ab
   for (std::size_t i = 0; i < layers.size(); ++i)
   {
     RemoveImage(layers[i].get(), m_images);
+
+    m_tileCache->invalidate(layers[i]->getId());
   }
 
   if (redraw)
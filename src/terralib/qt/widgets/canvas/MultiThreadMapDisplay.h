@@ -36,12 +36,15 @@
 #include <QString>
 
 // STL
+#include <memory>
 #include <vector>
 
 class QRunnable;
 
 namespace te
 {
+  namespace map { class TileRenderCache; }
+
   namespace qt
   {
     namespace widgets
@@ -109,6 +112,20 @@ namespace te
 
           void setSynchronous(bool on);
 
+          /*!
+            \brief It enables or disables the tile cache used to draw the layers (enabled by default).
+
+            \param on If true, the layers are drawn in tiles kept between the drawings, so a pan only renders the tiles entering the view.
+          */
+          void setTileCacheEnabled(bool on);
+
+          /*!
+            \brief It returns the tile cache of the map display. It may be given to te::map::DrawLayers to export the displayed layers.
+
+            \return The tile cache of the map display.
+          */
+          te::map::TileRenderCache* getTileCache() const;
+
           void updateLayer(te::map::AbstractLayerPtr layer, bool redraw = true);
 
           void updateLayer(std::vector<te::map::AbstractLayerPtr> layers, bool redraw = true);
@@ -181,6 +198,8 @@ namespace te
           ThreadManager* m_tmger;
           QCursor m_oldCursor;
 //          std::auto_ptr<ScopedCursor> m_cursor;
+          std::auto_ptr<te::map::TileRenderCache> m_tileCache;  //!< The tiles rendered by the previous drawings.
+          bool m_useTileCache;                                  //!< A flag that indicates if the layers are drawn through the tile cache.
       };
     } // end namespace widgets
   }   // end namespace qt
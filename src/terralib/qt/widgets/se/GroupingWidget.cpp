@@ -40,6 +40,8 @@
 #include "../../../maptools/QueryLayer.h"
 #include "../../../se/SymbolizerColorFinder.h"
 #include "../../../se/Utils.h"
+#include "../../../statistics/core/StreamingSummary.h"
+#include "../../../statistics/core/SummaryFunctions.h"
 #include "../colorbar/ColorBar.h"
 #include "../colorbar/ColorCatalogWidget.h"
 #include "../se/LineSymbolizerWidget.h"
@@ -51,6 +53,7 @@
 
 // STL
 #include <cassert>
+#include <cmath>
 
 // QT
 #include <QDialogButtonBox>
@@ -65,7 +68,9 @@ Q_DECLARE_METATYPE(te::map::AbstractLayerPtr);
 te::qt::widgets::GroupingWidget::GroupingWidget(QWidget* parent, Qt::WindowFlags f)
   : QWidget(parent, f),
     m_ui(new Ui::GroupingWidgetForm),
-    m_cb(0)
+    m_cb(0),
+    m_manual(false),
+    m_exact(false)
 {
   m_ui->setupUi(this);
 
@@ -94,6 +99,11 @@ te::qt::widgets::GroupingWidget::~GroupingWidget()
   m_legend.clear();
 }
 
+void te::qt::widgets::GroupingWidget::setExactGrouping(bool exact)
+{
+  m_exact = exact;
+}
+
 std::auto_ptr<te::map::Grouping> te::qt::widgets::GroupingWidget::getGrouping()
 {
   if(m_ui->m_importGroupBox->isChecked())
@@ -449,7 +459,51 @@ void te::qt::widgets::GroupingWidget::onApplyPushButtonClicked()
 
   bool update = false;
 
-  if(type == te::map::EQUAL_STEPS)
+  // the numeric groupings of large layers use a single pass summary of the values, unless an exact grouping was required
+  te::stat::StreamingSummary summary;
+
+  bool summarized = false;
+
+  if(!m_exact && (type == te::map::EQUAL_STEPS || type == te::map::QUANTIL || type == te::map::STD_DEVIATION))
+  {
+    summarized = getDataSummary(summary, attr) &&
+                 (summary.getCount() + summary.getNullCount() > TE_QTWIDGETS_EXACT_GROUPING_MAX_VALUES);
+  }
+
+  if(summarized)
+  {
+    nullValues = static_cast<int>(summary.getNullCount());
+
+    if(summary.getCount() != 0)
+    {
+      if(type == te::map::EQUAL_STEPS)
+      {
+        te::map::GroupingByEqualSteps(summary.getMinimum(), summary.getMaximum(), slices, m_legend, prec);
+      }
+      else if(type == te::map::QUANTIL)
+      {
+        std::vector<double> breaks;
+        summary.getQuantileBreaks(slices, breaks);
+
+        te::map::GroupingByQuantil(breaks, m_legend, prec);
+      }
+      else
+      {
+        // the summary gives the sample deviation, but the grouping has always used the population one
+        const double count = static_cast<double>(summary.getCount());
+
+        te::map::GroupingByStdDeviation(summary.getMinimum(), summary.getMaximum(), summary.getMean(),
+                                        summary.getStdDeviation() * std::sqrt((count - 1.) / count), stdDev, m_legend, mean, prec);
+      }
+
+      setCountBySummary(summary);
+
+      buildSymbolizer(mean);
+
+      createDoubleNullGroupingItem(nullValues);
+    }
+  }
+  else if(type == te::map::EQUAL_STEPS)
   {
     std::vector<double> vec;
 
@@ -916,6 +970,36 @@ void te::qt::widgets::GroupingWidget::getLinkedDataAsDouble(std::vector<double>&
   values.clear();
 }
 
+bool te::qt::widgets::GroupingWidget::getDataSummary(te::stat::StreamingSummary& ss, const std::string& attrName)
+{
+  assert(m_layer.get());
+
+  // the linked values are summarized by object before being grouped
+  if (te::da::HasLinkedTable(m_layer->getSchema().get()) && (m_ui->m_summaryComboBox->currentText().toStdString() != "NONE"))
+    return false;
+
+  std::auto_ptr<te::da::DataSet> ds(m_layer->getData());
+
+  te::stat::GetNumericStreamingSummary(ds.get(), attrName, ss);
+
+  return true;
+}
+
+void te::qt::widgets::GroupingWidget::setCountBySummary(const te::stat::StreamingSummary& ss)
+{
+  for(std::size_t i = 0; i < m_legend.size(); ++i)
+  {
+    te::map::GroupingItem* legendItem = m_legend[i];
+
+    double from = atof(legendItem->getLowerLimit().c_str());
+    double to = atof(legendItem->getUpperLimit().c_str());
+
+    double count = ss.getRank(to) - ss.getRank(from);
+
+    legendItem->setCount(count > 0. ? static_cast<int>(count + .5) : 0);
+  }
+}
+
 void te::qt::widgets::GroupingWidget::getDataAsString(std::vector<std::string>& vec, const std::string& attrName, int& nullValues)
 {
   assert(m_layer.get());
@@ -55,6 +55,8 @@ namespace te
     class GroupingItem;
   }
 
+  namespace stat { class StreamingSummary; }
+
   namespace qt
   {
     namespace widgets
@@ -94,6 +96,14 @@ namespace te
 
           std::auto_ptr<te::map::Grouping> getGrouping();
 
+          /*!
+            \brief It sets if the numeric groupings are computed from all the values in memory.
+
+            \note By default only the layers with up to TE_QTWIDGETS_EXACT_GROUPING_MAX_VALUES values are grouped from all the values;
+                  the breaks and counts of the larger ones are estimated from a streaming summary of the layer data.
+          */
+          void setExactGrouping(bool exact);
+
         protected:
 
           /*! \brief Internal method to initialize the widget (e.g.: color, combos, icons, etc.) */
@@ -116,6 +126,12 @@ namespace te
 
           void getLinkedDataAsString(std::vector<std::string>& vec, const std::string& attrName, int& nullValues);
 
+          /*! \brief It summarizes the attribute values in a single pass; it returns false if the values must be summarized first (linked tables). */
+          bool getDataSummary(te::stat::StreamingSummary& ss, const std::string& attrName);
+
+          /*! \brief It sets the estimated number of values of each legend item. */
+          void setCountBySummary(const te::stat::StreamingSummary& ss);
+
           void createDoubleNullGroupingItem(int count);
 
           void createStringNullGroupingItem(int count);
@@ -157,6 +173,7 @@ namespace te
           std::vector<te::map::GroupingItem*> m_legend;             //!< Grouping items
 
           bool m_manual;
+          bool m_exact;                                             //!< True to compute the numeric groupings from all the values.
           
       };
 
@@ -0,0 +1,173 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+
+/*!
+  \file terralib/raster/PolygonScanline.cpp
+
+  \brief The columns of a grid inside a polygon, computed row by row with an active edge table.
+*/
+
+// TerraLib
+#include "../geometry/LinearRing.h"
+#include "../geometry/Polygon.h"
+#include "Grid.h"
+#include "PolygonScanline.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+te::rst::PolygonScanline::PolygonScanline(const te::gm::Polygon& polygon, const Grid& grid)
+  : m_nextEdge(0),
+    m_currentRow(std::numeric_limits<int>::min()),
+    m_firstRow(0),
+    m_lastRow(-1),
+    m_nCols(static_cast<int>(grid.getNumberOfColumns()))
+{
+  double minRow = std::numeric_limits<double>::max();
+  double maxRow = -std::numeric_limits<double>::max();
+
+  for(std::size_t i = 0; i < polygon.getNumRings(); ++i)
+  {
+    const te::gm::LinearRing* ring = dynamic_cast<const te::gm::LinearRing*>(polygon.getRingN(i));
+
+    if(ring == 0 || ring->getNPoints() < 2)
+      continue;
+
+    const std::size_t nPoints = ring->getNPoints();
+
+    double col0, row0;
+    grid.geoToGrid(ring->getX(nPoints - 1), ring->getY(nPoints - 1), col0, row0);
+
+    for(std::size_t j = 0; j < nPoints; ++j)
+    {
+      double col1, row1;
+      grid.geoToGrid(ring->getX(j), ring->getY(j), col1, row1);
+
+      // the horizontal edges never cross a pixel centers line in a single point
+      if(row0 != row1)
+      {
+        Edge e;
+
+        if(row0 < row1)
+        {
+          e.m_row0 = row0;
+          e.m_row1 = row1;
+          e.m_col0 = col0;
+        }
+        else
+        {
+          e.m_row0 = row1;
+          e.m_row1 = row0;
+          e.m_col0 = col1;
+        }
+
+        e.m_slope = (col1 - col0) / (row1 - row0);
+
+        m_edges.push_back(e);
+
+        minRow = std::min(minRow, e.m_row0);
+        maxRow = std::max(maxRow, e.m_row1);
+      }
+
+      col0 = col1;
+      row0 = row1;
+    }
+  }
+
+  if(m_edges.empty())
+    return;
+
+  std::sort(m_edges.begin(), m_edges.end());
+
+  // an edge crosses the rows r such that row0 <= r < row1
+  const double nRows = static_cast<double>(grid.getNumberOfRows());
+
+  m_firstRow = static_cast<int>(std::ceil(std::max(minRow, 0.0)));
+  m_lastRow = static_cast<int>(std::ceil(std::min(maxRow, nRows))) - 1;
+}
+
+int te::rst::PolygonScanline::getFirstRow() const
+{
+  return m_firstRow;
+}
+
+int te::rst::PolygonScanline::getLastRow() const
+{
+  return m_lastRow;
+}
+
+void te::rst::PolygonScanline::getSpans(int row, std::vector<Span>& spans)
+{
+  spans.clear();
+
+  if(row < m_currentRow)
+  {
+    m_active.clear();
+    m_nextEdge = 0;
+  }
+
+  m_currentRow = row;
+
+  const double r = static_cast<double>(row);
+
+  while(m_nextEdge < m_edges.size() && m_edges[m_nextEdge].m_row0 <= r)
+    m_active.push_back(m_nextEdge++);
+
+  // remove the edges above the row and compute the crossings of the others
+  m_crossings.clear();
+
+  std::size_t nActive = 0;
+
+  for(std::size_t i = 0; i < m_active.size(); ++i)
+  {
+    const Edge& e = m_edges[m_active[i]];
+
+    if(e.m_row1 <= r)
+      continue;
+
+    m_active[nActive++] = m_active[i];
+
+    m_crossings.push_back(e.m_col0 + (r - e.m_row0) * e.m_slope);
+  }
+
+  m_active.resize(nActive);
+
+  std::sort(m_crossings.begin(), m_crossings.end());
+
+  for(std::size_t i = 0; i + 1 < m_crossings.size(); i += 2)
+  {
+    int first = static_cast<int>(std::ceil(std::max(m_crossings[i], 0.0)));
+    int last = static_cast<int>(std::floor(std::min(m_crossings[i + 1], static_cast<double>(m_nCols - 1))));
+
+    if(last < first)
+      continue;
+
+    // a crossing over a pixel center is shared by two spans
+    if(!spans.empty() && spans.back().second >= first)
+    {
+      spans.back().second = std::max(spans.back().second, last);
+      continue;
+    }
+
+    spans.push_back(Span(first, last));
+  }
+}
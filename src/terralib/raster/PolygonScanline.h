@@ -0,0 +1,121 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+
+/*!
+  \file terralib/raster/PolygonScanline.h
+
+  \brief The columns of a grid inside a polygon, computed row by row with an active edge table.
+*/
+
+#ifndef __TERRALIB_RASTER_INTERNAL_POLYGONSCANLINE_H
+#define __TERRALIB_RASTER_INTERNAL_POLYGONSCANLINE_H
+
+// TerraLib
+#include "Config.h"
+
+// STL
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace te
+{
+  namespace gm { class Polygon; }
+
+  namespace rst
+  {
+// Forward declaration
+    class Grid;
+
+    /*!
+      \class PolygonScanline
+
+      \brief The columns of a grid inside a polygon, computed row by row with an active edge table.
+
+      \details The polygon rings are converted once to grid coordinates and their edges are
+               sorted by the first row they cross. For each row, the edges crossing the pixel
+               centers line are kept in an active list, their crossings are computed
+               analytically and sorted, and the spans between each pair of crossings (even-odd
+               rule, so the holes are excluded) give the columns whose pixel centers are inside
+               the polygon.
+
+      \ingroup rst
+
+      \note The rows are expected in increasing order; if a previous row is requested, the
+            active list is rebuilt from the first edge.
+    */
+    class TERASTEREXPORT PolygonScanline
+    {
+      public:
+
+        /*! \brief A run of columns of a row: the first and the last column (inclusive). */
+        typedef std::pair<int, int> Span;
+
+        /*!
+          \brief Constructor.
+
+          \param polygon The polygon, in the grid SRS.
+          \param grid    The grid.
+        */
+        PolygonScanline(const te::gm::Polygon& polygon, const Grid& grid);
+
+        /*! \brief It returns the first grid row that may have columns inside the polygon. */
+        int getFirstRow() const;
+
+        /*! \brief It returns the last grid row that may have columns inside the polygon. */
+        int getLastRow() const;
+
+        /*!
+          \brief It computes the spans of a row.
+
+          \param row   The grid row.
+          \param spans The spans of the row, sorted by column and clamped to the grid columns.
+        */
+        void getSpans(int row, std::vector<Span>& spans);
+
+      protected:
+
+        /*! \brief A polygon edge in grid coordinates, oriented from the smallest to the largest row. */
+        struct Edge
+        {
+          double m_row0;      //!< The smallest row.
+          double m_row1;      //!< The largest row.
+          double m_col0;      //!< The column at the smallest row.
+          double m_slope;     //!< The column increment for each row.
+
+          bool operator<(const Edge& rhs) const { return m_row0 < rhs.m_row0; }
+        };
+
+      private:
+
+        std::vector<Edge> m_edges;              //!< The edges sorted by the smallest row.
+        std::vector<std::size_t> m_active;      //!< The edges crossing the current row.
+        std::vector<double> m_crossings;        //!< The crossings of the current row.
+        std::size_t m_nextEdge;                 //!< The first edge not yet activated.
+        int m_currentRow;                       //!< The last row computed.
+        int m_firstRow;                         //!< The first row crossed by an edge.
+        int m_lastRow;                          //!< The last row crossed by an edge.
+        int m_nCols;                            //!< The number of grid columns.
+    };
+
+  } // end namespace rst
+}   // end namespace te
+
+#endif  // __TERRALIB_RASTER_INTERNAL_POLYGONSCANLINE_H
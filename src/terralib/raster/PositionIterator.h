@@ -37,6 +37,7 @@
 #include "BlockUtils.h"
 #include "Grid.h"
 #include "Exception.h"
+#include "PolygonScanline.h"
 
 // STL
 #include <iostream>
@@ -48,11 +49,6 @@ namespace te
   {
 // Forward declaration.
     class Band;
-    
-    inline bool StdSortPointPointerComparison( te::gm::Point *p1, te::gm::Point *p2 )
-    {
-      return *p1 < *p2;
-    }    
 
     /*!
       \class AbstractPositionIterator
@@ -160,6 +156,11 @@ namespace te
       \brief This class implements the strategy to iterate with spatial restriction,
              the iteration occurs inside a polygon.
 
+      \details The pixels are visited row by row, in spans: the runs of columns of a row
+               whose pixel centers are inside the polygon (see PolygonScanline). Besides
+               the pixel by pixel iteration, a whole span can be processed at once using
+               getSpanStartColumn, getSpanEndColumn and nextSpan.
+
       \ingroup rst
     */
     template<class T> class PolygonIterator: public AbstractPositionIterator<T>
@@ -198,6 +199,15 @@ namespace te
 
         unsigned int getColumn() const;
 
+        /*! \brief Returns the first column of the current span. */
+        unsigned int getSpanStartColumn() const;
+
+        /*! \brief Returns the last column (inclusive) of the current span. */
+        unsigned int getSpanEndColumn() const;
+
+        /*! \brief Moves the iterator to the first column of the next span, that may be in a following row. */
+        void nextSpan();
+
         void operator++();
 
         void operator--();
@@ -217,7 +227,6 @@ namespace te
       protected:
 
         const te::gm::Polygon* m_polygon;                  //!< The spatial restriction to be applied in the iterator.
-        te::gm::Line* m_currline;                          //!< The current line in the iterator.
         int m_column;                                      //!< The current column of the iterator.
         int m_row;                                         //!< The current row of the iterator.
         int m_startingcolumn;                              //!< The starting column (in current line) to initialize the iteration.
@@ -228,7 +237,7 @@ namespace te
         int m_maxrows;                                     //!< The number of rows in band.
         int m_actualintersection;                          //!< The actual line of the iterator.
         int m_nintersections;                              //!< The number number of intersected lines in current line of the iterator.
-        std::auto_ptr<te::rst::TileIndexer> m_tileIndexer; //!< Tile indexer used to optimize the geometric operations
+        std::auto_ptr<te::rst::PolygonScanline> m_scanline; //!< The active edge table used to compute the spans of each row.
         std::vector<std::pair<int, int> > m_columns; //!< Coordinates of the columns to be transversed
         
         // Variables used by the operator[] method.
@@ -413,7 +422,6 @@ namespace te
     template<class T> te::rst::PolygonIterator<T>::PolygonIterator()
       : AbstractPositionIterator<T>(),
         m_polygon(0),
-        m_currline(0),
         m_column(-1),
         m_row(-1),
         m_startingcolumn(0),
@@ -430,7 +438,6 @@ namespace te
     template<class T> te::rst::PolygonIterator<T>::PolygonIterator(const te::rst::Raster* r, const te::gm::Polygon* p)
       : AbstractPositionIterator<T>(r),
         m_polygon(p),
-        m_currline(0),
         m_column(-1),
         m_row(-1),
         m_startingcolumn(0),
@@ -484,22 +491,21 @@ namespace te
         m_endingrow = std::max( 0, m_endingrow );
         m_endingrow = std::min( m_endingrow, ((int)rasterGrid.getNumberOfRows()) - 1 );
 
+        // initialize the edge table
+
+        m_scanline.reset(new te::rst::PolygonScanline(*m_polygon, rasterGrid));
+
+        m_startingrow = std::max( m_startingrow, m_scanline->getFirstRow() );
+        m_endingrow = std::min( m_endingrow, m_scanline->getLastRow() );
+
         if( m_endingrow < m_startingrow )
         {
           setEnd();
         }
         else
         {
-          // initialize the TileIndexer
-
-          m_tileIndexer = std::auto_ptr<te::rst::TileIndexer>(new te::rst::TileIndexer(*m_polygon, rasterGrid.getResolutionY()));
-
           // defining initial state
 
-          m_currline = new te::gm::Line(te::gm::Point(0, 0, m_polygon->getSRID()),
-            te::gm::Point(0, 0, m_polygon->getSRID()), te::gm::LineStringType,
-            m_polygon->getSRID());
-
           m_row = m_startingrow;
 
           setNextLine(true);
@@ -512,7 +518,6 @@ namespace te
     template<class T> te::rst::PolygonIterator<T>::PolygonIterator(const PolygonIterator<T>& rhs)
       : AbstractPositionIterator<T>(rhs),
         m_polygon(0),
-        m_currline(0),
         m_column(-1),
         m_row(-1),
         m_startingcolumn(0),
@@ -532,259 +537,18 @@ namespace te
       clear();
     }
 
-    template<class T> void te::rst::PolygonIterator<T>::setNextLine(bool updatecurrline)
+    template<class T> void te::rst::PolygonIterator<T>::setNextLine(bool /*updatecurrline*/)
     {
       if (m_actualintersection == -1 || m_actualintersection >= m_nintersections)
       {
-        // Globals
-
-        const double& rasterEnvelopeLLX =
-          AbstractPositionIterator< T >::m_raster->getGrid()->getExtent()->m_llx;
-        const double& rasterEnvelopeURX =
-          AbstractPositionIterator< T >::m_raster->getGrid()->getExtent()->m_urx;
+        // Retrieve the spans of the current line, skipping the lines outside the polygon
 
-        // Updates the line corresponding to the current line of the iterator
+        m_scanline->getSpans(m_row, m_columns);
 
-        if (updatecurrline)
-        {
-          double nexty = this->m_raster->getGrid()->gridToGeo(0, m_row).y;
-
-          m_currline->setX(0, std::min(
-            rasterEnvelopeLLX,
-            m_polygon->getMBR()->getLowerLeft().x) );
-          m_currline->setY(0, nexty);
-
-          m_currline->setX(1, std::max(
-            rasterEnvelopeURX,
-            m_polygon->getMBR()->getUpperRight().x ) );
-          m_currline->setY(1, nexty);
-        }
-
-        // Initialize Tile Indexer and structures used to retrieve the points where the current line 
-        // intersects the polygon
-
-        m_columns.clear();
-
-        
-        // Vector to store the points where the current line intersects the current tile of the polygon
-        std::vector<te::gm::Point*> intersectionPoints;
-
-        // Retrieve the tile corresponding to the current line and store the points where the line
-        // intersects the tile
-        
-        te::rst::TileIndexer::TileSegIndex* currentTilePtr = 0;
-        
-        if (m_tileIndexer->getTile(m_currline->getY(0), &currentTilePtr)) 
-        {
-          assert(currentTilePtr);
-          
-          te::gm::LinearRing const* ringTile;
-          std::auto_ptr<te::gm::Line> tileSeg;          
-          std::auto_ptr< te::gm::Geometry > interResultPtr;
-          std::vector< te::gm::Geometry * > singleGeomsPtrs;
-          std::size_t singleGeomsPtrsIdx = 0;
-          
-          try
-          {
-            // in some cases the intersection presents an unhandled exception, in this case we do not paint the current line
-            // Transverse the segments of the tile retrieving the intersection between them and the current line
-
-            te::gm::LineString* lineStrPtr = 0;
-
-            for (std::size_t i = 0; i < currentTilePtr->size(); i++) 
-            {
-              assert((*currentTilePtr)[i].first < m_polygon->getNumRings());
-
-              // Retrieve the current ring of the current tile
-              assert(dynamic_cast<te::gm::LinearRing const*>((*m_polygon)[(*currentTilePtr)[i].first]));
-              ringTile = (te::gm::LinearRing const*)(*m_polygon)[(*currentTilePtr)[i].first];
-
-              assert((*currentTilePtr)[i].second < m_polygon->getNPoints());
-
-              // Retrieve the current segment of the current tile
-              tileSeg.reset(new te::gm::Line(te::gm::Point(ringTile->getX((*currentTilePtr)[i].second),
-                                                           ringTile->getY((*currentTilePtr)[i].second), 
-                                                           ringTile->getSRID()),
-                                             te::gm::Point(ringTile->getX((*currentTilePtr)[i].second + 1),
-                                                           ringTile->getY((*currentTilePtr)[i].second + 1),
-                                                           ringTile->getSRID()),
-                                             te::gm::LineStringType, ringTile->getSRID()));
-
-              // Computes the intersection point between the current segment and the current line
-              
-              interResultPtr.reset( tileSeg->intersection( m_currline ) );
-              
-              if( interResultPtr.get() != 0 ) 
-              {
-                singleGeomsPtrs.clear();
-                te::gm::Multi2Single( interResultPtr.get(), singleGeomsPtrs );
-                
-                for( singleGeomsPtrsIdx = 0 ; singleGeomsPtrsIdx < singleGeomsPtrs.size() ; 
-                  ++singleGeomsPtrsIdx )
-                {
-                  if( singleGeomsPtrs[ singleGeomsPtrsIdx ]->getGeomTypeId() == 
-                    te::gm::PointType )
-                  {
-                    intersectionPoints.push_back( (te::gm::Point*)(
-                      singleGeomsPtrs[ singleGeomsPtrsIdx ]->clone() ) );
-                  }
-                  else if( singleGeomsPtrs[ singleGeomsPtrsIdx ]->getGeomTypeId() == 
-                    te::gm::LineStringType )
-                  {
-                    lineStrPtr = ((te::gm::LineString*) singleGeomsPtrs[
-                      singleGeomsPtrsIdx ]);
-                    intersectionPoints.push_back( lineStrPtr->getStartPoint() );
-                    intersectionPoints.push_back( lineStrPtr->getEndPoint() );
-                  }
-                }
-              }
-            }
-          }
-          catch(const std::exception& e)
-          {
-            TE_LOG_WARN( "Geometry intersection error:" + e.what() );
-            
-            // deleting the intersections points
-            
-            for( std::size_t intersectionPointsIdx = 0; intersectionPointsIdx < 
-              intersectionPoints.size() ; ++intersectionPointsIdx )  
-            {
-              delete intersectionPoints[intersectionPointsIdx];
-            }
-            
-            intersectionPoints.clear();
-          }          
-          catch(...)
-          {
-            TE_LOG_WARN( "Geometry intersection error" );
-            
-            // deleting the intersections points
-            
-            for( std::size_t intersectionPointsIdx = 0; intersectionPointsIdx < 
-              intersectionPoints.size() ; ++intersectionPointsIdx )  
-            {
-              delete intersectionPoints[intersectionPointsIdx];
-            }
-            
-            intersectionPoints.clear();
-          }
-        }
-
-        // Removing duplicated points
-
-        {
-          std::size_t positionBegin = 0;
-          std::size_t positionEnd = 0;
-          std::vector<te::gm::Point*> intersectionPointsAux = intersectionPoints;
-
-          intersectionPoints.clear();
-
-          while( positionBegin < intersectionPointsAux.size() )
-          {
-            if( intersectionPointsAux[positionBegin] )
-            {
-              positionEnd = positionBegin + 1;
-
-              while( positionEnd < intersectionPointsAux.size() )
-              {
-                if(
-                    ( intersectionPointsAux[positionEnd] != 0 )
-                    &&
-                    intersectionPointsAux[positionBegin]->equals(
-                      intersectionPointsAux[positionEnd], true)
-                  )
-                {
-                  delete intersectionPointsAux[positionEnd];
-                  intersectionPointsAux[positionEnd] = 0;
-                }
-
-                positionEnd++;
-              }
-
-              intersectionPoints.push_back( intersectionPointsAux[positionBegin] );
-            }
-
-            ++positionBegin;
-          }
-        }
-        
-        // Sort the intersection points through its Y coordinates (column)
-        std::sort(intersectionPoints.begin(), intersectionPoints.end(),
-                  te::rst::StdSortPointPointerComparison);        
-  
-        // Using the intersection points, build a vector of coordinates (columns) with the start and
-        // end column of the current line for each stretch
-        
-        std::size_t positionBegin = 0;
-        std::size_t positionEnd = 0;
-        int startingCol = 0;
-        int endingCol = 0;
-        double startingX = 0;
-        double startingY = 0;
-        double endingX = 0;
-        double endingY = 0;          
-        
-        while( ( positionBegin + 1 ) < intersectionPoints.size() )  
-        {
-          positionEnd = positionBegin + 1;
-          
-          startingX = intersectionPoints[positionBegin]->getX();
-          startingX = std::max( startingX, rasterEnvelopeLLX );
-
-          startingY = intersectionPoints[positionBegin]->getY();
-
-          endingX = intersectionPoints[positionEnd]->getX();
-          endingX = std::min( endingX, rasterEnvelopeURX );
-
-          endingY = intersectionPoints[positionEnd]->getY();
-
-          // Build the vector of coordinates with the folowing structure: 
-          // vector<pair<startcolumn, endcolumn>>;
-          // where each pair represents a stretch to be transversed
-          
-          if(
-              ( startingX != endingX )
-              &&
-              (
-                m_tileIndexer->withinOrTouches(te::gm::Point(
-                (startingX + (endingX - startingX) / 2.0 ), (startingY +
-                (endingY - startingY) / 2.0 ), m_polygon->getSRID()))
-              )
-            )
-          {
-            // The middle-point (between the start end end point)
-            // inside the current polygon
-            
-            startingCol = (int)std::ceil( AbstractPositionIterator<T>::m_raster->getGrid()->geoToGrid(startingX, startingY).x );
-            startingCol = std::max( 0, startingCol );
-            startingCol = std::min( m_maxcolumns - 1, startingCol );
-            
-            endingCol = (int)std::floor( AbstractPositionIterator<T>::m_raster->getGrid()->geoToGrid(endingX, endingY).x );
-            endingCol = std::max( 0, endingCol );
-            endingCol = std::min( m_maxcolumns - 1, endingCol );
-
-            if( endingCol >= startingCol )
-            {
-              m_columns.push_back(std::pair<int, int>(startingCol, endingCol));
-            }
-          } 
-
-          positionBegin = positionEnd;
-        }
-        
-        // deleting the intersections points
-        
-        positionBegin = 0;
-        
-        while ( positionBegin < intersectionPoints.size() )  
-        {
-          delete intersectionPoints[positionBegin];
-          ++positionBegin;
-        }
-
-        if (m_columns.empty())
+        while (m_columns.empty())
         {
           m_row++;
+
           if (m_row > m_endingrow)
           {
             setEnd();
@@ -792,9 +556,7 @@ namespace te
             return;
           }
 
-          setNextLine();
-
-          return;
+          m_scanline->getSpans(m_row, m_columns);
         }
 
         m_actualintersection = 0;
@@ -859,6 +621,23 @@ namespace te
       return m_column;
     }
 
+    template<class T> unsigned int te::rst::PolygonIterator<T>::getSpanStartColumn() const
+    {
+      return m_startingcolumn;
+    }
+
+    template<class T> unsigned int te::rst::PolygonIterator<T>::getSpanEndColumn() const
+    {
+      return m_endingcolumn;
+    }
+
+    template<class T> void te::rst::PolygonIterator<T>::nextSpan()
+    {
+      m_column = m_endingcolumn;
+
+      operator++();
+    }
+
     template<class T> void te::rst::PolygonIterator<T>::operator++()
     {
       m_column++;
@@ -921,11 +700,13 @@ namespace te
 
         m_polygon = rhs.m_polygon;
 
-        if( rhs.m_currline )
+        if( rhs.m_scanline.get() )
         {
-          m_currline = (te::gm::Line*)rhs.m_currline->clone();
+          m_scanline.reset(new te::rst::PolygonScanline(*rhs.m_scanline));
         }
-        
+
+        m_columns = rhs.m_columns;
+
         m_column = rhs.m_column;
         m_row = rhs.m_row;
         m_startingcolumn = rhs.m_startingcolumn;
@@ -970,12 +751,10 @@ namespace te
     {
       m_polygon = 0;
 
-      if( m_currline )
-      {
-        delete m_currline;
-        m_currline = 0;
-      }
-      
+      m_scanline.reset();
+
+      m_columns.clear();
+
       m_column = -1;
       m_row = -1;
       m_startingcolumn = 0;
@@ -732,9 +732,12 @@ void te::rst::Raster::rasterize(std::vector<te::gm::Geometry*> g, std::vector<do
 
       while (it != itend)
       {
-        setValue(it.getColumn(), it.getRow(), vp[i], b);
+        const unsigned int row = it.getRow();
 
-        ++it;
+        for (unsigned int col = it.getSpanStartColumn(); col <= it.getSpanEndColumn(); ++col)
+          setValue(col, row, vp[i], b);
+
+        it.nextSpan();
       }
     }
 
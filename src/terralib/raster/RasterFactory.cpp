@@ -25,6 +25,7 @@
 
 // TerraLib
 #include "../common/StringUtils.h"
+#include "../core/plugin/PluginManager.h"
 #include "../core/translator/Translator.h"
 #include "Exception.h"
 #include "RasterFactory.h"
@@ -32,15 +33,36 @@
 // STL
 #include <memory>
 
+namespace
+{
+  /*!
+    \brief It returns the concrete factory with the given key, loading the plugin
+           that provides it if it is registered but not loaded yet.
+  */
+  te::rst::RasterFactory* FindFactory(const std::string& ucase)
+  {
+    te::common::AbstractFactory<te::rst::Raster, std::string>::dictionary_type& d = te::common::AbstractFactory<te::rst::Raster, std::string>::getDictionary();
+
+    te::rst::RasterFactory* f = static_cast<te::rst::RasterFactory*>(d.find(ucase));
+
+    if(f == 0 && te::core::PluginManager::instance().resolve(ucase))
+      f = static_cast<te::rst::RasterFactory*>(d.find(ucase));
+
+    return f;
+  }
+}
+
 te::rst::Raster* te::rst::RasterFactory::make()
 {
-  return te::common::AbstractFactory<Raster, std::string>::make(TE_DEFAULT_RASTER_TYPE);
+  return make(TE_DEFAULT_RASTER_TYPE);
 }
 
 te::rst::Raster* te::rst::RasterFactory::make(const std::string& rType)
 {
   std::string ucase = te::common::Convert2UCase(rType);
 
+  FindFactory(ucase); // it loads the plugin providing the key, if needed
+
   return te::common::AbstractFactory<Raster, std::string>::make(ucase);
 }
 
@@ -59,9 +81,7 @@ te::rst::Raster* te::rst::RasterFactory::make(const std::string& rType, Grid* g,
 {
   std::string ucase = te::common::Convert2UCase(rType);
 
-  te::common::AbstractFactory<Raster, std::string>::dictionary_type& d = te::common::AbstractFactory<Raster, std::string>::getDictionary();
-
-  RasterFactory* f = static_cast<RasterFactory*>(d.find(ucase));
+  RasterFactory* f = FindFactory(ucase);
 
   if(f == 0)
     throw Exception(TE_TR("Could not find concrete factory! Check if it was initialized!"));
@@ -90,9 +110,7 @@ te::rst::Raster* te::rst::RasterFactory::open(const std::string& rType, const st
 {
   std::string ucase = te::common::Convert2UCase(rType);
 
-  te::common::AbstractFactory<Raster, std::string>::dictionary_type& d = te::common::AbstractFactory<Raster, std::string>::getDictionary();
-
-  RasterFactory* f = static_cast<RasterFactory*>(d.find(ucase));
+  RasterFactory* f = FindFactory(ucase);
 
   if(f == 0)
     throw Exception(TE_TR("Could not find concrete factory! Check if it was initialized!"));
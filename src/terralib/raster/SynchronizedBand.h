@@ -65,7 +65,7 @@ namespace te
 
         inline te::rst::Raster* getRaster() const
         {
-          return (te::rst::Raster*)(&m_syncRasterPtr);
+          return (te::rst::Raster*)m_syncRasterPtr;
         };
 
         void getValue(unsigned int c, unsigned int r, double& value) const;
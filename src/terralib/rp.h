@@ -33,6 +33,7 @@
 #include "rp/AlgorithmOutputParameters.h"
 #include "rp/ArithmeticOperations.h"
 #include "rp/Blender.h"
+#include "rp/BlockProcessor.h"
 #include "rp/ClassifierDummyStrategy.h"
 #include "rp/ClassifierEMStrategy.h"
 #include "rp/Classifier.h"
@@ -50,6 +51,7 @@
 #include "rp/Functions.h"
 #include "rp/GeoMosaic.h"
 #include "rp/IHSFusion.h"
+#include "rp/KDForestFeaturesIndex.h"
 #include "rp/Macros.h"
 #include "rp/Matrix.h"
 #include "rp/MixtureModel.h"
@@ -78,6 +80,7 @@
 #include "rp/SpectralResponseFunctions.h"
 #include "rp/StrategyParameters.h"
 #include "rp/Texture.h"
+#include "rp/ThreadPool.h"
 #include "rp/TiePointsLocator.h"
 #include "rp/TiePointsLocatorInputParameters.h"
 #include "rp/TiePointsLocatorMoravecStrategy.h"
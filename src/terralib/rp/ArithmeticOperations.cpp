@@ -34,6 +34,9 @@
 #include "../memory/ExpansibleRaster.h"
 #include "../srs/Converter.h"
 
+#include <boost/bind.hpp>
+
+#include <algorithm>
 #include <cfloat>
 
 namespace te
@@ -64,6 +67,7 @@ namespace te
       m_normalize = false;
       m_enableProgress = false;
       m_interpMethod = te::rst::NearestNeighbor;
+      m_enableMultiThread = true;
     }
 
     const ArithmeticOperations::InputParameters& ArithmeticOperations::InputParameters::operator=(
@@ -76,6 +80,7 @@ namespace te
       m_normalize = params.m_normalize;
       m_enableProgress = params.m_enableProgress;
       m_interpMethod = params.m_interpMethod;
+      m_enableMultiThread = params.m_enableMultiThread;
 
       return *this;
     }
@@ -200,60 +205,115 @@ namespace te
 
       // Copy result data to output raster
 
-      const unsigned int nRows = (unsigned int)auxRasterPtr->getNumberOfRows();
-      const unsigned int nCols = (unsigned int)auxRasterPtr->getNumberOfColumns();
-      unsigned int row = 0;
-      unsigned int col = 0;
-      double value = 0;
       te::rst::Raster& auxRasterRef = *auxRasterPtr;
       te::rst::Raster& outRasterRef = *outParamsPtr->m_outputRasterPtr;
+      const bool normalize = m_inputParameters.m_normalize && 
+        ( outRasterRef.getBand(0)->getProperty()->getType() != te::dt::DOUBLE_TYPE );
+      double outputOffset = 0;  
+      double outputGain = 1.0;
   
-      double outAllowedMin = 0;
-      double outAllowedMax = 0;
-      GetDataTypeRange( outParamsPtr->m_outputRasterPtr->getBandDataType( 0 ) , 
-        outAllowedMin, outAllowedMax );
-  
-      if( m_inputParameters.m_normalize && ( outRasterRef.getBand(0)->getProperty()->getType() !=
-        te::dt::DOUBLE_TYPE ) )
+      if( normalize )
       {
         // Calculating the output gain and offset
     
-        const double auxNoDataValue = auxRasterRef.getBand( 0 )->getProperty()->m_noDataValue;
-        const double outNoDataValue = outRasterRef.getBand( 0 )->getProperty()->m_noDataValue;
-        double auxMin = DBL_MAX;
-        double auxMax = -1.0 * auxMin;  
+        double outAllowedMin = 0;
+        double outAllowedMax = 0;
+        GetDataTypeRange( outRasterRef.getBandDataType( 0 ) , 
+          outAllowedMin, outAllowedMax );
     
-        for( row = 0 ; row < nRows ; ++row )
-        {
-          for( col = 0 ; col < nCols ; ++col )
-          {
-            auxRasterRef.getValue( col, row, value, 0 );
-            
-            if( auxNoDataValue != value )
-            {
-              if( auxMin > value ) auxMin = value;
-              if( auxMax < value ) auxMax = value;
-            }
-          }
-        } 
+        BlockProcessor processor;
+        processor.addInputRaster( auxRasterRef );
+        processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
+        
+        std::vector< double > auxMins( processor.getThreadsNumber(), DBL_MAX );
+        std::vector< double > auxMaxs( processor.getThreadsNumber(), -1.0 * DBL_MAX );
+        
+        TERP_TRUE_OR_RETURN_FALSE( processor.execute( boost::bind( 
+          &ArithmeticOperations::getResultRangeBlock, this, boost::ref( auxMins ),
+          boost::ref( auxMaxs ), _1, _2 ) ), "Result range error" );
+          
+        const double auxMin = *std::min_element( auxMins.begin(), auxMins.end() );
+        const double auxMax = *std::max_element( auxMaxs.begin(), auxMaxs.end() );
     
-        double outputOffset = 0;  
-        double outputGain = 1.0;
         if( ( auxMin != DBL_MAX ) && ( auxMax != ( -1.0 * DBL_MAX ) ) && ( auxMax != auxMin ) )
         {
           outputOffset = -1.0 * auxMin;
           outputGain = ( ( outAllowedMax - outAllowedMin ) / ( auxMax - auxMin ) );       
         }
+      }
+      
+      BlockProcessor processor;
+      processor.setOutputRaster( outRasterRef );
+      processor.addInputRaster( auxRasterRef );
+      processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
+      
+      TERP_TRUE_OR_RETURN_FALSE( processor.execute( boost::bind( 
+        &ArithmeticOperations::copyResultBlock, this, normalize, outputOffset,
+        outputGain, _1, _2 ) ), "Output raster data copy error" );
+
+      return true;
+    }
+
+    bool ArithmeticOperations::getResultRangeBlock( std::vector< double >& resultMins,
+      std::vector< double >& resultMaxs, const BlockWindow& window,
+      BlockContext& context ) const
+    {
+      const te::rst::Band& auxBand = *context.getInputRaster( 0 ).getBand( 0 );
+      const double auxNoDataValue = auxBand.getProperty()->m_noDataValue;
+      double auxMin = resultMins[ context.getThreadIndex() ];
+      double auxMax = resultMaxs[ context.getThreadIndex() ];
+      unsigned int row = 0;
+      unsigned int col = 0;
+      double value = 0;
+  
+      for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
+      {
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
+        {
+          auxBand.getValue( col, row, value );
+          
+          if( auxNoDataValue != value )
+          {
+            if( auxMin > value ) auxMin = value;
+            if( auxMax < value ) auxMax = value;
+          }
+        }
+      } 
+      
+      resultMins[ context.getThreadIndex() ] = auxMin;
+      resultMaxs[ context.getThreadIndex() ] = auxMax;
+      
+      return true;
+    }
+
+    bool ArithmeticOperations::copyResultBlock( const bool normalize, 
+      const double outputOffset, const double outputGain, 
+      const BlockWindow& window, BlockContext& context ) const
+    {
+      const te::rst::Band& auxBand = *context.getInputRaster( 0 ).getBand( 0 );
+      te::rst::Band& outBand = *context.getOutputRaster().getBand( 0 );
+      unsigned int row = 0;
+      unsigned int col = 0;
+      double value = 0;
+  
+      if( normalize )
+      {
+        const double auxNoDataValue = auxBand.getProperty()->m_noDataValue;
+        const double outNoDataValue = outBand.getProperty()->m_noDataValue;
+        double outAllowedMin = 0;
+        double outAllowedMax = 0;
+        GetDataTypeRange( outBand.getProperty()->getType(), outAllowedMin, 
+          outAllowedMax );
       
-        for( row = 0 ; row < nRows ; ++row )
+        for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
         {
-          for( col = 0 ; col < nCols ; ++col )
+          for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
           {
-            auxRasterRef.getValue( col, row, value, 0 );
+            auxBand.getValue( col, row, value );
             
             if( auxNoDataValue == value )
             {            
-              outRasterRef.setValue( col, row, outNoDataValue, 0 );
+              outBand.setValue( col, row, outNoDataValue );
             }
             else
             {
@@ -263,23 +323,23 @@ namespace te
               value = MIN( value, outAllowedMax );
               value = MAX( value, outAllowedMin );
           
-              outRasterRef.setValue( col, row, value, 0 );
+              outBand.setValue( col, row, value );
             }
           }
         }        
       }
       else
       {
-        for( row = 0 ; row < nRows ; ++row )
+        for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
         {
-          for( col = 0 ; col < nCols ; ++col )
+          for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
           {
-            auxRasterRef.getValue( col, row, value, 0 );        
-            outRasterRef.setValue( col, row, value, 0 );
+            auxBand.getValue( col, row, value );        
+            outBand.setValue( col, row, value );
           }
         }  
       }
-
+      
       return true;
     }
 
@@ -671,42 +731,18 @@ namespace te
         return false;
       }      
       
+      BlockProcessor processor;
+      processor.setOutputRaster( *outRasterPtr );
+      processor.addInputRaster( inRaster1 );
+      processor.addInputRaster( inRaster2 );
+      
       if( inRaster1.getGrid()->operator==( *inRaster2.getGrid() ) ) 
       {
-        const unsigned int nRows = inRaster1.getNumberOfRows();
-        const unsigned int nCols = inRaster1.getNumberOfColumns();
-        const te::rst::Band& inBand1 = *inRaster1.getBand( band1Idx );
-        const te::rst::Band& inBand2 = *inRaster2.getBand( band2Idx );
-        te::rst::Band& outBand = *outRasterPtr->getBand( 0 );
-        const double inNoData1 = inBand1.getProperty()->m_noDataValue;
-        const double inNoData2 = inBand2.getProperty()->m_noDataValue;
-        const double outNoData = outBand.getProperty()->m_noDataValue;
-        unsigned int row = 0;
-        unsigned int col = 0;
-        double value1 = 0;
-        double value2 = 0;
-        double outValue = 0;
-        
-        for( row = 0 ; row < nRows ; ++row )
-        {
-          for( col = 0 ; col < nCols ; ++col )
-          {
-            inBand1.getValue( col, row, value1 );
-            inBand2.getValue( col, row, value2 );
-            
-            if( ( value1 != inNoData1 ) && ( value2 != inNoData2 ) )
-            {
-              (this->*binOptFunctPtr)( value1, value2, outValue );
-              outBand.setValue( col, row, outValue );
-            }
-            else
-            {
-              outBand.setValue( col, row, outNoData );
-            }
-          }
-        }
+        processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
         
-        return true;
+        return processor.execute( boost::bind( 
+          &ArithmeticOperations::binaryOperatorRasterXRasterBlock, this,
+          band1Idx, band2Idx, binOptFunctPtr, _1, _2 ) );
       }
       else
       {
@@ -731,67 +767,142 @@ namespace te
         overlapLRRow1 = std::max( 0.0, std::min( (double)( inRaster1.getNumberOfRows() 
           - 1 ), overlapLRRow1 ) );        
         
-        const unsigned int overlapFirstCol1 = (unsigned int)std::floor( overlapULCol1 );
-        const unsigned int overlapFirstRow1 = (unsigned int)std::floor( overpalULRow1 );
-        const unsigned int overlapLastCol1 = (unsigned int)std::ceil( overlapLRCol1 );
-        const unsigned int overlapLastRow1 = (unsigned int)std::ceil( overlapLRRow1 );
+        BlockWindow overlapWindow;
+        overlapWindow.m_firstCol = (unsigned int)std::floor( overlapULCol1 );
+        overlapWindow.m_firstRow = (unsigned int)std::floor( overpalULRow1 );
+        overlapWindow.m_colsBound = ( (unsigned int)std::ceil( overlapLRCol1 ) ) + 1;
+        overlapWindow.m_rowsBound = ( (unsigned int)std::ceil( overlapLRRow1 ) ) + 1;
         
-        const unsigned int nRows1 = inRaster1.getNumberOfRows();
-        const unsigned int nCols1 = inRaster1.getNumberOfColumns();
-        const te::rst::Band& inBand1 = *inRaster1.getBand( band1Idx );
-        const te::rst::Grid& grid1 = *inRaster1.getGrid();
-        const te::rst::Grid& grid2 = *inRaster2.getGrid();
-        te::rst::Band& outBand = *outRasterPtr->getBand( 0 );
-        const double inNoData1 = inBand1.getProperty()->m_noDataValue;
-        const double inNoData2 = inRaster2.getBand( band2Idx )->getProperty()->m_noDataValue;
-        const double outNoData = outBand.getProperty()->m_noDataValue;       
-        te::srs::Converter converter( inRaster1.getSRID(), inRaster2.getSRID() );
-        te::rst::Interpolator interpolator2( &inRaster2, m_inputParameters.m_interpMethod );
-        unsigned int row1 = 0;
-        unsigned int col1 = 0;
-        double row2 = 0;
-        double col2 = 0;        
-        double value1 = 0;
-        std::complex< double > value2;
-        double outValue = 0;
-        double currX1 = 0;
-        double currY1 = 0;
-        double currX2 = 0;
-        double currY2 = 0;        
+        // The coordinates conversion (proj.4 shared context) is not thread safe,
+        // rasters with different SRIDs are processed by the calling thread
         
-        for( row1 = 0 ; row1 < nRows1 ; ++row1 )
+        std::auto_ptr< te::srs::Converter > converterPtr;
+        
+        if( inRaster1.getSRID() != inRaster2.getSRID() )
+        {
+          converterPtr.reset( new te::srs::Converter( inRaster1.getSRID(), 
+            inRaster2.getSRID() ) );
+          processor.setThreadsNumber( 1 );
+        }
+        else
         {
-          for( col1 = 0 ; col1 < nCols1 ; ++col1 )
+          processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
+        }
+        
+        return processor.execute( boost::bind( 
+          &ArithmeticOperations::binaryOperatorRasterXResampledRasterBlock, this,
+          band1Idx, band2Idx, binOptFunctPtr, converterPtr.get(), 
+          boost::cref( overlapWindow ), _1, _2 ) );
+      }
+    }
+    
+    bool ArithmeticOperations::binaryOperatorRasterXRasterBlock( 
+      const unsigned int band1Idx, const unsigned int band2Idx,
+      const BinOpFuncPtrT binOptFunctPtr, const BlockWindow& window,
+      BlockContext& context ) const
+    {
+      const te::rst::Band& inBand1 = *context.getInputRaster( 0 ).getBand( band1Idx );
+      const te::rst::Band& inBand2 = *context.getInputRaster( 1 ).getBand( band2Idx );
+      te::rst::Band& outBand = *context.getOutputRaster().getBand( 0 );
+      const double inNoData1 = inBand1.getProperty()->m_noDataValue;
+      const double inNoData2 = inBand2.getProperty()->m_noDataValue;
+      const double outNoData = outBand.getProperty()->m_noDataValue;
+      unsigned int row = 0;
+      unsigned int col = 0;
+      double value1 = 0;
+      double value2 = 0;
+      double outValue = 0;
+      
+      for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
+      {
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
+        {
+          inBand1.getValue( col, row, value1 );
+          inBand2.getValue( col, row, value2 );
+          
+          if( ( value1 != inNoData1 ) && ( value2 != inNoData2 ) )
+          {
+            (this->*binOptFunctPtr)( value1, value2, outValue );
+            outBand.setValue( col, row, outValue );
+          }
+          else
+          {
+            outBand.setValue( col, row, outNoData );
+          }
+        }
+      }
+      
+      return true;
+    }
+    
+    bool ArithmeticOperations::binaryOperatorRasterXResampledRasterBlock( 
+      const unsigned int band1Idx, const unsigned int band2Idx,
+      const BinOpFuncPtrT binOptFunctPtr, te::srs::Converter const* converterPtr,
+      const BlockWindow& overlapWindow, const BlockWindow& window,
+      BlockContext& context ) const
+    {
+      const te::rst::Raster& inRaster1 = context.getInputRaster( 0 );
+      const te::rst::Raster& inRaster2 = context.getInputRaster( 1 );
+      const te::rst::Band& inBand1 = *inRaster1.getBand( band1Idx );
+      const te::rst::Grid& grid1 = *inRaster1.getGrid();
+      const te::rst::Grid& grid2 = *inRaster2.getGrid();
+      te::rst::Band& outBand = *context.getOutputRaster().getBand( 0 );
+      const double inNoData1 = inBand1.getProperty()->m_noDataValue;
+      const double inNoData2 = inRaster2.getBand( band2Idx )->getProperty()->m_noDataValue;
+      const double outNoData = outBand.getProperty()->m_noDataValue;       
+      te::rst::Interpolator interpolator2( &inRaster2, m_inputParameters.m_interpMethod );
+      unsigned int row1 = 0;
+      unsigned int col1 = 0;
+      double row2 = 0;
+      double col2 = 0;        
+      double value1 = 0;
+      std::complex< double > value2;
+      double outValue = 0;
+      double currX1 = 0;
+      double currY1 = 0;
+      double currX2 = 0;
+      double currY2 = 0;        
+      
+      for( row1 = window.m_firstRow ; row1 < window.m_rowsBound ; ++row1 )
+      {
+        for( col1 = window.m_firstCol ; col1 < window.m_colsBound ; ++col1 )
+        {
+          if( ( row1 >= overlapWindow.m_firstRow ) && ( row1 < overlapWindow.m_rowsBound ) &&
+            ( col1 >= overlapWindow.m_firstCol ) && ( col1 < overlapWindow.m_colsBound ) )
           {
-            if( ( row1 >= overlapFirstRow1 ) && ( row1 <= overlapLastRow1 ) &&
-              ( col1 >= overlapFirstCol1 ) && ( col1 <= overlapLastCol1 ) )
+            grid1.gridToGeo( (double)col1, (double)row1, currX1, currY1 );
+            
+            if( converterPtr )
             {
-              grid1.gridToGeo( (double)col1, (double)row1, currX1, currY1 );
-              converter.convert( currX1, currY1, currX2, currY2 );
-              grid2.geoToGrid( currX2, currY2, col2, row2 );
-              
-              inBand1.getValue( col1, row1, value1 );
-              interpolator2.getValue( col2, row2, value2, band2Idx );
-              
-              if( ( value1 != inNoData1 ) && ( value2.real() != inNoData2 ) )
-              {
-                (this->*binOptFunctPtr)( value1, value2.real(), outValue );
-                outBand.setValue( col1, row1, outValue );
-              }
-              else
-              {
-                outBand.setValue( col1, row1, outNoData );
-              }
+              converterPtr->convert( currX1, currY1, currX2, currY2 );
+            }
+            else
+            {
+              currX2 = currX1;
+              currY2 = currY1;
+            }
+            
+            grid2.geoToGrid( currX2, currY2, col2, row2 );
+            
+            inBand1.getValue( col1, row1, value1 );
+            interpolator2.getValue( col2, row2, value2, band2Idx );
+            
+            if( ( value1 != inNoData1 ) && ( value2.real() != inNoData2 ) )
+            {
+              (this->*binOptFunctPtr)( value1, value2.real(), outValue );
+              outBand.setValue( col1, row1, outValue );
             }
             else
             {
               outBand.setValue( col1, row1, outNoData );
             }
           }
-        }        
-        
-        return true;
-      }
+          else
+          {
+            outBand.setValue( col1, row1, outNoData );
+          }
+        }
+      }        
       
       return true;
     }
@@ -808,10 +919,23 @@ namespace te
         return false;
       }
       
-      const unsigned int nRows = inRaster.getNumberOfRows();
-      const unsigned int nCols = inRaster.getNumberOfColumns();
-      const te::rst::Band& inBand = *inRaster.getBand( bandIdx );
-      te::rst::Band& outBand = *outRasterPtr->getBand( 0 );
+      BlockProcessor processor;
+      processor.setOutputRaster( *outRasterPtr );
+      processor.addInputRaster( inRaster );
+      processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
+      
+      return processor.execute( boost::bind( 
+        &ArithmeticOperations::binaryOperatorRasterXRealBlock, this,
+        bandIdx, value, binOptFunctPtr, realNumberIsRigthtTerm, _1, _2 ) );
+    }
+    
+    bool ArithmeticOperations::binaryOperatorRasterXRealBlock( 
+      const unsigned int bandIdx, const double value, 
+      const BinOpFuncPtrT binOptFunctPtr, const bool realNumberIsRigthtTerm,
+      const BlockWindow& window, BlockContext& context ) const
+    {
+      const te::rst::Band& inBand = *context.getInputRaster( 0 ).getBand( bandIdx );
+      te::rst::Band& outBand = *context.getOutputRaster().getBand( 0 );
       const double inNoData = inBand.getProperty()->m_noDataValue;
       const double outNoData = outBand.getProperty()->m_noDataValue;
       unsigned int row = 0;
@@ -821,9 +945,9 @@ namespace te
       
       if( realNumberIsRigthtTerm )
       {
-        for( row = 0 ; row < nRows ; ++row )
+        for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
         {
-          for( col = 0 ; col < nCols ; ++col )
+          for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
           {
             inBand.getValue( col, row, value1 );
             
@@ -841,9 +965,9 @@ namespace te
       }
       else
       {
-        for( row = 0 ; row < nRows ; ++row )
+        for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
         {
-          for( col = 0 ; col < nCols ; ++col )
+          for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
           {
             inBand.getValue( col, row, value1 );
             
@@ -957,34 +1081,47 @@ namespace te
         return false;
       }
 
-        const unsigned int nRows = inRaster.getNumberOfRows();
-        const unsigned int nCols = inRaster.getNumberOfColumns();
-        const te::rst::Band& inBand = *inRaster.getBand(bandIdx);
-        te::rst::Band& outBand = *outRasterPtr->getBand(0);
-        const double inNoData = inBand.getProperty()->m_noDataValue;
-        const double outNoData = outBand.getProperty()->m_noDataValue;
-        unsigned int row = 0;
-        unsigned int col = 0;
-        double value = 0;
-        double outValue = 0;
+      BlockProcessor processor;
+      processor.setOutputRaster(*outRasterPtr);
+      processor.addInputRaster(inRaster);
+      processor.setThreadsNumber(m_inputParameters.m_enableMultiThread ? 0 : 1);
 
-        for (row = 0; row < nRows; ++row)
+      return processor.execute(boost::bind(
+        &ArithmeticOperations::unaryOperatorRasterBlock, this,
+        bandIdx, unaryOptFunctPtr, _1, _2));
+    }
+
+    bool ArithmeticOperations::unaryOperatorRasterBlock(
+      const unsigned int bandIdx,
+      const UnaryOpFuncPtrT unaryOptFunctPtr,
+      const BlockWindow& window, BlockContext& context) const
+    {
+      const te::rst::Band& inBand = *context.getInputRaster(0).getBand(bandIdx);
+      te::rst::Band& outBand = *context.getOutputRaster().getBand(0);
+      const double inNoData = inBand.getProperty()->m_noDataValue;
+      const double outNoData = outBand.getProperty()->m_noDataValue;
+      unsigned int row = 0;
+      unsigned int col = 0;
+      double value = 0;
+      double outValue = 0;
+
+      for (row = window.m_firstRow; row < window.m_rowsBound; ++row)
+      {
+        for (col = window.m_firstCol; col < window.m_colsBound; ++col)
         {
-          for (col = 0; col < nCols; ++col)
-          {
-            inBand.getValue(col, row, value);
+          inBand.getValue(col, row, value);
 
-            if ((value != inNoData))
-            {
-              (this->*unaryOptFunctPtr)(value, outValue);
-              outBand.setValue(col, row, outValue);
-            }
-            else
-            {
-              outBand.setValue(col, row, outNoData);
-            }
+          if ((value != inNoData))
+          {
+            (this->*unaryOptFunctPtr)(value, outValue);
+            outBand.setValue(col, row, outValue);
+          }
+          else
+          {
+            outBand.setValue(col, row, outNoData);
           }
         }
+      }
 
       return true;
     }
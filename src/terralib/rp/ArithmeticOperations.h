@@ -26,6 +26,7 @@
 #define __TERRALIB_RP_INTERNAL_ARITHMETICOPERATIONS_H
 
 #include "Algorithm.h"
+#include "BlockProcessor.h"
 #include "../raster/Grid.h"
 #include "../raster/Interpolator.h"
 #include "../common/progress/TaskProgress.h"
@@ -47,6 +48,11 @@ namespace te
     class Raster;
   }
 
+  namespace srs
+  {
+    class Converter;
+  }
+
   namespace rp
   {
     /*!
@@ -89,6 +95,8 @@ namespace te
             
             te::rst::Interpolator::Method m_interpMethod; //!< The raster interpolator method (default:NearestNeighbor).
             
+            bool m_enableMultiThread; //!< Enable/Disable the use of multi-threads (default:true).
+            
             InputParameters();
             
             InputParameters( const InputParameters& );
@@ -406,6 +414,35 @@ namespace te
           const BinOpFuncPtrT binOptFunctPtr,
           std::auto_ptr<te::rst::Raster>& outRasterPtr ) const; 
           
+        /*!
+          \brief Execute the given binary operator over one block window of two rasters with the same grid (BlockProcessor function).
+          \param band1 Input raster 1 band.
+          \param band2 Input raster 2 band.
+          \param binOptFunctPtr The binary operation function pointer.
+          \param window The block window.
+          \param context The executing thread context.
+          \return true if OK, false on errors.
+        */
+        bool binaryOperatorRasterXRasterBlock( const unsigned int band1,
+          const unsigned int band2, const BinOpFuncPtrT binOptFunctPtr,
+          const BlockWindow& window, BlockContext& context ) const;
+          
+        /*!
+          \brief Execute the given binary operator over one block window of two rasters with different grids (BlockProcessor function).
+          \param band1 Input raster 1 band.
+          \param band2 Input raster 2 band.
+          \param binOptFunctPtr The binary operation function pointer.
+          \param converterPtr The raster 1 to raster 2 coordinates converter (null if both rasters have the same SRID).
+          \param overlapWindow The area of raster 1 overlapped by raster 2.
+          \param window The block window.
+          \param context The executing thread context.
+          \return true if OK, false on errors.
+        */
+        bool binaryOperatorRasterXResampledRasterBlock( const unsigned int band1,
+          const unsigned int band2, const BinOpFuncPtrT binOptFunctPtr,
+          te::srs::Converter const* converterPtr, const BlockWindow& overlapWindow,
+          const BlockWindow& window, BlockContext& context ) const;
+          
         /*!
           \brief Execute the given binary operator using the given input raster and a real number
           \param inRaster Input raster.
@@ -420,6 +457,21 @@ namespace te
           const BinOpFuncPtrT binOptFunctPtr,
           std::auto_ptr<te::rst::Raster>& outRasterPtr,
           const bool realNumberIsRigthtTerm ) const;  
+          
+        /*!
+          \brief Execute the given binary operator over one block window of a raster and a real number (BlockProcessor function).
+          \param bandIdx Input raster band.
+          \param value The real number.
+          \param binOptFunctPtr The binary operation function pointer.
+          \param realNumberIsRigthtTerm true if the real number is the right term.
+          \param window The block window.
+          \param context The executing thread context.
+          \return true if OK, false on errors.
+        */
+        bool binaryOperatorRasterXRealBlock( const unsigned int bandIdx,
+          const double value, const BinOpFuncPtrT binOptFunctPtr,
+          const bool realNumberIsRigthtTerm, const BlockWindow& window,
+          BlockContext& context ) const;
       
         /*!
           \brief Execute the given unary operator using the current given execution stack.
@@ -443,6 +495,18 @@ namespace te
           const unsigned int band, const UnaryOpFuncPtrT unaryOptFunctPtr,
           std::auto_ptr<te::rst::Raster>& outRasterPtr) const;
 
+        /*!
+        \brief Execute the given unary operator over one block window of a raster (BlockProcessor function).
+        \param band Input raster band.
+        \param unaryOptFunctPtr The unary operation function pointer.
+        \param window The block window.
+        \param context The executing thread context.
+        \return true if OK, false on errors.
+        */
+        bool unaryOperatorRasterBlock(const unsigned int band,
+          const UnaryOpFuncPtrT unaryOptFunctPtr, const BlockWindow& window,
+          BlockContext& context) const;
+
         /*!
         \brief Execute the given unary operator using the given a real number
         \param unaryOptFunctPtr The unary operation function pointer.
@@ -472,6 +536,31 @@ namespace te
         bool allocResultRaster( const te::rst::Grid& grid, 
           std::auto_ptr<te::rst::Raster>& rasterPtr ) const;
         
+        /*!
+          \brief Updates the result values range with one block window (BlockProcessor function).
+          \param resultMins The minimum value found by each thread.
+          \param resultMaxs The maximum value found by each thread.
+          \param window The block window.
+          \param context The executing thread context.
+          \return Returns true if OK, false on errors.
+        */
+        bool getResultRangeBlock( std::vector< double >& resultMins,
+          std::vector< double >& resultMaxs, const BlockWindow& window,
+          BlockContext& context ) const;
+        
+        /*!
+          \brief Copies one block window of the result raster to the output raster (BlockProcessor function).
+          \param normalize true if the values must be normalized.
+          \param outputOffset The normalization offset.
+          \param outputGain The normalization gain.
+          \param window The block window.
+          \param context The executing thread context.
+          \return Returns true if OK, false on errors.
+        */
+        bool copyResultBlock( const bool normalize, const double outputOffset,
+          const double outputGain, const BlockWindow& window,
+          BlockContext& context ) const;
+        
         /*!
           \brief Split the input string into a vector of token strings
           \param inputStr The input string.
@@ -0,0 +1,591 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/rp/BlockProcessor.cpp
+  \brief Parallel execution of a function over the blocks of an output raster.
+ */
+
+#include "BlockProcessor.h"
+#include "Exception.h"
+#include "Macros.h"
+#include "ThreadPool.h"
+#include "../common/progress/TaskProgress.h"
+#include "../raster/Band.h"
+#include "../raster/BandProperty.h"
+#include "../raster/Raster.h"
+#include "../raster/RasterSynchronizer.h"
+#include "../raster/SynchronizedRaster.h"
+
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+namespace te
+{
+  namespace rp
+  {
+    CancellationToken::CancellationToken()
+    : m_cancelled( false )
+    {
+    }
+
+    CancellationToken::~CancellationToken()
+    {
+    }
+
+    void CancellationToken::cancel()
+    {
+      m_cancelled = true;
+    }
+
+    bool CancellationToken::isCancelled() const
+    {
+      return m_cancelled;
+    }
+
+    void CancellationToken::reset()
+    {
+      m_cancelled = false;
+    }
+
+    BlockWindow::BlockWindow()
+    : m_firstRow( 0 ), m_rowsBound( 0 ), m_firstCol( 0 ), m_colsBound( 0 ),
+      m_haloFirstRow( 0 ), m_haloRowsBound( 0 ), m_haloFirstCol( 0 ),
+      m_haloColsBound( 0 )
+    {
+    }
+
+    BlockWindow::~BlockWindow()
+    {
+    }
+
+    BlockContext::BlockContext()
+    : m_outputRasterPtr( 0 ), m_threadIndex( 0 ), m_internalTokenPtr( 0 ),
+      m_externalTokenPtr( 0 )
+    {
+    }
+
+    BlockContext::~BlockContext()
+    {
+    }
+
+    te::rst::Raster const& BlockContext::getInputRaster(
+      const unsigned int inputRasterIdx ) const
+    {
+      TERP_TRUE_OR_THROW( inputRasterIdx < m_inputRasters.size(),
+        "Invalid input raster index" );
+
+      return *m_inputRasters[ inputRasterIdx ];
+    }
+
+    te::rst::Raster& BlockContext::getOutputRaster() const
+    {
+      TERP_TRUE_OR_THROW( m_outputRasterPtr, "Invalid output raster" );
+
+      return *m_outputRasterPtr;
+    }
+
+    unsigned int BlockContext::getThreadIndex() const
+    {
+      return m_threadIndex;
+    }
+
+    bool BlockContext::isCancelled() const
+    {
+      return m_internalTokenPtr->isCancelled() || ( m_externalTokenPtr &&
+        m_externalTokenPtr->isCancelled() );
+    }
+
+    class BlockProcessor::ExecutionState
+    {
+      public :
+
+        BlockFunctionT m_blockFunction; //!< The block function.
+
+        std::vector< te::rst::Raster const* > m_inputRasters; //!< The input rasters.
+
+        te::rst::Raster* m_outputRasterPtr; //!< The output raster.
+
+        std::vector< boost::shared_ptr< te::rst::RasterSynchronizer > > m_inputSyncs; //!< The input rasters synchronizers (null when not synchronized or when the input is the output).
+
+        std::vector< unsigned int > m_inputMaxCachedBlocks; //!< The blocks cache size of each thread input raster.
+
+        boost::scoped_ptr< te::rst::RasterSynchronizer > m_outputSync; //!< The output raster synchronizer (null when not synchronized).
+
+        unsigned int m_outputMaxCachedBlocks; //!< The blocks cache size of each thread output raster.
+
+        unsigned int m_nRows; //!< The number of raster rows.
+
+        unsigned int m_nCols; //!< The number of raster columns.
+
+        unsigned int m_windowWidth; //!< The windows width (the output blocks width).
+
+        unsigned int m_windowHeight; //!< The windows height (a multiple of the output blocks height).
+
+        unsigned int m_windowsPerRow; //!< The number of windows in one row of windows.
+
+        unsigned int m_windowsNumber; //!< The total number of windows.
+
+        unsigned int m_haloRows; //!< The number of halo rows.
+
+        unsigned int m_haloCols; //!< The number of halo columns.
+
+        std::atomic< unsigned int > m_nextWindowIdx; //!< The next window to process.
+
+        std::atomic< unsigned int > m_processedWindowsNumber; //!< The number of processed windows.
+
+        std::atomic< bool > m_returnValue; //!< The execution return value.
+
+        CancellationToken m_internalToken; //!< Set on errors and progress cancellation.
+
+        CancellationToken const* m_externalTokenPtr; //!< The user cancellation token (or null).
+
+        te::common::TaskProgress* m_progressPtr; //!< The progress interface (or null), only used by the calling thread.
+
+        boost::mutex m_mutex; //!< The mutex guarding the variables below.
+
+        boost::condition_variable m_condVar; //!< Signals the end of a thread.
+
+        unsigned int m_runningThreadsNumber; //!< The number of threads processing windows.
+
+        bool m_closed; //!< True when new threads must not start processing windows.
+
+        std::exception_ptr m_exception; //!< The first exception thrown by the threads.
+
+        ExecutionState()
+        : m_outputRasterPtr( 0 ), m_outputMaxCachedBlocks( 0 ), m_nRows( 0 ),
+          m_nCols( 0 ), m_windowWidth( 0 ), m_windowHeight( 0 ),
+          m_windowsPerRow( 0 ), m_windowsNumber( 0 ), m_haloRows( 0 ),
+          m_haloCols( 0 ), m_nextWindowIdx( 0 ), m_processedWindowsNumber( 0 ),
+          m_returnValue( true ), m_externalTokenPtr( 0 ), m_progressPtr( 0 ),
+          m_runningThreadsNumber( 0 ), m_closed( false )
+        {
+        }
+
+        bool isCancelled() const
+        {
+          return m_internalToken.isCancelled() || ( m_externalTokenPtr &&
+            m_externalTokenPtr->isCancelled() );
+        }
+
+        void fail()
+        {
+          m_returnValue = false;
+          m_internalToken.cancel();
+        }
+
+        void getWindow( const unsigned int windowIdx, BlockWindow& window ) const
+        {
+          window.m_firstRow = ( windowIdx / m_windowsPerRow ) * m_windowHeight;
+          window.m_rowsBound = std::min( window.m_firstRow + m_windowHeight, m_nRows );
+          window.m_firstCol = ( windowIdx % m_windowsPerRow ) * m_windowWidth;
+          window.m_colsBound = std::min( window.m_firstCol + m_windowWidth, m_nCols );
+
+          window.m_haloFirstRow = ( window.m_firstRow > m_haloRows ) ?
+            ( window.m_firstRow - m_haloRows ) : 0;
+          window.m_haloRowsBound = std::min( window.m_rowsBound + m_haloRows, m_nRows );
+          window.m_haloFirstCol = ( window.m_firstCol > m_haloCols ) ?
+            ( window.m_firstCol - m_haloCols ) : 0;
+          window.m_haloColsBound = std::min( window.m_colsBound + m_haloCols, m_nCols );
+        }
+
+        void updateProgress()
+        {
+          if( m_progressPtr )
+          {
+            const int processedWindowsNumber = (int)m_processedWindowsNumber;
+
+            if( processedWindowsNumber != m_progressPtr->getCurrentStep() )
+            {
+              m_progressPtr->setCurrentStep( processedWindowsNumber );
+            }
+
+            if( ! m_progressPtr->isActive() )
+            {
+              fail();
+            }
+          }
+        }
+    };
+
+    BlockProcessor::BlockProcessor()
+    : m_outputRasterPtr( 0 ), m_haloRows( 0 ), m_haloCols( 0 ),
+      m_threadsNumber( 0 ), m_enableProgress( false ), m_externalTokenPtr( 0 )
+    {
+    }
+
+    BlockProcessor::~BlockProcessor()
+    {
+    }
+
+    void BlockProcessor::setOutputRaster( te::rst::Raster& outputRaster )
+    {
+      m_outputRasterPtr = &outputRaster;
+    }
+
+    unsigned int BlockProcessor::addInputRaster( te::rst::Raster const& inputRaster )
+    {
+      m_inputRasters.push_back( &inputRaster );
+
+      return (unsigned int)( m_inputRasters.size() - 1 );
+    }
+
+    void BlockProcessor::setHalo( const unsigned int haloRows,
+      const unsigned int haloCols )
+    {
+      m_haloRows = haloRows;
+      m_haloCols = haloCols;
+    }
+
+    void BlockProcessor::setThreadsNumber( const unsigned int threadsNumber )
+    {
+      m_threadsNumber = threadsNumber;
+    }
+
+    unsigned int BlockProcessor::getThreadsNumber() const
+    {
+      return std::max( 1u, ( m_threadsNumber == 0 ) ?
+        ThreadPool::getInstance().getThreadsNumber() : m_threadsNumber );
+    }
+
+    void BlockProcessor::enableProgress( const std::string& message )
+    {
+      m_enableProgress = true;
+      m_progressMessage = message;
+    }
+
+    void BlockProcessor::setCancellationToken( CancellationToken const* tokenPtr )
+    {
+      m_externalTokenPtr = tokenPtr;
+    }
+
+    bool BlockProcessor::execute( const BlockFunctionT& blockFunction )
+    {
+      TERP_TRUE_OR_RETURN_FALSE( m_outputRasterPtr || ( ! m_inputRasters.empty() ),
+        "Invalid output raster" );
+      TERP_TRUE_OR_RETURN_FALSE( ( m_outputRasterPtr == 0 ) ||
+        ( m_outputRasterPtr->getAccessPolicy() & te::common::WAccess ),
+        "Invalid output raster" );
+      TERP_TRUE_OR_RETURN_FALSE( ! blockFunction.empty(), "Invalid block function" );
+
+      // The windows are defined by the output raster or, for reductions, by the first input raster
+
+      te::rst::Raster const& refRaster = m_outputRasterPtr ? *m_outputRasterPtr :
+        *m_inputRasters[ 0 ];
+
+      TERP_TRUE_OR_RETURN_FALSE( refRaster.getNumberOfBands() > 0,
+        "Invalid output raster" );
+
+      const unsigned int nRows = (unsigned int)refRaster.getNumberOfRows();
+      const unsigned int nCols = (unsigned int)refRaster.getNumberOfColumns();
+      const unsigned int refBandsNumber = (unsigned int)refRaster.getNumberOfBands();
+
+      for( unsigned int inputRasterIdx = 0 ; inputRasterIdx < m_inputRasters.size() ;
+        ++inputRasterIdx )
+      {
+        te::rst::Raster const& inputRaster = *m_inputRasters[ inputRasterIdx ];
+
+        TERP_TRUE_OR_RETURN_FALSE( inputRaster.getAccessPolicy() & te::common::RAccess,
+          "Invalid input raster" );
+        TERP_TRUE_OR_RETURN_FALSE( ( &inputRaster != m_outputRasterPtr ) ||
+          ( ( m_haloRows == 0 ) && ( m_haloCols == 0 ) ),
+          "The output raster can only be an input raster without halo" );
+      }
+
+      if( ( nRows == 0 ) || ( nCols == 0 ) ) return true;
+
+      // Windows geometry (aligned with the reference raster blocks)
+
+      const te::rst::BandProperty& outBandProp = *refRaster.getBand( 0 )->getProperty();
+
+      bool sameBlocking = ( outBandProp.m_blkw > 0 ) && ( outBandProp.m_blkh > 0 );
+
+      for( unsigned int bandIdx = 1 ; sameBlocking && ( bandIdx < refBandsNumber ) ;
+        ++bandIdx )
+      {
+        const te::rst::BandProperty& bandProp = *refRaster.getBand( bandIdx )->getProperty();
+
+        sameBlocking = ( bandProp.m_blkw == outBandProp.m_blkw ) &&
+          ( bandProp.m_blkh == outBandProp.m_blkh );
+      }
+
+      const unsigned int blkW = ( outBandProp.m_blkw > 0 ) ?
+        std::min( (unsigned int)outBandProp.m_blkw, nCols ) : nCols;
+      const unsigned int blkH = ( outBandProp.m_blkh > 0 ) ?
+        std::min( (unsigned int)outBandProp.m_blkh, nRows ) : 1;
+      const unsigned int blocksPerColumn = ( nRows + blkH - 1 ) / blkH;
+      const unsigned int blockRowsPerWindow = std::max( 1u, std::min( blocksPerColumn,
+        ( TERP_BLOCKPROCESSOR_MIN_TASK_PIXELS + ( blkW * blkH ) - 1 ) / ( blkW * blkH ) ) );
+
+      boost::shared_ptr< ExecutionState > statePtr( new ExecutionState );
+      ExecutionState& state = *statePtr;
+
+      state.m_blockFunction = blockFunction;
+      state.m_inputRasters = m_inputRasters;
+      state.m_outputRasterPtr = m_outputRasterPtr;
+      state.m_nRows = nRows;
+      state.m_nCols = nCols;
+      state.m_windowWidth = blkW;
+      state.m_windowHeight = blkH * blockRowsPerWindow;
+      state.m_windowsPerRow = ( nCols + blkW - 1 ) / blkW;
+      state.m_windowsNumber = state.m_windowsPerRow * ( ( nRows +
+        state.m_windowHeight - 1 ) / state.m_windowHeight );
+      state.m_haloRows = m_haloRows;
+      state.m_haloCols = m_haloCols;
+      state.m_externalTokenPtr = m_externalTokenPtr;
+
+      // Finding the number of threads
+
+      unsigned int threadsNumber = 1;
+
+      if( sameBlocking && ( m_threadsNumber != 1 ) )
+      {
+        threadsNumber = std::max( 1u, std::min( state.m_windowsNumber,
+          getThreadsNumber() ) );
+      }
+
+      // Creating the synchronizers and finding the threads cache sizes
+
+      if( threadsNumber > 1 )
+      {
+        if( m_outputRasterPtr )
+        {
+          state.m_outputSync.reset( new te::rst::RasterSynchronizer(
+            *m_outputRasterPtr, te::common::RWAccess ) );
+          state.m_outputMaxCachedBlocks = blockRowsPerWindow * refBandsNumber;
+        }
+
+        for( unsigned int inputRasterIdx = 0 ; inputRasterIdx < m_inputRasters.size() ;
+          ++inputRasterIdx )
+        {
+          te::rst::Raster const& inputRaster = *m_inputRasters[ inputRasterIdx ];
+          unsigned int inputMaxCachedBlocks = 0;
+
+          if( &inputRaster != m_outputRasterPtr )
+          {
+            // An input added more than once shares the same synchronizer
+
+            boost::shared_ptr< te::rst::RasterSynchronizer > inputSyncPtr;
+
+            for( unsigned int prevInputRasterIdx = 0 ; prevInputRasterIdx < inputRasterIdx ;
+              ++prevInputRasterIdx )
+            {
+              if( m_inputRasters[ prevInputRasterIdx ] == &inputRaster )
+              {
+                inputSyncPtr = state.m_inputSyncs[ prevInputRasterIdx ];
+              }
+            }
+
+            if( ! inputSyncPtr )
+            {
+              inputSyncPtr.reset( new te::rst::RasterSynchronizer(
+                (te::rst::Raster&)inputRaster, te::common::RAccess ) );
+            }
+
+            state.m_inputSyncs.push_back( inputSyncPtr );
+
+            // The window area inside this input grid (inputs with other dimensions are resampled)
+
+            const unsigned int inWindowWidth = (unsigned int)std::ceil(
+              (double)( state.m_windowWidth + 2 * m_haloCols ) *
+              (double)inputRaster.getNumberOfColumns() / (double)nCols );
+            const unsigned int inWindowHeight = (unsigned int)std::ceil(
+              (double)( state.m_windowHeight + 2 * m_haloRows ) *
+              (double)inputRaster.getNumberOfRows() / (double)nRows );
+
+            for( unsigned int bandIdx = 0 ; bandIdx < inputRaster.getNumberOfBands() ;
+              ++bandIdx )
+            {
+              const te::rst::BandProperty& inBandProp = *inputRaster.getBand( bandIdx )->getProperty();
+
+              inputMaxCachedBlocks +=
+                ( ( inWindowWidth / std::max( 1, inBandProp.m_blkw ) ) + 2 )
+                *
+                ( ( inWindowHeight / std::max( 1, inBandProp.m_blkh ) ) + 2 );
+            }
+          }
+          else
+          {
+            state.m_inputSyncs.push_back( boost::shared_ptr< te::rst::RasterSynchronizer >() );
+          }
+
+          state.m_inputMaxCachedBlocks.push_back( inputMaxCachedBlocks );
+        }
+      }
+      else
+      {
+        state.m_inputSyncs.resize( m_inputRasters.size() );
+        state.m_inputMaxCachedBlocks.resize( m_inputRasters.size(), 0 );
+      }
+
+      // Processing
+
+      std::auto_ptr< te::common::TaskProgress > progressPtr;
+      if( m_enableProgress )
+      {
+        progressPtr.reset( new te::common::TaskProgress( m_progressMessage,
+          te::common::TaskProgress::UNDEFINED, (int)state.m_windowsNumber ) );
+        state.m_progressPtr = progressPtr.get();
+      }
+
+      for( unsigned int threadIdx = 1 ; threadIdx < threadsNumber ; ++threadIdx )
+      {
+        ThreadPool::getInstance().submit( boost::bind( &BlockProcessor::runBlocks,
+          statePtr, threadIdx ) );
+      }
+
+      runBlocks( statePtr, 0 );
+
+      // Waiting for the threads already processing windows, the others will not start
+
+      {
+        boost::unique_lock< boost::mutex > lock( state.m_mutex );
+
+        state.m_closed = true;
+
+        while( state.m_runningThreadsNumber > 0 )
+        {
+          state.m_condVar.timed_wait( lock, boost::posix_time::milliseconds( 100 ) );
+
+          state.updateProgress();
+        }
+      }
+
+      state.updateProgress();
+      state.m_progressPtr = 0;
+
+      state.m_inputSyncs.clear();
+      state.m_outputSync.reset();
+
+      if( state.m_exception )
+      {
+        std::rethrow_exception( state.m_exception );
+      }
+
+      return state.m_returnValue && ( ! state.isCancelled() );
+    }
+
+    void BlockProcessor::runBlocks( boost::shared_ptr< ExecutionState > statePtr,
+      const unsigned int threadIndex )
+    {
+      ExecutionState& state = *statePtr;
+
+      {
+        boost::lock_guard< boost::mutex > lock( state.m_mutex );
+
+        if( state.m_closed ) return;
+
+        ++state.m_runningThreadsNumber;
+      }
+
+      try
+      {
+        // Instantiating the local rasters instances (destroyed at the end, writing the cached output blocks)
+
+        std::vector< boost::shared_ptr< te::rst::Raster > > localRasters;
+
+        BlockContext context;
+        context.m_threadIndex = threadIndex;
+        context.m_internalTokenPtr = &state.m_internalToken;
+        context.m_externalTokenPtr = state.m_externalTokenPtr;
+
+        if( state.m_outputSync.get() )
+        {
+          localRasters.push_back( boost::shared_ptr< te::rst::Raster >(
+            new te::rst::SynchronizedRaster( state.m_outputMaxCachedBlocks,
+            *state.m_outputSync ) ) );
+          context.m_outputRasterPtr = localRasters.back().get();
+        }
+        else
+        {
+          context.m_outputRasterPtr = state.m_outputRasterPtr;
+        }
+
+        for( unsigned int inputRasterIdx = 0 ; inputRasterIdx < state.m_inputRasters.size() ;
+          ++inputRasterIdx )
+        {
+          if( state.m_inputRasters[ inputRasterIdx ] == state.m_outputRasterPtr )
+          {
+            context.m_inputRasters.push_back( context.m_outputRasterPtr );
+          }
+          else if( state.m_inputSyncs[ inputRasterIdx ].get() )
+          {
+            localRasters.push_back( boost::shared_ptr< te::rst::Raster >(
+              new te::rst::SynchronizedRaster( state.m_inputMaxCachedBlocks[ inputRasterIdx ],
+              *state.m_inputSyncs[ inputRasterIdx ] ) ) );
+            context.m_inputRasters.push_back( localRasters.back().get() );
+          }
+          else
+          {
+            context.m_inputRasters.push_back( state.m_inputRasters[ inputRasterIdx ] );
+          }
+        }
+
+        BlockWindow window;
+        unsigned int windowIdx = 0;
+
+        while( ! state.isCancelled() )
+        {
+          windowIdx = state.m_nextWindowIdx++;
+
+          if( windowIdx >= state.m_windowsNumber ) break;
+
+          state.getWindow( windowIdx, window );
+
+          if( ! state.m_blockFunction( window, context ) )
+          {
+            state.fail();
+            break;
+          }
+
+          ++state.m_processedWindowsNumber;
+
+          if( threadIndex == 0 )
+          {
+            state.updateProgress();
+          }
+        }
+      }
+      catch( ... )
+      {
+        boost::lock_guard< boost::mutex > lock( state.m_mutex );
+
+        if( ! state.m_exception ) state.m_exception = std::current_exception();
+        state.fail();
+      }
+
+      {
+        boost::lock_guard< boost::mutex > lock( state.m_mutex );
+
+        --state.m_runningThreadsNumber;
+      }
+
+      state.m_condVar.notify_all();
+    }
+
+  } // end namespace rp
+}   // end namespace te
+
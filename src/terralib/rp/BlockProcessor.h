@@ -0,0 +1,294 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/rp/BlockProcessor.h
+  \brief Parallel execution of a function over the blocks of an output raster.
+ */
+
+#ifndef __TERRALIB_RP_INTERNAL_BLOCKPROCESSOR_H
+#define __TERRALIB_RP_INTERNAL_BLOCKPROCESSOR_H
+
+#include "Config.h"
+
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace te
+{
+  namespace rst
+  {
+    class Raster;
+  }
+
+  namespace rp
+  {
+    /*!
+      \class CancellationToken
+      \brief A flag used to cooperatively stop a parallel execution.
+      \details The running block functions are not interrupted: the remaining blocks are
+      skipped and the functions may test the flag to stop a long computation (see BlockContext::isCancelled).
+      \ingroup rp_aux
+     */
+    class TERPEXPORT CancellationToken : public boost::noncopyable
+    {
+      public :
+
+        CancellationToken();
+
+        ~CancellationToken();
+
+        /*! \brief Requests the cancellation. */
+        void cancel();
+
+        /*!
+          \brief Returns true if the cancellation was requested.
+          \return Returns true if the cancellation was requested.
+         */
+        bool isCancelled() const;
+
+        /*! \brief Clears the cancellation request. */
+        void reset();
+
+      protected :
+
+        std::atomic< bool > m_cancelled; //!< True if the cancellation was requested.
+    };
+
+    /*!
+      \class BlockWindow
+      \brief The output raster area processed by one call of a block function.
+      \details The output area is aligned with the output raster blocks. The input area is the output
+      area expanded by the halo and clipped to the raster limits.
+      \ingroup rp_aux
+     */
+    class TERPEXPORT BlockWindow
+    {
+      public :
+
+        unsigned int m_firstRow; //!< The first output row.
+
+        unsigned int m_rowsBound; //!< The last output row plus one.
+
+        unsigned int m_firstCol; //!< The first output column.
+
+        unsigned int m_colsBound; //!< The last output column plus one.
+
+        unsigned int m_haloFirstRow; //!< The first input row.
+
+        unsigned int m_haloRowsBound; //!< The last input row plus one.
+
+        unsigned int m_haloFirstCol; //!< The first input column.
+
+        unsigned int m_haloColsBound; //!< The last input column plus one.
+
+        BlockWindow();
+
+        ~BlockWindow();
+    };
+
+    class BlockProcessor;
+
+    /*!
+      \class BlockContext
+      \brief The rasters used by one thread to execute the block functions.
+      \details When multiple threads are used, the rasters are synchronized raster instances owned by the
+      thread (te::rst::SynchronizedRaster), with their own blocks cache.
+      \note The block functions must only write the output pixels of the given block window.
+      \ingroup rp_aux
+     */
+    class TERPEXPORT BlockContext : public boost::noncopyable
+    {
+      friend class BlockProcessor;
+
+      public :
+
+        ~BlockContext();
+
+        /*!
+          \brief Returns an input raster.
+          \param inputRasterIdx The input raster index (the order of BlockProcessor::addInputRaster calls).
+          \return Returns an input raster.
+         */
+        te::rst::Raster const& getInputRaster( const unsigned int inputRasterIdx ) const;
+
+        /*!
+          \brief Returns the output raster.
+          \return Returns the output raster.
+          \note Throws an exception when the processor has no output raster.
+         */
+        te::rst::Raster& getOutputRaster() const;
+
+        /*!
+          \brief Returns the index of the thread using this context, in the range [0, threads number).
+          \return Returns the index of the thread using this context.
+         */
+        unsigned int getThreadIndex() const;
+
+        /*!
+          \brief Returns true if the execution was cancelled.
+          \return Returns true if the execution was cancelled.
+         */
+        bool isCancelled() const;
+
+      protected :
+
+        std::vector< te::rst::Raster const* > m_inputRasters; //!< The input rasters.
+
+        te::rst::Raster* m_outputRasterPtr; //!< The output raster.
+
+        unsigned int m_threadIndex; //!< The thread index.
+
+        CancellationToken const* m_internalTokenPtr; //!< The execution cancellation token.
+
+        CancellationToken const* m_externalTokenPtr; //!< The user cancellation token (or null).
+
+        BlockContext();
+    };
+
+    /*!
+      \class BlockProcessor
+      \brief Parallel execution of a function over the blocks of an output raster.
+      \details The output raster is divided in windows aligned with its blocks and the block function
+      is called once for each window, by the calling thread and by tasks executed in the global
+      ThreadPool. Each thread reads the input rasters and writes the output raster through its own
+      te::rst::SynchronizedRaster instances. The halo expands the input area of each window
+      for the algorithms that need the neighbourhood of the output pixels (filters, for example).
+      The execution is cancelled when a block function returns false, when the
+      progress interface is cancelled or through an user cancellation token.
+      \note Multiple threads are only used when all the output bands have the same blocking scheme,
+      otherwise the blocks are processed by the calling thread.
+      \note An input raster may be the output raster only when the halo is zero.
+      \note Without an output raster the windows are aligned with the first input raster blocks and the block
+      functions only read (reductions accumulating one partial result per thread, see BlockContext::getThreadIndex).
+      \note Input rasters with other dimensions are also read through per-thread synchronized instances, the block
+      function must map the window coordinates to their grids (resampling, for example).
+      \ingroup rp_aux
+     */
+    class TERPEXPORT BlockProcessor : public boost::noncopyable
+    {
+      public :
+
+        /*!
+          \brief Block function type definition.
+          \details The function receives the window to process and the context of the calling thread.
+          It returns false on errors (the execution is cancelled).
+         */
+        typedef boost::function< bool ( const BlockWindow&, BlockContext& ) > BlockFunctionT;
+
+        BlockProcessor();
+
+        ~BlockProcessor();
+
+        /*!
+          \brief Sets the output raster.
+          \param outputRaster The output raster (write access).
+          \note When no output raster is set, the windows are defined by the first input raster.
+         */
+        void setOutputRaster( te::rst::Raster& outputRaster );
+
+        /*!
+          \brief Adds an input raster.
+          \param inputRaster An input raster (usually with the output raster dimensions).
+          \return Returns the input raster index (see BlockContext::getInputRaster).
+         */
+        unsigned int addInputRaster( te::rst::Raster const& inputRaster );
+
+        /*!
+          \brief Sets the halo (the number of neighbour input rows and columns read around each window).
+          \param haloRows The number of rows.
+          \param haloCols The number of columns.
+         */
+        void setHalo( const unsigned int haloRows, const unsigned int haloCols );
+
+        /*!
+          \brief Sets the number of threads.
+          \param threadsNumber The number of threads to use (0:automatic , 1:disabled, any other integer dictates the number of threads).
+         */
+        void setThreadsNumber( const unsigned int threadsNumber );
+
+        /*!
+          \brief Returns the maximum number of threads used by execute (the bound of BlockContext::getThreadIndex).
+          \return Returns the maximum number of threads used by execute.
+         */
+        unsigned int getThreadsNumber() const;
+
+        /*!
+          \brief Enables the progress interface.
+          \param message The progress message.
+         */
+        void enableProgress( const std::string& message );
+
+        /*!
+          \brief Sets an user cancellation token.
+          \param tokenPtr A pointer to the token (or null). It must exist until the end of the execution.
+         */
+        void setCancellationToken( CancellationToken const* tokenPtr );
+
+        /*!
+          \brief Executes the block function over all the output raster blocks.
+          \param blockFunction The block function.
+          \return true if OK, false on errors or cancellation.
+          \note The first exception thrown by the block function is rethrown by this method, keeping its type.
+         */
+        bool execute( const BlockFunctionT& blockFunction );
+
+      protected :
+
+        te::rst::Raster* m_outputRasterPtr; //!< The output raster.
+
+        std::vector< te::rst::Raster const* > m_inputRasters; //!< The input rasters.
+
+        unsigned int m_haloRows; //!< The number of halo rows.
+
+        unsigned int m_haloCols; //!< The number of halo columns.
+
+        unsigned int m_threadsNumber; //!< The number of threads to use (0:automatic , 1:disabled, any other integer dictates the number of threads).
+
+        bool m_enableProgress; //!< Enable/Disable the progress interface.
+
+        std::string m_progressMessage; //!< The progress message.
+
+        CancellationToken const* m_externalTokenPtr; //!< The user cancellation token (or null).
+
+        /*!
+          \class ExecutionState
+          \brief The state shared by the threads of one execution.
+         */
+        class ExecutionState;
+
+        /*!
+          \brief Processes windows until there are no more windows or the execution is cancelled.
+          \param statePtr The execution state.
+          \param threadIndex The thread index (0 for the calling thread).
+         */
+        static void runBlocks( boost::shared_ptr< ExecutionState > statePtr,
+          const unsigned int threadIndex );
+    };
+
+  } // end namespace rp
+}   // end namespace te
+
+#endif  // __TERRALIB_RP_INTERNAL_BLOCKPROCESSOR_H
+
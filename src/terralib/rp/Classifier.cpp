@@ -79,6 +79,7 @@ void te::rp::Classifier::InputParameters::reset() throw(te::rp::Exception)
   m_inputRasterBands.clear();
   m_inputPolygons.clear();
   m_strategyName.clear();
+  m_enableMultiThread = true;
 
   if(m_classifierStrategyParamsPtr)
   {
@@ -95,6 +96,7 @@ const te::rp::Classifier::InputParameters& te::rp::Classifier::InputParameters::
   m_inputRasterBands = params.m_inputRasterBands;
   m_inputPolygons = params.m_inputPolygons;
   m_strategyName = params.m_strategyName;
+  m_enableMultiThread = params.m_enableMultiThread;
 
   setClassifierStrategyParams(*params.m_classifierStrategyParamsPtr);
 
@@ -167,6 +169,8 @@ bool te::rp::Classifier::execute(AlgorithmOutputParameters& outputParams) throw(
   TERP_TRUE_OR_RETURN_FALSE(strategyPtr->initialize( m_inputParameters.getClassifierStrategyParams()),
                             "Unable to initialize the classification strategy");
 
+  strategyPtr->setThreadsNumber(m_inputParameters.m_enableMultiThread ? 0 : 1);
+
   std::vector<te::rst::BandProperty*> bandsProperties;
   const std::vector< int > outputDataTypes = strategyPtr->getOutputDataTypes();
 
@@ -115,6 +115,7 @@ namespace te
             std::vector<te::gm::Polygon*> m_inputPolygons;                //!< The polygons to be classified when using object-based image analysis (OBIA).
             std::string m_strategyName;                                   //!< The classifier strategy name see each te::rp::ClassifierStrategyFactory inherited classes documentation for reference.
             ClassifierStrategyParameters* m_classifierStrategyParamsPtr;  //!< Internal specific classifier strategy parameters.
+            bool m_enableMultiThread;                                     //!< Enable/disable the use of threads by the strategies block classification stage (default:true).
 
         };
 
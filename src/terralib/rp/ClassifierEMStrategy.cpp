@@ -28,7 +28,6 @@
 #include "../common/progress/TaskProgress.h"
 #include "../raster/Grid.h"
 #include "../raster/PositionIterator.h"
-#include "../raster/RasterIterator.h"
 #include "../raster/Utils.h"
 #include "ClassifierEMStrategy.h"
 #include "Macros.h"
@@ -207,75 +206,49 @@ bool te::rp::ClassifierEMStrategy::execute(const te::rst::Raster& inputRaster, c
   double sum_PCj_Xk;
   double numerator_PCj_Xk;
   double denominator_PCj_Xk;
-  double det_SIGMAj;
-  double det_SIGMAj2;
   double distance_MUj;
 
   boost::numeric::ublas::matrix<double> Xk_minus_MUj(S, 1);
   boost::numeric::ublas::matrix<double> Xk_minus_MUj_T(1, S);
   boost::numeric::ublas::matrix<double> product_NETAj(1, 1);
-  boost::numeric::ublas::matrix<double> product_NETAj2(1, 1);
-  boost::numeric::ublas::matrix<double> inverse_SIGMAj(S, S);
-  boost::numeric::ublas::matrix<double> inverse_SIGMAj2(S, S);
   boost::numeric::ublas::matrix<double> product_Xk_minusMUj(S, S);
   boost::numeric::ublas::matrix<double> sum_product_Xk_minusMUj(S, S);
 
+  std::vector<boost::numeric::ublas::matrix<double> > inverse_SIGMAj(M);
+  std::vector<double> det_SIGMAj(M);
+
   te::common::TaskProgress task(TE_TR("Expectation Maximization algorithm - estimating clusters"), te::common::TaskProgress::UNDEFINED, m_parameters.m_maxIterations);
   for (unsigned int i = 0; i < m_parameters.m_maxIterations; i++)
   {
-// computing PCj_Xk
+// the determinants and inverse matrices only change once per iteration
     for (unsigned int j = 0; j < M; j++)
-    {
-      te::common::GetDeterminant(SIGMAj[j], det_SIGMAj);
-      if (det_SIGMAj >= 0.0)
-        det_SIGMAj = pow(det_SIGMAj, -0.5);
-      else
-        det_SIGMAj = 1.0;
+      getClusterTerms(SIGMAj[j], inverse_SIGMAj[j], det_SIGMAj[j]);
 
-      for (unsigned int k = 0; k < N; k++)
+// computing PCj_Xk
+    for (unsigned int k = 0; k < N; k++)
+    {
+// computing the numerator of equation for PCj_Xk for every cluster, the denominator is their sum
+      denominator_PCj_Xk = 0.0;
+      for (unsigned int j = 0; j < M; j++)
       {
-// computing numerator of equation for PCj_Xk
-        numerator_PCj_Xk = 0.0;
         for (unsigned int l = 0; l < S; l++)
           Xk_minus_MUj(l, 0) = Xk(k, l) - MUj(j, l);
         Xk_minus_MUj_T = boost::numeric::ublas::trans(Xk_minus_MUj);
 
-        te::common::GetInverseMatrix(SIGMAj[j], inverse_SIGMAj);
-
-        product_NETAj = prod(Xk_minus_MUj_T, inverse_SIGMAj);
+        product_NETAj = prod(Xk_minus_MUj_T, inverse_SIGMAj[j]);
         product_NETAj = prod(product_NETAj, Xk_minus_MUj);
         product_NETAj *= -0.5;
 
-        numerator_PCj_Xk = det_SIGMAj * exp(product_NETAj(0, 0)) * Pj(j, 0);
-
-// computing denominator of equation for PCj_Xk
-        denominator_PCj_Xk = 0.0;
-        for (unsigned int j2 = 0; j2 < M; j2++)
-        {
-          te::common::GetDeterminant(SIGMAj[j2], det_SIGMAj2);
-          if (det_SIGMAj2 >= 0.0)
-            det_SIGMAj2 = pow(det_SIGMAj2, -0.5);
-          else
-            det_SIGMAj2 = 1.0;
-
-          for (unsigned int l = 0; l < S; l++)
-            Xk_minus_MUj(l, 0) = Xk(k, l) - MUj(j2, l);
-          Xk_minus_MUj_T = boost::numeric::ublas::trans(Xk_minus_MUj);
-
-          te::common::GetInverseMatrix(SIGMAj[j2], inverse_SIGMAj2);
+        numerator_PCj_Xk = det_SIGMAj[j] * exp(product_NETAj(0, 0)) * Pj(j, 0);
 
-          product_NETAj2 = prod(Xk_minus_MUj_T, inverse_SIGMAj2);
-          product_NETAj2 = prod(product_NETAj2, Xk_minus_MUj);
-          product_NETAj2 *= -0.5;
-
-          denominator_PCj_Xk += det_SIGMAj2 * exp(product_NETAj2(0, 0)) * Pj(j2, 0);
-        }
-        if (denominator_PCj_Xk == 0.0)
-          denominator_PCj_Xk = 0.0000000001;
-
-// computing PCj_Xk
-        PCj_Xk(j, k) = numerator_PCj_Xk / denominator_PCj_Xk;
+        PCj_Xk(j, k) = numerator_PCj_Xk;
+        denominator_PCj_Xk += numerator_PCj_Xk;
       }
+      if (denominator_PCj_Xk == 0.0)
+        denominator_PCj_Xk = 0.0000000001;
+
+      for (unsigned int j = 0; j < M; j++)
+        PCj_Xk(j, k) /= denominator_PCj_Xk;
     }
 
 // computing SIGMAj for t + 1
@@ -347,100 +320,122 @@ bool te::rp::ClassifierEMStrategy::execute(const te::rst::Raster& inputRaster, c
     task.pulse();
   }
 
-// classifying image
-  te::rst::RasterIterator<double> it = te::rst::RasterIterator<double>::begin((te::rst::Raster*) &inputRaster, inputRasterBands);
-  te::rst::RasterIterator<double> itend = te::rst::RasterIterator<double>::end((te::rst::Raster*) &inputRaster, inputRasterBands);
-
-  boost::numeric::ublas::matrix<double> X = boost::numeric::ublas::matrix<double>(1, S);
-  boost::numeric::ublas::matrix<double> PCj_X = boost::numeric::ublas::matrix<double>(M, 1);
-
-  double max_PCj_X;
-  unsigned int cluster;
+// storing the estimated clusters in the layout used by classifyBlock
+  m_clustersMeansValues.resize(M * S);
+  m_clustersCovarianceInvMatrixesValues.resize(M * S * S);
+  m_clustersDetTerms.resize(M);
+  m_clustersProbabilities.resize(M);
 
-  double numerator_PCj_X;
-  double denominator_PCj_X;
-
-  boost::numeric::ublas::matrix<double> X_minus_MUj(S, 1);
-  boost::numeric::ublas::matrix<double> X_minus_MUj_T(1, S);
-
-  task.setTotalSteps(inputRaster.getNumberOfColumns() * inputRaster.getNumberOfRows());
-  task.setMessage(TE_TR("Expectation Maximization algorithm - classifying image"));
-  task.setCurrentStep(0);
-  while (it != itend)
+  for (unsigned int j = 0; j < M; j++)
   {
-    for (unsigned int l = 0; l < S; l++)
-      X(0, l) = (*it)[l];
+    getClusterTerms(SIGMAj[j], inverse_SIGMAj[j], det_SIGMAj[j]);
 
-// computing PCj_X
-    for (unsigned int j = 0; j < M; j++)
+    for (unsigned int l = 0; l < S; l++)
     {
-// computing numerator of equation for PCj_X
-      te::common::GetDeterminant(SIGMAj[j], det_SIGMAj);
-      if (det_SIGMAj >= 0.0)
-        det_SIGMAj = pow(det_SIGMAj, -0.5);
-      else
-        det_SIGMAj = 1.0;
-
-      numerator_PCj_X = 0.0;
-      for (unsigned int l = 0; l < S; l++)
-        X_minus_MUj(l, 0) = X(0, l) - MUj(j, l);
-      X_minus_MUj_T = boost::numeric::ublas::trans(X_minus_MUj);
+      m_clustersMeansValues[j * S + l] = MUj(j, l);
 
-      te::common::GetInverseMatrix(SIGMAj[j], inverse_SIGMAj);
+      for (unsigned int l2 = 0; l2 < S; l2++)
+        m_clustersCovarianceInvMatrixesValues[(j * S + l) * S + l2] = inverse_SIGMAj[j](l, l2);
+    }
 
-      product_NETAj = prod(X_minus_MUj_T, inverse_SIGMAj);
-      product_NETAj = prod(product_NETAj, X_minus_MUj);
-      product_NETAj *= -0.5;
+    m_clustersDetTerms[j] = det_SIGMAj[j];
+    m_clustersProbabilities[j] = Pj(j, 0);
+  }
 
-      numerator_PCj_X = det_SIGMAj * exp(product_NETAj(0, 0)) * Pj(j, 0);
+// classifying image
+  return executeBlockClassification(inputRaster, inputRasterBands, outputRaster, outputRasterBand,
+    enableProgressInterface, TE_TR("Expectation Maximization algorithm - classifying image"));
+}
 
-// computing denominator of equation for PCj_X
-      denominator_PCj_X = 0.0;
-      for (unsigned int j2 = 0; j2 < M; j2++)
-      {
-        te::common::GetDeterminant(SIGMAj[j2], det_SIGMAj2);
-        if (det_SIGMAj2 >= 0.0)
-          det_SIGMAj2 = pow(det_SIGMAj2, -0.5);
-        else
-          det_SIGMAj2 = 1.0;
+bool te::rp::ClassifierEMStrategy::classifyBlock(double const* const samples,
+  const unsigned int pixelsNumber, unsigned int* const labels) const
+{
+  const unsigned int M = (unsigned int) m_clustersDetTerms.size();
+  const unsigned int S = (unsigned int) (m_clustersMeansValues.size() / M);
+  std::vector<double> sampleMinusMean(S * pixelsNumber);
+  std::vector<double> mahalanobisDistances(pixelsNumber);
+  std::vector<double> maxNumerators(pixelsNumber, 0.0);
+  double* const sampleMinusMeanPtr = &sampleMinusMean[0];
+  double* const mahalanobisDistancesPtr = &mahalanobisDistances[0];
+  double* const maxNumeratorsPtr = &maxNumerators[0];
+  unsigned int p = 0;
+
+// pixels where every cluster probability vanishes are left unclassified (0)
+  for (p = 0; p < pixelsNumber; p++)
+    labels[p] = 0;
 
-        for (unsigned int l = 0; l < S; l++)
-          X_minus_MUj(l, 0) = X(0, l) - MUj(j2, l);
-        X_minus_MUj_T = boost::numeric::ublas::trans(X_minus_MUj);
+  for (unsigned int j = 0; j < M; j++)
+  {
+    const double detTerm = m_clustersDetTerms[j];
+    const double probability = m_clustersProbabilities[j];
 
-        te::common::GetInverseMatrix(SIGMAj[j2], inverse_SIGMAj2);
+    if (detTerm == 0.0)
+      continue;
 
-        product_NETAj2 = prod(X_minus_MUj_T, inverse_SIGMAj2);
-        product_NETAj2 = prod(product_NETAj2, X_minus_MUj);
-        product_NETAj2 *= -0.5;
+    double const* const covInvPtr = &m_clustersCovarianceInvMatrixesValues[j * S * S];
 
-        denominator_PCj_X += det_SIGMAj2 * exp(product_NETAj2(0, 0)) * Pj(j2, 0);
-      }
-      if (denominator_PCj_X == 0.0)
-        denominator_PCj_X = 0.0000000001;
+    for (unsigned int l = 0; l < S; l++)
+    {
+      double const* const bandSamplesPtr = samples + (l * pixelsNumber);
+      double* const bandSampleMinusMeanPtr = sampleMinusMeanPtr + (l * pixelsNumber);
+      const double mean = m_clustersMeansValues[j * S + l];
 
-      PCj_X(j, 0) = numerator_PCj_X / denominator_PCj_X;
+      for (p = 0; p < pixelsNumber; p++)
+        bandSampleMinusMeanPtr[p] = bandSamplesPtr[p] - mean;
     }
 
-    max_PCj_X = 0.0;
-    cluster = 0;
-    for (unsigned int j = 0; j < M; j++)
-      if (PCj_X(j, 0) > max_PCj_X)
+// (X - MUj)T * inverse(SIGMAj) * (X - MUj)
+    for (p = 0; p < pixelsNumber; p++)
+      mahalanobisDistancesPtr[p] = 0.0;
+
+    for (unsigned int l = 0; l < S; l++)
+    {
+      double const* const lDiffPtr = sampleMinusMeanPtr + (l * pixelsNumber);
+
+      for (unsigned int l2 = 0; l2 < S; l2++)
       {
-        max_PCj_X = PCj_X(j, 0);
-        cluster = j + 1;
+        double const* const l2DiffPtr = sampleMinusMeanPtr + (l2 * pixelsNumber);
+        const double coef = covInvPtr[l * S + l2];
+
+        for (p = 0; p < pixelsNumber; p++)
+          mahalanobisDistancesPtr[p] += coef * lDiffPtr[p] * l2DiffPtr[p];
       }
+    }
 
-// save cluster information in output raster
-    outputRaster.setValue(it.getColumn(), it.getRow(), cluster, outputRasterBand);
+// the denominator of PCj_X is the same for every cluster, comparing the numerators is enough
+    for (p = 0; p < pixelsNumber; p++)
+    {
+      const double numerator = detTerm * exp(-0.5 * mahalanobisDistancesPtr[p]) * probability;
 
-    ++it;
-    task.pulse();
+      if (numerator > maxNumeratorsPtr[p])
+      {
+        maxNumeratorsPtr[p] = numerator;
+        labels[p] = j + 1;
+      }
+    }
   }
 
   return true;
 }
 
+void te::rp::ClassifierEMStrategy::getClusterTerms(const boost::numeric::ublas::matrix<double>& covarianceMatrix,
+  boost::numeric::ublas::matrix<double>& inverseMatrix, double& detTerm)
+{
+  double determinant = 0.0;
+
+  if (!te::common::GetDeterminant(covarianceMatrix, determinant) ||
+      !te::common::GetInverseMatrix(covarianceMatrix, inverseMatrix))
+  {
+// a degenerated cluster (singular covariance) never attracts any pixel
+    inverseMatrix = boost::numeric::ublas::zero_matrix<double>(covarianceMatrix.size1(), covarianceMatrix.size2());
+    detTerm = 0.0;
+  }
+  else if (determinant > 0.0)
+    detTerm = pow(determinant, -0.5);
+  else
+    detTerm = 1.0;
+}
+
 te::rp::ClassifierEMStrategyFactory::ClassifierEMStrategyFactory()
   : te::rp::ClassifierStrategyFactory("em")
 {
@@ -109,6 +109,24 @@ namespace te
 
         bool m_isInitialized;                                        //!< True if this instance is initialized.
         ClassifierEMStrategy::Parameters m_parameters;               //!< Internal execution parameters.
+        std::vector<double> m_clustersMeansValues;                   //!< The estimated clusters means contiguous values ( [ clusterIdx * dims + dim ] ), updated by execute.
+        std::vector<double> m_clustersCovarianceInvMatrixesValues;   //!< The estimated clusters covariance inverse matrixes contiguous values ( [ clusterIdx * dims * dims + row * dims + col ] ), updated by execute.
+        std::vector<double> m_clustersDetTerms;                      //!< The inverse square root of each cluster covariance matrix determinant (zero for degenerated clusters), updated by execute.
+        std::vector<double> m_clustersProbabilities;                 //!< The estimated a priori probability of each cluster, updated by execute.
+
+        //overload
+        bool classifyBlock( double const* const samples, const unsigned int pixelsNumber,
+          unsigned int* const labels ) const;
+
+        /*!
+          \brief Compute the terms of a cluster density function that do not depend on the pixel value.
+
+          \param covarianceMatrix The cluster covariance matrix.
+          \param inverseMatrix The computed covariance inverse matrix.
+          \param detTerm The inverse square root of the covariance matrix determinant, or zero if the matrix cannot be inverted.
+        */
+        static void getClusterTerms( const boost::numeric::ublas::matrix<double>& covarianceMatrix,
+          boost::numeric::ublas::matrix<double>& inverseMatrix, double& detTerm );
 
     };
 
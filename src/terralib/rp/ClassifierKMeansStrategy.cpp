@@ -37,6 +37,7 @@
 
 // STL
 #include <iostream>
+#include <limits>
 #include <stdlib.h>
 
 namespace
@@ -81,6 +82,7 @@ te::common::AbstractParameters* te::rp::ClassifierKMeansStrategy::Parameters::cl
 te::rp::ClassifierKMeansStrategy::ClassifierKMeansStrategy()
 {
   m_isInitialized = false;
+  m_dimsNumber = 0;
 }
 
 te::rp::ClassifierKMeansStrategy::~ClassifierKMeansStrategy()
@@ -128,17 +130,12 @@ bool te::rp::ClassifierKMeansStrategy::execute(const te::rst::Raster& inputRaste
   classifierParameters.m_K = m_parameters.m_K;
   classifierParameters.m_maxIterations = m_parameters.m_maxIterations;
   classifierParameters.m_epsilon = m_parameters.m_epsilon;
-  std::vector<unsigned int> classification;
 
 // define point set iterators for training
   std::vector<te::gm::Point*> randomPoints = te::rst::GetRandomPointsInRaster(inputRaster, m_parameters.m_maxInputPoints);
   te::rst::PointSetIterator<double> pit = te::rst::PointSetIterator<double>::begin(&inputRaster, randomPoints);
   te::rst::PointSetIterator<double> pitend = te::rst::PointSetIterator<double>::end(&inputRaster, randomPoints);
 
-// define raster iterators for classification
-  te::rst::RasterIterator<double> rit = te::rst::RasterIterator<double>::begin((te::rst::Raster*) &inputRaster, inputRasterBands);
-  te::rst::RasterIterator<double> ritend = te::rst::RasterIterator<double>::end((te::rst::Raster*) &inputRaster, inputRasterBands);
-
 // execute the algorithm
   te::cl::KMeans<te::rst::PointSetIterator<double>, te::rst::RasterIterator<double> > classifier;
 
@@ -146,21 +143,61 @@ bool te::rp::ClassifierKMeansStrategy::execute(const te::rst::Raster& inputRaste
     throw;
   if(!classifier.train(pit, pitend, inputRasterBands, std::vector<unsigned int>(), true))
     throw;
-  if(!classifier.classify(rit, ritend, inputRasterBands, classification, true))
-    throw;
+
+// flattening the trained means (index 0 of the KMeans means is not used)
+  const std::vector<std::vector<double> >& kMeans = classifier.getMeans();
+  TERP_TRUE_OR_RETURN_FALSE(kMeans.size() == (m_parameters.m_K + 1), "Invalid trained means");
+
+  m_dimsNumber = (unsigned int)inputRasterBands.size();
+  m_means.clear();
+  for (unsigned int k = 1; k <= m_parameters.m_K; k++)
+    m_means.insert(m_means.end(), kMeans[k].begin(), kMeans[k].end());
 
 // classifying image
-  te::common::TaskProgress task;
-  task.setTotalSteps(inputRaster.getNumberOfColumns() * inputRaster.getNumberOfRows());
-  task.setMessage(TE_TR("KMeans algorithm - classifying image"));
-  task.setCurrentStep(0);
-  unsigned int i = 0;
-  while (rit != ritend)
+  return executeBlockClassification(inputRaster, inputRasterBands, outputRaster,
+    outputRasterBand, enableProgressInterface, TE_TR("KMeans algorithm - classifying image"));
+}
+
+bool te::rp::ClassifierKMeansStrategy::classifyBlock(double const* const samples,
+  const unsigned int pixelsNumber, unsigned int* const labels) const
+{
+  std::vector<double> minDistances(pixelsNumber, std::numeric_limits<double>::max());
+  std::vector<double> distances(pixelsNumber);
+  double* const minDistancesPtr = &minDistances[0];
+  double* const distancesPtr = &distances[0];
+  unsigned int p = 0;
+  unsigned int dim = 0;
+
+  for (p = 0; p < pixelsNumber; p++)
+    labels[p] = 0;
+
+  for (unsigned int k = 0; k < m_parameters.m_K; k++)
   {
-    outputRaster.setValue(rit.getColumn(), rit.getRow(), classification[i], outputRasterBand);
-    ++i;
-    ++rit;
-    task.pulse();
+    double const* const meanPtr = &m_means[k * m_dimsNumber];
+
+    for (p = 0; p < pixelsNumber; p++)
+      distancesPtr[p] = 0.0;
+
+    for (dim = 0; dim < m_dimsNumber; dim++)
+    {
+      double const* const dimSamplesPtr = samples + (dim * pixelsNumber);
+      const double mean = meanPtr[dim];
+
+      for (p = 0; p < pixelsNumber; p++)
+      {
+        const double diff = dimSamplesPtr[p] - mean;
+        distancesPtr[p] += diff * diff;
+      }
+    }
+
+    for (p = 0; p < pixelsNumber; p++)
+    {
+      if (distancesPtr[p] < minDistancesPtr[p])
+      {
+        minDistancesPtr[p] = distancesPtr[p];
+        labels[p] = k + 1;
+      }
+    }
   }
 
   return true;
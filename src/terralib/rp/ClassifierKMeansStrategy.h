@@ -102,6 +102,12 @@ namespace te
 
         bool m_isInitialized;                                        //!< True if this instance is initialized.
         ClassifierKMeansStrategy::Parameters m_parameters;           //!< Internal execution parameters.
+        std::vector< double > m_means;                               //!< The trained means, one contiguous row of m_dimsNumber values for each class (class k label is k + 1).
+        unsigned int m_dimsNumber;                                   //!< The number of dimensions (bands) of each mean.
+
+        // overload
+        bool classifyBlock( double const* const samples, const unsigned int pixelsNumber,
+          unsigned int* const labels ) const;
 
     };
 
@@ -99,6 +99,8 @@ bool te::rp::ClassifierMAPStrategy::initialize(
   m_classesCovarianceMatrixes.clear();
   m_classesCovarianceInvMatrixes.clear();
   m_classesOptizedMAPDiscriminantTerm.clear();  
+  m_classesCovarianceInvMatrixesValues.clear();
+  m_classesDiscriminantConstTerms.clear();
   
   ClassifierMAPStrategy::Parameters const * const castParamsPtr = 
     dynamic_cast< ClassifierMAPStrategy::Parameters const * >( strategyParams );
@@ -260,6 +262,15 @@ bool te::rp::ClassifierMAPStrategy::initialize(
         classCovarianceInvMatrix ), "Inverse matrix calcule error" );
       m_classesCovarianceInvMatrixes.push_back( classCovarianceInvMatrix );
       
+      for( dimIdx1 = 0 ; dimIdx1 < dimsNumber ; ++dimIdx1 )
+      {
+        for( dimIdx2 = 0 ; dimIdx2 < dimsNumber ; ++dimIdx2 )
+        {
+          m_classesCovarianceInvMatrixesValues.push_back( 
+            classCovarianceInvMatrix( dimIdx1, dimIdx2 ) );
+        }
+      }
+      
       ++classIdx;
       ++classesIt;
     }
@@ -291,28 +302,21 @@ bool te::rp::ClassifierMAPStrategy::execute(const te::rst::Raster& inputRaster,
   TERP_DEBUG_TRUE_OR_THROW( inputRaster.getNumberOfRows() ==
     outputRaster.getNumberOfRows(), "Rasters dims mismatch" );
     
-  // progress
-  
-  std::auto_ptr< te::common::TaskProgress > progressPtr;
-  if( enableProgressInterface )
-  {
-    progressPtr.reset( new te::common::TaskProgress );
-    
-    if( m_initParams.m_prioriProbs.empty() )
-      progressPtr->setTotalSteps( inputRaster.getNumberOfRows() +
-        ( inputRaster.getNumberOfRows() / m_initParams.m_prioriCalcSampleStep ) );
-    else
-      progressPtr->setTotalSteps( inputRaster.getNumberOfRows() );
-    
-    progressPtr->setMessage( "Classifying" );
-  }    
-    
   // Dealing with the logarithm of priori probabilities
   
   std::vector< double > logPrioriProbs;
   
   if( m_initParams.m_prioriProbs.empty() )
   {
+    std::auto_ptr< te::common::TaskProgress > progressPtr;
+    if( enableProgressInterface )
+    {
+      progressPtr.reset( new te::common::TaskProgress );
+      progressPtr->setTotalSteps( ( inputRaster.getNumberOfRows() + 
+        m_initParams.m_prioriCalcSampleStep - 1 ) / m_initParams.m_prioriCalcSampleStep );
+      progressPtr->setMessage( "Priori probabilities" );
+    }
+    
     TERP_TRUE_OR_RETURN_FALSE( getPrioriProbabilities( inputRaster,
       inputRasterBands, progressPtr.get(), logPrioriProbs ), "Priori probabilities calcule error" );
       
@@ -329,79 +333,92 @@ bool te::rp::ClassifierMAPStrategy::execute(const te::rst::Raster& inputRaster,
   
   // Classifying
   
+  m_classesDiscriminantConstTerms.resize( m_classesMeans.size() );
+  
+  for( unsigned int classIdx = 0 ; classIdx < m_classesMeans.size() ; ++classIdx )
+  {
+    m_classesDiscriminantConstTerms[ classIdx ] = logPrioriProbs[ classIdx ] 
+      + m_classesOptizedMAPDiscriminantTerm[ classIdx ];
+  }
+  
+  return executeBlockClassification( inputRaster, inputRasterBands, outputRaster,
+    outputRasterBand, enableProgressInterface, "Classifying" );
+}
+
+bool te::rp::ClassifierMAPStrategy::classifyBlock( double const* const samples, 
+  const unsigned int pixelsNumber, unsigned int* const labels ) const
+{
   const unsigned int classesNumber = (unsigned int)m_classesMeans.size();
-  const unsigned int nRows = (unsigned int)inputRaster.getNumberOfRows();
-  const unsigned int nCols = (unsigned int)inputRaster.getNumberOfColumns();
-  const unsigned int nDims = (unsigned int)inputRasterBands.size();
-  unsigned int col = 0;
+  const unsigned int nDims = (unsigned int)m_classesMeans[ 0 ].size();
+  std::vector< double > sampleMinusMean( nDims * pixelsNumber );
+  std::vector< double > mahalanobisDistances( pixelsNumber );
+  std::vector< double > closestClassDiscriminantValues( pixelsNumber, -1.0 * DBL_MAX );
+  double* const sampleMinusMeanPtr = &sampleMinusMean[ 0 ];
+  double* const mahalanobisDistancesPtr = &mahalanobisDistances[ 0 ];
+  double* const closestClassDiscriminantValuesPtr = &closestClassDiscriminantValues[ 0 ];
   unsigned int dim = 0;
-  boost::numeric::ublas::matrix< double > sample( nDims, 1 );
-  boost::numeric::ublas::matrix< double > sampleMinusMean( nDims, 1 );
-  boost::numeric::ublas::matrix< double > sampleMinusMeanT( 1, nDims );
-  boost::numeric::ublas::matrix< double > auxMatrix;
-  boost::numeric::ublas::matrix< double > mahalanobisDistanceMatrix;
-  unsigned int bandIdx = 0;
-  unsigned int classIdx = 0;
-  double discriminantFunctionValue = 0;
-  double closestClassdiscriminantFunctionValue = 0;
-  unsigned int closestClassIdx = 0;
+  unsigned int dim2 = 0;
+  unsigned int p = 0;
+  
+  for( p = 0 ; p < pixelsNumber ; ++p )
+    labels[ p ] = m_classesIndex2ID[ 0 ];
   
-  for( unsigned int row = 0 ; row < nRows ; ++row )
+  for( unsigned int classIdx = 0 ; classIdx < classesNumber ; ++classIdx )
   {
-    for( col = 0 ; col < nCols ; ++col )
+    const Parameters::ClassSampleT& classMeans = m_classesMeans[ classIdx ];
+    double const* const covInvPtr = &m_classesCovarianceInvMatrixesValues[ 
+      classIdx * nDims * nDims ];
+    const double constTerm = m_classesDiscriminantConstTerms[ classIdx ];
+    const Parameters::ClassIDT classID = m_classesIndex2ID[ classIdx ];
+    
+    for( dim = 0 ; dim < nDims ; ++dim )
     {
-      // Creating the sample
+      double const* const dimSamplesPtr = samples + ( dim * pixelsNumber );
+      double* const dimSampleMinusMeanPtr = sampleMinusMeanPtr + ( dim * pixelsNumber );
+      const double mean = classMeans[ dim ];
       
-      for( dim = 0 ; dim < nDims ; ++dim )
-      {
-        bandIdx = inputRasterBands[ dim ];
-        TERP_DEBUG_TRUE_OR_THROW( bandIdx < inputRaster.getNumberOfBands(),
-          "Invalid band index" );
-          
-        inputRaster.getValue( col, row, sample( dim, 0 ), bandIdx );
-      }
-      
-      // Looking the the closest class
+      for( p = 0 ; p < pixelsNumber ; ++p )
+        dimSampleMinusMeanPtr[ p ] = dimSamplesPtr[ p ] - mean;
+    }
+    
+    //calculate the mahalanobis distance: (x-mean)T * CovMatrizInvert * (x-mean)
+    
+    for( p = 0 ; p < pixelsNumber ; ++p )
+      mahalanobisDistancesPtr[ p ] = 0.0;
+    
+    for( dim = 0 ; dim < nDims ; ++dim )
+    {
+      double const* const dimDiffPtr = sampleMinusMeanPtr + ( dim * pixelsNumber );
+      const double diagCoef = covInvPtr[ dim * nDims + dim ];
       
-      closestClassdiscriminantFunctionValue = -1.0 * DBL_MAX;
+      for( p = 0 ; p < pixelsNumber ; ++p )
+        mahalanobisDistancesPtr[ p ] += diagCoef * dimDiffPtr[ p ] * dimDiffPtr[ p ];
       
-      for( classIdx = 0 ; classIdx < classesNumber ; ++classIdx )
+      for( dim2 = dim + 1 ; dim2 < nDims ; ++dim2 )
       {
-        const Parameters::ClassSampleT& classMeans = m_classesMeans[ classIdx ];
+        double const* const dim2DiffPtr = sampleMinusMeanPtr + ( dim2 * pixelsNumber );
+        const double coef = covInvPtr[ dim * nDims + dim2 ] + 
+          covInvPtr[ dim2 * nDims + dim ];
         
-        for( dim = 0 ; dim < nDims ; ++dim )
-        {
-          sampleMinusMean( dim, 0 ) = sampleMinusMeanT( 0, dim ) =
-            ( sample( dim, 0 ) - classMeans[ dim ] );
-        }
-        
-        //calculate the mahalanobis distance: (x-mean)T * CovMatrizInvert * (x-mean)
-        auxMatrix = boost::numeric::ublas::prod( sampleMinusMeanT, 
-          m_classesCovarianceInvMatrixes[ classIdx ] );
-        mahalanobisDistanceMatrix = boost::numeric::ublas::prod( auxMatrix, sampleMinusMean );
-        TERP_DEBUG_TRUE_OR_THROW( mahalanobisDistanceMatrix.size1() == 1, "Internal error" );
-        TERP_DEBUG_TRUE_OR_THROW( mahalanobisDistanceMatrix.size2() == 1, "Internal error" );
-        
-        discriminantFunctionValue = logPrioriProbs[ classIdx ] 
-          + m_classesOptizedMAPDiscriminantTerm[ classIdx ]
-          - ( 0.5 * mahalanobisDistanceMatrix( 0, 0 ) );
-        
-        if( discriminantFunctionValue > closestClassdiscriminantFunctionValue )
-        {
-          closestClassdiscriminantFunctionValue = discriminantFunctionValue;
-          closestClassIdx = classIdx;
-        }
+        for( p = 0 ; p < pixelsNumber ; ++p )
+          mahalanobisDistancesPtr[ p ] += coef * dimDiffPtr[ p ] * dim2DiffPtr[ p ];
       }
-      
-      outputRaster.setValue( col, row, m_classesIndex2ID[ closestClassIdx ] );      
-    }    
+    }
     
-    if( enableProgressInterface )
+    // Looking the the closest class
+    
+    for( p = 0 ; p < pixelsNumber ; ++p )
     {
-      progressPtr->pulse();
-      if( ! progressPtr->isActive() ) return false;
-    }         
-  }    
+      const double discriminantFunctionValue = constTerm 
+        - ( 0.5 * mahalanobisDistancesPtr[ p ] );
+        
+      if( discriminantFunctionValue > closestClassDiscriminantValuesPtr[ p ] )
+      {
+        closestClassDiscriminantValuesPtr[ p ] = discriminantFunctionValue;
+        labels[ p ] = classID;
+      }
+    }
+  }
   
   return true;
 }
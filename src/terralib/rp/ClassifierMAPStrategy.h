@@ -123,6 +123,14 @@ namespace te
         
         std::vector< double > m_classesOptizedMAPDiscriminantTerm;  //!< An optimized portion of the MAP discriminant function.
         
+        std::vector< double > m_classesCovarianceInvMatrixesValues; //!< Classes covariance inverse matrixes contiguous values ( [ classIdx * dims * dims + row * dims + col ] ).
+        
+        std::vector< double > m_classesDiscriminantConstTerms; //!< The constant portion of the MAP discriminant function (log priori probability plus the optimized term) for each class, updated by execute.
+        
+        //overload
+        bool classifyBlock( double const* const samples, const unsigned int pixelsNumber,
+          unsigned int* const labels ) const;
+        
         /*!
           \brief Calcule of priori probabilities following the current internal state.
           \param inputRaster Input raster.
@@ -94,6 +94,7 @@ bool te::rp::ClassifierSAMStrategy::initialize(
   m_initParams.reset();
   m_classesMeans.clear();
   m_classesIndex2ID.clear();
+  m_classesMeansNorms.clear();
   
   ClassifierSAMStrategy::Parameters const * const castParamsPtr = 
     dynamic_cast< ClassifierSAMStrategy::Parameters const * >( strategyParams );
@@ -166,8 +167,14 @@ bool te::rp::ClassifierSAMStrategy::initialize(
         dimMean /= (double)( classSamples.size() );
       }
       
+      double classMeansNorm = 0.0;
+      
+      for( dimIdx = 0 ; dimIdx < dimsNumber ; ++dimIdx )
+        classMeansNorm += classMeans[ dimIdx ] * classMeans[ dimIdx ];
+      
       m_classesMeans.push_back( classMeans );
       m_classesIndex2ID.push_back( classID );
+      m_classesMeansNorms.push_back( std::sqrt( classMeansNorm ) );
       
       ++classesIt;
     }
@@ -201,94 +208,81 @@ bool te::rp::ClassifierSAMStrategy::execute(const te::rst::Raster& inputRaster,
   TERP_DEBUG_TRUE_OR_THROW( inputRaster.getNumberOfRows() ==
     outputRaster.getNumberOfRows(), "Rasters dims mismatch" );
     
-  // progress
-  
-  std::auto_ptr< te::common::TaskProgress > progressPtr;
-  if( enableProgressInterface )
-  {
-    progressPtr.reset( new te::common::TaskProgress );
-    progressPtr->setTotalSteps( inputRaster.getNumberOfRows() );
-    progressPtr->setMessage( "Classifying" );
-  }    
-    
-  // Classifying
-  
+  return executeBlockClassification( inputRaster, inputRasterBands, outputRaster,
+    outputRasterBand, enableProgressInterface, "Classifying" );
+}
+
+bool te::rp::ClassifierSAMStrategy::classifyBlock( double const* const samples, 
+  const unsigned int pixelsNumber, unsigned int* const labels ) const
+{
   const unsigned int classesNumber = (unsigned int)m_classesMeans.size();
-  const unsigned int nRows = (unsigned int)inputRaster.getNumberOfRows();
-  const unsigned int nCols = (unsigned int)inputRaster.getNumberOfColumns();
   const unsigned int nDims = (unsigned int)m_classesMeans[ 0 ].size();
-  unsigned int col = 0;
+  std::vector< double > samplesNorms( pixelsNumber, 0.0 );
+  std::vector< double > angularTRs( pixelsNumber );
+  std::vector< double > minAngularDists( pixelsNumber, DBL_MAX );
+  double* const samplesNormsPtr = &samplesNorms[ 0 ];
+  double* const angularTRsPtr = &angularTRs[ 0 ];
+  double* const minAngularDistsPtr = &minAngularDists[ 0 ];
   unsigned int dim = 0;
-  unsigned int classIdx = 0;
-  double angularTR = 0;
-  double angularTT = 0;
-  double angularRR = 0;  
+  unsigned int p = 0;
   double angularDist = 0;
-  double readedValue = 0;
-  double minAngularDist = 0;
-  unsigned int minAngularDistClassIdx = 0;
   
-  for( unsigned int row = 0 ; row < nRows ; ++row )
+  for( dim = 0 ; dim < nDims ; ++dim )
+  {
+    double const* const dimSamplesPtr = samples + ( dim * pixelsNumber );
+    
+    for( p = 0 ; p < pixelsNumber ; ++p )
+      samplesNormsPtr[ p ] += dimSamplesPtr[ p ] * dimSamplesPtr[ p ];
+  }
+  
+  for( p = 0 ; p < pixelsNumber ; ++p )
+  {
+    samplesNormsPtr[ p ] = std::sqrt( samplesNormsPtr[ p ] );
+    labels[ p ] = 0;
+  }
+  
+  // Looking the the closest class
+  
+  for( unsigned int classIdx = 0 ; classIdx < classesNumber ; ++classIdx )
   {
-    for( col = 0 ; col < nCols ; ++col )
+    const SampleT& classMeans = m_classesMeans[ classIdx ];
+    const double classMeansNorm = m_classesMeansNorms[ classIdx ];
+    const double maxAngularDistance = m_initParams.m_maxAngularDistances[ classIdx ];
+    const ClassIDT classID = m_classesIndex2ID[ classIdx ];
+    
+    for( p = 0 ; p < pixelsNumber ; ++p )
+      angularTRsPtr[ p ] = 0.0;
+    
+    for( dim = 0 ; dim < nDims ; ++dim )
     {
-      // Looking the the closest class
-      
-      minAngularDist = DBL_MAX;
-      minAngularDistClassIdx = classesNumber;
+      double const* const dimSamplesPtr = samples + ( dim * pixelsNumber );
+      const double meanValue = classMeans[ dim ];
       
-      for( classIdx = 0 ; classIdx < classesNumber ; ++classIdx )
-      {
-        const SampleT& classMeans = m_classesMeans[ classIdx ];
-              
-        angularTR = 0;
-        angularTT = 0;
-        angularRR = 0;           
-        
-        for( dim = 0 ; dim < nDims ; ++dim )
-        {
-          const double& meanValue = classMeans[ dim ];
-          
-          inputRaster.getValue( col, row, readedValue, inputRasterBands[ dim ] );
-          
-          angularTR += readedValue * meanValue;
-          angularRR += meanValue * meanValue;
-          angularTT += readedValue * readedValue;
-        }
+      for( p = 0 ; p < pixelsNumber ; ++p )
+        angularTRsPtr[ p ] += dimSamplesPtr[ p ] * meanValue;
+    }
+    
+    for( p = 0 ; p < pixelsNumber ; ++p )
+    {
+      angularDist = angularTRsPtr[ p ] / ( samplesNormsPtr[ p ] * classMeansNorm );
         
-        angularDist = angularTR / ( sqrt( angularTT ) *
-          sqrt( angularRR ) );
-          
-        if( std::abs( angularDist ) > 1.0 )
-        {
-          angularDist = DBL_MAX;
-        }
-        else
-        {
-          angularDist = acos( angularDist );
-        }
-      
-        if( ( angularDist < minAngularDist ) && ( angularDist < 
-          m_initParams.m_maxAngularDistances[ classIdx ] ) )
-        {
-          minAngularDist = angularDist;
-          minAngularDistClassIdx = classIdx;
-        }
+      if( std::abs( angularDist ) > 1.0 )
+      {
+        angularDist = DBL_MAX;
       }
-      
-      if( minAngularDistClassIdx == classesNumber )
-        outputRaster.setValue( col, row, 0, 0 );
       else
-        outputRaster.setValue( col, row, m_classesIndex2ID[ minAngularDistClassIdx ], 
-          0 );      
-    }    
+      {
+        angularDist = acos( angularDist );
+      }
     
-    if( enableProgressInterface )
-    {
-      progressPtr->pulse();
-      if( ! progressPtr->isActive() ) return false;
-    }         
-  }    
+      if( ( angularDist < minAngularDistsPtr[ p ] ) && ( angularDist < 
+        maxAngularDistance ) )
+      {
+        minAngularDistsPtr[ p ] = angularDist;
+        labels[ p ] = classID;
+      }
+    }
+  }
   
   return true;
 }
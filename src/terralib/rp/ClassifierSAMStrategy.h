@@ -117,6 +117,12 @@ namespace te
         SamplesT m_classesMeans; //!< Classes means.
         
         std::vector< ClassIDT > m_classesIndex2ID; //!< An class index ordered vector of classes IDs;
+        
+        std::vector< double > m_classesMeansNorms; //!< The euclidean norm of each class mean vector.
+        
+        //overload
+        bool classifyBlock( double const* const samples, const unsigned int pixelsNumber,
+          unsigned int* const labels ) const;
     };
 
     /*!
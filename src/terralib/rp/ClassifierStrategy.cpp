@@ -24,8 +24,36 @@
 */
 
 #include "ClassifierStrategy.h"
+#include "Macros.h"
+#include "../raster/Band.h"
+#include "../raster/BandProperty.h"
+#include "../raster/SynchronizedRaster.h"
+#include "../common/PlatformUtils.h"
+#include "../common/progress/TaskProgress.h"
+
+#include <boost/thread.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+te::rp::ClassifierStrategy::ClassifyBlocksThreadParams::ClassifyBlocksThreadParams()
+: m_strategyPtr( 0 ), m_inputSyncPtr( 0 ), m_outputSyncPtr( 0 ),
+  m_outputRasterBand( 0 ), m_inputMaxCachedBlocks( 1 ), m_outputBlocksPerRow( 0 ),
+  m_outputBlocksNumber( 0 ), m_nextBlockIdxPtr( 0 ), m_processedBlocksNumberPtr( 0 ),
+  m_runningThreadsCounterPtr( 0 ), m_returnValuePtr( 0 ), m_abortValuePtr( 0 ),
+  m_mutexPtr( 0 ), m_blockProcessedSignalMutexPtr( 0 ),
+  m_blockProcessedSignalPtr( 0 ), m_useProgress( false )
+{
+}
+
+te::rp::ClassifierStrategy::ClassifyBlocksThreadParams::~ClassifyBlocksThreadParams()
+{
+}
 
 te::rp::ClassifierStrategy::ClassifierStrategy()
+: m_threadsNumber( 0 )
 {
 }
 
@@ -34,6 +62,7 @@ te::rp::ClassifierStrategy::~ClassifierStrategy()
 }
 
 te::rp::ClassifierStrategy::ClassifierStrategy(const te::rp::ClassifierStrategy&)
+: m_threadsNumber( 0 )
 {
 }
 
@@ -41,3 +70,326 @@ const te::rp::ClassifierStrategy& te::rp::ClassifierStrategy::operator=(const te
 {
   return *this;
 }
+
+void te::rp::ClassifierStrategy::setThreadsNumber( const unsigned int threadsNumber )
+{
+  m_threadsNumber = threadsNumber;
+}
+
+bool te::rp::ClassifierStrategy::classifyBlock( double const* const,
+  const unsigned int, unsigned int* const ) const
+{
+  assert( false && "classifyBlock not overloaded by a strategy using executeBlockClassification" );
+  
+  TERP_LOG_AND_RETURN_FALSE( "Block classification not implemented by this strategy" );
+}
+
+bool te::rp::ClassifierStrategy::executeBlockClassification( 
+  const te::rst::Raster& inputRaster,
+  const std::vector<unsigned int>& inputRasterBands,
+  te::rst::Raster& outputRaster, const unsigned int outputRasterBand,
+  const bool enableProgressInterface, const std::string& progressMessage ) const
+{
+  TERP_TRUE_OR_RETURN_FALSE( inputRasterBands.size() > 0, "Invalid input bands" );
+  TERP_TRUE_OR_RETURN_FALSE( outputRasterBand < outputRaster.getNumberOfBands(),
+    "Invalid output band" );
+  TERP_TRUE_OR_RETURN_FALSE( inputRaster.getNumberOfColumns() ==
+    outputRaster.getNumberOfColumns(), "Rasters dims mismatch" );
+  TERP_TRUE_OR_RETURN_FALSE( inputRaster.getNumberOfRows() ==
+    outputRaster.getNumberOfRows(), "Rasters dims mismatch" );
+    
+  for( unsigned int inputRasterBandsIdx = 0 ; inputRasterBandsIdx <
+    inputRasterBands.size() ; ++inputRasterBandsIdx )
+  {
+    TERP_TRUE_OR_RETURN_FALSE( inputRasterBands[ inputRasterBandsIdx ] <
+      inputRaster.getNumberOfBands(), "Invalid band index" );
+  }
+  
+  // Finding the number of threads and the input cache size
+  
+  const te::rst::BandProperty& outBandProp = 
+    *outputRaster.getBand( outputRasterBand )->getProperty();
+  const unsigned int outputBlocksPerRow = (unsigned int)outBandProp.m_nblocksx;
+  const unsigned int outputBlocksNumber = (unsigned int)( outBandProp.m_nblocksx *
+    outBandProp.m_nblocksy );
+  TERP_TRUE_OR_RETURN_FALSE( outputBlocksNumber > 0, "Invalid output blocking" );
+  
+  unsigned int inputMaxCachedBlocks = 0;
+  
+  for( unsigned int inputRasterBandsIdx = 0 ; inputRasterBandsIdx <
+    inputRasterBands.size() ; ++inputRasterBandsIdx )
+  {
+    const te::rst::BandProperty& inBandProp = *inputRaster.getBand( 
+      inputRasterBands[ inputRasterBandsIdx ] )->getProperty();
+      
+    inputMaxCachedBlocks += 
+      ( ( outBandProp.m_blkw / std::max( 1, inBandProp.m_blkw ) ) + 2 )
+      *
+      ( ( outBandProp.m_blkh / std::max( 1, inBandProp.m_blkh ) ) + 2 );
+  }
+  
+  const unsigned int threadsNumber = std::max( 1u, std::min( outputBlocksNumber,
+    ( m_threadsNumber == 0 ) ? te::common::GetPhysProcNumber() : m_threadsNumber ) );
+  
+  // Creating the threads parameters
+  
+  bool returnValue = true;
+  bool abortValue = false;
+  unsigned int nextBlockIdx = 0;
+  unsigned int processedBlocksNumber = 0;
+  unsigned int runningThreadsCounter = 0;
+  boost::mutex mutex;
+  boost::mutex blockProcessedSignalMutex;
+  boost::condition_variable blockProcessedSignal;
+  te::rst::RasterSynchronizer inputSync( (te::rst::Raster&)inputRaster, 
+    te::common::RAccess );
+  te::rst::RasterSynchronizer outputSync( outputRaster, te::common::RWAccess );
+  
+  ClassifyBlocksThreadParams threadParams;
+  threadParams.m_strategyPtr = this;
+  threadParams.m_inputSyncPtr = &inputSync;
+  threadParams.m_outputSyncPtr = &outputSync;
+  threadParams.m_inputRasterBands = inputRasterBands;
+  threadParams.m_outputRasterBand = outputRasterBand;
+  threadParams.m_inputMaxCachedBlocks = inputMaxCachedBlocks;
+  threadParams.m_outputBlocksPerRow = outputBlocksPerRow;
+  threadParams.m_outputBlocksNumber = outputBlocksNumber;
+  threadParams.m_nextBlockIdxPtr = &nextBlockIdx;
+  threadParams.m_processedBlocksNumberPtr = &processedBlocksNumber;
+  threadParams.m_runningThreadsCounterPtr = &runningThreadsCounter;
+  threadParams.m_returnValuePtr = &returnValue;
+  threadParams.m_abortValuePtr = &abortValue;
+  threadParams.m_mutexPtr = &mutex;
+  threadParams.m_blockProcessedSignalMutexPtr = &blockProcessedSignalMutex;
+  threadParams.m_blockProcessedSignalPtr = &blockProcessedSignal;
+  threadParams.m_progressMessage = progressMessage;
+  
+  if( threadsNumber == 1 )
+  {
+    runningThreadsCounter = 1;
+    threadParams.m_useProgress = enableProgressInterface;
+    
+    classifyBlocksThreadEntry( &threadParams );
+  }
+  else
+  {
+    threadParams.m_useProgress = false;
+    runningThreadsCounter = threadsNumber;
+    
+    boost::thread_group threads;
+    
+    for( unsigned int threadIdx = 0 ; threadIdx < threadsNumber ; ++threadIdx )
+    {
+      threads.add_thread( new boost::thread( classifyBlocksThreadEntry, 
+        &threadParams ) );
+    }
+    
+    // progress stuff
+    
+    if( enableProgressInterface )
+    {
+      te::common::TaskProgress progress;
+      progress.setTotalSteps( outputBlocksNumber );
+      progress.setMessage( progressMessage );
+      
+      int currentStep = 0;
+      
+      while( true )
+      {
+        {
+          boost::unique_lock<boost::mutex> lock( blockProcessedSignalMutex );
+          blockProcessedSignal.timed_wait( lock, 
+            boost::posix_time::seconds( 1 ) );
+        }
+        
+        mutex.lock();
+        const bool stop = abortValue || ( runningThreadsCounter == 0 );
+        const int processedBlocks = (int)processedBlocksNumber;
+        mutex.unlock();
+        
+        if( stop ) break;
+        
+        if( progress.isActive() )
+        {
+          if( processedBlocks != currentStep )
+          {
+            progress.setCurrentStep( processedBlocks );
+            currentStep = processedBlocks;
+          }
+        }
+        else
+        {
+          mutex.lock();
+          abortValue = true;
+          returnValue = false;
+          mutex.unlock();
+          break;
+        }
+      }
+    }
+    
+    threads.join_all();
+  }
+  
+  return returnValue;
+}
+
+void te::rp::ClassifierStrategy::classifyBlocksThreadEntry( 
+  ClassifyBlocksThreadParams* paramsPtr )
+{
+  // Instantiating the local rasters instances
+  
+  te::rst::SynchronizedRaster inputRaster( paramsPtr->m_inputMaxCachedBlocks,
+    *( paramsPtr->m_inputSyncPtr ) );
+  te::rst::SynchronizedRaster outputRaster( 1, *( paramsPtr->m_outputSyncPtr ) );
+  
+  const std::vector< unsigned int >& inputRasterBands = paramsPtr->m_inputRasterBands;
+  const unsigned int nDims = (unsigned int)inputRasterBands.size();
+  const unsigned int outputRasterBand = paramsPtr->m_outputRasterBand;
+  te::rst::Band& outputBand = *outputRaster.getBand( outputRasterBand );
+  const unsigned int nRows = (unsigned int)outputRaster.getNumberOfRows();
+  const unsigned int nCols = (unsigned int)outputRaster.getNumberOfColumns();
+  const unsigned int blkW = (unsigned int)outputBand.getProperty()->m_blkw;
+  const unsigned int blkH = (unsigned int)outputBand.getProperty()->m_blkh;
+  const unsigned int blockPixelsNumber = blkW * blkH;
+  
+  std::vector< te::rst::Band const* > inputBands( nDims );
+  for( unsigned int dim = 0 ; dim < nDims ; ++dim )
+    inputBands[ dim ] = inputRaster.getBand( inputRasterBands[ dim ] );
+  
+  boost::scoped_array< double > samplesHandler( new double[ blockPixelsNumber * nDims ] );
+  boost::scoped_array< unsigned int > labelsHandler( new unsigned int[ blockPixelsNumber ] );
+  double* const samplesPtr = samplesHandler.get();
+  unsigned int* const labelsPtr = labelsHandler.get();
+  
+  // progress stuff
+  
+  std::auto_ptr< te::common::TaskProgress > progressPtr;
+  if( paramsPtr->m_useProgress )
+  {
+    progressPtr.reset( new te::common::TaskProgress );
+    progressPtr->setTotalSteps( paramsPtr->m_outputBlocksNumber );
+    progressPtr->setMessage( paramsPtr->m_progressMessage );
+  }
+  
+  unsigned int blockIdx = 0;
+  unsigned int firstRow = 0;
+  unsigned int rowsBound = 0;
+  unsigned int firstCol = 0;
+  unsigned int colsBound = 0;
+  unsigned int blockCols = 0;
+  unsigned int pixelsNumber = 0;
+  unsigned int row = 0;
+  unsigned int col = 0;
+  unsigned int dim = 0;
+  double* dimSamplesPtr = 0;
+  unsigned int* labelPtr = 0;
+  
+  while( true )
+  {
+    // looking for the next block to classify
+    
+    paramsPtr->m_mutexPtr->lock();
+    
+    if( *( paramsPtr->m_abortValuePtr ) || ( *( paramsPtr->m_nextBlockIdxPtr ) >=
+      paramsPtr->m_outputBlocksNumber ) )
+    {
+      paramsPtr->m_mutexPtr->unlock();
+      break;
+    }
+    
+    blockIdx = ( *( paramsPtr->m_nextBlockIdxPtr ) )++;
+    
+    paramsPtr->m_mutexPtr->unlock();
+    
+    firstRow = ( blockIdx / paramsPtr->m_outputBlocksPerRow ) * blkH;
+    rowsBound = std::min( firstRow + blkH, nRows );
+    firstCol = ( blockIdx % paramsPtr->m_outputBlocksPerRow ) * blkW;
+    colsBound = std::min( firstCol + blkW, nCols );
+    
+    if( ( firstRow < rowsBound ) && ( firstCol < colsBound ) )
+    {
+      blockCols = colsBound - firstCol;
+      pixelsNumber = ( rowsBound - firstRow ) * blockCols;
+      
+      // loading the block data (band sequential)
+      
+      for( dim = 0 ; dim < nDims ; ++dim )
+      {
+        const te::rst::Band& inBand = *inputBands[ dim ];
+        dimSamplesPtr = samplesPtr + ( dim * pixelsNumber );
+        
+        for( row = firstRow ; row < rowsBound ; ++row )
+        {
+          for( col = firstCol ; col < colsBound ; ++col )
+          {
+            inBand.getValue( col, row, *dimSamplesPtr );
+            ++dimSamplesPtr;
+          }
+        }
+      }
+      
+      // classifying
+      
+      if( ! paramsPtr->m_strategyPtr->classifyBlock( samplesPtr, pixelsNumber,
+        labelsPtr ) )
+      {
+        paramsPtr->m_mutexPtr->lock();
+        *( paramsPtr->m_abortValuePtr ) = true;
+        *( paramsPtr->m_returnValuePtr ) = false;
+        paramsPtr->m_mutexPtr->unlock();
+        break;
+      }
+      
+      // writing the labels
+      
+      labelPtr = labelsPtr;
+      
+      for( row = firstRow ; row < rowsBound ; ++row )
+      {
+        for( col = firstCol ; col < colsBound ; ++col )
+        {
+          outputBand.setValue( col, row, (double)( *labelPtr ) );
+          ++labelPtr;
+        }
+      }
+    }
+    
+    // progress stuff
+    
+    paramsPtr->m_mutexPtr->lock();
+    ++( *( paramsPtr->m_processedBlocksNumberPtr ) );
+    paramsPtr->m_mutexPtr->unlock();
+    
+    if( paramsPtr->m_useProgress )
+    {
+      if( progressPtr->isActive() )
+      {
+        progressPtr->pulse();
+      }
+      else
+      {
+        paramsPtr->m_mutexPtr->lock();
+        *( paramsPtr->m_abortValuePtr ) = true;
+        *( paramsPtr->m_returnValuePtr ) = false;
+        paramsPtr->m_mutexPtr->unlock();
+        break;
+      }
+    }
+    else
+    {
+      boost::lock_guard<boost::mutex> blockProcessedSignalLockGuard( 
+        *( paramsPtr->m_blockProcessedSignalMutexPtr ) );
+      
+      paramsPtr->m_blockProcessedSignalPtr->notify_one();
+    }
+  }
+  
+  paramsPtr->m_mutexPtr->lock();
+  --( *( paramsPtr->m_runningThreadsCounterPtr ) );
+  paramsPtr->m_mutexPtr->unlock();
+  
+  boost::lock_guard<boost::mutex> blockProcessedSignalLockGuard( 
+    *( paramsPtr->m_blockProcessedSignalMutexPtr ) );
+  paramsPtr->m_blockProcessedSignalPtr->notify_one();
+}
@@ -28,11 +28,13 @@
 
 // TerraLib
 #include "../raster/Raster.h"
+#include "../raster/RasterSynchronizer.h"
 #include "ClassifierStrategyParameters.h"
 #include "Config.h"
 #include "Exception.h"
 
 // STL
+#include <string>
 #include <vector>
 
 namespace te
@@ -81,11 +83,95 @@ namespace te
         */
         virtual std::vector< int > getOutputDataTypes() const = 0; 
 
+        /*!
+          \brief Set the number of threads used by the block classification stage.
+
+          \param threadsNumber The number of threads to use (0:automatic , 1:disabled, any other integer dictates the number of threads).
+        */
+        void setThreadsNumber( const unsigned int threadsNumber );
+
       protected:
 
+        /*!
+          \class ClassifyBlocksThreadParams
+          \brief The parameters passed to the classifyBlocksThreadEntry method.
+        */
+        class ClassifyBlocksThreadParams
+        {
+          public :
+
+            ClassifierStrategy const* m_strategyPtr; //!< The strategy owning the classification kernel.
+            te::rst::RasterSynchronizer* m_inputSyncPtr; //!< Input raster synchronizer pointer.
+            te::rst::RasterSynchronizer* m_outputSyncPtr; //!< Output raster synchronizer pointer.
+            std::vector< unsigned int > m_inputRasterBands; //!< Input raster bands.
+            unsigned int m_outputRasterBand; //!< Output raster band.
+            unsigned int m_inputMaxCachedBlocks; //!< The maximum number of input raster cached blocks.
+            unsigned int m_outputBlocksPerRow; //!< The number of output blocks on each row (blocks-x).
+            unsigned int m_outputBlocksNumber; //!< The total number of output blocks.
+            unsigned int* m_nextBlockIdxPtr; //!< A pointer to the next output block index to process.
+            unsigned int* m_processedBlocksNumberPtr; //!< A pointer to the processed blocks counter.
+            unsigned int* m_runningThreadsCounterPtr; //!< A pointer to the running threads counter.
+            bool* m_returnValuePtr; //!< A pointer to the threads return value.
+            bool* m_abortValuePtr; //!< A pointer to the abort execution value.
+            boost::mutex* m_mutexPtr; //!< General mutex pointer.
+            boost::mutex* m_blockProcessedSignalMutexPtr; //!< Mutex used to update the main process progress.
+            boost::condition_variable* m_blockProcessedSignalPtr; //!< Signal used to update the main process progress.
+            bool m_useProgress; //!< If enabled the thread will use its own progress interface, if false only a signal will be emitted on each processed block.
+            std::string m_progressMessage; //!< The progress interface message.
+
+            ClassifyBlocksThreadParams();
+
+            ~ClassifyBlocksThreadParams();
+        };
+
+        unsigned int m_threadsNumber; //!< The number of threads to use by the block classification stage (0:automatic , 1:disabled, any other integer dictates the number of threads).
+
         /*! \brief Default constructor. */
         ClassifierStrategy();
 
+        /*!
+          \brief Classify a block of pixels already loaded into memory.
+
+          \param samples The pixels values, band sequential: samples[ dimIdx * pixelsNumber + pixelIdx ].
+          \param pixelsNumber The number of pixels inside the block.
+          \param labels A pre-allocated buffer where the pixels labels will be written (one label for each pixel).
+
+          \return true if OK, false on errors.
+
+          \note This method is called concurrently by the block classification threads and must not change the instance state.
+          \note The default implementation asserts and logs an error (returning false), strategies using executeBlockClassification must overload it.
+        */
+        virtual bool classifyBlock( double const* const samples,
+          const unsigned int pixelsNumber, unsigned int* const labels ) const;
+
+        /*!
+          \brief Classify all input raster pixels following the output raster blocking scheme.
+
+          \details Output blocks are distributed among m_threadsNumber threads, each block is
+          loaded band sequentially, classified by classifyBlock and the labels are written
+          straight into the output raster.
+
+          \param inputRaster                Input raster.
+          \param inputRasterBands           Input raster bands.
+          \param outputRaster               Output raster.
+          \param outputRasterBand           Output raster band.
+          \param enableProgressInterface    Enable the progress interface.
+          \param progressMessage            The progress interface message.
+
+          \return true if OK, false on errors or if the process was canceled.
+        */
+        bool executeBlockClassification( const te::rst::Raster& inputRaster,
+          const std::vector<unsigned int>& inputRasterBands,
+          te::rst::Raster& outputRaster, const unsigned int outputRasterBand,
+          const bool enableProgressInterface, const std::string& progressMessage ) const;
+
+        /*!
+          \brief Thread entry for the block classification stage.
+
+          \param paramsPtr A pointer to the thread parameters.
+        */
+        static void classifyBlocksThreadEntry( ClassifyBlocksThreadParams* paramsPtr );
+
       private:
 
         /*!
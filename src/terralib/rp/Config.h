@@ -113,6 +113,15 @@
 
 #define TE_RP_MODULE_NAME "te.rasterprocessing"
 
+/*!
+  \def TERP_BLOCKPROCESSOR_MIN_TASK_PIXELS
+
+  \brief The minimum number of pixels processed by each BlockProcessor task.
+
+  \note Rasters with small blocks (one line blocks, for example) have their vertically adjacent blocks grouped until this size is reached.
+ */
+#define TERP_BLOCKPROCESSOR_MIN_TASK_PIXELS 65536
+
 /*!
   \def TERPEXPORT
 
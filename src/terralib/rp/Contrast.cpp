@@ -42,6 +42,7 @@
 #include <cfloat>
 
 // Boost
+#include <boost/bind.hpp>
 #include <boost/concept_check.hpp>
 
 namespace te
@@ -85,6 +86,7 @@ namespace te
       m_inRasterPtr = 0;
       m_inRasterBands.clear();
       m_enableProgress = false;
+      m_enableMultiThread = true;
     }
 
     const Contrast::InputParameters& Contrast::InputParameters::operator=(
@@ -114,6 +116,7 @@ namespace te
       m_inRasterPtr = params.m_inRasterPtr;
       m_inRasterBands = params.m_inRasterBands;
       m_enableProgress = params.m_enableProgress;
+      m_enableMultiThread = params.m_enableMultiThread;
 
       return *this;
     }
@@ -429,8 +432,6 @@ namespace te
       for( unsigned int inRasterBandsIdx = 0 ; inRasterBandsIdx <
         m_inputParameters.m_inRasterBands.size() ; ++inRasterBandsIdx )
       {
-        te::rst::Band const* inRasterBandPtr = m_inputParameters.m_inRasterPtr->getBand(
-          m_inputParameters.m_inRasterBands[ inRasterBandsIdx ] );
         te::rst::Band* outRasterBandPtr =m_outputParametersPtr->m_outRasterPtr->getBand(
          m_outputParametersPtr->m_outRasterBands[ inRasterBandsIdx ] );
 
@@ -456,7 +457,10 @@ namespace te
           m_offSetGainRemap_offset2 = 0.0;
         }
 
-        if( ! remapBandLevels( *inRasterBandPtr, *outRasterBandPtr,
+        if( ! remapBandLevels( *m_inputParameters.m_inRasterPtr,
+          m_inputParameters.m_inRasterBands[ inRasterBandsIdx ],
+          *m_outputParametersPtr->m_outRasterPtr,
+          m_outputParametersPtr->m_outRasterBands[ inRasterBandsIdx ],
           &Contrast::offSetGainRemap, m_inputParameters.m_enableProgress &&
           (!enableGlobalProgress) ) )
         {
@@ -564,8 +568,6 @@ namespace te
       for( unsigned int inRasterBandsIdx = 0 ; inRasterBandsIdx <
         m_inputParameters.m_inRasterBands.size() ; ++inRasterBandsIdx )
       {
-        te::rst::Band const* inRasterBandPtr = m_inputParameters.m_inRasterPtr->getBand(
-          m_inputParameters.m_inRasterBands[ inRasterBandsIdx ] );
         te::rst::Band* outRasterBandPtr =m_outputParametersPtr->m_outRasterPtr->getBand(
          m_outputParametersPtr->m_outRasterBands[ inRasterBandsIdx ] );
 
@@ -587,7 +589,10 @@ namespace te
           m_squareRemap_factor = 0.0;
         }
 
-        if( ! remapBandLevels( *inRasterBandPtr, *outRasterBandPtr,
+        if( ! remapBandLevels( *m_inputParameters.m_inRasterPtr,
+          m_inputParameters.m_inRasterBands[ inRasterBandsIdx ],
+          *m_outputParametersPtr->m_outRasterPtr,
+          m_outputParametersPtr->m_outRasterBands[ inRasterBandsIdx ],
           &Contrast::squareRemap, m_inputParameters.m_enableProgress &&
           (!enableGlobalProgress) ) )
         {
@@ -622,8 +627,6 @@ namespace te
       for( unsigned int inRasterBandsIdx = 0 ; inRasterBandsIdx <
         m_inputParameters.m_inRasterBands.size() ; ++inRasterBandsIdx )
       {
-        te::rst::Band const* inRasterBandPtr = m_inputParameters.m_inRasterPtr->getBand(
-          m_inputParameters.m_inRasterBands[ inRasterBandsIdx ] );
         te::rst::Band* outRasterBandPtr =m_outputParametersPtr->m_outRasterPtr->getBand(
          m_outputParametersPtr->m_outRasterBands[ inRasterBandsIdx ] );
 
@@ -645,7 +648,10 @@ namespace te
           m_squareRootRemap_gain = 0.0;
         }
 
-        if( ! remapBandLevels( *inRasterBandPtr, *outRasterBandPtr,
+        if( ! remapBandLevels( *m_inputParameters.m_inRasterPtr,
+          m_inputParameters.m_inRasterBands[ inRasterBandsIdx ],
+          *m_outputParametersPtr->m_outRasterPtr,
+          m_outputParametersPtr->m_outRasterBands[ inRasterBandsIdx ],
           &Contrast::squareRootRemap, m_inputParameters.m_enableProgress &&
           (!enableGlobalProgress) ) )
         {
@@ -680,8 +686,6 @@ namespace te
       for( unsigned int inRasterBandsIdx = 0 ; inRasterBandsIdx <
         m_inputParameters.m_inRasterBands.size() ; ++inRasterBandsIdx )
       {
-        te::rst::Band const* inRasterBandPtr = m_inputParameters.m_inRasterPtr->getBand(
-          m_inputParameters.m_inRasterBands[ inRasterBandsIdx ] );
         te::rst::Band* outRasterBandPtr =m_outputParametersPtr->m_outRasterPtr->getBand(
          m_outputParametersPtr->m_outRasterBands[ inRasterBandsIdx ] );
 
@@ -705,7 +709,10 @@ namespace te
           m_logRemap_gain = 0.0;
         }
 
-        if( ! remapBandLevels( *inRasterBandPtr, *outRasterBandPtr,
+        if( ! remapBandLevels( *m_inputParameters.m_inRasterPtr,
+          m_inputParameters.m_inRasterBands[ inRasterBandsIdx ],
+          *m_outputParametersPtr->m_outRasterPtr,
+          m_outputParametersPtr->m_outRasterBands[ inRasterBandsIdx ],
           &Contrast::logRemap, m_inputParameters.m_enableProgress &&
           (!enableGlobalProgress) ) )
         {
@@ -884,8 +891,8 @@ namespace te
           stdDevValue );
         m_offSetGainRemap_offset2 = pca0MeanValue;
 
-        if( ! remapBandLevels( pcaBand, pcaBand,
-          &Contrast::offSetGainRemap, 0 ) )
+        if( ! remapBandLevels( *pcaRasterPtr, pcaBandIdx, *pcaRasterPtr,
+          pcaBandIdx, &Contrast::offSetGainRemap, false ) )
         {
           return false;
         }
@@ -913,108 +920,48 @@ namespace te
       return true;
     }    
 
-    bool Contrast::remapBandLevels( const te::rst::Band& inRasterBand,
-      te::rst::Band& outRasterBand, RemapFuncPtrT remapFuncPtr,
+    bool Contrast::remapBandLevels( const te::rst::Raster& inRaster,
+      const unsigned int inBandIdx, te::rst::Raster& outRaster,
+      const unsigned int outBandIdx, RemapFuncPtrT remapFuncPtr,
       const bool enableProgress )
     {
-      const unsigned int inBlkWidthPixels = inRasterBand.getProperty()->m_blkw;
-      const unsigned int inBlkHeightPixels = inRasterBand.getProperty()->m_blkh;
-      const unsigned int outBlkWidthPixels = outRasterBand.getProperty()->m_blkw;
-      const unsigned int outBlkHeightPixels = outRasterBand.getProperty()->m_blkh;
-      double outRangeMin = 0.0;
-      double outRangeMax = 0.0;
-      GetDataTypeRange( outRasterBand.getProperty()->getType(),
-        outRangeMin, outRangeMax );
-        
-      std::auto_ptr< te::common::TaskProgress > progressPtr;
+      BlockProcessor processor;
+      processor.setOutputRaster( outRaster );
+      processor.addInputRaster( inRaster );
+      processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
       if( enableProgress )
       {
-        progressPtr.reset( new te::common::TaskProgress );
-        progressPtr->setMessage( "Contrast" );
-      }          
-
-      if( ( inBlkWidthPixels == outBlkWidthPixels ) &&
-        ( inBlkHeightPixels == outBlkHeightPixels ) )
-      { // block version
-        const unsigned int blockSizePixels = inBlkWidthPixels *
-          inBlkHeightPixels;
-        const unsigned int xBlocksNmb = inRasterBand.getProperty()->m_nblocksx;
-        const unsigned int yBlocksNmb = inRasterBand.getProperty()->m_nblocksy;
-        unsigned char* inputBuffer = new unsigned char[ inRasterBand.getBlockSize() ];
-        unsigned char* outputBuffer = new unsigned char[ outRasterBand.getBlockSize() ];
-        double* inDoublesBuffer = new double[ blockSizePixels ];
-        double* outDoublesBuffer = new double[ blockSizePixels ];
-        const int inputVectorDataType = inRasterBand.getProperty()->getType();
-        const int outputVectorDataType = outRasterBand.getProperty()->getType();
-        unsigned int blockXIndex = 0;
-        unsigned int blockOffset = 0;
-        double outValue = 0;
-        
-        if( enableProgress ) progressPtr->setTotalSteps( yBlocksNmb * xBlocksNmb );
-
-        for( unsigned int blockYIndex = 0 ; blockYIndex < yBlocksNmb ;
-          ++blockYIndex )
-        {
-          for( blockXIndex = 0 ; blockXIndex < xBlocksNmb ;
-            ++blockXIndex )
-          {
-            inRasterBand.read( blockXIndex, blockYIndex, inputBuffer );
-
-            Convert2DoublesVector( inputBuffer, inputVectorDataType,
-              blockSizePixels, inDoublesBuffer );
-
-            for( blockOffset = 0 ; blockOffset < blockSizePixels ; ++blockOffset )
-            {
-              (this->*remapFuncPtr)( inDoublesBuffer[blockOffset],
-                outValue);
-              outDoublesBuffer[blockOffset] = std::max( outRangeMin, std::min(
-                outRangeMax, outValue ) );
-            }
+        processor.enableProgress( "Contrast" );
+      }
 
-            ConvertDoublesVector( outDoublesBuffer, blockSizePixels,
-              outputVectorDataType, outputBuffer );
+      return processor.execute( boost::bind( &Contrast::remapBlockLevels, this,
+        inBandIdx, outBandIdx, remapFuncPtr, _1, _2 ) );
+    }
 
-            outRasterBand.write( blockXIndex, blockYIndex, outputBuffer );
-            
-            if( enableProgress )
-            {
-              progressPtr->pulse();
-              if( ! progressPtr->isActive() ) return false;
-            }
-          }
-        }
+    bool Contrast::remapBlockLevels( const unsigned int inBandIdx,
+      const unsigned int outBandIdx, RemapFuncPtrT remapFuncPtr,
+      const BlockWindow& window, BlockContext& context )
+    {
+      const te::rst::Band& inRasterBand = *context.getInputRaster( 0 ).getBand( inBandIdx );
+      te::rst::Band& outRasterBand = *context.getOutputRaster().getBand( outBandIdx );
 
-        delete[] inputBuffer;
-        delete[] outputBuffer;
-        delete[] inDoublesBuffer;
-        delete[] outDoublesBuffer;
-      }
-      else
-      { // pixel by pixel version
-        const unsigned int linesNumber = m_inputParameters.m_inRasterPtr->getNumberOfRows();
-        const unsigned int columnsNumber =  m_inputParameters.m_inRasterPtr->getNumberOfColumns();
-        
-        if( enableProgress ) progressPtr->setTotalSteps( linesNumber );
+      double outRangeMin = 0.0;
+      double outRangeMax = 0.0;
+      GetDataTypeRange( outRasterBand.getProperty()->getType(),
+        outRangeMin, outRangeMax );
 
-        unsigned int col = 0;
-        double inputValue = 0;
-        double outputValue = 0;
+      unsigned int col = 0;
+      double inputValue = 0;
+      double outputValue = 0;
 
-        for( unsigned int line = 0 ; line < linesNumber ; ++line )
+      for( unsigned int line = window.m_firstRow ; line < window.m_rowsBound ; ++line )
+      {
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
         {
-          for( col = 0 ; col < columnsNumber ; ++col )
-          {
-            inRasterBand.getValue( col, line, inputValue );
-            (this->*remapFuncPtr)( inputValue, outputValue );
-            outRasterBand.setValue( col, line, std::max( outRangeMin, std::min(
-              outRangeMax, outputValue ) ) );
-          }
-          
-          if( enableProgress )
-          {
-            progressPtr->pulse();
-            if( ! progressPtr->isActive() ) return false;
-          }          
+          inRasterBand.getValue( col, line, inputValue );
+          (this->*remapFuncPtr)( inputValue, outputValue );
+          outRasterBand.setValue( col, line, std::max( outRangeMin, std::min(
+            outRangeMax, outputValue ) ) );
         }
       }
 
@@ -26,6 +26,7 @@
 #define __TERRALIB_RP_INTERNAL_CONTRAST_H
 
 #include "Algorithm.h"
+#include "BlockProcessor.h"
 
 #include <vector>
 #include <string>
@@ -92,6 +93,8 @@ namespace te
             
             bool m_enableProgress; //!< Enable/Disable the progress interface (default:false).
             
+            bool m_enableMultiThread; //!< Enable/Disable the use of multi-threads (default:true).
+            
             //@}
             
             /*!
@@ -283,16 +286,32 @@ namespace te
 
         /*!
           \brief Band gray levels remap using a remap function.
-          \param inRasterBand Input raster band.
-          \param outRasterBand Output raster band.
+          \param inRaster Input raster.
+          \param inBandIdx Input raster band index.
+          \param outRaster Output raster (it may be the input raster).
+          \param outBandIdx Output raster band index.
           \param remapFuncPtr The remap function pointer used.
           \param enableProgress Enable the use of a progress interface.
           \return true if OK, false on errors.
          */        
-        bool remapBandLevels( const te::rst::Band& inRasterBand,
-          te::rst::Band& outRasterBand, RemapFuncPtrT remapFuncPtr,
+        bool remapBandLevels( const te::rst::Raster& inRaster,
+          const unsigned int inBandIdx, te::rst::Raster& outRaster,
+          const unsigned int outBandIdx, RemapFuncPtrT remapFuncPtr,
           const bool enableProgress );
           
+        /*!
+          \brief Remaps the gray levels of one block window (BlockProcessor function).
+          \param inBandIdx Input raster band index.
+          \param outBandIdx Output raster band index.
+          \param remapFuncPtr The remap function pointer used.
+          \param window The block window.
+          \param context The executing thread context.
+          \return true if OK, false on errors.
+         */        
+        bool remapBlockLevels( const unsigned int inBandIdx,
+          const unsigned int outBandIdx, RemapFuncPtrT remapFuncPtr,
+          const BlockWindow& window, BlockContext& context );
+          
         // Variables used by offSetGainRemap
         double m_offSetGainRemap_offset1;
         double m_offSetGainRemap_offset2;
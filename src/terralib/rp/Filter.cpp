@@ -31,9 +31,13 @@
 #include "../raster/Grid.h"
 #include "../raster/Band.h"
 #include "../raster/BandIterator.h"
-#include "../raster/BandIteratorWindow.h"
 #include "../common/progress/TaskProgress.h"
 
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <map>
 #include <memory>
 #include <cmath>
 
@@ -67,6 +71,7 @@ namespace te
       m_windowH = 3;
       m_windowW = 3;
       m_enableProgress = false;
+      m_enableMultiThread = true;
       m_window.clear();
     }
 
@@ -82,6 +87,7 @@ namespace te
       m_windowH = params.m_windowH;
       m_windowW = params.m_windowW;
       m_enableProgress = params.m_enableProgress;
+      m_enableMultiThread = params.m_enableMultiThread;
 
       if (m_filterType == InputParameters::UserDefinedWindowT)
         m_window = params.m_window;
@@ -140,17 +146,6 @@ namespace te
 
     Filter::~Filter()
     {
-      if (m_convBuffer != 0) {
-        for (unsigned int line = 0; line < m_convBufferLines; ++line) {
-          delete[] m_convBuffer[line];
-        }
-
-        delete[] m_convBuffer;
-
-        m_convBuffer = 0;
-        m_convBufferLines = 0;
-        m_convBufferColumns = 0;
-      }
     }
 
     bool Filter::execute( AlgorithmOutputParameters& outputParams )
@@ -295,21 +290,26 @@ namespace te
         }
       }
 
-      const bool useGlobalProgress = ( ( m_inputParameters.m_iterationsNumber *
-        m_inputParameters.m_inRasterBands.size() ) != 1 );
+      // The halo must cover the filter window radius and
+      // the Roberts/Sobel forward neighbours
+
+      const unsigned int haloRows = std::max( 2u, m_inputParameters.m_windowH / 2 );
+      const unsigned int haloCols = std::max( 2u, m_inputParameters.m_windowW / 2 );
+
+      const bool useGlobalProgress = ( m_inputParameters.m_iterationsNumber > 1 );
 
       std::auto_ptr< te::common::TaskProgress > task;
       if( m_inputParameters.m_enableProgress && useGlobalProgress )
       {
         task.reset( new te::common::TaskProgress(TE_TR("Filtering"),
           te::common::TaskProgress::UNDEFINED,
-         ( m_inputParameters.m_iterationsNumber *
-          m_inputParameters.m_inRasterBands.size() ) ) );
+          m_inputParameters.m_iterationsNumber ) );
       }
 
       te::rst::Raster const* srcRasterPtr = 0;
       te::rst::Raster* dstRasterPtr = 0;
       te::rst::Raster const* auxRasterPtr = 0;
+      std::vector< unsigned int > srcBandsIndexes;
 
       for( unsigned int iteration = 0 ; iteration <
         m_inputParameters.m_iterationsNumber ; ++iteration )
@@ -320,6 +320,7 @@ namespace te
         if( iteration == 0 )
         {
           srcRasterPtr = m_inputParameters.m_inRasterPtr;
+          srcBandsIndexes = m_inputParameters.m_inRasterBands;
 
           if( m_inputParameters.m_iterationsNumber == 1 )
           {
@@ -330,38 +331,61 @@ namespace te
             dstRasterPtr = bufferRaster1Ptr.get();
           }
         }
-        else if( iteration == ( m_inputParameters.m_iterationsNumber - 1 ) )
+        else
         {
-          srcRasterPtr = dstRasterPtr;
+          if( iteration == 1 )
+          {
+            srcBandsIndexes.clear();
+            for( unsigned int bandIdx = 0 ; bandIdx <
+              m_inputParameters.m_inRasterBands.size() ; ++bandIdx )
+            {
+              srcBandsIndexes.push_back( bandIdx );
+            }
+          }
 
-          dstRasterPtr = outParamsPtr->m_outputRasterPtr.get();
-        }
-        else if( iteration == 1 )
-        {
-          srcRasterPtr = dstRasterPtr;
+          if( iteration == ( m_inputParameters.m_iterationsNumber - 1 ) )
+          {
+            srcRasterPtr = dstRasterPtr;
+
+            dstRasterPtr = outParamsPtr->m_outputRasterPtr.get();
+          }
+          else if( iteration == 1 )
+          {
+            srcRasterPtr = dstRasterPtr;
 
-          dstRasterPtr = bufferRaster2Ptr.get();
+            dstRasterPtr = bufferRaster2Ptr.get();
+          }
+          else
+          {
+            auxRasterPtr = srcRasterPtr;
+            srcRasterPtr = dstRasterPtr;
+            dstRasterPtr = (te::rst::Raster*)auxRasterPtr;
+          }
         }
-        else
+
+        // Filtering all bands, block by block
+
+        BlockProcessor processor;
+        processor.setOutputRaster( *dstRasterPtr );
+        processor.addInputRaster( *srcRasterPtr );
+        processor.setHalo( haloRows, haloCols );
+        processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
+        if( m_inputParameters.m_enableProgress && ( ! useGlobalProgress ) )
         {
-          auxRasterPtr = srcRasterPtr;
-          srcRasterPtr = dstRasterPtr;
-          dstRasterPtr = (te::rst::Raster*)auxRasterPtr;
+          processor.enableProgress( TE_TR("Filtering") );
         }
 
-        for( unsigned int inRasterBandsIdx = 0 ; inRasterBandsIdx <
-          m_inputParameters.m_inRasterBands.size() ; ++inRasterBandsIdx )
+        if( ! processor.execute( boost::bind( &Filter::filterBlock, this,
+          filterPointer, boost::cref( srcBandsIndexes ), _1, _2 ) ) )
         {
-          if( (this->*(filterPointer))( *srcRasterPtr, ( iteration == 0 ) ?
-            m_inputParameters.m_inRasterBands[ inRasterBandsIdx ] :
-            inRasterBandsIdx, *dstRasterPtr, inRasterBandsIdx,
-            ( m_inputParameters.m_enableProgress && (!useGlobalProgress) ) ) ==
-            false )
-          {
-            TERP_LOG_AND_RETURN_FALSE( TE_TR( "Filter error" ) );
-          }
+          TERP_LOG_AND_RETURN_FALSE( TE_TR( "Filter error" ) );
         }
 
+        if( task.get() )
+        {
+          task->pulse();
+          if( !task->isActive() ) return false;
+        }
       }
 
       return true;
@@ -371,10 +395,6 @@ namespace te
     {
       m_isInitialized = false;
       m_inputParameters.reset();
-
-      m_convBuffer = 0;
-      m_convBufferLines = 0;
-      m_convBufferColumns = 0;
     }
 
     bool Filter::initialize( const AlgorithmInputParameters& inputParams )
@@ -454,39 +474,60 @@ namespace te
       return m_isInitialized;
     }
 
-    bool Filter::RobertsFilter( const te::rst::Raster& srcRaster,
-      const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-      const unsigned int dstBandIdx, const bool useProgress )
+    bool Filter::filterBlock( FilterMethodPointerT filterPointer,
+      const std::vector< unsigned int >& srcBandsIndexes,
+      const BlockWindow& window, BlockContext& context ) const
     {
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfColumns() ==
-        dstRaster.getNumberOfColumns(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfRows() ==
-        dstRaster.getNumberOfRows(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcBandIdx < srcRaster.getNumberOfBands(),
-        "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( dstBandIdx < dstRaster.getNumberOfBands(),
+      const te::rst::Raster& srcRaster = context.getInputRaster( 0 );
+      te::rst::Raster& dstRaster = context.getOutputRaster();
+
+      TERP_DEBUG_TRUE_OR_THROW( srcBandsIndexes.size() <= dstRaster.getNumberOfBands(),
         "Internal error" );
 
-      const unsigned int nRows = (unsigned int)( srcRaster.getNumberOfRows() );
+      std::vector< double > srcBuffer(
+        ( window.m_haloRowsBound - window.m_haloFirstRow ) *
+        ( window.m_haloColsBound - window.m_haloFirstCol ) );
+      unsigned int bufferIdx = 0;
+      unsigned int row = 0;
+      unsigned int col = 0;
+
+      for( unsigned int bandIdx = 0 ; bandIdx < srcBandsIndexes.size() ; ++bandIdx )
+      {
+        if( context.isCancelled() ) return true;
+
+        const te::rst::Band& srcBand = *srcRaster.getBand( srcBandsIndexes[ bandIdx ] );
+
+        bufferIdx = 0;
+
+        for( row = window.m_haloFirstRow ; row < window.m_haloRowsBound ; ++row )
+        {
+          for( col = window.m_haloFirstCol ; col < window.m_haloColsBound ; ++col )
+          {
+            srcBand.getValue( col, row, srcBuffer[ bufferIdx++ ] );
+          }
+        }
+
+        (this->*(filterPointer))( window, srcBuffer,
+          srcBand.getProperty()->m_noDataValue, *dstRaster.getBand( bandIdx ) );
+      }
+
+      return true;
+    }
+
+    void Filter::RobertsFilter( const BlockWindow& window,
+      const std::vector< double >& srcBuffer, const double srcNoDataValue,
+      te::rst::Band& dstBand ) const
+    {
+      const unsigned int nRows = (unsigned int)( dstBand.getRaster()->getNumberOfRows() );
       const unsigned int rowsBound = (unsigned int)( nRows ?
         ( nRows - 1 ) : 0 );
 
-      const unsigned int nCols = (unsigned int)( srcRaster.getNumberOfColumns() );
+      const unsigned int nCols = (unsigned int)( dstBand.getRaster()->getNumberOfColumns() );
       const unsigned int colsBound = (unsigned int)( nCols ?
         ( nCols - 1 ) : 0 );
 
-      std::auto_ptr< te::common::TaskProgress > task;
-      if( useProgress )
-      {
-        task.reset( new te::common::TaskProgress(TE_TR("Mean Filter"),
-          te::common::TaskProgress::UNDEFINED,
-         srcRaster.getNumberOfRows() - 2) );
-      }
-
-      const te::rst::Band& srcBand = *srcRaster.getBand( srcBandIdx );
-      te::rst::Band& dstBand = *dstRaster.getBand( dstBandIdx );
+      const unsigned int bufferCols = window.m_haloColsBound - window.m_haloFirstCol;
 
-      const double srcNoDataValue = srcBand.getProperty()->m_noDataValue;
       const double dstNoDataValue = dstBand.getProperty()->m_noDataValue;
 
       double dstBandAllowedMin = 0;
@@ -495,6 +536,7 @@ namespace te
         dstBandAllowedMax );
 
       unsigned int col = 0;
+      unsigned int bufferIdx = 0;
       double value1diag = 0;
       double value2diag = 0;
       double value1adiag = 0;
@@ -503,35 +545,22 @@ namespace te
       double adiagDiff = 0;
       double outValue = 0;
 
-      for( unsigned int row = 0; row < nRows ; ++row )
+      for( unsigned int row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
       {
-        for( col = 0 ; col < nCols ; ++col )
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
         {
           if( ( row < rowsBound ) && ( col < colsBound ) )
           {
-            srcBand.getValue( col, row, value1diag );
-            if( value1diag == srcNoDataValue )
-            {
-              dstBand.setValue( col, row, dstNoDataValue );
-              continue;
-            }
+            bufferIdx = ( ( row - window.m_haloFirstRow ) * bufferCols ) +
+              ( col - window.m_haloFirstCol );
 
-            srcBand.getValue( col + 1, row + 1, value2diag );
-            if( value2diag == srcNoDataValue )
-            {
-              dstBand.setValue( col, row, dstNoDataValue );
-              continue;
-            }
+            value1diag = srcBuffer[ bufferIdx ];
+            value2diag = srcBuffer[ bufferIdx + bufferCols + 1 ];
+            value1adiag = srcBuffer[ bufferIdx + bufferCols ];
+            value2adiag = srcBuffer[ bufferIdx + 1 ];
 
-            srcBand.getValue( col, row + 1, value1adiag );
-            if( value1adiag == srcNoDataValue )
-            {
-              dstBand.setValue( col, row, dstNoDataValue );
-              continue;
-            }
-
-            srcBand.getValue( col + 1, row, value2adiag );
-            if( value2adiag == srcNoDataValue )
+            if( ( value1diag == srcNoDataValue ) || ( value2diag == srcNoDataValue ) ||
+              ( value1adiag == srcNoDataValue ) || ( value2adiag == srcNoDataValue ) )
             {
               dstBand.setValue( col, row, dstNoDataValue );
               continue;
@@ -552,48 +581,24 @@ namespace te
             dstBand.setValue( col, row, dstNoDataValue );
           }
         }
-
-        if( useProgress )
-        {
-          task->pulse();
-          if( !task->isActive() ) return false;
-        }
       }
-
-      return true;
     }
 
-    bool Filter::SobelFilter( const te::rst::Raster& srcRaster,
-      const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-      const unsigned int dstBandIdx, const bool useProgress )
+    void Filter::SobelFilter( const BlockWindow& window,
+      const std::vector< double >& srcBuffer, const double,
+      te::rst::Band& dstBand ) const
     {
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfColumns() ==
-        dstRaster.getNumberOfColumns(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfRows() ==
-        dstRaster.getNumberOfRows(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcBandIdx < srcRaster.getNumberOfBands(),
-        "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( dstBandIdx < dstRaster.getNumberOfBands(),
-        "Internal error" );
+      // The output pixel (col,row) is computed from the 3x3 source
+      // window starting at (col,row); the last two rows and columns
+      // are not written.
 
-      const unsigned int nRows = (unsigned int)( srcRaster.getNumberOfRows() );
-      const unsigned int rowsBound = (unsigned int)( nRows - 2 );
+      const unsigned int rowsBound = std::min( window.m_rowsBound,
+        (unsigned int)( dstBand.getRaster()->getNumberOfRows() - 2 ) );
 
-      const unsigned int nCols = (unsigned int)( srcRaster.getNumberOfColumns() );
-      const unsigned int colsBound = (unsigned int)( nCols - 2 );
+      const unsigned int colsBound = std::min( window.m_colsBound,
+        (unsigned int)( dstBand.getRaster()->getNumberOfColumns() - 2 ) );
 
-      ResetConvBuffer(3, nCols);
-
-      std::auto_ptr< te::common::TaskProgress > task;
-      if( useProgress )
-      {
-        task.reset( new te::common::TaskProgress(TE_TR("Sobel Filter"),
-          te::common::TaskProgress::UNDEFINED,
-         srcRaster.getNumberOfRows() - 2) );
-      }
-
-      const te::rst::Band& srcBand = *srcRaster.getBand( srcBandIdx );
-      te::rst::Band& dstBand = *dstRaster.getBand( dstBandIdx );
+      const unsigned int bufferCols = window.m_haloColsBound - window.m_haloFirstCol;
 
       double dstBandAllowedMin = 0;
       double dstBandAllowedMax = 0;
@@ -601,38 +606,36 @@ namespace te
         dstBandAllowedMax );
 
       unsigned int col = 0;
+      double const* line0Ptr = 0;
+      double const* line1Ptr = 0;
+      double const* line2Ptr = 0;
       double gY = 0;
       double gX = 0;
       double outValue = 0;
 
-      /* Fills the convolution buffer with the first "mask_lines" from the raster */
-
-      for (unsigned int line = 0; line < 2; ++line) {
-        UpdateConvBuffer(srcBand, line);
-      }
-
-      /* raster convolution */
-
-      for( unsigned int row = 0; row < rowsBound ; ++row )
+      for( unsigned int row = window.m_firstRow ; row < rowsBound ; ++row )
       {
-        /* Getting one more line from the source raster and adding to buffer */
-        UpdateConvBuffer(srcBand, row + 2);
+        line0Ptr = &srcBuffer[ ( row - window.m_haloFirstRow ) * bufferCols ];
+        line1Ptr = line0Ptr + bufferCols;
+        line2Ptr = line1Ptr + bufferCols;
 
-        for( col = 0 ; col < colsBound ; ++col )
+        for( col = window.m_firstCol ; col < colsBound ; ++col )
         {
-          gX = m_convBuffer[2][col] +
-            (2 * m_convBuffer[2][col + 1]) +
-            m_convBuffer[2][col + 2] -
-            m_convBuffer[0][col] -
-            (2 * m_convBuffer[0][col + 1]) -
-            m_convBuffer[0][col + 2];
-
-          gY = m_convBuffer[0][col + 2] +
-            (2 * m_convBuffer[1][col + 2]) +
-            m_convBuffer[2][col + 2] -
-            m_convBuffer[0][col] -
-            (2 * m_convBuffer[1][col]) -
-            m_convBuffer[2][col];
+          const unsigned int bufCol = col - window.m_haloFirstCol;
+
+          gX = line2Ptr[bufCol] +
+            (2 * line2Ptr[bufCol + 1]) +
+            line2Ptr[bufCol + 2] -
+            line0Ptr[bufCol] -
+            (2 * line0Ptr[bufCol + 1]) -
+            line0Ptr[bufCol + 2];
+
+          gY = line0Ptr[bufCol + 2] +
+            (2 * line1Ptr[bufCol + 2]) +
+            line2Ptr[bufCol + 2] -
+            line0Ptr[bufCol] -
+            (2 * line1Ptr[bufCol]) -
+            line2Ptr[bufCol];
 
           outValue = std::sqrt( ( gY * gY ) +
             ( gX * gX ) );
@@ -641,97 +644,54 @@ namespace te
 
           dstBand.setValue( col, row, outValue );
         }
-
-        if( useProgress )
-        {
-          task->pulse();
-          if( !task->isActive() ) return false;
-        }
       }
-
-      return true;
     }
 
-    bool Filter::MeanFilter( const te::rst::Raster& srcRaster,
-      const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-      const unsigned int dstBandIdx, const bool useProgress )
+    void Filter::MeanFilter( const BlockWindow& window,
+      const std::vector< double >& srcBuffer, const double srcNoDataValue,
+      te::rst::Band& dstBand ) const
     {
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfColumns() ==
-        dstRaster.getNumberOfColumns(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfRows() ==
-        dstRaster.getNumberOfRows(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcBandIdx < srcRaster.getNumberOfBands(),
-        "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( dstBandIdx < dstRaster.getNumberOfBands(),
-        "Internal error" );
-
-      const unsigned int nRows = srcRaster.getNumberOfRows();
-      const unsigned int nCols = srcRaster.getNumberOfColumns();
+      const unsigned int nRows = (unsigned int)( dstBand.getRaster()->getNumberOfRows() );
+      const unsigned int nCols = (unsigned int)( dstBand.getRaster()->getNumberOfColumns() );
       const unsigned int windowHeight = m_inputParameters.m_windowH;
       const unsigned int windowWidth = m_inputParameters.m_windowW;
       const unsigned int windowRowRadius = ( windowHeight / 2 );
       const unsigned int windowColRadius = ( windowWidth / 2 );
-      const unsigned int filterStartRowOffsetBound = nRows - windowHeight + 1;
-      const unsigned int filterStartColOffsetBound = nCols - windowWidth + 1;
       const unsigned int validDataRowsBound = nRows - windowRowRadius;
       const unsigned int validDataColsBound = nCols - windowColRadius;
-      unsigned int filterStartRow = 0;
-      unsigned int filterStartCol = 0;
+      const unsigned int bufferCols = window.m_haloColsBound - window.m_haloFirstCol;
+      const double dstNoDataValue = dstBand.getProperty()->m_noDataValue;
+      unsigned int col = 0;
       unsigned int rowOffset = 0;
       unsigned int colOffset = 0;
-      std::map< double , unsigned int > frequencies;
-      const te::rst::Band& srcBand = *( srcRaster.getBand( srcBandIdx ) );
-      te::rst::Band& dstBand = *( dstRaster.getBand( dstBandIdx ) );
-      const double srcNoDataValue = srcBand.getProperty()->m_noDataValue;
-      const double dstNoDataValue = dstBand.getProperty()->m_noDataValue;
+      double const* bufferLinePtr = 0;
       double value = 0;
-      unsigned int row = 0;
-      unsigned int col = 0;
-      std::map< double , unsigned int >::iterator frequenciesIt;
-      std::map< double , unsigned int >::iterator frequenciesItEnd;
       double meanValue = 0;
       unsigned int meanValidPixelsNmb = 0;
-      
-      std::auto_ptr< te::common::TaskProgress > task;
-      if( useProgress )
-      {
-        task.reset( new te::common::TaskProgress(TE_TR("Mode Filter"),
-          te::common::TaskProgress::UNDEFINED, filterStartRowOffsetBound + nRows ) );
-      }      
-      
-      for( row = 0 ; row < nRows ; ++row )
+
+      for( unsigned int row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
       {
-        for( col = 0 ; col < nCols ; ++col )
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
         {
           if( ( row < windowRowRadius ) || ( row >= validDataRowsBound ) ||
             ( col < windowColRadius ) || ( col >= validDataColsBound ) )
           {
             dstBand.setValue( col, row, dstNoDataValue );
+            continue;
           }
-        }
-        
-        if( useProgress )
-        {
-          task->pulse();
-          if( !task->isActive() ) return false;
-        }         
-      }
-      
-      for( filterStartRow = 0 ; filterStartRow < filterStartRowOffsetBound ; ++filterStartRow )
-      {
-        for( filterStartCol = 0 ; filterStartCol < filterStartColOffsetBound ; ++filterStartCol )
-        {
+
           meanValue = 0;
           meanValidPixelsNmb = 0;
-          
+
           for( rowOffset = 0 ; rowOffset < windowHeight ; ++rowOffset )
           {
-            row = filterStartRow + rowOffset;
-            
+            bufferLinePtr = &srcBuffer[ ( ( row - windowRowRadius + rowOffset -
+              window.m_haloFirstRow ) * bufferCols ) + ( col - windowColRadius -
+              window.m_haloFirstCol ) ];
+
             for( colOffset = 0 ; colOffset < windowWidth ; ++colOffset )
             {
-              col = filterStartCol + colOffset;
-              srcBand.getValue( col, row, value );
+              value = bufferLinePtr[ colOffset ];
               if( value != srcNoDataValue )
               {
                 meanValue += value;
@@ -739,116 +699,74 @@ namespace te
               }
             }
           }
-          
+
           if( meanValidPixelsNmb )
           {
             meanValue /= (double)meanValidPixelsNmb;
-            dstBand.setValue( filterStartCol + windowColRadius, 
-              filterStartRow + windowRowRadius, meanValue );            
+            dstBand.setValue( col, row, meanValue );
           }
           else
           {
-            dstBand.setValue( filterStartCol + windowColRadius, 
-              filterStartRow + windowRowRadius, dstNoDataValue );
+            dstBand.setValue( col, row, dstNoDataValue );
           }
         }
-        
-        if( useProgress )
-        {
-          task->pulse();
-          if( !task->isActive() ) return false;
-        }        
       }
-
-      return true;
     }
 
-    bool Filter::ModeFilter( const te::rst::Raster& srcRaster,
-      const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-      const unsigned int dstBandIdx, const bool useProgress )
+    void Filter::ModeFilter( const BlockWindow& window,
+      const std::vector< double >& srcBuffer, const double srcNoDataValue,
+      te::rst::Band& dstBand ) const
     {
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfColumns() ==
-        dstRaster.getNumberOfColumns(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfRows() ==
-        dstRaster.getNumberOfRows(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcBandIdx < srcRaster.getNumberOfBands(),
-        "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( dstBandIdx < dstRaster.getNumberOfBands(),
-        "Internal error" );
-
-      const unsigned int nRows = srcRaster.getNumberOfRows();
-      const unsigned int nCols = srcRaster.getNumberOfColumns();
+      const unsigned int nRows = (unsigned int)( dstBand.getRaster()->getNumberOfRows() );
+      const unsigned int nCols = (unsigned int)( dstBand.getRaster()->getNumberOfColumns() );
       const unsigned int windowHeight = m_inputParameters.m_windowH;
       const unsigned int windowWidth = m_inputParameters.m_windowW;
       const unsigned int windowRowRadius = ( windowHeight / 2 );
       const unsigned int windowColRadius = ( windowWidth / 2 );
-      const unsigned int filterStartRowOffsetBound = nRows - windowHeight + 1;
-      const unsigned int filterStartColOffsetBound = nCols - windowWidth + 1;
       const unsigned int validDataRowsBound = nRows - windowRowRadius;
       const unsigned int validDataColsBound = nCols - windowColRadius;
-      unsigned int filterStartRow = 0;
-      unsigned int filterStartCol = 0;
+      const unsigned int bufferCols = window.m_haloColsBound - window.m_haloFirstCol;
+      const double dstNoDataValue = dstBand.getProperty()->m_noDataValue;
+      unsigned int col = 0;
       unsigned int rowOffset = 0;
       unsigned int colOffset = 0;
-      std::map< double , unsigned int > frequencies;
-      const te::rst::Band& srcBand = *( srcRaster.getBand( srcBandIdx ) );
-      te::rst::Band& dstBand = *( dstRaster.getBand( dstBandIdx ) );
-      const double srcNoDataValue = srcBand.getProperty()->m_noDataValue;
-      const double dstNoDataValue = dstBand.getProperty()->m_noDataValue;
+      double const* bufferLinePtr = 0;
       double value = 0;
-      unsigned int row = 0;
-      unsigned int col = 0;
+      std::map< double , unsigned int > frequencies;
       std::map< double , unsigned int >::iterator frequenciesIt;
       std::map< double , unsigned int >::iterator frequenciesItEnd;
       unsigned int higherFrequency = 0;
       double higherFrequencyValue = 0;
-      
-      std::auto_ptr< te::common::TaskProgress > task;
-      if( useProgress )
-      {
-        task.reset( new te::common::TaskProgress(TE_TR("Mode Filter"),
-          te::common::TaskProgress::UNDEFINED, filterStartRowOffsetBound + nRows ) );
-      }      
-      
-      for( row = 0 ; row < nRows ; ++row )
+
+      for( unsigned int row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
       {
-        for( col = 0 ; col < nCols ; ++col )
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
         {
           if( ( row < windowRowRadius ) || ( row >= validDataRowsBound ) ||
             ( col < windowColRadius ) || ( col >= validDataColsBound ) )
           {
             dstBand.setValue( col, row, dstNoDataValue );
+            continue;
           }
-        }
-        
-        if( useProgress )
-        {
-          task->pulse();
-          if( !task->isActive() ) return false;
-        }         
-      }
-      
-      for( filterStartRow = 0 ; filterStartRow < filterStartRowOffsetBound ; ++filterStartRow )
-      {
-        for( filterStartCol = 0 ; filterStartCol < filterStartColOffsetBound ; ++filterStartCol )
-        {
+
           frequencies.clear();
-          
+
           for( rowOffset = 0 ; rowOffset < windowHeight ; ++rowOffset )
           {
-            row = filterStartRow + rowOffset;
-            
+            bufferLinePtr = &srcBuffer[ ( ( row - windowRowRadius + rowOffset -
+              window.m_haloFirstRow ) * bufferCols ) + ( col - windowColRadius -
+              window.m_haloFirstCol ) ];
+
             for( colOffset = 0 ; colOffset < windowWidth ; ++colOffset )
             {
-              col = filterStartCol + colOffset;
-              srcBand.getValue( col, row, value );
+              value = bufferLinePtr[ colOffset ];
               if( value != srcNoDataValue )
               {
                 ++frequencies[ value ];
               }
             }
           }
-          
+
           frequenciesIt = frequencies.begin();
           frequenciesItEnd = frequencies.end();
           higherFrequency = 0;
@@ -857,407 +775,219 @@ namespace te
             if( frequenciesIt->second > higherFrequency )
             {
               higherFrequency = frequenciesIt->second;
-              higherFrequencyValue = frequenciesIt->first;              
+              higherFrequencyValue = frequenciesIt->first;
             }
-            
+
             ++frequenciesIt;
           }
-          
-          if( higherFrequency == 0.0 )
+
+          if( higherFrequency == 0 )
           {
-            dstBand.setValue( filterStartCol + windowColRadius, 
-              filterStartRow + windowRowRadius, dstNoDataValue );
+            dstBand.setValue( col, row, dstNoDataValue );
           }
           else
           {
-            dstBand.setValue( filterStartCol + windowColRadius, 
-              filterStartRow + windowRowRadius, higherFrequencyValue );
+            dstBand.setValue( col, row, higherFrequencyValue );
           }
         }
-        
-        if( useProgress )
-        {
-          task->pulse();
-          if( !task->isActive() ) return false;
-        }        
       }
-
-      return true;
     }
 
-    bool Filter::MedianFilter( const te::rst::Raster& srcRaster,
-      const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-      const unsigned int dstBandIdx, const bool useProgress )
+    void Filter::MedianFilter( const BlockWindow& window,
+      const std::vector< double >& srcBuffer, const double,
+      te::rst::Band& dstBand ) const
     {
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfColumns() ==
-        dstRaster.getNumberOfColumns(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfRows() ==
-        dstRaster.getNumberOfRows(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcBandIdx < srcRaster.getNumberOfBands(),
-        "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( dstBandIdx < dstRaster.getNumberOfBands(),
-        "Internal error" );
-
       const unsigned int H = m_inputParameters.m_windowH;
       const unsigned int W = m_inputParameters.m_windowW;
-
-      std::auto_ptr< te::common::TaskProgress > task;
-      if( useProgress )
-      {
-        task.reset( new te::common::TaskProgress(TE_TR("Median Filter"),
-          te::common::TaskProgress::UNDEFINED, 100 ) );
-      }
-
-      unsigned int R = 0;
-      unsigned int C = 0;
-      const unsigned int MR = srcRaster.getNumberOfRows();
-      const unsigned int MC = srcRaster.getNumberOfColumns();
+      const unsigned int MR = (unsigned int)( dstBand.getRaster()->getNumberOfRows() );
+      const unsigned int MC = (unsigned int)( dstBand.getRaster()->getNumberOfColumns() );
+      const unsigned int bufferCols = window.m_haloColsBound - window.m_haloFirstCol;
 
       double dstBandAllowedMin = 0;
       double dstBandAllowedMax = 0;
-      te::rp::GetDataTypeRange( dstRaster.getBand( dstBandIdx )->getProperty()->getType(), dstBandAllowedMin,
+      te::rp::GetDataTypeRange( dstBand.getProperty()->getType(), dstBandAllowedMin,
         dstBandAllowedMax );
 
       std::vector<double> pixels_in_window;
+      pixels_in_window.reserve( H * W );
       double pixel_median = 0.0;
+      double const* bufferLinePtr = 0;
+      unsigned int C = 0;
 
-      te::rst::Band const * const band = srcRaster.getBand(srcBandIdx);
-      te::rst::BandIteratorWindow<double> it = te::rst::BandIteratorWindow<double>::begin(band, W, H);
-      te::rst::BandIteratorWindow<double> itend = te::rst::BandIteratorWindow<double>::end(band, W, H);
-
-      while (it != itend)
+      for( unsigned int R = window.m_firstRow ; R < window.m_rowsBound ; ++R )
       {
-        R = it.getRow();
-        C = it.getColumn();
-
-        if ((R >= (unsigned)(H / 2) && R < MR - (H / 2)) &&
-            (C >= (unsigned)(W / 2) && C < MC - (W / 2)))
+        for( C = window.m_firstCol ; C < window.m_colsBound ; ++C )
         {
-          pixel_median = 0.0;
-          pixels_in_window.clear();
-          for (int r = -1 * (int) (H / 2); r <= (int) (H / 2); r++)
-            for (int c = -1 * (int) (W / 2); c <= (int) (W / 2); c++)
-              pixels_in_window.push_back(it.getValue(c, r));
-
-          std::sort(pixels_in_window.begin(), pixels_in_window.end(), OrderFunction);
-          pixel_median = pixels_in_window[pixels_in_window.size() / 2];
-        }
-        else
-          pixel_median = it.getValue();
+          if ((R >= (H / 2) && R < MR - (H / 2)) &&
+              (C >= (W / 2) && C < MC - (W / 2)))
+          {
+            pixels_in_window.clear();
+            for (unsigned int r = 0; r < H; r++)
+            {
+              bufferLinePtr = &srcBuffer[ ( ( R - (H / 2) + r - window.m_haloFirstRow ) *
+                bufferCols ) + ( C - (W / 2) - window.m_haloFirstCol ) ];
+              for (unsigned int c = 0; c < W; c++)
+                pixels_in_window.push_back(bufferLinePtr[c]);
+            }
 
-        pixel_median = std::max( pixel_median, dstBandAllowedMin );
-        pixel_median = std::min( pixel_median, dstBandAllowedMax );
-        dstRaster.setValue(C, R, pixel_median, dstBandIdx);
+            std::sort(pixels_in_window.begin(), pixels_in_window.end(), OrderFunction);
+            pixel_median = pixels_in_window[pixels_in_window.size() / 2];
+          }
+          else
+            pixel_median = srcBuffer[ ( ( R - window.m_haloFirstRow ) * bufferCols ) +
+              ( C - window.m_haloFirstCol ) ];
 
-        if( useProgress )
-        {
-          task->setCurrentStep( R / srcRaster.getNumberOfRows() );
-          if( !task->isActive() ) return false;
+          pixel_median = std::max( pixel_median, dstBandAllowedMin );
+          pixel_median = std::min( pixel_median, dstBandAllowedMax );
+          dstBand.setValue(C, R, pixel_median);
         }
-
-        ++it;
       }
-
-      return true;
     }
 
-    bool Filter::DilationFilter( const te::rst::Raster& srcRaster,
-      const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-      const unsigned int dstBandIdx, const bool useProgress )
+    void Filter::DilationFilter( const BlockWindow& window,
+      const std::vector< double >& srcBuffer, const double,
+      te::rst::Band& dstBand ) const
     {
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfColumns() ==
-        dstRaster.getNumberOfColumns(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfRows() ==
-        dstRaster.getNumberOfRows(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcBandIdx < srcRaster.getNumberOfBands(),
-        "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( dstBandIdx < dstRaster.getNumberOfBands(),
-        "Internal error" );
-
       const unsigned int H = m_inputParameters.m_windowH;
       const unsigned int W = m_inputParameters.m_windowW;
-
-      std::auto_ptr< te::common::TaskProgress > task;
-      if( useProgress )
-      {
-        task.reset( new te::common::TaskProgress(TE_TR("Dilation Filter"),
-          te::common::TaskProgress::UNDEFINED, 100 ) );
-      }
-
-      unsigned int R = 0;
-      unsigned int C = 0;
-      const unsigned int MR = srcRaster.getNumberOfRows();
-      const unsigned int MC = srcRaster.getNumberOfColumns();
+      const unsigned int MR = (unsigned int)( dstBand.getRaster()->getNumberOfRows() );
+      const unsigned int MC = (unsigned int)( dstBand.getRaster()->getNumberOfColumns() );
+      const unsigned int bufferCols = window.m_haloColsBound - window.m_haloFirstCol;
 
       double dstBandAllowedMin = 0;
       double dstBandAllowedMax = 0;
-      te::rp::GetDataTypeRange( dstRaster.getBand( dstBandIdx )->getProperty()->getType(), dstBandAllowedMin,
+      te::rp::GetDataTypeRange( dstBand.getProperty()->getType(), dstBandAllowedMin,
         dstBandAllowedMax );
 
       double pixel_dilation = 0;
-      double pixel = 0;
-
-      te::rst::Band const * const band = srcRaster.getBand(srcBandIdx);
-      te::rst::BandIteratorWindow<double> it = te::rst::BandIteratorWindow<double>::begin(band, W, H);
-      te::rst::BandIteratorWindow<double> itend = te::rst::BandIteratorWindow<double>::end(band, W, H);
+      double const* bufferLinePtr = 0;
+      unsigned int C = 0;
 
-      while (it != itend)
+      for( unsigned int R = window.m_firstRow ; R < window.m_rowsBound ; ++R )
       {
-        R = it.getRow();
-        C = it.getColumn();
-
-        if ((R >= (unsigned)(H / 2) && R < MR - (H / 2)) &&
-            (C >= (unsigned)(W / 2) && C < MC - (W / 2)))
+        for( C = window.m_firstCol ; C < window.m_colsBound ; ++C )
         {
-          pixel_dilation = -1.0 * std::numeric_limits<double>::max();
-          for (int r = -1 * (int) (H / 2); r <= (int) (H / 2); r++)
-            for (int c = -1 * (int) (W / 2); c <= (int) (W / 2); c++)
+          if ((R >= (H / 2) && R < MR - (H / 2)) &&
+              (C >= (W / 2) && C < MC - (W / 2)))
+          {
+            pixel_dilation = -1.0 * std::numeric_limits<double>::max();
+            for (unsigned int r = 0; r < H; r++)
             {
-              pixel = it.getValue(c, r);
-              if (pixel > pixel_dilation)
-                pixel_dilation = pixel;
+              bufferLinePtr = &srcBuffer[ ( ( R - (H / 2) + r - window.m_haloFirstRow ) *
+                bufferCols ) + ( C - (W / 2) - window.m_haloFirstCol ) ];
+              for (unsigned int c = 0; c < W; c++)
+                if (bufferLinePtr[c] > pixel_dilation)
+                  pixel_dilation = bufferLinePtr[c];
             }
-        }
-        else
-          pixel_dilation = it.getValue();
-
-        pixel_dilation = std::max( pixel_dilation, dstBandAllowedMin );
-        pixel_dilation = std::min( pixel_dilation, dstBandAllowedMax );
-        dstRaster.setValue(C, R, pixel_dilation, dstBandIdx);
+          }
+          else
+            pixel_dilation = srcBuffer[ ( ( R - window.m_haloFirstRow ) * bufferCols ) +
+              ( C - window.m_haloFirstCol ) ];
 
-        if( useProgress )
-        {
-          task->setCurrentStep( R / srcRaster.getNumberOfRows() );
-          if( !task->isActive() ) return false;
+          pixel_dilation = std::max( pixel_dilation, dstBandAllowedMin );
+          pixel_dilation = std::min( pixel_dilation, dstBandAllowedMax );
+          dstBand.setValue(C, R, pixel_dilation);
         }
-
-        ++it;
       }
-
-      return true;
     }
 
-    bool Filter::ErosionFilter( const te::rst::Raster& srcRaster,
-      const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-      const unsigned int dstBandIdx, const bool useProgress )
+    void Filter::ErosionFilter( const BlockWindow& window,
+      const std::vector< double >& srcBuffer, const double,
+      te::rst::Band& dstBand ) const
     {
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfColumns() ==
-        dstRaster.getNumberOfColumns(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfRows() ==
-        dstRaster.getNumberOfRows(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcBandIdx < srcRaster.getNumberOfBands(),
-        "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( dstBandIdx < dstRaster.getNumberOfBands(),
-        "Internal error" );
-
       const unsigned int H = m_inputParameters.m_windowH;
       const unsigned int W = m_inputParameters.m_windowW;
-
-      std::auto_ptr< te::common::TaskProgress > task;
-      if( useProgress )
-      {
-        task.reset( new te::common::TaskProgress(TE_TR("Erosion Filter"),
-          te::common::TaskProgress::UNDEFINED, 100 ) );
-      }
-
-      unsigned int R = 0;
-      unsigned int C = 0;
-      const unsigned int MR = srcRaster.getNumberOfRows();
-      const unsigned int MC = srcRaster.getNumberOfColumns();
+      const unsigned int MR = (unsigned int)( dstBand.getRaster()->getNumberOfRows() );
+      const unsigned int MC = (unsigned int)( dstBand.getRaster()->getNumberOfColumns() );
+      const unsigned int bufferCols = window.m_haloColsBound - window.m_haloFirstCol;
 
       double dstBandAllowedMin = 0;
       double dstBandAllowedMax = 0;
-      te::rp::GetDataTypeRange( dstRaster.getBand( dstBandIdx )->getProperty()->getType(), dstBandAllowedMin,
+      te::rp::GetDataTypeRange( dstBand.getProperty()->getType(), dstBandAllowedMin,
         dstBandAllowedMax );
 
       double pixel_erosion = 0;
-      double pixel = 0;
-
-      te::rst::Band const * const band = srcRaster.getBand(srcBandIdx);
-      te::rst::BandIteratorWindow<double> it = te::rst::BandIteratorWindow<double>::begin(band, W, H);
-      te::rst::BandIteratorWindow<double> itend = te::rst::BandIteratorWindow<double>::end(band, W, H);
+      double const* bufferLinePtr = 0;
+      unsigned int C = 0;
 
-      while (it != itend)
+      for( unsigned int R = window.m_firstRow ; R < window.m_rowsBound ; ++R )
       {
-        R = it.getRow();
-        C = it.getColumn();
-
-        if ((R >= (unsigned)(H / 2) && R < MR - (H / 2)) &&
-            (C >= (unsigned)(W / 2) && C < MC - (W / 2)))
+        for( C = window.m_firstCol ; C < window.m_colsBound ; ++C )
         {
-          pixel_erosion = std::numeric_limits<double>::max();
-          for (int r = -1 * (int) (H / 2); r <= (int) (H / 2); r++)
-            for (int c = -1 * (int) (W / 2); c <= (int) (W / 2); c++)
+          if ((R >= (H / 2) && R < MR - (H / 2)) &&
+              (C >= (W / 2) && C < MC - (W / 2)))
+          {
+            pixel_erosion = std::numeric_limits<double>::max();
+            for (unsigned int r = 0; r < H; r++)
             {
-              pixel = it.getValue(c, r);
-              if (pixel < pixel_erosion)
-                pixel_erosion = pixel;
+              bufferLinePtr = &srcBuffer[ ( ( R - (H / 2) + r - window.m_haloFirstRow ) *
+                bufferCols ) + ( C - (W / 2) - window.m_haloFirstCol ) ];
+              for (unsigned int c = 0; c < W; c++)
+                if (bufferLinePtr[c] < pixel_erosion)
+                  pixel_erosion = bufferLinePtr[c];
             }
-        }
-        else
-          pixel_erosion = it.getValue();
-
-        pixel_erosion = std::max( pixel_erosion, dstBandAllowedMin );
-        pixel_erosion = std::min( pixel_erosion, dstBandAllowedMax );
-        dstRaster.setValue(C, R, pixel_erosion, dstBandIdx);
+          }
+          else
+            pixel_erosion = srcBuffer[ ( ( R - window.m_haloFirstRow ) * bufferCols ) +
+              ( C - window.m_haloFirstCol ) ];
 
-        if( useProgress )
-        {
-          task->setCurrentStep( R / srcRaster.getNumberOfRows() );
-          if( !task->isActive() ) return false;
+          pixel_erosion = std::max( pixel_erosion, dstBandAllowedMin );
+          pixel_erosion = std::min( pixel_erosion, dstBandAllowedMax );
+          dstBand.setValue(C, R, pixel_erosion);
         }
-
-        ++it;
       }
-
-      return true;
     }
 
-    bool Filter::UserDefinedFilter( const te::rst::Raster& srcRaster,
-      const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-      const unsigned int dstBandIdx, const bool useProgress )
+    void Filter::UserDefinedFilter( const BlockWindow& window,
+      const std::vector< double >& srcBuffer, const double,
+      te::rst::Band& dstBand ) const
     {
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfColumns() ==
-        dstRaster.getNumberOfColumns(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcRaster.getNumberOfRows() ==
-        dstRaster.getNumberOfRows(), "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( srcBandIdx < srcRaster.getNumberOfBands(),
-        "Internal error" );
-      TERP_DEBUG_TRUE_OR_THROW( dstBandIdx < dstRaster.getNumberOfBands(),
-        "Internal error" );
-
       const unsigned int H = m_inputParameters.m_windowH;
       const unsigned int W = m_inputParameters.m_windowW;
-
-      std::auto_ptr< te::common::TaskProgress > task;
-      if( useProgress )
-      {
-        task.reset( new te::common::TaskProgress(TE_TR("User Defined Filter"),
-          te::common::TaskProgress::UNDEFINED, 100 ) );
-      }
-
-      unsigned int R = 0;
-      unsigned int C = 0;
-      const unsigned int MR = srcRaster.getNumberOfRows();
-      const unsigned int MC = srcRaster.getNumberOfColumns();
-      double pixels_in_window = 0;
+      const unsigned int MR = (unsigned int)( dstBand.getRaster()->getNumberOfRows() );
+      const unsigned int MC = (unsigned int)( dstBand.getRaster()->getNumberOfColumns() );
+      const unsigned int bufferCols = window.m_haloColsBound - window.m_haloFirstCol;
 
       double dstBandAllowedMin = 0;
       double dstBandAllowedMax = 0;
-      te::rp::GetDataTypeRange( dstRaster.getBand( dstBandIdx )->getProperty()->getType(), dstBandAllowedMin,
+      te::rp::GetDataTypeRange( dstBand.getProperty()->getType(), dstBandAllowedMin,
         dstBandAllowedMax );
 
-      te::rst::Band const * const band = srcRaster.getBand(srcBandIdx);
-      te::rst::BandIteratorWindow<double> it = te::rst::BandIteratorWindow<double>::begin(band, W, H);
-      te::rst::BandIteratorWindow<double> itend = te::rst::BandIteratorWindow<double>::end(band, W, H);
+      double pixels_in_window = 0;
+      double const* bufferLinePtr = 0;
+      unsigned int C = 0;
 
-      while (it != itend)
+      for( unsigned int R = window.m_firstRow ; R < window.m_rowsBound ; ++R )
       {
-        R = it.getRow();
-        C = it.getColumn();
-        if ((R >= (unsigned)(H / 2) && R < MR - (H / 2)) &&
-            (C >= (unsigned)(W / 2) && C < MC - (W / 2)))
+        for( C = window.m_firstCol ; C < window.m_colsBound ; ++C )
         {
-          pixels_in_window = 0.0;
-          for (int r = -1 * (int) (H / 2), rw = 0; r <= (int) (H / 2); r++, rw++)
-            for (int c = -1 * (int) (W / 2), cw = 0; c <= (int) (W / 2); c++, cw++)
-              pixels_in_window += m_inputParameters.m_window(rw, cw) * it.getValue(c, r);
-        }
-        else
-          pixels_in_window = it.getValue();
-
-        pixels_in_window = std::max( pixels_in_window, dstBandAllowedMin );
-        pixels_in_window = std::min( pixels_in_window, dstBandAllowedMax );
-        dstRaster.setValue(C, R, pixels_in_window, dstBandIdx);
+          if ((R >= (H / 2) && R < MR - (H / 2)) &&
+              (C >= (W / 2) && C < MC - (W / 2)))
+          {
+            pixels_in_window = 0.0;
+            for (unsigned int rw = 0; rw < H; rw++)
+            {
+              bufferLinePtr = &srcBuffer[ ( ( R - (H / 2) + rw - window.m_haloFirstRow ) *
+                bufferCols ) + ( C - (W / 2) - window.m_haloFirstCol ) ];
+              for (unsigned int cw = 0; cw < W; cw++)
+                pixels_in_window += m_inputParameters.m_window(rw, cw) * bufferLinePtr[cw];
+            }
+          }
+          else
+            pixels_in_window = srcBuffer[ ( ( R - window.m_haloFirstRow ) * bufferCols ) +
+              ( C - window.m_haloFirstCol ) ];
 
-        if( useProgress )
-        {
-          task->setCurrentStep( R / srcRaster.getNumberOfRows() );
-          if( !task->isActive() ) return false;
+          pixels_in_window = std::max( pixels_in_window, dstBandAllowedMin );
+          pixels_in_window = std::min( pixels_in_window, dstBandAllowedMax );
+          dstBand.setValue(C, R, pixels_in_window);
         }
-
-        ++it;
       }
-
-      return true;
     }
 
     bool Filter::OrderFunction(double i, double j)
     {
       return (i < j);
     }
-
-    void Filter::ResetConvBuffer(unsigned int lines, unsigned int columns)
-    {
-      if (m_convBuffer != 0) {
-        for (unsigned int line = 0; line < m_convBufferLines; ++line) {
-          delete[] m_convBuffer[line];
-        }
-
-        delete[] m_convBuffer;
-
-        m_convBuffer = 0;
-        m_convBufferLines = 0;
-        m_convBufferColumns = 0;
-      }
-
-      if ((lines > 0) && (columns > 0)) {
-        m_convBuffer = new double*[lines];
-
-        TERP_DEBUG_TRUE_OR_THROW(m_convBuffer != 0, "Memory allocation error");
-
-        for (unsigned int line = 0; line < lines; ++line) {
-          m_convBuffer[line] = new double[columns];
-
-          TERP_DEBUG_TRUE_OR_THROW(m_convBuffer[line] != 0, "Memory allocation error");
-        }
-
-        m_convBufferLines = lines;
-        m_convBufferColumns = columns;
-      }
-    }
-
-    void Filter::UpdateConvBuffer(const te::rst::Band& inRaster, unsigned int line)
-    {
-      TERP_DEBUG_TRUE_OR_THROW((inRaster.getRaster()->getNumberOfRows() > (int)line),
-        "Trying to get a non existent line from raster");
-      TERP_DEBUG_TRUE_OR_THROW((inRaster.getRaster()->getNumberOfColumns() ==
-        (int)m_convBufferColumns),
-        "Buffer columns number not equal to raster columns");
-
-
-      /* Buffer roll up */
-
-      ConvBufferRoolup(1);
-
-      /* Updating the last line */
-
-      unsigned int convBufferLastLine = m_convBufferLines - 1;
-
-      for (unsigned int bufcolumn = 0; bufcolumn < m_convBufferColumns; ++bufcolumn) {
-        inRaster.getValue(bufcolumn, line,
-          m_convBuffer[convBufferLastLine][bufcolumn]);
-      }
-    }
-
-    void Filter::ConvBufferRoolup(unsigned int count)
-    {
-      TERP_DEBUG_TRUE_OR_THROW((m_convBufferLines > 0), "Invalid convolution buffer lines");
-
-      double* firstBufferLinePtr;
-      unsigned int convBufferLastLine = m_convBufferLines - 1;
-      unsigned int bufline;
-
-      for (unsigned int curCount = 0; curCount < count; ++curCount) {
-        firstBufferLinePtr = m_convBuffer[0];
-
-        for (bufline = 1; bufline < m_convBufferLines; ++bufline) {
-          m_convBuffer[bufline - 1] = m_convBuffer[bufline];
-        }
-
-        m_convBuffer[convBufferLastLine] = firstBufferLinePtr;
-      }
-    }
   } // end namespace rp
 }   // end namespace te
 
@@ -26,6 +26,7 @@
 #define __TERRALIB_RP_INTERNAL_FILTER_H
 
 #include "Algorithm.h"
+#include "BlockProcessor.h"
 #include "../raster/Raster.h"
 
 // Boost
@@ -84,6 +85,8 @@ namespace te
 
             bool m_enableProgress; //!< Enable/Disable the progress interface (default:false).
 
+            bool m_enableMultiThread; //!< Enable/Disable the use of multi-threads (default:true).
+
             boost::numeric::ublas::matrix<double> m_window; //!< User defined convolution window. (The size must be equal to m_windowH x m_windowW)
 
             InputParameters();
@@ -152,149 +155,124 @@ namespace te
 
         /*!
           \brief Type definition for a filter method pointer.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
-          \return true if ok, false on errors.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area (row-major).
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        typedef bool (Filter::*FilterMethodPointerT)( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress );
+        typedef void (Filter::*FilterMethodPointerT)( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         bool m_isInitialized; //!< Is this instance already initialized?
 
         Filter::InputParameters m_inputParameters; //!< Input parameters.
 
-        double** m_convBuffer; //!< Convolution Buffer.
-
-        unsigned int m_convBufferLines; //!< Convolution Buffer lines.
-
-        unsigned int m_convBufferColumns; //!< Convolution Buffer columns.
+        /*!
+          \brief Applies the given filter over one block window of all bands (BlockProcessor function).
+          \param filterPointer The filter method.
+          \param srcBandsIndexes The source raster bands indexes (one for each destination band).
+          \param window The block window.
+          \param context The executing thread context.
+          \return true if ok, false on errors.
+         */
+        bool filterBlock( FilterMethodPointerT filterPointer,
+          const std::vector< unsigned int >& srcBandsIndexes,
+          const BlockWindow& window, BlockContext& context ) const;
 
         /*!
-          \brief Applay the Roberts filter over the source raster band.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
+          \brief Applay the Roberts filter over a block window.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area.
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        bool RobertsFilter( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress  );
+        void RobertsFilter( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         /*!
-          \brief Applay the Sobel filter over the source raster band.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
+          \brief Applay the Sobel filter over a block window.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area.
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        bool SobelFilter( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress  );
+        void SobelFilter( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         /*!
-          \brief Applay the mean filter over the source raster band.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
+          \brief Applay the mean filter over a block window.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area.
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        bool MeanFilter( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress  );
+        void MeanFilter( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         /*!
-          \brief Applay the mode filter over the source raster band.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
+          \brief Applay the mode filter over a block window.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area.
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        bool ModeFilter( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress  );
+        void ModeFilter( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         /*!
-          \brief Applay the median filter over the source raster band.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
+          \brief Applay the median filter over a block window.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area.
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        bool MedianFilter( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress  );
+        void MedianFilter( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         /*!
-          \brief Applay the dilation filter over the source raster band.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
+          \brief Applay the dilation filter over a block window.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area.
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        bool DilationFilter( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress  );
+        void DilationFilter( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         /*!
-          \brief Applay the erosion filter over the source raster band.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
+          \brief Applay the erosion filter over a block window.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area.
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        bool ErosionFilter( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress  );
+        void ErosionFilter( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         /*!
-          \brief Applay the user defined filter over the source raster band.
-          \param srcRaster Source raster.
-          \param srcBandIdx Source raster band index.
-          \param dstRaster Destination raster.
-          \param dstBandIdx Destination raster band index.
-          \param useProgress if true, the progress interface must be used.
+          \brief Applay the user defined filter over a block window.
+          \param window The block window to filter.
+          \param srcBuffer The source band values inside the window halo area.
+          \param srcNoDataValue Source band no-data value.
+          \param dstBand Destination raster band.
          */
-        bool UserDefinedFilter( const te::rst::Raster& srcRaster,
-          const unsigned int srcBandIdx, te::rst::Raster& dstRaster,
-          const unsigned int dstBandIdx, const bool useProgress  );
+        void UserDefinedFilter( const BlockWindow& window,
+          const std::vector< double >& srcBuffer, const double srcNoDataValue,
+          te::rst::Band& dstBand ) const;
 
         /*!
           \brief Returns true if i < j.
           \return Returns true if i < j.
          */
         static bool OrderFunction(double i, double j);
-
-        /*!
-        \brief Resets the convolution buffer.
-        \param lines Convolution buffer lines.
-        \param columns Convolution buffer columns.
-        */
-        void ResetConvBuffer(unsigned int lines, unsigned int columns);
-
-        /*!
-        \brief Updates the convolution buffer with a new raster line.
-        \param inBand Source raster band.
-        \param line Raster line.
-        \param band Raster band.
-        */
-        void UpdateConvBuffer(const te::rst::Band& inBand, unsigned int line);
-
-        /*!
-        \brief Rools up the convolution buffer count lines.
-        \param count Count times to rool convolution buffer.
-        */
-        void ConvBufferRoolup(unsigned int count);
     };
 
   } // end namespace rp
@@ -1,890 +1,1574 @@
-/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
-
-    This file is part of the TerraLib - a Framework for building GIS enabled applications.
-
-    TerraLib is free software: you can redistribute it and/or modify
-    it under the terms of the GNU Lesser General Public License as published by
-    the Free Software Foundation, either version 3 of the License,
-    or (at your option) any later version.
-
-    TerraLib is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
-    GNU Lesser General Public License for more details.
-
-    You should have received a copy of the GNU Lesser General Public License
-    along with TerraLib. See COPYING. If not, write to
-    TerraLib Team at <terralib-team@terralib.org>.
- */
-
-/*!
-  \file terralib/rp/GeoMosaic.cpp
-  \brief Create a mosaic from a set of geo-referenced rasters.
-*/
-
-#include "GeoMosaic.h"
-
-#include "Macros.h"
-#include "Functions.h"
-#include "../raster/Interpolator.h"
-#include "../raster/Enums.h"
-#include "../raster/RasterFactory.h"
-#include "../raster/Grid.h"
-#include "../raster/Band.h"
-#include "../raster/BandProperty.h"
-#include "../raster/PositionIterator.h"
-#include "../raster/Utils.h"
-#include "../memory/CachedRaster.h"
-#include "../geometry/Envelope.h"
-#include "../geometry/GTFactory.h"
-#include "../geometry/Polygon.h"
-#include "../geometry/LinearRing.h"
-#include "../geometry/MultiPolygon.h"
-#include "../srs/Converter.h"
-#include "../common/progress/TaskProgress.h"
-#include "../common/MathUtils.h"
-
-#include <boost/shared_array.hpp>
-#include <boost/filesystem.hpp>
-#include <boost/lexical_cast.hpp>
-
-#include <climits>
-#include <cfloat>
-#include <cmath>
-#include <memory>
-#include <cstdio>
-
-namespace te
-{
-  namespace rp
-  {
-
-    GeoMosaic::InputParameters::InputParameters()
-    {
-      reset();
-    }
-
-    GeoMosaic::InputParameters::InputParameters( const InputParameters& other )
-    {
-      reset();
-      operator=( other );
-    }
-
-    GeoMosaic::InputParameters::~InputParameters()
-    {
-      reset();
-    }
-
-    void GeoMosaic::InputParameters::reset() throw( te::rp::Exception )
-    {
-      m_feederRasterPtr = 0;
-      m_inputRastersBands.clear();
-      m_interpMethod = te::rst::NearestNeighbor;
-      m_noDataValue = 0.0;
-      m_forceInputNoDataValue = false;
-      m_blendMethod = te::rp::Blender::NoBlendMethod;
-      m_autoEqualize = true;
-      m_useRasterCache = true;
-      m_enableProgress = false;
-      m_enableMultiThread = true;
-    }
-
-    const GeoMosaic::InputParameters& GeoMosaic::InputParameters::operator=(
-      const GeoMosaic::InputParameters& params )
-    {
-      reset();
-
-      m_feederRasterPtr = params.m_feederRasterPtr;
-      m_inputRastersBands = params.m_inputRastersBands;
-      m_interpMethod = params.m_interpMethod;
-      m_noDataValue = params.m_noDataValue;
-      m_forceInputNoDataValue = params.m_forceInputNoDataValue;
-      m_blendMethod = params.m_blendMethod;
-      m_autoEqualize = params.m_autoEqualize;
-      m_useRasterCache = params.m_useRasterCache;
-      m_enableProgress = params.m_enableProgress;
-      m_enableMultiThread = params.m_enableMultiThread;
-
-      return *this;
-    }
-
-    te::common::AbstractParameters* GeoMosaic::InputParameters::clone() const
-    {
-      return new InputParameters( *this );
-    }
-
-    GeoMosaic::OutputParameters::OutputParameters()
-    {
-      reset();
-    }
-
-    GeoMosaic::OutputParameters::OutputParameters( const OutputParameters& other )
-    {
-      reset();
-      operator=( other );
-    }
-
-    GeoMosaic::OutputParameters::~OutputParameters()
-    {
-      reset();
-    }
-
-    void GeoMosaic::OutputParameters::reset() throw( te::rp::Exception )
-    {
-      m_rType.clear();
-      m_rInfo.clear();
-      m_outputRasterPtr.reset();
-    }
-
-    const GeoMosaic::OutputParameters& GeoMosaic::OutputParameters::operator=(
-      const GeoMosaic::OutputParameters& params )
-    {
-      reset();
-
-      m_rType = params.m_rType;
-      m_rInfo = params.m_rInfo;
-      m_outputRasterPtr.reset();;
-
-      return *this;
-    }
-
-    te::common::AbstractParameters* GeoMosaic::OutputParameters::clone() const
-    {
-      return new OutputParameters( *this );
-    }
-
-    GeoMosaic::GeoMosaic()
-    {
-      reset();
-    }
-
-    GeoMosaic::~GeoMosaic()
-    {
-    }
-
-    bool GeoMosaic::execute( AlgorithmOutputParameters& outputParams )
-      throw( te::rp::Exception )
-    {
-      if( ! m_isInitialized ) return false;
-      
-      GeoMosaic::OutputParameters* outParamsPtr = dynamic_cast<
-        GeoMosaic::OutputParameters* >( &outputParams );
-      TERP_TRUE_OR_THROW( outParamsPtr, "Invalid paramters" );
-      
-      assert( m_inputParameters.m_feederRasterPtr->getObjsCount() > 1 );
-      
-      // progress
-      
-      std::auto_ptr< te::common::TaskProgress > progressPtr;
-      if( m_inputParameters.m_enableProgress )
-      {
-        progressPtr.reset( new te::common::TaskProgress );
-        
-        progressPtr->setTotalSteps( 2 + m_inputParameters.m_feederRasterPtr->getObjsCount() );
-        
-        progressPtr->setMessage( "Mosaic" );
-      }       
-      
-      // First pass: getting global mosaic info
-
-      double mosaicXResolution = 0.0;
-      double mosaicYResolution = 0.0;
-      double mosaicLLX = DBL_MAX; // world coords
-      double mosaicLLY = DBL_MAX; // world coords
-      double mosaicURX = -1.0 * DBL_MAX; // world coords
-      double mosaicURY = -1.0 * DBL_MAX; // world coords
-      int mosaicSRID = 0;     
-      te::rst::BandProperty mosaicBaseBandProperties( 0, 0, "" );
-      std::vector< te::gm::Polygon > rastersBBoxes; // all rasters bounding boxes (under the first raster world coords.
-
-      {
-        te::gm::Polygon auxPolygon( 0, te::gm::PolygonType, 0 );
-        te::gm::LinearRing* auxLinearRingPtr = 0;        
-        te::rst::Raster const* inputRasterPtr = 0;
-        unsigned int inputRasterIdx = 0;
-        te::srs::Converter convInstance;
-        te::gm::LinearRing reprojectedExtent(te::gm::LineStringType, 0, 0);
-
-        m_inputParameters.m_feederRasterPtr->reset();
-        while( ( inputRasterPtr = m_inputParameters.m_feederRasterPtr->getCurrentObj() ) )
-        {
-          inputRasterIdx = m_inputParameters.m_feederRasterPtr->getCurrentOffset();
-          TERP_TRUE_OR_RETURN_FALSE(
-            inputRasterPtr->getAccessPolicy() & te::common::RAccess,
-            "Invalid raster" );
-          
-          // checking the input bands
-
-          for( std::vector< unsigned int >::size_type inputRastersBandsIdx = 0 ;
-            inputRastersBandsIdx <
-            m_inputParameters.m_inputRastersBands[ inputRasterIdx ].size() ;
-            ++inputRastersBandsIdx )
-          {
-            const unsigned int& currBand =
-              m_inputParameters.m_inputRastersBands[ inputRasterIdx ][ inputRastersBandsIdx ];
-
-            TERP_TRUE_OR_RETURN_FALSE( currBand < inputRasterPtr->getNumberOfBands(),
-              "Invalid band" )
-          }          
-            
-          // Defining the base mosaic info
-
-          if( inputRasterIdx == 0 )
-          {
-            mosaicXResolution = inputRasterPtr->getGrid()->getResolutionX();
-            mosaicYResolution = inputRasterPtr->getGrid()->getResolutionY();
-            mosaicSRID = inputRasterPtr->getGrid()->getSRID();
-            mosaicBaseBandProperties = *inputRasterPtr->getBand( 
-              m_inputParameters.m_inputRastersBands[ inputRasterIdx ][ 0 ] )->getProperty();
-          }
-
-          TERP_TRUE_OR_RETURN_FALSE( te::rp::GetDetailedExtent( 
-            *inputRasterPtr->getGrid(), reprojectedExtent ),
-            "Detailed raster extent calcule error" );
-          
-          if( mosaicSRID != inputRasterPtr->getGrid()->getSRID() )
-          {
-            reprojectedExtent.transform( mosaicSRID );
-          }
-
-          // expanding mosaic area
-
-          mosaicLLX = std::min( mosaicLLX, reprojectedExtent.getMBR()->getLowerLeftX() );
-          mosaicLLY = std::min( mosaicLLY, reprojectedExtent.getMBR()->getLowerLeftY() );
-
-          mosaicURX = std::max( mosaicURX, reprojectedExtent.getMBR()->getUpperRightX() );
-          mosaicURY = std::max( mosaicURY, reprojectedExtent.getMBR()->getUpperRightY() );
-
-          // finding the current raster bounding box polygon (first raster world coordinates)
-
-          auxPolygon.clear();
-          auxLinearRingPtr = new te::gm::LinearRing( reprojectedExtent );
-          auxPolygon.push_back( auxLinearRingPtr );
-          auxPolygon.setSRID( mosaicSRID );
-          rastersBBoxes.push_back( auxPolygon );
-
-          // move to the next raster
-
-          m_inputParameters.m_feederRasterPtr->moveNext();
-        }
-      }
-      
-      if( m_inputParameters.m_enableProgress )
-      {
-        progressPtr->pulse();
-        if( ! progressPtr->isActive() ) return false;
-      }        
-
-      // creating the output raster
-      
-      te::rst::Raster* outputRasterPtr = 0;
-      std::vector< double > mosaicBandsRangeMin;
-      std::vector< double > mosaicBandsRangeMax;        
-
-      {
-        mosaicBandsRangeMin.resize( 
-          m_inputParameters.m_inputRastersBands[ 0 ].size(), 0 );
-        mosaicBandsRangeMax.resize( 
-          m_inputParameters.m_inputRastersBands[ 0 ].size(), 0 );           
-        
-        std::vector< te::rst::BandProperty* > bandsProperties;
-        for( std::vector< unsigned int >::size_type bandIdx = 0 ;  bandIdx <
-          m_inputParameters.m_inputRastersBands[ 0 ].size() ; ++bandIdx )
-        {
-          bandsProperties.push_back( new te::rst::BandProperty( mosaicBaseBandProperties ) );
-          bandsProperties[ bandIdx ]->m_colorInterp = te::rst::GrayIdxCInt;
-          bandsProperties[ bandIdx ]->m_noDataValue = m_inputParameters.m_noDataValue;
-          
-          te::rst::GetDataTypeRanges( bandsProperties[ bandIdx ]->m_type,
-            mosaicBandsRangeMin[ bandIdx ],
-            mosaicBandsRangeMax[ bandIdx ]);           
-        }
-
-        te::rst::Grid* outputGrid = new te::rst::Grid( mosaicXResolution,
-          mosaicYResolution,  new te::gm::Envelope( mosaicLLX, mosaicLLY, mosaicURX,
-          mosaicURY ), mosaicSRID );
-
-        outParamsPtr->m_outputRasterPtr.reset(
-          te::rst::RasterFactory::make(
-            outParamsPtr->m_rType,
-            outputGrid,
-            bandsProperties,
-            outParamsPtr->m_rInfo,
-            0,
-            0 ) );
-        TERP_TRUE_OR_RETURN_FALSE( outParamsPtr->m_outputRasterPtr.get(),
-          "Output raster creation error" );
-          
-        outputRasterPtr = outParamsPtr->m_outputRasterPtr.get();
-      }
-
-      std::auto_ptr< te::mem::CachedRaster > cachedRasterInstancePtr;
-      
-      if( m_inputParameters.m_useRasterCache )
-      {
-        cachedRasterInstancePtr.reset( new te::mem::CachedRaster(
-          *(outParamsPtr->m_outputRasterPtr.get()), 20, 0 ) );   
-          
-        outputRasterPtr = cachedRasterInstancePtr.get();
-      }
-
-      // fill output with no data values
-
-      {
-        const unsigned int nBands = outputRasterPtr->getNumberOfBands();
-        const unsigned int nRows = outputRasterPtr->getNumberOfRows();
-        const unsigned int nCols = outputRasterPtr->getNumberOfColumns();
-        unsigned int col = 0;
-        unsigned int row = 0;
-        unsigned int bandIdx = 0;
-
-        for( bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
-        {
-          te::rst::Band& outBand = ( *( outputRasterPtr->getBand( bandIdx ) ) );
-
-          for( row = 0 ; row < nRows ; ++row )
-          {
-            for( col = 0 ; col < nCols ; ++col )
-            {
-              outBand.setValue( col, row, m_inputParameters.m_noDataValue );
-            }
-          }
-        }
-      }
-      
-      if( m_inputParameters.m_enableProgress )
-      {
-        progressPtr->pulse();
-        if( ! progressPtr->isActive() ) return false;
-      }        
-      
-      // Copying the first image data to the output mosaic
-      // and find the base mosaic mean and offset values
-
-      std::vector< double > mosaicTargetMeans( outputRasterPtr->getNumberOfBands(), 0 );
-      std::vector< double > mosaicTargetVariances( outputRasterPtr->getNumberOfBands(), 0 );
-
-      {
-        m_inputParameters.m_feederRasterPtr->reset();
-
-        te::rst::Raster const* inputRasterPtr =
-          m_inputParameters.m_feederRasterPtr->getCurrentObj();
-        TERP_DEBUG_TRUE_OR_RETURN_FALSE( inputRasterPtr, "Invalid raster pointer" );
-
-        double inXStartGeo = 0;
-        double inYStartGeo = 0;
-        inputRasterPtr->getGrid()->gridToGeo( 0.0, 0.0, inXStartGeo, inYStartGeo );
-        
-        double outFirstRowDouble = 0;
-        double outFirstColDouble = 0;
-        outputRasterPtr->getGrid()->geoToGrid( inXStartGeo, inYStartGeo,
-          outFirstColDouble, outFirstRowDouble );
-        
-        const double outRowsBoundDouble = outFirstRowDouble +
-          (double)( inputRasterPtr->getNumberOfRows() );
-        const double outColsBoundDouble = outFirstColDouble +
-          (double)( inputRasterPtr->getNumberOfColumns() );
-          
-        const unsigned int outFirstRow = (unsigned int)std::max( 0u, 
-          te::common::Round< double, unsigned int >( outFirstRowDouble ) );
-        const unsigned int outFirstCol = (unsigned int)std::max( 0u, 
-          te::common::Round< double, unsigned int >( outFirstColDouble ) );
-        
-        const unsigned int outRowsBound = (unsigned int)std::min( 
-          te::common::Round< double, unsigned int >( outRowsBoundDouble ),
-          outputRasterPtr->getNumberOfRows() );
-        const unsigned int outColsBound = (unsigned int)std::min( 
-          te::common::Round< double, unsigned int >( outColsBoundDouble ),
-          outputRasterPtr->getNumberOfColumns() );
-
-        const unsigned int nBands = (unsigned int)
-          m_inputParameters.m_inputRastersBands[ 0 ].size();
-        unsigned int outCol = 0;
-        unsigned int outRow = 0;
-        double inCol = 0;
-        double inRow = 0;
-        double bandNoDataValue = -1.0 * DBL_MAX;
-        std::complex< double > pixelCValue = 0;
-        te::rst::Interpolator interpInstance( inputRasterPtr,
-          m_inputParameters.m_interpMethod );
-        unsigned int inputBandIdx = 0;
-
-        for( unsigned int inputRastersBandsIdx = 0 ; inputRastersBandsIdx <
-          nBands ; ++inputRastersBandsIdx )
-        {
-          inputBandIdx =  m_inputParameters.m_inputRastersBands[ 0 ][
-            inputRastersBandsIdx ] ;
-          bandNoDataValue = m_inputParameters.m_forceInputNoDataValue ?
-            m_inputParameters.m_noDataValue : inputRasterPtr->getBand( inputBandIdx
-            )->getProperty()->m_noDataValue;
-          te::rst::Band& outBand =
-            (*outputRasterPtr->getBand( inputRastersBandsIdx ));
-          unsigned long int validPixelsNumber = 0;
-
-          double mean = 0;
-
-          for( outRow = outFirstRow ; outRow < outRowsBound ; ++outRow )
-          {
-            inRow = ((double)outRow) - outFirstRowDouble;
-
-            for( outCol = outFirstCol ; outCol < outColsBound ; ++outCol )
-            {
-              inCol = ((double)outCol) - outFirstColDouble;
-
-              interpInstance.getValue( inCol, inRow, pixelCValue, inputBandIdx );
-
-              if( pixelCValue.real() != bandNoDataValue )
-              {
-                outBand.setValue( outCol, outRow, pixelCValue );
-                mean += pixelCValue.real();
-                ++validPixelsNumber;
-              }
-            }
-          }
-
-          // variance calcule
-
-          if( m_inputParameters.m_autoEqualize && ( validPixelsNumber > 0 ) )
-          {
-            mean /= ( (double)validPixelsNumber );            
-            mosaicTargetMeans[ inputRastersBandsIdx ] = mean;
-            
-            double& variance = mosaicTargetVariances[ inputRastersBandsIdx ];
-            variance = 0;
-
-            double pixelValue = 0;
-
-            for( outRow = outFirstRow ; outRow < outRowsBound ; ++outRow )
-            {
-              for( outCol = outFirstCol ; outCol < outColsBound ; ++outCol )
-              {
-                outBand.getValue( outCol, outRow, pixelValue );
-
-                if( pixelValue != m_inputParameters.m_noDataValue )
-                {
-                  variance += ( ( pixelValue - mean ) * ( pixelValue -
-                    mean ) ) / ( (double)validPixelsNumber );
-                }
-              }
-            }
-          }
-        }
-      }
-      
-      TERP_DEBUG_TRUE_OR_THROW( rastersBBoxes.size() ==
-        m_inputParameters.m_feederRasterPtr->getObjsCount(),
-        "Rasters bounding boxes number mismatch" );
-        
-      if( m_inputParameters.m_enableProgress )
-      {
-        progressPtr->pulse();
-        if( ! progressPtr->isActive() ) return false;
-      }          
-
-      // Initiating the mosaic bounding boxes union
-
-      std::auto_ptr< te::gm::MultiPolygon > mosaicBBoxesUnionPtr(
-        new te::gm::MultiPolygon( 0, te::gm::MultiPolygonType,
-        outputRasterPtr->getSRID(), 0 ) );
-      mosaicBBoxesUnionPtr->add( (te::gm::Polygon*)rastersBBoxes[ 0 ].clone() );
-
-      // skipping the first raster
-
-      m_inputParameters.m_feederRasterPtr->reset();
-      m_inputParameters.m_feederRasterPtr->moveNext();
-
-      // iterating over the other rasters
-      
-      te::rst::Raster const* originalInputRasterPtr = 0;
-
-      std::vector< unsigned int > outputRasterBands;
-      std::vector< double > dummyRasterOffsets;
-      std::vector< double > dummyRasterScales;
-      for( unsigned int outputRasterBandsIdx = 0 ; outputRasterBandsIdx <
-        outputRasterPtr->getNumberOfBands() ; ++outputRasterBandsIdx )
-      {
-        outputRasterBands.push_back( outputRasterBandsIdx );
-        dummyRasterOffsets.push_back( 0.0 );
-        dummyRasterScales.push_back( 1.0 );
-      }      
-
-      while( ( originalInputRasterPtr = m_inputParameters.m_feederRasterPtr->getCurrentObj() ) )
-      {
-        const unsigned int inputRasterIdx = m_inputParameters.m_feederRasterPtr->getCurrentOffset();
-        
-//         Copy2DiskRaster( outputRaster, boost::lexical_cast< std::string >( inputRasterIdx ) +
-//           "_output_raster_begininng.tif" );
-
-        TERP_DEBUG_TRUE_OR_THROW( rastersBBoxes[ inputRasterIdx ].getSRID() == outputRasterPtr->getSRID(),
-          "Invalid boxes SRID" );
-          
-        te::rst::Raster const* inputRasterPtr = originalInputRasterPtr;
-        
-//         Copy2DiskRaster( *inputRasterPtr, boost::lexical_cast< std::string >( inputRasterIdx ) +
-//           "_input_raster.tif" );
-
-        // reprojection / caching issues
-        
-        std::auto_ptr< te::rst::Raster > reprojectedInputRasterPtr;
-        
-        std::string reprojectedRasterFileName;
-
-        if( outputRasterPtr->getSRID() != inputRasterPtr->getSRID() )
-        {
-          boost::filesystem::path tempDirPath(
-              te::core::FileSystem::tempDirectoryPath());
-          reprojectedRasterFileName = te::core::FileSystem::uniquePath(
-              (tempDirPath /= boost::filesystem::path(
-                   "TerralibRGeoMosaic_%%%%-%%%%-%%%%-%%%%")).string());
-          TERP_TRUE_OR_RETURN_FALSE( !reprojectedRasterFileName.empty(),
-            "Invalid temporary raster file name" );
-          reprojectedRasterFileName += ".tif";
-          
-          std::map< std::string, std::string > rInfo;
-          rInfo[ "URI" ] = reprojectedRasterFileName;
-          
-          reprojectedInputRasterPtr.reset( inputRasterPtr->transform( 
-            outputRasterPtr->getSRID(), rInfo,
-            m_inputParameters.m_interpMethod) );
-          inputRasterPtr = reprojectedInputRasterPtr.get();
-          TERP_TRUE_OR_RETURN_FALSE( inputRasterPtr, "Reprojection error" );
-          
-//           Copy2DiskRaster( *inputRasterPtr, boost::lexical_cast< std::string >( inputRasterIdx ) +
-//             "reprojected_input_raster.tif" );
-        }
-        
-        // Caching issues 
-        
-        std::auto_ptr< te::mem::CachedRaster > cachedInputRasterPtr;
-        
-        if( m_inputParameters.m_useRasterCache )
-        {
-          cachedInputRasterPtr.reset( new te::mem::CachedRaster(
-            *inputRasterPtr, 20, 0 ) );
-          inputRasterPtr = cachedInputRasterPtr.get();
-        }         
-        
-        // The transformation mapping outputRaster pixels 
-        // ( te::gm::GTParameters::TiePoint::first ) to input pixels 
-        // ( te::gm::GTParameters::TiePoint::second ) 
-        // (Note: all coords are indexed by lines/columns).
-        
-        std::auto_ptr< te::gm::GeometricTransformation > transPtr;
-        
-        {
-          te::gm::GTParameters transParams;
-          double auxX;
-          double auxY;
-          te::gm::GTParameters::TiePoint auxTP;
-          
-          auxTP.first.x = 0;
-          auxTP.first.y = 0;
-          outputRasterPtr->getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
-          inputRasterPtr->getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );
-          transParams.m_tiePoints.push_back( auxTP );
-          
-          auxTP.first.x = 0;
-          auxTP.first.y = (double)( outputRasterPtr->getNumberOfRows() - 1 );
-          outputRasterPtr->getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
-          inputRasterPtr->getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );          
-          transParams.m_tiePoints.push_back( auxTP );
-//           
-//           auxTP.first.x = (double)( outputRasterPtr->getNumberOfColumns() - 1);
-//           auxTP.first.y = 0;
-//           outputRasterPtr->getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
-//           inputRasterPtr->getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );
-//           transParams.m_tiePoints.push_back( auxTP );
-          
-          auxTP.first.x = (double)( outputRasterPtr->getNumberOfColumns() - 1 );
-          auxTP.first.y = (double)( outputRasterPtr->getNumberOfRows() - 1 );
-          outputRasterPtr->getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
-          inputRasterPtr->getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );                    
-          transParams.m_tiePoints.push_back( auxTP );
-          
-          transPtr.reset( te::gm::GTFactory::make( "RST" ) );
-          TERP_TRUE_OR_RETURN_FALSE( transPtr.get(), "Could not instantiate a geometric transformation" );
-          
-          TERP_TRUE_OR_RETURN_FALSE( transPtr->initialize( transParams ),
-            "Could not initialize a geometric transformation" );
-        }
-
-        // Generating the offset and gain info for eath band from the current raster
-
-        std::vector< double > currentRasterBandsOffsets = dummyRasterOffsets;
-        std::vector< double > currentRasterBandsScales = dummyRasterScales;
-
-        if( m_inputParameters.m_autoEqualize )
-        {
-          double currentRasterVariance = 0;
-          double currentRasterMean = 0;
-
-          for( unsigned int inputRastersBandsIdx = 0 ; inputRastersBandsIdx <
-            m_inputParameters.m_inputRastersBands[ inputRasterIdx ].size() ;
-            ++inputRastersBandsIdx )
-          {
-            const unsigned int inputBandIdx = m_inputParameters.m_inputRastersBands[ inputRasterIdx ][
-              inputRastersBandsIdx ];
-
-            if( 
-                ( mosaicTargetMeans[ inputRastersBandsIdx ] != 0.0 )
-                &&
-                ( mosaicTargetVariances[ inputRastersBandsIdx ] != 0.0 )
-              )
-            {
-              calcBandStatistics( (*inputRasterPtr->getBand( inputBandIdx ) ),
-                m_inputParameters.m_forceInputNoDataValue,
-                m_inputParameters.m_noDataValue,
-                currentRasterMean,
-                currentRasterVariance );
-
-              currentRasterBandsScales[ inputRastersBandsIdx ] = 
-                ( 
-                  std::sqrt( mosaicTargetVariances[ inputRastersBandsIdx ] )
-                   /
-                  std::sqrt( currentRasterVariance ) 
-                );
-              currentRasterBandsOffsets[ inputRastersBandsIdx ] =
-                ( 
-                  mosaicTargetMeans[ inputRastersBandsIdx ]
-                   - 
-                  ( 
-                    currentRasterBandsScales[ inputRastersBandsIdx ] 
-                    * 
-                    currentRasterMean 
-                  ) 
-                );
-            }
-          }
-        }
-
-         // blending
-
-        te::rp::Blender blenderInstance;
-
-        TERP_TRUE_OR_RETURN_FALSE( blenderInstance.initialize(
-          *outputRasterPtr,
-          outputRasterBands,
-          *inputRasterPtr,
-          m_inputParameters.m_inputRastersBands[ inputRasterIdx ],
-          m_inputParameters.m_blendMethod,
-          te::rst::NearestNeighbor,
-          m_inputParameters.m_interpMethod,
-          m_inputParameters.m_noDataValue,
-          false,
-          m_inputParameters.m_forceInputNoDataValue,
-          dummyRasterOffsets,
-          dummyRasterScales,
-          currentRasterBandsOffsets,
-          currentRasterBandsScales,
-          mosaicBBoxesUnionPtr.get(),
-          0,
-          *transPtr,
-          m_inputParameters.m_enableMultiThread ? 0 : 1,
-          false ), "Blender initiazing error" );
-        
-        TERP_TRUE_OR_RETURN_FALSE( blenderInstance.blendIntoRaster1(), 
-          "Error blending images" );
-
-//           Copy2DiskRaster( outputRaster, boost::lexical_cast< std::string >( inputRasterIdx ) +
-//              "output_raster_after_blending_" + 
-//             boost::lexical_cast< std::string >( mosaicBBoxesUnionIdx ) + ".tif" );
-
-        // updating the  gloabal mosaic boxes
-
-        std::auto_ptr< te::gm::Geometry > boxesUnionResultPtr; // under the mosaic SRID
-        TERP_TRUE_OR_RETURN_FALSE( mosaicBBoxesUnionPtr->isValid(), 
-          "Invalid mosaic bounding boxes union geometry" );
-        TERP_TRUE_OR_RETURN_FALSE( rastersBBoxes[ inputRasterIdx ].isValid(), 
-          "Invalid raster bounding boxes union geometry (raster index:"
-          + boost::lexical_cast< std::string >( inputRasterIdx ) + ")" );  
-        
-        try
-        {
-          boxesUnionResultPtr.reset( mosaicBBoxesUnionPtr->Union(
-            &( rastersBBoxes[ inputRasterIdx ] ) ) );
-        }
-        catch( const std::exception& e )
-        {
-          TERP_LOG_AND_RETURN_FALSE( "Mosaic bounding boxes union error" ); 
-        }
-        
-        TERP_TRUE_OR_THROW( boxesUnionResultPtr.get(), "Invalid pointer" );
-        
-        boxesUnionResultPtr->setSRID( outputRasterPtr->getSRID() );
-
-        if( 
-            ( boxesUnionResultPtr->getGeomTypeId() == te::gm::MultiPolygonType )
-            ||
-            ( boxesUnionResultPtr->getGeomTypeId() == te::gm::MultiPolygonZType )
-            ||
-            ( boxesUnionResultPtr->getGeomTypeId() == te::gm::MultiPolygonMType )
-            ||
-            ( boxesUnionResultPtr->getGeomTypeId() == te::gm::MultiPolygonZMType )
-          )
-        {
-          mosaicBBoxesUnionPtr.reset( (te::gm::MultiPolygon*)boxesUnionResultPtr.release() );
-        }
-        else if( 
-                 ( boxesUnionResultPtr->getGeomTypeId() == te::gm::PolygonType )
-                 ||
-                 ( boxesUnionResultPtr->getGeomTypeId() == te::gm::PolygonZType )
-                 ||
-                 ( boxesUnionResultPtr->getGeomTypeId() == te::gm::PolygonMType )
-                 ||
-                 ( boxesUnionResultPtr->getGeomTypeId() == te::gm::PolygonZMType )
-               )
-        {
-          // transforming it into a te::gm::MultiPolygon
-          te::gm::MultiPolygon* auxMultiPol = new te::gm::MultiPolygon( 0,
-            te::gm::MultiPolygonType, boxesUnionResultPtr->getSRID(), 0 );
-          auxMultiPol->add( boxesUnionResultPtr.release() );
-
-          mosaicBBoxesUnionPtr.reset( auxMultiPol );
-        }
-        else
-        {
-          TERP_LOGWARN( "Invalid union geometry type" );
-        }
-        
-        // Reseting the input cache
-        
-        cachedInputRasterPtr.reset();
-        
-        // deleting the reprojected raster
-        
-        if( reprojectedInputRasterPtr.get() )
-        {
-          reprojectedInputRasterPtr.reset();
-          remove( reprojectedRasterFileName.c_str() );
-        }
-
-        // moving to the next raster
-
-        m_inputParameters.m_feederRasterPtr->moveNext();
-        
-        if( m_inputParameters.m_enableProgress )
-        {
-          progressPtr->pulse();
-          if( ! progressPtr->isActive() ) return false;
-        }          
-      }
-      
-      // reseting the output cache
-      
-      if( cachedRasterInstancePtr.get() ) cachedRasterInstancePtr.reset();
-      
-      return true;
-    }
-
-    void GeoMosaic::reset() throw( te::rp::Exception )
-    {
-      m_inputParameters.reset();
-      m_isInitialized = false;
-    }
-
-    bool GeoMosaic::initialize( const AlgorithmInputParameters& inputParams )
-      throw( te::rp::Exception )
-    {
-      reset();
-
-      GeoMosaic::InputParameters const* inputParamsPtr = dynamic_cast<
-        GeoMosaic::InputParameters const* >( &inputParams );
-      TERP_TRUE_OR_THROW( inputParamsPtr, "Invalid paramters pointer" );
-
-      m_inputParameters = *inputParamsPtr;
-
-      // Checking the feeder
-
-      TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_feederRasterPtr,
-        "Invalid m_feederRasterPtr" )
-
-      TERP_TRUE_OR_RETURN_FALSE(
-        m_inputParameters.m_feederRasterPtr->getObjsCount() > 0,
-        "Invalid number of rasters" )
-
-      // checking m_inputRastersBands
-
-      TERP_TRUE_OR_RETURN_FALSE(
-        ((unsigned int)m_inputParameters.m_inputRastersBands.size()) ==
-        m_inputParameters.m_feederRasterPtr->getObjsCount(),
-        "Bands mismatch" );
-
-      for( std::vector< std::vector< unsigned int > >::size_type
-        inputRastersBandsIdx = 0 ;  inputRastersBandsIdx <
-        m_inputParameters.m_inputRastersBands.size() ; ++inputRastersBandsIdx )
-      {
-        TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_inputRastersBands[
-          inputRastersBandsIdx ].size() > 0, "Invalid bands number" );
-
-        TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_inputRastersBands[
-          inputRastersBandsIdx ].size() ==  m_inputParameters.m_inputRastersBands[
-          0 ].size(), "Bands number mismatch" );
-      }
-
-      m_isInitialized = true;
-
-      return true;
-    }
-
-    bool GeoMosaic::isInitialized() const
-    {
-      return m_isInitialized;
-    }
-
-    void GeoMosaic::calcBandStatistics( const te::rst::Band& band,
-      const bool& forceNoDataValue,
-      const double& noDataValue,
-      double& mean, double& variance )
-    {
-      mean = 0;
-      variance = 0;
-
-      double internalNoDataValue = 0;
-      if( forceNoDataValue )
-        internalNoDataValue = noDataValue;
-      else
-        internalNoDataValue = band.getProperty()->m_noDataValue;
-
-      const unsigned int nCols = band.getProperty()->m_blkw *
-        band.getProperty()->m_nblocksx;
-      const unsigned int nLines = band.getProperty()->m_blkh *
-        band.getProperty()->m_nblocksy;
-
-      double pixelsNumber = 0;
-      double value = 0;
-      unsigned int col = 0;
-      unsigned int line = 0;
-
-      for( line = 0 ; line < nLines ; ++line )
-        for( col = 0 ; col < nCols ; ++col )
-        {
-          band.getValue( col, line, value );
-
-          if( value != internalNoDataValue )
-          {
-            mean += value;
-            ++pixelsNumber;
-          }
-        }
-
-      if( pixelsNumber != 0.0 )
-      {
-        mean /= pixelsNumber;
-
-        for( line = 0 ; line < nLines ; ++line )
-          for( col = 0 ; col < nCols ; ++col )
-          {
-            band.getValue( col, line, value );
-
-            if( value != internalNoDataValue )
-            {
-              variance += ( ( value - mean ) * ( value - mean ) ) / pixelsNumber;
-            }
-          }
-
-      }
-    }
-
-  } // end namespace rp
-}   // end namespace te
-
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/rp/GeoMosaic.cpp
+  \brief Create a mosaic from a set of geo-referenced rasters.
+*/
+
+#include "GeoMosaic.h"
+
+#include "Macros.h"
+#include "Functions.h"
+#include "../raster/Interpolator.h"
+#include "../raster/Enums.h"
+#include "../raster/RasterFactory.h"
+#include "../raster/Grid.h"
+#include "../raster/Band.h"
+#include "../raster/BandProperty.h"
+#include "../raster/PositionIterator.h"
+#include "../raster/Utils.h"
+#include "../raster/SynchronizedRaster.h"
+#include "../memory/CachedRaster.h"
+#include "../geometry/Envelope.h"
+#include "../geometry/GTFactory.h"
+#include "../geometry/Polygon.h"
+#include "../geometry/LinearRing.h"
+#include "../geometry/MultiPolygon.h"
+#include "../srs/Converter.h"
+#include "../common/progress/TaskProgress.h"
+#include "../common/MathUtils.h"
+#include "../common/PlatformUtils.h"
+
+#include <boost/shared_array.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <climits>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <cstdio>
+#include <algorithm>
+#include <complex>
+#include <utility>
+
+namespace te
+{
+  namespace rp
+  {
+    /*! \brief A shared pointer deleter for the rasters owned by someone else. */
+    static void NoRasterDeleter( te::rst::Raster* )
+    {
+    }
+
+    GeoMosaic::InputParameters::InputParameters()
+    {
+      reset();
+    }
+
+    GeoMosaic::InputParameters::InputParameters( const InputParameters& other )
+    {
+      reset();
+      operator=( other );
+    }
+
+    GeoMosaic::InputParameters::~InputParameters()
+    {
+      reset();
+    }
+
+    void GeoMosaic::InputParameters::reset() throw( te::rp::Exception )
+    {
+      m_feederRasterPtr = 0;
+      m_inputRastersBands.clear();
+      m_interpMethod = te::rst::NearestNeighbor;
+      m_noDataValue = 0.0;
+      m_forceInputNoDataValue = false;
+      m_blendMethod = te::rp::Blender::NoBlendMethod;
+      m_autoEqualize = true;
+      m_useRasterCache = true;
+      m_enableProgress = false;
+      m_enableMultiThread = true;
+      m_executionMode = GeoMosaic::SequentialBlendingMode;
+      m_priorityRule = GeoMosaic::FeederOrderPriorityRule;
+      m_inputRastersPriorities.clear();
+    }
+
+    const GeoMosaic::InputParameters& GeoMosaic::InputParameters::operator=(
+      const GeoMosaic::InputParameters& params )
+    {
+      reset();
+
+      m_feederRasterPtr = params.m_feederRasterPtr;
+      m_inputRastersBands = params.m_inputRastersBands;
+      m_interpMethod = params.m_interpMethod;
+      m_noDataValue = params.m_noDataValue;
+      m_forceInputNoDataValue = params.m_forceInputNoDataValue;
+      m_blendMethod = params.m_blendMethod;
+      m_autoEqualize = params.m_autoEqualize;
+      m_useRasterCache = params.m_useRasterCache;
+      m_enableProgress = params.m_enableProgress;
+      m_enableMultiThread = params.m_enableMultiThread;
+      m_executionMode = params.m_executionMode;
+      m_priorityRule = params.m_priorityRule;
+      m_inputRastersPriorities = params.m_inputRastersPriorities;
+
+      return *this;
+    }
+
+    te::common::AbstractParameters* GeoMosaic::InputParameters::clone() const
+    {
+      return new InputParameters( *this );
+    }
+
+    GeoMosaic::OutputParameters::OutputParameters()
+    {
+      reset();
+    }
+
+    GeoMosaic::OutputParameters::OutputParameters( const OutputParameters& other )
+    {
+      reset();
+      operator=( other );
+    }
+
+    GeoMosaic::OutputParameters::~OutputParameters()
+    {
+      reset();
+    }
+
+    void GeoMosaic::OutputParameters::reset() throw( te::rp::Exception )
+    {
+      m_rType.clear();
+      m_rInfo.clear();
+      m_outputRasterPtr.reset();
+    }
+
+    const GeoMosaic::OutputParameters& GeoMosaic::OutputParameters::operator=(
+      const GeoMosaic::OutputParameters& params )
+    {
+      reset();
+
+      m_rType = params.m_rType;
+      m_rInfo = params.m_rInfo;
+      m_outputRasterPtr.reset();;
+
+      return *this;
+    }
+
+    te::common::AbstractParameters* GeoMosaic::OutputParameters::clone() const
+    {
+      return new OutputParameters( *this );
+    }
+
+    GeoMosaic::GeoMosaic()
+    {
+      reset();
+    }
+
+    GeoMosaic::~GeoMosaic()
+    {
+    }
+
+    bool GeoMosaic::execute( AlgorithmOutputParameters& outputParams )
+      throw( te::rp::Exception )
+    {
+      if( ! m_isInitialized ) return false;
+      
+      GeoMosaic::OutputParameters* outParamsPtr = dynamic_cast<
+        GeoMosaic::OutputParameters* >( &outputParams );
+      TERP_TRUE_OR_THROW( outParamsPtr, "Invalid paramters" );
+      
+      assert( m_inputParameters.m_feederRasterPtr->getObjsCount() > 1 );
+      
+      // progress
+      
+      std::auto_ptr< te::common::TaskProgress > progressPtr;
+      if( m_inputParameters.m_enableProgress )
+      {
+        progressPtr.reset( new te::common::TaskProgress );
+        
+        progressPtr->setTotalSteps( 2 + m_inputParameters.m_feederRasterPtr->getObjsCount() );
+        
+        progressPtr->setMessage( "Mosaic" );
+      }       
+      
+      // First pass: getting global mosaic info
+
+      double mosaicXResolution = 0.0;
+      double mosaicYResolution = 0.0;
+      double mosaicLLX = DBL_MAX; // world coords
+      double mosaicLLY = DBL_MAX; // world coords
+      double mosaicURX = -1.0 * DBL_MAX; // world coords
+      double mosaicURY = -1.0 * DBL_MAX; // world coords
+      int mosaicSRID = 0;     
+      te::rst::BandProperty mosaicBaseBandProperties( 0, 0, "" );
+      std::vector< te::gm::Polygon > rastersBBoxes; // all rasters bounding boxes (under the first raster world coords.
+
+      {
+        te::gm::Polygon auxPolygon( 0, te::gm::PolygonType, 0 );
+        te::gm::LinearRing* auxLinearRingPtr = 0;        
+        te::rst::Raster const* inputRasterPtr = 0;
+        unsigned int inputRasterIdx = 0;
+        te::srs::Converter convInstance;
+        te::gm::LinearRing reprojectedExtent(te::gm::LineStringType, 0, 0);
+
+        m_inputParameters.m_feederRasterPtr->reset();
+        while( ( inputRasterPtr = m_inputParameters.m_feederRasterPtr->getCurrentObj() ) )
+        {
+          inputRasterIdx = m_inputParameters.m_feederRasterPtr->getCurrentOffset();
+          TERP_TRUE_OR_RETURN_FALSE(
+            inputRasterPtr->getAccessPolicy() & te::common::RAccess,
+            "Invalid raster" );
+          
+          // checking the input bands
+
+          for( std::vector< unsigned int >::size_type inputRastersBandsIdx = 0 ;
+            inputRastersBandsIdx <
+            m_inputParameters.m_inputRastersBands[ inputRasterIdx ].size() ;
+            ++inputRastersBandsIdx )
+          {
+            const unsigned int& currBand =
+              m_inputParameters.m_inputRastersBands[ inputRasterIdx ][ inputRastersBandsIdx ];
+
+            TERP_TRUE_OR_RETURN_FALSE( currBand < inputRasterPtr->getNumberOfBands(),
+              "Invalid band" )
+          }          
+            
+          // Defining the base mosaic info
+
+          if( inputRasterIdx == 0 )
+          {
+            mosaicXResolution = inputRasterPtr->getGrid()->getResolutionX();
+            mosaicYResolution = inputRasterPtr->getGrid()->getResolutionY();
+            mosaicSRID = inputRasterPtr->getGrid()->getSRID();
+            mosaicBaseBandProperties = *inputRasterPtr->getBand( 
+              m_inputParameters.m_inputRastersBands[ inputRasterIdx ][ 0 ] )->getProperty();
+          }
+
+          TERP_TRUE_OR_RETURN_FALSE( te::rp::GetDetailedExtent( 
+            *inputRasterPtr->getGrid(), reprojectedExtent ),
+            "Detailed raster extent calcule error" );
+          
+          if( mosaicSRID != inputRasterPtr->getGrid()->getSRID() )
+          {
+            reprojectedExtent.transform( mosaicSRID );
+          }
+
+          // expanding mosaic area
+
+          mosaicLLX = std::min( mosaicLLX, reprojectedExtent.getMBR()->getLowerLeftX() );
+          mosaicLLY = std::min( mosaicLLY, reprojectedExtent.getMBR()->getLowerLeftY() );
+
+          mosaicURX = std::max( mosaicURX, reprojectedExtent.getMBR()->getUpperRightX() );
+          mosaicURY = std::max( mosaicURY, reprojectedExtent.getMBR()->getUpperRightY() );
+
+          // finding the current raster bounding box polygon (first raster world coordinates)
+
+          auxPolygon.clear();
+          auxLinearRingPtr = new te::gm::LinearRing( reprojectedExtent );
+          auxPolygon.push_back( auxLinearRingPtr );
+          auxPolygon.setSRID( mosaicSRID );
+          rastersBBoxes.push_back( auxPolygon );
+
+          // move to the next raster
+
+          m_inputParameters.m_feederRasterPtr->moveNext();
+        }
+      }
+      
+      if( m_inputParameters.m_enableProgress )
+      {
+        progressPtr->pulse();
+        if( ! progressPtr->isActive() ) return false;
+      }        
+
+      // creating the output raster
+      
+      te::rst::Raster* outputRasterPtr = 0;
+      std::vector< double > mosaicBandsRangeMin;
+      std::vector< double > mosaicBandsRangeMax;        
+
+      {
+        mosaicBandsRangeMin.resize( 
+          m_inputParameters.m_inputRastersBands[ 0 ].size(), 0 );
+        mosaicBandsRangeMax.resize( 
+          m_inputParameters.m_inputRastersBands[ 0 ].size(), 0 );           
+        
+        std::vector< te::rst::BandProperty* > bandsProperties;
+        for( std::vector< unsigned int >::size_type bandIdx = 0 ;  bandIdx <
+          m_inputParameters.m_inputRastersBands[ 0 ].size() ; ++bandIdx )
+        {
+          bandsProperties.push_back( new te::rst::BandProperty( mosaicBaseBandProperties ) );
+          bandsProperties[ bandIdx ]->m_colorInterp = te::rst::GrayIdxCInt;
+          bandsProperties[ bandIdx ]->m_noDataValue = m_inputParameters.m_noDataValue;
+          
+          te::rst::GetDataTypeRanges( bandsProperties[ bandIdx ]->m_type,
+            mosaicBandsRangeMin[ bandIdx ],
+            mosaicBandsRangeMax[ bandIdx ]);           
+        }
+
+        te::rst::Grid* outputGrid = new te::rst::Grid( mosaicXResolution,
+          mosaicYResolution,  new te::gm::Envelope( mosaicLLX, mosaicLLY, mosaicURX,
+          mosaicURY ), mosaicSRID );
+
+        outParamsPtr->m_outputRasterPtr.reset(
+          te::rst::RasterFactory::make(
+            outParamsPtr->m_rType,
+            outputGrid,
+            bandsProperties,
+            outParamsPtr->m_rInfo,
+            0,
+            0 ) );
+        TERP_TRUE_OR_RETURN_FALSE( outParamsPtr->m_outputRasterPtr.get(),
+          "Output raster creation error" );
+          
+        outputRasterPtr = outParamsPtr->m_outputRasterPtr.get();
+      }
+      
+      // Tiled composition
+      
+      if( m_inputParameters.m_executionMode == GeoMosaic::TiledCompositionMode )
+      {
+        return executeTiledComposition( *outputRasterPtr, mosaicBandsRangeMin,
+          mosaicBandsRangeMax, progressPtr.get() );
+      }
+
+      std::auto_ptr< te::mem::CachedRaster > cachedRasterInstancePtr;
+      
+      if( m_inputParameters.m_useRasterCache )
+      {
+        cachedRasterInstancePtr.reset( new te::mem::CachedRaster(
+          *(outParamsPtr->m_outputRasterPtr.get()), 20, 0 ) );   
+          
+        outputRasterPtr = cachedRasterInstancePtr.get();
+      }
+
+      // fill output with no data values
+
+      {
+        const unsigned int nBands = outputRasterPtr->getNumberOfBands();
+        const unsigned int nRows = outputRasterPtr->getNumberOfRows();
+        const unsigned int nCols = outputRasterPtr->getNumberOfColumns();
+        unsigned int col = 0;
+        unsigned int row = 0;
+        unsigned int bandIdx = 0;
+
+        for( bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+        {
+          te::rst::Band& outBand = ( *( outputRasterPtr->getBand( bandIdx ) ) );
+
+          for( row = 0 ; row < nRows ; ++row )
+          {
+            for( col = 0 ; col < nCols ; ++col )
+            {
+              outBand.setValue( col, row, m_inputParameters.m_noDataValue );
+            }
+          }
+        }
+      }
+      
+      if( m_inputParameters.m_enableProgress )
+      {
+        progressPtr->pulse();
+        if( ! progressPtr->isActive() ) return false;
+      }        
+      
+      // Copying the first image data to the output mosaic
+      // and find the base mosaic mean and offset values
+
+      std::vector< double > mosaicTargetMeans( outputRasterPtr->getNumberOfBands(), 0 );
+      std::vector< double > mosaicTargetVariances( outputRasterPtr->getNumberOfBands(), 0 );
+
+      {
+        m_inputParameters.m_feederRasterPtr->reset();
+
+        te::rst::Raster const* inputRasterPtr =
+          m_inputParameters.m_feederRasterPtr->getCurrentObj();
+        TERP_DEBUG_TRUE_OR_RETURN_FALSE( inputRasterPtr, "Invalid raster pointer" );
+
+        double inXStartGeo = 0;
+        double inYStartGeo = 0;
+        inputRasterPtr->getGrid()->gridToGeo( 0.0, 0.0, inXStartGeo, inYStartGeo );
+        
+        double outFirstRowDouble = 0;
+        double outFirstColDouble = 0;
+        outputRasterPtr->getGrid()->geoToGrid( inXStartGeo, inYStartGeo,
+          outFirstColDouble, outFirstRowDouble );
+        
+        const double outRowsBoundDouble = outFirstRowDouble +
+          (double)( inputRasterPtr->getNumberOfRows() );
+        const double outColsBoundDouble = outFirstColDouble +
+          (double)( inputRasterPtr->getNumberOfColumns() );
+          
+        const unsigned int outFirstRow = (unsigned int)std::max( 0u, 
+          te::common::Round< double, unsigned int >( outFirstRowDouble ) );
+        const unsigned int outFirstCol = (unsigned int)std::max( 0u, 
+          te::common::Round< double, unsigned int >( outFirstColDouble ) );
+        
+        const unsigned int outRowsBound = (unsigned int)std::min( 
+          te::common::Round< double, unsigned int >( outRowsBoundDouble ),
+          outputRasterPtr->getNumberOfRows() );
+        const unsigned int outColsBound = (unsigned int)std::min( 
+          te::common::Round< double, unsigned int >( outColsBoundDouble ),
+          outputRasterPtr->getNumberOfColumns() );
+
+        const unsigned int nBands = (unsigned int)
+          m_inputParameters.m_inputRastersBands[ 0 ].size();
+        unsigned int outCol = 0;
+        unsigned int outRow = 0;
+        double inCol = 0;
+        double inRow = 0;
+        double bandNoDataValue = -1.0 * DBL_MAX;
+        std::complex< double > pixelCValue = 0;
+        te::rst::Interpolator interpInstance( inputRasterPtr,
+          m_inputParameters.m_interpMethod );
+        unsigned int inputBandIdx = 0;
+
+        for( unsigned int inputRastersBandsIdx = 0 ; inputRastersBandsIdx <
+          nBands ; ++inputRastersBandsIdx )
+        {
+          inputBandIdx =  m_inputParameters.m_inputRastersBands[ 0 ][
+            inputRastersBandsIdx ] ;
+          bandNoDataValue = m_inputParameters.m_forceInputNoDataValue ?
+            m_inputParameters.m_noDataValue : inputRasterPtr->getBand( inputBandIdx
+            )->getProperty()->m_noDataValue;
+          te::rst::Band& outBand =
+            (*outputRasterPtr->getBand( inputRastersBandsIdx ));
+          unsigned long int validPixelsNumber = 0;
+
+          double mean = 0;
+
+          for( outRow = outFirstRow ; outRow < outRowsBound ; ++outRow )
+          {
+            inRow = ((double)outRow) - outFirstRowDouble;
+
+            for( outCol = outFirstCol ; outCol < outColsBound ; ++outCol )
+            {
+              inCol = ((double)outCol) - outFirstColDouble;
+
+              interpInstance.getValue( inCol, inRow, pixelCValue, inputBandIdx );
+
+              if( pixelCValue.real() != bandNoDataValue )
+              {
+                outBand.setValue( outCol, outRow, pixelCValue );
+                mean += pixelCValue.real();
+                ++validPixelsNumber;
+              }
+            }
+          }
+
+          // variance calcule
+
+          if( m_inputParameters.m_autoEqualize && ( validPixelsNumber > 0 ) )
+          {
+            mean /= ( (double)validPixelsNumber );            
+            mosaicTargetMeans[ inputRastersBandsIdx ] = mean;
+            
+            double& variance = mosaicTargetVariances[ inputRastersBandsIdx ];
+            variance = 0;
+
+            double pixelValue = 0;
+
+            for( outRow = outFirstRow ; outRow < outRowsBound ; ++outRow )
+            {
+              for( outCol = outFirstCol ; outCol < outColsBound ; ++outCol )
+              {
+                outBand.getValue( outCol, outRow, pixelValue );
+
+                if( pixelValue != m_inputParameters.m_noDataValue )
+                {
+                  variance += ( ( pixelValue - mean ) * ( pixelValue -
+                    mean ) ) / ( (double)validPixelsNumber );
+                }
+              }
+            }
+          }
+        }
+      }
+      
+      TERP_DEBUG_TRUE_OR_THROW( rastersBBoxes.size() ==
+        m_inputParameters.m_feederRasterPtr->getObjsCount(),
+        "Rasters bounding boxes number mismatch" );
+        
+      if( m_inputParameters.m_enableProgress )
+      {
+        progressPtr->pulse();
+        if( ! progressPtr->isActive() ) return false;
+      }          
+
+      // Initiating the mosaic bounding boxes union
+
+      std::auto_ptr< te::gm::MultiPolygon > mosaicBBoxesUnionPtr(
+        new te::gm::MultiPolygon( 0, te::gm::MultiPolygonType,
+        outputRasterPtr->getSRID(), 0 ) );
+      mosaicBBoxesUnionPtr->add( (te::gm::Polygon*)rastersBBoxes[ 0 ].clone() );
+
+      // skipping the first raster
+
+      m_inputParameters.m_feederRasterPtr->reset();
+      m_inputParameters.m_feederRasterPtr->moveNext();
+
+      // iterating over the other rasters
+      
+      te::rst::Raster const* originalInputRasterPtr = 0;
+
+      std::vector< unsigned int > outputRasterBands;
+      std::vector< double > dummyRasterOffsets;
+      std::vector< double > dummyRasterScales;
+      for( unsigned int outputRasterBandsIdx = 0 ; outputRasterBandsIdx <
+        outputRasterPtr->getNumberOfBands() ; ++outputRasterBandsIdx )
+      {
+        outputRasterBands.push_back( outputRasterBandsIdx );
+        dummyRasterOffsets.push_back( 0.0 );
+        dummyRasterScales.push_back( 1.0 );
+      }      
+
+      while( ( originalInputRasterPtr = m_inputParameters.m_feederRasterPtr->getCurrentObj() ) )
+      {
+        const unsigned int inputRasterIdx = m_inputParameters.m_feederRasterPtr->getCurrentOffset();
+        
+//         Copy2DiskRaster( outputRaster, boost::lexical_cast< std::string >( inputRasterIdx ) +
+//           "_output_raster_begininng.tif" );
+
+        TERP_DEBUG_TRUE_OR_THROW( rastersBBoxes[ inputRasterIdx ].getSRID() == outputRasterPtr->getSRID(),
+          "Invalid boxes SRID" );
+          
+        te::rst::Raster const* inputRasterPtr = originalInputRasterPtr;
+        
+//         Copy2DiskRaster( *inputRasterPtr, boost::lexical_cast< std::string >( inputRasterIdx ) +
+//           "_input_raster.tif" );
+
+        // reprojection / caching issues
+        
+        std::auto_ptr< te::rst::Raster > reprojectedInputRasterPtr;
+        
+        std::string reprojectedRasterFileName;
+
+        if( outputRasterPtr->getSRID() != inputRasterPtr->getSRID() )
+        {
+          boost::filesystem::path tempDirPath(
+              te::core::FileSystem::tempDirectoryPath());
+          reprojectedRasterFileName = te::core::FileSystem::uniquePath(
+              (tempDirPath /= boost::filesystem::path(
+                   "TerralibRGeoMosaic_%%%%-%%%%-%%%%-%%%%")).string());
+          TERP_TRUE_OR_RETURN_FALSE( !reprojectedRasterFileName.empty(),
+            "Invalid temporary raster file name" );
+          reprojectedRasterFileName += ".tif";
+          
+          std::map< std::string, std::string > rInfo;
+          rInfo[ "URI" ] = reprojectedRasterFileName;
+          
+          reprojectedInputRasterPtr.reset( inputRasterPtr->transform( 
+            outputRasterPtr->getSRID(), rInfo,
+            m_inputParameters.m_interpMethod) );
+          inputRasterPtr = reprojectedInputRasterPtr.get();
+          TERP_TRUE_OR_RETURN_FALSE( inputRasterPtr, "Reprojection error" );
+          
+//           Copy2DiskRaster( *inputRasterPtr, boost::lexical_cast< std::string >( inputRasterIdx ) +
+//             "reprojected_input_raster.tif" );
+        }
+        
+        // Caching issues 
+        
+        std::auto_ptr< te::mem::CachedRaster > cachedInputRasterPtr;
+        
+        if( m_inputParameters.m_useRasterCache )
+        {
+          cachedInputRasterPtr.reset( new te::mem::CachedRaster(
+            *inputRasterPtr, 20, 0 ) );
+          inputRasterPtr = cachedInputRasterPtr.get();
+        }         
+        
+        // The transformation mapping outputRaster pixels 
+        // ( te::gm::GTParameters::TiePoint::first ) to input pixels 
+        // ( te::gm::GTParameters::TiePoint::second ) 
+        // (Note: all coords are indexed by lines/columns).
+        
+        std::auto_ptr< te::gm::GeometricTransformation > transPtr;
+        
+        {
+          te::gm::GTParameters transParams;
+          double auxX;
+          double auxY;
+          te::gm::GTParameters::TiePoint auxTP;
+          
+          auxTP.first.x = 0;
+          auxTP.first.y = 0;
+          outputRasterPtr->getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
+          inputRasterPtr->getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );
+          transParams.m_tiePoints.push_back( auxTP );
+          
+          auxTP.first.x = 0;
+          auxTP.first.y = (double)( outputRasterPtr->getNumberOfRows() - 1 );
+          outputRasterPtr->getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
+          inputRasterPtr->getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );          
+          transParams.m_tiePoints.push_back( auxTP );
+//           
+//           auxTP.first.x = (double)( outputRasterPtr->getNumberOfColumns() - 1);
+//           auxTP.first.y = 0;
+//           outputRasterPtr->getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
+//           inputRasterPtr->getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );
+//           transParams.m_tiePoints.push_back( auxTP );
+          
+          auxTP.first.x = (double)( outputRasterPtr->getNumberOfColumns() - 1 );
+          auxTP.first.y = (double)( outputRasterPtr->getNumberOfRows() - 1 );
+          outputRasterPtr->getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
+          inputRasterPtr->getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );                    
+          transParams.m_tiePoints.push_back( auxTP );
+          
+          transPtr.reset( te::gm::GTFactory::make( "RST" ) );
+          TERP_TRUE_OR_RETURN_FALSE( transPtr.get(), "Could not instantiate a geometric transformation" );
+          
+          TERP_TRUE_OR_RETURN_FALSE( transPtr->initialize( transParams ),
+            "Could not initialize a geometric transformation" );
+        }
+
+        // Generating the offset and gain info for eath band from the current raster
+
+        std::vector< double > currentRasterBandsOffsets = dummyRasterOffsets;
+        std::vector< double > currentRasterBandsScales = dummyRasterScales;
+
+        if( m_inputParameters.m_autoEqualize )
+        {
+          double currentRasterVariance = 0;
+          double currentRasterMean = 0;
+
+          for( unsigned int inputRastersBandsIdx = 0 ; inputRastersBandsIdx <
+            m_inputParameters.m_inputRastersBands[ inputRasterIdx ].size() ;
+            ++inputRastersBandsIdx )
+          {
+            const unsigned int inputBandIdx = m_inputParameters.m_inputRastersBands[ inputRasterIdx ][
+              inputRastersBandsIdx ];
+
+            if( 
+                ( mosaicTargetMeans[ inputRastersBandsIdx ] != 0.0 )
+                &&
+                ( mosaicTargetVariances[ inputRastersBandsIdx ] != 0.0 )
+              )
+            {
+              calcBandStatistics( (*inputRasterPtr->getBand( inputBandIdx ) ),
+                m_inputParameters.m_forceInputNoDataValue,
+                m_inputParameters.m_noDataValue,
+                currentRasterMean,
+                currentRasterVariance );
+
+              currentRasterBandsScales[ inputRastersBandsIdx ] = 
+                ( 
+                  std::sqrt( mosaicTargetVariances[ inputRastersBandsIdx ] )
+                   /
+                  std::sqrt( currentRasterVariance ) 
+                );
+              currentRasterBandsOffsets[ inputRastersBandsIdx ] =
+                ( 
+                  mosaicTargetMeans[ inputRastersBandsIdx ]
+                   - 
+                  ( 
+                    currentRasterBandsScales[ inputRastersBandsIdx ] 
+                    * 
+                    currentRasterMean 
+                  ) 
+                );
+            }
+          }
+        }
+
+         // blending
+
+        te::rp::Blender blenderInstance;
+
+        TERP_TRUE_OR_RETURN_FALSE( blenderInstance.initialize(
+          *outputRasterPtr,
+          outputRasterBands,
+          *inputRasterPtr,
+          m_inputParameters.m_inputRastersBands[ inputRasterIdx ],
+          m_inputParameters.m_blendMethod,
+          te::rst::NearestNeighbor,
+          m_inputParameters.m_interpMethod,
+          m_inputParameters.m_noDataValue,
+          false,
+          m_inputParameters.m_forceInputNoDataValue,
+          dummyRasterOffsets,
+          dummyRasterScales,
+          currentRasterBandsOffsets,
+          currentRasterBandsScales,
+          mosaicBBoxesUnionPtr.get(),
+          0,
+          *transPtr,
+          m_inputParameters.m_enableMultiThread ? 0 : 1,
+          false ), "Blender initiazing error" );
+        
+        TERP_TRUE_OR_RETURN_FALSE( blenderInstance.blendIntoRaster1(), 
+          "Error blending images" );
+
+//           Copy2DiskRaster( outputRaster, boost::lexical_cast< std::string >( inputRasterIdx ) +
+//              "output_raster_after_blending_" + 
+//             boost::lexical_cast< std::string >( mosaicBBoxesUnionIdx ) + ".tif" );
+
+        // updating the  gloabal mosaic boxes
+
+        std::auto_ptr< te::gm::Geometry > boxesUnionResultPtr; // under the mosaic SRID
+        TERP_TRUE_OR_RETURN_FALSE( mosaicBBoxesUnionPtr->isValid(), 
+          "Invalid mosaic bounding boxes union geometry" );
+        TERP_TRUE_OR_RETURN_FALSE( rastersBBoxes[ inputRasterIdx ].isValid(), 
+          "Invalid raster bounding boxes union geometry (raster index:"
+          + boost::lexical_cast< std::string >( inputRasterIdx ) + ")" );  
+        
+        try
+        {
+          boxesUnionResultPtr.reset( mosaicBBoxesUnionPtr->Union(
+            &( rastersBBoxes[ inputRasterIdx ] ) ) );
+        }
+        catch( const std::exception& e )
+        {
+          TERP_LOG_AND_RETURN_FALSE( "Mosaic bounding boxes union error" ); 
+        }
+        
+        TERP_TRUE_OR_THROW( boxesUnionResultPtr.get(), "Invalid pointer" );
+        
+        boxesUnionResultPtr->setSRID( outputRasterPtr->getSRID() );
+
+        if( 
+            ( boxesUnionResultPtr->getGeomTypeId() == te::gm::MultiPolygonType )
+            ||
+            ( boxesUnionResultPtr->getGeomTypeId() == te::gm::MultiPolygonZType )
+            ||
+            ( boxesUnionResultPtr->getGeomTypeId() == te::gm::MultiPolygonMType )
+            ||
+            ( boxesUnionResultPtr->getGeomTypeId() == te::gm::MultiPolygonZMType )
+          )
+        {
+          mosaicBBoxesUnionPtr.reset( (te::gm::MultiPolygon*)boxesUnionResultPtr.release() );
+        }
+        else if( 
+                 ( boxesUnionResultPtr->getGeomTypeId() == te::gm::PolygonType )
+                 ||
+                 ( boxesUnionResultPtr->getGeomTypeId() == te::gm::PolygonZType )
+                 ||
+                 ( boxesUnionResultPtr->getGeomTypeId() == te::gm::PolygonMType )
+                 ||
+                 ( boxesUnionResultPtr->getGeomTypeId() == te::gm::PolygonZMType )
+               )
+        {
+          // transforming it into a te::gm::MultiPolygon
+          te::gm::MultiPolygon* auxMultiPol = new te::gm::MultiPolygon( 0,
+            te::gm::MultiPolygonType, boxesUnionResultPtr->getSRID(), 0 );
+          auxMultiPol->add( boxesUnionResultPtr.release() );
+
+          mosaicBBoxesUnionPtr.reset( auxMultiPol );
+        }
+        else
+        {
+          TERP_LOGWARN( "Invalid union geometry type" );
+        }
+        
+        // Reseting the input cache
+        
+        cachedInputRasterPtr.reset();
+        
+        // deleting the reprojected raster
+        
+        if( reprojectedInputRasterPtr.get() )
+        {
+          reprojectedInputRasterPtr.reset();
+          remove( reprojectedRasterFileName.c_str() );
+        }
+
+        // moving to the next raster
+
+        m_inputParameters.m_feederRasterPtr->moveNext();
+        
+        if( m_inputParameters.m_enableProgress )
+        {
+          progressPtr->pulse();
+          if( ! progressPtr->isActive() ) return false;
+        }          
+      }
+      
+      // reseting the output cache
+      
+      if( cachedRasterInstancePtr.get() ) cachedRasterInstancePtr.reset();
+      
+      return true;
+    }
+
+    bool GeoMosaic::executeTiledComposition( te::rst::Raster& outputRaster,
+      const std::vector< double >& outputBandsRangeMin,
+      const std::vector< double >& outputBandsRangeMax,
+      te::common::TaskProgress* progressPtr )
+    {
+      const unsigned int inputRastersNumber = 
+        m_inputParameters.m_feederRasterPtr->getObjsCount();
+      const unsigned int outBandsNumber = (unsigned int)
+        outputRaster.getNumberOfBands();
+        
+      // Output tiling (the output bands blocks)
+        
+      const te::rst::BandProperty& outBandProp = 
+        *outputRaster.getBand( 0 )->getProperty();
+        
+      for( unsigned int outBandIdx = 1 ; outBandIdx < outBandsNumber ; ++outBandIdx )
+      {
+        TERP_TRUE_OR_RETURN_FALSE( 
+          ( outputRaster.getBand( outBandIdx )->getProperty()->m_blkw ==
+          outBandProp.m_blkw ) &&
+          ( outputRaster.getBand( outBandIdx )->getProperty()->m_blkh ==
+          outBandProp.m_blkh ), "Output bands blocking mismatch" );
+      }
+        
+      const unsigned int tilesPerRow = (unsigned int)outBandProp.m_nblocksx;
+      const unsigned int tilesNumber = (unsigned int)( outBandProp.m_nblocksx *
+        outBandProp.m_nblocksy );
+      TERP_TRUE_OR_RETURN_FALSE( tilesNumber > 0, "Invalid output blocking" );
+      
+      if( progressPtr )
+      {
+        progressPtr->setTotalSteps( (int)( inputRastersNumber + tilesNumber ) );
+        progressPtr->setCurrentStep( 0 );
+      }
+      
+      // Preparing the input rasters and indexing their footprints 
+      // (output raster indexed coords)
+      
+      std::vector< std::string > reprojectedRastersFileNames;
+      std::vector< ComposerInputRaster > inputs( inputRastersNumber );
+      
+      // Releases the input rasters and removes the reprojected ones at any
+      // return (errors and cancellations included)
+      
+      class InputsRemover
+      {
+        public :
+          
+          InputsRemover( std::vector< ComposerInputRaster >& inputs,
+            const std::vector< std::string >& fileNames )
+          : m_inputs( inputs ), m_fileNames( fileNames )
+          {
+          }
+          
+          ~InputsRemover()
+          {
+            m_inputs.clear();
+            
+            for( unsigned int fileIdx = 0 ; fileIdx < m_fileNames.size() ;
+              ++fileIdx )
+            {
+              remove( m_fileNames[ fileIdx ].c_str() );
+            }
+          }
+          
+        private :
+          
+          std::vector< ComposerInputRaster >& m_inputs;
+          const std::vector< std::string >& m_fileNames;
+      } inputsRemover( inputs, reprojectedRastersFileNames );
+      
+      // The vector feeder rasters live as long as the feeder, so they are used in place
+      
+      const bool feederKeepsRasters = ( dynamic_cast< FeederConstRasterVector* >(
+        m_inputParameters.m_feederRasterPtr ) != 0 );
+      
+      te::sam::rtree::Index< unsigned int > inputsRTree;
+      std::vector< double > referenceMeans( outBandsNumber, 0.0 );
+      std::vector< double > referenceVariances( outBandsNumber, 0.0 );
+      te::rst::Raster const* originalInputRasterPtr = 0;
+      
+      m_inputParameters.m_feederRasterPtr->reset();
+      
+      while( ( originalInputRasterPtr = m_inputParameters.m_feederRasterPtr->getCurrentObj() ) )
+      {
+        const unsigned int inputRasterIdx = 
+          m_inputParameters.m_feederRasterPtr->getCurrentOffset();
+        ComposerInputRaster& input = inputs[ inputRasterIdx ];
+        
+        // reprojection
+        
+        if( outputRaster.getSRID() != originalInputRasterPtr->getSRID() )
+        {
+          boost::filesystem::path tempDirPath(
+              te::core::FileSystem::tempDirectoryPath());
+          input.m_reprojectedRasterFileName = te::core::FileSystem::uniquePath(
+              (tempDirPath /= boost::filesystem::path(
+                   "TerralibRGeoMosaic_%%%%-%%%%-%%%%-%%%%")).string());
+          TERP_TRUE_OR_RETURN_FALSE( !input.m_reprojectedRasterFileName.empty(),
+            "Invalid temporary raster file name" );
+          input.m_reprojectedRasterFileName += ".tif";
+          reprojectedRastersFileNames.push_back( input.m_reprojectedRasterFileName );
+          
+          std::map< std::string, std::string > rInfo;
+          rInfo[ "URI" ] = input.m_reprojectedRasterFileName;
+          
+          input.m_rasterPtr.reset( originalInputRasterPtr->transform( 
+            outputRaster.getSRID(), rInfo, m_inputParameters.m_interpMethod ) );
+          TERP_TRUE_OR_RETURN_FALSE( input.m_rasterPtr.get(), "Reprojection error" );
+        }
+        else if( feederKeepsRasters )
+        {
+          input.m_rasterPtr.reset( (te::rst::Raster*)originalInputRasterPtr,
+            NoRasterDeleter );
+        }
+        else
+        {
+          // the other feeders release the current raster when moving to the next one
+          
+          input.m_rasterPtr.reset( (te::rst::Raster*)originalInputRasterPtr->clone() );
+          TERP_TRUE_OR_RETURN_FALSE( input.m_rasterPtr.get(), "Raster clone error" );
+        }
+        
+        const te::rst::Raster& inputRaster = *input.m_rasterPtr;
+        
+        // bands info
+        
+        input.m_bands = m_inputParameters.m_inputRastersBands[ inputRasterIdx ];
+        input.m_bandsNoDataValues.resize( outBandsNumber );
+        input.m_bandsOffsets.resize( outBandsNumber, 0.0 );
+        input.m_bandsScales.resize( outBandsNumber, 1.0 );
+        input.m_maxCachedBlocks = 0;
+        
+        for( unsigned int bandIdx = 0 ; bandIdx < outBandsNumber ; ++bandIdx )
+        {
+          const te::rst::Band& inputBand = *inputRaster.getBand( 
+            input.m_bands[ bandIdx ] );
+            
+          input.m_bandsNoDataValues[ bandIdx ] = 
+            m_inputParameters.m_forceInputNoDataValue ?
+            m_inputParameters.m_noDataValue : 
+            inputBand.getProperty()->m_noDataValue;
+            
+          input.m_maxCachedBlocks += 
+            ( ( outBandProp.m_blkw / std::max( 1, inputBand.getProperty()->m_blkw ) ) + 2 )
+            *
+            ( ( outBandProp.m_blkh / std::max( 1, inputBand.getProperty()->m_blkh ) ) + 2 );
+          
+          // equalization (the first raster is the reference)
+            
+          if( m_inputParameters.m_autoEqualize )
+          {
+            if( inputRasterIdx == 0 )
+            {
+              calcBandStatistics( inputBand, m_inputParameters.m_forceInputNoDataValue,
+                m_inputParameters.m_noDataValue, referenceMeans[ bandIdx ],
+                referenceVariances[ bandIdx ] );
+            }
+            else if( ( referenceMeans[ bandIdx ] != 0.0 ) &&
+              ( referenceVariances[ bandIdx ] != 0.0 ) )
+            {
+              double currentRasterMean = 0;
+              double currentRasterVariance = 0;
+              
+              calcBandStatistics( inputBand, m_inputParameters.m_forceInputNoDataValue,
+                m_inputParameters.m_noDataValue, currentRasterMean,
+                currentRasterVariance );
+                
+              if( currentRasterVariance != 0.0 )
+              {
+                input.m_bandsScales[ bandIdx ] = std::sqrt( referenceVariances[ bandIdx ] ) 
+                  / std::sqrt( currentRasterVariance );
+                input.m_bandsOffsets[ bandIdx ] = referenceMeans[ bandIdx ] -
+                  ( input.m_bandsScales[ bandIdx ] * currentRasterMean );
+              }
+            }
+          }
+        }
+        
+        input.m_priority = ( m_inputParameters.m_priorityRule == 
+          GeoMosaic::UserPriorityRule ) ? 
+          m_inputParameters.m_inputRastersPriorities[ inputRasterIdx ] : 0.0;
+        
+        // The transformation mapping output raster indexed coords 
+        // ( te::gm::GTParameters::TiePoint::first ) to input raster
+        // indexed coords ( te::gm::GTParameters::TiePoint::second ).
+        
+        {
+          te::gm::GTParameters transParams;
+          te::gm::GTParameters::TiePoint auxTP;
+          double auxX = 0;
+          double auxY = 0;
+          
+          for( unsigned int tpIdx = 0 ; tpIdx < 3 ; ++tpIdx )
+          {
+            auxTP.first.x = ( tpIdx == 2 ) ? 
+              (double)( outputRaster.getNumberOfColumns() - 1 ) : 0.0;
+            auxTP.first.y = ( tpIdx == 0 ) ? 0.0 :
+              (double)( outputRaster.getNumberOfRows() - 1 );
+            outputRaster.getGrid()->gridToGeo( auxTP.first.x, auxTP.first.y, auxX, auxY );
+            inputRaster.getGrid()->geoToGrid( auxX, auxY, auxTP.second.x, auxTP.second.y );
+            transParams.m_tiePoints.push_back( auxTP );
+          }
+          
+          input.m_transPtr.reset( te::gm::GTFactory::make( "RST" ) );
+          TERP_TRUE_OR_RETURN_FALSE( input.m_transPtr.get(), 
+            "Could not instantiate a geometric transformation" );
+          TERP_TRUE_OR_RETURN_FALSE( input.m_transPtr->initialize( transParams ),
+            "Could not initialize a geometric transformation" );
+        }
+        
+        // indexing the footprint
+        
+        {
+          te::gm::Envelope footprint;
+          double outX = 0;
+          double outY = 0;
+          
+          for( unsigned int cornerIdx = 0 ; cornerIdx < 4 ; ++cornerIdx )
+          {
+            input.m_transPtr->inverseMap( 
+              ( cornerIdx % 2 ) ? ( ((double)inputRaster.getNumberOfColumns()) - 0.5 ) : -0.5,
+              ( cornerIdx / 2 ) ? ( ((double)inputRaster.getNumberOfRows()) - 0.5 ) : -0.5,
+              outX, outY );
+            
+            if( cornerIdx == 0 )
+            {
+              footprint.init( outX, outY, outX, outY );
+            }
+            else
+            {
+              footprint.m_llx = std::min( footprint.m_llx, outX );
+              footprint.m_lly = std::min( footprint.m_lly, outY );
+              footprint.m_urx = std::max( footprint.m_urx, outX );
+              footprint.m_ury = std::max( footprint.m_ury, outY );
+            }
+          }
+          
+          inputsRTree.insert( footprint, inputRasterIdx );
+        }
+        
+        input.m_syncPtr.reset( new te::rst::RasterSynchronizer( 
+          *input.m_rasterPtr, te::common::RAccess ) );
+        
+        m_inputParameters.m_feederRasterPtr->moveNext();
+        
+        if( progressPtr )
+        {
+          progressPtr->pulse();
+          if( ! progressPtr->isActive() ) return false;
+        }
+      }
+      
+      // Creating the threads parameters
+      
+      const unsigned int threadsNumber = m_inputParameters.m_enableMultiThread ?
+        std::max( 1u, std::min( tilesNumber, te::common::GetPhysProcNumber() ) ) : 1;
+      
+      bool returnValue = true;
+      bool abortValue = false;
+      unsigned int nextTileIdx = 0;
+      unsigned int processedTilesNumber = 0;
+      unsigned int runningThreadsCounter = 0;
+      boost::mutex mutex;
+      boost::mutex tileProcessedSignalMutex;
+      boost::condition_variable tileProcessedSignal;
+      
+      {
+        te::rst::RasterSynchronizer outputSync( outputRaster, te::common::RWAccess );
+        
+        ComposeTilesThreadParams threadParams;
+        threadParams.m_inputsPtr = &inputs;
+        threadParams.m_inputsRTreePtr = &inputsRTree;
+        threadParams.m_outputSyncPtr = &outputSync;
+        threadParams.m_inputParametersPtr = &m_inputParameters;
+        threadParams.m_outputBandsRangeMin = outputBandsRangeMin;
+        threadParams.m_outputBandsRangeMax = outputBandsRangeMax;
+        threadParams.m_tilesPerRow = tilesPerRow;
+        threadParams.m_tilesNumber = tilesNumber;
+        threadParams.m_nextTileIdxPtr = &nextTileIdx;
+        threadParams.m_processedTilesNumberPtr = &processedTilesNumber;
+        threadParams.m_runningThreadsCounterPtr = &runningThreadsCounter;
+        threadParams.m_returnValuePtr = &returnValue;
+        threadParams.m_abortValuePtr = &abortValue;
+        threadParams.m_mutexPtr = &mutex;
+        threadParams.m_tileProcessedSignalMutexPtr = &tileProcessedSignalMutex;
+        threadParams.m_tileProcessedSignalPtr = &tileProcessedSignal;
+        threadParams.m_useProgress = false;
+        
+        boost::thread_group threads;
+        
+        runningThreadsCounter = threadsNumber;
+        
+        for( unsigned int threadIdx = 0 ; threadIdx < threadsNumber ; ++threadIdx )
+        {
+          threads.add_thread( new boost::thread( composeTilesThreadEntry, 
+            &threadParams ) );
+        }
+        
+        // progress stuff
+        
+        if( progressPtr )
+        {
+          int currentStep = (int)inputRastersNumber;
+          
+          while( true )
+          {
+            {
+              boost::unique_lock<boost::mutex> lock( tileProcessedSignalMutex );
+              tileProcessedSignal.timed_wait( lock, 
+                boost::posix_time::seconds( 1 ) );
+            }
+            
+            mutex.lock();
+            const bool stop = abortValue || ( runningThreadsCounter == 0 );
+            const int processedTiles = (int)processedTilesNumber;
+            mutex.unlock();
+            
+            if( stop ) break;
+            
+            if( progressPtr->isActive() )
+            {
+              if( ( (int)inputRastersNumber + processedTiles ) != currentStep )
+              {
+                currentStep = (int)inputRastersNumber + processedTiles;
+                progressPtr->setCurrentStep( currentStep );
+              }
+            }
+            else
+            {
+              mutex.lock();
+              abortValue = true;
+              returnValue = false;
+              mutex.unlock();
+              break;
+            }
+          }
+        }
+        
+        threads.join_all();
+      }
+      
+      return returnValue;
+    }
+    
+    void GeoMosaic::composeTilesThreadEntry( ComposeTilesThreadParams* paramsPtr )
+    {
+      const std::vector< ComposerInputRaster >& inputs = *paramsPtr->m_inputsPtr;
+      const GeoMosaic::InputParameters& inputParams = *paramsPtr->m_inputParametersPtr;
+      const unsigned int inputsNumber = (unsigned int)inputs.size();
+      
+      // Instantiating the local rasters instances
+      
+      te::rst::SynchronizedRaster outputRaster( 
+        (unsigned int)paramsPtr->m_outputBandsRangeMin.size(),
+        *( paramsPtr->m_outputSyncPtr ) );
+        
+      const unsigned int nBands = (unsigned int)outputRaster.getNumberOfBands();
+      const unsigned int nRows = (unsigned int)outputRaster.getNumberOfRows();
+      const unsigned int nCols = (unsigned int)outputRaster.getNumberOfColumns();
+      const unsigned int blkW = (unsigned int)outputRaster.getBand( 0 )->getProperty()->m_blkw;
+      const unsigned int blkH = (unsigned int)outputRaster.getBand( 0 )->getProperty()->m_blkh;
+      
+      std::vector< te::rst::Band* > outputBands( nBands );
+      for( unsigned int bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+        outputBands[ bandIdx ] = outputRaster.getBand( bandIdx );
+      
+      // The input rasters local instances are created on demand
+      
+      std::vector< boost::shared_ptr< te::rst::SynchronizedRaster > > inRasters( inputsNumber );
+      std::vector< boost::shared_ptr< te::rst::Interpolator > > inInterpolators( inputsNumber );
+      std::vector< boost::shared_ptr< te::gm::GeometricTransformation > > inTransformations( inputsNumber );
+      std::vector< double > inNRows( inputsNumber, 0.0 );
+      std::vector< double > inNCols( inputsNumber, 0.0 );
+      
+      const te::rp::Blender::BlendMethod blendMethod = inputParams.m_blendMethod;
+      const bool firstValidWins = ( blendMethod == te::rp::Blender::NoBlendMethod ) &&
+        ( inputParams.m_priorityRule != GeoMosaic::SeamlinePriorityRule );
+      const double noDataValue = inputParams.m_noDataValue;
+      
+      std::vector< unsigned int > candidates;
+      std::vector< std::pair< double, unsigned int > > priorityCandidates;
+      std::vector< double > pixelValues( nBands, 0.0 );
+      std::vector< double > blendedValues( nBands, 0.0 );
+      std::complex< double > cValue;
+      te::gm::Envelope tileEnvelope;
+      unsigned int tileIdx = 0;
+      unsigned int firstRow = 0;
+      unsigned int rowsBound = 0;
+      unsigned int firstCol = 0;
+      unsigned int colsBound = 0;
+      unsigned int row = 0;
+      unsigned int col = 0;
+      unsigned int bandIdx = 0;
+      unsigned int candidatesIdx = 0;
+      unsigned int inputIdx = 0;
+      unsigned int contributorsNumber = 0;
+      double inCol = 0;
+      double inRow = 0;
+      double weight = 0;
+      double bestWeight = 0;
+      double weightsSum = 0;
+      double value = 0;
+      bool validPixel = false;
+      
+      while( true )
+      {
+        // looking for the next tile to compose
+        
+        paramsPtr->m_mutexPtr->lock();
+        
+        if( *( paramsPtr->m_abortValuePtr ) || ( *( paramsPtr->m_nextTileIdxPtr ) >=
+          paramsPtr->m_tilesNumber ) )
+        {
+          paramsPtr->m_mutexPtr->unlock();
+          break;
+        }
+        
+        tileIdx = ( *( paramsPtr->m_nextTileIdxPtr ) )++;
+        
+        paramsPtr->m_mutexPtr->unlock();
+        
+        firstRow = ( tileIdx / paramsPtr->m_tilesPerRow ) * blkH;
+        rowsBound = std::min( firstRow + blkH, nRows );
+        firstCol = ( tileIdx % paramsPtr->m_tilesPerRow ) * blkW;
+        colsBound = std::min( firstCol + blkW, nCols );
+        
+        if( ( firstRow < rowsBound ) && ( firstCol < colsBound ) )
+        {
+          // Finding the input rasters covering the tile (in feeder or 
+          // priority order)
+          
+          tileEnvelope.init( (double)firstCol, (double)firstRow,
+            (double)( colsBound - 1 ), (double)( rowsBound - 1 ) );
+            
+          candidates.clear();
+          paramsPtr->m_inputsRTreePtr->search( tileEnvelope, candidates );
+          std::sort( candidates.begin(), candidates.end() );
+          
+          if( inputParams.m_priorityRule == GeoMosaic::UserPriorityRule )
+          {
+            priorityCandidates.clear();
+            
+            for( candidatesIdx = 0 ; candidatesIdx < candidates.size() ; ++candidatesIdx )
+            {
+              priorityCandidates.push_back( std::pair< double, unsigned int >( 
+                -1.0 * inputs[ candidates[ candidatesIdx ] ].m_priority, 
+                candidates[ candidatesIdx ] ) );
+            }
+            
+            std::sort( priorityCandidates.begin(), priorityCandidates.end() );
+            
+            for( candidatesIdx = 0 ; candidatesIdx < candidates.size() ; ++candidatesIdx )
+            {
+              candidates[ candidatesIdx ] = priorityCandidates[ candidatesIdx ].second;
+            }
+          }
+          
+          for( candidatesIdx = 0 ; candidatesIdx < candidates.size() ; ++candidatesIdx )
+          {
+            inputIdx = candidates[ candidatesIdx ];
+            
+            if( inRasters[ inputIdx ].get() == 0 )
+            {
+              inRasters[ inputIdx ].reset( new te::rst::SynchronizedRaster( 
+                inputs[ inputIdx ].m_maxCachedBlocks, *inputs[ inputIdx ].m_syncPtr ) );
+              inInterpolators[ inputIdx ].reset( new te::rst::Interpolator( 
+                inRasters[ inputIdx ].get(), inputParams.m_interpMethod ) );
+              
+              paramsPtr->m_mutexPtr->lock();
+              inTransformations[ inputIdx ].reset( inputs[ inputIdx ].m_transPtr->clone() );
+              paramsPtr->m_mutexPtr->unlock();
+              
+              inNRows[ inputIdx ] = (double)inRasters[ inputIdx ]->getNumberOfRows();
+              inNCols[ inputIdx ] = (double)inRasters[ inputIdx ]->getNumberOfColumns();
+            }
+          }
+          
+          // Composing the tile pixels
+          
+          for( row = firstRow ; row < rowsBound ; ++row )
+          {
+            for( col = firstCol ; col < colsBound ; ++col )
+            {
+              contributorsNumber = 0;
+              bestWeight = 0;
+              weightsSum = 0;
+              
+              for( candidatesIdx = 0 ; candidatesIdx < candidates.size() ; ++candidatesIdx )
+              {
+                inputIdx = candidates[ candidatesIdx ];
+                const ComposerInputRaster& input = inputs[ inputIdx ];
+                
+                inTransformations[ inputIdx ]->directMap( (double)col, (double)row,
+                  inCol, inRow );
+                  
+                // distance to the input footprint border (pixels)
+                  
+                weight = std::min( 
+                  std::min( inCol + 0.5, inNCols[ inputIdx ] - 0.5 - inCol ),
+                  std::min( inRow + 0.5, inNRows[ inputIdx ] - 0.5 - inRow ) );
+                  
+                if( weight <= 0.0 ) continue;
+                
+                validPixel = true;
+                
+                for( bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+                {
+                  inInterpolators[ inputIdx ]->getValue( inCol, inRow, cValue,
+                    input.m_bands[ bandIdx ] );
+                    
+                  if( cValue.real() == input.m_bandsNoDataValues[ bandIdx ] )
+                  {
+                    validPixel = false;
+                    break;
+                  }
+                  
+                  pixelValues[ bandIdx ] = ( cValue.real() * input.m_bandsScales[ bandIdx ] )
+                    + input.m_bandsOffsets[ bandIdx ];
+                }
+                
+                if( ! validPixel ) continue;
+                
+                switch( blendMethod )
+                {
+                  case te::rp::Blender::EuclideanDistanceMethod :
+                  {
+                    for( bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+                    {
+                      blendedValues[ bandIdx ] = ( contributorsNumber == 0 ) ?
+                        ( pixelValues[ bandIdx ] * weight ) :
+                        ( blendedValues[ bandIdx ] + ( pixelValues[ bandIdx ] * weight ) );
+                    }
+                    weightsSum += weight;
+                    break;
+                  }
+                  case te::rp::Blender::SumMethod :
+                  {
+                    for( bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+                    {
+                      blendedValues[ bandIdx ] = ( contributorsNumber == 0 ) ?
+                        pixelValues[ bandIdx ] :
+                        ( blendedValues[ bandIdx ] + pixelValues[ bandIdx ] );
+                    }
+                    break;
+                  }
+                  case te::rp::Blender::MaxMethod :
+                  {
+                    for( bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+                    {
+                      blendedValues[ bandIdx ] = ( contributorsNumber == 0 ) ?
+                        pixelValues[ bandIdx ] :
+                        std::max( blendedValues[ bandIdx ], pixelValues[ bandIdx ] );
+                    }
+                    break;
+                  }
+                  case te::rp::Blender::MinMethod :
+                  {
+                    for( bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+                    {
+                      blendedValues[ bandIdx ] = ( contributorsNumber == 0 ) ?
+                        pixelValues[ bandIdx ] :
+                        std::min( blendedValues[ bandIdx ], pixelValues[ bandIdx ] );
+                    }
+                    break;
+                  }
+                  default :
+                  {
+                    // NoBlendMethod - priority rules
+                    
+                    if( ( contributorsNumber == 0 ) || ( weight > bestWeight ) )
+                    {
+                      blendedValues = pixelValues;
+                      bestWeight = weight;
+                    }
+                    break;
+                  }
+                }
+                
+                ++contributorsNumber;
+                
+                if( firstValidWins ) break;
+              }
+              
+              // Writing the output pixel
+              
+              for( bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+              {
+                if( contributorsNumber == 0 )
+                {
+                  value = noDataValue;
+                }
+                else
+                {
+                  value = blendedValues[ bandIdx ];
+                  
+                  if( ( blendMethod == te::rp::Blender::EuclideanDistanceMethod ) &&
+                    ( weightsSum > 0.0 ) )
+                  {
+                    value /= weightsSum;
+                  }
+                  
+                  value = std::max( paramsPtr->m_outputBandsRangeMin[ bandIdx ], 
+                    std::min( paramsPtr->m_outputBandsRangeMax[ bandIdx ], value ) );
+                }
+                
+                outputBands[ bandIdx ]->setValue( col, row, value );
+              }
+            }
+          }
+        }
+        
+        // progress stuff
+        
+        paramsPtr->m_mutexPtr->lock();
+        ++( *( paramsPtr->m_processedTilesNumberPtr ) );
+        paramsPtr->m_mutexPtr->unlock();
+        
+        {
+          boost::lock_guard<boost::mutex> tileProcessedSignalLockGuard( 
+            *( paramsPtr->m_tileProcessedSignalMutexPtr ) );
+          paramsPtr->m_tileProcessedSignalPtr->notify_one();
+        }
+      }
+      
+      paramsPtr->m_mutexPtr->lock();
+      --( *( paramsPtr->m_runningThreadsCounterPtr ) );
+      paramsPtr->m_mutexPtr->unlock();
+      
+      boost::lock_guard<boost::mutex> tileProcessedSignalLockGuard( 
+        *( paramsPtr->m_tileProcessedSignalMutexPtr ) );
+      paramsPtr->m_tileProcessedSignalPtr->notify_one();
+    }
+
+    void GeoMosaic::reset() throw( te::rp::Exception )
+    {
+      m_inputParameters.reset();
+      m_isInitialized = false;
+    }
+
+    bool GeoMosaic::initialize( const AlgorithmInputParameters& inputParams )
+      throw( te::rp::Exception )
+    {
+      reset();
+
+      GeoMosaic::InputParameters const* inputParamsPtr = dynamic_cast<
+        GeoMosaic::InputParameters const* >( &inputParams );
+      TERP_TRUE_OR_THROW( inputParamsPtr, "Invalid paramters pointer" );
+
+      m_inputParameters = *inputParamsPtr;
+
+      // Checking the feeder
+
+      TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_feederRasterPtr,
+        "Invalid m_feederRasterPtr" )
+
+      TERP_TRUE_OR_RETURN_FALSE(
+        m_inputParameters.m_feederRasterPtr->getObjsCount() > 0,
+        "Invalid number of rasters" )
+
+      // checking m_inputRastersBands
+
+      TERP_TRUE_OR_RETURN_FALSE(
+        ((unsigned int)m_inputParameters.m_inputRastersBands.size()) ==
+        m_inputParameters.m_feederRasterPtr->getObjsCount(),
+        "Bands mismatch" );
+
+      for( std::vector< std::vector< unsigned int > >::size_type
+        inputRastersBandsIdx = 0 ;  inputRastersBandsIdx <
+        m_inputParameters.m_inputRastersBands.size() ; ++inputRastersBandsIdx )
+      {
+        TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_inputRastersBands[
+          inputRastersBandsIdx ].size() > 0, "Invalid bands number" );
+
+        TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_inputRastersBands[
+          inputRastersBandsIdx ].size() ==  m_inputParameters.m_inputRastersBands[
+          0 ].size(), "Bands number mismatch" );
+      }
+      
+      // checking the execution mode
+      
+      TERP_TRUE_OR_RETURN_FALSE( 
+        ( m_inputParameters.m_executionMode == GeoMosaic::SequentialBlendingMode ) ||
+        ( m_inputParameters.m_executionMode == GeoMosaic::TiledCompositionMode ),
+        "Invalid execution mode" );
+        
+      if( m_inputParameters.m_executionMode == GeoMosaic::TiledCompositionMode )
+      {
+        TERP_TRUE_OR_RETURN_FALSE( 
+          ( m_inputParameters.m_priorityRule == GeoMosaic::FeederOrderPriorityRule ) ||
+          ( m_inputParameters.m_priorityRule == GeoMosaic::UserPriorityRule ) ||
+          ( m_inputParameters.m_priorityRule == GeoMosaic::SeamlinePriorityRule ),
+          "Invalid priority rule" );
+          
+        TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_blendMethod != 
+          te::rp::Blender::InvalidBlendMethod, "Invalid blend method" );
+          
+        if( m_inputParameters.m_priorityRule == GeoMosaic::UserPriorityRule )
+        {
+          TERP_TRUE_OR_RETURN_FALSE(
+            ((unsigned int)m_inputParameters.m_inputRastersPriorities.size()) ==
+            m_inputParameters.m_feederRasterPtr->getObjsCount(),
+            "Priorities mismatch" );
+        }
+      }
+
+      m_isInitialized = true;
+
+      return true;
+    }
+
+    bool GeoMosaic::isInitialized() const
+    {
+      return m_isInitialized;
+    }
+
+    void GeoMosaic::calcBandStatistics( const te::rst::Band& band,
+      const bool& forceNoDataValue,
+      const double& noDataValue,
+      double& mean, double& variance )
+    {
+      mean = 0;
+      variance = 0;
+
+      double internalNoDataValue = 0;
+      if( forceNoDataValue )
+        internalNoDataValue = noDataValue;
+      else
+        internalNoDataValue = band.getProperty()->m_noDataValue;
+
+      const unsigned int nCols = band.getProperty()->m_blkw *
+        band.getProperty()->m_nblocksx;
+      const unsigned int nLines = band.getProperty()->m_blkh *
+        band.getProperty()->m_nblocksy;
+
+      double pixelsNumber = 0;
+      double value = 0;
+      unsigned int col = 0;
+      unsigned int line = 0;
+
+      for( line = 0 ; line < nLines ; ++line )
+        for( col = 0 ; col < nCols ; ++col )
+        {
+          band.getValue( col, line, value );
+
+          if( value != internalNoDataValue )
+          {
+            mean += value;
+            ++pixelsNumber;
+          }
+        }
+
+      if( pixelsNumber != 0.0 )
+      {
+        mean /= pixelsNumber;
+
+        for( line = 0 ; line < nLines ; ++line )
+          for( col = 0 ; col < nCols ; ++col )
+          {
+            band.getValue( col, line, value );
+
+            if( value != internalNoDataValue )
+            {
+              variance += ( ( value - mean ) * ( value - mean ) ) / pixelsNumber;
+            }
+          }
+
+      }
+    }
+
+  } // end namespace rp
+}   // end namespace te
+
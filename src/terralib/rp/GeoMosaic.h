@@ -29,6 +29,12 @@
 #include "FeedersRaster.h"
 #include "Blender.h"
 #include "../raster/Interpolator.h"
+#include "../raster/RasterSynchronizer.h"
+#include "../geometry/GeometricTransformation.h"
+#include "../sam/rtree/Index.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
 
 #include <vector>
 #include <string>
@@ -37,6 +43,11 @@
 
 namespace te
 {
+  namespace common
+  {
+    class TaskProgress;
+  }
+  
   namespace rp
   {
     /*!
@@ -49,6 +60,23 @@ namespace te
     {
       public:
         
+        /*! \enum ExecutionMode Mosaic execution modes. */
+        enum ExecutionMode
+        {
+          InvalidExecutionMode, //!< Invalid execution mode.
+          SequentialBlendingMode, //!< Input rasters are blended one after another into the output mosaic.
+          TiledCompositionMode //!< All input rasters are composed in one output pass, each output tile is rendered (in parallel) by sampling all input rasters covering it.
+        };
+        
+        /*! \enum PriorityRule Rules to choose the raster used over overlapped areas (TiledCompositionMode with NoBlendMethod). */
+        enum PriorityRule
+        {
+          InvalidPriorityRule, //!< Invalid priority rule.
+          FeederOrderPriorityRule, //!< The first raster (feeder order) covering the pixel is used.
+          UserPriorityRule, //!< The raster with the highest m_inputRastersPriorities value covering the pixel is used (ties resolved by feeder order).
+          SeamlinePriorityRule //!< The raster with the farthest footprint border from the pixel is used (seamlines halfway between the overlapped footprints borders).
+        };
+        
         /*!
           \class InputParameters
           \brief GeoMosaic input parameters
@@ -77,6 +105,12 @@ namespace te
             
             bool m_enableMultiThread; //!< Enable/disable the use of threads (default:true).
             
+            GeoMosaic::ExecutionMode m_executionMode; //!< The mosaic execution mode (default:SequentialBlendingMode).
+            
+            GeoMosaic::PriorityRule m_priorityRule; //!< TiledCompositionMode - The rule used over overlapped areas when m_blendMethod is NoBlendMethod (default:FeederOrderPriorityRule).
+            
+            std::vector< double > m_inputRastersPriorities; //!< TiledCompositionMode and UserPriorityRule - One priority value for each input raster (higher values first).
+            
             InputParameters();
             
             InputParameters( const InputParameters& );
@@ -140,6 +174,86 @@ namespace te
 
       protected:
         
+        /*!
+          \class ComposerInputRaster
+          \brief An input raster prepared for the tiled composition.
+         */
+        class ComposerInputRaster
+        {
+          public :
+            
+            boost::shared_ptr< te::rst::Raster > m_rasterPtr; //!< The input raster (the feeder raster itself, a clone or a reprojected version of it).
+            
+            boost::shared_ptr< te::rst::RasterSynchronizer > m_syncPtr; //!< The input raster synchronizer.
+            
+            boost::shared_ptr< te::gm::GeometricTransformation > m_transPtr; //!< A transformation mapping output raster indexed coords to input raster indexed coords.
+            
+            std::string m_reprojectedRasterFileName; //!< The temporary reprojected raster file name (empty if no reprojection was performed).
+            
+            std::vector< unsigned int > m_bands; //!< The input raster bands to process.
+            
+            std::vector< double > m_bandsNoDataValues; //!< The no-data value of each band.
+            
+            std::vector< double > m_bandsOffsets; //!< The equalization offset of each band.
+            
+            std::vector< double > m_bandsScales; //!< The equalization scale of each band.
+            
+            double m_priority; //!< The raster priority.
+            
+            unsigned int m_maxCachedBlocks; //!< The maximum number of cached blocks for each thread.
+            
+            ComposerInputRaster() : m_priority( 0 ), m_maxCachedBlocks( 0 ) {};
+            
+            ~ComposerInputRaster() {};
+        };
+        
+        /*!
+          \class ComposeTilesThreadParams
+          \brief Parameters used by the composeTilesThreadEntry method.
+         */
+        class ComposeTilesThreadParams
+        {
+          public :
+            
+            std::vector< ComposerInputRaster > const* m_inputsPtr; //!< The prepared input rasters.
+            
+            te::sam::rtree::Index< unsigned int > const* m_inputsRTreePtr; //!< The input rasters footprints index (output raster indexed coords).
+            
+            te::rst::RasterSynchronizer* m_outputSyncPtr; //!< The output raster synchronizer.
+            
+            GeoMosaic::InputParameters const* m_inputParametersPtr; //!< The algorithm input parameters.
+            
+            std::vector< double > m_outputBandsRangeMin; //!< The output bands allowed minimum values.
+            
+            std::vector< double > m_outputBandsRangeMax; //!< The output bands allowed maximum values.
+            
+            unsigned int m_tilesPerRow; //!< The number of output tiles (blocks) per row.
+            
+            unsigned int m_tilesNumber; //!< The total number of output tiles (blocks).
+            
+            unsigned int* m_nextTileIdxPtr; //!< A pointer to the next tile to process.
+            
+            unsigned int* m_processedTilesNumberPtr; //!< A pointer to the number of processed tiles.
+            
+            unsigned int* m_runningThreadsCounterPtr; //!< A pointer to the running threads counter.
+            
+            bool* m_returnValuePtr; //!< A pointer to the threads return value.
+            
+            bool* m_abortValuePtr; //!< A pointer to the abort execution flag.
+            
+            boost::mutex* m_mutexPtr; //!< A pointer to the sync mutex.
+            
+            boost::mutex* m_tileProcessedSignalMutexPtr; //!< A pointer to the tile processed signal mutex.
+            
+            boost::condition_variable* m_tileProcessedSignalPtr; //!< A pointer to the tile processed signal.
+            
+            bool m_useProgress; //!< Enable/disable the progress interface.
+            
+            ComposeTilesThreadParams() {};
+            
+            ~ComposeTilesThreadParams() {};
+        };
+        
         GeoMosaic::InputParameters m_inputParameters; //!< Input execution parameters.
         
         bool m_isInitialized; //!< Tells if this instance is initialized.
@@ -165,6 +279,25 @@ namespace te
           const double& noDataValue,
           double& mean, 
           double& variance );
+          
+        /*!
+          \brief Compose all input rasters into the given output raster in one tiled pass.
+          \param outputRaster The output mosaic raster (all bands must share the same blocking scheme).
+          \param outputBandsRangeMin The output bands allowed minimum values.
+          \param outputBandsRangeMax The output bands allowed maximum values.
+          \param progressPtr A pointer to the progress interface or null if no progress should be used.
+          \return true if ok, false on errors.
+        */
+        bool executeTiledComposition( te::rst::Raster& outputRaster,
+          const std::vector< double >& outputBandsRangeMin,
+          const std::vector< double >& outputBandsRangeMax,
+          te::common::TaskProgress* progressPtr );
+          
+        /*!
+          \brief Output tiles composition thread entry.
+          \param paramsPtr A pointer to the thread parameters.
+        */
+        static void composeTilesThreadEntry( ComposeTilesThreadParams* paramsPtr );
 
     };
 
@@ -33,7 +33,11 @@
 #include "../geometry/Envelope.h"
 #include "../common/progress/TaskProgress.h"
 
+#include <boost/bind.hpp>
+
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <limits>
 
 #ifndef M_PI
@@ -73,6 +77,7 @@ namespace te
       m_interpMethod = te::rst::NearestNeighbor;
       m_RGBMin = 0.0;
       m_RGBMax = 0.0;
+      m_enableMultiThread = true;
     }
 
     const IHSFusion::InputParameters& IHSFusion::InputParameters::operator=(
@@ -90,6 +95,7 @@ namespace te
       m_interpMethod = params.m_interpMethod;
       m_RGBMin = params.m_RGBMin;
       m_RGBMax = params.m_RGBMax;
+      m_enableMultiThread = params.m_enableMultiThread;
 
       return *this;
     }
@@ -163,7 +169,7 @@ namespace te
       {
         progressPtr.reset( new te::common::TaskProgress );
         
-        progressPtr->setTotalSteps( 4 );
+        progressPtr->setTotalSteps( 3 );
         
         progressPtr->setMessage( "Fusing images" );
       }        
@@ -181,45 +187,30 @@ namespace te
         if( ! progressPtr->isActive() ) return false;
       }  
       
-      // Loading IHS data    
+      // Getting the intensity and high resolution image statistics
       
-      te::rp::Matrix< float > intensityData;
-      intensityData.reset( te::rp::Matrix< float >::AutoMemPol );
-      te::rp::Matrix< float > hueData;
-      hueData.reset( te::rp::Matrix< float >::AutoMemPol );
-      te::rp::Matrix< float > saturationData;
-      saturationData.reset( te::rp::Matrix< float >::AutoMemPol );
+      double intensityMean = 0.0;
+      double intensityVariance = 0.0;
+      double rasterMean = 0.0;
+      double rasterVariance = 0.0;
       
-      TERP_TRUE_OR_RETURN_FALSE( loadIHSData( rgbMin, rgbMax, intensityData,
-        hueData, saturationData ), "Error loading IHS data" );
+      TERP_TRUE_OR_RETURN_FALSE( getStatistics( rgbMin, rgbMax, intensityMean,
+        intensityVariance, rasterMean, rasterVariance ),
+        "IHS statistics error" );
         
       if( m_inputParameters.m_enableProgress )
       {
         progressPtr->pulse();
         if( ! progressPtr->isActive() ) return false;
       }          
-        
-//       CreateRasterFileFromMatrix( intensityData, true, "intensityData.tif" );
-//       CreateRasterFileFromMatrix( hueData, true, "hueData.tif" );  
-//       CreateRasterFileFromMatrix( saturationData, true, "saturationData.tif" );
-      
-      // Swapping Itensity
-      
-      TERP_TRUE_OR_RETURN_FALSE( swapIntensity( intensityData ),
-        "Intensity channel swap error" );
-        
-//       CreateRasterFileFromMatrix( intensityData, true, "swappedintensityData.tif" );
       
-      if( m_inputParameters.m_enableProgress )
-      {
-        progressPtr->pulse();
-        if( ! progressPtr->isActive() ) return false;
-      }        
+      // Saving RGB data with the swapped intensity
       
-      // Saving RGB data
+      const double gain = ( ( rasterVariance == 0.0 ) ? 0.0 :
+        std::sqrt( intensityVariance ) / std::sqrt( rasterVariance ) );
       
-      TERP_TRUE_OR_RETURN_FALSE( saveIHSData( rgbMin, rgbMax, intensityData,
-        hueData, saturationData, outParamsPtr->m_rType, outParamsPtr->m_rInfo,
+      TERP_TRUE_OR_RETURN_FALSE( saveIHSData( rgbMin, rgbMax, gain, rasterMean,
+        intensityMean, outParamsPtr->m_rType, outParamsPtr->m_rInfo,
         outParamsPtr->m_outputRasterPtr),
         "RGB raster creation error" );
 
@@ -305,49 +296,23 @@ namespace te
       if( ( m_inputParameters.m_RGBMax == 0.0 ) && 
         ( m_inputParameters.m_RGBMin == 0.0 ) )
       {
+        BlockProcessor processor;
+        processor.addInputRaster( *m_inputParameters.m_lowResRasterPtr );
+        processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
         
-        const unsigned int nCols = m_inputParameters.m_lowResRasterPtr->getNumberOfColumns();
-        const unsigned int nRows = m_inputParameters.m_lowResRasterPtr->getNumberOfRows();
-        const te::rst::Band& redBand = *( m_inputParameters.m_lowResRasterPtr->getBand(
-          m_inputParameters.m_lowResRasterRedBandIndex ) );
-        const te::rst::Band& greenBand = *( m_inputParameters.m_lowResRasterPtr->getBand(
-          m_inputParameters.m_lowResRasterGreenBandIndex ) );
-        const te::rst::Band& blueBand = *( m_inputParameters.m_lowResRasterPtr->getBand(
-          m_inputParameters.m_lowResRasterBlueBandIndex ) );
-        const double redNoData = redBand.getProperty()->m_noDataValue;
-        const double greenNoData = greenBand.getProperty()->m_noDataValue;
-        const double blueNoData = blueBand.getProperty()->m_noDataValue;
-        
-        rgbMin = std::numeric_limits<double>::max();
-        rgbMax = -1.0 * std::numeric_limits<double>::max();
-
-        unsigned int row = 0;
-        unsigned int col = 0;
-        double redValue = 0;
-        double greenValue = 0;
-        double blueValue = 0;
+        std::vector< double > rgbMins( processor.getThreadsNumber(),
+          std::numeric_limits<double>::max() );
+        std::vector< double > rgbMaxs( processor.getThreadsNumber(),
+          -1.0 * std::numeric_limits<double>::max() );
         
-        for( row = 0 ; row < nRows ; ++row )
+        if( ! processor.execute( boost::bind( &IHSFusion::getRGBRangeBlock, this,
+          boost::ref( rgbMins ), boost::ref( rgbMaxs ), _1, _2 ) ) )
         {
-          for( col = 0 ; col < nCols ; ++col )
-          {
-            redBand.getValue( col, row, redValue );
-            greenBand.getValue( col, row, greenValue );
-            blueBand.getValue( col, row, blueValue );
-            
-            if( ( redValue != redNoData ) && ( greenValue != greenNoData ) &&
-              ( blueValue != blueNoData ) )
-            {
-              if( redValue > rgbMax ) rgbMax = redValue;
-              if( greenValue > rgbMax ) rgbMax = greenValue;
-              if( blueValue > rgbMax ) rgbMax = blueValue;
-              
-              if( redValue < rgbMin ) rgbMin = redValue;
-              if( greenValue < rgbMin ) rgbMin = greenValue;
-              if( blueValue < rgbMin ) rgbMin = blueValue;
-            }
-          }
+          return false;
         }
+        
+        rgbMin = *std::min_element( rgbMins.begin(), rgbMins.end() );
+        rgbMax = *std::max_element( rgbMaxs.begin(), rgbMaxs.end() );
       }
       else
       {
@@ -358,263 +323,246 @@ namespace te
       return true;
     }
     
-    bool IHSFusion::loadIHSData( const double& rgbMin, const double rgbMax,
-      te::rp::Matrix< float >& intensityData,
-      te::rp::Matrix< float >& hueData, te::rp::Matrix< float >& saturationData ) const
+    bool IHSFusion::getRGBRangeBlock( std::vector< double >& rgbMins,
+      std::vector< double >& rgbMaxs, const BlockWindow& window,
+      BlockContext& context ) const
     {
-      const unsigned int outNCols = m_inputParameters.m_highResRasterPtr->getNumberOfColumns();
-      const unsigned int outNRows = m_inputParameters.m_highResRasterPtr->getNumberOfRows();
-      const double colsRescaleFactor =
-        ((double)m_inputParameters.m_lowResRasterPtr->getNumberOfColumns()) /
-        ((double)outNCols);
-      const double rowsRescaleFactor =
-        ((double)m_inputParameters.m_lowResRasterPtr->getNumberOfRows()) /
-        ((double)outNRows);
-      const unsigned int redBandIdx = m_inputParameters.m_lowResRasterRedBandIndex;
-      const unsigned int greenBandIdx = m_inputParameters.m_lowResRasterGreenBandIndex;
-      const unsigned int blueBandIdx = m_inputParameters.m_lowResRasterBlueBandIndex;
-      const double redNoData = m_inputParameters.m_lowResRasterPtr->getBand( 
-        redBandIdx )->getProperty()->m_noDataValue;
-      const double greenNoData = m_inputParameters.m_lowResRasterPtr->getBand( 
-        greenBandIdx )->getProperty()->m_noDataValue;
-      const double blueNoData = m_inputParameters.m_lowResRasterPtr->getBand( 
-        blueBandIdx )->getProperty()->m_noDataValue;
-        
-      if( ! intensityData.reset( outNRows, outNCols ) ) return false;
-      if( ! hueData.reset( outNRows, outNCols ) ) return false;
-      if( ! saturationData.reset( outNRows, outNCols ) ) return false;
-      
-      te::rst::Interpolator interpol( m_inputParameters.m_lowResRasterPtr,
-        m_inputParameters.m_interpMethod );
-      unsigned int outRow = 0;
-      unsigned int outCol = 0;
-      double inRow = 0;
-      double inCol = 0;
-      std::complex< double > redC = 0;
-      std::complex< double > greenC = 0;
-      std::complex< double > blueC = 0;
-      float* intensityRow = 0;
-      float* hueRow = 0;
-      float* saturationRow = 0;
-      
-      double teta = 0;
-      double redNorm = 0, greenNorm = 0, blueNorm = 0;
-      double rMinusG = 0, rMinusB = 0;
-      double rgbSum = 0;
-      double cosValue = 0;
-      const double twoPi = 2.0 * ((double)M_PI);
-      const double pi2 = ((double)M_PI) / 2.0;   
-      const double rgbNormFac = ( rgbMax == rgbMin ) ? 0.0 :
-        ( 1.0 / ( rgbMax - rgbMin ) );
+      const te::rst::Raster& lowResRaster = context.getInputRaster( 0 );
+      const te::rst::Band& redBand = *( lowResRaster.getBand(
+        m_inputParameters.m_lowResRasterRedBandIndex ) );
+      const te::rst::Band& greenBand = *( lowResRaster.getBand(
+        m_inputParameters.m_lowResRasterGreenBandIndex ) );
+      const te::rst::Band& blueBand = *( lowResRaster.getBand(
+        m_inputParameters.m_lowResRasterBlueBandIndex ) );
+      const double redNoData = redBand.getProperty()->m_noDataValue;
+      const double greenNoData = greenBand.getProperty()->m_noDataValue;
+      const double blueNoData = blueBand.getProperty()->m_noDataValue;
+      
+      double rgbMin = rgbMins[ context.getThreadIndex() ];
+      double rgbMax = rgbMaxs[ context.getThreadIndex() ];
+
+      unsigned int row = 0;
+      unsigned int col = 0;
+      double redValue = 0;
+      double greenValue = 0;
+      double blueValue = 0;
       
-      for( outRow = 0 ; outRow < outNRows ; ++outRow )
+      for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
       {
-        inRow = ((double)outRow) * rowsRescaleFactor;
-        intensityRow = intensityData[ outRow ];
-        hueRow = hueData[ outRow ];
-        saturationRow = saturationData[ outRow ];
-        
-        for( outCol = 0 ; outCol < outNCols ; ++outCol )
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
         {
-          inCol = ((double)outCol) * colsRescaleFactor;
-          
-          interpol.getValue( inCol, inRow, redC, redBandIdx );
-          interpol.getValue( inCol, inRow, greenC, greenBandIdx );
-          interpol.getValue( inCol, inRow, blueC, blueBandIdx );
+          redBand.getValue( col, row, redValue );
+          greenBand.getValue( col, row, greenValue );
+          blueBand.getValue( col, row, blueValue );
           
-          if( ( redC.real() == redNoData ) || ( greenC.real() == greenNoData ) ||
-            ( blueC.real() == blueNoData ) )
+          if( ( redValue != redNoData ) && ( greenValue != greenNoData ) &&
+            ( blueValue != blueNoData ) )
           {
-            intensityRow[ outCol ] = 0.0;
-            hueRow[ outCol ] = 0.0;
-            saturationRow[ outCol ] = 0.0;
-          }            
-          else
-          {
-            if( ( redC.real() == greenC.real() ) && ( greenC.real() == blueC.real() ) ) 
-            { // Gray scale case
-              // From Wikipedia:
-              // h = 0 is used for grays though the hue has no geometric 
-              // meaning there, where the saturation s = 0. Similarly, 
-              // the choice of 0 as the value for s when l is equal to 0 or 1 
-              // is arbitrary.        
-              
-              hueRow[ outCol ] = 0.0;
-              saturationRow[ outCol ] = 0.0;
-              intensityRow[ outCol ] = (float)( redC.real() * rgbNormFac ); // or green or blue since they all are the same.
-            }
-            else
-            { // Color case
-              redNorm = ( redC.real() - rgbMin ) * rgbNormFac;
-              greenNorm = ( greenC.real() - rgbMin ) * rgbNormFac;
-              blueNorm = ( blueC.real() - rgbMin ) * rgbNormFac;
-              
-              rMinusG = redNorm - greenNorm;
-              rMinusB = redNorm - blueNorm;
-              
-              cosValue = sqrt( ( rMinusG * rMinusG ) + ( rMinusB * 
-                ( greenNorm - blueNorm ) ) );
-                
-              if( cosValue == 0.0 )
-              {
-                teta = pi2;
-              }
-              else
-              {
-                cosValue =  ( 0.5 * ( rMinusG + rMinusB )  ) /
-                  cosValue;
-                teta = std::acos( cosValue );  
-              }
-                
-              assert( ( cosValue >= (-1.0) ) && ( cosValue <= (1.0) ) );
-                
-              if( blueNorm > greenNorm )
-              {
-                hueRow[ outCol ] = (float)( twoPi - teta );
-              }
-              else
-              {
-                hueRow[ outCol ] = (float)teta;
-              }
-                
-              rgbSum = ( redNorm + greenNorm + blueNorm );
-              
-              saturationRow[ outCol ] = (float)( 1.0 - ( 3 * std::min( std::min( redNorm, greenNorm ), blueNorm ) /
-                rgbSum ) );
-                
-              intensityRow[ outCol ] = (float)( rgbSum / 3.0 );            
-            }
+            if( redValue > rgbMax ) rgbMax = redValue;
+            if( greenValue > rgbMax ) rgbMax = greenValue;
+            if( blueValue > rgbMax ) rgbMax = blueValue;
+            
+            if( redValue < rgbMin ) rgbMin = redValue;
+            if( greenValue < rgbMin ) rgbMin = greenValue;
+            if( blueValue < rgbMin ) rgbMin = blueValue;
           }
         }
       }
+      
+      rgbMins[ context.getThreadIndex() ] = rgbMin;
+      rgbMaxs[ context.getThreadIndex() ] = rgbMax;
         
       return true;
     }
     
-    bool IHSFusion::getStatistics( const te::rp::Matrix< float >& matrix, float& mean, 
-      float& variance ) const
+    bool IHSFusion::getStatistics( const double& rgbMin, const double rgbMax,
+      double& intensityMean, double& intensityVariance, double& rasterMean,
+      double& rasterVariance ) const
     {
-      const unsigned int nRows = matrix.getLinesNumber();
-      const unsigned int nCols = matrix.getColumnsNumber();
+      const double nPixels = ((double)m_inputParameters.m_highResRasterPtr->getNumberOfRows()) *
+        ((double)m_inputParameters.m_highResRasterPtr->getNumberOfColumns());
       
-      if( ( nRows == 0 ) || ( nCols == 0 ) ) return false;
+      if( nPixels == 0.0 ) return false;
       
-      unsigned int col = 0;
-      unsigned int row = 0;
-      float const * rowPtr = 0;
+      // The windows are defined by the high resolution raster (the first input)
+      
+      BlockProcessor processor;
+      processor.addInputRaster( *m_inputParameters.m_highResRasterPtr );
+      processor.addInputRaster( *m_inputParameters.m_lowResRasterPtr );
+      processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
       
-      mean = 0.0;
+      std::vector< double > sums( 4 * processor.getThreadsNumber(), 0.0 );
       
-      for( row = 0 ; row < nRows ; ++row )
+      if( ! processor.execute( boost::bind( &IHSFusion::getStatisticsBlock, this,
+        rgbMin, rgbMax, boost::ref( sums ), _1, _2 ) ) )
       {
-        rowPtr = matrix[ row ];
-        
-        for( col = 0 ; col < nCols ; ++col )
-        {
-          mean += rowPtr[ col ];
-        }
+        return false;
       }
       
-      mean /= (float)( nCols * nRows );
+      double intensitySum = 0.0;
+      double intensitySquaresSum = 0.0;
+      double rasterSum = 0.0;
+      double rasterSquaresSum = 0.0;
       
-      float diff = 0.0;
-      variance = 0.0;
-      
-      for( row = 0 ; row < nRows ; ++row )
+      for( unsigned int sumsIdx = 0 ; sumsIdx < sums.size() ; sumsIdx += 4 )
       {
-        rowPtr = matrix[ row ];
-        
-        for( col = 0 ; col < nCols ; ++col )
-        {
-          diff = rowPtr[ col ] - mean;
-          variance += ( diff * diff );
-        }
+        intensitySum += sums[ sumsIdx ];
+        intensitySquaresSum += sums[ sumsIdx + 1 ];
+        rasterSum += sums[ sumsIdx + 2 ];
+        rasterSquaresSum += sums[ sumsIdx + 3 ];
       }
       
+      intensityMean = intensitySum / nPixels;
+      intensityVariance = std::max( 0.0, intensitySquaresSum - ( intensitySum * intensityMean ) );
+      rasterMean = rasterSum / nPixels;
+      rasterVariance = std::max( 0.0, rasterSquaresSum - ( rasterSum * rasterMean ) );
+      
       return true;
     }
     
-    bool IHSFusion::swapIntensity( te::rp::Matrix< float >& intensityData )
+    bool IHSFusion::getStatisticsBlock( const double rgbMin, const double rgbMax,
+      std::vector< double >& sums, const BlockWindow& window,
+      BlockContext& context ) const
     {
-      const unsigned int nRows = intensityData.getLinesNumber();
-      const unsigned int nCols = intensityData.getColumnsNumber();
-      
-      if( ( nRows == 0 ) || ( nCols == 0 ) ) return false;
-      
-      assert( nRows == m_inputParameters.m_highResRasterPtr->getNumberOfRows() );
-      assert( nCols == m_inputParameters.m_highResRasterPtr->getNumberOfColumns() );
-      
-      // intensity statistics
-      
-      float intensityMean = 0.0;
-      float intensityVariance = 0.0;
-      getStatistics( intensityData, intensityMean, intensityVariance );     
-      
-      // high resolution raster statistics
-      
-      double rasterMean = 0;
-      double rasterVariance = 0;
-      
-      unsigned int col = 0;
-      unsigned int row = 0;
-      double value = 0;
-      const te::rst::Band& band = *( m_inputParameters.m_highResRasterPtr->getBand(
+      const te::rst::Band& highResBand = *( context.getInputRaster( 0 ).getBand(
         m_inputParameters.m_highResRasterBand ) );
-      double diff = 0;
+      te::rst::Interpolator interpol( &context.getInputRaster( 1 ),
+        m_inputParameters.m_interpMethod );
+      const double colsRescaleFactor =
+        ((double)m_inputParameters.m_lowResRasterPtr->getNumberOfColumns()) /
+        ((double)m_inputParameters.m_highResRasterPtr->getNumberOfColumns());
+      const double rowsRescaleFactor =
+        ((double)m_inputParameters.m_lowResRasterPtr->getNumberOfRows()) /
+        ((double)m_inputParameters.m_highResRasterPtr->getNumberOfRows());
+      const double rgbNormFac = ( rgbMax == rgbMin ) ? 0.0 :
+        ( 1.0 / ( rgbMax - rgbMin ) );
       
-      for( row = 0 ; row < nRows ; ++row )
+      unsigned int outRow = 0;
+      unsigned int outCol = 0;
+      double inRow = 0;
+      double value = 0;
+      float intensity = 0;
+      float hue = 0;
+      float saturation = 0;
+      double intensitySum = 0.0;
+      double intensitySquaresSum = 0.0;
+      double rasterSum = 0.0;
+      double rasterSquaresSum = 0.0;
+      
+      for( outRow = window.m_firstRow ; outRow < window.m_rowsBound ; ++outRow )
       {
-        for( col = 0 ; col < nCols ; ++col )
+        inRow = ((double)outRow) * rowsRescaleFactor;
+        
+        for( outCol = window.m_firstCol ; outCol < window.m_colsBound ; ++outCol )
         {
-          band.getValue( col, row, value );
-          rasterMean += value;
+          getIHSValue( interpol, inRow, ((double)outCol) * colsRescaleFactor,
+            rgbMin, rgbNormFac, intensity, hue, saturation );
+          
+          intensitySum += intensity;
+          intensitySquaresSum += ( ((double)intensity) * ((double)intensity) );
+          
+          highResBand.getValue( outCol, outRow, value );
+          
+          rasterSum += value;
+          rasterSquaresSum += ( value * value );
         }
       }
       
-      rasterMean /= (double)( nCols * nRows );
-
-      for( row = 0 ; row < nRows ; ++row )
-      {
-        for( col = 0 ; col < nCols ; ++col )
-        {
-          band.getValue( col, row, value );
-          diff = value - rasterMean;
-          rasterVariance += ( diff * diff );
-        }
-      }
+      double* threadSums = &sums[ 4 * context.getThreadIndex() ];
+      threadSums[ 0 ] += intensitySum;
+      threadSums[ 1 ] += intensitySquaresSum;
+      threadSums[ 2 ] += rasterSum;
+      threadSums[ 3 ] += rasterSquaresSum;
       
-      const double gain = ( ( rasterVariance == 0.0 ) ? 0.0 :
-        std::sqrt( (double)intensityVariance ) / std::sqrt( rasterVariance ) );
-      float* intensityRow = 0;
+      return true;
+    }
+    
+    void IHSFusion::getIHSValue( te::rst::Interpolator& interpol, const double& inRow,
+      const double& inCol, const double& rgbMin, const double& rgbNormFac,
+      float& intensity, float& hue, float& saturation ) const
+    {
+      std::complex< double > redC = 0;
+      std::complex< double > greenC = 0;
+      std::complex< double > blueC = 0;
+      
+      interpol.getValue( inCol, inRow, redC, m_inputParameters.m_lowResRasterRedBandIndex );
+      interpol.getValue( inCol, inRow, greenC, m_inputParameters.m_lowResRasterGreenBandIndex );
+      interpol.getValue( inCol, inRow, blueC, m_inputParameters.m_lowResRasterBlueBandIndex );
       
-      for( row = 0 ; row < nRows ; ++row )
+      if( ( redC.real() == m_inputParameters.m_lowResRasterPtr->getBand( 
+          m_inputParameters.m_lowResRasterRedBandIndex )->getProperty()->m_noDataValue ) || 
+        ( greenC.real() == m_inputParameters.m_lowResRasterPtr->getBand( 
+          m_inputParameters.m_lowResRasterGreenBandIndex )->getProperty()->m_noDataValue ) ||
+        ( blueC.real() == m_inputParameters.m_lowResRasterPtr->getBand( 
+          m_inputParameters.m_lowResRasterBlueBandIndex )->getProperty()->m_noDataValue ) )
       {
-        intensityRow = intensityData[ row ];
+        intensity = 0.0;
+        hue = 0.0;
+        saturation = 0.0;
+      }            
+      else if( ( redC.real() == greenC.real() ) && ( greenC.real() == blueC.real() ) ) 
+      { // Gray scale case
+        // From Wikipedia:
+        // h = 0 is used for grays though the hue has no geometric 
+        // meaning there, where the saturation s = 0. Similarly, 
+        // the choice of 0 as the value for s when l is equal to 0 or 1 
+        // is arbitrary.        
         
-        for( col = 0 ; col < nCols ; ++col )
+        hue = 0.0;
+        saturation = 0.0;
+        intensity = (float)( redC.real() * rgbNormFac ); // or green or blue since they all are the same.
+      }
+      else
+      { // Color case
+        const double redNorm = ( redC.real() - rgbMin ) * rgbNormFac;
+        const double greenNorm = ( greenC.real() - rgbMin ) * rgbNormFac;
+        const double blueNorm = ( blueC.real() - rgbMin ) * rgbNormFac;
+        
+        const double rMinusG = redNorm - greenNorm;
+        const double rMinusB = redNorm - blueNorm;
+        
+        double cosValue = sqrt( ( rMinusG * rMinusG ) + ( rMinusB * 
+          ( greenNorm - blueNorm ) ) );
+        double teta = 0;
+          
+        if( cosValue == 0.0 )
         {
-          band.getValue( col, row, value );
-          intensityRow[ col ] = (float)std::min( 1.0, std::max( 0.0, ( ( value - rasterMean ) * gain ) + ((double)intensityMean) ) );
+          teta = ((double)M_PI) / 2.0;
         }
-      }      
-      
-      return true;
+        else
+        {
+          cosValue =  ( 0.5 * ( rMinusG + rMinusB )  ) /
+            cosValue;
+          teta = std::acos( cosValue );  
+        }
+          
+        assert( ( cosValue >= (-1.0) ) && ( cosValue <= (1.0) ) );
+          
+        if( blueNorm > greenNorm )
+        {
+          hue = (float)( ( 2.0 * ((double)M_PI) ) - teta );
+        }
+        else
+        {
+          hue = (float)teta;
+        }
+          
+        const double rgbSum = ( redNorm + greenNorm + blueNorm );
+        
+        saturation = (float)( 1.0 - ( 3 * std::min( std::min( redNorm, greenNorm ), blueNorm ) /
+          rgbSum ) );
+          
+        intensity = (float)( rgbSum / 3.0 );            
+      }
     }
     
-    bool IHSFusion::saveIHSData( const double& rgbMin, const double rgbMax, const te::rp::Matrix< float >& intensityData,
-      const te::rp::Matrix< float >& hueData, const te::rp::Matrix< float >& saturationData,
+    bool IHSFusion::saveIHSData( const double& rgbMin, const double rgbMax,
+      const double gain, const double rasterMean, const double intensityMean,
       const std::string& rType, const std::map< std::string, std::string >& rInfo,
       std::auto_ptr< te::rst::Raster >& outputRasterPtr ) const
     {
-      assert( intensityData.getColumnsNumber() == m_inputParameters.m_highResRasterPtr->getNumberOfColumns() );
-      assert( intensityData.getLinesNumber() == m_inputParameters.m_highResRasterPtr->getNumberOfRows() );
-      assert( intensityData.getColumnsNumber() == hueData.getColumnsNumber() );
-      assert( intensityData.getColumnsNumber() == saturationData.getColumnsNumber() );
-      assert( intensityData.getLinesNumber() == hueData.getLinesNumber() );
-      assert( intensityData.getLinesNumber() == saturationData.getLinesNumber() );      
-      
-      const unsigned int nRows = intensityData.getLinesNumber();
-      const unsigned int nCols = intensityData.getColumnsNumber();
+      const unsigned int nRows = m_inputParameters.m_highResRasterPtr->getNumberOfRows();
+      const unsigned int nCols = m_inputParameters.m_highResRasterPtr->getNumberOfColumns();
       
       std::vector< te::rst::BandProperty* > outRasterBandsProperties;
       outRasterBandsProperties.push_back( new te::rst::BandProperty(
@@ -652,6 +600,32 @@ namespace te
       TERP_TRUE_OR_RETURN_FALSE( outputRasterPtr.get(),
         "Output raster creation error" );  
         
+      BlockProcessor processor;
+      processor.setOutputRaster( *outputRasterPtr );
+      processor.addInputRaster( *m_inputParameters.m_highResRasterPtr );
+      processor.addInputRaster( *m_inputParameters.m_lowResRasterPtr );
+      processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
+      
+      return processor.execute( boost::bind( &IHSFusion::saveIHSBlock, this,
+        rgbMin, rgbMax, gain, rasterMean, intensityMean, _1, _2 ) );
+    }
+    
+    bool IHSFusion::saveIHSBlock( const double rgbMin, const double rgbMax,
+      const double gain, const double rasterMean, const double intensityMean,
+      const BlockWindow& window, BlockContext& context ) const
+    {
+      const te::rst::Band& highResBand = *( context.getInputRaster( 0 ).getBand(
+        m_inputParameters.m_highResRasterBand ) );
+      te::rst::Interpolator interpol( &context.getInputRaster( 1 ),
+        m_inputParameters.m_interpMethod );
+      const double colsRescaleFactor =
+        ((double)m_inputParameters.m_lowResRasterPtr->getNumberOfColumns()) /
+        ((double)m_inputParameters.m_highResRasterPtr->getNumberOfColumns());
+      const double rowsRescaleFactor =
+        ((double)m_inputParameters.m_lowResRasterPtr->getNumberOfRows()) /
+        ((double)m_inputParameters.m_highResRasterPtr->getNumberOfRows());
+      const double rgbLoadNormFac = ( rgbMax == rgbMin ) ? 0.0 :
+        ( 1.0 / ( rgbMax - rgbMin ) );
       const double rgbNormFac = ( rgbMax == rgbMin ) ? 0.0 :
         ( rgbMax - rgbMin ); 
       const double pi3 = M_PI / 3.0; // 60
@@ -659,23 +633,38 @@ namespace te
       const double fourPi3 = 4.0 * M_PI / 3.0; // 240        
       unsigned int row = 0;
       unsigned int col = 0;  
+      double inRow = 0;
+      double value = 0;
+      float intensity = 0;
+      float hueValue = 0;
+      float saturation = 0;
       double hue = 0;
       double lig = 0;
       double sat = 0;
       double red = 0;
       double green = 0;
       double blue = 0;  
-      te::rst::Band& redBand = *outputRasterPtr->getBand( 0 );
-      te::rst::Band& greenBand = *outputRasterPtr->getBand( 1 );
-      te::rst::Band& blueBand = *outputRasterPtr->getBand( 2 );
+      te::rst::Band& redBand = *context.getOutputRaster().getBand( 0 );
+      te::rst::Band& greenBand = *context.getOutputRaster().getBand( 1 );
+      te::rst::Band& blueBand = *context.getOutputRaster().getBand( 2 );
       
-      for( row = 0 ; row < nRows ; ++row )
+      for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
       {
-        for( col = 0 ; col < nCols ; ++col )
+        inRow = ((double)row) * rowsRescaleFactor;
+        
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
         {     
-          hue = hueData[ row ][ col ];
-          lig = intensityData[ row ][ col ];
-          sat = saturationData[ row ][ col ];
+          getIHSValue( interpol, inRow, ((double)col) * colsRescaleFactor,
+            rgbMin, rgbLoadNormFac, intensity, hueValue, saturation );
+          
+          // Swapping the intensity by the high resolution image data
+          
+          highResBand.getValue( col, row, value );
+          intensity = (float)std::min( 1.0, std::max( 0.0, ( ( value - rasterMean ) * gain ) + intensityMean ) );
+          
+          hue = hueValue;
+          lig = intensity;
+          sat = saturation;
           
           if( ( hue == 0.0 ) && ( sat == 0.0 ) )
           { // Gray scale case
@@ -26,7 +26,7 @@
 #define __TERRALIB_RP_INTERNAL_IHSFUSION_H
 
 #include "Algorithm.h"
-#include "Matrix.h"
+#include "BlockProcessor.h"
 #include "../raster/Raster.h"
 #include "../raster/Interpolator.h"
 
@@ -85,6 +85,8 @@ namespace te
             
             double m_RGBMax; //!< The used RGB maximum value (default:0 - leave zero for automatic detection based on the input images).            
             
+            bool m_enableMultiThread; //!< Enable/Disable the use of multi-threads (default:true).
+            
             InputParameters();
             
             InputParameters( const InputParameters& );
@@ -162,48 +164,91 @@ namespace te
         bool getRGBRange( double& rgbMin, double& rgbMax ) const;
         
         /*!
-          \brief Get statistics from the given matrix.
-          \param matrix Input matrix.
-          \param mean Mean value.
-          \param variance Variance value.
+          \brief Updates the RGB range with the pixels of one block window (BlockProcessor function).
+          \param rgbMins The RGB minimum value found by each thread.
+          \param rgbMaxs The RGB maximum value found by each thread.
+          \param window The block window.
+          \param context The executing thread context.
           \return true if ok, false on errors.
-         */        
-        bool getStatistics( const te::rp::Matrix< float >& matrix, float& mean, 
-          float& variance ) const;        
+         */
+        bool getRGBRangeBlock( std::vector< double >& rgbMins,
+          std::vector< double >& rgbMaxs, const BlockWindow& window,
+          BlockContext& context ) const;
         
         /*!
-          \brief Load resampled IHS data from the input image.
+          \brief Get the resampled intensity channel and the high resolution image statistics.
           \param rgbMin RGB minimum value.
           \param rgbMax RGB maximum value.
-          \param intensityData Intensity channel data.
-          \param hueData Hue channel data.
-          \param saturationData Saturation channel data.
+          \param intensityMean The intensity mean value.
+          \param intensityVariance The intensity sum of squared deviations.
+          \param rasterMean The high resolution image mean value.
+          \param rasterVariance The high resolution image sum of squared deviations.
           \return true if ok, false on errors.
-          \note IHS data with the following channels ranges: I:[0,1] H:[0,2pi] (radians) S:[0,1].
          */
-        bool loadIHSData( const double& rgbMin, const double rgbMax, te::rp::Matrix< float >& intensityData,
-          te::rp::Matrix< float >& hueData, te::rp::Matrix< float >& saturationData ) const;
-          
+        bool getStatistics( const double& rgbMin, const double rgbMax,
+          double& intensityMean, double& intensityVariance, double& rasterMean,
+          double& rasterVariance ) const;
+        
         /*!
-          \brief Swap the intensity data by the high resolution image data.
-          \param intensityData Intensity channel data.
+          \brief Accumulates the intensity and high resolution image sums of one block window (BlockProcessor function).
+          \param rgbMin RGB minimum value.
+          \param rgbMax RGB maximum value.
+          \param sums The sums of each thread (intensity, squared intensity, raster and squared raster values).
+          \param window The block window.
+          \param context The executing thread context.
           \return true if ok, false on errors.
          */
-        bool swapIntensity( te::rp::Matrix< float >& intensityData );   
+        bool getStatisticsBlock( const double rgbMin, const double rgbMax,
+          std::vector< double >& sums, const BlockWindow& window,
+          BlockContext& context ) const;
+        
+        /*!
+          \brief Get the resampled IHS data of one pixel.
+          \param interpol The low resolution image interpolator.
+          \param inRow The low resolution image row.
+          \param inCol The low resolution image column.
+          \param rgbMin RGB minimum value.
+          \param rgbNormFac RGB normalization factor.
+          \param intensity Intensity channel value.
+          \param hue Hue channel value.
+          \param saturation Saturation channel value.
+          \note IHS data with the following channels ranges: I:[0,1] H:[0,2pi] (radians) S:[0,1].
+         */
+        void getIHSValue( te::rst::Interpolator& interpol, const double& inRow,
+          const double& inCol, const double& rgbMin, const double& rgbNormFac,
+          float& intensity, float& hue, float& saturation ) const;
         
         /*!
-          \brief Save resampled IHS data as RGB data to the output image.
+          \brief Save the fused RGB data to the output image.
           \param rgbMin RGB minimum value.
           \param rgbMax RGB maximum value.
-          \param intensityData Intensity channel data.
-          \param hueData Hue channel data.
-          \param saturationData Saturation channel data.
+          \param gain The high resolution image values gain.
+          \param rasterMean The high resolution image mean value.
+          \param intensityMean The intensity mean value.
+          \param rType The output raster type.
+          \param rInfo The output raster info.
+          \param outputRasterPtr The created output raster.
           \return true if ok, false on errors.
          */
-        bool saveIHSData( const double& rgbMin, const double rgbMax, const te::rp::Matrix< float >& intensityData,
-          const te::rp::Matrix< float >& hueData, const te::rp::Matrix< float >& saturationData,
+        bool saveIHSData( const double& rgbMin, const double rgbMax,
+          const double gain, const double rasterMean, const double intensityMean,
           const std::string& rType, const std::map< std::string, std::string >& rInfo,
-          std::auto_ptr< te::rst::Raster >& outputRasterPtr ) const;        
+          std::auto_ptr< te::rst::Raster >& outputRasterPtr ) const;
+        
+        /*!
+          \brief Swaps the intensity channel and writes the RGB data of one block window (BlockProcessor function).
+          \param rgbMin RGB minimum value.
+          \param rgbMax RGB maximum value.
+          \param gain The high resolution image values gain.
+          \param rasterMean The high resolution image mean value.
+          \param intensityMean The intensity mean value.
+          \param window The block window.
+          \param context The executing thread context.
+          \return true if ok, false on errors.
+         */
+        bool saveIHSBlock( const double rgbMin, const double rgbMax,
+          const double gain, const double rasterMean, const double intensityMean,
+          const BlockWindow& window, BlockContext& context ) const;
     };
 
   } // end namespace rp
@@ -0,0 +1,488 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/rp/KDForestFeaturesIndex.cpp
+  \brief Randomized kd-trees forest index for approximate nearest neighbour features search.
+*/
+
+#include "KDForestFeaturesIndex.h"
+
+#include "Macros.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cassert>
+#include <cfloat>
+
+// Linear congruential random generator step
+#define nextRandomValue( state ) \
+  ( ( state = ( state * 1664525u ) + 1013904223u ) >> 8 )
+
+// Maximum number of node features used to estimate the dimensions variances
+#define KDFOREST_MAX_VARIANCE_SAMPLES 128
+
+// Number of highest variance dimensions where the split dimension is randomly chosen
+#define KDFOREST_SPLIT_CANDIDATE_DIMS 5
+
+namespace
+{
+  class FeatureDimLessThan
+  {
+    public :
+
+      float const* m_featuresPtr;
+
+      unsigned int m_stride;
+
+      unsigned int m_dim;
+
+      FeatureDimLessThan( float const* featuresPtr, const unsigned int stride,
+        const unsigned int dim )
+      : m_featuresPtr( featuresPtr ), m_stride( stride ), m_dim( dim ) {};
+
+      bool operator()( const unsigned int& idx1, const unsigned int& idx2 ) const
+      {
+        return ( m_featuresPtr[ ( idx1 * m_stride ) + m_dim ] <
+          m_featuresPtr[ ( idx2 * m_stride ) + m_dim ] );
+      };
+  };
+
+  class DimVarianceGreaterThan
+  {
+    public :
+
+      std::vector< double > const* m_variancesPtr;
+
+      DimVarianceGreaterThan( std::vector< double > const* variancesPtr )
+      : m_variancesPtr( variancesPtr ) {};
+
+      bool operator()( const unsigned int& dim1, const unsigned int& dim2 ) const
+      {
+        return ( (*m_variancesPtr)[ dim1 ] > (*m_variancesPtr)[ dim2 ] );
+      };
+  };
+}
+
+namespace te
+{
+  namespace rp
+  {
+    KDForestFeaturesIndex::SearchBuffers::SearchBuffers()
+    : m_stamp( 0 )
+    {
+    }
+
+    KDForestFeaturesIndex::SearchBuffers::~SearchBuffers()
+    {
+    }
+
+    KDForestFeaturesIndex::KDForestFeaturesIndex()
+    {
+      clear();
+    }
+
+    KDForestFeaturesIndex::~KDForestFeaturesIndex()
+    {
+    }
+
+    bool KDForestFeaturesIndex::initialize( const FloatsMatrix& features,
+      const std::vector< unsigned int >& featuresIndexes,
+      const unsigned int treesNumber,
+      const unsigned int leafMaxSize,
+      const unsigned int randomSeed )
+    {
+      clear();
+
+      TERP_TRUE_OR_RETURN_FALSE( features.getColumnsNumber() > 0,
+        "Invalid features dimensions number" );
+      TERP_TRUE_OR_RETURN_FALSE( treesNumber > 0, "Invalid trees number" );
+      TERP_TRUE_OR_RETURN_FALSE( leafMaxSize > 0, "Invalid leaf size" );
+
+      const unsigned int featuresLinesNumber = features.getLinesNumber();
+
+      if( featuresIndexes.empty() )
+      {
+        m_featuresOriginalIndexes.resize( featuresLinesNumber );
+
+        for( unsigned int idx = 0 ; idx < featuresLinesNumber ; ++idx )
+        {
+          m_featuresOriginalIndexes[ idx ] = idx;
+        }
+      }
+      else
+      {
+        for( unsigned int idx = 0 ; idx < featuresIndexes.size() ; ++idx )
+        {
+          TERP_TRUE_OR_RETURN_FALSE( featuresIndexes[ idx ] < featuresLinesNumber,
+            "Invalid feature index" );
+        }
+
+        m_featuresOriginalIndexes = featuresIndexes;
+      }
+
+      m_dimsNumber = features.getColumnsNumber();
+      m_stride = ( ( m_dimsNumber + 3 ) / 4 ) * 4;
+      m_featuresNumber = (unsigned int)m_featuresOriginalIndexes.size();
+      m_leafMaxSize = leafMaxSize;
+
+      // Copying the features into the contiguous padded buffer
+
+      m_features.resize( m_featuresNumber * m_stride, 0.0f );
+
+      for( unsigned int idx = 0 ; idx < m_featuresNumber ; ++idx )
+      {
+        float const* inFeatPtr = features[ m_featuresOriginalIndexes[ idx ] ];
+        float* outFeatPtr = &m_features[ idx * m_stride ];
+
+        for( unsigned int dim = 0 ; dim < m_dimsNumber ; ++dim )
+        {
+          outFeatPtr[ dim ] = inFeatPtr[ dim ];
+        }
+      }
+
+      if( m_featuresNumber == 0 ) return true;
+
+      // Building the trees
+
+      m_treesNodes.resize( treesNumber );
+      m_treesFeaturesIndexes.resize( treesNumber );
+
+      unsigned int randomState = randomSeed;
+
+      for( unsigned int treeIdx = 0 ; treeIdx < treesNumber ; ++treeIdx )
+      {
+        std::vector< unsigned int >& treeIndexes = m_treesFeaturesIndexes[ treeIdx ];
+        treeIndexes.resize( m_featuresNumber );
+
+        for( unsigned int idx = 0 ; idx < m_featuresNumber ; ++idx )
+        {
+          treeIndexes[ idx ] = idx;
+        }
+
+        for( unsigned int idx = m_featuresNumber - 1 ; idx > 0 ; --idx )
+        {
+          std::swap( treeIndexes[ idx ], treeIndexes[ nextRandomValue( randomState ) %
+            ( idx + 1 ) ] );
+        }
+
+        m_treesNodes[ treeIdx ].reserve( ( 2 * m_featuresNumber / m_leafMaxSize ) + 1 );
+
+        buildNode( treeIdx, 0, m_featuresNumber, randomState );
+      }
+
+      return true;
+    }
+
+    void KDForestFeaturesIndex::clear()
+    {
+      m_dimsNumber = 0;
+      m_stride = 0;
+      m_featuresNumber = 0;
+      m_leafMaxSize = 0;
+      m_features.clear();
+      m_featuresOriginalIndexes.clear();
+      m_treesNodes.clear();
+      m_treesFeaturesIndexes.clear();
+    }
+
+    unsigned int KDForestFeaturesIndex::getFeaturesNumber() const
+    {
+      return m_featuresNumber;
+    }
+
+    void KDForestFeaturesIndex::searchNearest( float const* featurePtr,
+      const unsigned int maxChecks,
+      SearchBuffers& buffers,
+      unsigned int& nearest1Idx, float& nearest1Dist,
+      unsigned int& nearest2Idx, float& nearest2Dist ) const
+    {
+      assert( featurePtr );
+
+      nearest1Idx = std::numeric_limits< unsigned int >::max();
+      nearest1Dist = FLT_MAX;
+      nearest2Idx = std::numeric_limits< unsigned int >::max();
+      nearest2Dist = FLT_MAX;
+
+      if( m_featuresNumber == 0 ) return;
+
+      // Preparing the search buffers
+
+      buffers.m_query.resize( m_stride );
+
+      for( unsigned int dim = 0 ; dim < m_stride ; ++dim )
+      {
+        buffers.m_query[ dim ] = ( dim < m_dimsNumber ) ? featurePtr[ dim ] : 0.0f;
+      }
+
+      if( buffers.m_checkedStamps.size() < m_featuresNumber )
+      {
+        buffers.m_checkedStamps.assign( m_featuresNumber, 0 );
+        buffers.m_stamp = 0;
+      }
+
+      ++buffers.m_stamp;
+
+      if( buffers.m_stamp == 0 )
+      {
+        std::fill( buffers.m_checkedStamps.begin(), buffers.m_checkedStamps.end(), 0 );
+        buffers.m_stamp = 1;
+      }
+
+      while( ! buffers.m_branches.empty() ) buffers.m_branches.pop();
+
+      // Searching
+
+      const unsigned int checksLimit = ( maxChecks == 0 ) ? m_featuresNumber :
+        std::min( maxChecks, m_featuresNumber );
+      unsigned int checks = 0;
+      unsigned int best1Idx = m_featuresNumber;
+      float best1Dist = FLT_MAX;
+      unsigned int best2Idx = m_featuresNumber;
+      float best2Dist = FLT_MAX;
+
+      const unsigned int treesNumber = (unsigned int)m_treesNodes.size();
+
+      for( unsigned int treeIdx = 0 ; treeIdx < treesNumber ; ++treeIdx )
+      {
+        searchBranch( treeIdx, 0, 0.0f, buffers, checks, best1Idx, best1Dist,
+          best2Idx, best2Dist );
+      }
+
+      while( ( ! buffers.m_branches.empty() ) && ( checks < checksLimit ) )
+      {
+        const SearchBuffers::BranchT branch = buffers.m_branches.top();
+        buffers.m_branches.pop();
+
+        if( branch.m_distance >= best2Dist ) break;
+
+        searchBranch( branch.m_treeIdx, branch.m_nodeIdx, branch.m_distance,
+          buffers, checks, best1Idx, best1Dist, best2Idx, best2Dist );
+      }
+
+      if( best1Idx < m_featuresNumber )
+      {
+        nearest1Idx = m_featuresOriginalIndexes[ best1Idx ];
+        nearest1Dist = std::sqrt( best1Dist );
+      }
+
+      if( best2Idx < m_featuresNumber )
+      {
+        nearest2Idx = m_featuresOriginalIndexes[ best2Idx ];
+        nearest2Dist = std::sqrt( best2Dist );
+      }
+    }
+
+    unsigned int KDForestFeaturesIndex::buildNode( const unsigned int treeIdx,
+      const unsigned int begin, const unsigned int end, unsigned int& randomState )
+    {
+      assert( end > begin );
+
+      std::vector< NodeT >& nodes = m_treesNodes[ treeIdx ];
+      std::vector< unsigned int >& indexes = m_treesFeaturesIndexes[ treeIdx ];
+
+      const unsigned int nodeIdx = (unsigned int)nodes.size();
+      nodes.push_back( NodeT() );
+
+      if( ( end - begin ) <= m_leafMaxSize )
+      {
+        nodes[ nodeIdx ].m_begin = begin;
+        nodes[ nodeIdx ].m_end = end;
+        return nodeIdx;
+      }
+
+      // Estimating each dimension mean and variance
+
+      const unsigned int samplesNumber = std::min( end - begin,
+        (unsigned int)KDFOREST_MAX_VARIANCE_SAMPLES );
+      std::vector< double > means( m_dimsNumber, 0.0 );
+      std::vector< double > variances( m_dimsNumber, 0.0 );
+      float const* featPtr = 0;
+      unsigned int dim = 0;
+      double diff = 0;
+
+      for( unsigned int sampleIdx = 0 ; sampleIdx < samplesNumber ; ++sampleIdx )
+      {
+        featPtr = &m_features[ indexes[ begin + sampleIdx ] * m_stride ];
+
+        for( dim = 0 ; dim < m_dimsNumber ; ++dim )
+        {
+          means[ dim ] += featPtr[ dim ];
+        }
+      }
+
+      for( dim = 0 ; dim < m_dimsNumber ; ++dim )
+      {
+        means[ dim ] /= (double)samplesNumber;
+      }
+
+      for( unsigned int sampleIdx = 0 ; sampleIdx < samplesNumber ; ++sampleIdx )
+      {
+        featPtr = &m_features[ indexes[ begin + sampleIdx ] * m_stride ];
+
+        for( dim = 0 ; dim < m_dimsNumber ; ++dim )
+        {
+          diff = featPtr[ dim ] - means[ dim ];
+          variances[ dim ] += diff * diff;
+        }
+      }
+
+      // Choosing the split dimension among the highest variances ones
+
+      std::vector< unsigned int > dims( m_dimsNumber );
+
+      for( dim = 0 ; dim < m_dimsNumber ; ++dim )
+      {
+        dims[ dim ] = dim;
+      }
+
+      const unsigned int candidateDimsNumber = std::min( m_dimsNumber,
+        (unsigned int)KDFOREST_SPLIT_CANDIDATE_DIMS );
+
+      std::partial_sort( dims.begin(), dims.begin() + candidateDimsNumber,
+        dims.end(), DimVarianceGreaterThan( &variances ) );
+
+      const unsigned int splitDim = dims[ nextRandomValue( randomState ) %
+        candidateDimsNumber ];
+      float splitValue = (float)means[ splitDim ];
+
+      // Partitioning the node features
+
+      unsigned int middle = begin;
+      unsigned int last = end;
+
+      while( middle < last )
+      {
+        if( m_features[ ( indexes[ middle ] * m_stride ) + splitDim ] < splitValue )
+        {
+          ++middle;
+        }
+        else
+        {
+          --last;
+          std::swap( indexes[ middle ], indexes[ last ] );
+        }
+      }
+
+      if( ( middle == begin ) || ( middle == end ) )
+      {
+        // Degenerated split - using the median
+
+        middle = begin + ( ( end - begin ) / 2 );
+
+        std::nth_element( indexes.begin() + begin, indexes.begin() + middle,
+          indexes.begin() + end, FeatureDimLessThan( &m_features[ 0 ], m_stride,
+          splitDim ) );
+
+        splitValue = m_features[ ( indexes[ middle ] * m_stride ) + splitDim ];
+      }
+
+      nodes[ nodeIdx ].m_splitDim = splitDim;
+      nodes[ nodeIdx ].m_splitValue = splitValue;
+
+      const unsigned int child1Idx = buildNode( treeIdx, begin, middle, randomState );
+      const unsigned int child2Idx = buildNode( treeIdx, middle, end, randomState );
+
+      // the nodes vector may have been reallocated
+
+      m_treesNodes[ treeIdx ][ nodeIdx ].m_child1 = child1Idx;
+      m_treesNodes[ treeIdx ][ nodeIdx ].m_child2 = child2Idx;
+
+      return nodeIdx;
+    }
+
+    void KDForestFeaturesIndex::searchBranch( const unsigned int treeIdx,
+      const unsigned int nodeIdx, const float branchDistance,
+      SearchBuffers& buffers, unsigned int& checks,
+      unsigned int& nearest1Idx, float& nearest1Dist,
+      unsigned int& nearest2Idx, float& nearest2Dist ) const
+    {
+      const std::vector< NodeT >& nodes = m_treesNodes[ treeIdx ];
+      float const* queryPtr = &buffers.m_query[ 0 ];
+      unsigned int currNodeIdx = nodeIdx;
+      float diff = 0;
+      float otherBranchDistance = 0;
+
+      // Descending to the closest leaf
+
+      while( nodes[ currNodeIdx ].m_child1 )
+      {
+        const NodeT& node = nodes[ currNodeIdx ];
+
+        diff = queryPtr[ node.m_splitDim ] - node.m_splitValue;
+        otherBranchDistance = branchDistance + ( diff * diff );
+
+        if( diff < 0.0f )
+        {
+          if( otherBranchDistance < nearest2Dist )
+          {
+            buffers.m_branches.push( SearchBuffers::BranchT( otherBranchDistance,
+              treeIdx, node.m_child2 ) );
+          }
+
+          currNodeIdx = node.m_child1;
+        }
+        else
+        {
+          if( otherBranchDistance < nearest2Dist )
+          {
+            buffers.m_branches.push( SearchBuffers::BranchT( otherBranchDistance,
+              treeIdx, node.m_child1 ) );
+          }
+
+          currNodeIdx = node.m_child2;
+        }
+      }
+
+      // Checking the leaf features
+
+      const NodeT& leaf = nodes[ currNodeIdx ];
+      const std::vector< unsigned int >& indexes = m_treesFeaturesIndexes[ treeIdx ];
+      unsigned int featureIdx = 0;
+      float dist = 0;
+
+      for( unsigned int pos = leaf.m_begin ; pos < leaf.m_end ; ++pos )
+      {
+        featureIdx = indexes[ pos ];
+
+        if( buffers.m_checkedStamps[ featureIdx ] == buffers.m_stamp ) continue;
+
+        buffers.m_checkedStamps[ featureIdx ] = buffers.m_stamp;
+        ++checks;
+
+        dist = getSquaredDistance( queryPtr, featureIdx );
+
+        if( dist < nearest1Dist )
+        {
+          nearest2Idx = nearest1Idx;
+          nearest2Dist = nearest1Dist;
+          nearest1Idx = featureIdx;
+          nearest1Dist = dist;
+        }
+        else if( dist < nearest2Dist )
+        {
+          nearest2Idx = featureIdx;
+          nearest2Dist = dist;
+        }
+      }
+    }
+
+  } // end namespace rp
+}   // end namespace te
@@ -0,0 +1,262 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/rp/KDForestFeaturesIndex.h
+  \brief Randomized kd-trees forest index for approximate nearest neighbour features search.
+ */
+
+#ifndef __TERRALIB_RP_INTERNAL_KDFORESTFEATURESINDEX_H
+#define __TERRALIB_RP_INTERNAL_KDFORESTFEATURESINDEX_H
+
+#include "Config.h"
+#include "Matrix.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <vector>
+#include <queue>
+
+namespace te
+{
+  namespace rp
+  {
+    /*!
+      \class KDForestFeaturesIndex
+      \brief Randomized kd-trees forest index for approximate nearest neighbour features search.
+      \details Features are copied into a contiguous row-major buffer padded to a multiple of 4 elements.
+      Each tree splits the node features by the mean value of a dimension randomly chosen among the ones with the highest variances.
+      Searches descend all trees and then explore the remaining branches in best-bin-first order until the given number of feature comparisons is reached.
+      \note Searches are thread-safe as long as each thread uses its own SearchBuffers instance.
+      \ingroup rp_match
+     */
+    class TERPEXPORT KDForestFeaturesIndex : public boost::noncopyable
+    {
+      public:
+
+        /*!
+          \typedef FloatsMatrix
+          \brief A matrix do store float values.
+         */
+        typedef te::rp::Matrix< float > FloatsMatrix;
+
+        /*!
+          \class SearchBuffers
+          \brief Per-thread search auxiliary buffers.
+         */
+        class TERPEXPORT SearchBuffers
+        {
+          friend class KDForestFeaturesIndex;
+
+          public :
+
+            SearchBuffers();
+
+            ~SearchBuffers();
+
+          protected :
+
+            /*! \brief A branch waiting to be explored. */
+            class BranchT
+            {
+              public :
+
+                float m_distance; //!< The branch minimum squared distance lower bound.
+
+                unsigned int m_treeIdx; //!< The branch tree index.
+
+                unsigned int m_nodeIdx; //!< The branch node index.
+
+                BranchT() : m_distance( 0 ), m_treeIdx( 0 ), m_nodeIdx( 0 ) {};
+
+                BranchT( const float distance, const unsigned int treeIdx,
+                  const unsigned int nodeIdx ) : m_distance( distance ),
+                  m_treeIdx( treeIdx ), m_nodeIdx( nodeIdx ) {};
+
+                ~BranchT() {};
+
+                bool operator<( const BranchT& other ) const
+                {
+                  return ( m_distance > other.m_distance );
+                };
+            };
+
+            std::vector< float > m_query; //!< The padded query feature.
+
+            std::vector< unsigned int > m_checkedStamps; //!< The last search stamp where each feature was compared.
+
+            unsigned int m_stamp; //!< The current search stamp.
+
+            std::priority_queue< BranchT > m_branches; //!< The branches heap (lower distances first).
+        };
+
+        KDForestFeaturesIndex();
+
+        ~KDForestFeaturesIndex();
+
+        /*!
+          \brief Build the index.
+          \param features The features matrix (one feature per line).
+          \param featuresIndexes The indexes of the features matrix lines to be indexed (an empty vector means all lines).
+          \param treesNumber The number of randomized trees.
+          \param leafMaxSize The maximum number of features inside each tree leaf.
+          \param randomSeed The seed used to choose the split dimensions.
+          \return true if OK, false on errors.
+         */
+        bool initialize( const FloatsMatrix& features,
+          const std::vector< unsigned int >& featuresIndexes,
+          const unsigned int treesNumber,
+          const unsigned int leafMaxSize,
+          const unsigned int randomSeed );
+
+        /*!
+          \brief Clear all internal allocated resources.
+         */
+        void clear();
+
+        /*!
+          \brief Returns the number of indexed features.
+          \return Returns the number of indexed features.
+         */
+        unsigned int getFeaturesNumber() const;
+
+        /*!
+          \brief Approximate search for the two nearest features.
+          \param featurePtr A pointer to the query feature (the same number of elements as the indexed ones).
+          \param maxChecks The maximum number of feature comparisons (0 - all features will be checked).
+          \param buffers The calling thread search buffers.
+          \param nearest1Idx The nearest feature index (features matrix line index) or std::numeric_limits< unsigned int >::max() if nothing was found.
+          \param nearest1Dist The nearest feature euclidean distance.
+          \param nearest2Idx The second nearest feature index (features matrix line index) or std::numeric_limits< unsigned int >::max() if nothing was found.
+          \param nearest2Dist The second nearest feature euclidean distance.
+         */
+        void searchNearest( float const* featurePtr,
+          const unsigned int maxChecks,
+          SearchBuffers& buffers,
+          unsigned int& nearest1Idx, float& nearest1Dist,
+          unsigned int& nearest2Idx, float& nearest2Dist ) const;
+
+      protected :
+
+        /*! \brief A tree node. */
+        class NodeT
+        {
+          public :
+
+            unsigned int m_splitDim; //!< The split dimension.
+
+            float m_splitValue; //!< The split value.
+
+            unsigned int m_child1; //!< The lower child node index (zero for leaf nodes).
+
+            unsigned int m_child2; //!< The higher child node index (zero for leaf nodes).
+
+            unsigned int m_begin; //!< The first leaf feature position inside the tree features indexes.
+
+            unsigned int m_end; //!< One past the last leaf feature position inside the tree features indexes.
+
+            NodeT() : m_splitDim( 0 ), m_splitValue( 0 ), m_child1( 0 ),
+              m_child2( 0 ), m_begin( 0 ), m_end( 0 ) {};
+
+            ~NodeT() {};
+        };
+
+        unsigned int m_dimsNumber; //!< The features dimensions number.
+
+        unsigned int m_stride; //!< The padded features stride (a multiple of 4).
+
+        unsigned int m_featuresNumber; //!< The number of indexed features.
+
+        unsigned int m_leafMaxSize; //!< The maximum number of features inside each leaf.
+
+        std::vector< float > m_features; //!< The contiguous padded indexed features.
+
+        std::vector< unsigned int > m_featuresOriginalIndexes; //!< The features matrix line index of each indexed feature.
+
+        std::vector< std::vector< NodeT > > m_treesNodes; //!< The nodes of each tree (the root is the first node).
+
+        std::vector< std::vector< unsigned int > > m_treesFeaturesIndexes; //!< The indexed features order inside each tree.
+
+        /*!
+          \brief Recursive node building.
+          \param treeIdx The tree index.
+          \param begin The first node feature position inside the tree features indexes.
+          \param end One past the last node feature position inside the tree features indexes.
+          \param randomState The current random generator state.
+          \return The created node index.
+         */
+        unsigned int buildNode( const unsigned int treeIdx, const unsigned int begin,
+          const unsigned int end, unsigned int& randomState );
+
+        /*!
+          \brief Descend one tree branch down to a leaf, queueing the not taken branches.
+          \param treeIdx The tree index.
+          \param nodeIdx The branch starting node index.
+          \param branchDistance The branch minimum squared distance lower bound.
+          \param buffers The calling thread search buffers.
+          \param checks The current number of feature comparisons.
+          \param nearest1Idx The current nearest indexed feature.
+          \param nearest1Dist The current nearest squared distance.
+          \param nearest2Idx The current second nearest indexed feature.
+          \param nearest2Dist The current second nearest squared distance.
+         */
+        void searchBranch( const unsigned int treeIdx, const unsigned int nodeIdx,
+          const float branchDistance, SearchBuffers& buffers, unsigned int& checks,
+          unsigned int& nearest1Idx, float& nearest1Dist,
+          unsigned int& nearest2Idx, float& nearest2Dist ) const;
+
+        /*!
+          \brief Squared euclidean distance between the padded query and one indexed feature.
+          \param queryPtr The padded query pointer.
+          \param featureIdx The indexed feature index.
+          \return The squared euclidean distance.
+         */
+        inline float getSquaredDistance( float const* queryPtr,
+          const unsigned int featureIdx ) const
+        {
+          float const* featPtr = &m_features[ featureIdx * m_stride ];
+          float d0 = 0;
+          float d1 = 0;
+          float d2 = 0;
+          float d3 = 0;
+          float diff0 = 0;
+          float diff1 = 0;
+          float diff2 = 0;
+          float diff3 = 0;
+
+          for( unsigned int col = 0 ; col < m_stride ; col += 4 )
+          {
+            diff0 = queryPtr[ col ] - featPtr[ col ];
+            diff1 = queryPtr[ col + 1 ] - featPtr[ col + 1 ];
+            diff2 = queryPtr[ col + 2 ] - featPtr[ col + 2 ];
+            diff3 = queryPtr[ col + 3 ] - featPtr[ col + 3 ];
+            d0 += diff0 * diff0;
+            d1 += diff1 * diff1;
+            d2 += diff2 * diff2;
+            d3 += diff3 * diff3;
+          }
+
+          return ( d0 + d1 ) + ( d2 + d3 );
+        };
+    };
+
+  } // end namespace rp
+}   // end namespace te
+
+#endif
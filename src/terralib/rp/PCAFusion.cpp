@@ -34,6 +34,8 @@
 #include "../common/progress/TaskProgress.h"
 #include "../memory/ExpansibleRaster.h"
 
+#include <boost/bind.hpp>
+
 #include <cmath>
 #include <limits>
   
@@ -376,20 +378,33 @@ namespace te
         TERP_LOG_AND_RETURN_FALSE( e.what() );
       }
       
+      BlockProcessor processor;
+      processor.setOutputRaster( *ressampledRasterPtr );
+      processor.addInputRaster( *m_inputParameters.m_lowResRasterPtr );
+      processor.setThreadsNumber( m_inputParameters.m_enableThreadedProcessing ? 0 : 1 );
+      
+      return processor.execute( boost::bind( &PCAFusion::loadRessampledBlock, this,
+        _1, _2 ) );
+    }
+    
+    bool PCAFusion::loadRessampledBlock( const BlockWindow& window, BlockContext& context ) const
+    {
+      te::rst::Raster& ressampledRaster = context.getOutputRaster();
       const double colsRescaleFactor =
         ((double)m_inputParameters.m_lowResRasterPtr->getNumberOfColumns()) /
-        ((double)outNCols);
+        ((double)ressampledRaster.getNumberOfColumns());
       const double rowsRescaleFactor =
         ((double)m_inputParameters.m_lowResRasterPtr->getNumberOfRows()) /
-        ((double)outNRows);
+        ((double)ressampledRaster.getNumberOfRows());
+      unsigned int lowResRasterBandsIdx = 0;
+      unsigned int lowResRasterBandIdx = 0;
       unsigned int outRow = 0;
       unsigned int outCol = 0;
       double inRow = 0;
       double inCol = 0;  
-      te::rst::Interpolator interpol( m_inputParameters.m_lowResRasterPtr,
+      te::rst::Interpolator interpol( &context.getInputRaster( 0 ),
         m_inputParameters.m_interpMethod );      
       std::complex< double > value = 0;
-      te::rst::Raster& ressampledRaster = *ressampledRasterPtr;
       double inNoDataValue = 0;
       double outNoDataValue = 0;
         
@@ -400,11 +415,11 @@ namespace te
         inNoDataValue = m_inputParameters.m_lowResRasterPtr->getBand( lowResRasterBandIdx )->getProperty()->m_noDataValue;
         outNoDataValue = ressampledRaster.getBand( lowResRasterBandsIdx )->getProperty()->m_noDataValue;
         
-        for( outRow = 0 ; outRow < outNRows ; ++outRow )
+        for( outRow = window.m_firstRow ; outRow < window.m_rowsBound ; ++outRow )
         {
           inRow = ((double)outRow) * rowsRescaleFactor;
           
-          for( outCol = 0 ; outCol < outNCols ; ++outCol )
+          for( outCol = window.m_firstCol ; outCol < window.m_colsBound ; ++outCol )
           {
             inCol = ((double)outCol) * colsRescaleFactor;
             
@@ -461,10 +476,24 @@ namespace te
       }
       
       const double gain = ( ( hrStdDev == 0.0 ) ? 0.0 : ( pcaZeroStdDev / hrStdDev ) );
+      
+      BlockProcessor processor;
+      processor.setOutputRaster( pcaRaster );
+      processor.addInputRaster( *m_inputParameters.m_highResRasterPtr );
+      processor.setThreadsNumber( m_inputParameters.m_enableThreadedProcessing ? 0 : 1 );
+      
+      return processor.execute( boost::bind( &PCAFusion::swapBandBlock, this,
+        pcaRasterBandIdx, gain, hrMean, pcaZeroMean, _1, _2 ) );
+    }
+    
+    bool PCAFusion::swapBandBlock( const unsigned int pcaRasterBandIdx, const double gain,
+      const double hrMean, const double pcaZeroMean, const BlockWindow& window,
+      BlockContext& context ) const
+    {
+      te::rst::Band& pcaBand = (*context.getOutputRaster().getBand( pcaRasterBandIdx ));
+      const te::rst::Band& hrBand = (*context.getInputRaster( 0 ).getBand( m_inputParameters.m_highResRasterBand ));
       const double& pcaNoDataValue = pcaBand.getProperty()->m_noDataValue;
       const double& hrNoDataValue = hrBand.getProperty()->m_noDataValue;
-      const unsigned int nRows = pcaRaster.getNumberOfRows();
-      const unsigned int nCols = pcaRaster.getNumberOfColumns();
       unsigned int col = 0;
       unsigned int row = 0;
       double value = 0;
@@ -473,9 +502,9 @@ namespace te
       te::rp::GetDataTypeRange( pcaBand.getProperty()->getType(), pcaAllowedMin,
         pcaAllowedMax );
       
-      for( row = 0 ; row < nRows ; ++row )
+      for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
       {
-        for( col = 0 ; col < nCols ; ++col )
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
         {
           hrBand.getValue( col, row, value );
           if( value == hrNoDataValue )
@@ -26,6 +26,7 @@
 #define __TERRALIB_RP_INTERNAL_PCAFUSION_H
 
 #include "Algorithm.h"
+#include "BlockProcessor.h"
 #include "../raster/Raster.h"
 #include "../raster/Band.h"
 #include "../raster/Interpolator.h"
@@ -148,6 +149,14 @@ namespace te
          */
         bool loadRessampledRaster( std::auto_ptr< te::rst::Raster >& ressampledRasterPtr ) const;         
         
+        /*!
+          \brief Load the resampled data of one block window (BlockProcessor function).
+          \param window The block window.
+          \param context The executing thread context.
+          \return true if ok, false on errors.
+         */
+        bool loadRessampledBlock( const BlockWindow& window, BlockContext& context ) const;
+        
         /*!
           \brief Swap the band values by the normalized high resolution raster data.
           \param pcaRaster The PCA raster.
@@ -155,6 +164,20 @@ namespace te
           \return true if ok, false on errors.
          */
         bool swapBandByHighResRaster( te::rst::Raster& pcaRaster, const unsigned int pcaRasterBandIdx );          
+        
+        /*!
+          \brief Swap the band values of one block window (BlockProcessor function).
+          \param pcaRasterBandIdx The band index where the values will be swapped.
+          \param gain The high resolution raster values gain.
+          \param hrMean The high resolution raster mean value.
+          \param pcaZeroMean The PCA band mean value.
+          \param window The block window.
+          \param context The executing thread context.
+          \return true if ok, false on errors.
+         */
+        bool swapBandBlock( const unsigned int pcaRasterBandIdx, const double gain,
+          const double hrMean, const double pcaZeroMean, const BlockWindow& window,
+          BlockContext& context ) const;
        
     };
 
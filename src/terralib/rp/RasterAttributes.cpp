@@ -33,9 +33,96 @@
 #include "../raster/Raster.h"
 #include "../raster/Utils.h"
 #include "../statistics.h"
+#include "BlockProcessor.h"
 #include "RasterAttributes.h"
 
+// Boost
+#include <boost/ref.hpp>
+
+// STL
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+/*!
+  \brief GLCM accumulation over the block windows (BlockProcessor function), one partial GLCM per thread.
+*/
+  class GLCMBlockAccumulator
+  {
+    public:
+
+      unsigned int m_band;                                              //!< The input band position.
+      int m_dx;                                                         //!< The displacement in x direction.
+      int m_dy;                                                         //!< The displacement in y direction.
+      int m_rowStart;                                                   //!< The first row with a valid neighbor.
+      int m_rowEnd;                                                     //!< The last row with a valid neighbor plus one.
+      int m_columnStart;                                                //!< The first column with a valid neighbor.
+      int m_columnEnd;                                                  //!< The last column with a valid neighbor plus one.
+      double m_minPixel;                                                //!< The minimum GL pixel value.
+      double m_maxPixel;                                                //!< The maximum GL pixel value.
+      double m_maxValueNormalization;                                   //!< The maximum normalized GL value.
+      bool m_normalize;                                                 //!< True if the GLs must be normalized.
+      double m_noDataValue;                                             //!< The band no-data value.
+      std::vector<boost::numeric::ublas::matrix<double> > m_glcms;      //!< The GLCM of each thread.
+      std::vector<double> m_counts;                                     //!< The number of accumulated pairs of each thread.
+
+      double normalizePixel(double pixel) const
+      {
+        pixel = std::round(((m_maxValueNormalization / (m_maxPixel - m_minPixel)) * (pixel - m_minPixel)));
+        if (pixel < 0)
+          pixel = 0;
+        else if (pixel > m_maxValueNormalization)
+          pixel = m_maxValueNormalization;
+
+        return pixel;
+      }
+
+      bool operator()(const te::rp::BlockWindow& window, te::rp::BlockContext& context)
+      {
+        const te::rst::Raster& rin = context.getInputRaster(0);
+        boost::numeric::ublas::matrix<double>& glcm = m_glcms[context.getThreadIndex()];
+        double& N = m_counts[context.getThreadIndex()];
+        const int row_start = std::max((int)window.m_firstRow, m_rowStart);
+        const int row_end = std::min((int)window.m_rowsBound, m_rowEnd);
+        const int column_start = std::max((int)window.m_firstCol, m_columnStart);
+        const int column_end = std::min((int)window.m_colsBound, m_columnEnd);
+        double pixel;
+        double neighborPixel;
+
+        for (int r = row_start; r < row_end; r++)
+        {
+          for (int c = column_start; c < column_end; c++)
+          {
+// get central pixel
+            rin.getValue(c, r, pixel, m_band);
+            if (pixel == m_noDataValue)
+              continue;
+
+            if (m_normalize)
+              pixel = normalizePixel(pixel);
+
+// get neighbor pixel
+            rin.getValue(c + m_dx, r + m_dy, neighborPixel, m_band);
+            if (neighborPixel == m_noDataValue)
+              continue;
+
+            if (m_normalize)
+              neighborPixel = normalizePixel(neighborPixel);
+
+// update GLCM matrix
+            glcm(pixel, neighborPixel) = glcm(pixel, neighborPixel) + 1;
+            N++;
+          }
+        }
+
+        return true;
+      }
+  };
+}
+
 te::rp::RasterAttributes::RasterAttributes()
+  : m_enableMultiThread(true)
 {
 }
 
@@ -78,6 +165,7 @@ std::vector<double> te::rp::RasterAttributes::getValuesFromBand(const te::rst::R
   assert(band < raster.getNumberOfBands());
 
   std::vector<double> values;
+  double value;
 
 // create iterators for band and polygon
   te::rst::PolygonIterator<double> it = te::rst::PolygonIterator<double>::begin(&raster, &polygon);
@@ -85,10 +173,16 @@ std::vector<double> te::rp::RasterAttributes::getValuesFromBand(const te::rst::R
 
   while (it != itend)
   {
-// using iterator
-    values.push_back((*it)[band]);
+// read the whole span of the current row
+    const unsigned int row = it.getRow();
 
-    ++it;
+    for (unsigned int col = it.getSpanStartColumn(); col <= it.getSpanEndColumn(); ++col)
+    {
+      raster.getValue(col, row, value, band);
+      values.push_back(value);
+    }
+
+    it.nextSpan();
   }
 
   return values;
@@ -419,12 +513,10 @@ boost::numeric::ublas::matrix<double> te::rp::RasterAttributes::getGLCM(const te
       throw te::common::Exception(TE_TR("GLCM can not be computed. Minimum and Maximum values are invalid."));
   }
   
-  double minValueNormalization, maxValueNormalization, matrixLimit;
+  double matrixLimit;
   bool normalize = false;
   
   if ((maxPixel - minPixel) > (gLevels - 1)) {
-    minValueNormalization = 0;
-    maxValueNormalization = gLevels - 1;
     matrixLimit = gLevels;
     normalize = true;
   } else {
@@ -434,69 +526,50 @@ boost::numeric::ublas::matrix<double> te::rp::RasterAttributes::getGLCM(const te
 
   boost::numeric::ublas::matrix<double> glcm(matrixLimit, matrixLimit);
   glcm.clear();
-  double pixel;
-  double neighborPixel;
-  double noDataValue = rin.getBand(band)->getProperty()->m_noDataValue;
   double N = 0.0;
-  
-// defining limits for iteration  
-  int row_start = 0;
-  int row_end = rin.getNumberOfRows();
-  int column_start = 0;
-  int column_end = rin.getNumberOfColumns();
-  
+
+// defining limits for iteration
+  GLCMBlockAccumulator accumulator;
+  accumulator.m_band = band;
+  accumulator.m_dx = dx;
+  accumulator.m_dy = dy;
+  accumulator.m_rowStart = 0;
+  accumulator.m_rowEnd = rin.getNumberOfRows();
+  accumulator.m_columnStart = 0;
+  accumulator.m_columnEnd = rin.getNumberOfColumns();
+  accumulator.m_minPixel = minPixel;
+  accumulator.m_maxPixel = maxPixel;
+  accumulator.m_maxValueNormalization = gLevels - 1;
+  accumulator.m_normalize = normalize;
+  accumulator.m_noDataValue = rin.getBand(band)->getProperty()->m_noDataValue;
+
   if (dy > 0)
-    row_end -= dy;
+    accumulator.m_rowEnd -= dy;
   else
-    row_start -= dy;
+    accumulator.m_rowStart -= dy;
 
   if (dx > 0)
-    column_end -= dx;
+    accumulator.m_columnEnd -= dx;
   else
-    column_start -= dx;
-  
-// computing GLCM
-  te::common::TaskProgress taskProgress("Computing the GLCM", te::common::TaskProgress::UNDEFINED, (row_end - row_start) * (column_end - column_start));
-  for (int r = row_start; r < row_end; r++)
-  {
-    for (int c = column_start; c < column_end; c++)
-    {
-      taskProgress.pulse();
-      
-// get central pixel      
-      rin.getValue(c, r, pixel, band);
-      if (pixel == noDataValue)
-        continue;
-
-      double auxPixel = pixel;
-      // normalizing between 0-maxValue
-      if (normalize) {
-          pixel = std::round((((maxValueNormalization - minValueNormalization) / (maxPixel - minPixel)) * (auxPixel - minPixel)) + minValueNormalization);
-          if (pixel < 0)
-              pixel = 0;
-          else if (pixel > maxValueNormalization)
-              pixel = maxValueNormalization;
-      }
-      
-// get neighbor pixel
-      rin.getValue(c + dx, r + dy, neighborPixel, band);
-      if (neighborPixel == noDataValue)
-        continue;
-
-      double auxNeighbor = neighborPixel;
-      // normalizing between 0-maxValue
-      if (normalize) {
-          neighborPixel = std::round((((maxValueNormalization - minValueNormalization) / (maxPixel - minPixel)) * (auxNeighbor - minPixel)) + minValueNormalization);
-          if (neighborPixel < 0)
-              neighborPixel = 0;
-          else if (neighborPixel > maxValueNormalization)
-              neighborPixel = maxValueNormalization;
-      }
+    accumulator.m_columnStart -= dx;
 
-// update GLCM matrix
-      glcm(pixel, neighborPixel) = glcm(pixel, neighborPixel) + 1;
-      N++;
-    }
+// computing GLCM, one partial matrix per thread
+  te::rp::BlockProcessor processor;
+  processor.addInputRaster(rin);
+  processor.setHalo((unsigned int)std::abs(dy), (unsigned int)std::abs(dx));
+  processor.setThreadsNumber(m_enableMultiThread ? 0 : 1);
+  processor.enableProgress("Computing the GLCM");
+
+  accumulator.m_glcms.resize(processor.getThreadsNumber(), glcm);
+  accumulator.m_counts.resize(processor.getThreadsNumber(), 0.0);
+
+  if (!processor.execute(boost::ref(accumulator)))
+    throw te::common::Exception(TE_TR("GLCM can not be computed."));
+
+  for (unsigned int i = 0; i < accumulator.m_glcms.size(); i++)
+  {
+    glcm += accumulator.m_glcms[i];
+    N += accumulator.m_counts[i];
   }
 
   if (N > 0.0)
@@ -558,4 +631,8 @@ te::rp::Texture te::rp::RasterAttributes::getGLCMMetrics(boost::numeric::ublas::
     metrics.m_energy = std::sqrt(metrics.m_energy);
 
   return metrics;
-}
\ No newline at end of file
+}
+void te::rp::RasterAttributes::setEnableMultiThread(const bool enabled)
+{
+  m_enableMultiThread = enabled;
+}
@@ -239,7 +239,17 @@ namespace te
           \return The Texture structure will all available metrics computed
         */
         te::rp::Texture getGLCMMetrics(boost::numeric::ublas::matrix<double> glcm);
-        
+
+        /*!
+          \brief Enable/Disable the use of multi-threads by getGLCM.
+
+          \param enabled True to enable the use of multi-threads (default:true).
+        */
+        void setEnableMultiThread(const bool enabled);
+
+      protected:
+
+        bool m_enableMultiThread; //!< Enable/Disable the use of multi-threads (default:true).
     };
 
   } // end namespace rp
@@ -0,0 +1,169 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/rp/ThreadPool.cpp
+  \brief A global work-stealing thread pool shared by the raster processing algorithms.
+ */
+
+#include "ThreadPool.h"
+#include "../common/PlatformUtils.h"
+
+#include <boost/bind.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <algorithm>
+
+namespace te
+{
+  namespace rp
+  {
+    namespace
+    {
+      /*! \brief The index of the worker running in the current thread (not set for the other threads). */
+      boost::thread_specific_ptr< unsigned int > WorkerIndex;
+    }
+
+    ThreadPool::ThreadPool()
+    : m_pendingTasks( 0 ), m_nextQueueIdx( 0 ), m_stop( false )
+    {
+      const unsigned int threadsNumber = std::max( 1u, te::common::GetPhysProcNumber() );
+
+      for( unsigned int workerIdx = 0 ; workerIdx < threadsNumber ; ++workerIdx )
+      {
+        m_queues.push_back( boost::shared_ptr< TasksQueue >( new TasksQueue ) );
+      }
+
+      for( unsigned int workerIdx = 0 ; workerIdx < threadsNumber ; ++workerIdx )
+      {
+        m_threads.add_thread( new boost::thread( boost::bind(
+          &ThreadPool::workerEntry, this, workerIdx ) ) );
+      }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+      {
+        boost::lock_guard< boost::mutex > lock( m_mutex );
+        m_stop = true;
+      }
+
+      m_condVar.notify_all();
+
+      m_threads.join_all();
+    }
+
+    unsigned int ThreadPool::getThreadsNumber() const
+    {
+      return (unsigned int)m_queues.size();
+    }
+
+    void ThreadPool::submit( const TaskT& task )
+    {
+      const unsigned int queueIdx = isWorkerThread() ? ( *WorkerIndex ) :
+        ( ( m_nextQueueIdx++ ) % (unsigned int)m_queues.size() );
+
+      // The task is counted before it is published, so takeTask never decrements
+      // the counter of a task not counted yet; the idle workers mutex is held until
+      // the task is queued, so a woken worker always finds it.
+
+      {
+        boost::lock_guard< boost::mutex > lock( m_mutex );
+
+        ++m_pendingTasks;
+
+        TasksQueue& queue = *m_queues[ queueIdx ];
+        boost::lock_guard< boost::mutex > queueLock( queue.m_mutex );
+        queue.m_tasks.push_back( task );
+      }
+
+      m_condVar.notify_one();
+    }
+
+    bool ThreadPool::isWorkerThread() const
+    {
+      return ( WorkerIndex.get() != 0 );
+    }
+
+    bool ThreadPool::takeTask( const unsigned int workerIdx, TaskT& task )
+    {
+      const unsigned int queuesNumber = (unsigned int)m_queues.size();
+
+      // The worker own queue first (newest task), then the other queues (oldest task)
+
+      for( unsigned int queueOffset = 0 ; queueOffset < queuesNumber ; ++queueOffset )
+      {
+        TasksQueue& queue = *m_queues[ ( workerIdx + queueOffset ) % queuesNumber ];
+        boost::lock_guard< boost::mutex > queueLock( queue.m_mutex );
+
+        if( ! queue.m_tasks.empty() )
+        {
+          if( queueOffset == 0 )
+          {
+            task = queue.m_tasks.back();
+            queue.m_tasks.pop_back();
+          }
+          else
+          {
+            task = queue.m_tasks.front();
+            queue.m_tasks.pop_front();
+          }
+
+          --m_pendingTasks;
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void ThreadPool::workerEntry( const unsigned int workerIdx )
+    {
+      WorkerIndex.reset( new unsigned int( workerIdx ) );
+
+      TaskT task;
+
+      while( true )
+      {
+        if( takeTask( workerIdx, task ) )
+        {
+          task();
+          task.clear();
+          continue;
+        }
+
+        boost::unique_lock< boost::mutex > lock( m_mutex );
+
+        while( ( m_pendingTasks == 0 ) && ( ! m_stop ) )
+        {
+          m_condVar.wait( lock );
+        }
+
+        if( m_stop && ( m_pendingTasks == 0 ) )
+        {
+          break;
+        }
+      }
+    }
+
+  } // end namespace rp
+}   // end namespace te
+
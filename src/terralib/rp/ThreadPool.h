@@ -0,0 +1,137 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/rp/ThreadPool.h
+  \brief A global work-stealing thread pool shared by the raster processing algorithms.
+ */
+
+#ifndef __TERRALIB_RP_INTERNAL_THREADPOOL_H
+#define __TERRALIB_RP_INTERNAL_THREADPOOL_H
+
+#include "Config.h"
+#include "../common/Singleton.h"
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+namespace te
+{
+  namespace rp
+  {
+    /*!
+      \class ThreadPool
+      \brief A global work-stealing thread pool shared by the raster processing algorithms.
+      \details The pool has one worker thread per physical processor, created at the first use.
+      Each worker has its own tasks queue: it takes the tasks from the back of its queue and,
+      when it is empty, steals tasks from the front of the other queues. Tasks submitted
+      by a worker (nested parallel executions) go to its own queue, the other ones are
+      distributed among the queues.
+      \note A task must not block waiting for a task submitted after it, since there may be
+      no free worker to run it (see BlockProcessor, where the submitting thread takes
+      part in the work and only waits for the tasks already started).
+      \ingroup rp_aux
+     */
+    class TERPEXPORT ThreadPool : public te::common::Singleton< ThreadPool >
+    {
+      friend class te::common::Singleton< ThreadPool >;
+
+      public :
+
+        /*! \brief Task type definition. */
+        typedef boost::function< void () > TaskT;
+
+        /*!
+          \brief Returns the number of worker threads.
+          \return Returns the number of worker threads.
+         */
+        unsigned int getThreadsNumber() const;
+
+        /*!
+          \brief Submits a task for execution by one of the workers.
+          \param task The task (it must not throw exceptions).
+         */
+        void submit( const TaskT& task );
+
+        /*!
+          \brief Returns true if the calling thread is one of the pool workers.
+          \return Returns true if the calling thread is one of the pool workers.
+         */
+        bool isWorkerThread() const;
+
+      protected :
+
+        /*!
+          \class TasksQueue
+          \brief The tasks queue of one worker.
+         */
+        class TasksQueue
+        {
+          public :
+
+            boost::mutex m_mutex; //!< The queue mutex.
+
+            std::deque< TaskT > m_tasks; //!< The queued tasks.
+        };
+
+        std::vector< boost::shared_ptr< TasksQueue > > m_queues; //!< The workers queues.
+
+        boost::thread_group m_threads; //!< The worker threads.
+
+        boost::mutex m_mutex; //!< Idle workers sync mutex.
+
+        boost::condition_variable m_condVar; //!< Idle workers sync variable.
+
+        std::atomic< unsigned int > m_pendingTasks; //!< The number of queued tasks (incremented under m_mutex before a task is queued).
+
+        std::atomic< unsigned int > m_nextQueueIdx; //!< The queue that will receive the next external task.
+
+        bool m_stop; //!< True when the workers must finish.
+
+        ThreadPool();
+
+        ~ThreadPool();
+
+        /*!
+          \brief Takes a task from the worker queue or steals one from the other queues.
+          \param workerIdx The worker index.
+          \param task The task taken.
+          \return true if a task was found, false if all queues are empty.
+         */
+        bool takeTask( const unsigned int workerIdx, TaskT& task );
+
+        /*!
+          \brief The worker threads entry.
+          \param workerIdx The worker index.
+         */
+        void workerEntry( const unsigned int workerIdx );
+    };
+
+  } // end namespace rp
+}   // end namespace te
+
+#endif  // __TERRALIB_RP_INTERNAL_THREADPOOL_H
+
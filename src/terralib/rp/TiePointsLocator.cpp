@@ -550,6 +550,24 @@ namespace te
       TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_tiePointsSubSectorsSplitFactor >= 1,
         "Invalid m_tiePointsSubSectorsSplitFactor" );  
       
+      TERP_TRUE_OR_RETURN_FALSE( 
+        ( m_inputParameters.m_featuresMatchingMethod == 
+        TiePointsLocatorInputParameters::BruteForceFeaturesMatchingMethod ) ||
+        ( m_inputParameters.m_featuresMatchingMethod == 
+        TiePointsLocatorInputParameters::KDForestFeaturesMatchingMethod ),
+        "Invalid m_featuresMatchingMethod" );
+        
+      if( m_inputParameters.m_featuresMatchingMethod == 
+        TiePointsLocatorInputParameters::KDForestFeaturesMatchingMethod )
+      {
+        TERP_TRUE_OR_RETURN_FALSE( m_inputParameters.m_kdForestTreesNumber >= 1,
+          "Invalid m_kdForestTreesNumber" );
+          
+        TERP_TRUE_OR_RETURN_FALSE( ( m_inputParameters.m_kdForestMaxDistanceRatio > 0.0 ) &&
+          ( m_inputParameters.m_kdForestMaxDistanceRatio <= 1.0 ),
+          "Invalid m_kdForestMaxDistanceRatio" );
+      }
+      
       m_isInitialized = true;
 
       return true;
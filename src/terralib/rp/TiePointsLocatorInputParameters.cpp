@@ -76,6 +76,10 @@ namespace te
       m_subSampleOptimizationMinTPNumberFactor = 2;
       m_interpMethod = te::rst::NearestNeighbor;
       m_tiePointsSubSectorsSplitFactor = 3;
+      m_featuresMatchingMethod = BruteForceFeaturesMatchingMethod;
+      m_kdForestTreesNumber = 4;
+      m_kdForestMaxChecks = 256;
+      m_kdForestMaxDistanceRatio = 0.8;
       
       m_specStratParamsPtr.reset( new te::rp::TiePointsLocatorMoravecStrategy::Parameters() );
     }
@@ -114,6 +118,10 @@ namespace te
       m_subSampleOptimizationMinTPNumberFactor = params.m_subSampleOptimizationMinTPNumberFactor;
       m_interpMethod = params.m_interpMethod;
       m_tiePointsSubSectorsSplitFactor = params.m_tiePointsSubSectorsSplitFactor;
+      m_featuresMatchingMethod = params.m_featuresMatchingMethod;
+      m_kdForestTreesNumber = params.m_kdForestTreesNumber;
+      m_kdForestMaxChecks = params.m_kdForestMaxChecks;
+      m_kdForestMaxDistanceRatio = params.m_kdForestMaxDistanceRatio;
       
       if( params.m_specStratParamsPtr.get() )
       {
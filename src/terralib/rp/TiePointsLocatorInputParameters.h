@@ -49,6 +49,14 @@ namespace te
     {
       public:
         
+        /*! \enum FeaturesMatchingMethod Interest points features matching methods. */
+        enum FeaturesMatchingMethod
+        {
+          InvalidFeaturesMatchingMethod, //!< Invalid matching method.
+          BruteForceFeaturesMatchingMethod, //!< Each raster 1 feature is compared against all raster 2 features.
+          KDForestFeaturesMatchingMethod //!< Approximate nearest neighbour search over a randomized kd-trees forest (see te::rp::KDForestFeaturesIndex).
+        };
+        
         std::string m_interesPointsLocationStrategyName; //!< The strategy used to locate interest points (default:Moravec).
         
         te::rst::Raster const* m_inRaster1Ptr; //!< Input raster 1.
@@ -107,6 +115,14 @@ namespace te
         
         unsigned int m_tiePointsSubSectorsSplitFactor; //!< The algorithm will try to generate tie-points distributed over image sectors ( Default: 3 - 3x3 sub-sectors, minimum: 1).
         
+        FeaturesMatchingMethod m_featuresMatchingMethod; //!< The interest points features matching method (default:BruteForceFeaturesMatchingMethod).
+        
+        unsigned int m_kdForestTreesNumber; //!< KDForestFeaturesMatchingMethod - The number of randomized kd-trees (default:4, minimum:1).
+        
+        unsigned int m_kdForestMaxChecks; //!< KDForestFeaturesMatchingMethod - The maximum number of feature comparisons for each search (0:Exact search, default:256).
+        
+        double m_kdForestMaxDistanceRatio; //!< KDForestFeaturesMatchingMethod - Ratio test: the maximum nearest/second nearest feature distance ratio for a match to be accepted - valid range (0,1] (1:Ratio test disabled, default:0.8).
+        
         TiePointsLocatorInputParameters();
         
         TiePointsLocatorInputParameters( const TiePointsLocatorInputParameters& );
@@ -1650,6 +1650,132 @@ namespace te
         ++it2;
       }        
       
+      // Indexed matching (when there is no transformation available to 
+      // restrict the search area)
+      
+      if( ( m_inputParameters.m_featuresMatchingMethod == 
+        TiePointsLocatorInputParameters::KDForestFeaturesMatchingMethod ) &&
+        ( raster1ToRaster2TransfPtr == 0 ) )
+      {
+        /* The correlation features are non-negative and the correlation 
+           between two features is the dot product of their unit-norm versions:
+           correlation = 1 - ( euclidean_distance^2 / 2 ). Null features
+           are placed into exclusive groups since their correlation is zero. */
+        
+        const unsigned int featureElementsNmb = featuresSet1.getColumnsNumber();
+        FloatsMatrix normFeaturesSet1;
+        FloatsMatrix normFeaturesSet2;
+        std::vector< unsigned int > featuresSet1Groups( interestPointsSet1Size, 0 );
+        std::vector< unsigned int > featuresSet2Groups( interestPointsSet2Size, 0 );
+        
+        TERP_TRUE_OR_RETURN_FALSE( normFeaturesSet1.reset( interestPointsSet1Size,
+          featureElementsNmb, FloatsMatrix::RAMMemPol ),
+          "Error crearting the normalized features matrix" );
+        TERP_TRUE_OR_RETURN_FALSE( normFeaturesSet2.reset( interestPointsSet2Size,
+          featureElementsNmb, FloatsMatrix::RAMMemPol ),
+          "Error crearting the normalized features matrix" );
+          
+        FloatsMatrix const* inFeaturesPtrs[ 2 ] = { &featuresSet1, &featuresSet2 };
+        FloatsMatrix* outFeaturesPtrs[ 2 ] = { &normFeaturesSet1, &normFeaturesSet2 };
+        std::vector< unsigned int >* groupsPtrs[ 2 ] = { &featuresSet1Groups,
+          &featuresSet2Groups };
+        float const* inFeatPtr = 0;
+        float* outFeatPtr = 0;
+        unsigned int featCol = 0;
+        float featNorm = 0;
+          
+        for( unsigned int setIdx = 0 ; setIdx < 2 ; ++setIdx )
+        {
+          const unsigned int featuresNumber = inFeaturesPtrs[ setIdx ]->getLinesNumber();
+          
+          for( unsigned int featIdx = 0 ; featIdx < featuresNumber ; ++featIdx )
+          {
+            inFeatPtr = inFeaturesPtrs[ setIdx ]->operator[]( featIdx );
+            outFeatPtr = outFeaturesPtrs[ setIdx ]->operator[]( featIdx );
+            
+            featNorm = 0;
+            for( featCol = 0 ; featCol < featureElementsNmb ; ++featCol )
+            {
+              featNorm += inFeatPtr[ featCol ] * inFeatPtr[ featCol ];
+            }
+            featNorm = std::sqrt( featNorm );
+            
+            if( featNorm == 0.0 )
+            {
+              groupsPtrs[ setIdx ]->operator[]( featIdx ) = setIdx + 1;
+              
+              for( featCol = 0 ; featCol < featureElementsNmb ; ++featCol )
+              {
+                outFeatPtr[ featCol ] = 0;
+              }              
+            }
+            else
+            {
+              for( featCol = 0 ; featCol < featureElementsNmb ; ++featCol )
+              {
+                outFeatPtr[ featCol ] = inFeatPtr[ featCol ] / featNorm;
+              }
+            }
+          }
+        }
+        
+        std::vector< unsigned int > nearestIndexes;
+        std::vector< float > nearestDistances;
+        
+        TERP_TRUE_OR_RETURN_FALSE( executeKDForestMatching( normFeaturesSet1,
+          featuresSet1Groups, normFeaturesSet2, featuresSet2Groups, m_inputParameters,
+          nearestIndexes, nearestDistances ), "Features matching error" );
+          
+        // Keeping only the most correlated set 1 feature matched to each set 2 feature
+          
+        const double moravecMinAbsCorrelation = 
+          ((Parameters*)(m_inputParameters.getSpecStrategyParams()))->m_moravecMinAbsCorrelation;
+        std::vector< float > nearestCorrelations( interestPointsSet1Size, 0.0 );
+        std::vector< float > eachColMaxValues( interestPointsSet2Size,
+          0.0 );
+        std::vector< unsigned int > eachColMaxIndexes( interestPointsSet2Size,
+          interestPointsSet1Size );
+        unsigned int col = 0;
+        unsigned int line = 0;
+          
+        for( line = 0 ; line < interestPointsSet1Size ; ++line )
+        {
+          col = nearestIndexes[ line ];
+          
+          if( col < interestPointsSet2Size )
+          {
+            nearestCorrelations[ line ] = 1.0f - ( nearestDistances[ line ] * 
+              nearestDistances[ line ] / 2.0f );
+            
+            if( ( nearestCorrelations[ line ] >= moravecMinAbsCorrelation ) &&
+              ( nearestCorrelations[ line ] > eachColMaxValues[ col ] ) )
+            {
+              eachColMaxValues[ col ] = nearestCorrelations[ line ];
+              eachColMaxIndexes[ col ] = line;
+            }
+          }
+        }
+        
+        MatchedInterestPointsT auxMatchedPoints;
+        
+        for( line = 0 ; line < interestPointsSet1Size ; ++line )
+        {
+          col = nearestIndexes[ line ];
+          
+          if( ( col < interestPointsSet2Size ) &&
+            ( eachColMaxIndexes[ col ] == line ) )
+          {
+            auxMatchedPoints.m_point1 = internalInterestPointsSet1[ line ];
+            auxMatchedPoints.m_point2 = internalInterestPointsSet2[ col ];
+            auxMatchedPoints.m_feature = nearestCorrelations[ line ];
+            
+            matchedPoints.insert( auxMatchedPoints );
+          }
+        }
+        
+        return true;
+      }
+      
       // Creating the correlation matrix
       
       FloatsMatrix corrMatrix;
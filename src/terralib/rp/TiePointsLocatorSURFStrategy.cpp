@@ -28,6 +28,8 @@
 #include "../sam/rtree.h"
 
 #include <memory>
+#include <map>
+#include <utility>
 
 #include <boost/shared_array.hpp>
 
@@ -1916,6 +1918,107 @@ namespace te
         ++it2;
       }        
       
+      // Indexed matching (when there is no transformation available to 
+      // restrict the search area)
+      
+      if( ( m_inputParameters.m_featuresMatchingMethod == 
+        TiePointsLocatorInputParameters::KDForestFeaturesMatchingMethod ) &&
+        ( raster1ToRaster2TransfPtr == 0 ) )
+      {
+        // Only features with the same filter size and laplacian sign
+        // can be matched
+        
+        std::map< std::pair< float, float >, unsigned int > groupsIds;
+        std::map< std::pair< float, float >, unsigned int >::const_iterator groupsIdsIt;
+        std::pair< float, float > groupKey;
+        std::vector< unsigned int > featuresSet1Groups( interestPointsSet1Size );
+        std::vector< unsigned int > featuresSet2Groups( interestPointsSet2Size );
+        
+        for( unsigned int idx2 = 0 ; idx2 < interestPointsSet2Size ; ++idx2 )
+        {
+          groupKey.first = internalInterestPointsSet2[ idx2 ].m_feature2;
+          groupKey.second = internalInterestPointsSet2[ idx2 ].m_feature3;
+          
+          groupsIdsIt = groupsIds.find( groupKey );
+          
+          if( groupsIdsIt == groupsIds.end() )
+          {
+            featuresSet2Groups[ idx2 ] = (unsigned int)groupsIds.size();
+            groupsIds[ groupKey ] = featuresSet2Groups[ idx2 ];
+          }
+          else
+          {
+            featuresSet2Groups[ idx2 ] = groupsIdsIt->second;
+          }
+        }
+        
+        for( unsigned int idx1 = 0 ; idx1 < interestPointsSet1Size ; ++idx1 )
+        {
+          groupKey.first = internalInterestPointsSet1[ idx1 ].m_feature2;
+          groupKey.second = internalInterestPointsSet1[ idx1 ].m_feature3;
+          
+          groupsIdsIt = groupsIds.find( groupKey );
+          
+          if( groupsIdsIt == groupsIds.end() )
+          {
+            featuresSet1Groups[ idx1 ] = (unsigned int)groupsIds.size();
+            groupsIds[ groupKey ] = featuresSet1Groups[ idx1 ];
+          }
+          else
+          {
+            featuresSet1Groups[ idx1 ] = groupsIdsIt->second;
+          }
+        }        
+        
+        std::vector< unsigned int > nearestIndexes;
+        std::vector< float > nearestDistances;
+        
+        TERP_TRUE_OR_RETURN_FALSE( executeKDForestMatching( featuresSet1,
+          featuresSet1Groups, featuresSet2, featuresSet2Groups, m_inputParameters,
+          nearestIndexes, nearestDistances ), "Features matching error" );
+          
+        // Keeping only the nearest set 1 feature matched to each set 2 feature
+          
+        std::vector< float > eachColMinValues( interestPointsSet2Size,
+          FLT_MAX );
+        std::vector< unsigned int > eachColMinIndexes( interestPointsSet2Size,
+          interestPointsSet1Size );
+        unsigned int col = 0;
+        unsigned int line = 0;
+          
+        for( line = 0 ; line < interestPointsSet1Size ; ++line )
+        {
+          col = nearestIndexes[ line ];
+          
+          if( ( col < interestPointsSet2Size ) && 
+            ( nearestDistances[ line ] <= maxEuclideanDist ) &&
+            ( nearestDistances[ line ] < eachColMinValues[ col ] ) )
+          {
+            eachColMinValues[ col ] = nearestDistances[ line ];
+            eachColMinIndexes[ col ] = line;
+          }
+        }
+        
+        MatchedInterestPointsT auxMatchedPoints;
+        
+        for( line = 0 ; line < interestPointsSet1Size ; ++line )
+        {
+          col = nearestIndexes[ line ];
+          
+          if( ( col < interestPointsSet2Size ) &&
+            ( eachColMinIndexes[ col ] == line ) )
+          {
+            auxMatchedPoints.m_point1 = internalInterestPointsSet1[ line ];
+            auxMatchedPoints.m_point2 = internalInterestPointsSet2[ col ];
+            auxMatchedPoints.m_feature = nearestDistances[ line ];
+            
+            matchedPoints.insert( auxMatchedPoints );
+          }
+        }
+        
+        return true;
+      }
+      
       // Creating the distances matrix
       
       FloatsMatrix distMatrix;
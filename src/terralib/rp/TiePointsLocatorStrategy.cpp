@@ -23,12 +23,19 @@
 */
 
 #include "TiePointsLocatorStrategy.h"
+#include "Macros.h"
 #include "../raster/Band.h"
 #include "../raster/BandProperty.h"
 #include "../raster/Grid.h"
 #include "../raster/RasterFactory.h"
+#include "../common/PlatformUtils.h"
+
+#include <boost/thread.hpp>
 
 #include <memory.h>
+#include <limits>
+#include <cfloat>
+#include <algorithm>
 
 namespace te
 {
@@ -390,6 +397,159 @@ namespace te
       return true;
     }
     
+    bool TiePointsLocatorStrategy::executeKDForestMatching(
+      const FloatsMatrix& featuresSet1,
+      const std::vector< unsigned int >& featuresSet1Groups,
+      const FloatsMatrix& featuresSet2,
+      const std::vector< unsigned int >& featuresSet2Groups,
+      const TiePointsLocatorInputParameters& inputParameters,
+      std::vector< unsigned int >& nearestIndexes,
+      std::vector< float >& nearestDistances )
+    {
+      const unsigned int featuresSet1Size = featuresSet1.getLinesNumber();
+      const unsigned int featuresSet2Size = featuresSet2.getLinesNumber();
+      
+      TERP_TRUE_OR_RETURN_FALSE( featuresSet1Groups.size() == featuresSet1Size,
+        "Invalid features set 1 groups" );
+      TERP_TRUE_OR_RETURN_FALSE( featuresSet2Groups.size() == featuresSet2Size,
+        "Invalid features set 2 groups" );
+      TERP_TRUE_OR_RETURN_FALSE( featuresSet1.getColumnsNumber() == 
+        featuresSet2.getColumnsNumber(), "Features dimensions mismatch" );
+      
+      nearestIndexes.assign( featuresSet1Size, featuresSet2Size );
+      nearestDistances.assign( featuresSet1Size, FLT_MAX );
+      
+      if( ( featuresSet1Size == 0 ) || ( featuresSet2Size == 0 ) ) return true;
+      
+      // Indexing each set 2 features group
+      
+      unsigned int groupsNumber = 0;
+      unsigned int featIdx = 0;
+      
+      for( featIdx = 0 ; featIdx < featuresSet1Size ; ++featIdx )
+      {
+        groupsNumber = std::max( groupsNumber, featuresSet1Groups[ featIdx ] + 1 );
+      }
+      
+      for( featIdx = 0 ; featIdx < featuresSet2Size ; ++featIdx )
+      {
+        groupsNumber = std::max( groupsNumber, featuresSet2Groups[ featIdx ] + 1 );
+      }
+      
+      std::vector< std::vector< unsigned int > > groupsFeatures( groupsNumber );
+      
+      for( featIdx = 0 ; featIdx < featuresSet2Size ; ++featIdx )
+      {
+        groupsFeatures[ featuresSet2Groups[ featIdx ] ].push_back( featIdx );
+      }
+      
+      boost::ptr_vector< KDForestFeaturesIndex > groupsIndexes;
+      
+      for( unsigned int groupIdx = 0 ; groupIdx < groupsNumber ; ++groupIdx )
+      {
+        groupsIndexes.push_back( new KDForestFeaturesIndex() );
+        
+        if( ! groupsFeatures[ groupIdx ].empty() )
+        {
+          TERP_TRUE_OR_RETURN_FALSE( groupsIndexes.back().initialize( featuresSet2,
+            groupsFeatures[ groupIdx ], inputParameters.m_kdForestTreesNumber, 8,
+            groupIdx + 1 ), "Features index creation error" );
+        }
+      }
+      
+      // Searching
+      
+      boost::mutex syncMutex;
+      unsigned int nextFeatureIdx1ToProcess = 0;
+      
+      ExecuteKDForestMatchingThreadEntryParams params;
+      params.m_featuresSet1Ptr = &featuresSet1;
+      params.m_featuresSet1GroupsPtr = &featuresSet1Groups;
+      params.m_groupsIndexesPtr = &groupsIndexes;
+      params.m_maxChecks = inputParameters.m_kdForestMaxChecks;
+      params.m_maxDistanceRatio = (float)inputParameters.m_kdForestMaxDistanceRatio;
+      params.m_nextFeatureIdx1ToProcessPtr = &nextFeatureIdx1ToProcess;
+      params.m_nearestIndexesPtr = &nearestIndexes;
+      params.m_nearestDistancesPtr = &nearestDistances;
+      params.m_syncMutexPtr = &syncMutex;
+      
+      if( inputParameters.m_enableMultiThread )
+      {
+        TERP_TRUE_OR_RETURN_FALSE( featuresSet1.getMemPolicy() ==
+          FloatsMatrix::RAMMemPol, "Invalid memory policy" )
+          
+        const unsigned int procsNumber = te::common::GetPhysProcNumber();
+        
+        boost::thread_group threads;
+        
+        for( unsigned int threadIdx = 0 ; threadIdx < procsNumber ;
+          ++threadIdx )
+        {
+          threads.add_thread( new boost::thread( 
+            executeKDForestMatchingThreadEntry, &params ) );
+        }
+        
+        threads.join_all();
+      }
+      else
+      {
+        executeKDForestMatchingThreadEntry( &params );
+      }
+      
+      return true;
+    }
+    
+    void TiePointsLocatorStrategy::executeKDForestMatchingThreadEntry(
+      ExecuteKDForestMatchingThreadEntryParams* paramsPtr )
+    {
+      const unsigned int featuresSet1Size = 
+        paramsPtr->m_featuresSet1Ptr->getLinesNumber();
+      const unsigned int notFoundIdx = std::numeric_limits< unsigned int >::max();
+        
+      KDForestFeaturesIndex::SearchBuffers buffers;
+      unsigned int nearest1Idx = 0;
+      float nearest1Dist = 0;
+      unsigned int nearest2Idx = 0;
+      float nearest2Dist = 0;
+      
+      for( unsigned int feat1Idx = 0 ; feat1Idx < featuresSet1Size ; ++feat1Idx )
+      {
+        paramsPtr->m_syncMutexPtr->lock();
+        
+        if( feat1Idx == (*paramsPtr->m_nextFeatureIdx1ToProcessPtr) )
+        {
+          ++(*paramsPtr->m_nextFeatureIdx1ToProcessPtr);
+          
+          paramsPtr->m_syncMutexPtr->unlock();
+          
+          const KDForestFeaturesIndex& index = paramsPtr->m_groupsIndexesPtr->operator[](
+            paramsPtr->m_featuresSet1GroupsPtr->operator[]( feat1Idx ) );
+          
+          index.searchNearest( paramsPtr->m_featuresSet1Ptr->operator[]( feat1Idx ),
+            paramsPtr->m_maxChecks, buffers, nearest1Idx, nearest1Dist,
+            nearest2Idx, nearest2Dist );
+            
+          if( 
+              ( nearest1Idx != notFoundIdx )
+              &&
+              (
+                ( nearest2Idx == notFoundIdx )
+                ||
+                ( nearest1Dist <= ( paramsPtr->m_maxDistanceRatio * nearest2Dist ) )
+              )
+            )
+          {
+            paramsPtr->m_nearestIndexesPtr->operator[]( feat1Idx ) = nearest1Idx;
+            paramsPtr->m_nearestDistancesPtr->operator[]( feat1Idx ) = nearest1Dist;
+          }
+        }
+        else
+        {
+          paramsPtr->m_syncMutexPtr->unlock();
+        }
+      }
+    }
+    
   } // end namespace rp
 }   // end namespace te    
 
@@ -28,6 +28,7 @@
 #include "Config.h"
 #include "Matrix.h"
 #include "TiePointsLocatorInputParameters.h"
+#include "KDForestFeaturesIndex.h"
 #include "../geometry/GTParameters.h"
 #include "../raster/Raster.h"
 #include "../raster/Interpolator.h"
@@ -38,6 +39,9 @@
 #include <list>
 #include <memory>
 
+#include <boost/thread/mutex.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
 namespace te
 {
   namespace rp
@@ -190,6 +194,37 @@ namespace te
         /*! Matched interest points container type 
         */
         typedef std::multiset< MatchedInterestPointsT > MatchedInterestPointsSetT;                 
+        
+        /*!
+          \class ExecuteKDForestMatchingThreadEntryParams
+          \brief Parameters used by the executeKDForestMatchingThreadEntry method.
+         */
+        class ExecuteKDForestMatchingThreadEntryParams
+        {
+          public :
+            
+            FloatsMatrix const* m_featuresSet1Ptr; //!< Features set 1 (queries).
+            
+            std::vector< unsigned int > const* m_featuresSet1GroupsPtr; //!< The group of each set 1 feature.
+            
+            boost::ptr_vector< KDForestFeaturesIndex > const* m_groupsIndexesPtr; //!< One set 2 index for each group.
+            
+            unsigned int m_maxChecks; //!< The maximum number of feature comparisons for each search.
+            
+            float m_maxDistanceRatio; //!< The maximum nearest/second nearest distance ratio.
+            
+            unsigned int* m_nextFeatureIdx1ToProcessPtr; //!< A pointer to the next set 1 feature to process.
+            
+            std::vector< unsigned int >* m_nearestIndexesPtr; //!< The output nearest set 2 feature index for each set 1 feature.
+            
+            std::vector< float >* m_nearestDistancesPtr; //!< The output nearest set 2 feature distance for each set 1 feature.
+            
+            boost::mutex* m_syncMutexPtr; //!< Synchronization mutex.
+            
+            ExecuteKDForestMatchingThreadEntryParams() {};
+            
+            ~ExecuteKDForestMatchingThreadEntryParams() {};
+        };
             
         /*!
           \brief Initialize the strategy.
@@ -343,6 +378,42 @@ namespace te
         static bool checkForDuplicatedInterestPoints( const InterestPointsSetT& interestPoints,
           double& x, double& y );         
         
+        /*!
+          \brief Find the nearest features set 2 feature for each features set 1 feature using an approximate nearest neighbour index.
+          
+          \param featuresSet1 Features set 1 (one feature per line).
+          
+          \param featuresSet1Groups The group of each set 1 feature (features from different groups are never matched).
+          
+          \param featuresSet2 Features set 2 (one feature per line).
+          
+          \param featuresSet2Groups The group of each set 2 feature (features from different groups are never matched).
+          
+          \param inputParameters The input parameters (the kd-forest and multi-thread parameters will be used).
+          
+          \param nearestIndexes The nearest set 2 feature index for each set 1 feature or featuresSet2.getLinesNumber() if no match was accepted by the ratio test.
+          
+          \param nearestDistances The nearest set 2 feature euclidean distance for each set 1 feature.
+          
+          \return true if ok, false on errors.
+        */
+        static bool executeKDForestMatching(
+          const FloatsMatrix& featuresSet1,
+          const std::vector< unsigned int >& featuresSet1Groups,
+          const FloatsMatrix& featuresSet2,
+          const std::vector< unsigned int >& featuresSet2Groups,
+          const TiePointsLocatorInputParameters& inputParameters,
+          std::vector< unsigned int >& nearestIndexes,
+          std::vector< float >& nearestDistances );
+          
+        /*! 
+          \brief Features set 1 searches thread entry.
+          
+          \param paramsPtr A pointer to the thread parameters.
+        */
+        static void executeKDForestMatchingThreadEntry(
+          ExecuteKDForestMatchingThreadEntryParams* paramsPtr );
+        
       private:
         
         TiePointsLocatorStrategy( const TiePointsLocatorStrategy& );
@@ -36,6 +36,8 @@
 #include "../common/progress/TaskProgress.h"
 #include "../memory/ExpansibleRaster.h"
 
+#include <boost/bind.hpp>
+
 #include <cmath>
 #include <limits>
   
@@ -508,134 +510,73 @@ namespace te
       // Recomposing levels for each band
       
       {
-        const unsigned int nRows = outParamsPtr->m_outputRasterPtr->getNumberOfRows();
-        const unsigned int nCols = outParamsPtr->m_outputRasterPtr->getNumberOfColumns();
         const unsigned int nBands = outParamsPtr->m_outputRasterPtr->getNumberOfBands();
-        te::rst::Raster& resampledLlowResRaster = *resampledLlowResRasterPtr;
-        te::rst::Raster& outputRaster = *(outParamsPtr->m_outputRasterPtr);
-        te::rst::Raster& highResWaveletsRaster = *highResWaveletsRasterPtr;
-        const unsigned int highResWaveletsRasterBands = highResWaveletsRaster.getNumberOfBands();
-        unsigned int row = 0;
-        unsigned int col = 0;
         unsigned int bandIdx = 0;
-        std::vector< double > resLRRasterValues( nBands );
-        unsigned int waveletBandIdx = 0;
-        double outputRasterValue = 0;
-        double resampledLlowResRasterValue = 0;
-        double wisperTerm = 0;
-        double highResWaveletsValue = 0.0;
-        std::vector< double > ropi( nBands );
-        double ropiMean = 0;
+        std::vector< double > ropiGains( nBands );
+        std::vector< double > alphaTerms( nBands );
+        std::vector< double > betaTerms( nBands );
         
-        std::vector< double > outBandsMinValue( nBands );
-        std::vector< double > outBandsMaxValue( nBands );
-        std::vector< double > resampledLlowResBandsGains( nBands );
         for( bandIdx = 0 ; bandIdx < nBands ;  ++bandIdx )
-        {           
-          te::rp::GetDataTypeRange( 
-            outParamsPtr->m_outputRasterPtr->getBandDataType( bandIdx ),
-            outBandsMinValue[ bandIdx ], outBandsMaxValue[ bandIdx ] );
-        }
-
-        for( row = 0 ; row < nRows ; ++row )
         {
-          for( col = 0 ; col < nCols ; ++col )
-          {     
-            ropiMean = 0.0;
-            for( bandIdx = 0 ; bandIdx < nBands ;  ++bandIdx )
-            {
-              resampledLlowResRaster.getValue( col, row, resampledLlowResRasterValue, bandIdx );
-              
-              resLRRasterValues[ bandIdx ] = resampledLlowResRasterValue;
-              
-              assert( lRBandXHRBandIntersectionAreas[ bandIdx ] > 0.0 );
-              ropi[ bandIdx ] = 
-                (
-                  (
-                    lRBandXHRBandIntersectionAreas[ bandIdx ]
-                    *
-                    lRBandXHRBandIntersectionAreas[ bandIdx ]
-                    *
-                    resLRRasterValues[ bandIdx ]
-                  )
-                  /
-                  lowResBandsSRFAreas[ bandIdx ]
-                );
-                  
-              ropiMean += ropi[ bandIdx ];
-            }
-            ropiMean /= ((double)nBands);
+          assert( lRBandXHRBandIntersectionAreas[ bandIdx ] > 0.0 );
+          
+          ropiGains[ bandIdx ] = 
+            lRBandXHRBandIntersectionAreas[ bandIdx ]
+            *
+            lRBandXHRBandIntersectionAreas[ bandIdx ];
+          
+          alphaTerms[ bandIdx ] =
+            (
+              // alpha
+              (
+                lRBandsXHRBandTotalExclusiveIntersectionSRFArea
+                /
+                hiResBandSRFArea
+              )
+              *
+              // P( mi | pm )
+              (
+                lRBandXHRBandIntersectionAreas[ bandIdx ]
+                /
+                lRBandsXHRBandTotalExclusiveIntersectionSRFArea
+              )
+              /
+              // P( pm | mi )
+              (
+                lRBandXHRBandIntersectionAreas[ bandIdx ]
+                /
+                lowResBandsSRFAreas[ bandIdx ]
+              )
+            );
             
-            for( bandIdx = 0 ; bandIdx < nBands ;  ++bandIdx )
-            {      
-              wisperTerm =
+          betaTerms[ bandIdx ] =
+            (
+              1.0
+              -
+              (
                 (
-                  // Si
-                  (
-                    ropi[ bandIdx ]
-                    /
-                    ropiMean
-                  )
-                  *
-                  (
-                    // alpha
-                    (
-                      lRBandsXHRBandTotalExclusiveIntersectionSRFArea
-                      /
-                      hiResBandSRFArea
-                    )
-                    *
-                    // P( mi | pm )
-                    (
-                      lRBandXHRBandIntersectionAreas[ bandIdx ]
-                      /
-                      lRBandsXHRBandTotalExclusiveIntersectionSRFArea
-                    )
-                    /
-                    // P( pm | mi )
-                    (
-                      lRBandXHRBandIntersectionAreas[ bandIdx ]
-                      /
-                      lowResBandsSRFAreas[ bandIdx ]
-                    )
-                  )
-                  *
-                  (
-                    1.0
-                    -
-                    (
-                      (
-                        // beta
-                        lRBandXlRBandSRFIntersectionAreas[ bandIdx ][ lRInterceptedBandIndex[ bandIdx ] ]
-                        /
-                        lRBandXHRBandIntersectionAreas[ bandIdx ]
-                      )
-                      /
-                      2.0
-                    )
-                  )
-                );
-                
-              outputRasterValue = resLRRasterValues[ bandIdx ];
-              
-              for( waveletBandIdx = 1 ; waveletBandIdx < highResWaveletsRasterBands ; 
-                waveletBandIdx += 2 )
-              {
-                highResWaveletsRaster.getValue( col, row, highResWaveletsValue, 
-                  waveletBandIdx );
-                outputRasterValue += ( wisperTerm * highResWaveletsValue );
-              }         
-
-              outputRasterValue = std::max( outBandsMinValue[ bandIdx ], 
-                outputRasterValue );
-              outputRasterValue = std::min( outBandsMaxValue[ bandIdx ], 
-                outputRasterValue );
-              
-              outputRaster.setValue( col, row, outputRasterValue, bandIdx );
-            }
-          }
+                  // beta
+                  lRBandXlRBandSRFIntersectionAreas[ bandIdx ][ lRInterceptedBandIndex[ bandIdx ] ]
+                  /
+                  lRBandXHRBandIntersectionAreas[ bandIdx ]
+                )
+                /
+                2.0
+              )
+            );
         }
-       
+        
+        BlockProcessor processor;
+        processor.setOutputRaster( *outParamsPtr->m_outputRasterPtr );
+        processor.addInputRaster( *resampledLlowResRasterPtr );
+        processor.addInputRaster( *highResWaveletsRasterPtr );
+        processor.setThreadsNumber( m_inputParameters.m_enableMultiThread ? 0 : 1 );
+        
+        TERP_TRUE_OR_RETURN_FALSE( processor.execute( boost::bind( 
+          &WisperFusion::recomposeBlock, this, boost::cref( ropiGains ),
+          boost::cref( lowResBandsSRFAreas ), boost::cref( alphaTerms ),
+          boost::cref( betaTerms ), _1, _2 ) ),
+          "Wavelet levels recomposition error" );
       } 
       
       if( m_inputParameters.m_enableProgress )
@@ -647,6 +588,103 @@ namespace te
       return true;
     }
 
+    bool WisperFusion::recomposeBlock( const std::vector< double >& ropiGains,
+      const std::vector< double >& lowResBandsSRFAreas,
+      const std::vector< double >& alphaTerms,
+      const std::vector< double >& betaTerms,
+      const BlockWindow& window, BlockContext& context ) const
+    {
+      const te::rst::Raster& resampledLlowResRaster = context.getInputRaster( 0 );
+      const te::rst::Raster& highResWaveletsRaster = context.getInputRaster( 1 );
+      te::rst::Raster& outputRaster = context.getOutputRaster();
+      const unsigned int nBands = outputRaster.getNumberOfBands();
+      const unsigned int highResWaveletsRasterBands = highResWaveletsRaster.getNumberOfBands();
+      unsigned int row = 0;
+      unsigned int col = 0;
+      unsigned int bandIdx = 0;
+      std::vector< double > resLRRasterValues( nBands );
+      unsigned int waveletBandIdx = 0;
+      double outputRasterValue = 0;
+      double resampledLlowResRasterValue = 0;
+      double wisperTerm = 0;
+      double highResWaveletsValue = 0.0;
+      std::vector< double > ropi( nBands );
+      double ropiMean = 0;
+      
+      std::vector< double > outBandsMinValue( nBands );
+      std::vector< double > outBandsMaxValue( nBands );
+      for( bandIdx = 0 ; bandIdx < nBands ;  ++bandIdx )
+      {           
+        te::rp::GetDataTypeRange( 
+          outputRaster.getBandDataType( bandIdx ),
+          outBandsMinValue[ bandIdx ], outBandsMaxValue[ bandIdx ] );
+      }
+
+      for( row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
+      {
+        for( col = window.m_firstCol ; col < window.m_colsBound ; ++col )
+        {     
+          ropiMean = 0.0;
+          for( bandIdx = 0 ; bandIdx < nBands ;  ++bandIdx )
+          {
+            resampledLlowResRaster.getValue( col, row, resampledLlowResRasterValue, bandIdx );
+            
+            resLRRasterValues[ bandIdx ] = resampledLlowResRasterValue;
+            
+            ropi[ bandIdx ] = 
+              (
+                (
+                  ropiGains[ bandIdx ]
+                  *
+                  resLRRasterValues[ bandIdx ]
+                )
+                /
+                lowResBandsSRFAreas[ bandIdx ]
+              );
+                
+            ropiMean += ropi[ bandIdx ];
+          }
+          ropiMean /= ((double)nBands);
+          
+          for( bandIdx = 0 ; bandIdx < nBands ;  ++bandIdx )
+          {      
+            wisperTerm =
+              (
+                // Si
+                (
+                  ropi[ bandIdx ]
+                  /
+                  ropiMean
+                )
+                *
+                alphaTerms[ bandIdx ]
+                *
+                betaTerms[ bandIdx ]
+              );
+              
+            outputRasterValue = resLRRasterValues[ bandIdx ];
+            
+            for( waveletBandIdx = 1 ; waveletBandIdx < highResWaveletsRasterBands ; 
+              waveletBandIdx += 2 )
+            {
+              highResWaveletsRaster.getValue( col, row, highResWaveletsValue, 
+                waveletBandIdx );
+              outputRasterValue += ( wisperTerm * highResWaveletsValue );
+            }         
+
+            outputRasterValue = std::max( outBandsMinValue[ bandIdx ], 
+              outputRasterValue );
+            outputRasterValue = std::min( outBandsMaxValue[ bandIdx ], 
+              outputRasterValue );
+            
+            outputRaster.setValue( col, row, outputRasterValue, bandIdx );
+          }
+        }
+      }
+      
+      return true;
+    }
+
     void WisperFusion::reset() throw( te::rp::Exception )
     {
       m_inputParameters.reset();
@@ -26,6 +26,7 @@
 #define __TERRALIB_RP_INTERNAL_WISPERFUSION_H
 
 #include "Algorithm.h"
+#include "BlockProcessor.h"
 #include "Matrix.h"
 #include "../raster/Raster.h"
 #include "../raster/Interpolator.h"
@@ -161,6 +162,22 @@ namespace te
         InputParameters m_inputParameters; //!< Input execution parameters.
         
         bool m_isInitialized; //!< Tells if this instance is initialized.
+        
+        /*!
+          \brief Recomposes the wavelet levels of one block window for all bands (BlockProcessor function).
+          \param ropiGains The squared low resolution band x high resolution band SRFs intersection area of each band.
+          \param lowResBandsSRFAreas The SRF area of each low resolution band.
+          \param alphaTerms The wisper alpha term (alpha * P( mi | pm ) / P( pm | mi )) of each band.
+          \param betaTerms The wisper beta term ( 1 - beta / 2 ) of each band.
+          \param window The block window.
+          \param context The executing thread context (input 0: the resampled low resolution raster, input 1: the high resolution wavelets raster).
+          \return true if ok, false on errors.
+         */
+        bool recomposeBlock( const std::vector< double >& ropiGains,
+          const std::vector< double >& lowResBandsSRFAreas,
+          const std::vector< double >& alphaTerms,
+          const std::vector< double >& betaTerms,
+          const BlockWindow& window, BlockContext& context ) const;
     };
 
   } // end namespace rp
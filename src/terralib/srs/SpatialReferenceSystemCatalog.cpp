@@ -0,0 +1,414 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+ \file terralib/srs/SpatialReferenceSystemCatalog.cpp
+
+ \brief A read-only catalog of SRS descriptions stored in a memory-mapped binary file.
+ */
+
+// TerraLib
+#include "../core/translator/Translator.h"
+#include "Exception.h"
+#include "SpatialReferenceSystemCatalog.h"
+
+// STL
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <vector>
+
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/foreach.hpp>
+#include <boost/format.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+namespace
+{
+  const char sg_magic[8] = { 'T', 'E', 'S', 'R', 'S', 'C', 'A', 'T' };
+
+  const boost::uint32_t sg_version = 1;
+
+  const boost::uint32_t sg_byteOrder = 0x01020304;
+
+  struct CatalogHeader
+  {
+    char m_magic[8];
+    boost::uint32_t m_version;
+    boost::uint32_t m_byteOrder;
+    boost::uint32_t m_nRecords;
+    boost::uint32_t m_nBuckets;
+    boost::uint64_t m_recordsOffset;
+    boost::uint64_t m_bucketsOffset;
+    boost::uint64_t m_poolOffset;
+    boost::uint64_t m_poolSize;
+  };
+
+  struct CatalogString
+  {
+    boost::uint32_t m_offset;
+    boost::uint32_t m_size;
+  };
+
+  struct CatalogRecord
+  {
+    boost::uint32_t m_id;
+    CatalogString m_authName;
+    CatalogString m_name;
+    CatalogString m_p4txt;
+    CatalogString m_wkt;
+  };
+
+  //! FNV-1a hash of <authority, id>.
+  boost::uint32_t Hash(unsigned int id, const char* authName, std::size_t size)
+  {
+    boost::uint32_t h = 2166136261u;
+
+    for(std::size_t i = 0; i < size; ++i)
+    {
+      h ^= static_cast<unsigned char>(authName[i]);
+      h *= 16777619u;
+    }
+
+    for(int i = 0; i < 4; ++i)
+    {
+      h ^= (id >> (8 * i)) & 0xFF;
+      h *= 16777619u;
+    }
+
+    return h;
+  }
+
+  //! It adds a string to the pool, storing repeated strings once.
+  CatalogString AddString(const std::string& s, std::string& pool, std::map<std::string, CatalogString>& added)
+  {
+    std::map<std::string, CatalogString>::const_iterator it = added.find(s);
+
+    if(it != added.end())
+      return it->second;
+
+    CatalogString cs;
+    cs.m_offset = static_cast<boost::uint32_t>(pool.size());
+    cs.m_size = static_cast<boost::uint32_t>(s.size());
+
+    pool += s;
+
+    added[s] = cs;
+
+    return cs;
+  }
+
+  struct JSONRecord
+  {
+    unsigned int m_id;
+    std::string m_authName;
+    std::string m_name;
+    std::string m_p4txt;
+    std::string m_wkt;
+  };
+}
+
+const std::size_t te::srs::SpatialReferenceSystemCatalog::npos = static_cast<std::size_t>(-1);
+
+struct te::srs::SpatialReferenceSystemCatalog::Impl
+{
+  boost::interprocess::file_mapping m_file;
+  boost::interprocess::mapped_region m_region;
+  const CatalogHeader* m_header;
+  const CatalogRecord* m_records;
+  const boost::uint32_t* m_buckets;
+  const char* m_pool;
+
+  std::string toString(const CatalogString& s) const
+  {
+    return std::string(m_pool + s.m_offset, s.m_size);
+  }
+
+  bool equals(const CatalogString& s, const std::string& value) const
+  {
+    return (s.m_size == value.size()) && (std::memcmp(m_pool + s.m_offset, value.data(), s.m_size) == 0);
+  }
+};
+
+te::srs::SpatialReferenceSystemCatalog::SpatialReferenceSystemCatalog(const std::string& fileName)
+  : m_pImpl(new Impl)
+{
+  try
+  {
+    boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+
+    m_pImpl->m_file.swap(file);
+    m_pImpl->m_region.swap(region);
+  }
+  catch(const boost::interprocess::interprocess_exception& e)
+  {
+    throw Exception((boost::format(TE_TR("Could not map the SRS catalog %1%: %2%.")) % fileName % e.what()).str());
+  }
+
+  const char* data = static_cast<const char*>(m_pImpl->m_region.get_address());
+  const boost::uint64_t fileSize = m_pImpl->m_region.get_size();
+
+  m_pImpl->m_header = reinterpret_cast<const CatalogHeader*>(data);
+
+  const CatalogHeader& h = *m_pImpl->m_header;
+
+  if((fileSize < sizeof(CatalogHeader)) ||
+     (std::memcmp(h.m_magic, sg_magic, sizeof(sg_magic)) != 0) ||
+     (h.m_version != sg_version) ||
+     (h.m_byteOrder != sg_byteOrder) ||
+     (h.m_nBuckets == 0) ||
+     ((h.m_nBuckets & (h.m_nBuckets - 1)) != 0) ||
+     (h.m_nBuckets <= h.m_nRecords) ||
+     (h.m_recordsOffset + h.m_nRecords * sizeof(CatalogRecord) > fileSize) ||
+     (h.m_bucketsOffset + h.m_nBuckets * sizeof(boost::uint32_t) > fileSize) ||
+     (h.m_poolOffset + h.m_poolSize > fileSize))
+    throw Exception((boost::format(TE_TR("The file %1% is not a valid SRS catalog.")) % fileName).str());
+
+  m_pImpl->m_records = reinterpret_cast<const CatalogRecord*>(data + h.m_recordsOffset);
+  m_pImpl->m_buckets = reinterpret_cast<const boost::uint32_t*>(data + h.m_bucketsOffset);
+  m_pImpl->m_pool = data + h.m_poolOffset;
+
+// check the references to the pool once, so the accessors can trust them
+  for(boost::uint32_t i = 0; i < h.m_nRecords; ++i)
+  {
+    const CatalogRecord& r = m_pImpl->m_records[i];
+
+    const CatalogString* strings[] = { &r.m_authName, &r.m_name, &r.m_p4txt, &r.m_wkt };
+
+    for(std::size_t j = 0; j < 4; ++j)
+    {
+      if(static_cast<boost::uint64_t>(strings[j]->m_offset) + strings[j]->m_size > h.m_poolSize)
+        throw Exception((boost::format(TE_TR("The file %1% is not a valid SRS catalog.")) % fileName).str());
+    }
+  }
+
+  for(boost::uint32_t i = 0; i < h.m_nBuckets; ++i)
+  {
+    if(m_pImpl->m_buckets[i] > h.m_nRecords)
+      throw Exception((boost::format(TE_TR("The file %1% is not a valid SRS catalog.")) % fileName).str());
+  }
+}
+
+te::srs::SpatialReferenceSystemCatalog::~SpatialReferenceSystemCatalog()
+{
+}
+
+bool te::srs::SpatialReferenceSystemCatalog::isCatalog(const std::string& fileName)
+{
+  std::ifstream f(fileName.c_str(), std::ios::in | std::ios::binary);
+
+  char magic[sizeof(sg_magic)];
+
+  if(!f.read(magic, sizeof(magic)))
+    return false;
+
+  return std::memcmp(magic, sg_magic, sizeof(sg_magic)) == 0;
+}
+
+void te::srs::SpatialReferenceSystemCatalog::build(const std::string& jsonFileName, const std::string& catalogFileName)
+{
+// read the descriptions as the SpatialReferenceSystemManager does
+  std::vector<JSONRecord> descs;
+
+  try
+  {
+    boost::property_tree::ptree pt;
+    boost::property_tree::json_parser::read_json(jsonFileName, pt);
+
+    BOOST_FOREACH(boost::property_tree::ptree::value_type& v, pt.get_child("SRSs"))
+    {
+      JSONRecord d;
+      d.m_id = v.second.get<unsigned int>("srid");
+      d.m_authName = d.m_id > 100000 ? "USER" : "EPSG";
+      d.m_name = v.second.get<std::string>("name");
+      d.m_p4txt = v.second.get<std::string>("pj4txt");
+      d.m_wkt = v.second.get<std::string>("wkt");
+
+      descs.push_back(d);
+    }
+  }
+  catch(const boost::property_tree::ptree_error& e)
+  {
+    throw Exception((boost::format(TE_TR("Could not read the SRS descriptions from %1%: %2%.")) % jsonFileName % e.what()).str());
+  }
+
+// the manager keeps the first description of a repeated SRS; the order of the file
+// is kept, so the searches by name or text find the same description as the manager
+  std::set<std::pair<std::string, unsigned int> > ids;
+  std::vector<JSONRecord> unique;
+
+  for(std::size_t i = 0; i < descs.size(); ++i)
+  {
+    if(ids.insert(std::make_pair(descs[i].m_authName, descs[i].m_id)).second)
+      unique.push_back(descs[i]);
+  }
+
+  descs.swap(unique);
+
+// the records and the string pool
+  std::string pool;
+  std::map<std::string, CatalogString> added;
+  std::vector<CatalogRecord> records(descs.size());
+
+  for(std::size_t i = 0; i < descs.size(); ++i)
+  {
+    records[i].m_id = descs[i].m_id;
+    records[i].m_authName = AddString(descs[i].m_authName, pool, added);
+    records[i].m_name = AddString(descs[i].m_name, pool, added);
+    records[i].m_p4txt = AddString(descs[i].m_p4txt, pool, added);
+    records[i].m_wkt = AddString(descs[i].m_wkt, pool, added);
+  }
+
+// the hash table: a power of two with a load factor of at most 0.5
+  boost::uint32_t nBuckets = 16;
+
+  while(nBuckets < 2 * records.size())
+    nBuckets *= 2;
+
+  std::vector<boost::uint32_t> buckets(nBuckets, 0);
+
+  for(std::size_t i = 0; i < descs.size(); ++i)
+  {
+    boost::uint32_t b = Hash(descs[i].m_id, descs[i].m_authName.c_str(), descs[i].m_authName.size()) & (nBuckets - 1);
+
+    while(buckets[b] != 0)
+      b = (b + 1) & (nBuckets - 1);
+
+    buckets[b] = static_cast<boost::uint32_t>(i + 1);
+  }
+
+  CatalogHeader h;
+  std::memcpy(h.m_magic, sg_magic, sizeof(sg_magic));
+  h.m_version = sg_version;
+  h.m_byteOrder = sg_byteOrder;
+  h.m_nRecords = static_cast<boost::uint32_t>(records.size());
+  h.m_nBuckets = nBuckets;
+  h.m_recordsOffset = sizeof(CatalogHeader);
+  h.m_bucketsOffset = h.m_recordsOffset + records.size() * sizeof(CatalogRecord);
+  h.m_poolOffset = h.m_bucketsOffset + buckets.size() * sizeof(boost::uint32_t);
+  h.m_poolSize = pool.size();
+
+  std::ofstream f(catalogFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+  if(!records.empty())
+    f.write(reinterpret_cast<const char*>(&records[0]), records.size() * sizeof(CatalogRecord));
+
+  f.write(reinterpret_cast<const char*>(&buckets[0]), buckets.size() * sizeof(boost::uint32_t));
+  f.write(pool.data(), pool.size());
+
+  f.close();
+
+  if(!f)
+    throw Exception((boost::format(TE_TR("Could not write the SRS catalog %1%.")) % catalogFileName).str());
+}
+
+std::size_t te::srs::SpatialReferenceSystemCatalog::size() const
+{
+  return m_pImpl->m_header->m_nRecords;
+}
+
+std::size_t te::srs::SpatialReferenceSystemCatalog::find(unsigned int id, const std::string& authName) const
+{
+  const boost::uint32_t mask = m_pImpl->m_header->m_nBuckets - 1;
+
+  boost::uint32_t b = Hash(id, authName.c_str(), authName.size()) & mask;
+
+  for(boost::uint32_t probes = 0; probes <= mask; ++probes)
+  {
+    const boost::uint32_t r = m_pImpl->m_buckets[b];
+
+    if(r == 0)
+      return npos;
+
+    const CatalogRecord& rec = m_pImpl->m_records[r - 1];
+
+    if((rec.m_id == id) && m_pImpl->equals(rec.m_authName, authName))
+      return r - 1;
+
+    b = (b + 1) & mask;
+  }
+
+  return npos;
+}
+
+std::size_t te::srs::SpatialReferenceSystemCatalog::findByName(const std::string& name) const
+{
+  for(std::size_t i = 0; i < size(); ++i)
+  {
+    if(m_pImpl->equals(m_pImpl->m_records[i].m_name, name))
+      return i;
+  }
+
+  return npos;
+}
+
+std::size_t te::srs::SpatialReferenceSystemCatalog::findByP4Txt(const std::string& p4Txt) const
+{
+  for(std::size_t i = 0; i < size(); ++i)
+  {
+    if(m_pImpl->equals(m_pImpl->m_records[i].m_p4txt, p4Txt))
+      return i;
+  }
+
+  return npos;
+}
+
+std::size_t te::srs::SpatialReferenceSystemCatalog::findByWkt(const std::string& wkt) const
+{
+  for(std::size_t i = 0; i < size(); ++i)
+  {
+    if(m_pImpl->equals(m_pImpl->m_records[i].m_wkt, wkt))
+      return i;
+  }
+
+  return npos;
+}
+
+unsigned int te::srs::SpatialReferenceSystemCatalog::getId(std::size_t pos) const
+{
+  return m_pImpl->m_records[pos].m_id;
+}
+
+std::string te::srs::SpatialReferenceSystemCatalog::getAuthName(std::size_t pos) const
+{
+  return m_pImpl->toString(m_pImpl->m_records[pos].m_authName);
+}
+
+std::string te::srs::SpatialReferenceSystemCatalog::getName(std::size_t pos) const
+{
+  return m_pImpl->toString(m_pImpl->m_records[pos].m_name);
+}
+
+std::string te::srs::SpatialReferenceSystemCatalog::getP4Txt(std::size_t pos) const
+{
+  return m_pImpl->toString(m_pImpl->m_records[pos].m_p4txt);
+}
+
+std::string te::srs::SpatialReferenceSystemCatalog::getWkt(std::size_t pos) const
+{
+  return m_pImpl->toString(m_pImpl->m_records[pos].m_wkt);
+}
@@ -0,0 +1,160 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+ \file terralib/srs/SpatialReferenceSystemCatalog.h
+
+ \brief A read-only catalog of SRS descriptions stored in a memory-mapped binary file.
+ */
+
+#ifndef __TERRALIB_SRS_INTERNAL_SPATIALREFERENCESYSTEMCATALOG_H
+#define __TERRALIB_SRS_INTERNAL_SPATIALREFERENCESYSTEMCATALOG_H
+
+// TerraLib
+#include "Config.h"
+
+// STL
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Boost
+#include <boost/noncopyable.hpp>
+
+namespace te
+{
+  namespace srs
+  {
+    /*!
+     \class SpatialReferenceSystemCatalog
+
+     \brief A read-only catalog of SRS descriptions stored in a memory-mapped binary file.
+
+     The catalog is generated at build time from the JSON file read by the SpatialReferenceSystemManager
+     (see build()). It has a hash table on <authority, id> and a pool with the names, PROJ4 and WKT
+     texts. Opening it only maps the file: the pages are shared by all the processes using the catalog
+     and the strings are only copied when they are requested.
+
+     File layout (native byte order):
+     - header: magic "TESRSCAT", version, byte order mark, number of records, number of buckets and
+       the offsets of the sections;
+     - records: <id, authority, name, PROJ4, WKT>, the strings as <offset, size> in the pool;
+     - buckets: the index of a record plus one (0 for an empty bucket), with linear probing;
+     - pool: the strings, without terminators. Repeated strings are stored once.
+
+     \ingroup srs
+
+     \sa SpatialReferenceSystemManager
+     */
+    class TESRSEXPORT SpatialReferenceSystemCatalog : public boost::noncopyable
+    {
+      public:
+
+        //! The value returned by the searches when a description is not in the catalog.
+        static const std::size_t npos;
+
+        /*!
+         \brief It opens a catalog file.
+
+         \param fileName The catalog file name.
+
+         \exception te::srs::Exception If the file can not be mapped or it is not a valid catalog.
+         */
+        explicit SpatialReferenceSystemCatalog(const std::string& fileName);
+
+        //! Destructor.
+        ~SpatialReferenceSystemCatalog();
+
+        /*!
+         \brief It returns true if the file starts with the catalog signature.
+
+         \param fileName The file name.
+         */
+        static bool isCatalog(const std::string& fileName);
+
+        /*!
+         \brief It generates a catalog from a JSON file in the format read by the SpatialReferenceSystemManager.
+
+         \param jsonFileName    The JSON file name.
+         \param catalogFileName The catalog file name.
+
+         \exception te::srs::Exception If the JSON file can not be parsed or the catalog can not be written.
+         */
+        static void build(const std::string& jsonFileName, const std::string& catalogFileName);
+
+        //! It returns the number of descriptions in the catalog.
+        std::size_t size() const;
+
+        /*!
+         \brief It returns the position of a description given its identification, using the hash table.
+
+         \param id       The coordinate system identification.
+         \param authName The authority responsible for the id.
+
+         \return The position of the description or npos.
+         */
+        std::size_t find(unsigned int id, const std::string& authName) const;
+
+        /*!
+         \brief It returns the position of the first description with the given name.
+
+         \note It scans the catalog.
+         */
+        std::size_t findByName(const std::string& name) const;
+
+        /*!
+         \brief It returns the position of the first description with the given PROJ4 text.
+
+         \note It scans the catalog.
+         */
+        std::size_t findByP4Txt(const std::string& p4Txt) const;
+
+        /*!
+         \brief It returns the position of the first description with the given WKT.
+
+         \note It scans the catalog.
+         */
+        std::size_t findByWkt(const std::string& wkt) const;
+
+        //! It returns the identification of the description at the given position.
+        unsigned int getId(std::size_t pos) const;
+
+        //! It returns the authority of the description at the given position.
+        std::string getAuthName(std::size_t pos) const;
+
+        //! It returns the name of the description at the given position.
+        std::string getName(std::size_t pos) const;
+
+        //! It returns the PROJ4 text of the description at the given position.
+        std::string getP4Txt(std::size_t pos) const;
+
+        //! It returns the WKT of the description at the given position.
+        std::string getWkt(std::size_t pos) const;
+
+      private:
+
+        struct Impl;
+
+        std::unique_ptr<Impl> m_pImpl;  //!< The mapped file and its sections.
+    };
+
+  } // end namespace srs
+}   // end namespace te
+
+#endif // __TERRALIB_SRS_INTERNAL_SPATIALREFERENCESYSTEMCATALOG_H
@@ -65,6 +65,10 @@ void LoadSpatialReferenceSystemManager(const std::string fileName, te::srs::Spat
   return;
 }
 
+te::srs::SpatialReferenceSystemManager::srs_desc::srs_desc():
+  m_auth_id(0)
+{}
+
 te::srs::SpatialReferenceSystemManager::srs_desc::srs_desc(const std::string& name, unsigned int auth_id, const std::string& auth_name, const std::string& p4txt, const std::string& wkt):
   m_name(name),
   m_auth_id(auth_id),
@@ -82,6 +86,67 @@ te::srs::SpatialReferenceSystemManager::srs_desc::srid() const
   return ssrid;
 }
 
+te::srs::SpatialReferenceSystemManager::iterator::iterator():
+  m_catalog(0),
+  m_pos(0)
+{}
+
+te::srs::SpatialReferenceSystemManager::iterator::iterator(const SpatialReferenceSystemCatalog* catalog, std::size_t pos, set_iterator it):
+  m_catalog(catalog),
+  m_pos(pos),
+  m_it(it)
+{
+  fetch();
+}
+
+const te::srs::SpatialReferenceSystemManager::srs_desc&
+te::srs::SpatialReferenceSystemManager::iterator::operator*() const
+{
+  return *operator->();
+}
+
+const te::srs::SpatialReferenceSystemManager::srs_desc*
+te::srs::SpatialReferenceSystemManager::iterator::operator->() const
+{
+  if (m_catalog && m_pos < m_catalog->size())
+    return &m_current;
+
+  return &(*m_it);
+}
+
+te::srs::SpatialReferenceSystemManager::iterator&
+te::srs::SpatialReferenceSystemManager::iterator::operator++()
+{
+  if (m_catalog && m_pos < m_catalog->size())
+  {
+    ++m_pos;
+    fetch();
+  }
+  else
+    ++m_it;
+
+  return *this;
+}
+
+bool te::srs::SpatialReferenceSystemManager::iterator::operator==(const iterator& rhs) const
+{
+  return m_catalog == rhs.m_catalog && m_pos == rhs.m_pos && m_it == rhs.m_it;
+}
+
+bool te::srs::SpatialReferenceSystemManager::iterator::operator!=(const iterator& rhs) const
+{
+  return !operator==(rhs);
+}
+
+void te::srs::SpatialReferenceSystemManager::iterator::fetch()
+{
+  if (!m_catalog || m_pos >= m_catalog->size())
+    return;
+
+  m_current = srs_desc(m_catalog->getName(m_pos), m_catalog->getId(m_pos), m_catalog->getAuthName(m_pos),
+                       m_catalog->getP4Txt(m_pos), m_catalog->getWkt(m_pos));
+}
+
 te::srs::SpatialReferenceSystemManager::SpatialReferenceSystemManager()
 {
 }
@@ -93,9 +158,23 @@ te::srs::SpatialReferenceSystemManager::~SpatialReferenceSystemManager()
 
 void te::srs::SpatialReferenceSystemManager::init()
 {
-  if(!m_set.empty())
+  if(isInitialized())
     throw Exception(TE_TR("The spatial reference system manager is already initialized!"));
-  
+
+// the binary catalog generated at build time avoids parsing the JSON file
+#ifdef NDEBUG
+  std::string catalogf = te::core::FindInTerraLibPath("share/terralib/json/srs.bin");
+#else
+  std::string catalogf = te::core::FindInTerraLibPath("share/terralib/json/srs_incomplete.bin");
+#endif
+  if(!catalogf.empty() && SpatialReferenceSystemCatalog::isCatalog(catalogf))
+  {
+    init(catalogf);
+
+    if(isInitialized())
+      return;
+  }
+
 #ifdef NDEBUG
   std::string jsonf = te::core::FindInTerraLibPath("share/terralib/json/srs.json");
 #else
@@ -112,7 +191,11 @@ void te::srs::SpatialReferenceSystemManager::init(const std::string& fileName)
   try
   {
     clear();
-    LoadSpatialReferenceSystemManager(fileName, this);
+
+    if(SpatialReferenceSystemCatalog::isCatalog(fileName))
+      m_catalog.reset(new SpatialReferenceSystemCatalog(fileName));
+    else
+      LoadSpatialReferenceSystemManager(fileName, this);
   }
   catch(boost::property_tree::json_parser::json_parser_error &je)
   {
@@ -134,7 +217,8 @@ void te::srs::SpatialReferenceSystemManager::add(const std::string& name, const
   key += boost::lexical_cast<std::string>(id);
   
   boost::multi_index::nth_index<srs_set,0>::type::iterator it = boost::multi_index::get<0>(m_set).find(key);
-  if (it != boost::multi_index::get<0>(m_set).end())
+  if (it != boost::multi_index::get<0>(m_set).end() ||
+      (m_catalog.get() && m_catalog->find(id, authName) != SpatialReferenceSystemCatalog::npos))
     throw te::srs::Exception(TE_TR("The CS identification already exists in the manager.")); 
   
   srs_desc record(name, id, authName, p4Txt, wkt);
@@ -143,21 +227,10 @@ void te::srs::SpatialReferenceSystemManager::add(const std::string& name, const
 
 bool te::srs::SpatialReferenceSystemManager::recognizes(unsigned int id, const std::string& authName) const
 {
-  std::string key = authName;
-  key += ":";
-  key += boost::lexical_cast<std::string>(id);
-  
-  boost::multi_index::nth_index<srs_set,0>::type::iterator it = boost::multi_index::get<0>(m_set).find(key);
-  if (it == boost::multi_index::get<0>(m_set).end())
-  {
-    key = "USER";
-    key += ":";
-    key += boost::lexical_cast<std::string>(id);
-    it = boost::multi_index::get<0>(m_set).find(key);
-    return (it != boost::multi_index::get<0>(m_set).end());
-  }
-  else
-    return true;
+  const srs_desc* desc = 0;
+  std::size_t pos = SpatialReferenceSystemCatalog::npos;
+
+  return find(id, authName, desc, pos);
 }
 
 std::auto_ptr<te::srs::SpatialReferenceSystem> te::srs::SpatialReferenceSystemManager::getSpatialReferenceSystem(unsigned int id, const std::string& authName) const
@@ -180,75 +253,49 @@ std::auto_ptr<te::srs::SpatialReferenceSystem> te::srs::SpatialReferenceSystemMa
 
 std::string te::srs::SpatialReferenceSystemManager::getName(unsigned int id, const std::string& authName) const
 {
-  std::string key = authName;
-  key += ":";
-  key += boost::lexical_cast<std::string>(id);
-  
-  boost::multi_index::nth_index<srs_set,0>::type::iterator it = boost::multi_index::get<0>(m_set).find(key);
-  if (it == boost::multi_index::get<0>(m_set).end())
-  {
-    key = "USER";
-    key += ":";
-    key += boost::lexical_cast<std::string>(id);
-    it = boost::multi_index::get<0>(m_set).find(key);
-    if (it!=boost::multi_index::get<0>(m_set).end())
-      return it->m_name;
-  }
-  else
-    return it->m_name;
-  
-  return "";
+  const srs_desc* desc = 0;
+  std::size_t pos = SpatialReferenceSystemCatalog::npos;
+
+  if (!find(id, authName, desc, pos))
+    return "";
+
+  return desc ? desc->m_name : m_catalog->getName(pos);
 }
 
 std::string te::srs::SpatialReferenceSystemManager::getWkt(unsigned int id, const std::string& authName) const
 {
-  std::string key = authName;
-  key += ":";
-  key += boost::lexical_cast<std::string>(id);
-  
-  boost::multi_index::nth_index<srs_set,0>::type::iterator it = boost::multi_index::get<0>(m_set).find(key);
-  if (it==boost::multi_index::get<0>(m_set).end())
-  {
-    key = "USER";
-    key += ":";
-    key += boost::lexical_cast<std::string>(id);
-    it = boost::multi_index::get<0>(m_set).find(key);
-    if (it!=boost::multi_index::get<0>(m_set).end())
-      return it->m_wkt;
-  }
-  else
-    return it->m_wkt;
-  
-  return "";
+  const srs_desc* desc = 0;
+  std::size_t pos = SpatialReferenceSystemCatalog::npos;
+
+  if (!find(id, authName, desc, pos))
+    return "";
+
+  return desc ? desc->m_wkt : m_catalog->getWkt(pos);
 }
 
 std::string te::srs::SpatialReferenceSystemManager::getP4Txt(unsigned int id, const std::string& authName) const
 {
-  std::string key = authName;
-  key += ":";
-  key += boost::lexical_cast<std::string>(id);
-  
-  boost::multi_index::nth_index<srs_set,0>::type::iterator it = boost::multi_index::get<0>(m_set).find(key);
-  if (it==boost::multi_index::get<0>(m_set).end())
-  {
-    key = "USER";
-    key += ":";
-    key += boost::lexical_cast<std::string>(id);
-    it = boost::multi_index::get<0>(m_set).find(key);
-    if (it!=boost::multi_index::get<0>(m_set).end())
-      return it->m_p4txt;
-  }
-  else
-    return it->m_p4txt;
-  
-  return "";
+  const srs_desc* desc = 0;
+  std::size_t pos = SpatialReferenceSystemCatalog::npos;
+
+  if (!find(id, authName, desc, pos))
+    return "";
+
+  return desc ? desc->m_p4txt : m_catalog->getP4Txt(pos);
 }
 
 std::pair<std::string,unsigned int> te::srs::SpatialReferenceSystemManager::getIdFromName(const std::string& name) const
 { 
   boost::multi_index::nth_index<srs_set,1>::type::iterator it = boost::multi_index::get<1>(m_set).find(name);
-  if (it==boost::multi_index::get<1>(m_set).end()) 
-    throw te::srs::Exception(TE_TR("CS name not recognized."));
+  if (it==boost::multi_index::get<1>(m_set).end())
+  {
+    std::size_t pos = m_catalog.get() ? m_catalog->findByName(name) : SpatialReferenceSystemCatalog::npos;
+
+    if (pos == SpatialReferenceSystemCatalog::npos)
+      throw te::srs::Exception(TE_TR("CS name not recognized."));
+
+    return std::pair<std::string,unsigned int>(m_catalog->getAuthName(pos), m_catalog->getId(pos));
+  }
   
   return std::pair<std::string,unsigned int>(it->m_auth_name, it->m_auth_id);
 }
@@ -257,8 +304,15 @@ std::pair<std::string,unsigned int> te::srs::SpatialReferenceSystemManager::getI
 std::pair<std::string,unsigned int> te::srs::SpatialReferenceSystemManager::getIdFromP4Txt(const std::string& p4Txt) const
 {  
   boost::multi_index::nth_index<srs_set,2>::type::iterator it = boost::multi_index::get<2>(m_set).find(p4Txt);
-  if (it==boost::multi_index::get<2>(m_set).end()) 
-    throw te::srs::Exception(TE_TR("CS name not recognized."));
+  if (it==boost::multi_index::get<2>(m_set).end())
+  {
+    std::size_t pos = m_catalog.get() ? m_catalog->findByP4Txt(p4Txt) : SpatialReferenceSystemCatalog::npos;
+
+    if (pos == SpatialReferenceSystemCatalog::npos)
+      throw te::srs::Exception(TE_TR("CS name not recognized."));
+
+    return std::pair<std::string,unsigned int>(m_catalog->getAuthName(pos), m_catalog->getId(pos));
+  }
   
   return std::pair<std::string,unsigned int>(it->m_auth_name, it->m_auth_id);
 }
@@ -266,14 +320,23 @@ std::pair<std::string,unsigned int> te::srs::SpatialReferenceSystemManager::getI
 std::pair<std::string,unsigned int> te::srs::SpatialReferenceSystemManager::getIdFromWkt(const std::string& wkt) const
 { 
   boost::multi_index::nth_index<srs_set,3>::type::iterator it = boost::multi_index::get<3>(m_set).find(wkt);
-  if (it==boost::multi_index::get<3>(m_set).end()) 
-    throw te::srs::Exception(TE_TR("CS name not recognized."));
+  if (it==boost::multi_index::get<3>(m_set).end())
+  {
+    std::size_t pos = m_catalog.get() ? m_catalog->findByWkt(wkt) : SpatialReferenceSystemCatalog::npos;
+
+    if (pos == SpatialReferenceSystemCatalog::npos)
+      throw te::srs::Exception(TE_TR("CS name not recognized."));
+
+    return std::pair<std::string,unsigned int>(m_catalog->getAuthName(pos), m_catalog->getId(pos));
+  }
 
   return std::pair<std::string,unsigned int>(it->m_auth_name, it->m_auth_id);
 }
 
 void te::srs::SpatialReferenceSystemManager::remove(unsigned int id, const std::string& authName)
 { 
+  materialize();
+
   std::string key = authName;
   key += ":";
   key += boost::lexical_cast<std::string>(id);
@@ -295,18 +358,23 @@ void te::srs::SpatialReferenceSystemManager::remove(unsigned int id, const std::
 void te::srs::SpatialReferenceSystemManager::clear()
 {
   m_set.clear();
+  m_catalog.reset();
 }
 
 std::pair<te::srs::SpatialReferenceSystemManager::iterator,te::srs::SpatialReferenceSystemManager::iterator> 
 te::srs::SpatialReferenceSystemManager::getIterators() const
 {
+  const SpatialReferenceSystemCatalog* catalog = m_catalog.get();
+  std::size_t nrecords = catalog ? catalog->size() : 0;
+
   return std::pair<te::srs::SpatialReferenceSystemManager::iterator,
-                   te::srs::SpatialReferenceSystemManager::iterator>(boost::multi_index::get<0>(m_set).begin(), boost::multi_index::get<0>(m_set).end());
+                   te::srs::SpatialReferenceSystemManager::iterator>(iterator(catalog, 0, boost::multi_index::get<0>(m_set).begin()),
+                                                                     iterator(catalog, nrecords, boost::multi_index::get<0>(m_set).end()));
 }
 
 size_t te::srs::SpatialReferenceSystemManager::size() const
 {
-  return m_set.size();
+  return m_set.size() + (m_catalog.get() ? m_catalog->size() : 0);
 }
 
 te::common::UnitOfMeasurePtr te::srs::SpatialReferenceSystemManager::getUnit(unsigned int id, const std::string& authName)
@@ -339,24 +407,76 @@ bool te::srs::SpatialReferenceSystemManager::isGeographic(unsigned int id, const
 
 bool te::srs::SpatialReferenceSystemManager::isInitialized()
 {
-  bool initialized = !m_set.empty();
+  bool initialized = !m_set.empty() || m_catalog.get() != 0;
 
   return initialized;
 }
 
 std::string te::srs::SpatialReferenceSystemManager::getNewUserDefinedSRID()
 {
+  unsigned int val = 0;
+
+  if (m_catalog.get())
+  {
+    for (std::size_t i = 0; i < m_catalog->size(); ++i)
+    {
+      if (m_catalog->getAuthName(i) == "USER" && m_catalog->getId(i) > val)
+        val = m_catalog->getId(i);
+    }
+  }
+
   boost::multi_index::nth_index<srs_set,4>::type::iterator it = boost::multi_index::get<4>(m_set).find("USER");
-  if (it==boost::multi_index::get<4>(m_set).end())
-    return "100001";
-  
-  int val = it->m_auth_id;
-  ++it;
-  while (it != boost::multi_index::get<4>(m_set).end())
+  while (it != boost::multi_index::get<4>(m_set).end() && it->m_auth_name == "USER")
   {
     if (it->m_auth_id > val)
       val = it->m_auth_id;
     ++it;
   }
+
+  if (val == 0)
+    return "100001";
+
   return boost::lexical_cast<std::string>(val+1);
 }
+
+bool te::srs::SpatialReferenceSystemManager::find(unsigned int id, const std::string& authName, const srs_desc*& desc, std::size_t& pos) const
+{
+  const std::string authNames[] = { authName, "USER" };
+
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    if (!m_set.empty())
+    {
+      std::string key = authNames[i];
+      key += ":";
+      key += boost::lexical_cast<std::string>(id);
+
+      boost::multi_index::nth_index<srs_set,0>::type::iterator it = boost::multi_index::get<0>(m_set).find(key);
+      if (it != boost::multi_index::get<0>(m_set).end())
+      {
+        desc = &(*it);
+        return true;
+      }
+    }
+
+    if (m_catalog.get())
+    {
+      pos = m_catalog->find(id, authNames[i]);
+      if (pos != SpatialReferenceSystemCatalog::npos)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+void te::srs::SpatialReferenceSystemManager::materialize()
+{
+  if (!m_catalog.get())
+    return;
+
+  for (std::size_t i = 0; i < m_catalog->size(); ++i)
+    m_set.insert(srs_desc(m_catalog->getName(i), m_catalog->getId(i), m_catalog->getAuthName(i), m_catalog->getP4Txt(i), m_catalog->getWkt(i)));
+
+  m_catalog.reset();
+}
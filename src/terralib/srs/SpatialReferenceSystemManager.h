@@ -31,6 +31,7 @@
 #include "../common/UnitOfMeasure.h"
 #include "Config.h"
 #include "SpatialReferenceSystem.h"
+#include "SpatialReferenceSystemCatalog.h"
 
 // STL
 #include <map>
@@ -63,6 +64,12 @@ namespace te
      
       Refer to the <a href="http://www.spatialreference.org">Spatial Reference website</a> for more information about EPSG codes for SRS.
 
+     The descriptions shipped with TerraLib are read from a precomputed binary catalog when it is
+     available (see SpatialReferenceSystemCatalog): the lookups by identification use its hash table
+     and the texts are only copied when requested. The descriptions added later are kept in the manager.
+     getIterators() walks the catalog and then the added descriptions, without copying the catalog.
+     The catalog is copied into the manager only when a description is removed.
+
       \ingroup srs
     */
     class TESRSEXPORT SpatialReferenceSystemManager : public te::common::Singleton<SpatialReferenceSystemManager>
@@ -75,6 +82,8 @@ namespace te
        It is not visible outside this class. */
       struct srs_desc
       {
+        srs_desc();
+
         srs_desc(const std::string& name, unsigned int auth_id, const std::string& auth_name, const std::string& p4txt, const std::string& wkt);
         
         std::string srid() const;
@@ -106,12 +115,52 @@ namespace te
       
     private:
       
-      srs_set m_set;
+      srs_set m_set;                                              //!< The descriptions added to the manager.
+      std::unique_ptr<SpatialReferenceSystemCatalog> m_catalog;   //!< The descriptions read from a binary catalog.
       
     public:
       
-      //! An iterator by SRS <id,authority>
-      typedef boost::multi_index::nth_index<srs_set,0>::type::iterator iterator;
+      /*!
+       \class iterator
+
+       \brief A read-only forward iterator over the descriptions of the catalog followed by the added ones.
+
+       A description of the catalog is copied when the iterator reaches it.
+       The iterators are invalidated by add(), remove(), clear() and init().
+       */
+      class TESRSEXPORT iterator
+      {
+        friend class SpatialReferenceSystemManager;
+
+        public:
+
+          //! It creates an invalid iterator.
+          iterator();
+
+          const srs_desc& operator*() const;
+
+          const srs_desc* operator->() const;
+
+          iterator& operator++();
+
+          bool operator==(const iterator& rhs) const;
+
+          bool operator!=(const iterator& rhs) const;
+
+        private:
+
+          typedef boost::multi_index::nth_index<srs_set,0>::type::const_iterator set_iterator;
+
+          iterator(const SpatialReferenceSystemCatalog* catalog, std::size_t pos, set_iterator it);
+
+          //! It copies the catalog description at the current position.
+          void fetch();
+
+          const SpatialReferenceSystemCatalog* m_catalog;   //!< The catalog, if any.
+          std::size_t m_pos;                                //!< The position in the catalog, or its size past the catalog descriptions.
+          set_iterator m_it;                                //!< The position in the added descriptions.
+          srs_desc m_current;                               //!< The current catalog description.
+      };
       
       //! Destructor.
       ~SpatialReferenceSystemManager();
@@ -120,15 +169,16 @@ namespace te
        \brief Inializes the manager from a JSON file containing instances of SRSs
        
        This methods reads the file "TE_JSON_FILES_LOCATION/srs.json" for SRSs definitions and insert them on the manager if it is empty.
+       If the binary catalog generated from it at build time ("srs.bin") is found, it is used instead.
        \exception te::srs::Exception if the JSON file is not well formed.
        */
       void init();
 
       /*!
-       \brief Inializes the manager from a JSON file containing instances of SRSs.
+       \brief Inializes the manager from a JSON file or a binary catalog containing instances of SRSs.
 
-       \param fileName Name of the JSON file.
-       \exception te::srs::Exception if the JSON file is not well formed.
+       \param fileName Name of the JSON file or of the binary catalog.
+       \exception te::srs::Exception if the JSON file is not well formed or the catalog is not valid.
        */
       void init(const std::string& fileName);
       
@@ -225,6 +275,7 @@ namespace te
        
        The first iterator of the returned pair points to first coordinate system description.
        The second iterator of the returned pair points to the last plus one ccoordinate system description.
+       It does not change the manager, so it can be called while other threads look descriptions up.
        \return a pair of iterators pointing to the first and last coordnate system representation in the manager.
        */
       std::pair<te::srs::SpatialReferenceSystemManager::iterator,te::srs::SpatialReferenceSystemManager::iterator> getIterators() const;
@@ -258,6 +309,21 @@ namespace te
       SpatialReferenceSystemManager();
       
     private:
+
+      /*!
+       \brief It looks for a description, first given its authority and then as a user defined one.
+
+       \param id       The coordinate system identification.
+       \param authName The authority responsible for the id.
+       \param desc     It receives the description if it is in the manager.
+       \param pos      It receives the position of the description if it is in the catalog.
+
+       \return True if the description was found.
+       */
+      bool find(unsigned int id, const std::string& authName, const srs_desc*& desc, std::size_t& pos) const;
+
+      //! It copies the descriptions of the catalog into the manager and releases the catalog.
+      void materialize();
       
       /*!
        \brief Copy constructor not allowed.
@@ -0,0 +1,55 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+ \file terralib/srs/catalog/main.cpp
+
+ \brief A build tool that generates the binary SRS catalog from the JSON file with the SRS descriptions.
+
+ Usage: terralib_srs_catalog <srs JSON file> <catalog file>
+ */
+
+// TerraLib
+#include "../SpatialReferenceSystemCatalog.h"
+
+// STL
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+  if(argc != 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <srs JSON file> <catalog file>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    te::srs::SpatialReferenceSystemCatalog::build(argv[1], argv[2]);
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
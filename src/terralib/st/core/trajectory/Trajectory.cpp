@@ -30,7 +30,8 @@
 #include "../../../datatype/DateTimeUtils.h"
 #include "../../../geometry/Geometry.h"
 #include "../../../geometry/Utils.h"
-#include "../../../sam/rtree/Index.h"
+#include "../../../stmemory/SpatioTemporalIndex.h"
+#include "../../../stmemory/TemporalRange.h"
 
 //ST
 #include "Trajectory.h"
@@ -47,8 +48,8 @@ te::st::Trajectory::Trajectory()
     m_id("-1"),
     m_rtree()
 {  
-  //create the internal empty RTree 
-  m_rtree.reset(new te::sam::rtree::Index<te::dt::DateTime*>());
+  //create the internal empty spatio-temporal index
+  m_rtree.reset(new te::stmem::SpatioTemporalIndex<te::dt::DateTime*>());
 }
 
 te::st::Trajectory::Trajectory(const std::string& id)
@@ -57,8 +58,8 @@ te::st::Trajectory::Trajectory(const std::string& id)
     m_id(id),
     m_rtree()
 {  
-  //create the internal empty RTree 
-  m_rtree.reset(new te::sam::rtree::Index<te::dt::DateTime*>());
+  //create the internal empty spatio-temporal index
+  m_rtree.reset(new te::stmem::SpatioTemporalIndex<te::dt::DateTime*>());
 }
 
 te::st::Trajectory::Trajectory(AbstractTrajectoryInterp* interp, const std::string& id)
@@ -67,8 +68,8 @@ te::st::Trajectory::Trajectory(AbstractTrajectoryInterp* interp, const std::stri
     m_id(id),
     m_rtree()
 {  
-  //create the internal empty RTree 
-  m_rtree.reset(new te::sam::rtree::Index<te::dt::DateTime*>());
+  //create the internal empty spatio-temporal index
+  m_rtree.reset(new te::stmem::SpatioTemporalIndex<te::dt::DateTime*>());
 }
 
 te::st::Trajectory::Trajectory(const TrajectoryObservationSet& obs, const std::string& id)
@@ -77,8 +78,10 @@ te::st::Trajectory::Trajectory(const TrajectoryObservationSet& obs, const std::s
     m_id(id),
     m_rtree()
 {  
-  //create the internal empty RTree 
-  m_rtree.reset(new te::sam::rtree::Index<te::dt::DateTime*>());
+  //create the internal empty spatio-temporal index
+  m_rtree.reset(new te::stmem::SpatioTemporalIndex<te::dt::DateTime*>());
+
+  indexObservations();
 }
 
 te::st::Trajectory::Trajectory( const TrajectoryObservationSet& obs, AbstractTrajectoryInterp* interp, 
@@ -88,8 +91,10 @@ te::st::Trajectory::Trajectory( const TrajectoryObservationSet& obs, AbstractTra
     m_id(id),
     m_rtree()
 {
-  //create the internal empty RTree 
-  m_rtree.reset(new te::sam::rtree::Index<te::dt::DateTime*>());
+  //create the internal empty spatio-temporal index
+  m_rtree.reset(new te::stmem::SpatioTemporalIndex<te::dt::DateTime*>());
+
+  indexObservations();
 }
 
 te::st::Trajectory::Trajectory(const TrajectoryPatch& patch, AbstractTrajectoryInterp* interp, 
@@ -99,14 +104,14 @@ te::st::Trajectory::Trajectory(const TrajectoryPatch& patch, AbstractTrajectoryI
     m_id(id),
     m_rtree()
 {
-  //create the internal empty RTree 
-  m_rtree.reset(new te::sam::rtree::Index<te::dt::DateTime*>());
+  //create the internal empty spatio-temporal index
+  m_rtree.reset(new te::stmem::SpatioTemporalIndex<te::dt::DateTime*>());
   
   TrajectoryIterator it = patch.begin();
   while(it!=patch.end())
   {
-    //add shared pointers and creates the internal RTree
-    m_observations.insert(*it);  
+    //add shared pointers and updates the internal index
+    add(*it);
     ++it;
   }
 }
@@ -181,9 +186,12 @@ void te::st::Trajectory::add(te::dt::DateTime* time, te::gm::Geometry* geom)
 
 void te::st::Trajectory::add(const TrajectoryObservation& p)
 {
-  m_observations.insert(p);
+  //only the stored times can be indexed
+  if(!m_observations.insert(p).second)
+    return;
+
   const te::gm::Envelope* env = p.second->getMBR();
-  m_rtree->insert(*env, p.first.get());
+  m_rtree->insert(*env, p.first.get(), p.first.get());
 }
 
 std::size_t te::st::Trajectory::size() const
@@ -297,54 +305,14 @@ void
 te::st::Trajectory::getPatches(const te::gm::Envelope& g, te::gm::SpatialRelation r, 
                                   std::vector<TrajectoryPatch>& result) const
 {
-  //Note: the end iterator of a patch points to the position AFTER the last required observation 
   if(r!=te::gm::INTERSECTS)
     return;
 
   //times when the trajectory intersects the envelope
   std::vector<te::dt::DateTime*> report;
   m_rtree->search(g, report);
-  std::sort(report.begin(), report.end(), te::dt::CompareDateTime());
-
-  std::vector<te::dt::DateTime*>::const_iterator itResultBegin = report.begin();
-  std::vector<te::dt::DateTime*>::const_iterator itResultEnd = report.end();
-  
-  te::dt::DateTimeShrPtr shrdt(static_cast<te::dt::DateTime*>((*itResultBegin)->clone())); 
-  TrajectoryObservationSet::const_iterator itOriginBegin = m_observations.find(shrdt);
-  TrajectoryObservationSet::const_iterator itOriginEnd = m_observations.end();
 
-  TrajectoryObservationSet::const_iterator pathBegin;
-  TrajectoryObservationSet::const_iterator pathEnd;
-
-  while(itResultBegin!=itResultEnd && itOriginBegin!=itOriginEnd)
-  {
-     pathBegin = itOriginBegin; //The beginning of a patch
-
-     //Enquanto os ponteiros forem iguais estamos no meio de um patch
-     while( (itResultBegin!=itResultEnd) && (itOriginBegin!=itOriginEnd) && 
-            (*itResultBegin == itOriginBegin->first.get())) 
-     {
-        pathEnd = itOriginBegin;
-        ++itResultBegin;
-        ++itOriginBegin;
-     }
-
-     //get the patch
-     //the end of a patch MUST point to the position AFTER the required observations 
-     if(pathEnd!=itOriginEnd)
-      ++pathEnd;
-     TrajectoryPatch r(pathBegin, pathEnd);
-     result.push_back(r);
-
-     //update the origin begin
-     if(itResultBegin!=itResultEnd)
-     {
-       shrdt.reset(static_cast<te::dt::DateTime*>((*itResultBegin)->clone()));
-       itOriginBegin = m_observations.find(shrdt);
-     }
-  }
-  
-  return;
+  buildPatches(report, 0, result);
 }
 
 void 
@@ -354,171 +322,88 @@ te::st::Trajectory::getPatches(const te::gm::Geometry& geom, te::gm::SpatialRela
   if(r!=te::gm::INTERSECTS)
     return;
 
-  //times when the trajectory intersects the envelope
+  //times when the trajectory intersects the geometry envelope
   std::vector<te::dt::DateTime*> report;
   m_rtree->search(*geom.getMBR(), report);
-  
-  std::sort(report.begin(), report.end(), te::dt::CompareDateTime());
-
-  std::vector<te::dt::DateTime*>::const_iterator itResultBegin = report.begin();
-  std::vector<te::dt::DateTime*>::const_iterator itResultEnd = report.end();
 
-  te::dt::DateTimeShrPtr shrdt(static_cast<te::dt::DateTime*>((*itResultBegin)->clone()));
-  TrajectoryObservationSet::const_iterator itOriginBegin = m_observations.find(shrdt);
-  TrajectoryObservationSet::const_iterator itOriginEnd = m_observations.end();
-  
-  TrajectoryObservationSet::const_iterator pathBegin;
-  TrajectoryObservationSet::const_iterator pathEnd;
-   
-  while(itResultBegin!=itResultEnd && itOriginBegin!=itOriginEnd)
-  {
-     if(!geom.intersects(itOriginBegin->second.get())) //looking for a patch
-     {
-        ++itResultBegin;
-        if(itResultBegin!=itResultEnd)
-        {
-          shrdt.reset(static_cast<te::dt::DateTime*>((*itResultBegin)->clone()));
-          itOriginBegin = m_observations.find(shrdt);
-        }        
-     }
-     else //the beginning of a patch was found
-     {
-        pathBegin = itOriginBegin;
-        //enquanto os datetimes forem sequenciais e as geometrias interceptam geom estamos no meio do patch! 
-        while( itResultBegin!=itResultEnd && itOriginBegin!=itOriginEnd
-            && (*itResultBegin == itOriginBegin->first.get())
-            && geom.intersects(itOriginBegin->second.get()))
-        {
-            pathEnd = itOriginBegin;
-            ++itResultBegin;
-            if(itResultBegin!=itResultEnd)
-            {
-              shrdt.reset(static_cast<te::dt::DateTime*>((*itResultBegin)->clone()));
-              itOriginBegin = m_observations.find(shrdt);
-            }
-        }
-
-        //get the patch
-        //the end of a patch MUST point to the position AFTER the required observations
-        if(pathEnd!=itOriginEnd)
-          ++pathEnd; 
-        TrajectoryPatch r(pathBegin, pathEnd);
-        result.push_back(r);  
-
-     }//else
-  }//while
-     
-  return;  
+  buildPatches(report, &geom, result);
 }
 
-
 void te::st::Trajectory::getPatches(const te::gm::Envelope& e, te::gm::SpatialRelation sr, 
                       const te::dt::DateTime& dt, te::dt::TemporalRelation tr,
                       std::vector<TrajectoryPatch>& result) const
 {
-  //first: find the patch that satisfy the temporal relation
-  TrajectoryPatch res1 = getPatch(dt, tr);
-
-  //second: find the patches using the spatial relation
-  Trajectory tj(res1, m_interpolator, m_id);
-  std::vector<TrajectoryPatch> res2;
-  tj.getPatches(e, sr, res2); //sr: must be INTERSECTS for while
-    
-  std::vector<TrajectoryPatch>::const_iterator it = res2.begin();
+  if(sr!=te::gm::INTERSECTS)
+    return;
 
-  TrajectoryObservationSet::const_iterator itObsEnd = m_observations.end();
+  //times that satisfy the temporal relation when the trajectory intersects the envelope
+  std::vector<te::dt::DateTime*> report;
+  m_rtree->search(e, te::stmem::TemporalRange(&dt, tr), report);
 
-  while(it!=res2.end())
-  {
-    TrajectoryIterator itAuxBegin = (*it).begin();
-    TrajectoryIterator itAuxEnd = (*it).end();
+  buildPatches(report, 0, result);
+}
 
-    TrajectoryIterator itBegin(itObsEnd);
-    TrajectoryIterator itEnd(itObsEnd);
+void te::st::Trajectory::getPatches(const te::gm::Geometry& geom, te::gm::SpatialRelation sr, 
+                      const te::dt::DateTime& dt, te::dt::TemporalRelation tr,
+                      std::vector<TrajectoryPatch>& result) const
+{
+  if(sr!=te::gm::INTERSECTS)
+    return;
 
-    //Get the first position
-    if(itAuxBegin!=tj.end())
-    {
-      te::dt::DateTime* t = itAuxBegin.getTime();
-      itBegin = at(t);
-    }
+  //times that satisfy the temporal relation when the trajectory intersects the geometry envelope
+  std::vector<te::dt::DateTime*> report;
+  m_rtree->search(*geom.getMBR(), te::stmem::TemporalRange(&dt, tr), report);
 
-    //Get the last position
-    if(itAuxEnd==tj.end())
-      --itAuxEnd;
+  buildPatches(report, &geom, result);
+}
 
-    te::dt::DateTime* t = itAuxEnd.getTime();
-    itEnd = at(t);
-    ++itEnd;
+void te::st::Trajectory::getPatches(const te::gm::Geometry& geom, te::st::SpatioTemporalRelation str, 
+                    const std::vector<TrajectoryPatch>& result) const
+{
+}
 
-    //Get the patch
-    if(itBegin!=itEnd)
-    {
-      TrajectoryPatch p(itBegin, itEnd);
-      result.push_back(p);
-    }
-    
+void te::st::Trajectory::indexObservations()
+{
+  TrajectoryObservationSet::const_iterator it = m_observations.begin();
+  while(it != m_observations.end())
+  {
+    m_rtree->insert(*it->second->getMBR(), it->first.get(), it->first.get());
     ++it;
   }
-  
-  return;
 }
 
-void te::st::Trajectory::getPatches(const te::gm::Geometry& geom, te::gm::SpatialRelation sr, 
-                      const te::dt::DateTime& dt, te::dt::TemporalRelation tr,
-                      std::vector<TrajectoryPatch>& result) const
+void te::st::Trajectory::buildPatches(std::vector<te::dt::DateTime*>& report, const te::gm::Geometry* geom,
+                                      std::vector<TrajectoryPatch>& result) const
 {
-  //first: find the patch that satisfy the temporal relation
-  TrajectoryPatch res1 = getPatch(dt, tr);
-
-  //second: find the patches using the spatial relation
-  Trajectory tj(res1, m_interpolator, m_id);
-  std::vector<TrajectoryPatch> res2;
-  tj.getPatches(geom, sr, res2); //sr: must be INTERSECTS for while
-    
-  std::vector<TrajectoryPatch>::const_iterator it = res2.begin();
+  //Note: the end iterator of a patch points to the position AFTER the last required observation 
+  std::sort(report.begin(), report.end(), te::dt::CompareDateTime());
 
-  TrajectoryObservationSet::const_iterator itObsEnd = m_observations.end();
+  TrajectoryObservationSet::const_iterator itOriginEnd = m_observations.end();
 
-  while(it!=res2.end())
+  std::size_t i = 0;
+  while(i < report.size())
   {
-    TrajectoryIterator itAuxBegin = (*it).begin();
-    TrajectoryIterator itAuxEnd = (*it).end();
-
-    TrajectoryIterator itBegin(itObsEnd);
-    TrajectoryIterator itEnd(itObsEnd);
+    te::dt::DateTimeShrPtr shrdt(static_cast<te::dt::DateTime*>(report[i]->clone()));
+    TrajectoryObservationSet::const_iterator itOrigin = m_observations.find(shrdt);
 
-    //Get the first position
-    if(itAuxBegin!=tj.end())
+    if(itOrigin == itOriginEnd || (geom && !geom->intersects(itOrigin->second.get())))
     {
-      te::dt::DateTime* t = itAuxBegin.getTime();
-      itBegin = at(t);
+      ++i;
+      continue;
     }
 
-    //Get the last position
-    if(itAuxEnd==tj.end())
-      --itAuxEnd;
+    //the beginning of a patch was found: it goes on while the found times are consecutive observations
+    TrajectoryObservationSet::const_iterator pathBegin = itOrigin;
 
-    te::dt::DateTime* t = itAuxEnd.getTime();
-    itEnd = at(t);
-    ++itEnd;
-
-    //Get the patch
-    if(itBegin!=itEnd)
+    while(i < report.size() && itOrigin != itOriginEnd && report[i] == itOrigin->first.get() &&
+          (!geom || geom->intersects(itOrigin->second.get())))
     {
-      TrajectoryPatch p(itBegin, itEnd);
-      result.push_back(p);
+      ++i;
+      ++itOrigin;
     }
-    
-    ++it;
-  }
-  
-  return;
-}
 
-void te::st::Trajectory::getPatches(const te::gm::Geometry& geom, te::st::SpatioTemporalRelation str, 
-                    const std::vector<TrajectoryPatch>& result) const
-{
+    result.push_back(TrajectoryPatch(pathBegin, itOrigin));
+  }
 }
 
 std::auto_ptr<te::st::TimeSeries> te::st::Trajectory::getDistance(const Trajectory& other) const
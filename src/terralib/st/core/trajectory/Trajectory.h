@@ -27,7 +27,7 @@
 #define __TERRALIB_ST_INTERNAL_TRAJECTORY_H
 
 //TerraLib
-#include "../../../sam/rtree/Index.h"
+#include "../../../stmemory/SpatioTemporalIndex.h"
 
 //ST
 #include "../../Config.h"
@@ -56,7 +56,7 @@ namespace te
     class AbstractTrajectoryInterp;
        
     // Typedef
-    typedef boost::shared_ptr<te::sam::rtree::Index<te::dt::DateTime*> >  TjRTreeShrPtr; 
+    typedef boost::shared_ptr<te::stmem::SpatioTemporalIndex<te::dt::DateTime*> >  TjRTreeShrPtr; 
         
     /*!
       \class Trajectory
@@ -455,11 +455,26 @@ namespace te
         virtual ~Trajectory(); 
 
       private:
+
+        /*!
+          \brief It indexes the observations that were not added through the add methods.
+        */
+        void indexObservations();
+
+        /*!
+          \brief It groups the observations found by an index search into patches of consecutive observations.
+
+          \param report The times found by the index search.
+          \param geom   If not NULL, only the observations whose geometries intersect it are considered.
+          \param result The returned patches.
+        */
+        void buildPatches(std::vector<te::dt::DateTime*>& report, const te::gm::Geometry* geom,
+                          std::vector<TrajectoryPatch>& result) const;
                
         TrajectoryObservationSet       m_observations;    //!< The trajectory observations 
         AbstractTrajectoryInterp*      m_interpolator;    //!< The interpolator used to estimate non-observed times.
         std::string                    m_id;              //!< The trajectory identification.
-        TjRTreeShrPtr                  m_rtree;           //!< The RTree to index the trajectory geometries
+        TjRTreeShrPtr                  m_rtree;           //!< The spatio-temporal index of the trajectory geometries
       };
    } // end namespace st
 }   // end namespace te
@@ -28,6 +28,29 @@
 
 #define TE_STATISTICS_MODULE_NAME "te.stat"
 
+/*!
+  \def TE_STAT_TDIGEST_COMPRESSION
+
+  \brief It specifies the default compression of the t-digest used by the streaming summaries.
+
+  \note Higher values keep more centroids and give more accurate quantiles.
+*/
+#define TE_STAT_TDIGEST_COMPRESSION 200.0
+
+/*!
+  \def TE_STAT_STREAMING_MODE_CAPACITY
+
+  \brief It specifies the maximum number of distinct values counted by a streaming summary to find the mode.
+*/
+#define TE_STAT_STREAMING_MODE_CAPACITY 65536
+
+/*!
+  \def TE_STAT_STREAMING_BLOCK_SIZE
+
+  \brief It specifies the number of values read from a dataset before they are handed to a summary thread.
+*/
+#define TE_STAT_STREAMING_BLOCK_SIZE 65536
+
 /** @name DLL/LIB Module
  *  Flags for building TerraLib as a DLL or as a Static Library
  */
@@ -0,0 +1,415 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/statistics/core/StreamingSummary.cpp
+
+  \brief A summary of numerical values computed in a single pass.
+*/
+
+// TerraLib
+#include "NumericStatisticalSummary.h"
+#include "StreamingSummary.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace te
+{
+  namespace stat
+  {
+    /*! \brief The t-digest scale function: it limits the centroids sizes, mainly at the tails. */
+    inline double TDigestScale(double q, double compression)
+    {
+      static const double pi = 3.14159265358979323846;
+
+      return compression / (2.0 * pi) * std::asin(2.0 * std::min(std::max(q, 0.0), 1.0) - 1.0);
+    }
+  }
+}
+
+te::stat::StreamingSummary::StreamingSummary(double compression, std::size_t modeCapacity)
+  : m_compression(std::max(compression, 10.0)),
+    m_modeCapacity(modeCapacity)
+{
+  clear();
+}
+
+void te::stat::StreamingSummary::add(double value)
+{
+  ++m_count;
+
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_sum += value;
+
+  double delta = value - m_mean;
+  m_mean += delta / static_cast<double>(m_count);
+  m_m2 += delta * (value - m_mean);
+
+  Centroid c = { value, 1.0 };
+  m_buffer.push_back(c);
+
+  if(m_buffer.size() >= static_cast<std::size_t>(8.0 * m_compression))
+    compress();
+
+  if(!m_modeOverflow)
+  {
+    ++m_frequencies[value];
+
+    if(m_frequencies.size() > m_modeCapacity)
+    {
+      m_modeOverflow = true;
+      m_frequencies.clear();
+    }
+  }
+}
+
+void te::stat::StreamingSummary::addNull()
+{
+  ++m_nullCount;
+}
+
+void te::stat::StreamingSummary::merge(const StreamingSummary& rhs)
+{
+  m_nullCount += rhs.m_nullCount;
+
+  if(rhs.m_count == 0)
+    return;
+
+  if(m_count == 0)
+  {
+    std::size_t nullCount = m_nullCount;
+    *this = rhs;
+    m_nullCount = nullCount;
+    return;
+  }
+
+  const double na = static_cast<double>(m_count);
+  const double nb = static_cast<double>(rhs.m_count);
+  const double n = na + nb;
+  const double delta = rhs.m_mean - m_mean;
+
+  m_mean += delta * nb / n;
+  m_m2 += rhs.m_m2 + delta * delta * na * nb / n;
+  m_count += rhs.m_count;
+  m_sum += rhs.m_sum;
+  m_min = std::min(m_min, rhs.m_min);
+  m_max = std::max(m_max, rhs.m_max);
+
+  m_buffer.insert(m_buffer.end(), rhs.m_centroids.begin(), rhs.m_centroids.end());
+  m_buffer.insert(m_buffer.end(), rhs.m_buffer.begin(), rhs.m_buffer.end());
+  compress();
+
+  if(rhs.m_modeOverflow)
+  {
+    m_modeOverflow = true;
+  }
+  else if(!m_modeOverflow)
+  {
+    for(boost::unordered_map<double, std::size_t>::const_iterator it = rhs.m_frequencies.begin(); it != rhs.m_frequencies.end(); ++it)
+      m_frequencies[it->first] += it->second;
+
+    if(m_frequencies.size() > m_modeCapacity)
+      m_modeOverflow = true;
+  }
+
+  if(m_modeOverflow)
+    m_frequencies.clear();
+}
+
+void te::stat::StreamingSummary::clear()
+{
+  m_count = 0;
+  m_nullCount = 0;
+  m_min = std::numeric_limits<double>::max();
+  m_max = -std::numeric_limits<double>::max();
+  m_mean = 0.0;
+  m_m2 = 0.0;
+  m_sum = 0.0;
+  m_centroids.clear();
+  m_buffer.clear();
+  m_frequencies.clear();
+  m_modeOverflow = false;
+}
+
+std::size_t te::stat::StreamingSummary::getCount() const
+{
+  return m_count;
+}
+
+std::size_t te::stat::StreamingSummary::getNullCount() const
+{
+  return m_nullCount;
+}
+
+double te::stat::StreamingSummary::getMinimum() const
+{
+  return m_count ? m_min : 0.0;
+}
+
+double te::stat::StreamingSummary::getMaximum() const
+{
+  return m_count ? m_max : 0.0;
+}
+
+double te::stat::StreamingSummary::getSum() const
+{
+  return m_sum;
+}
+
+double te::stat::StreamingSummary::getMean() const
+{
+  return m_mean;
+}
+
+double te::stat::StreamingSummary::getVariance() const
+{
+  if(m_count < 2)
+    return 0.0;
+
+  return m_m2 / static_cast<double>(m_count - 1);
+}
+
+double te::stat::StreamingSummary::getStdDeviation() const
+{
+  return std::sqrt(getVariance());
+}
+
+std::vector<double> te::stat::StreamingSummary::getMode() const
+{
+  std::vector<double> mode;
+
+  if(m_modeOverflow)
+    return mode;
+
+  std::size_t repeat = 1;
+
+  for(boost::unordered_map<double, std::size_t>::const_iterator it = m_frequencies.begin(); it != m_frequencies.end(); ++it)
+  {
+    if(it->second < repeat)
+      continue;
+
+    if(it->second > repeat)
+    {
+      repeat = it->second;
+      mode.clear();
+    }
+
+    mode.push_back(it->first);
+  }
+
+  // as te::stat::Mode, a value must repeat to be a mode
+  if(repeat == 1)
+    mode.clear();
+
+  std::sort(mode.begin(), mode.end());
+
+  return mode;
+}
+
+bool te::stat::StreamingSummary::hasMode() const
+{
+  return !m_modeOverflow;
+}
+
+double te::stat::StreamingSummary::getQuantile(double q) const
+{
+  if(m_count == 0)
+    return 0.0;
+
+  if(q <= 0.0)
+    return m_min;
+
+  if(q >= 1.0)
+    return m_max;
+
+  compress();
+
+  const std::size_t n = m_centroids.size();
+
+  if(n == 1)
+    return m_centroids[0].m_mean;
+
+  const double t = q * static_cast<double>(m_count);
+
+  // left tail: between the minimum and the center of the first centroid
+  const Centroid& first = m_centroids[0];
+
+  if(t < first.m_weight / 2.0)
+    return m_min + (first.m_mean - m_min) * t / (first.m_weight / 2.0);
+
+  double cumulative = 0.0;
+
+  for(std::size_t i = 0; i < n - 1; ++i)
+  {
+    const Centroid& c1 = m_centroids[i];
+    const Centroid& c2 = m_centroids[i + 1];
+
+    double left = cumulative + c1.m_weight / 2.0;
+    double right = cumulative + c1.m_weight + c2.m_weight / 2.0;
+
+    if(t < right)
+      return c1.m_mean + (c2.m_mean - c1.m_mean) * (t - left) / (right - left);
+
+    cumulative += c1.m_weight;
+  }
+
+  // right tail: between the center of the last centroid and the maximum
+  const Centroid& last = m_centroids[n - 1];
+
+  double left = static_cast<double>(m_count) - last.m_weight / 2.0;
+
+  return last.m_mean + (m_max - last.m_mean) * (t - left) / (last.m_weight / 2.0);
+}
+
+double te::stat::StreamingSummary::getRank(double value) const
+{
+  if(m_count == 0 || value <= m_min)
+    return 0.0;
+
+  const double total = static_cast<double>(m_count);
+
+  if(value > m_max)
+    return total;
+
+  compress();
+
+  const std::size_t n = m_centroids.size();
+
+  const Centroid& first = m_centroids[0];
+
+  if(value < first.m_mean)
+    return (first.m_weight / 2.0) * (value - m_min) / (first.m_mean - m_min);
+
+  double cumulative = 0.0;
+
+  for(std::size_t i = 0; i < n - 1; ++i)
+  {
+    const Centroid& c1 = m_centroids[i];
+    const Centroid& c2 = m_centroids[i + 1];
+
+    if(value < c2.m_mean)
+    {
+      double left = cumulative + c1.m_weight / 2.0;
+      double right = cumulative + c1.m_weight + c2.m_weight / 2.0;
+
+      return left + (right - left) * (value - c1.m_mean) / (c2.m_mean - c1.m_mean);
+    }
+
+    cumulative += c1.m_weight;
+  }
+
+  const Centroid& last = m_centroids[n - 1];
+
+  double left = total - last.m_weight / 2.0;
+
+  if(m_max <= last.m_mean)
+    return left;
+
+  return left + (last.m_weight / 2.0) * (value - last.m_mean) / (m_max - last.m_mean);
+}
+
+void te::stat::StreamingSummary::getQuantileBreaks(std::size_t nSlices, std::vector<double>& breaks) const
+{
+  breaks.clear();
+
+  if(m_count == 0 || nSlices == 0)
+    return;
+
+  breaks.reserve(nSlices + 1);
+
+  breaks.push_back(m_min);
+
+  for(std::size_t i = 1; i < nSlices; ++i)
+    breaks.push_back(getQuantile(static_cast<double>(i) / static_cast<double>(nSlices)));
+
+  breaks.push_back(m_max);
+}
+
+void te::stat::StreamingSummary::fill(NumericStatisticalSummary& ss) const
+{
+  if(m_count == 0)
+    return;
+
+  ss.m_minVal = m_min;
+  ss.m_maxVal = m_max;
+  ss.m_sum = m_sum;
+  ss.m_count = static_cast<int>(m_count + m_nullCount);
+  ss.m_validCount = static_cast<int>(m_count);
+  ss.m_mean = m_mean;
+  ss.m_variance = getVariance();
+  ss.m_stdDeviation = std::sqrt(ss.m_variance);
+  ss.m_varCoeff = (100 * ss.m_stdDeviation) / ss.m_mean;
+  ss.m_amplitude = m_max - m_min;
+  ss.m_median = getQuantile(0.5);
+  ss.m_mode = getMode();
+}
+
+void te::stat::StreamingSummary::compress() const
+{
+  if(m_buffer.empty())
+    return;
+
+  std::vector<Centroid> all;
+  all.reserve(m_centroids.size() + m_buffer.size());
+  all.insert(all.end(), m_centroids.begin(), m_centroids.end());
+  all.insert(all.end(), m_buffer.begin(), m_buffer.end());
+
+  m_buffer.clear();
+
+  std::sort(all.begin(), all.end());
+
+  double total = 0.0;
+
+  for(std::size_t i = 0; i < all.size(); ++i)
+    total += all[i].m_weight;
+
+  m_centroids.clear();
+
+  Centroid current = all[0];
+
+  double weightSoFar = 0.0;
+
+  for(std::size_t i = 1; i < all.size(); ++i)
+  {
+    const Centroid& next = all[i];
+
+    double proposed = current.m_weight + next.m_weight;
+
+    double k0 = TDigestScale(weightSoFar / total, m_compression);
+    double k1 = TDigestScale((weightSoFar + proposed) / total, m_compression);
+
+    if(k1 - k0 <= 1.0)
+    {
+      current.m_mean += (next.m_mean - current.m_mean) * next.m_weight / proposed;
+      current.m_weight = proposed;
+    }
+    else
+    {
+      weightSoFar += current.m_weight;
+      m_centroids.push_back(current);
+      current = next;
+    }
+  }
+
+  m_centroids.push_back(current);
+}
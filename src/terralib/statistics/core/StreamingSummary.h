@@ -0,0 +1,181 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/statistics/core/StreamingSummary.h
+
+  \brief A summary of numerical values computed in a single pass.
+*/
+
+#ifndef __TERRALIB_STATISTICAL_CORE_INTERNAL_STREAMINGSUMMARY_H
+#define __TERRALIB_STATISTICAL_CORE_INTERNAL_STREAMINGSUMMARY_H
+
+// TerraLib
+#include "Config.h"
+
+// STL
+#include <cstddef>
+#include <vector>
+
+// Boost
+#include <boost/unordered_map.hpp>
+
+namespace te
+{
+  namespace stat
+  {
+    struct NumericStatisticalSummary;
+
+    /*!
+      \class StreamingSummary
+
+      \brief A summary of numerical values computed in a single pass.
+
+      \details The count, minimum, maximum, mean and variance are exact. The quantiles
+               are estimated by a merging t-digest, whose error is lower at the tails.
+               The mode is exact while the number of distinct values does not exceed
+               the mode capacity; beyond it the mode is not tracked anymore.
+
+               Summaries of disjoint sets of values can be merged, so a set can be
+               split among several threads.
+    */
+    class TESTATEXPORT StreamingSummary
+    {
+      public:
+
+        /*!
+          \brief Constructor.
+
+          \param compression  The t-digest compression.
+          \param modeCapacity The maximum number of distinct values counted to find the mode.
+        */
+        explicit StreamingSummary(double compression = TE_STAT_TDIGEST_COMPRESSION,
+                                  std::size_t modeCapacity = TE_STAT_STREAMING_MODE_CAPACITY);
+
+        /*! \brief It adds a value. */
+        void add(double value);
+
+        /*! \brief It counts a null value. */
+        void addNull();
+
+        /*!
+          \brief It adds the values summarized by another summary.
+
+          \param rhs A summary of a disjoint set of values.
+        */
+        void merge(const StreamingSummary& rhs);
+
+        /*! \brief It clears the summary. */
+        void clear();
+
+        /*! \brief It returns the number of values. */
+        std::size_t getCount() const;
+
+        /*! \brief It returns the number of null values. */
+        std::size_t getNullCount() const;
+
+        double getMinimum() const;
+
+        double getMaximum() const;
+
+        double getSum() const;
+
+        double getMean() const;
+
+        /*! \brief It returns the sample variance. */
+        double getVariance() const;
+
+        double getStdDeviation() const;
+
+        /*!
+          \brief It returns the most frequent values.
+
+          \return The modes or an empty vector if the mode was not tracked.
+        */
+        std::vector<double> getMode() const;
+
+        /*! \brief It returns true if the mode is known. */
+        bool hasMode() const;
+
+        /*!
+          \brief It estimates a quantile.
+
+          \param q The quantile, in the range [0, 1].
+        */
+        double getQuantile(double q) const;
+
+        /*!
+          \brief It estimates the number of values lower than a given one.
+
+          \param value A given value.
+        */
+        double getRank(double value) const;
+
+        /*!
+          \brief It estimates the breaks that split the values in slices with the same number of values.
+
+          \param nSlices The number of slices.
+          \param breaks  The nSlices + 1 breaks, from the minimum to the maximum.
+        */
+        void getQuantileBreaks(std::size_t nSlices, std::vector<double>& breaks) const;
+
+        /*!
+          \brief It fills the fields of a statistical summary that can be computed in a single pass.
+
+          \note The skewness and kurtosis are not filled and the median is estimated.
+        */
+        void fill(NumericStatisticalSummary& ss) const;
+
+      protected:
+
+        struct Centroid
+        {
+          double m_mean;
+          double m_weight;
+
+          bool operator<(const Centroid& rhs) const { return m_mean < rhs.m_mean; }
+        };
+
+        /*! \brief It merges the buffered values into the centroids. */
+        void compress() const;
+
+      private:
+
+        double m_compression;
+        std::size_t m_modeCapacity;
+
+        std::size_t m_count;
+        std::size_t m_nullCount;
+        double m_min;
+        double m_max;
+        double m_mean;
+        double m_m2;                  //!< The sum of the squared differences from the mean.
+        double m_sum;
+
+        mutable std::vector<Centroid> m_centroids;
+        mutable std::vector<Centroid> m_buffer;
+
+        boost::unordered_map<double, std::size_t> m_frequencies;
+        bool m_modeOverflow;
+    };
+
+  } // end namespace stat
+}   // end namespace te
+
+#endif  // __TERRALIB_STATISTICAL_CORE_INTERNAL_STREAMINGSUMMARY_H
@@ -24,6 +24,8 @@
  */
 
 //Terralib
+#include "../../common/PlatformUtils.h"
+#include "../../core/translator/Translator.h"
 #include "../../dataaccess/query_h.h"
 #include "../../dataaccess/dataset/DataSet.h"
 #include "../../dataaccess/dataset/DataSetType.h"
@@ -35,6 +37,7 @@
 #include "../../datatype/Property.h"
 #include "../../maptools/AbstractLayer.h"
 #include "../../maptools/DataSetLayer.h"
+#include "../../memory/ColumnarDataSet.h"
 #include "Config.h"
 #include "Exception.h"
 #include "SummaryFunctions.h"
@@ -42,9 +45,11 @@
 
 // BOOST
 #include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
 
 //STL
 #include <algorithm>
+#include <deque>
 #include <map>
 #include <numeric>
 #include <vector>
@@ -59,6 +64,95 @@ namespace te
       return (x.real() < y.real()) ||
           (x.real() == y.real() && x.imag() < y.imag());
     }
+
+    /*! \brief The blocks of values read from a dataset and waiting to be summarized. */
+    struct StreamingSummaryJob
+    {
+      std::deque<std::vector<double>*> m_blocks;
+      std::size_t m_maxBlocks;
+      bool m_done;
+      boost::mutex m_mtx;
+      boost::condition_variable m_blockReady;
+      boost::condition_variable m_blockTaken;
+    };
+
+    void StreamingSummaryThreadEntry(StreamingSummaryJob* job, StreamingSummary* ss)
+    {
+      while(true)
+      {
+        std::auto_ptr<std::vector<double> > block;
+
+        {
+          boost::unique_lock<boost::mutex> lock(job->m_mtx);
+
+          while(job->m_blocks.empty() && !job->m_done)
+            job->m_blockReady.wait(lock);
+
+          if(job->m_blocks.empty())
+            return;
+
+          block.reset(job->m_blocks.front());
+          job->m_blocks.pop_front();
+        }
+
+        job->m_blockTaken.notify_one();
+
+        for(std::size_t i = 0; i < block->size(); ++i)
+          ss->add((*block)[i]);
+      }
+    }
+
+    void StreamingSummaryColumnThreadEntry(const double* values, const std::vector<bool>* nulls,
+                                           std::size_t begin, std::size_t end, StreamingSummary* ss)
+    {
+      for(std::size_t i = begin; i < end; ++i)
+      {
+        if((*nulls)[i])
+          ss->addNull();
+        else
+          ss->add(values[i]);
+      }
+    }
+
+    bool GetNumericValue(te::da::DataSet* dataSet, std::size_t pos, int type, double& value)
+    {
+      switch(type)
+      {
+        case te::dt::INT16_TYPE:
+          value = dataSet->getInt16(pos);
+          return true;
+
+        case te::dt::INT32_TYPE:
+          value = dataSet->getInt32(pos);
+          return true;
+
+        case te::dt::INT64_TYPE:
+          value = (double)dataSet->getInt64(pos);
+          return true;
+
+        case te::dt::FLOAT_TYPE:
+          value = dataSet->getFloat(pos);
+          return true;
+
+        case te::dt::DOUBLE_TYPE:
+          value = dataSet->getDouble(pos);
+          return true;
+
+        case te::dt::NUMERIC_TYPE:
+          try
+          {
+            value = boost::lexical_cast<double>(dataSet->getNumeric(pos));
+            return true;
+          }
+          catch(const boost::bad_lexical_cast&)
+          {
+            return false;
+          }
+
+        default:
+          return false;
+      }
+    }
   }
 }
 
@@ -550,3 +644,157 @@ void te::stat::GetNumericStatisticalSummaryQuery(const std::string& inDataset,
     ss.m_amplitude = boost::lexical_cast<double>(dsQuery->getAsString(7));
   }
 }
+
+void te::stat::GetNumericStreamingSummary(te::da::DataSet* dataSet,
+                                          const std::string& propName,
+                                          te::stat::StreamingSummary& ss,
+                                          std::size_t nThreads)
+{
+  const std::size_t pos = te::da::GetPropertyPos(dataSet, propName);
+
+  if(pos >= dataSet->getNumProperties())
+    throw te::stat::Exception(TE_TR("The property was not found in the dataset!"));
+
+  const int type = dataSet->getPropertyDataType(pos);
+
+  if(type != te::dt::INT16_TYPE && type != te::dt::INT32_TYPE && type != te::dt::INT64_TYPE &&
+     type != te::dt::FLOAT_TYPE && type != te::dt::DOUBLE_TYPE && type != te::dt::NUMERIC_TYPE)
+    throw te::stat::Exception(TE_TR("The property is not a numeric one!"));
+
+  if(nThreads == 0)
+    nThreads = std::max<std::size_t>(1, te::common::GetPhysProcNumber());
+
+  std::vector<te::stat::StreamingSummary> partials(nThreads);
+
+  // a columnar double column is split among the threads with no copy
+  te::mem::ColumnarDataSet* cds = dynamic_cast<te::mem::ColumnarDataSet*>(dataSet);
+
+  if(cds && type == te::dt::DOUBLE_TYPE)
+  {
+    const double* values = cds->getDoubleColumn(pos);
+    const std::vector<bool>& nulls = cds->getNulls(pos);
+    const std::size_t size = cds->size();
+
+    const std::size_t step = (size + nThreads - 1) / nThreads;
+
+    boost::thread_group threads;
+
+    for(std::size_t i = 0; i < nThreads; ++i)
+    {
+      std::size_t begin = std::min(i * step, size);
+      std::size_t end = std::min(begin + step, size);
+
+      threads.add_thread(new boost::thread(StreamingSummaryColumnThreadEntry, values, &nulls, begin, end, &partials[i]));
+    }
+
+    threads.join_all();
+
+    for(std::size_t i = 0; i < nThreads; ++i)
+      ss.merge(partials[i]);
+
+    return;
+  }
+
+  if(nThreads == 1)
+  {
+    double value = 0.0;
+
+    dataSet->moveBeforeFirst();
+
+    while(dataSet->moveNext())
+    {
+      if(dataSet->isNull(pos))
+        ss.addNull();
+      else if(GetNumericValue(dataSet, pos, type, value))
+        ss.add(value);
+    }
+
+    return;
+  }
+
+  StreamingSummaryJob job;
+  job.m_maxBlocks = 2 * nThreads;
+  job.m_done = false;
+
+  boost::thread_group threads;
+
+  for(std::size_t i = 0; i < nThreads; ++i)
+    threads.add_thread(new boost::thread(StreamingSummaryThreadEntry, &job, &partials[i]));
+
+  std::auto_ptr<std::vector<double> > block;
+
+  try
+  {
+    double value = 0.0;
+
+    dataSet->moveBeforeFirst();
+
+    while(dataSet->moveNext())
+    {
+      if(dataSet->isNull(pos))
+      {
+        ss.addNull();
+        continue;
+      }
+
+      if(!GetNumericValue(dataSet, pos, type, value))
+        continue;
+
+      if(block.get() == 0)
+      {
+        block.reset(new std::vector<double>);
+        block->reserve(TE_STAT_STREAMING_BLOCK_SIZE);
+      }
+
+      block->push_back(value);
+
+      if(block->size() < TE_STAT_STREAMING_BLOCK_SIZE)
+        continue;
+
+      {
+        boost::unique_lock<boost::mutex> lock(job.m_mtx);
+
+        while(job.m_blocks.size() >= job.m_maxBlocks)
+          job.m_blockTaken.wait(lock);
+
+        job.m_blocks.push_back(block.release());
+      }
+
+      job.m_blockReady.notify_one();
+    }
+
+    {
+      boost::lock_guard<boost::mutex> lock(job.m_mtx);
+
+      if(block.get())
+        job.m_blocks.push_back(block.release());
+
+      job.m_done = true;
+    }
+
+    job.m_blockReady.notify_all();
+  }
+  catch(...)
+  {
+    {
+      boost::lock_guard<boost::mutex> lock(job.m_mtx);
+
+      for(std::size_t i = 0; i < job.m_blocks.size(); ++i)
+        delete job.m_blocks[i];
+
+      job.m_blocks.clear();
+      job.m_done = true;
+    }
+
+    job.m_blockReady.notify_all();
+
+    threads.join_all();
+
+    throw;
+  }
+
+  threads.join_all();
+
+  for(std::size_t i = 0; i < nThreads; ++i)
+    ss.merge(partials[i]);
+}
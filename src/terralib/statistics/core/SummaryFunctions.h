@@ -31,6 +31,7 @@
 #include "Enums.h"
 #include "NumericStatisticalSummary.h"
 #include "NumericStatisticalComplexSummary.h"
+#include "StreamingSummary.h"
 #include "StringStatisticalSummary.h"
 
 // STL
@@ -40,7 +41,11 @@
 
 namespace te
 {
-  namespace da { class DataSource; }
+  namespace da
+  {
+    class DataSet;
+    class DataSource;
+  }
   
   namespace stat
   {
@@ -139,6 +144,22 @@ namespace te
                                                         const std::string& propName,
                                                         te::stat::NumericStatisticalSummary& ss);
     
+    /*! Fills a streaming summary of a given numerical property from a dataset in a single pass.
+
+     \details The dataset is read by the calling thread and the values are summarized in blocks by
+              a pool of threads, whose partial summaries are merged at the end. The values of a
+              te::mem::ColumnarDataSet double column are summarized without being copied.
+
+     \param dataSet  a pointer to a dataset, traversed from its first item. Do not pass null.
+     \param propName the name of the numerical property to be summarized.
+     \param ss       to return the summary.
+     \param nThreads the number of summary threads; 0 means the number of processors.
+     */
+    TESTATEXPORT void GetNumericStreamingSummary(te::da::DataSet* dataSet,
+                                                 const std::string& propName,
+                                                 te::stat::StreamingSummary& ss,
+                                                 std::size_t nThreads = 0);
+    
   } // end namespace stat
 }   // end namespace te
 
@@ -26,6 +26,8 @@
 // TerraLib
 #include "../../core/translator/Translator.h"
 #include "../../dataaccess/dataset/DataSet.h"
+#include "../../dataaccess/utils/Utils.h"
+#include "../../memory/ColumnarDataSet.h"
 #include "Config.h"
 #include "Enums.h"
 #include "Exception.h"
@@ -153,6 +155,20 @@ std::vector<std::string> te::stat::GetStringData(te::da::DataSet* dataSet, const
   std::vector<std::string> result;
   std::string value="";
 
+  // the columnar datasets hand over the whole column at once
+  te::mem::ColumnarDataSet* cds = dynamic_cast<te::mem::ColumnarDataSet*>(dataSet);
+
+  if(cds)
+  {
+    std::size_t pos = te::da::GetPropertyPos(cds, propName);
+
+    if(cds->getPropertyDataType(pos) == te::dt::STRING_TYPE)
+    {
+      cds->getStringValues(pos, result);
+      return result;
+    }
+  }
+
   dataSet->moveFirst();
 
   do
@@ -178,6 +194,16 @@ std::vector<double> te::stat::GetNumericData(te::da::DataSet* dataSet, const std
       break;
   
   std::size_t type = dataSet->getPropertyDataType(index);
+
+  te::mem::ColumnarDataSet* cds = dynamic_cast<te::mem::ColumnarDataSet*>(dataSet);
+
+  if(cds && (type == te::dt::INT16_TYPE || type == te::dt::INT32_TYPE || type == te::dt::INT64_TYPE ||
+              type == te::dt::FLOAT_TYPE || type == te::dt::DOUBLE_TYPE || type == te::dt::NUMERIC_TYPE))
+  {
+    cds->getDoubleValues(index, result);
+    return result;
+  }
+
   dataSet->moveFirst();
   do
   {
@@ -43,17 +43,17 @@
 #include "../geometry/GeometryProperty.h"
 #include "../geometry/Utils.h"
 #include "../memory/DataSetItem.h"
-#include "../sam/rtree/Index.h"
 
 #include "DataSet.h"
 #include "Exception.h"
+#include "TemporalRange.h"
 
 // STL
 #include <limits>
 
 te::stmem::DataSet::DataSet(const te::da::DataSetType* type, int tpPropIdx)
   : m_items(),
-    m_RTree(),  
+    m_STIndex(),
     m_iterator(),
     m_beforeFirst(true),  
     m_pnames(),
@@ -64,13 +64,13 @@ te::stmem::DataSet::DataSet(const te::da::DataSetType* type, int tpPropIdx)
 {
   te::da::GetPropertyInfo(type, m_pnames, m_ptypes);
 
-  //create the internal empty RTree 
-  m_RTree.reset(new te::sam::rtree::Index<te::mem::DataSetItem*>());
+  //create the internal empty spatio-temporal index
+  m_STIndex.reset(new SpatioTemporalIndex<te::mem::DataSetItem*>());
 }
 
 te::stmem::DataSet::DataSet(const te::da::DataSetType* type, int tpPropIdx, int gmPropIdx)
   : m_items(),
-    m_RTree(),  
+    m_STIndex(),
     m_iterator(),
     m_beforeFirst(true),  
     m_pnames(),
@@ -81,14 +81,14 @@ te::stmem::DataSet::DataSet(const te::da::DataSetType* type, int tpPropIdx, int
 {
   te::da::GetPropertyInfo(type, m_pnames, m_ptypes);
 
-  //create the internal empty RTree 
-  m_RTree.reset(new te::sam::rtree::Index<te::mem::DataSetItem*>());
+  //create the internal empty spatio-temporal index
+  m_STIndex.reset(new SpatioTemporalIndex<te::mem::DataSetItem*>());
 }
 
 te::stmem::DataSet::DataSet( const te::da::DataSetType* type, int begTimePropIdx, 
                              int endTimePropIdx, int gmPropIdx)
   : m_items(),
-    m_RTree(),  
+    m_STIndex(),
     m_iterator(),
     m_beforeFirst(true),  
     m_pnames(),
@@ -99,14 +99,14 @@ te::stmem::DataSet::DataSet( const te::da::DataSetType* type, int begTimePropIdx
 {
   te::da::GetPropertyInfo(type, m_pnames, m_ptypes);
 
-  //create the internal empty RTree 
-  m_RTree.reset(new te::sam::rtree::Index<te::mem::DataSetItem*>());
+  //create the internal empty spatio-temporal index
+  m_STIndex.reset(new SpatioTemporalIndex<te::mem::DataSetItem*>());
 }
 
 te::stmem::DataSet::DataSet(const std::vector<std::string>& pnames, const std::vector<int>& ptypes,
                             int begTimePropIdx, int endTimePropIdx, int gmPropIdx)
   : m_items(),
-    m_RTree(),  
+    m_STIndex(),
     m_iterator(),
     m_beforeFirst(true),  
     m_pnames(pnames),
@@ -115,13 +115,13 @@ te::stmem::DataSet::DataSet(const std::vector<std::string>& pnames, const std::v
     m_endTimePropIdx(endTimePropIdx),
     m_geomPropIdx(gmPropIdx)
 {
-  //create the internal empty RTree 
-  m_RTree.reset(new te::sam::rtree::Index<te::mem::DataSetItem*>());
+  //create the internal empty spatio-temporal index
+  m_STIndex.reset(new SpatioTemporalIndex<te::mem::DataSetItem*>());
 }
 
 te::stmem::DataSet::DataSet(te::da::DataSet* ds, int tpPropIdx, int gmPropIdx, unsigned int limit)
   : m_items(),
-    m_RTree(),  
+    m_STIndex(),
     m_iterator(),
     m_beforeFirst(true),  
     m_pnames(),
@@ -132,8 +132,8 @@ te::stmem::DataSet::DataSet(te::da::DataSet* ds, int tpPropIdx, int gmPropIdx, u
 {
   te::da::GetPropertyInfo(ds, m_pnames, m_ptypes);
 
-  //create the internal empty RTree 
-  m_RTree.reset(new te::sam::rtree::Index<te::mem::DataSetItem*>());
+  //create the internal empty spatio-temporal index
+  m_STIndex.reset(new SpatioTemporalIndex<te::mem::DataSetItem*>());
   
   //copy the items
   copy(ds, limit);
@@ -141,7 +141,7 @@ te::stmem::DataSet::DataSet(te::da::DataSet* ds, int tpPropIdx, int gmPropIdx, u
 
 te::stmem::DataSet::DataSet(te::da::DataSet* ds, int begTimePropIdx, int endTimePropIdx, int gmPropIdx, unsigned int limit)
   : m_items(),
-    m_RTree(),  
+    m_STIndex(),
     m_iterator(),
     m_beforeFirst(true),  
     m_pnames(),
@@ -152,8 +152,8 @@ te::stmem::DataSet::DataSet(te::da::DataSet* ds, int begTimePropIdx, int endTime
 {
   te::da::GetPropertyInfo(ds, m_pnames, m_ptypes);
 
-  //create the internal empty RTree 
-  m_RTree.reset(new te::sam::rtree::Index<te::mem::DataSetItem*>());
+  //create the internal empty spatio-temporal index
+  m_STIndex.reset(new SpatioTemporalIndex<te::mem::DataSetItem*>());
   
   //copy the items
   copy(ds, limit);
@@ -161,7 +161,7 @@ te::stmem::DataSet::DataSet(te::da::DataSet* ds, int begTimePropIdx, int endTime
 
 te::stmem::DataSet::DataSet(const DataSet& rhs, const bool deepCopy)
   : m_items(),
-    m_RTree(),  
+    m_STIndex(),
     m_iterator(),
     m_beforeFirst(true),  
     m_pnames(rhs.m_pnames),
@@ -170,17 +170,17 @@ te::stmem::DataSet::DataSet(const DataSet& rhs, const bool deepCopy)
     m_endTimePropIdx(rhs.m_endTimePropIdx),
     m_geomPropIdx(rhs.m_geomPropIdx)
 {
-  //create the internal empty RTree 
-  m_RTree.reset(new te::sam::rtree::Index<te::mem::DataSetItem*>());
+  //create the internal empty spatio-temporal index
+  m_STIndex.reset(new SpatioTemporalIndex<te::mem::DataSetItem*>());
 
   TimeToDataSetItemMap::const_iterator it = rhs.m_items.begin();
   while(it != rhs.m_items.end())
   {
     if(deepCopy)
       //clone the DataSetItem
-      add(it->second->clone().release()); //add to m_items and m_RTree
+      add(it->second->clone().release()); //add to m_items and m_STIndex
     else
-      add(*it); //add to m_items and m_RTree
+      add(*it); //add to m_items and m_STIndex
 
     ++it;
   }
@@ -190,7 +190,7 @@ te::stmem::DataSet& te::stmem::DataSet::operator= (const te::stmem::DataSet& oth
 {
   if (this != &other) 
   {
-    m_RTree.reset(new te::sam::rtree::Index<te::mem::DataSetItem*>());
+    m_STIndex.reset(new SpatioTemporalIndex<te::mem::DataSetItem*>());
     m_beforeFirst = true;
     m_pnames = other.m_pnames;
     m_ptypes = other.m_ptypes;
@@ -202,7 +202,7 @@ te::stmem::DataSet& te::stmem::DataSet::operator= (const te::stmem::DataSet& oth
     TimeToDataSetItemMap::const_iterator it = other.m_items.begin();
     while(it != other.m_items.end())
     {
-      add(*it); //add to m_items and m_RTree
+      add(*it); //add to m_items and m_STIndex
       ++it;
     }   
   }
@@ -291,7 +291,7 @@ void te::stmem::DataSet::add(const std::pair<te::dt::DateTime*, DateSetItemShrPt
   te::dt::DateTime* dt = static_cast<te::dt::DateTime*>(p.first->clone());
   m_items.insert(std::pair<te::dt::DateTime*, DateSetItemShrPtr>(dt,p.second)); 
    
-  //insert into the RTree
+  //insert into the spatio-temporal index
   if(m_geomPropIdx<0)
     return;
 
@@ -299,7 +299,7 @@ void te::stmem::DataSet::add(const std::pair<te::dt::DateTime*, DateSetItemShrPt
   if(geom.get()!=0)
   {
     const te::gm::Envelope* env = geom->getMBR();
-    m_RTree->insert(*env, p.second.get());
+    m_STIndex->insert(*env, dt, p.second.get());
   }     
   return; 
 }
@@ -359,7 +359,7 @@ std::auto_ptr<te::stmem::DataSet> te::stmem::DataSet::filter(const te::gm::Envel
     return std::auto_ptr<te::stmem::DataSet>(0);
   
   std::vector<te::mem::DataSetItem*> report;
-  m_RTree->search(*e, report);
+  m_STIndex->search(*e, report);
 
   std::auto_ptr<te::stmem::DataSet> result(new DataSet(m_pnames, m_ptypes, m_begTimePropIdx, m_endTimePropIdx, m_geomPropIdx));
 
@@ -375,7 +375,7 @@ std::auto_ptr<te::stmem::DataSet> te::stmem::DataSet::filter(const te::gm::Geome
     return std::auto_ptr<te::stmem::DataSet>(0);
   
   std::vector<te::mem::DataSetItem*> report;
-  m_RTree->search(*g->getMBR(), report);
+  m_STIndex->search(*g->getMBR(), report);
 
   std::auto_ptr<te::stmem::DataSet> result(new DataSet(m_pnames, m_ptypes, m_begTimePropIdx, m_endTimePropIdx, m_geomPropIdx));
 
@@ -446,15 +446,38 @@ std::auto_ptr<te::stmem::DataSet> te::stmem::DataSet::filter(const te::dt::DateT
 std::auto_ptr<te::stmem::DataSet> te::stmem::DataSet::filter(const te::gm::Envelope* e, te::gm::SpatialRelation r, 
                                       const te::dt::DateTime* dt, te::dt::TemporalRelation tr) const
 {
-  std::auto_ptr<te::stmem::DataSet> result1 = filter(e,r);
-  return result1->filter(dt, tr);
+  if(r!=te::gm::INTERSECTS)
+    return std::auto_ptr<te::stmem::DataSet>(0);
+
+  std::vector<te::mem::DataSetItem*> report;
+  m_STIndex->search(*e, TemporalRange(dt, tr), report);
+
+  std::auto_ptr<te::stmem::DataSet> result(new DataSet(m_pnames, m_ptypes, m_begTimePropIdx, m_endTimePropIdx, m_geomPropIdx));
+
+  for(unsigned int i=0; i<report.size(); ++i)
+    result->add(report[i]->clone().release());
+
+  return result;
 }
 
 std::auto_ptr<te::stmem::DataSet> te::stmem::DataSet::filter(const te::gm::Geometry* g, te::gm::SpatialRelation r, 
                                       const te::dt::DateTime* dt, te::dt::TemporalRelation tr) const
 {
-  std::auto_ptr<te::stmem::DataSet> result1 = filter(g,r);
-  return result1->filter(dt, tr);
+  if(r!=te::gm::INTERSECTS)
+    return std::auto_ptr<te::stmem::DataSet>(0);
+
+  std::vector<te::mem::DataSetItem*> report;
+  m_STIndex->search(*g->getMBR(), TemporalRange(dt, tr), report);
+
+  std::auto_ptr<te::stmem::DataSet> result(new DataSet(m_pnames, m_ptypes, m_begTimePropIdx, m_endTimePropIdx, m_geomPropIdx));
+
+  for(unsigned int i=0; i<report.size(); ++i)
+  {
+    std::auto_ptr<te::gm::Geometry> geom(report[i]->getGeometry(m_geomPropIdx));
+    if(geom->intersects(g))
+      result->add(report[i]->clone().release());
+  }
+  return result;
 }
 
 std::auto_ptr<te::stmem::DataSet> te::stmem::DataSet::nearestObservations(const te::dt::DateTime* time, int n) const
@@ -548,7 +571,7 @@ std::size_t te::stmem::DataSet::size() const
 std::auto_ptr<te::gm::Envelope> te::stmem::DataSet::getExtent(std::size_t i)
 {
   if(i==m_geomPropIdx)
-    return std::auto_ptr<te::gm::Envelope>(new te::gm::Envelope(m_RTree->getMBR()));
+    return std::auto_ptr<te::gm::Envelope>(new te::gm::Envelope(m_STIndex->getMBR()));
   
   std::auto_ptr<te::gm::Envelope> mbr(new te::gm::Envelope);
 
@@ -28,8 +28,8 @@
 
 // TerraLib
 #include "../dataaccess/dataset/DataSet.h"
-#include "../sam/rtree/Index.h"
 #include "Config.h"
+#include "SpatioTemporalIndex.h"
 
 // STL
 #include <map>
@@ -251,7 +251,7 @@ namespace te
           
           This method must be used when the user wants to share
           the same item among DataSets. After adding the item,
-          it updates the internal RTree. 
+          it updates the internal spatio-temporal index. 
 
           \param item An existing item coming from another DataSet.
            
@@ -341,8 +341,10 @@ namespace te
           
           \return     a new DataSet
 
+          \note For while, it only works if the spatial relation is te::gm::INTERSECTS 
           \note The caller will take the ownership of the returned pointer.
           \note The returned DataSet will NOT share the intenal observations. It will clone the internal observations.
+          \note Both conditions are answered by the internal spatio-temporal index.
         */
         std::auto_ptr<DataSet> filter(const te::gm::Envelope* e, te::gm::SpatialRelation r, 
                                       const te::dt::DateTime* dt, te::dt::TemporalRelation tr) const;
@@ -357,8 +359,10 @@ namespace te
 
           \return     a new DataSet
 
+          \note For while, it only works if the spatial relation is te::gm::INTERSECTS 
           \note The caller will take the ownership of the returned pointer.
           \note The returned DataSet will NOT share the intenal observations. It will clone the internal observations. 
+          \note Both conditions are answered by the internal spatio-temporal index.
         */
         std::auto_ptr<DataSet> filter(const te::gm::Geometry* g, te::gm::SpatialRelation r, 
                                       const te::dt::DateTime* dt, te::dt::TemporalRelation tr) const;
@@ -523,7 +527,7 @@ namespace te
       protected:
 
         TimeToDataSetItemMap                                    m_items;          //!< The list of dataset items, ordered by time.
-        std::auto_ptr<te::sam::rtree::Index<te::mem::DataSetItem*> >   m_RTree;   //!< A RTree index created over the default geometry property 
+        std::auto_ptr<SpatioTemporalIndex<te::mem::DataSetItem*> >     m_STIndex; //!< A spatio-temporal index created over the default geometry property and the phenomenon time
         TimeToDataSetItemMap::const_iterator                    m_iterator;       //!< The pointer to the current item.
         bool                                                    m_beforeFirst;    //! internal control  
         std::vector<std::string>                                m_pnames;         //!< The list of property names.
@@ -0,0 +1,357 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/stmemory/SpatioTemporalIndex.h
+
+  \brief A spatio-temporal index made of time partitioned R-trees.
+*/
+
+#ifndef __TERRALIB_STMEMORY_INTERNAL_SPATIOTEMPORALINDEX_H
+#define __TERRALIB_STMEMORY_INTERNAL_SPATIOTEMPORALINDEX_H
+
+// TerraLib
+#include "../datatype/DateTime.h"
+#include "../geometry/Envelope.h"
+#include "../sam/rtree/Index.h"
+#include "TemporalRange.h"
+
+// STL
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+// Boost
+#include <boost/noncopyable.hpp>
+
+namespace te
+{
+  namespace stmem
+  {
+    /*!
+      \class SpatioTemporalIndex
+
+      \brief A spatio-temporal index made of time partitioned R-trees.
+
+      \details The entries are kept in partitions of consecutive times, each one with its own R-tree.
+               A partition holding more than the given capacity is split at its median time, so the
+               partitions adapt to the time distribution of the entries. A combined query visits only
+               the partitions overlapping the temporal range; the times of the entries are tested only
+               in the partitions partially covered by it.
+
+      \note The index does not take the ownership of the given times, they must live while they are indexed.
+    */
+    template<class DATATYPE> class SpatioTemporalIndex : public boost::noncopyable
+    {
+      public:
+
+        /*!
+          \brief Constructor.
+
+          \param partitionCapacity The number of entries that triggers a partition split.
+        */
+        explicit SpatioTemporalIndex(const std::size_t& partitionCapacity = 1024);
+
+        ~SpatioTemporalIndex();
+
+        /*!
+          \brief It inserts an entry.
+
+          \param mbr  The entry bounding rectangle.
+          \param time The entry time.
+          \param data The entry data.
+        */
+        void insert(const te::gm::Envelope& mbr, const te::dt::DateTime* time, const DATATYPE& data);
+
+        /*!
+          \brief It searches the entries intersecting a rectangle.
+
+          \return The number of found entries.
+        */
+        std::size_t search(const te::gm::Envelope& mbr, std::vector<DATATYPE>& report) const;
+
+        /*!
+          \brief It searches the entries intersecting a rectangle with times inside a temporal range.
+
+          \return The number of found entries.
+        */
+        std::size_t search(const te::gm::Envelope& mbr, const TemporalRange& range, std::vector<DATATYPE>& report) const;
+
+        /*! \brief It returns the bounding rectangle of all entries. */
+        const te::gm::Envelope& getMBR() const;
+
+        /*! \brief It returns the number of entries. */
+        std::size_t size() const;
+
+        /*! \brief It returns the number of partitions. */
+        std::size_t getNumberOfPartitions() const;
+
+        /*! \brief It removes all entries. */
+        void clear();
+
+      protected:
+
+        /*! \brief A set of entries with consecutive times. */
+        class PartitionT
+        {
+          public:
+
+            std::vector<const te::dt::DateTime*> m_times;     //!< The entries times.
+            std::vector<te::gm::Envelope> m_mbrs;             //!< The entries rectangles.
+            std::vector<DATATYPE> m_data;                     //!< The entries data.
+            const te::dt::DateTime* m_first;                  //!< The lowest time.
+            const te::dt::DateTime* m_last;                   //!< The highest time.
+            te::sam::rtree::Index<std::size_t, 8> m_rtree;    //!< The entries positions indexed by their rectangles.
+
+            PartitionT() : m_first(0), m_last(0) {}
+
+            void add(const te::gm::Envelope& mbr, const te::dt::DateTime* time, const DATATYPE& data)
+            {
+              if(m_first == 0 || time->operator<(*m_first))
+                m_first = time;
+
+              if(m_last == 0 || m_last->operator<(*time))
+                m_last = time;
+
+              m_rtree.insert(mbr, m_times.size());
+              m_times.push_back(time);
+              m_mbrs.push_back(mbr);
+              m_data.push_back(data);
+            }
+        };
+
+        typedef std::map<const te::dt::DateTime*, PartitionT*, te::dt::CompareDateTime> PartitionMap;
+
+        /*! \brief It orders the entries of a partition by time. */
+        struct CompareEntryTime
+        {
+          bool operator()(const std::pair<const te::dt::DateTime*, std::size_t>& e1,
+                          const std::pair<const te::dt::DateTime*, std::size_t>& e2) const
+          {
+            return e1.first->operator<(*e2.first);
+          }
+        };
+
+        /*! \brief It splits a partition at its median time, if it has distinct times. */
+        void split(typename PartitionMap::iterator it);
+
+        /*! \brief It adds the entries of a partition found by a search. */
+        void report(const PartitionT* p, const te::gm::Envelope& mbr, const TemporalRange* range, std::vector<DATATYPE>& report) const;
+
+      private:
+
+        PartitionMap m_partitions;      //!< The partitions by their lowest time.
+        std::size_t m_capacity;         //!< The number of entries that triggers a partition split.
+        std::size_t m_size;             //!< The number of entries.
+        te::gm::Envelope m_mbr;         //!< The bounding rectangle of all entries.
+    };
+
+    template<class DATATYPE> inline
+    SpatioTemporalIndex<DATATYPE>::SpatioTemporalIndex(const std::size_t& partitionCapacity)
+      : m_capacity(std::max<std::size_t>(partitionCapacity, 2)),
+        m_size(0)
+    {
+    }
+
+    template<class DATATYPE> inline
+    SpatioTemporalIndex<DATATYPE>::~SpatioTemporalIndex()
+    {
+      clear();
+    }
+
+    template<class DATATYPE> inline
+    void SpatioTemporalIndex<DATATYPE>::insert(const te::gm::Envelope& mbr, const te::dt::DateTime* time, const DATATYPE& data)
+    {
+      typename PartitionMap::iterator it = m_partitions.upper_bound(time);
+
+      if(it != m_partitions.begin())
+      {
+        --it;
+      }
+      else if(it != m_partitions.end())
+      {
+        // the time is lower than all partitions: the first one is extended
+        PartitionT* p = it->second;
+        m_partitions.erase(it);
+        it = m_partitions.insert(typename PartitionMap::value_type(time, p)).first;
+      }
+      else
+      {
+        it = m_partitions.insert(typename PartitionMap::value_type(time, new PartitionT)).first;
+      }
+
+      it->second->add(mbr, time, data);
+
+      m_mbr.Union(mbr);
+      ++m_size;
+
+      if(it->second->m_times.size() > m_capacity)
+        split(it);
+    }
+
+    template<class DATATYPE> inline
+    std::size_t SpatioTemporalIndex<DATATYPE>::search(const te::gm::Envelope& mbr, std::vector<DATATYPE>& report) const
+    {
+      std::size_t n = report.size();
+
+      for(typename PartitionMap::const_iterator it = m_partitions.begin(); it != m_partitions.end(); ++it)
+        this->report(it->second, mbr, 0, report);
+
+      return report.size() - n;
+    }
+
+    template<class DATATYPE> inline
+    std::size_t SpatioTemporalIndex<DATATYPE>::search(const te::gm::Envelope& mbr, const TemporalRange& range, std::vector<DATATYPE>& report) const
+    {
+      std::size_t n = report.size();
+
+      if(range.isEmpty() || m_partitions.empty())
+        return 0;
+
+      typename PartitionMap::const_iterator it = m_partitions.begin();
+
+      if(range.getLower())
+      {
+        it = m_partitions.upper_bound(range.getLower());
+
+        if(it != m_partitions.begin())
+          --it;
+      }
+
+      for(; it != m_partitions.end(); ++it)
+      {
+        const PartitionT* p = it->second;
+
+        if(range.isAbove(p->m_first))
+          break;
+
+        if(!range.overlaps(p->m_first, p->m_last))
+          continue;
+
+        this->report(p, mbr, range.covers(p->m_first, p->m_last) ? 0 : &range, report);
+      }
+
+      return report.size() - n;
+    }
+
+    template<class DATATYPE> inline
+    const te::gm::Envelope& SpatioTemporalIndex<DATATYPE>::getMBR() const
+    {
+      return m_mbr;
+    }
+
+    template<class DATATYPE> inline
+    std::size_t SpatioTemporalIndex<DATATYPE>::size() const
+    {
+      return m_size;
+    }
+
+    template<class DATATYPE> inline
+    std::size_t SpatioTemporalIndex<DATATYPE>::getNumberOfPartitions() const
+    {
+      return m_partitions.size();
+    }
+
+    template<class DATATYPE> inline
+    void SpatioTemporalIndex<DATATYPE>::clear()
+    {
+      for(typename PartitionMap::iterator it = m_partitions.begin(); it != m_partitions.end(); ++it)
+        delete it->second;
+
+      m_partitions.clear();
+      m_size = 0;
+      m_mbr = te::gm::Envelope();
+    }
+
+    template<class DATATYPE> inline
+    void SpatioTemporalIndex<DATATYPE>::split(typename PartitionMap::iterator it)
+    {
+      PartitionT* p = it->second;
+
+      const std::size_t n = p->m_times.size();
+
+      std::vector<std::pair<const te::dt::DateTime*, std::size_t> > order(n);
+
+      for(std::size_t i = 0; i < n; ++i)
+        order[i] = std::make_pair(p->m_times[i], i);
+
+      te::dt::CompareDateTime cmp;
+
+      std::stable_sort(order.begin(), order.end(), CompareEntryTime());
+
+      // the split position must separate distinct times
+      std::size_t s = n / 2;
+
+      while(s < n && !cmp(order[s - 1].first, order[s].first))
+        ++s;
+
+      if(s == n)
+      {
+        s = n / 2;
+
+        while(s > 0 && !cmp(order[s - 1].first, order[s].first))
+          --s;
+
+        if(s == 0)
+          return;
+      }
+
+      std::auto_ptr<PartitionT> lower(new PartitionT);
+      std::auto_ptr<PartitionT> upper(new PartitionT);
+
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        std::size_t pos = order[i].second;
+
+        PartitionT* target = (i < s) ? lower.get() : upper.get();
+
+        target->add(p->m_mbrs[pos], p->m_times[pos], p->m_data[pos]);
+      }
+
+      m_partitions.erase(it);
+
+      delete p;
+
+      m_partitions.insert(typename PartitionMap::value_type(lower->m_first, lower.get()));
+      lower.release();
+
+      m_partitions.insert(typename PartitionMap::value_type(upper->m_first, upper.get()));
+      upper.release();
+    }
+
+    template<class DATATYPE> inline
+    void SpatioTemporalIndex<DATATYPE>::report(const PartitionT* p, const te::gm::Envelope& mbr,
+                                               const TemporalRange* range, std::vector<DATATYPE>& report) const
+    {
+      std::vector<std::size_t> positions;
+      p->m_rtree.search(mbr, positions);
+
+      for(std::size_t i = 0; i < positions.size(); ++i)
+      {
+        std::size_t pos = positions[i];
+
+        if(range == 0 || range->contains(p->m_times[pos]))
+          report.push_back(p->m_data[pos]);
+      }
+    }
+  } // end namespace stmem
+}   // end namespace te
+
+#endif  // __TERRALIB_STMEMORY_INTERNAL_SPATIOTEMPORALINDEX_H
@@ -0,0 +1,149 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/stmemory/TemporalRange.cpp
+
+  \brief The range of times that satisfies a temporal relation with a given date and time.
+*/
+
+// TerraLib
+#include "../datatype/DateTime.h"
+#include "../datatype/DateTimeInstant.h"
+#include "../datatype/DateTimePeriod.h"
+#include "TemporalRange.h"
+
+te::stmem::TemporalRange::TemporalRange()
+  : m_lower(),
+    m_upper(),
+    m_lowerIncluded(false),
+    m_upperIncluded(false),
+    m_empty(false)
+{
+}
+
+te::stmem::TemporalRange::TemporalRange(const te::dt::DateTime* dt, te::dt::TemporalRelation tr)
+  : m_lower(),
+    m_upper(),
+    m_lowerIncluded(false),
+    m_upperIncluded(false),
+    m_empty(false)
+{
+  if(tr==te::dt::AFTER) //2
+  {
+    m_lower.reset(static_cast<te::dt::DateTime*>(dt->clone()));
+  }
+  else if(tr==(te::dt::AFTER | te::dt::EQUALS)) // 2 OU 8 = 10
+  {
+    m_lower.reset(static_cast<te::dt::DateTime*>(dt->clone()));
+    m_lowerIncluded = true;
+  }
+  else if(tr==te::dt::BEFORE) // 1
+  {
+    m_upper.reset(static_cast<te::dt::DateTime*>(dt->clone()));
+  }
+  else if(tr==(te::dt::BEFORE | te::dt::EQUALS)) // 1 OU 8 = 9
+  {
+    m_upper.reset(static_cast<te::dt::DateTime*>(dt->clone()));
+    m_upperIncluded = true;
+  }
+  else if(tr==te::dt::DURING) //4
+  {
+    const te::dt::DateTimePeriod* period = dynamic_cast<const te::dt::DateTimePeriod*>(dt);
+
+    if(period)
+    {
+      m_lower.reset(static_cast<te::dt::DateTime*>(period->getInitialInstant()));
+      m_upper.reset(static_cast<te::dt::DateTime*>(period->getFinalInstant()));
+      m_lowerIncluded = true;
+      m_upperIncluded = true;
+    }
+    else
+    {
+      m_empty = true;
+    }
+  }
+  else if(tr==te::dt::EQUALS) //8
+  {
+    m_lower.reset(static_cast<te::dt::DateTime*>(dt->clone()));
+    m_upper = m_lower;
+    m_lowerIncluded = true;
+    m_upperIncluded = true;
+  }
+  else
+  {
+    m_empty = true;
+  }
+}
+
+te::stmem::TemporalRange::~TemporalRange()
+{
+}
+
+bool te::stmem::TemporalRange::isEmpty() const
+{
+  return m_empty;
+}
+
+const te::dt::DateTime* te::stmem::TemporalRange::getLower() const
+{
+  return m_lower.get();
+}
+
+const te::dt::DateTime* te::stmem::TemporalRange::getUpper() const
+{
+  return m_upper.get();
+}
+
+bool te::stmem::TemporalRange::contains(const te::dt::DateTime* t) const
+{
+  return !m_empty && !isBelow(t) && !isAbove(t);
+}
+
+bool te::stmem::TemporalRange::isBelow(const te::dt::DateTime* t) const
+{
+  if(m_lower.get() == 0)
+    return false;
+
+  if(m_lowerIncluded)
+    return t->operator<(*m_lower);
+
+  return !m_lower->operator<(*t);
+}
+
+bool te::stmem::TemporalRange::isAbove(const te::dt::DateTime* t) const
+{
+  if(m_upper.get() == 0)
+    return false;
+
+  if(m_upperIncluded)
+    return m_upper->operator<(*t);
+
+  return !t->operator<(*m_upper);
+}
+
+bool te::stmem::TemporalRange::covers(const te::dt::DateTime* first, const te::dt::DateTime* last) const
+{
+  return contains(first) && contains(last);
+}
+
+bool te::stmem::TemporalRange::overlaps(const te::dt::DateTime* first, const te::dt::DateTime* last) const
+{
+  return !m_empty && !isBelow(last) && !isAbove(first);
+}
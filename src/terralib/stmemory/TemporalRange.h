@@ -0,0 +1,104 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/stmemory/TemporalRange.h
+
+  \brief The range of times that satisfies a temporal relation with a given date and time.
+*/
+
+#ifndef __TERRALIB_STMEMORY_INTERNAL_TEMPORALRANGE_H
+#define __TERRALIB_STMEMORY_INTERNAL_TEMPORALRANGE_H
+
+// TerraLib
+#include "../datatype/Enums.h"
+#include "Config.h"
+
+// Boost
+#include <boost/shared_ptr.hpp>
+
+namespace te { namespace dt { class DateTime; } }
+
+namespace te
+{
+  namespace stmem
+  {
+    /*!
+      \class TemporalRange
+
+      \brief The range of times that satisfies a temporal relation with a given date and time.
+
+      \details The times are ordered as in the in-memory observation datasets (te::dt::CompareDateTime),
+               so the range of a relation is the same run of observations selected by
+               te::stmem::DataSet::filter. The supported relations are: AFTER, AFTER | EQUALS,
+               BEFORE, BEFORE | EQUALS, DURING and EQUALS; the other ones give an empty range.
+    */
+    class TESTMEMORYEXPORT TemporalRange
+    {
+      public:
+
+        /*! \brief It constructs an unbounded range. */
+        TemporalRange();
+
+        /*!
+          \brief It constructs the range of times that satisfies a temporal relation.
+
+          \param dt A given date and time (a period for the DURING relation). It is cloned.
+          \param tr A given temporal relation.
+        */
+        TemporalRange(const te::dt::DateTime* dt, te::dt::TemporalRelation tr);
+
+        ~TemporalRange();
+
+        /*! \brief It returns true if no time satisfies the relation. */
+        bool isEmpty() const;
+
+        /*! \brief It returns the lower bound or NULL if the range is unbounded below. */
+        const te::dt::DateTime* getLower() const;
+
+        /*! \brief It returns the upper bound or NULL if the range is unbounded above. */
+        const te::dt::DateTime* getUpper() const;
+
+        /*! \brief It returns true if the time is in the range. */
+        bool contains(const te::dt::DateTime* t) const;
+
+        /*! \brief It returns true if the time is below the range. */
+        bool isBelow(const te::dt::DateTime* t) const;
+
+        /*! \brief It returns true if the time is above the range. */
+        bool isAbove(const te::dt::DateTime* t) const;
+
+        /*! \brief It returns true if all the times from first to last are in the range. */
+        bool covers(const te::dt::DateTime* first, const te::dt::DateTime* last) const;
+
+        /*! \brief It returns true if some time from first to last may be in the range. */
+        bool overlaps(const te::dt::DateTime* first, const te::dt::DateTime* last) const;
+
+      private:
+
+        boost::shared_ptr<te::dt::DateTime> m_lower;    //!< The lower bound (NULL if unbounded).
+        boost::shared_ptr<te::dt::DateTime> m_upper;    //!< The upper bound (NULL if unbounded).
+        bool m_lowerIncluded;                           //!< True if the lower bound is in the range.
+        bool m_upperIncluded;                           //!< True if the upper bound is in the range.
+        bool m_empty;                                   //!< True if the relation is not supported.
+    };
+  } // end namespace stmem
+}   // end namespace te
+
+#endif  // __TERRALIB_STMEMORY_INTERNAL_TEMPORALRANGE_H
@@ -27,6 +27,7 @@
 
 #include "../BuildConfig.h"
 #include "../common/progress/TaskProgress.h"
+#include "../common/STLUtils.h"
 #include "../core/logger/Logger.h"
 #include "../core/translator/Translator.h"
 
@@ -325,8 +326,10 @@ bool te::vp::AggregationMemory::run() throw( te::common::Exception )
   // for the non-spatial attributes
   std::auto_ptr<te::da::DataSetType> outDsType = this->buildOutDataSetType();
   
-  // create the output dataset in memory
+  // create the output dataset in memory; it is flushed to the output data source every few groups
   std::auto_ptr<te::mem::DataSet> outDataset(new te::mem::DataSet(outDsType.get()));
+  const std::size_t flushSize = 1000;
+  bool saved = false;
   
   // now calculate the aggregation of non spatial and spatial attributes and save it to the output dataset
   te::common::TaskProgress task("Processing aggregation...");
@@ -397,6 +400,13 @@ bool te::vp::AggregationMemory::run() throw( te::common::Exception )
 
       outDSetItem->setGeometry("geom", geometry);
       outDataset->add(outDSetItem);
+
+      if (outDataset->size() >= flushSize)
+      {
+        te::vp::Save(m_outDsrc.get(), outDataset.get(), outDsType.get());
+        outDataset->clear();
+        saved = true;
+      }
     }
     else
     {
@@ -404,6 +414,11 @@ bool te::vp::AggregationMemory::run() throw( te::common::Exception )
         TE_CORE_LOG_DEBUG("vp", "Aggregation - The operation generated invalid geometry.");
 #endif // TERRALIB_LOGGER_ENABLED
     }
+
+    // the group input items are no longer needed
+    te::common::FreeContents(itg->second);
+    itg->second.clear();
+
     ++itg;
   
     if (task.isActive() == false)
@@ -414,6 +429,8 @@ bool te::vp::AggregationMemory::run() throw( te::common::Exception )
 #ifdef TERRALIB_LOGGER_ENABLED
   TE_CORE_LOG_DEBUG("vp", timeResult.c_str());
 #endif
-  te::vp::Save(m_outDsrc.get(), outDataset.get(), outDsType.get());
+  if (!saved || !outDataset->isEmpty())
+    te::vp::Save(m_outDsrc.get(), outDataset.get(), outDsType.get());
+
   return true;
 }
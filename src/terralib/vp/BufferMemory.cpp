@@ -53,6 +53,7 @@
 #include "Utils.h"
 
 // STL
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -61,6 +62,20 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 
+namespace
+{
+  std::size_t FindClusterRoot(std::vector<std::size_t>& parents, std::size_t idx)
+  {
+    while(parents[idx] != idx)
+    {
+      parents[idx] = parents[parents[idx]];
+      idx = parents[idx];
+    }
+
+    return idx;
+  }
+}
+
 te::vp::BufferMemory::BufferMemory()
 {}
 
@@ -327,7 +342,8 @@ void te::vp::BufferMemory::dissolveMemory(te::mem::DataSet* outDSet,
   //task1.setCurrentStep(1);
   for(int i = 1; i <= levels; ++i)
   {
-    te::sam::rtree::Index<te::gm::Geometry*, 4> rtree;
+    std::vector<te::gm::Geometry*> levelGeoms;
+    te::sam::rtree::Index<std::size_t, 4> rtree;
 
     outDSet->moveBeforeFirst();
     while(outDSet->moveNext())
@@ -336,34 +352,59 @@ void te::vp::BufferMemory::dissolveMemory(te::mem::DataSet* outDSet,
       if(level == i)
       {
         te::gm::Geometry* geom = outDSet->getGeometry(geomPos).release();
-          
-        std::vector<te::gm::Geometry*> vec;
-          
-        rtree.search(*(geom->getMBR()), vec);
-          
-        if(!vec.empty())
-        {
-          for(std::size_t t = 0; t < vec.size(); ++t)
-          {
-            if(geom->intersects(vec[t]))
-            {
-              geom = geom->Union(vec[t]);
-              rtree.remove(*(vec[t]->getMBR()), vec[t]);
-            }
-          }
-        }
-        rtree.insert(*(geom->getMBR()), geom);
+
+        rtree.insert(*(geom->getMBR()), levelGeoms.size());
+        levelGeoms.push_back(geom);
       }
       //task1.pulse();
     }
-      
-    std::vector<te::gm::Geometry*> geomVec;
-    std::unique_ptr<te::gm::Envelope> e = outDSet->getExtent(geomPos);
-    rtree.search(*(e.get()), geomVec);
 
-    vecGeom.push_back(geomVec);
+    // Cluster the intersecting buffers (union-find) and merge each cluster with a cascaded union.
+    std::vector<std::size_t> parents(levelGeoms.size());
+    for(std::size_t g = 0; g < parents.size(); ++g)
+      parents[g] = g;
+
+    for(std::size_t g = 0; g < levelGeoms.size(); ++g)
+    {
+      std::vector<std::size_t> candidates;
+      rtree.search(*(levelGeoms[g]->getMBR()), candidates);
+
+      for(std::size_t t = 0; t < candidates.size(); ++t)
+      {
+        std::size_t c = candidates[t];
+
+        if(c <= g)
+          continue;
+
+        std::size_t rootG = FindClusterRoot(parents, g);
+        std::size_t rootC = FindClusterRoot(parents, c);
+
+        if(rootG != rootC && levelGeoms[g]->intersects(levelGeoms[c]))
+          parents[std::max(rootG, rootC)] = std::min(rootG, rootC);
+      }
+    }
 
     rtree.clear();
+
+    std::map<std::size_t, std::vector<te::gm::Geometry*> > clusters;
+    for(std::size_t g = 0; g < levelGeoms.size(); ++g)
+      clusters[FindClusterRoot(parents, g)].push_back(levelGeoms[g]);
+
+    levelGeoms.clear();
+
+    std::vector<te::gm::Geometry*> geomVec;
+    std::map<std::size_t, std::vector<te::gm::Geometry*> >::iterator itCluster = clusters.begin();
+    while(itCluster != clusters.end())
+    {
+      te::gm::Geometry* geom = te::vp::GetCascadedUnion(itCluster->second);
+
+      if(geom)
+        geomVec.push_back(geom);
+
+      ++itCluster;
+    }
+
+    vecGeom.push_back(geomVec);
   }
     
   outDSet->clear();
@@ -74,6 +74,7 @@
 #include "AlgorithmParams.h"
 #include "ComplexData.h"
 #include "Difference.h"
+#include "PartitionedOverlay.h"
 #include "Utils.h"
 
 // BOOST
@@ -87,6 +88,9 @@ te::vp::Difference::Difference()
 
 bool te::vp::Difference::executeMemory(te::vp::AlgorithmParams* mainParams)
 {
+  if (te::vp::PartitionedOverlay::isEnabled(mainParams->getSpecificParams()))
+    return executePartitioned(mainParams);
+
   te::vp::ValidateAlgorithmParams(mainParams, te::vp::MEMORY);
 
 // Validating parameters
@@ -249,6 +253,39 @@ bool te::vp::Difference::executeMemory(te::vp::AlgorithmParams* mainParams)
   return true;
 }
 
+bool te::vp::Difference::executePartitioned(te::vp::AlgorithmParams* mainParams)
+{
+  std::vector<te::vp::InputParams> inputParams = mainParams->getInputParams();
+
+  if (inputParams.size() < 2)
+    throw te::common::Exception(TE_TR("It is necessary more than one item for performing the operation."));
+
+  const std::map<std::string, te::dt::AbstractData*>& specificParams = mainParams->getSpecificParams();
+
+  std::auto_ptr<te::da::DataSetType> outputDataSetType(getOutputDataSetType(mainParams));
+
+// The input attributes keep their names in the output.
+  std::vector<std::string> propNames = this->getPropNames(specificParams);
+
+  std::map<std::string, std::string> attrNameMap;
+  for (std::size_t p = 0; p < propNames.size(); ++p)
+    attrNameMap[propNames[p]] = propNames[p];
+
+  te::vp::PartitionedOverlay overlay(te::vp::OVERLAY_DIFFERENCE);
+  overlay.setFirstInput(inputParams[0], attrNameMap);
+  overlay.setSecondInput(inputParams[1], std::map<std::string, std::string>());
+  overlay.setOutput(mainParams->getOutputDataSource(), outputDataSetType.get(), isCollection(specificParams));
+
+  std::size_t maxTileFeatures = te::vp::PartitionedOverlay::getMaxTileFeatures(specificParams);
+  if (maxTileFeatures > 0)
+    overlay.setMaxTileFeatures(maxTileFeatures);
+
+  if (overlay.execute() == 0)
+    throw te::common::Exception(TE_TR("The resultant layer is empty!"));
+
+  return true;
+}
+
 bool te::vp::Difference::executeQuery(te::vp::AlgorithmParams* mainParams)
 {
   te::vp::ValidateAlgorithmParams(mainParams, te::vp::QUERY);
@@ -68,6 +68,13 @@ namespace te
 
     protected:
 
+      /*!
+        \brief It runs the operation with the partitioned overlay, reading the input layers tile by tile from their data sources.
+
+        \note It is used by executeMemory when the "PARTITIONED" specific parameter is true.
+      */
+      bool executePartitioned(te::vp::AlgorithmParams* mainParams);
+
       std::vector<std::string> getPropNames(const std::map<std::string, te::dt::AbstractData*>& specificParams);
 
       bool isCollection(const std::map<std::string, te::dt::AbstractData*>& specificParams);
@@ -23,6 +23,7 @@
 
 #include "../core/logger/Logger.h"
 #include "../common/progress/TaskProgress.h"
+#include "../common/PlatformUtils.h"
 #include "../common/StringUtils.h"
 #include "../common/STLUtils.h"
 #include "../core/translator/Translator.h"
@@ -93,7 +94,9 @@
 #include <boost/thread.hpp>
 
 // STL 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 
@@ -667,21 +670,23 @@ bool te::vp::Dissolve::executeMemory(te::vp::AlgorithmParams* mainParams)
   task.useTimer(false);
   task.useMultiThread(true);
 
-  GroupThreadManager* manager = new GroupThreadManager(groups
+  std::size_t numProcs = std::max<std::size_t>(1, te::common::GetPhysProcNumber());
+
+  std::auto_ptr<GroupThreadManager> manager(new GroupThreadManager(groups
     , inputDataSet.get()
     , dsType_input.get()
     , outputDataSet.get()
     , outputDataSetType.get()
     , outputDataSource.get()
-    , specificParams);
+    , specificParams
+    , 2 * numProcs));
 
   boost::thread_group threadGroup;
-  threadGroup.add_thread(new boost::thread(threadSave, manager));
+  threadGroup.add_thread(new boost::thread(threadSave, manager.get()));
 
-  std::size_t numProcs = 8;
   for (std::size_t i = 0; i < numProcs; ++i)
   {
-    threadGroup.add_thread(new boost::thread(threadUnion, manager));
+    threadGroup.add_thread(new boost::thread(threadUnion, manager.get()));
   }
 
   threadGroup.join_all();
@@ -1094,28 +1099,25 @@ void te::vp::Dissolve::threadUnion(GroupThreadManager* manager)
 
     try
     {
-      resultUnionGeometry = te::vp::GetGeometryUnion(geomVec);
-      te::common::FreeContents(geomVec);
-      geomVec.clear();
+      resultUnionGeometry.reset(te::vp::GetCascadedUnion(geomVec));
     }
     catch (...)
     {
-      te::common::FreeContents(geomVec);
-      geomVec.clear();
-
       std::string message = "GEOS Exception.";
       manager->addWarning(message);
 
+      te::common::FreeContents(dsItemVec);
       manager->addOutput(outputItemVec);
 
       continue;
     }
 
-    if (!resultUnionGeometry->isValid())
+    if (!resultUnionGeometry.get() || !resultUnionGeometry->isValid())
     {
       std::string message = "The operation generated invalid geometry.";
       manager->addWarning(message);
 
+      te::common::FreeContents(dsItemVec);
       manager->addOutput(outputItemVec);
 
       continue;
@@ -1136,9 +1138,9 @@ void te::vp::Dissolve::threadUnion(GroupThreadManager* manager)
 
     PopulateItens(dataSetType, dsItemVec, specificParams, outputItemVec);
 
-    manager->addOutput(outputItemVec);
+    te::common::FreeContents(dsItemVec);
 
-    geomVec.clear();
+    manager->addOutput(outputItemVec);
   }
 }
 
@@ -1152,10 +1154,7 @@ void te::vp::Dissolve::threadSave(GroupThreadManager* manager)
   {
     //save the data
     if (outputItemVec.empty())
-    {
-      boost::this_thread::sleep(boost::posix_time::milliseconds(1000));
       continue;
-    }
 
     //Create a empty dataSet.
     te::mem::DataSet* outputDataSet = manager->getClearOutputDataSet();
@@ -1173,6 +1172,8 @@ void te::vp::Dissolve::threadSave(GroupThreadManager* manager)
     {
       std::string message = "Dissolve - Output DataSet was not prepared to save.";
       manager->addWarning(message);
+      outputItemVec.clear();
+      continue;
     }
 
     if (dataSetPrepared->isEmpty())
@@ -1182,6 +1183,9 @@ void te::vp::Dissolve::threadSave(GroupThreadManager* manager)
     }
 
     Save(outputDataSource, dataSetPrepared, outputDataType);
+
+    // Release the saved group before waiting for the next one.
+    manager->getClearOutputDataSet();
     outputItemVec.clear();
   }
 }
@@ -119,6 +119,18 @@ namespace te
       AGGREG_BY_ATTRIBUTE   //!< Aggregate objects by attribute.
     };
 
+    /*!
+      \enum OverlayOperation
+
+      \brief Defines the operations computed by the partitioned overlay.
+    */
+    enum OverlayOperation
+    {
+      OVERLAY_INTERSECTION, //!< The pieces shared by both layers.
+      OVERLAY_DIFFERENCE,   //!< The pieces of the first layer not covered by the second one.
+      OVERLAY_UNION         //!< The shared pieces plus the pieces exclusive to each layer.
+    };
+
   }
 }
 
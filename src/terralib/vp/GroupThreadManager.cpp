@@ -50,7 +50,8 @@ namespace te
                                             , te::mem::DataSet* outputDataSet
                                             , te::da::DataSetType* outputDataSetType
                                             , te::da::DataSource* outputDataSource
-                                            , std::map<std::string, te::dt::AbstractData*> specificParams)
+                                            , std::map<std::string, te::dt::AbstractData*> specificParams
+                                            , std::size_t maxOutputQueueSize)
       : m_groups(groups)
       , m_savedCount(0)
       , m_dataSet(dataSet)
@@ -59,6 +60,7 @@ namespace te
       , m_outputDataSetType(outputDataSetType)
       , m_outputDataSource(outputDataSource)
       , m_specificParams(specificParams)
+      , m_maxOutputQueueSize(maxOutputQueueSize)
     {
       m_groupsIterator = m_groups.begin();
     }
@@ -96,24 +98,28 @@ namespace te
 
     bool GroupThreadManager::getNextOutput(std::vector< te::mem::DataSetItem*>& nextOutput)
     {
-      boost::lock_guard<boost::mutex> lock(m_mtxOutput);
+      boost::unique_lock<boost::mutex> lock(m_mtxOutput);
 
-      if (m_outputQueue.empty())
+      while (m_outputQueue.empty())
       {
         if (m_savedCount == m_groups.size())
         {
           return false;
         }
 
-        return true;
+        m_outputAvailable.wait(lock);
       }
 
-      nextOutput = *m_outputQueue.begin();
+      nextOutput = m_outputQueue.front();
 
-      m_outputQueue.erase(m_outputQueue.begin());
+      m_outputQueue.pop_front();
 
       ++m_savedCount;
 
+      lock.unlock();
+
+      m_outputSpaceAvailable.notify_one();
+
       return true;
     }
 
@@ -158,9 +164,16 @@ namespace te
 
     void GroupThreadManager::addOutput(std::vector<te::mem::DataSetItem*>& itemGroup)
     {
-      boost::lock_guard<boost::mutex> lock(m_mtxOutput);
+      boost::unique_lock<boost::mutex> lock(m_mtxOutput);
+
+      while (m_maxOutputQueueSize > 0 && m_outputQueue.size() >= m_maxOutputQueueSize)
+        m_outputSpaceAvailable.wait(lock);
 
       m_outputQueue.push_back(itemGroup);
+
+      lock.unlock();
+
+      m_outputAvailable.notify_one();
     }
 
     void GroupThreadManager::addWarning(const std::string& warning, const bool& appendIfExists)
@@ -31,10 +31,12 @@
 #include "Config.h"
 
 // STL
+#include <deque>
 #include <map>
 #include <vector>
 
 // Boost
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
 
 namespace te
@@ -74,12 +76,20 @@ namespace te
                         , te::mem::DataSet* outputDataSet
                         , te::da::DataSetType* outputDataSetType
                         , te::da::DataSource* outputDataSource
-                        , std::map<std::string, te::dt::AbstractData*> specificParams);
+                        , std::map<std::string, te::dt::AbstractData*> specificParams
+                        , std::size_t maxOutputQueueSize = 0);
       
       virtual ~GroupThreadManager() {}
       
       bool getNextGroup(std::vector< te::mem::DataSetItem*>& nextGroup);
 
+      /*!
+        \brief It waits for the next processed group.
+
+        \param nextOutput The output items of the next processed group.
+
+        \return False when all groups were already delivered.
+      */
       bool getNextOutput(std::vector< te::mem::DataSetItem*>& nextOutput);
 
       te::da::DataSetType* getDataSetType();
@@ -96,6 +106,11 @@ namespace te
 
       te::mem::DataSetItem* createOutputItem();
 
+      /*!
+        \brief It queues a processed group to be saved.
+
+        \note The calling thread waits while the output queue is full, so the groups not yet saved are bounded in memory.
+      */
       void addOutput(std::vector<te::mem::DataSetItem*>& itemGroup);
     
       void addWarning(const std::string& warning, const bool& appendIfExists = false);
@@ -119,13 +134,16 @@ namespace te
 
       std::map<std::string, std::vector<int> >::iterator m_groupsIterator;
 
-      std::vector< std::vector<te::mem::DataSetItem*> > m_outputQueue;
+      std::deque< std::vector<te::mem::DataSetItem*> > m_outputQueue;
+      std::size_t m_maxOutputQueueSize;
       te::common::TaskProgress m_task;
 
       std::vector<std::string> m_warnings;
 
       boost::mutex m_mtx;
       boost::mutex m_mtxOutput;
+      boost::condition_variable m_outputAvailable;
+      boost::condition_variable m_outputSpaceAvailable;
       boost::mutex m_mtxWarning;
     };
   }
@@ -66,6 +66,7 @@
 #include "../geometry/MultiLineString.h"
 #include "../geometry/MultiPoint.h"
 #include "../geometry/MultiPolygon.h"
+#include "../geometry/ScopedGEOSCache.h"
 #include "../geometry/Utils.h"
 
 #include "../sam.h"
@@ -78,6 +79,7 @@
 #include "AlgorithmParams.h"
 #include "ComplexData.h"
 #include "Intersection.h"
+#include "PartitionedOverlay.h"
 #include "Utils.h"
 
 // BOOST
@@ -89,6 +91,9 @@ te::vp::Intersection::Intersection()
 
 bool te::vp::Intersection::executeMemory(te::vp::AlgorithmParams* mainParams)
 {
+  if (te::vp::PartitionedOverlay::isEnabled(mainParams->getSpecificParams()))
+    return executePartitioned(mainParams);
+
   te::vp::ValidateAlgorithmParams(mainParams, te::vp::MEMORY);
 
   te::vp::InputParams firstInputParams = mainParams->getInputParams()[0];
@@ -129,6 +134,9 @@ bool te::vp::Intersection::executeMemory(te::vp::AlgorithmParams* mainParams)
     std::vector<std::size_t> rtreeReport;
     rtree->search(*currentGeometry->getMBR(), rtreeReport);
 
+// the current geometry is tested against all the candidates: convert it to GEOS only once
+    te::gm::ScopedGEOSCache geosCache(*currentGeometry);
+
     for (std::size_t i = 0; i < rtreeReport.size(); ++i)
     {
       secondDataSet->move(rtreeReport[i]);
@@ -205,6 +213,32 @@ bool te::vp::Intersection::executeMemory(te::vp::AlgorithmParams* mainParams)
   return true;
 }
 
+bool te::vp::Intersection::executePartitioned(te::vp::AlgorithmParams* mainParams)
+{
+  std::vector<te::vp::InputParams> inputParams = mainParams->getInputParams();
+
+  if (inputParams.size() < 2)
+    throw te::common::Exception(TE_TR("It is necessary more than one item for performing the operation."));
+
+  const std::map<std::string, te::dt::AbstractData*> specificParams = mainParams->getSpecificParams();
+
+  std::auto_ptr<te::da::DataSetType> outputDataSetType(getOutputDataSetType(mainParams));
+
+  te::vp::PartitionedOverlay overlay(te::vp::OVERLAY_INTERSECTION);
+  overlay.setFirstInput(inputParams[0], m_firstAttrNameMap);
+  overlay.setSecondInput(inputParams[1], m_secondAttrNameMap);
+  overlay.setOutput(mainParams->getOutputDataSource(), outputDataSetType.get(), isCollection(specificParams));
+
+  std::size_t maxTileFeatures = te::vp::PartitionedOverlay::getMaxTileFeatures(specificParams);
+  if (maxTileFeatures > 0)
+    overlay.setMaxTileFeatures(maxTileFeatures);
+
+  if (overlay.execute() == 0)
+    throw te::common::Exception(TE_TR("The resultant layer is empty!"));
+
+  return true;
+}
+
 std::vector<te::dt::Property*> te::vp::Intersection::getFirstSelectedProperties(const te::da::DataSetType* dataSetType, const std::map<std::string, te::dt::AbstractData*>& specificParams)
 {
   std::vector<te::dt::Property*> result;
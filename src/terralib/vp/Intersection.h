@@ -68,6 +68,13 @@ namespace te
 
     protected:
 
+      /*!
+        \brief It runs the operation with the partitioned overlay, reading the input layers tile by tile from their data sources.
+
+        \note It is used by executeMemory when the "PARTITIONED" specific parameter is true.
+      */
+      bool executePartitioned(te::vp::AlgorithmParams* mainParams);
+
       te::da::DataSet* updateGeomType(te::da::DataSetType* dsType, te::da::DataSet* ds);
 
       te::da::DataSetType* getOutputDataSetType(te::vp::AlgorithmParams* mainParams);
@@ -0,0 +1,840 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+ \file PartitionedOverlay.cpp
+ */
+
+#include "../common/Exception.h"
+#include "../common/PlatformUtils.h"
+#include "../common/progress/TaskProgress.h"
+#include "../core/logger/Logger.h"
+#include "../core/translator/Translator.h"
+
+#include "../dataaccess/dataset/DataSet.h"
+#include "../dataaccess/dataset/DataSetType.h"
+#include "../dataaccess/utils/Utils.h"
+
+#include "../datatype/SimpleData.h"
+
+#include "../geometry/CurvePolygon.h"
+#include "../geometry/Geometry.h"
+#include "../geometry/GeometryCollection.h"
+#include "../geometry/GeometryProperty.h"
+#include "../geometry/LineString.h"
+#include "../geometry/Point.h"
+#include "../geometry/ScopedGEOSCache.h"
+#include "../geometry/Utils.h"
+
+#include "../memory/DataSet.h"
+#include "../memory/DataSetItem.h"
+
+#include "Exception.h"
+#include "PartitionedOverlay.h"
+#include "Utils.h"
+
+// STL
+#include <algorithm>
+
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+namespace
+{
+  /*!
+    \brief It updates the lowest-leftmost vertex found so far with the geometry vertices.
+  */
+  void UpdateReferenceVertex(const te::gm::Geometry* geom, double& x, double& y, bool& found)
+  {
+    const te::gm::Point* point = dynamic_cast<const te::gm::Point*>(geom);
+
+    if(point)
+    {
+      if(!found || point->getX() < x || (point->getX() == x && point->getY() < y))
+      {
+        x = point->getX();
+        y = point->getY();
+        found = true;
+      }
+
+      return;
+    }
+
+    const te::gm::LineString* line = dynamic_cast<const te::gm::LineString*>(geom);
+
+    if(line)
+    {
+      for(std::size_t i = 0; i < line->getNPoints(); ++i)
+      {
+        if(!found || line->getX(i) < x || (line->getX(i) == x && line->getY(i) < y))
+        {
+          x = line->getX(i);
+          y = line->getY(i);
+          found = true;
+        }
+      }
+
+      return;
+    }
+
+    const te::gm::CurvePolygon* polygon = dynamic_cast<const te::gm::CurvePolygon*>(geom);
+
+    if(polygon)
+    {
+      for(std::size_t i = 0; i < polygon->getNumRings(); ++i)
+        UpdateReferenceVertex(polygon->getRingN(i), x, y, found);
+
+      return;
+    }
+
+    const te::gm::GeometryCollection* collection = dynamic_cast<const te::gm::GeometryCollection*>(geom);
+
+    if(collection)
+    {
+      for(std::size_t i = 0; i < collection->getNumGeometries(); ++i)
+        UpdateReferenceVertex(collection->getGeometryN(i), x, y, found);
+
+      return;
+    }
+
+// Other geometry types fall back to the envelope lower left corner.
+    if(!geom->isEmpty())
+    {
+      const te::gm::Envelope* mbr = geom->getMBR();
+
+      if(!found || mbr->m_llx < x || (mbr->m_llx == x && mbr->m_lly < y))
+      {
+        x = mbr->m_llx;
+        y = mbr->m_lly;
+        found = true;
+      }
+    }
+  }
+}
+
+te::vp::PartitionedOverlay::TileLayerT::TileLayerT()
+{
+}
+
+te::vp::PartitionedOverlay::TileLayerT::~TileLayerT()
+{
+  clear();
+}
+
+void te::vp::PartitionedOverlay::TileLayerT::clear()
+{
+  for(std::size_t i = 0; i < m_geometries.size(); ++i)
+    delete m_geometries[i];
+
+  m_geometries.clear();
+  m_rtree.clear();
+  m_dataSet.reset();
+}
+
+te::vp::PartitionedOverlay::PartitionedOverlay(const OverlayOperation& operation)
+  : m_operation(operation),
+    m_srid(0),
+    m_outputDataSetType(0),
+    m_isCollection(false),
+    m_outputGeomType(te::gm::UnknownGeometryType),
+    m_maxTileFeatures(20000),
+    m_threadsNumber(0),
+    m_nextTile(0),
+    m_outputCount(0),
+    m_abort(false),
+    m_task(0)
+{
+}
+
+te::vp::PartitionedOverlay::~PartitionedOverlay()
+{
+}
+
+void te::vp::PartitionedOverlay::setFirstInput(const te::vp::InputParams& params, const std::map<std::string, std::string>& attrNameMap)
+{
+  setInput(params, attrNameMap, m_first);
+}
+
+void te::vp::PartitionedOverlay::setSecondInput(const te::vp::InputParams& params, const std::map<std::string, std::string>& attrNameMap)
+{
+  setInput(params, attrNameMap, m_second);
+}
+
+void te::vp::PartitionedOverlay::setOutput(te::da::DataSourcePtr dataSource, te::da::DataSetType* dataSetType, const bool& isCollection)
+{
+  if(!dataSource.get() || !dataSetType)
+    throw te::common::Exception(TE_TR("It is necessary to set the Output DataSource and DataSetType."));
+
+  te::gm::GeometryProperty* geomProp = te::da::GetFirstGeomProperty(dataSetType);
+
+  if(!geomProp)
+    throw te::common::Exception(TE_TR("The output DataSetType has no geometry property."));
+
+  m_outputDataSource = dataSource;
+  m_outputDataSetType = dataSetType;
+  m_outputGeomPropName = geomProp->getName();
+  m_outputGeomType = geomProp->getGeometryType();
+  m_isCollection = isCollection;
+}
+
+void te::vp::PartitionedOverlay::setMaxTileFeatures(const std::size_t& maxTileFeatures)
+{
+  m_maxTileFeatures = std::max<std::size_t>(1, maxTileFeatures);
+}
+
+void te::vp::PartitionedOverlay::setThreadsNumber(const std::size_t& threadsNumber)
+{
+  m_threadsNumber = threadsNumber;
+}
+
+std::size_t te::vp::PartitionedOverlay::execute()
+{
+  if(!m_first.m_dataSource.get() || !m_second.m_dataSource.get())
+    throw te::common::Exception(TE_TR("It is necessary to set both input layers."));
+
+  if(!m_outputDataSource.get() || !m_outputDataSetType)
+    throw te::common::Exception(TE_TR("It is necessary to set the Output DataSource and DataSetType."));
+
+  m_srid = m_first.m_srid;
+
+// Estimate the features density with one streamed pass over each layer.
+  te::gm::Envelope firstExtent;
+  te::gm::Envelope secondExtent;
+  std::vector<SampleT> samples;
+
+  sampleLayer(m_first, firstExtent, samples);
+  sampleLayer(m_second, secondExtent, samples);
+
+  m_extent = te::gm::Envelope();
+
+  switch(m_operation)
+  {
+    case OVERLAY_INTERSECTION:
+      if(firstExtent.isValid() && secondExtent.isValid() && firstExtent.intersects(secondExtent))
+        m_extent = firstExtent.intersection(secondExtent);
+      break;
+
+    case OVERLAY_DIFFERENCE:
+      m_extent = firstExtent;
+      break;
+
+    default:
+      m_extent = firstExtent;
+      m_extent.Union(secondExtent);
+  }
+
+  m_tiles.clear();
+
+  if(m_extent.isValid())
+  {
+    std::vector<SampleT> extentSamples;
+
+    for(std::size_t i = 0; i < samples.size(); ++i)
+    {
+      if(owns(m_extent, samples[i].m_x, samples[i].m_y))
+        extentSamples.push_back(samples[i]);
+    }
+
+    samples.clear();
+
+    buildTiles(m_extent, extentSamples, 0);
+  }
+
+#ifdef TERRALIB_LOGGER_ENABLED
+  std::string message = "Partitioned overlay - " + boost::lexical_cast<std::string>(m_tiles.size()) + " tiles.";
+  TE_CORE_LOG_DEBUG("vp", message.c_str());
+#endif // TERRALIB_LOGGER_ENABLED
+
+  te::common::TaskProgress task(TE_TR("Processing overlay..."), 0, (int)m_tiles.size());
+  task.useTimer(false);
+  task.useMultiThread(true);
+
+  m_nextTile = 0;
+  m_outputCount = 0;
+  m_abort = false;
+  m_errorMessage.clear();
+  m_task = &task;
+
+  std::size_t threadsNumber = m_threadsNumber ? m_threadsNumber : std::max<std::size_t>(1, te::common::GetPhysProcNumber());
+  threadsNumber = std::max<std::size_t>(1, std::min(threadsNumber, m_tiles.size()));
+
+  boost::thread_group threads;
+
+  for(std::size_t i = 0; i < threadsNumber; ++i)
+    threads.add_thread(new boost::thread(processTilesThreadEntry, this));
+
+  threads.join_all();
+
+  m_task = 0;
+  m_tiles.clear();
+
+  if(!m_errorMessage.empty())
+    throw te::common::Exception(m_errorMessage);
+
+  return m_outputCount;
+}
+
+bool te::vp::PartitionedOverlay::isEnabled(const std::map<std::string, te::dt::AbstractData*>& specificParams)
+{
+  std::map<std::string, te::dt::AbstractData*>::const_iterator it = specificParams.find("PARTITIONED");
+
+  if(it == specificParams.end())
+    return false;
+
+  te::dt::Boolean* sd = dynamic_cast<te::dt::Boolean*>(it->second);
+
+  return sd && sd->getValue();
+}
+
+std::size_t te::vp::PartitionedOverlay::getMaxTileFeatures(const std::map<std::string, te::dt::AbstractData*>& specificParams)
+{
+  std::map<std::string, te::dt::AbstractData*>::const_iterator it = specificParams.find("PARTITION_MAX_FEATURES");
+
+  if(it == specificParams.end())
+    return 0;
+
+  te::dt::Int32* sd = dynamic_cast<te::dt::Int32*>(it->second);
+
+  if(!sd || sd->getValue() <= 0)
+    return 0;
+
+  return static_cast<std::size_t>(sd->getValue());
+}
+
+void te::vp::PartitionedOverlay::setInput(const te::vp::InputParams& params, const std::map<std::string, std::string>& attrNameMap, LayerT& layer)
+{
+  if(!params.m_inputDataSource.get() || !params.m_inputDataSetType)
+    throw te::common::Exception(TE_TR("It is necessary to set the DataSource and the DataSetType from Input Layer."));
+
+  te::gm::GeometryProperty* geomProp = te::da::GetFirstGeomProperty(params.m_inputDataSetType);
+
+  if(!geomProp)
+    throw te::common::Exception(TE_TR("The input layer has no geometry property."));
+
+  layer.m_dataSource = params.m_inputDataSource;
+  layer.m_dataSetName = params.m_inputDataSetName.empty() ? params.m_inputDataSetType->getName() : params.m_inputDataSetName;
+  layer.m_geomPropName = geomProp->getName();
+  layer.m_srid = geomProp->getSRID();
+  layer.m_attrNameMap = attrNameMap;
+}
+
+void te::vp::PartitionedOverlay::sampleLayer(const LayerT& layer, te::gm::Envelope& extent, std::vector<SampleT>& samples)
+{
+  const std::size_t maxSamples = 65536;
+  const bool transform = (layer.m_srid != m_srid && layer.m_srid > 0 && m_srid > 0);
+
+  std::auto_ptr<te::da::DataSet> dataSet = layer.m_dataSource->getDataSet(layer.m_dataSetName);
+
+  std::size_t geomPos = te::da::GetFirstSpatialPropertyPos(dataSet.get());
+
+  std::vector<SampleT> layerSamples;
+  std::size_t stride = 1;
+  std::size_t count = 0;
+
+  while(dataSet->moveNext())
+  {
+    if(dataSet->isNull(geomPos))
+      continue;
+
+    std::auto_ptr<te::gm::Geometry> geom = dataSet->getGeometry(geomPos);
+
+    if(geom->isEmpty())
+      continue;
+
+    if(transform)
+    {
+      if(geom->getSRID() <= 0)
+        geom->setSRID(layer.m_srid);
+
+      geom->transform(m_srid);
+    }
+
+    const te::gm::Envelope* mbr = geom->getMBR();
+
+    extent.Union(*mbr);
+
+    if(count % stride == 0)
+    {
+      layerSamples.push_back(SampleT((mbr->m_llx + mbr->m_urx) * 0.5, (mbr->m_lly + mbr->m_ury) * 0.5, 1.0));
+
+// Keep one sample of every 2 * stride features.
+      if(layerSamples.size() == maxSamples)
+      {
+        for(std::size_t i = 0; i < maxSamples / 2; ++i)
+          layerSamples[i] = layerSamples[2 * i];
+
+        layerSamples.resize(maxSamples / 2);
+
+        stride *= 2;
+      }
+    }
+
+    ++count;
+  }
+
+  if(layerSamples.empty())
+    return;
+
+  const double weight = (double)count / (double)layerSamples.size();
+
+  for(std::size_t i = 0; i < layerSamples.size(); ++i)
+  {
+    layerSamples[i].m_weight = weight;
+    samples.push_back(layerSamples[i]);
+  }
+}
+
+void te::vp::PartitionedOverlay::buildTiles(const te::gm::Envelope& extent, std::vector<SampleT>& samples, const std::size_t& depth)
+{
+  double weight = 0.0;
+
+  for(std::size_t i = 0; i < samples.size(); ++i)
+    weight += samples[i].m_weight;
+
+  if(weight <= (double)m_maxTileFeatures || depth >= 16 ||
+     extent.getWidth() <= 0.0 || extent.getHeight() <= 0.0)
+  {
+    m_tiles.push_back(extent);
+    return;
+  }
+
+  const double midX = (extent.m_llx + extent.m_urx) * 0.5;
+  const double midY = (extent.m_lly + extent.m_ury) * 0.5;
+
+  te::gm::Envelope children[4] =
+  {
+    te::gm::Envelope(extent.m_llx, extent.m_lly, midX, midY),
+    te::gm::Envelope(midX, extent.m_lly, extent.m_urx, midY),
+    te::gm::Envelope(extent.m_llx, midY, midX, extent.m_ury),
+    te::gm::Envelope(midX, midY, extent.m_urx, extent.m_ury)
+  };
+
+  std::vector<SampleT> childrenSamples[4];
+
+  for(std::size_t i = 0; i < samples.size(); ++i)
+  {
+    std::size_t child = (samples[i].m_x < midX ? 0 : 1) + (samples[i].m_y < midY ? 0 : 2);
+
+    childrenSamples[child].push_back(samples[i]);
+  }
+
+  samples.clear();
+
+  for(std::size_t c = 0; c < 4; ++c)
+    buildTiles(children[c], childrenSamples[c], depth + 1);
+}
+
+void te::vp::PartitionedOverlay::loadTileLayer(const LayerT& layer, const te::gm::Envelope& envelope, TileLayerT& tileLayer)
+{
+  tileLayer.clear();
+
+  const bool transform = (layer.m_srid != m_srid && layer.m_srid > 0 && m_srid > 0);
+
+  te::gm::Envelope queryEnvelope(envelope);
+
+  if(transform)
+  {
+    queryEnvelope.transform(m_srid, layer.m_srid);
+
+// The transformed corners may not bound the whole transformed area.
+    const double marginX = queryEnvelope.getWidth() * 0.01;
+    const double marginY = queryEnvelope.getHeight() * 0.01;
+
+    queryEnvelope.m_llx -= marginX;
+    queryEnvelope.m_lly -= marginY;
+    queryEnvelope.m_urx += marginX;
+    queryEnvelope.m_ury += marginY;
+  }
+
+  {
+    boost::lock_guard<boost::mutex> lock(m_mtxIO);
+
+    std::auto_ptr<te::da::DataSet> dataSet = layer.m_dataSource->getDataSet(layer.m_dataSetName, layer.m_geomPropName, &queryEnvelope, te::gm::INTERSECTS);
+
+// Some drivers do not process spatial filters: the whole dataset is read and the envelope filter below drops the other features.
+    if(dataSet.get() == 0)
+      dataSet = layer.m_dataSource->getDataSet(layer.m_dataSetName);
+
+    if(dataSet.get() == 0)
+      throw te::vp::Exception(TE_TR("Could not read the input dataset: ") + layer.m_dataSetName);
+
+    tileLayer.m_dataSet.reset(new te::mem::DataSet(*dataSet));
+  }
+
+  std::size_t geomPos = te::da::GetFirstSpatialPropertyPos(tileLayer.m_dataSet.get());
+  std::size_t pos = 0;
+
+  tileLayer.m_dataSet->moveBeforeFirst();
+
+  while(tileLayer.m_dataSet->moveNext())
+  {
+    te::gm::Geometry* geom = 0;
+
+    if(!tileLayer.m_dataSet->isNull(geomPos))
+    {
+      geom = tileLayer.m_dataSet->getGeometry(geomPos).release();
+
+      if(transform)
+      {
+        if(geom->getSRID() <= 0)
+          geom->setSRID(layer.m_srid);
+
+        geom->transform(m_srid);
+      }
+
+      if(geom->isEmpty() || !geom->getMBR()->intersects(envelope))
+      {
+        delete geom;
+        geom = 0;
+      }
+      else
+      {
+        tileLayer.m_rtree.insert(*geom->getMBR(), pos);
+      }
+    }
+
+    tileLayer.m_geometries.push_back(geom);
+
+    ++pos;
+  }
+}
+
+void te::vp::PartitionedOverlay::processTile(const te::gm::Envelope& tile, te::mem::DataSet* outputDataSet)
+{
+  const bool computePairs = (m_operation != OVERLAY_DIFFERENCE);
+  const bool computeFirstDifferences = (m_operation != OVERLAY_INTERSECTION);
+  const bool computeSecondDifferences = (m_operation == OVERLAY_UNION);
+
+  TileLayerT firstTile;
+  TileLayerT secondTile;
+
+// The differences need all the features covering the owned ones, even beyond the tile.
+  loadTileLayer(m_first, tile, firstTile);
+
+  te::gm::Envelope secondEnvelope(tile);
+
+  if(computeFirstDifferences)
+  {
+    for(std::size_t i = 0; i < firstTile.m_geometries.size(); ++i)
+    {
+      if(firstTile.m_geometries[i] && ownsGeometry(tile, firstTile.m_geometries[i]))
+        secondEnvelope.Union(*firstTile.m_geometries[i]->getMBR());
+    }
+  }
+
+  loadTileLayer(m_second, secondEnvelope, secondTile);
+
+  if(computeSecondDifferences)
+  {
+    te::gm::Envelope firstEnvelope(tile);
+    bool expanded = false;
+
+    for(std::size_t i = 0; i < secondTile.m_geometries.size(); ++i)
+    {
+      const te::gm::Geometry* geom = secondTile.m_geometries[i];
+
+      if(geom && ownsGeometry(tile, geom) && !geom->getMBR()->within(tile))
+      {
+        firstEnvelope.Union(*geom->getMBR());
+        expanded = true;
+      }
+    }
+
+    if(expanded)
+      loadTileLayer(m_first, firstEnvelope, firstTile);
+  }
+
+  if(computePairs)
+  {
+    for(std::size_t i = 0; i < firstTile.m_geometries.size(); ++i)
+    {
+      const te::gm::Geometry* firstGeom = firstTile.m_geometries[i];
+
+      if(!firstGeom)
+        continue;
+
+      std::vector<std::size_t> report;
+      secondTile.m_rtree.search(*firstGeom->getMBR(), report);
+
+      te::gm::ScopedGEOSCache geosCache(*firstGeom);
+
+      for(std::size_t j = 0; j < report.size(); ++j)
+      {
+        const te::gm::Geometry* secondGeom = secondTile.m_geometries[report[j]];
+
+// The reference vertex of the piece lies inside both envelopes.
+        if(!firstGeom->getMBR()->intersection(*secondGeom->getMBR()).intersects(tile))
+          continue;
+
+        if(!firstGeom->intersects(secondGeom))
+          continue;
+
+        if(m_operation == OVERLAY_UNION && firstGeom->touches(secondGeom))
+          continue;
+
+        std::auto_ptr<te::gm::Geometry> result(firstGeom->intersection(secondGeom));
+
+        if(!result.get() || result->isEmpty() || !ownsGeometry(tile, result.get()))
+          continue;
+
+        if(!result->isValid())
+        {
+#ifdef TERRALIB_LOGGER_ENABLED
+          TE_CORE_LOG_DEBUG("vp", "Partitioned overlay - Invalid geometry found");
+#endif //TERRALIB_LOGGER_ENABLED
+          continue;
+        }
+
+        te::mem::DataSetItem* item = new te::mem::DataSetItem(outputDataSet);
+
+        copyAttributes(m_first, firstTile, i, item);
+        copyAttributes(m_second, secondTile, report[j], item);
+
+        addOutputItems(outputDataSet, item, result.release());
+      }
+    }
+  }
+
+  if(computeFirstDifferences)
+    addDifferences(tile, firstTile, secondTile, m_first, outputDataSet);
+
+  if(computeSecondDifferences)
+    addDifferences(tile, secondTile, firstTile, m_second, outputDataSet);
+}
+
+void te::vp::PartitionedOverlay::addDifferences(const te::gm::Envelope& tile, TileLayerT& owners, TileLayerT& others,
+                                                const LayerT& ownersLayer, te::mem::DataSet* outputDataSet)
+{
+  for(std::size_t i = 0; i < owners.m_geometries.size(); ++i)
+  {
+    const te::gm::Geometry* geom = owners.m_geometries[i];
+
+    if(!geom || !ownsGeometry(tile, geom))
+      continue;
+
+    std::vector<std::size_t> report;
+    others.m_rtree.search(*geom->getMBR(), report);
+
+    te::gm::ScopedGEOSCache geosCache(*geom);
+
+    std::vector<te::gm::Geometry*> covering;
+
+    for(std::size_t j = 0; j < report.size(); ++j)
+    {
+      const te::gm::Geometry* otherGeom = others.m_geometries[report[j]];
+
+      if(geom->intersects(otherGeom))
+        covering.push_back(static_cast<te::gm::Geometry*>(otherGeom->clone()));
+    }
+
+    std::auto_ptr<te::gm::Geometry> result;
+
+    if(covering.empty())
+    {
+      result.reset(static_cast<te::gm::Geometry*>(geom->clone()));
+    }
+    else
+    {
+      std::auto_ptr<te::gm::Geometry> coverage(te::vp::GetCascadedUnion(covering));
+
+      result.reset(geom->difference(coverage.get()));
+    }
+
+    if(!result.get() || result->isEmpty())
+      continue;
+
+    if(!result->isValid())
+    {
+#ifdef TERRALIB_LOGGER_ENABLED
+      TE_CORE_LOG_DEBUG("vp", "Partitioned overlay - Invalid geometry found");
+#endif //TERRALIB_LOGGER_ENABLED
+      continue;
+    }
+
+    te::mem::DataSetItem* item = new te::mem::DataSetItem(outputDataSet);
+
+    copyAttributes(ownersLayer, owners, i, item);
+
+    addOutputItems(outputDataSet, item, result.release());
+  }
+}
+
+void te::vp::PartitionedOverlay::copyAttributes(const LayerT& layer, TileLayerT& tileLayer, const std::size_t& pos, te::mem::DataSetItem* item)
+{
+  te::da::DataSet* dataSet = tileLayer.m_dataSet.get();
+
+  dataSet->move(pos);
+
+  for(std::map<std::string, std::string>::const_iterator it = layer.m_attrNameMap.begin(); it != layer.m_attrNameMap.end(); ++it)
+  {
+    if(!dataSet->isNull(it->second))
+      item->setValue(it->first, dataSet->getValue(it->second).release());
+  }
+}
+
+void te::vp::PartitionedOverlay::addOutputItems(te::mem::DataSet* outputDataSet, te::mem::DataSetItem* item, te::gm::Geometry* geom)
+{
+  std::auto_ptr<te::mem::DataSetItem> baseItem(item);
+  std::auto_ptr<te::gm::Geometry> result(geom);
+
+  std::vector<te::gm::Geometry*> geomVec;
+
+  if(m_isCollection)
+  {
+    geomVec.push_back(result.release());
+  }
+  else
+  {
+    std::vector<te::gm::Geometry*> singles;
+    te::gm::Multi2Single(result.get(), singles);
+
+    if(singles.size() == 1 && singles[0] == result.get())
+    {
+      geomVec.push_back(result.release());
+    }
+    else
+    {
+// The parts belong to the result collection.
+      for(std::size_t i = 0; i < singles.size(); ++i)
+        geomVec.push_back(static_cast<te::gm::Geometry*>(singles[i]->clone()));
+    }
+  }
+
+  for(std::size_t g = 0; g < geomVec.size(); ++g)
+  {
+    te::gm::Geometry* currentGeom = geomVec[g];
+
+    if(m_isCollection && !te::vp::IsMultiType(currentGeom->getGeomTypeId()))
+      currentGeom = te::vp::SetGeomAsMulti(currentGeom);
+
+    if(m_outputGeomType != te::gm::GeometryType && currentGeom->getGeomTypeId() != m_outputGeomType)
+    {
+      delete currentGeom;
+      continue;
+    }
+
+    std::auto_ptr<te::mem::DataSetItem> currentItem = baseItem->clone();
+    currentItem->setGeometry(m_outputGeomPropName, currentGeom);
+
+    outputDataSet->add(currentItem.release());
+  }
+}
+
+bool te::vp::PartitionedOverlay::owns(const te::gm::Envelope& tile, double x, double y) const
+{
+  x = std::min(std::max(x, m_extent.m_llx), m_extent.m_urx);
+  y = std::min(std::max(y, m_extent.m_lly), m_extent.m_ury);
+
+  return x >= tile.m_llx && y >= tile.m_lly &&
+         (x < tile.m_urx || tile.m_urx >= m_extent.m_urx) &&
+         (y < tile.m_ury || tile.m_ury >= m_extent.m_ury);
+}
+
+bool te::vp::PartitionedOverlay::ownsGeometry(const te::gm::Envelope& tile, const te::gm::Geometry* geom) const
+{
+  double x = 0.0;
+  double y = 0.0;
+  bool found = false;
+
+  UpdateReferenceVertex(geom, x, y, found);
+
+  return found && owns(tile, x, y);
+}
+
+void te::vp::PartitionedOverlay::processTilesThreadEntry(PartitionedOverlay* overlay)
+{
+  while(true)
+  {
+    te::gm::Envelope tile;
+
+    {
+      boost::lock_guard<boost::mutex> lock(overlay->m_mtx);
+
+      if(overlay->m_abort || overlay->m_nextTile >= overlay->m_tiles.size())
+        return;
+
+      tile = overlay->m_tiles[overlay->m_nextTile];
+      ++overlay->m_nextTile;
+    }
+
+    try
+    {
+      std::auto_ptr<te::mem::DataSet> outputDataSet(new te::mem::DataSet(overlay->m_outputDataSetType));
+
+      overlay->processTile(tile, outputDataSet.get());
+
+      std::size_t outputSize = outputDataSet->size();
+
+      if(outputSize > 0)
+      {
+        boost::lock_guard<boost::mutex> lock(overlay->m_mtxIO);
+
+        outputDataSet->moveBeforeFirst();
+
+        std::auto_ptr<te::da::DataSet> dataSetPrepared = PrepareAdd(outputDataSet.get(), overlay->m_outputDataSetType);
+        te::da::DataSet* dataSetToSave = dataSetPrepared.get();
+
+// PrepareAdd returns the given dataset itself when there are no columns to hide.
+        if(dataSetToSave == outputDataSet.get())
+          dataSetPrepared.release();
+
+        Save(overlay->m_outputDataSource.get(), dataSetToSave, overlay->m_outputDataSetType);
+      }
+
+      boost::lock_guard<boost::mutex> lock(overlay->m_mtx);
+
+      overlay->m_outputCount += outputSize;
+
+      overlay->m_task->pulse();
+
+      if(!overlay->m_task->isActive())
+      {
+        overlay->m_abort = true;
+
+        if(overlay->m_errorMessage.empty())
+          overlay->m_errorMessage = TE_TR("Operation canceled!");
+
+        return;
+      }
+    }
+    catch(const std::exception& e)
+    {
+      boost::lock_guard<boost::mutex> lock(overlay->m_mtx);
+
+      overlay->m_abort = true;
+
+      if(overlay->m_errorMessage.empty())
+        overlay->m_errorMessage = e.what();
+
+      return;
+    }
+    catch(...)
+    {
+      boost::lock_guard<boost::mutex> lock(overlay->m_mtx);
+
+      overlay->m_abort = true;
+
+      if(overlay->m_errorMessage.empty())
+        overlay->m_errorMessage = TE_TR("Partitioned overlay - Unexpected error processing a tile.");
+
+      return;
+    }
+  }
+}
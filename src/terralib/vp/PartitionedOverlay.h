@@ -0,0 +1,295 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+ \file PartitionedOverlay.h
+
+ \brief Out-of-core overlay of two layers processed by tiles.
+
+ \ingroup vp
+ */
+
+#ifndef __TERRALIB_VP_INTERNAL_PARTITIONED_OVERLAY_H
+#define __TERRALIB_VP_INTERNAL_PARTITIONED_OVERLAY_H
+
+// TerraLib
+#include "../dataaccess/datasource/DataSource.h"
+#include "../geometry/Enums.h"
+#include "../geometry/Envelope.h"
+#include "../sam/rtree.h"
+#include "Config.h"
+#include "Enums.h"
+#include "InputParams.h"
+
+// STL
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Boost
+#include <boost/thread/mutex.hpp>
+
+namespace te
+{
+  namespace common
+  {
+    class TaskProgress;
+  }
+
+  namespace da
+  {
+    class DataSetType;
+  }
+
+  namespace dt
+  {
+    class AbstractData;
+  }
+
+  namespace gm
+  {
+    class Geometry;
+  }
+
+  namespace mem
+  {
+    class DataSet;
+    class DataSetItem;
+  }
+
+  namespace vp
+  {
+    /*!
+      \class PartitionedOverlay
+
+      \brief Out-of-core overlay of two layers processed by tiles.
+
+      \details The extent covered by the operation is split by a quadtree until the
+               estimated number of features of each tile is below a limit, using a sample
+               of the feature envelope centers collected by a single streamed pass over both
+               layers. Each tile loads only the features touching it (through spatial filters
+               on the input data sources) and the tiles are processed by a pool of threads.
+
+               A piece is written only by the tile holding its reference vertex (the lowest-leftmost
+               vertex), so pieces touching several tiles are neither duplicated nor split at the tile
+               boundaries. Each finished tile is saved to the output data source.
+
+      \note The whole datasets are processed, selections made on the input layers are not considered.
+    */
+    class TEVPEXPORT PartitionedOverlay
+    {
+      public:
+
+        PartitionedOverlay(const OverlayOperation& operation);
+
+        ~PartitionedOverlay();
+
+        /*!
+          \brief It sets the first input layer.
+
+          \param params      The first layer input parameters (data source and dataset type are required).
+          \param attrNameMap The output attribute names mapped to the first layer attribute names.
+        */
+        void setFirstInput(const te::vp::InputParams& params, const std::map<std::string, std::string>& attrNameMap);
+
+        /*!
+          \brief It sets the second input layer.
+
+          \param params      The second layer input parameters (data source and dataset type are required).
+          \param attrNameMap The output attribute names mapped to the second layer attribute names.
+        */
+        void setSecondInput(const te::vp::InputParams& params, const std::map<std::string, std::string>& attrNameMap);
+
+        /*!
+          \brief It sets the output.
+
+          \param dataSource   The output data source.
+          \param dataSetType  The output dataset type (the caller keeps its ownership).
+          \param isCollection If true the output geometries are saved as multi geometries, otherwise they are split in single ones.
+        */
+        void setOutput(te::da::DataSourcePtr dataSource, te::da::DataSetType* dataSetType, const bool& isCollection);
+
+        /*!
+          \brief It sets the maximum estimated number of features loaded for each tile (default: 20000).
+        */
+        void setMaxTileFeatures(const std::size_t& maxTileFeatures);
+
+        /*!
+          \brief It sets the number of worker threads (default: 0 - the number of physical processors).
+        */
+        void setThreadsNumber(const std::size_t& threadsNumber);
+
+        /*!
+          \brief It runs the overlay, saving the result tile by tile.
+
+          \return The number of saved features.
+
+          \exception te::common::Exception If the parameters are not valid, an error happens in a tile or the operation is canceled.
+        */
+        std::size_t execute();
+
+        /*!
+          \brief It checks the "PARTITIONED" specific parameter.
+
+          \return True if the partitioned overlay was requested.
+        */
+        static bool isEnabled(const std::map<std::string, te::dt::AbstractData*>& specificParams);
+
+        /*!
+          \brief It returns the "PARTITION_MAX_FEATURES" specific parameter or 0 if it was not set.
+        */
+        static std::size_t getMaxTileFeatures(const std::map<std::string, te::dt::AbstractData*>& specificParams);
+
+      protected:
+
+        /*! \brief An input layer description. */
+        class LayerT
+        {
+          public:
+
+            te::da::DataSourcePtr m_dataSource;               //!< The layer data source.
+            std::string m_dataSetName;                        //!< The dataset name.
+            std::string m_geomPropName;                       //!< The geometry property name.
+            int m_srid;                                       //!< The geometries SRID.
+            std::map<std::string, std::string> m_attrNameMap; //!< The output attribute names mapped to the layer attribute names.
+
+            LayerT() : m_srid(0) {}
+        };
+
+        /*! \brief The features of one layer loaded for a tile. */
+        class TileLayerT
+        {
+          public:
+
+            std::auto_ptr<te::mem::DataSet> m_dataSet;          //!< The loaded features.
+            std::vector<te::gm::Geometry*> m_geometries;        //!< The features geometries in the operation SRID (NULL for the discarded ones).
+            te::sam::rtree::Index<std::size_t, 8> m_rtree;      //!< The geometries index.
+
+            TileLayerT();
+
+            ~TileLayerT();
+
+            void clear();
+        };
+
+        /*! \brief A sampled feature envelope center. */
+        class SampleT
+        {
+          public:
+
+            double m_x;      //!< The center x-coordinate.
+            double m_y;      //!< The center y-coordinate.
+            double m_weight; //!< The number of features represented by the sample.
+
+            SampleT() : m_x(0), m_y(0), m_weight(0) {}
+
+            SampleT(const double& x, const double& y, const double& weight) : m_x(x), m_y(y), m_weight(weight) {}
+        };
+
+        /*!
+          \brief It validates and stores an input layer description.
+        */
+        void setInput(const te::vp::InputParams& params, const std::map<std::string, std::string>& attrNameMap, LayerT& layer);
+
+        /*!
+          \brief It reads all the layer envelopes once, returning their union and a sample of their centers.
+        */
+        void sampleLayer(const LayerT& layer, te::gm::Envelope& extent, std::vector<SampleT>& samples);
+
+        /*!
+          \brief It splits the extent recursively until the estimated number of features of each tile is below the limit.
+        */
+        void buildTiles(const te::gm::Envelope& extent, std::vector<SampleT>& samples, const std::size_t& depth);
+
+        /*!
+          \brief It loads the layer features intersecting the given envelope (given in the operation SRID).
+        */
+        void loadTileLayer(const LayerT& layer, const te::gm::Envelope& envelope, TileLayerT& tileLayer);
+
+        /*!
+          \brief It computes one tile, returning the output items owned by it.
+        */
+        void processTile(const te::gm::Envelope& tile, te::mem::DataSet* outputDataSet);
+
+        /*!
+          \brief It adds the pieces of the owned features not covered by the other layer.
+        */
+        void addDifferences(const te::gm::Envelope& tile, TileLayerT& owners, TileLayerT& others,
+                            const LayerT& ownersLayer, te::mem::DataSet* outputDataSet);
+
+        /*!
+          \brief It copies the mapped attributes of a loaded feature into an output item.
+        */
+        void copyAttributes(const LayerT& layer, TileLayerT& tileLayer, const std::size_t& pos, te::mem::DataSetItem* item);
+
+        /*!
+          \brief It adds the output items of a resulting geometry, taking the ownership of the item and the geometry.
+        */
+        void addOutputItems(te::mem::DataSet* outputDataSet, te::mem::DataSetItem* item, te::gm::Geometry* geom);
+
+        /*!
+          \brief It checks if a point is owned by the tile (half-open tiles, closed at the operation extent upper limits).
+        */
+        bool owns(const te::gm::Envelope& tile, double x, double y) const;
+
+        /*!
+          \brief It checks if the tile owns the geometry reference vertex.
+        */
+        bool ownsGeometry(const te::gm::Envelope& tile, const te::gm::Geometry* geom) const;
+
+        /*! \brief The worker threads entry. */
+        static void processTilesThreadEntry(PartitionedOverlay* overlay);
+
+      private:
+
+        PartitionedOverlay(const PartitionedOverlay&);
+
+        const PartitionedOverlay& operator=(const PartitionedOverlay&);
+
+        OverlayOperation m_operation;                 //!< The overlay operation.
+        LayerT m_first;                               //!< The first layer.
+        LayerT m_second;                              //!< The second layer.
+        int m_srid;                                   //!< The operation SRID (the first layer one).
+
+        te::da::DataSourcePtr m_outputDataSource;     //!< The output data source.
+        te::da::DataSetType* m_outputDataSetType;     //!< The output dataset type.
+        bool m_isCollection;                          //!< Save multi geometries.
+        std::string m_outputGeomPropName;             //!< The output geometry property name.
+        te::gm::GeomType m_outputGeomType;            //!< The output geometry type.
+
+        std::size_t m_maxTileFeatures;                //!< The maximum estimated number of features of a tile.
+        std::size_t m_threadsNumber;                  //!< The number of worker threads.
+
+        te::gm::Envelope m_extent;                    //!< The operation extent.
+        std::vector<te::gm::Envelope> m_tiles;        //!< The tiles to be processed.
+
+        std::size_t m_nextTile;                       //!< The next tile to be processed.
+        std::size_t m_outputCount;                    //!< The number of saved features.
+        bool m_abort;                                 //!< Stop the workers.
+        std::string m_errorMessage;                   //!< The first error raised by a worker.
+        te::common::TaskProgress* m_task;             //!< The progress of the running operation.
+
+        boost::mutex m_mtx;                           //!< It protects the tiles queue and the status.
+        boost::mutex m_mtxIO;                         //!< It serializes the data sources access.
+    };
+  } // end namespace vp
+} // end namespace te
+
+#endif // __TERRALIB_VP_INTERNAL_PARTITIONED_OVERLAY_H
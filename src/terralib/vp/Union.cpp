@@ -32,6 +32,7 @@ TerraLib Team at <terralib-team@terralib.org>.
 #include "../geometry/MultiPolygon.h"
 #include "../geometry/Utils.h"
 #include "ComplexData.h"
+#include "PartitionedOverlay.h"
 #include "Union.h"
 #include "Utils.h"
 
@@ -41,6 +42,9 @@ te::vp::Union::Union()
 
 bool te::vp::Union::executeMemory(te::vp::AlgorithmParams* mainParams)
 {
+  if (te::vp::PartitionedOverlay::isEnabled(mainParams->getSpecificParams()))
+    return executePartitioned(mainParams);
+
   te::vp::ValidateAlgorithmParams(mainParams, te::vp::MEMORY);
 
   std::vector<te::vp::InputParams> inputParams =  mainParams->getInputParams();
@@ -312,6 +316,37 @@ std::vector<std::pair<std::string, std::string> > te::vp::Union::getProperties(
   return propNames;
 }
 
+bool te::vp::Union::executePartitioned(te::vp::AlgorithmParams* mainParams)
+{
+  std::vector<te::vp::InputParams> inputParams = mainParams->getInputParams();
+
+  if (inputParams.size() < 2)
+    throw te::common::Exception(
+        TE_TR("It is necessary more than one item for performing the operation."));
+
+  std::map<std::string, te::dt::AbstractData*> specificParams =
+      mainParams->getSpecificParams();
+
+  std::unique_ptr<te::da::DataSetType> outputDataSetType(
+      getOutputDataSetType(mainParams));
+
+  te::vp::PartitionedOverlay overlay(te::vp::OVERLAY_UNION);
+  overlay.setFirstInput(inputParams[0], m_firstAttrNameMap);
+  overlay.setSecondInput(inputParams[1], m_secondAttrNameMap);
+  overlay.setOutput(mainParams->getOutputDataSource(),
+                    outputDataSetType.get(), isCollection(specificParams));
+
+  std::size_t maxTileFeatures =
+      te::vp::PartitionedOverlay::getMaxTileFeatures(specificParams);
+  if (maxTileFeatures > 0)
+    overlay.setMaxTileFeatures(maxTileFeatures);
+
+  if (overlay.execute() == 0)
+    throw te::common::Exception(TE_TR("The resultant layer is empty!"));
+
+  return true;
+}
+
 bool te::vp::Union::executeQuery(te::vp::AlgorithmParams* mainParams)
 {
   return false;
@@ -54,6 +54,13 @@ namespace te
       bool executeQuery(te::vp::AlgorithmParams* mainParams);
 
     protected:
+     /*!
+       \brief It runs the operation with the partitioned overlay, reading the input layers tile by tile from their data sources.
+
+       \note It is used by executeMemory when the "PARTITIONED" specific parameter is true.
+     */
+     bool executePartitioned(te::vp::AlgorithmParams* mainParams);
+
      std::vector<std::pair<std::string, std::string> > getProperties(
          const std::map<std::string, te::dt::AbstractData*>& specificParams);
 
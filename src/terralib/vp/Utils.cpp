@@ -38,6 +38,7 @@
 #include "../dataaccess/datasource/DataSourceTransactor.h"
 #include "../dataaccess/utils/Utils.h"
 
+#include "../geometry/Envelope.h"
 #include "../geometry/GeometryProperty.h"
 #include "../geometry/MultiPoint.h"
 #include "../geometry/MultiLineString.h"
@@ -53,11 +54,104 @@
 
 // Boost
 #include <boost/algorithm/string.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
+//STL
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+  /*!
+    \brief It interleaves the bits of two 16 bits values into a Morton (Z-order) code.
+  */
+  boost::uint32_t MortonCode(boost::uint32_t x, boost::uint32_t y)
+  {
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+
+    y = (y | (y << 8)) & 0x00FF00FF;
+    y = (y | (y << 4)) & 0x0F0F0F0F;
+    y = (y | (y << 2)) & 0x33333333;
+    y = (y | (y << 1)) & 0x55555555;
+
+    return x | (y << 1);
+  }
+
+  bool CompareMortonKeys(const std::pair<boost::uint32_t, te::gm::Geometry*>& lhs,
+                         const std::pair<boost::uint32_t, te::gm::Geometry*>& rhs)
+  {
+    return lhs.first < rhs.first;
+  }
+
+  /*!
+    \brief It sorts the geometries by the Morton order of their envelope centers.
+  */
+  void SortByMortonOrder(std::vector<te::gm::Geometry*>& geomVec)
+  {
+    te::gm::Envelope extent;
+
+    for(std::size_t i = 0; i < geomVec.size(); ++i)
+      extent.Union(*geomVec[i]->getMBR());
+
+    const double width = extent.getWidth();
+    const double height = extent.getHeight();
+    const double xFactor = (width > 0.0) ? (65535.0 / width) : 0.0;
+    const double yFactor = (height > 0.0) ? (65535.0 / height) : 0.0;
+
+    std::vector<std::pair<boost::uint32_t, te::gm::Geometry*> > keys(geomVec.size());
+
+    for(std::size_t i = 0; i < geomVec.size(); ++i)
+    {
+      const te::gm::Envelope* mbr = geomVec[i]->getMBR();
+
+      if(!mbr->isValid() || !extent.isValid())
+      {
+        keys[i] = std::make_pair(0, geomVec[i]);
+        continue;
+      }
+
+      boost::uint32_t x = static_cast<boost::uint32_t>((((mbr->getLowerLeftX() + mbr->getUpperRightX()) * 0.5) - extent.getLowerLeftX()) * xFactor);
+      boost::uint32_t y = static_cast<boost::uint32_t>((((mbr->getLowerLeftY() + mbr->getUpperRightY()) * 0.5) - extent.getLowerLeftY()) * yFactor);
+
+      keys[i] = std::make_pair(MortonCode(std::min<boost::uint32_t>(x, 65535), std::min<boost::uint32_t>(y, 65535)), geomVec[i]);
+    }
+
+    std::stable_sort(keys.begin(), keys.end(), CompareMortonKeys);
+
+    for(std::size_t i = 0; i < keys.size(); ++i)
+      geomVec[i] = keys[i].second;
+  }
+
+  /*!
+    \brief It returns the cascaded union of the valid geometries of a group (the first one is used if none is valid).
+  */
+  te::gm::Geometry* GetValidGeometriesUnion(const std::vector<te::mem::DataSetItem*>& items, std::size_t geomIdx)
+  {
+    std::vector<te::gm::Geometry*> geomVec;
+    geomVec.reserve(items.size());
+
+    for(std::size_t i = 0; i < items.size(); ++i)
+    {
+      std::auto_ptr<te::gm::Geometry> currentGeom = items[i]->getGeometry(geomIdx);
+
+      if(currentGeom.get() && currentGeom->isValid())
+        geomVec.push_back(currentGeom.release());
+    }
+
+    if(geomVec.empty())
+      return items[0]->getGeometry(geomIdx).release();
+
+    return te::vp::GetCascadedUnion(geomVec);
+  }
+}
+
 
 std::auto_ptr<te::gm::Geometry> te::vp::GetGeometryUnion(const std::vector<gm::Geometry*> &geomVec)
 {
@@ -86,50 +180,71 @@ std::auto_ptr<te::gm::Geometry> te::vp::GetGeometryUnion(const std::vector<gm::G
   return geometry;
 }
 
-te::gm::Geometry* te::vp::GetGeometryUnion(const std::vector<te::mem::DataSetItem*>& items, size_t geomIdx, te::gm::GeomType outGeoType)
+te::gm::Geometry* te::vp::GetCascadedUnion(std::vector<te::gm::Geometry*>& geomVec)
 {
-  te::gm::Geometry* resultGeometry(0);
+  std::vector<te::gm::Geometry*> level;
+  level.reserve(geomVec.size());
+
+  for(std::size_t i = 0; i < geomVec.size(); ++i)
+  {
+    if(geomVec[i])
+      level.push_back(geomVec[i]);
+  }
 
-  std::auto_ptr<te::gm::Geometry> seedGeometry = items[0]->getGeometry(geomIdx);
+  geomVec.clear();
 
-  if(items.size() < 2)
-    resultGeometry = seedGeometry.release();
+  if(level.empty())
+    return 0;
 
-  if(items.size() == 2)
-  {
-    std::auto_ptr<te::gm::Geometry> teGeom = items[1]->getGeometry(geomIdx);
+  if(level.size() > 2)
+    SortByMortonOrder(level);
 
-    if(teGeom->isValid())
-      resultGeometry = seedGeometry->Union(teGeom.release());
-    else
-      resultGeometry = seedGeometry.release();
-  }
-  if(items.size() > 2)
+// Each pass merges neighbour pairs, halving the number of geometries.
+  while(level.size() > 1)
   {
-    //te::gm::GeometryCollection* teGeomColl = new te::gm::GeometryCollection(0, te::gm::GeometryCollectionType, seedGeometry->getSRID());
+    std::size_t merged = 0;
 
-    std::size_t pos = 1;
-    while (!seedGeometry->isValid())
+    for(std::size_t i = 0; i < level.size(); i += 2)
     {
-      seedGeometry = items[pos]->getGeometry(geomIdx);
-      ++pos;
-    }
+      if(i + 1 == level.size())
+      {
+        level[merged++] = level[i];
+        continue;
+      }
 
-    for (std::size_t i = pos; i < items.size(); ++i)
-    {
-      std::auto_ptr<te::gm::Geometry> currentGeom = items[i]->getGeometry(geomIdx);
+      te::gm::Geometry* result = 0;
 
-      if(currentGeom->isValid())
-        resultGeometry = seedGeometry->Union(currentGeom.release());
+      try
+      {
+        result = level[i]->Union(level[i + 1]);
+      }
+      catch(...)
+      {
+        for(std::size_t j = 0; j < merged; ++j)
+          delete level[j];
 
-      seedGeometry.reset(resultGeometry);
-    }
+        for(std::size_t j = i; j < level.size(); ++j)
+          delete level[j];
 
-    resultGeometry = seedGeometry.release();
-    //resultGeometry = seedGeometry->Union(teGeomColl);
+        throw;
+      }
+
+      delete level[i];
+      delete level[i + 1];
 
+      level[merged++] = result;
+    }
+
+    level.resize(merged);
   }
 
+  return level[0];
+}
+
+te::gm::Geometry* te::vp::GetGeometryUnion(const std::vector<te::mem::DataSetItem*>& items, size_t geomIdx, te::gm::GeomType outGeoType)
+{
+  te::gm::Geometry* resultGeometry = GetValidGeometriesUnion(items, geomIdx);
+
   if (resultGeometry->getGeomTypeId() != outGeoType)
   {
     if(resultGeometry->getGeomTypeId() == te::gm::GeometryCollectionType)
@@ -159,38 +274,7 @@ te::gm::Geometry* te::vp::GetGeometryUnion(const std::vector<te::mem::DataSetIte
 
 te::gm::Geometry* te::vp::GetGeometryUnion(const std::vector<te::mem::DataSetItem*>& items, size_t geomIdx)
 {
-  te::gm::Geometry* resultGeometry(0);
-
-  std::auto_ptr<te::gm::Geometry> seedGeometry = items[0]->getGeometry(geomIdx);
-
-  if(items.size() < 2)
-    resultGeometry = seedGeometry.release();
-
-  if(items.size() == 2)
-  {
-    std::auto_ptr<te::gm::Geometry> teGeom = items[1]->getGeometry(geomIdx);
-
-    if(teGeom->isValid())
-      resultGeometry = seedGeometry->Union(teGeom.release());
-    else
-      resultGeometry = seedGeometry.release();
-  }
-  if(items.size() > 2)
-  {
-    te::gm::GeometryCollection* teGeomColl = new te::gm::GeometryCollection(0, te::gm::GeometryCollectionType, seedGeometry->getSRID());
-
-    for(std::size_t i = 1; i < items.size(); ++i)
-    {
-      std::auto_ptr<te::gm::Geometry> currentGeom = items[i]->getGeometry(geomIdx);
-
-      if(currentGeom->isValid())
-        teGeomColl->add(currentGeom.release());
-    }
-
-    resultGeometry = seedGeometry->Union(teGeomColl);
-
-  }
-  return resultGeometry;
+  return GetValidGeometriesUnion(items, geomIdx);
 }
 
 void te::vp::SplitGeometryCollection(te::gm::GeometryCollection* gcIn, te::gm::GeometryCollection* gcOut)
@@ -62,6 +62,22 @@ namespace te
 
     TEVPEXPORT std::auto_ptr<te::gm::Geometry> GetGeometryUnion(const std::vector<te::gm::Geometry*>& geomVec);
 
+    /*!
+      \brief It returns the union of a geometry vector using a cascaded (tree) reduction.
+
+      \details The geometries are sorted by the Morton order of their envelope centers
+                and merged pairwise, level by level, so each union step only handles
+                spatially close operands of similar size. The operands are released as
+                soon as they are merged, so no extra copies of the group are kept.
+
+      \param geomVec The geometries to be merged. The function takes their ownership and clears the vector.
+
+      \return The union of the geometries (the caller takes its ownership) or a NULL pointer if the vector is empty.
+
+      \note Null entries are ignored.
+    */
+    TEVPEXPORT te::gm::Geometry* GetCascadedUnion(std::vector<te::gm::Geometry*>& geomVec);
+
     /*!
       \brief It returns the union of a geometry vector.
 
@@ -37,6 +37,7 @@
 #include <curl/curl.h>
 
 // STL
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 
@@ -428,6 +429,144 @@ void te::ws::core::CurlWrapper::get(const te::core::URI &uri, std::string &buffe
 }
 
 
+void te::ws::core::CurlWrapper::get(const std::vector<te::core::URI>& uris,
+                                    std::vector<std::string>& buffers,
+                                    std::vector<long>& responseCodes,
+                                    const std::size_t maxConnections)
+{
+  const std::size_t nrequests = uris.size();
+
+  buffers.assign(nrequests, std::string());
+  responseCodes.assign(nrequests, 0);
+
+  if(nrequests == 0)
+    return;
+
+  std::shared_ptr<CURLM> multi(curl_multi_init(), curl_multi_cleanup);
+
+  if(multi.get() == 0)
+    throw te::common::Exception(TE_TR("Could not initialize the concurrent requests!"));
+
+  const std::size_t nconnections = std::max<std::size_t>(1, std::min(maxConnections, nrequests));
+
+  curl_multi_setopt(multi.get(), CURLMOPT_MAXCONNECTS, (long)nconnections);
+
+  std::string userAndPassword = m_pimpl->m_username + std::string(":") + m_pimpl->m_password;
+
+  bool auth = (m_pimpl->m_method != AuthenticationMethod::NOT_AUTH) &&
+              !m_pimpl->m_username.empty() && !m_pimpl->m_password.empty();
+
+  std::vector<std::string> urls(nrequests);
+
+  // the handles in the pool, by request position
+  std::vector<CURL*> handles(nrequests, (CURL*)0);
+
+  std::size_t next = 0;
+
+  int running = 0;
+
+  auto addNext = [&]()
+  {
+    CURL* handle = curl_easy_init();
+
+    if(handle == 0)
+      throw te::common::Exception(TE_TR("Could not initialize the concurrent requests!"));
+
+    handles[next] = handle;
+
+    urls[next] = uris[next].uri();
+
+    curl_easy_setopt(handle, CURLOPT_URL, urls[next].c_str());
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteResponse);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &buffers[next]);
+    curl_easy_setopt(handle, CURLOPT_PRIVATE, (void*)next);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+
+    if(auth)
+    {
+      curl_easy_setopt(handle, CURLOPT_HTTPAUTH, m_pimpl->m_method == HTTP_BASIC ? CURLAUTH_BASIC : CURLAUTH_DIGEST);
+      curl_easy_setopt(handle, CURLOPT_USERPWD, userAndPassword.c_str());
+    }
+
+    curl_multi_add_handle(multi.get(), handle);
+
+    ++next;
+    ++running;
+  };
+
+  auto release = [&](const std::size_t i)
+  {
+    curl_multi_remove_handle(multi.get(), handles[i]);
+    curl_easy_cleanup(handles[i]);
+
+    handles[i] = 0;
+
+    --running;
+  };
+
+  try
+  {
+    while(next < nconnections)
+      addNext();
+
+    while(running > 0)
+    {
+      int active = 0;
+
+      CURLMcode mstatus = curl_multi_perform(multi.get(), &active);
+
+      if(mstatus != CURLM_OK)
+        throw te::common::Exception(curl_multi_strerror(mstatus));
+
+      int nmsgs = 0;
+
+      while(CURLMsg* msg = curl_multi_info_read(multi.get(), &nmsgs))
+      {
+        if(msg->msg != CURLMSG_DONE)
+          continue;
+
+        char* pos = 0;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &pos);
+
+        const std::size_t i = (std::size_t)pos;
+
+        if(msg->data.result == CURLE_OK)
+        {
+          curl_easy_getinfo(handles[i], CURLINFO_RESPONSE_CODE, &responseCodes[i]);
+        }
+        else
+        {
+          buffers[i].clear();
+          responseCodes[i] = 0;
+        }
+
+        release(i);
+
+        if(next < nrequests)
+          addNext();
+      }
+
+      if(running > 0)
+      {
+        mstatus = curl_multi_wait(multi.get(), 0, 0, 100, 0);
+
+        if(mstatus != CURLM_OK)
+          throw te::common::Exception(curl_multi_strerror(mstatus));
+      }
+    }
+  }
+  catch(...)
+  {
+    for(std::size_t i = 0; i < nrequests; ++i)
+    {
+      if(handles[i] != 0)
+        release(i);
+    }
+
+    throw;
+  }
+}
+
 const long te::ws::core::CurlWrapper::responseCode() const
 {
   return m_pimpl->m_responseCode;
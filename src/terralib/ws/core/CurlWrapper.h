@@ -32,6 +32,7 @@
 //STL
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "Config.h"
 #include "../../common/progress/TaskProgress.h"
@@ -132,6 +133,23 @@ namespace te
        */
       virtual void get(const te::core::URI &uri, std::string& buffer);
 
+      /*!
+       * \brief Method to make several GET requests concurrently, sharing a pool of connections.
+       *
+       *        The transfers are driven by a single curl multi handle, so no extra threads are used.
+       *        A failed transfer does not interrupt the others: its buffer is left empty and its
+       *        response code is set to zero.
+       *
+       * \param uris           The URIs with the address information.
+       * \param buffers        Where the server answers will be write (one for each URI).
+       * \param responseCodes  The response code of each request (one for each URI).
+       * \param maxConnections The maximum number of simultaneous transfers.
+       */
+      virtual void get(const std::vector<te::core::URI>& uris,
+                       std::vector<std::string>& buffers,
+                       std::vector<long>& responseCodes,
+                       const std::size_t maxConnections = 8);
+
 
       /*!
        * \brief Returns the last operation response code
@@ -56,6 +56,27 @@
 */
 #define TE_OGC_WMS_DEFAULT_SRS "EPSG:4326"
 
+/*!
+  \def TE_OGC_WMS_MAX_CONNECTIONS
+
+  \brief It specifies the maximum number of simultaneous GetMap requests made by a client.
+*/
+#define TE_OGC_WMS_MAX_CONNECTIONS 6
+
+/*!
+  \def TE_OGC_WMS_TILE_CACHE_MEMORY_LIMIT
+
+  \brief It specifies the default number of bytes of GetMap images kept in memory by the tile cache.
+*/
+#define TE_OGC_WMS_TILE_CACHE_MEMORY_LIMIT 33554432
+
+/*!
+  \def TE_OGC_WMS_TILE_CACHE_DISK_LIMIT
+
+  \brief It specifies the default number of bytes of GetMap images kept on disk by the tile cache.
+*/
+#define TE_OGC_WMS_TILE_CACHE_DISK_LIMIT 268435456
+
 /** @name DLL/LIB Module
  *  Flags for building TerraLib as a DLL or as a Static Library
  */
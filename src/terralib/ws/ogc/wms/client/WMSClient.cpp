@@ -11,11 +11,13 @@
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <string>
 
 te::ws::ogc::WMSClient::WMSClient(const std::string usrDataDir, const std::string uri, const std::string version) :
   m_version(version),
-  m_uri(uri)
+  m_uri(uri),
+  m_maxConnections(TE_OGC_WMS_MAX_CONNECTIONS)
 {
   m_dataDir = usrDataDir + "/wms/";
 
@@ -48,6 +50,12 @@ te::ws::ogc::WMSClient::WMSClient(const std::string usrDataDir, const std::strin
 
   if (te::core::FileSystem::isDirectory(usrDataDir) && !te::core::FileSystem::exists(m_dataDir))
     te::core::FileSystem::createDirectories(m_dataDir);
+
+  // the tiles are kept on disk only when there is a user data directory
+  if (te::core::FileSystem::isDirectory(m_dataDir))
+    m_tileCache.reset(new te::ws::ogc::wms::WMSTileCache(m_dataDir + "tiles/"));
+  else
+    m_tileCache.reset(new te::ws::ogc::wms::WMSTileCache());
 }
 
 te::ws::ogc::WMSClient::~WMSClient()
@@ -85,6 +93,77 @@ const te::ws::ogc::wms::WMSGetMapResponse te::ws::ogc::WMSClient::getMap(const t
 {
   te::ws::ogc::wms::WMSGetMapResponse response;
 
+  te::core::URI wmsRequest (buildGetMapUrl(request));
+
+  std::string buffer;
+
+  m_curl->get(wmsRequest, buffer);
+
+  response.m_buffer = buffer;
+  response.m_size = buffer.size();
+  response.m_format = request.m_format;
+
+  return response;
+}
+
+const std::vector<te::ws::ogc::wms::WMSGetMapResponse> te::ws::ogc::WMSClient::getMaps(const std::vector<te::ws::ogc::wms::WMSGetMapRequest>& requests) const
+{
+  std::vector<te::ws::ogc::wms::WMSGetMapResponse> responses(requests.size());
+
+  std::vector<std::string> urls(requests.size());
+
+  // the requests not found in the cache
+  std::vector<std::size_t> missing;
+  std::vector<te::core::URI> uris;
+
+  for(std::size_t i = 0; i < requests.size(); ++i)
+  {
+    responses[i].m_size = 0;
+    responses[i].m_format = requests[i].m_format;
+
+    urls[i] = buildGetMapUrl(requests[i]);
+
+    if(m_tileCache.get() && m_tileCache->get(urls[i], responses[i].m_buffer))
+    {
+      responses[i].m_size = responses[i].m_buffer.size();
+      continue;
+    }
+
+    missing.push_back(i);
+    uris.push_back(te::core::URI(urls[i]));
+  }
+
+  if(missing.empty())
+    return responses;
+
+  std::vector<std::string> buffers;
+  std::vector<long> responseCodes;
+
+  m_curl->get(uris, buffers, responseCodes, m_maxConnections);
+
+  for(std::size_t j = 0; j < missing.size(); ++j)
+  {
+    const std::size_t i = missing[j];
+
+    // non HTTP transfers (e.g. file://) have no response code
+    if(buffers[j].empty() || (responseCodes[j] != 200 && responseCodes[j] != 0))
+      continue;
+
+    if(IsServiceException(buffers[j], requests[i].m_format))
+      continue;
+
+    if(m_tileCache.get())
+      m_tileCache->put(urls[i], buffers[j]);
+
+    responses[i].m_buffer.swap(buffers[j]);
+    responses[i].m_size = responses[i].m_buffer.size();
+  }
+
+  return responses;
+}
+
+std::string te::ws::ogc::WMSClient::buildGetMapUrl(const te::ws::ogc::wms::WMSGetMapRequest& request) const
+{
   //Sets base URL
   std::string url = m_uri.uri();
 
@@ -175,17 +254,7 @@ const te::ws::ogc::wms::WMSGetMapResponse te::ws::ogc::WMSClient::getMap(const t
     }
   }
 
-  te::core::URI wmsRequest (url);
-
-  std::string buffer;
-
-  m_curl->get(wmsRequest, buffer);
-
-  response.m_buffer = buffer;
-  response.m_size = buffer.size();
-  response.m_format = request.m_format;
-
-  return response;
+  return url;
 }
 
 std::string te::ws::ogc::WMSClient::makeFileRequest(const std::string url, const std::string fileName) const
@@ -201,3 +270,29 @@ void te::ws::ogc::WMSClient::setCurlWrapper(te::ws::core::CurlWrapper* curlWrapp
 {
   m_curl.reset(curlWrapper);
 }
+
+void te::ws::ogc::WMSClient::setTileCache(const std::shared_ptr<te::ws::ogc::wms::WMSTileCache>& tileCache)
+{
+  m_tileCache = tileCache;
+}
+
+const std::shared_ptr<te::ws::ogc::wms::WMSTileCache>& te::ws::ogc::WMSClient::getTileCache() const
+{
+  return m_tileCache;
+}
+
+void te::ws::ogc::WMSClient::setMaxConnections(const std::size_t maxConnections)
+{
+  m_maxConnections = std::max<std::size_t>(1, maxConnections);
+}
+
+bool te::ws::ogc::WMSClient::IsServiceException(const std::string& buffer, const std::string& format)
+{
+  if(format.find("xml") != std::string::npos)
+    return false;
+
+  // images never start as a XML document
+  std::size_t pos = buffer.find_first_not_of(" \t\r\n");
+
+  return pos != std::string::npos && buffer[pos] == '<';
+}
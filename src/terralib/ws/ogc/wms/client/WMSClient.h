@@ -39,6 +39,7 @@
 #include "../../../core/CurlWrapper.h"
 #include "Config.h"
 #include "DataTypes.h"
+#include "WMSTileCache.h"
 #include "XMLParser.h"
 
 
@@ -98,6 +99,27 @@ namespace te
       */
       const te::ws::ogc::wms::WMSGetMapResponse getMap(const te::ws::ogc::wms::WMSGetMapRequest& request) const;
 
+      /*!
+        \brief Make several GetMap requests at once, e.g. the tiles of a map view.
+
+               The answers are first looked for in the tile cache. The remaining requests are made
+               concurrently and their valid answers are stored in the cache.
+
+        \param requests The GetMap requests.
+
+        \return The answers in the same order of the requests. A failed request gives an empty answer.
+      */
+      const std::vector<te::ws::ogc::wms::WMSGetMapResponse> getMaps(const std::vector<te::ws::ogc::wms::WMSGetMapRequest>& requests) const;
+
+      /*!
+        \brief Builds the GetMap URL of a request.
+
+        \param request The GetMap request.
+
+        \return The complete URL of the request.
+      */
+      std::string buildGetMapUrl(const te::ws::ogc::wms::WMSGetMapRequest& request) const;
+
       /*!
         \brief Executes a request on a WMS server
 
@@ -116,6 +138,30 @@ namespace te
        */
       void setCurlWrapper(te::ws::core::CurlWrapper* curlWrapper);
 
+      /*!
+       * \brief Sets the cache used by getMaps. If null, no cache is used.
+       *
+       *        By default the cache keeps the images on the "wms/tiles" folder of the user data directory.
+       *
+       * \param tileCache The cache to be used.
+       */
+      void setTileCache(const std::shared_ptr<te::ws::ogc::wms::WMSTileCache>& tileCache);
+
+      /*!
+       * \brief Gets the cache used by getMaps.
+       */
+      const std::shared_ptr<te::ws::ogc::wms::WMSTileCache>& getTileCache() const;
+
+      /*!
+       * \brief Sets the maximum number of simultaneous requests made by getMaps.
+       */
+      void setMaxConnections(const std::size_t maxConnections);
+
+      /*!
+       * \brief Checks if a GetMap answer is a service exception instead of the requested image.
+       */
+      static bool IsServiceException(const std::string& buffer, const std::string& format);
+
 
     private:
       std::string                                m_version;
@@ -124,6 +170,8 @@ namespace te
       te::ws::ogc::wms::WMSCapabilities          m_capabilities;
       std::shared_ptr<te::ws::core::CurlWrapper> m_curl;
       te::ws::ogc::wms::XMLParser                m_parser;
+      std::shared_ptr<te::ws::ogc::wms::WMSTileCache> m_tileCache;
+      std::size_t                                m_maxConnections;
 
     };
     }
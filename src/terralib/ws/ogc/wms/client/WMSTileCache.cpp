@@ -0,0 +1,316 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/ws/ogc/wms/client/WMSTileCache.cpp
+
+  \brief A size bounded cache of GetMap images, kept in memory and on disk.
+*/
+
+#include "WMSTileCache.h"
+
+// STL
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+
+te::ws::ogc::wms::WMSTileCache::WMSTileCache(const std::string& directory,
+                                             const std::size_t memoryLimit,
+                                             const std::size_t diskLimit)
+  : m_directory(directory),
+    m_memoryLimit(memoryLimit),
+    m_diskLimit(diskLimit),
+    m_memorySize(0),
+    m_diskSize(0)
+{
+  if(!m_directory.empty())
+    loadDirectory();
+}
+
+te::ws::ogc::wms::WMSTileCache::~WMSTileCache()
+{
+}
+
+bool te::ws::ogc::wms::WMSTileCache::get(const std::string& key, std::string& buffer)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto mit = m_memoryIdx.find(key);
+
+  if(mit != m_memoryIdx.end())
+  {
+    m_memory.splice(m_memory.begin(), m_memory, mit->second);
+
+    buffer = mit->second->second;
+
+    return true;
+  }
+
+  if(m_directory.empty())
+    return false;
+
+  const std::string fileName = getFileName(key);
+
+  auto dit = m_diskIdx.find(fileName);
+
+  if(dit == m_diskIdx.end())
+    return false;
+
+  if(!readFile(fileName, key, buffer))
+    return false;
+
+  m_disk.splice(m_disk.begin(), m_disk, dit->second);
+
+  // the next runs will see the file as recently used
+  boost::system::error_code ec;
+  boost::filesystem::last_write_time(boost::filesystem::path(m_directory) / fileName, std::time(0), ec);
+
+  putMemory(key, buffer);
+
+  return true;
+}
+
+void te::ws::ogc::wms::WMSTileCache::put(const std::string& key, const std::string& buffer)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  putMemory(key, buffer);
+
+  if(!m_directory.empty())
+    putDisk(key, buffer);
+}
+
+void te::ws::ogc::wms::WMSTileCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  boost::system::error_code ec;
+
+  for(auto it = m_disk.begin(); it != m_disk.end(); ++it)
+    boost::filesystem::remove(boost::filesystem::path(m_directory) / it->first, ec);
+
+  m_memory.clear();
+  m_memoryIdx.clear();
+  m_disk.clear();
+  m_diskIdx.clear();
+
+  m_memorySize = 0;
+  m_diskSize = 0;
+}
+
+const std::string& te::ws::ogc::wms::WMSTileCache::getDirectory() const
+{
+  return m_directory;
+}
+
+std::size_t te::ws::ogc::wms::WMSTileCache::getMemorySize() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_memorySize;
+}
+
+std::size_t te::ws::ogc::wms::WMSTileCache::getDiskSize() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_diskSize;
+}
+
+void te::ws::ogc::wms::WMSTileCache::loadDirectory()
+{
+  boost::system::error_code ec;
+
+  boost::filesystem::path dir(m_directory);
+
+  if(!boost::filesystem::exists(dir, ec))
+  {
+    boost::filesystem::create_directories(dir, ec);
+    return;
+  }
+
+  std::vector<std::pair<std::time_t, std::pair<std::string, std::size_t> > > files;
+
+  for(boost::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+  {
+    const boost::filesystem::path& p = it->path();
+
+    if(p.extension() != ".tile" || !boost::filesystem::is_regular_file(p, ec))
+      continue;
+
+    std::time_t t = boost::filesystem::last_write_time(p, ec);
+    std::size_t size = (std::size_t)boost::filesystem::file_size(p, ec);
+
+    if(ec)
+      continue;
+
+    files.push_back(std::make_pair(t, std::make_pair(p.filename().string(), size)));
+  }
+
+  std::sort(files.begin(), files.end());
+
+  for(std::size_t i = 0; i < files.size(); ++i)
+  {
+    m_disk.push_front(files[i].second);
+    m_diskIdx[files[i].second.first] = m_disk.begin();
+    m_diskSize += files[i].second.second;
+  }
+
+  while(m_diskSize > m_diskLimit && !m_disk.empty())
+  {
+    boost::filesystem::remove(dir / m_disk.back().first, ec);
+
+    m_diskSize -= m_disk.back().second;
+    m_diskIdx.erase(m_disk.back().first);
+    m_disk.pop_back();
+  }
+}
+
+std::string te::ws::ogc::wms::WMSTileCache::getFileName(const std::string& key)
+{
+  // 64-bit FNV-1a: stable across runs and platforms
+  boost::uint64_t hash = 14695981039346656037ULL;
+
+  for(std::size_t i = 0; i < key.size(); ++i)
+  {
+    hash ^= (unsigned char)key[i];
+    hash *= 1099511628211ULL;
+  }
+
+  char name[32];
+  std::sprintf(name, "%016llx.tile", (unsigned long long)hash);
+
+  return name;
+}
+
+bool te::ws::ogc::wms::WMSTileCache::readFile(const std::string& fileName, const std::string& key, std::string& buffer) const
+{
+  std::ifstream file((boost::filesystem::path(m_directory) / fileName).string().c_str(), std::ios::in | std::ios::binary);
+
+  if(!file.is_open())
+    return false;
+
+  // the file starts with its key, it guards against hash collisions
+  std::string fileKey;
+
+  if(!std::getline(file, fileKey) || fileKey != key)
+    return false;
+
+  buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  return !file.bad();
+}
+
+void te::ws::ogc::wms::WMSTileCache::writeFile(const std::string& fileName, const std::string& key, const std::string& buffer)
+{
+  boost::filesystem::path path = boost::filesystem::path(m_directory) / fileName;
+  boost::filesystem::path tmp = path;
+  tmp.replace_extension(".tmp");
+
+  {
+    std::ofstream file(tmp.string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if(!file.is_open())
+      return;
+
+    file << key << '\n';
+    file.write(buffer.data(), buffer.size());
+
+    if(!file)
+      return;
+  }
+
+  // another process never sees a partial file
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp, path, ec);
+
+  if(ec)
+    boost::filesystem::remove(tmp, ec);
+}
+
+void te::ws::ogc::wms::WMSTileCache::putMemory(const std::string& key, const std::string& buffer)
+{
+  auto it = m_memoryIdx.find(key);
+
+  if(it != m_memoryIdx.end())
+  {
+    m_memorySize -= it->second->second.size();
+    m_memory.erase(it->second);
+    m_memoryIdx.erase(it);
+  }
+
+  if(buffer.size() > m_memoryLimit)
+    return;
+
+  m_memory.push_front(std::make_pair(key, buffer));
+  m_memoryIdx[key] = m_memory.begin();
+  m_memorySize += buffer.size();
+
+  while(m_memorySize > m_memoryLimit)
+  {
+    m_memorySize -= m_memory.back().second.size();
+    m_memoryIdx.erase(m_memory.back().first);
+    m_memory.pop_back();
+  }
+}
+
+void te::ws::ogc::wms::WMSTileCache::putDisk(const std::string& key, const std::string& buffer)
+{
+  const std::size_t size = key.size() + 1 + buffer.size();
+
+  if(size > m_diskLimit)
+    return;
+
+  const std::string fileName = getFileName(key);
+
+  writeFile(fileName, key, buffer);
+
+  boost::system::error_code ec;
+
+  if(!boost::filesystem::exists(boost::filesystem::path(m_directory) / fileName, ec))
+    return;
+
+  auto it = m_diskIdx.find(fileName);
+
+  if(it != m_diskIdx.end())
+  {
+    m_diskSize -= it->second->second;
+    m_disk.erase(it->second);
+    m_diskIdx.erase(it);
+  }
+
+  m_disk.push_front(std::make_pair(fileName, size));
+  m_diskIdx[fileName] = m_disk.begin();
+  m_diskSize += size;
+
+  while(m_diskSize > m_diskLimit)
+  {
+    boost::filesystem::remove(boost::filesystem::path(m_directory) / m_disk.back().first, ec);
+
+    m_diskSize -= m_disk.back().second;
+    m_diskIdx.erase(m_disk.back().first);
+    m_disk.pop_back();
+  }
+}
@@ -0,0 +1,143 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/ws/ogc/wms/client/WMSTileCache.h
+
+  \brief A size bounded cache of GetMap images, kept in memory and on disk.
+*/
+
+#ifndef __TERRALIB_WS_OGC_WMS_CLIENT_WMSTILECACHE_H
+#define __TERRALIB_WS_OGC_WMS_CLIENT_WMSTILECACHE_H
+
+// STL
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// TerraLib
+#include "Config.h"
+
+namespace te
+{
+  namespace ws
+  {
+    namespace ogc
+    {
+      namespace wms
+      {
+      /*!
+        \class WMSTileCache
+
+        \brief A size bounded cache of GetMap images, kept in memory and on disk.
+
+        \details The images are identified by a key made of everything that defines a GetMap answer
+                 (server, layers, styles, SRS, format and tile). Both levels discard the least
+                 recently used images when their limit is exceeded. The disk level survives the
+                 application: each image is a file of the cache directory and the files found
+                 there are reused on the next run.
+
+        \note All methods are thread-safe.
+      */
+      class TEOGCWMSEXPORT WMSTileCache
+      {
+      public:
+
+        /*!
+          \brief Constructor.
+
+          \param directory   The directory of the disk level. If empty, only the memory level is used.
+          \param memoryLimit The maximum number of bytes kept in memory.
+          \param diskLimit   The maximum number of bytes kept on disk.
+        */
+        WMSTileCache(const std::string& directory = "",
+                     const std::size_t memoryLimit = TE_OGC_WMS_TILE_CACHE_MEMORY_LIMIT,
+                     const std::size_t diskLimit = TE_OGC_WMS_TILE_CACHE_DISK_LIMIT);
+
+        ~WMSTileCache();
+
+        /*!
+          \brief It looks for an image, first in memory and then on disk.
+
+          \param key    The image key.
+          \param buffer The image, if found.
+
+          \return True if the image was found.
+        */
+        bool get(const std::string& key, std::string& buffer);
+
+        /*!
+          \brief It stores an image in both levels.
+
+          \param key    The image key.
+          \param buffer The image.
+        */
+        void put(const std::string& key, const std::string& buffer);
+
+        /*! \brief It removes all images, including the disk ones. */
+        void clear();
+
+        /*! \brief It returns the directory of the disk level. */
+        const std::string& getDirectory() const;
+
+        /*! \brief It returns the number of bytes kept in memory. */
+        std::size_t getMemorySize() const;
+
+        /*! \brief It returns the number of bytes kept on disk. */
+        std::size_t getDiskSize() const;
+
+      private:
+
+        typedef std::list<std::pair<std::string, std::string> > MemoryList;
+        typedef std::list<std::pair<std::string, std::size_t> > DiskList;
+
+        /*! \brief It loads the files already found in the cache directory, oldest first. */
+        void loadDirectory();
+
+        /*! \brief It returns the file name used for a key. */
+        static std::string getFileName(const std::string& key);
+
+        bool readFile(const std::string& fileName, const std::string& key, std::string& buffer) const;
+
+        void writeFile(const std::string& fileName, const std::string& key, const std::string& buffer);
+
+        void putMemory(const std::string& key, const std::string& buffer);
+
+        void putDisk(const std::string& key, const std::string& buffer);
+
+      private:
+
+        std::string                                               m_directory;    //!< The directory of the disk level.
+        std::size_t                                               m_memoryLimit;  //!< The maximum number of bytes kept in memory.
+        std::size_t                                               m_diskLimit;    //!< The maximum number of bytes kept on disk.
+        std::size_t                                               m_memorySize;   //!< The number of bytes kept in memory.
+        std::size_t                                               m_diskSize;     //!< The number of bytes kept on disk.
+        MemoryList                                                m_memory;       //!< The images in memory, most recently used first.
+        std::unordered_map<std::string, MemoryList::iterator>     m_memoryIdx;    //!< The images in memory by key.
+        DiskList                                                  m_disk;         //!< The image files and sizes, most recently used first.
+        std::unordered_map<std::string, DiskList::iterator>       m_diskIdx;      //!< The image files by name.
+        mutable std::mutex                                        m_mutex;        //!< It serializes the cache accesses.
+      };
+      }
+    }
+  }
+}
+
+#endif // __TERRALIB_WS_OGC_WMS_CLIENT_WMSTILECACHE_H
@@ -37,6 +37,13 @@
 */
 #define TE_OGC_WMS_DRIVER_IDENTIFIER "WMS2"
 
+/*!
+  \def TE_OGC_WMS_DEFAULT_TILE_SIZE
+
+  \brief The default number of pixels of the tiles sides used to draw new WMS layers.
+*/
+#define TE_OGC_WMS_DEFAULT_TILE_SIZE 256
+
 /** @name DLL/LIB Module
  *  Flags for building TerraLib as a DLL or as a Static Library
  */
@@ -154,6 +154,14 @@ te::ws::ogc::wms::WMSGetMapResponse te::ws::ogc::wms::da::DataSource::getMap(con
   return m_wms->getMap(request);
 }
 
+std::vector<te::ws::ogc::wms::WMSGetMapResponse> te::ws::ogc::wms::da::DataSource::getMaps(const std::vector<te::ws::ogc::wms::WMSGetMapRequest>& requests)
+{
+  if(!isOpened())
+    throw te::ws::core::Exception() << te::ErrorDescription(TE_TR("The WMS DataSource is not opened."));
+
+  return m_wms->getMaps(requests);
+}
+
 void te::ws::ogc::wms::da::DataSource::create(const std::string& /*connInfo*/)
 {
   throw te::ws::core::Exception() << te::ErrorDescription(TE_TR("The create() method is not supported by the WMS driver!"));
@@ -84,6 +84,8 @@ namespace te
 
           te::ws::ogc::wms::WMSGetMapResponse getMap(const te::ws::ogc::wms::WMSGetMapRequest& request);
 
+          std::vector<te::ws::ogc::wms::WMSGetMapResponse> getMaps(const std::vector<te::ws::ogc::wms::WMSGetMapRequest>& requests);
+
         protected:
 
           void create(const std::string& connInfo);
@@ -16,9 +16,10 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/lexical_cast.hpp>
 
-te::ws::ogc::wms::WMS2Layer::WMS2Layer(const std::string dataSourceId)
+te::ws::ogc::wms::WMS2Layer::WMS2Layer(const std::string dataSourceId, const int tileSize)
 {
   m_dataSourceId = dataSourceId;
+  m_tileSize = tileSize;
 }
 
 te::ws::ogc::wms::WMSLayerPtr te::ws::ogc::wms::WMS2Layer::operator()(const te::ws::ogc::wms::WMSGetMapRequest &request) const
@@ -62,6 +63,7 @@ te::ws::ogc::wms::WMSLayerPtr te::ws::ogc::wms::WMS2Layer::operator()(const te::
   layer->setVisibility(te::map::NOT_VISIBLE);
 
   layer->setGetMapRequest(request);
+  layer->setTileSize(m_tileSize);
 
   return layer;
 }
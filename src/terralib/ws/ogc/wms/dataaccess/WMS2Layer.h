@@ -47,8 +47,9 @@ namespace te
         struct TEOGCWMSDATAACCESSEXPORT WMS2Layer
         {
           std::string m_dataSourceId;
+          int m_tileSize;
 
-          WMS2Layer(const std::string dataSourceId);
+          WMS2Layer(const std::string dataSourceId, const int tileSize = 0);
 
           WMSLayerPtr operator()(const te::ws::ogc::wms::WMSGetMapRequest& request) const;
         };
@@ -14,21 +14,24 @@ const std::string te::ws::ogc::wms::WMSLayer::sm_type("OGCWMSLAYER");
 
 te::ws::ogc::wms::WMSLayer::WMSLayer(te::map::AbstractLayer *parent)
   : te::map::AbstractLayer(parent),
-    m_rendererType("OGC_WMS_LAYER_RENDERER")
+    m_rendererType("OGC_WMS_LAYER_RENDERER"),
+    m_tileSize(0)
 {
 
 }
 
 te::ws::ogc::wms::WMSLayer::WMSLayer(const std::string &id, te::map::AbstractLayer *parent)
   : te::map::AbstractLayer(id, parent),
-    m_rendererType("OGC_WMS_LAYER_RENDERER")
+    m_rendererType("OGC_WMS_LAYER_RENDERER"),
+    m_tileSize(0)
 {
 
 }
 
 te::ws::ogc::wms::WMSLayer::WMSLayer(const std::string &id, const std::string &title, te::map::AbstractLayer *parent)
   : te::map::AbstractLayer(id, title, parent),
-    m_rendererType("OGC_WMS_LAYER_RENDERER")
+    m_rendererType("OGC_WMS_LAYER_RENDERER"),
+    m_tileSize(0)
 {
 
 }
@@ -178,6 +181,41 @@ const te::ws::ogc::wms::WMSGetMapResponse te::ws::ogc::wms::WMSLayer::getMap() c
   return wmsDataSource->getMap(m_getMapRequest);
 }
 
+std::vector<te::ws::ogc::wms::WMSGetMapResponse> te::ws::ogc::wms::WMSLayer::getMaps(const std::vector<te::ws::ogc::wms::WMSGetMapRequest>& requests) const
+{
+  te::da::DataSourcePtr ds;
+  try
+  {
+    ds = te::da::GetDataSource(m_datasourceId, true);
+  }
+  catch(...)
+  {
+    return std::vector<te::ws::ogc::wms::WMSGetMapResponse>();
+  }
+
+  if(ds.get() == 0 || !ds->isValid() || !ds->isOpened())
+    return std::vector<te::ws::ogc::wms::WMSGetMapResponse>();
+
+  te::ws::ogc::wms::da::DataSource* wmsDataSource = dynamic_cast<te::ws::ogc::wms::da::DataSource*>(ds.get());
+
+  if(wmsDataSource == nullptr)
+  {
+    return std::vector<te::ws::ogc::wms::WMSGetMapResponse>();
+  }
+
+  return wmsDataSource->getMaps(requests);
+}
+
+int te::ws::ogc::wms::WMSLayer::getTileSize() const
+{
+  return m_tileSize;
+}
+
+void te::ws::ogc::wms::WMSLayer::setTileSize(const int tileSize)
+{
+  m_tileSize = tileSize > 0 ? tileSize : 0;
+}
+
 
 
 
@@ -130,11 +130,32 @@ namespace te
           */
         const te::ws::ogc::wms::WMSGetMapResponse getMap() const;
 
+        /*!
+          \brief It gets the WMS GetMap responses of several requests, e.g. the tiles of a map view.
+                 The requests are made concurrently and their answers are cached.
+
+          \return The WMSGetMapResponse of each request. A failed request gives an empty response.
+          */
+        std::vector<te::ws::ogc::wms::WMSGetMapResponse> getMaps(const std::vector<te::ws::ogc::wms::WMSGetMapRequest>& requests) const;
+
+        /*!
+          \brief It returns the number of pixels of the tiles sides used to draw the layer, or 0 if it is drawn with a single request.
+          */
+        int getTileSize() const;
+
+        /*!
+          \brief It sets the number of pixels of the tiles sides used to draw the layer.
+
+          \param tileSize The tiles size, or 0 to draw the layer with a single request.
+          */
+        void setTileSize(const int tileSize);
+
       private:
 
         std::string                        m_datasourceId;   //!< The DataSource associated to this layer.
         std::string                        m_rendererType;   //!< A pointer to the internal renderer used to paint this layer.
         te::ws::ogc::wms::WMSGetMapRequest m_getMapRequest;
+        int                                m_tileSize;       //!< The tiles size, or 0 if the layer is not tiled.
 
         mutable std::auto_ptr<te::map::LayerSchema> m_schema; //!< The WMS layer schema.
 
@@ -1,6 +1,7 @@
 #include "WMSLayerRenderer.h"
 
 #include "WMSLayer.h"
+#include "WMSTileGrid.h"
 
 #include "../../../../core/translator/Translator.h"
 #include "../../../../maptools/AbstractLayer.h"
@@ -10,6 +11,9 @@
 #include "../../../core/Utils.h"
 #include "../../../../srs/Config.h"
 
+// STL
+#include <cmath>
+
 te::ws::ogc::wms::WMSLayerRenderer::WMSLayerRenderer()
 {
 
@@ -44,6 +48,13 @@ void te::ws::ogc::wms::WMSLayerRenderer::draw(te::map::AbstractLayer *layer, te:
   if(!reprojectedBBOX.intersects(wmsLayer->getExtent()))
     return;
 
+  // the tiles are placed on the canvas by their extent, it requires the same SRS
+  if(wmsLayer->getTileSize() > 0 && layer->getSRID() == srid)
+  {
+    drawTiles(wmsLayer, canvas, reprojectedBBOX, cancel);
+    return;
+  }
+
   //Preparing request acording to canvas and bbox.
 
   te::ws::ogc::wms::WMSGetMapRequest request = wmsLayer->getRequest();
@@ -68,3 +79,66 @@ void te::ws::ogc::wms::WMSLayerRenderer::draw(te::map::AbstractLayer *layer, te:
 
   canvas->drawImage(const_cast<char*>(response.m_buffer.c_str()), (std::size_t) response.m_size, imageType);
 }
+
+void te::ws::ogc::wms::WMSLayerRenderer::drawTiles(WMSLayer* layer, te::map::Canvas* canvas, const te::gm::Envelope& bbox, bool* cancel)
+{
+  if(canvas->getWidth() <= 0 || canvas->getHeight() <= 0)
+    return;
+
+  const double resX = bbox.getWidth() / canvas->getWidth();
+  const double resY = bbox.getHeight() / canvas->getHeight();
+
+  te::ws::ogc::wms::WMSTileGrid grid(layer->getExtent(), layer->getTileSize());
+
+  std::vector<te::ws::ogc::wms::WMSTileGrid::TileT> tiles;
+
+  grid.getTiles(bbox, grid.getLevel(std::min(resX, resY)), tiles);
+
+  if(tiles.empty())
+    return;
+
+  te::ws::ogc::wms::WMSGetMapRequest request = layer->getRequest();
+
+  request.m_width = grid.getTileSize();
+  request.m_height = grid.getTileSize();
+
+  std::vector<te::ws::ogc::wms::WMSGetMapRequest> requests(tiles.size(), request);
+
+  for(std::size_t i = 0; i < tiles.size(); ++i)
+  {
+    te::ws::ogc::wms::BoundingBox& boundingBox = requests[i].m_boundingBox;
+
+    boundingBox.m_minX = tiles[i].m_extent.getLowerLeftX();
+    boundingBox.m_minY = tiles[i].m_extent.getLowerLeftY();
+    boundingBox.m_maxX = tiles[i].m_extent.getUpperRightX();
+    boundingBox.m_maxY = tiles[i].m_extent.getUpperRightY();
+  }
+
+  std::vector<te::ws::ogc::wms::WMSGetMapResponse> responses = layer->getMaps(requests);
+
+  for(std::size_t i = 0; i < responses.size(); ++i)
+  {
+    if(cancel && *cancel)
+      return;
+
+    const te::ws::ogc::wms::WMSGetMapResponse& response = responses[i];
+
+    if(response.m_size <= 0)
+      continue;
+
+    const te::gm::Envelope& e = tiles[i].m_extent;
+
+    // both edges are rounded, so the neighbour tiles share their borders
+    int x0 = (int)std::floor((e.getLowerLeftX() - bbox.getLowerLeftX()) / resX + 0.5);
+    int x1 = (int)std::floor((e.getUpperRightX() - bbox.getLowerLeftX()) / resX + 0.5);
+    int y0 = (int)std::floor((bbox.getUpperRightY() - e.getUpperRightY()) / resY + 0.5);
+    int y1 = (int)std::floor((bbox.getUpperRightY() - e.getLowerLeftY()) / resY + 0.5);
+
+    if(x1 <= x0 || y1 <= y0)
+      continue;
+
+    te::map::ImageType imageType = te::ws::core::FormatToImageType(response.m_format);
+
+    canvas->drawImage(x0, y0, x1 - x0, y1 - y0, const_cast<char*>(response.m_buffer.c_str()), (std::size_t) response.m_size, imageType);
+  }
+}
@@ -39,6 +39,8 @@ namespace te
       namespace wms
       {
 
+      class WMSLayer;
+
       /*!
         \class WMSLayerRenderer
 
@@ -54,6 +56,18 @@ namespace te
 
         void draw(te::map::AbstractLayer* layer, te::map::Canvas* canvas, const te::gm::Envelope& bbox, int srid, const double& scale, bool* cancel);
 
+      private:
+
+        /*!
+          \brief It draws the layer as tiles of a fixed grid, fetched concurrently and cached.
+
+          \param layer  The WMS layer.
+          \param canvas The canvas to draw on.
+          \param bbox   The area to draw, in the layer and canvas SRS.
+          \param cancel The cancel flag.
+        */
+        void drawTiles(WMSLayer* layer, te::map::Canvas* canvas, const te::gm::Envelope& bbox, bool* cancel);
+
       };
 
       }
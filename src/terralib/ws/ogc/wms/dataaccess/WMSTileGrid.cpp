@@ -0,0 +1,99 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/ws/ogc/wms/dataaccess/WMSTileGrid.cpp
+
+  \brief A fixed pyramid of square tiles over the extent of a WMS layer.
+*/
+
+#include "WMSTileGrid.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // deep enough for any projected or geographic extent
+  const int sg_maxLevel = 30;
+}
+
+te::ws::ogc::wms::WMSTileGrid::WMSTileGrid(const te::gm::Envelope& extent, const int tileSize)
+  : m_extent(extent),
+    m_tileSize(std::max(tileSize, 1)),
+    m_baseResolution(0.0)
+{
+  m_baseResolution = std::max(extent.getWidth(), extent.getHeight()) / m_tileSize;
+}
+
+int te::ws::ogc::wms::WMSTileGrid::getTileSize() const
+{
+  return m_tileSize;
+}
+
+double te::ws::ogc::wms::WMSTileGrid::getResolution(const int level) const
+{
+  return std::ldexp(m_baseResolution, -level);
+}
+
+int te::ws::ogc::wms::WMSTileGrid::getLevel(const double& resolution) const
+{
+  if(resolution <= 0.0 || m_baseResolution <= 0.0)
+    return 0;
+
+  // the tolerance keeps an exact level from jumping to the next one
+  int level = (int)std::ceil(std::log(m_baseResolution / resolution) / std::log(2.0) - 1.0e-6);
+
+  return std::min(std::max(level, 0), sg_maxLevel);
+}
+
+void te::ws::ogc::wms::WMSTileGrid::getTiles(const te::gm::Envelope& area, const int level, std::vector<TileT>& tiles) const
+{
+  tiles.clear();
+
+  if(!area.isValid() || !area.intersects(m_extent) || m_baseResolution <= 0.0)
+    return;
+
+  const double tileSide = getResolution(level) * m_tileSize;
+
+  const int ntiles = 1 << level;
+
+  const int firstCol = std::max(0, (int)std::floor((area.getLowerLeftX() - m_extent.getLowerLeftX()) / tileSide));
+  const int lastCol = std::min(ntiles - 1, (int)std::ceil((area.getUpperRightX() - m_extent.getLowerLeftX()) / tileSide) - 1);
+  const int firstRow = std::max(0, (int)std::floor((area.getLowerLeftY() - m_extent.getLowerLeftY()) / tileSide));
+  const int lastRow = std::min(ntiles - 1, (int)std::ceil((area.getUpperRightY() - m_extent.getLowerLeftY()) / tileSide) - 1);
+
+  for(int row = firstRow; row <= lastRow; ++row)
+  {
+    for(int col = firstCol; col <= lastCol; ++col)
+    {
+      TileT tile;
+      tile.m_level = level;
+      tile.m_col = col;
+      tile.m_row = row;
+      tile.m_extent = te::gm::Envelope(m_extent.getLowerLeftX() + col * tileSide,
+                                       m_extent.getLowerLeftY() + row * tileSide,
+                                       m_extent.getLowerLeftX() + (col + 1) * tileSide,
+                                       m_extent.getLowerLeftY() + (row + 1) * tileSide);
+
+      tiles.push_back(tile);
+    }
+  }
+}
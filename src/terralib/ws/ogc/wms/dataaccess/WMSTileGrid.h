@@ -0,0 +1,104 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/ws/ogc/wms/dataaccess/WMSTileGrid.h
+
+  \brief A fixed pyramid of square tiles over the extent of a WMS layer.
+*/
+
+#ifndef __TERRALIB_WS_OGC_WMS_DATAACCESS_WMSTILEGRID_H
+#define __TERRALIB_WS_OGC_WMS_DATAACCESS_WMSTILEGRID_H
+
+// TerraLib
+#include "../../../../geometry/Envelope.h"
+#include "Config.h"
+
+// STL
+#include <vector>
+
+namespace te
+{
+  namespace ws
+  {
+    namespace ogc
+    {
+      namespace wms
+      {
+      /*!
+        \class WMSTileGrid
+
+        \brief A fixed pyramid of square tiles over the extent of a WMS layer.
+
+        \details The level 0 has a single tile covering the whole layer extent, anchored at its
+                 lower-left corner, and each next level halves the resolution. Since the tiles of
+                 a level never depend on the view, any map view is served by GetMap requests that
+                 repeat between draws and can be cached.
+      */
+      class TEOGCWMSDATAACCESSEXPORT WMSTileGrid
+      {
+      public:
+
+        /*! \brief A tile of the grid. */
+        struct TileT
+        {
+          int m_level;                //!< The tile level.
+          int m_col;                  //!< The tile column, from the left.
+          int m_row;                  //!< The tile row, from the bottom.
+          te::gm::Envelope m_extent;  //!< The tile extent.
+        };
+
+        /*!
+          \brief Constructor.
+
+          \param extent   The layer extent.
+          \param tileSize The number of pixels of the tiles sides.
+        */
+        WMSTileGrid(const te::gm::Envelope& extent, const int tileSize);
+
+        /*! \brief It returns the number of pixels of the tiles sides. */
+        int getTileSize() const;
+
+        /*! \brief It returns the pixel size of a level. */
+        double getResolution(const int level) const;
+
+        /*! \brief It returns the coarsest level with a pixel size not greater than the given one. */
+        int getLevel(const double& resolution) const;
+
+        /*!
+          \brief It returns the tiles of a level that intersect an area, row by row.
+
+          \param area  The area of interest.
+          \param level The level of the tiles.
+          \param tiles The tiles found.
+        */
+        void getTiles(const te::gm::Envelope& area, const int level, std::vector<TileT>& tiles) const;
+
+      private:
+
+        te::gm::Envelope m_extent;  //!< The layer extent.
+        int m_tileSize;             //!< The number of pixels of the tiles sides.
+        double m_baseResolution;    //!< The pixel size of level 0.
+      };
+      }
+    }
+  }
+}
+
+#endif // __TERRALIB_WS_OGC_WMS_DATAACCESS_WMSTILEGRID_H
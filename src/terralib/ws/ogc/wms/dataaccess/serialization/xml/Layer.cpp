@@ -13,6 +13,14 @@ te::map::AbstractLayer *te::ws::ogc::wms::serialize::LayerReader(te::xml::Reader
 {
   std::string id = reader.getAttr("id");
 
+  int tileSize = 0;
+
+  for(size_t i = 0; i < reader.getNumberOfAttrs(); i++)
+  {
+    if(reader.getAttrLocalName(i) == "tileSize")
+      tileSize = reader.getAttrAsInt32(i);
+  }
+
   /* Title Element */
   reader.next();
   std::string title = te::map::serialize::ReadLayerTitle(reader);
@@ -79,6 +87,7 @@ te::map::AbstractLayer *te::ws::ogc::wms::serialize::LayerReader(te::xml::Reader
   wmsLayer->setRendererType(rendererId);
   wmsLayer->setVisibility(te::map::serialize::GetVisibility(visible));
   wmsLayer->setGetMapRequest(request);
+  wmsLayer->setTileSize(tileSize);
 
   reader.next();
 
@@ -111,6 +120,9 @@ void te::ws::ogc::wms::serialize::LayerWriter(const te::map::AbstractLayer *alay
   if(request.m_transparent)
     writer.writeAttribute("transparent", request.m_transparent);
 
+  if(layer->getTileSize() > 0)
+    writer.writeAttribute("tileSize", layer->getTileSize());
+
 
   te::map::serialize::WriteAbstractLayer(layer, writer);
 
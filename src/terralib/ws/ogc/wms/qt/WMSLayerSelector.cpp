@@ -58,7 +58,7 @@ std::list<te::map::AbstractLayerPtr> te::ws::ogc::wms::qt::WMSLayerSelector::get
 
     std::vector<te::ws::ogc::wms::WMSGetMapRequest> requests = ldialog->getCheckedRequests();
 
-    std::transform(requests.begin(), requests.end(), std::back_inserter(layers), te::ws::ogc::wms::WMS2Layer((*it)->getId()));
+    std::transform(requests.begin(), requests.end(), std::back_inserter(layers), te::ws::ogc::wms::WMS2Layer((*it)->getId(), ldialog->getTileSize()));
   }
 
   return layers;
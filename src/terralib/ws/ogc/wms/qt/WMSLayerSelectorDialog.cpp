@@ -26,6 +26,7 @@
 #include "../../../../core/uri/Utils.h"
 #include "../../../core/CurlWrapper.h"
 #include "../../../../dataaccess/datasource/DataSource.h"
+#include "../dataaccess/Config.h"
 #include "../dataaccess/Transactor.h"
 
 //QT
@@ -41,6 +42,8 @@ te::ws::ogc::wms::qt::WMSLayerSelectorDialog::WMSLayerSelectorDialog(QWidget *pa
 {
   m_ui->setupUi(this);
 
+  m_ui->m_tileSizeSpinBox->setValue(TE_OGC_WMS_DEFAULT_TILE_SIZE);
+
   m_mapPreview.reset(new WMSLayerDisplay(m_ui->m_layerPreviewGroupBox));
   QVBoxLayout* mapPreviewGroupBoxLayout = new QVBoxLayout(m_ui->m_layerPreviewGroupBox);
   mapPreviewGroupBoxLayout->addWidget(m_mapPreview.get());
@@ -122,6 +125,11 @@ std::vector<te::ws::ogc::wms::WMSGetMapRequest> te::ws::ogc::wms::qt::WMSLayerSe
   return checkedRequests;
 }
 
+int te::ws::ogc::wms::qt::WMSLayerSelectorDialog::getTileSize() const
+{
+  return m_ui->m_tiledCheckBox->isChecked() ? m_ui->m_tileSizeSpinBox->value() : 0;
+}
+
 void te::ws::ogc::wms::qt::WMSLayerSelectorDialog::currentLayerChanged(QTreeWidgetItem *current, QTreeWidgetItem *previous)
 {
   m_currentLayerItem = dynamic_cast<WMSLayerItem*>(current);
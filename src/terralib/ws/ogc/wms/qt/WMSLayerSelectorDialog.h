@@ -83,6 +83,11 @@ namespace te
 
           std::vector<te::ws::ogc::wms::WMSGetMapRequest> getCheckedRequests();
 
+          /*!
+            \brief It returns the number of pixels of the tiles sides chosen for the new layers, or 0 if they must be drawn with a single request.
+          */
+          int getTileSize() const;
+
         public slots:
 
           void currentLayerChanged(QTreeWidgetItem* current, QTreeWidgetItem* previous);
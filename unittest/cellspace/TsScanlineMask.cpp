@@ -0,0 +1,188 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/cellspace/TsScanlineMask.cpp
+
+  \brief A test suite for the ScanlineMask class.
+ */
+
+// TerraLib
+#include <terralib/cellspace/ScanlineMask.h>
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/LinearRing.h>
+#include <terralib/geometry/MultiPolygon.h>
+#include <terralib/geometry/Point.h>
+#include <terralib/geometry/Polygon.h>
+#include <terralib/geometry/Utils.h>
+
+// Boost
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <memory>
+#include <vector>
+
+namespace
+{
+  te::gm::LinearRing* CreateRing(const double* xy, std::size_t npts)
+  {
+    te::gm::LinearRing* ring = new te::gm::LinearRing(npts + 1, te::gm::LineStringType);
+
+    for(std::size_t i = 0; i < npts; ++i)
+      ring->setPoint(i, xy[2 * i], xy[2 * i + 1]);
+
+    ring->setPoint(npts, xy[0], xy[1]);
+
+    return ring;
+  }
+
+  te::gm::Polygon* CreatePolygon(const double* shell, std::size_t nshell, const double* hole = 0, std::size_t nhole = 0)
+  {
+    te::gm::Polygon* poly = new te::gm::Polygon(0, te::gm::PolygonType);
+
+    poly->push_back(CreateRing(shell, nshell));
+
+    if(hole)
+      poly->push_back(CreateRing(hole, nhole));
+
+    poly->computeMBR(false);
+
+    return poly;
+  }
+
+  /*
+    It checks that the columns selected by the mask in each row are the cells the geometry
+    test loop of CellularSpacesOperations would select: the cell polygons (or their center points)
+    intersecting the mask.
+  */
+  void CheckMask(const te::gm::Geometry& geom, const te::gm::Envelope& env, double res)
+  {
+    te::cellspace::ScanlineMask mask(env, res, res);
+
+    BOOST_REQUIRE(te::cellspace::ScanlineMask::isSupported(&geom));
+
+    mask.add(&geom);
+
+    std::vector<std::pair<int, int> > cells;
+    std::vector<std::pair<int, int> > centers;
+
+    for(int row = 0; row < mask.getNumberOfRows(); ++row)
+    {
+      mask.getCellColumns(row, cells);
+      mask.getCenterColumns(row, centers);
+
+      std::vector<bool> cellSelected(mask.getNumberOfColumns(), false);
+      std::vector<bool> centerSelected(mask.getNumberOfColumns(), false);
+
+      for(std::size_t i = 0; i < cells.size(); ++i)
+      {
+        for(int col = cells[i].first; col <= cells[i].second; ++col)
+          cellSelected[col] = true;
+      }
+
+      for(std::size_t i = 0; i < centers.size(); ++i)
+      {
+        for(int col = centers[i].first; col <= centers[i].second; ++col)
+          centerSelected[col] = true;
+      }
+
+      const double y = env.m_lly + row * res;
+
+      for(int col = 0; col < mask.getNumberOfColumns(); ++col)
+      {
+        const double x = env.m_llx + col * res;
+
+        te::gm::Envelope cellEnv(x, y, x + res, y + res);
+
+        std::auto_ptr<te::gm::Geometry> cell(te::gm::GetGeomFromEnvelope(&cellEnv, 0));
+        te::gm::Point center(x + res / 2, y + res / 2);
+
+        BOOST_CHECK_MESSAGE(cellSelected[col] == cell->intersects(&geom), "polygon cell (" << col << ", " << row << ")");
+        BOOST_CHECK_MESSAGE(centerSelected[col] == center.intersects(&geom), "point cell (" << col << ", " << row << ")");
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( scanlinemask_tests )
+
+BOOST_AUTO_TEST_CASE( polygon_test )
+{
+  const double shell[] = { 3.3, 2.7, 27.6, 5.2, 31.4, 18.9, 14.1, 26.35, 6.8, 15.5 };
+
+  std::auto_ptr<te::gm::Polygon> poly(CreatePolygon(shell, 5));
+
+  CheckMask(*poly, te::gm::Envelope(0.0, 0.0, 40.0, 30.0), 1.0);
+  CheckMask(*poly, te::gm::Envelope(0.0, 0.0, 40.0, 30.0), 2.5);
+}
+
+BOOST_AUTO_TEST_CASE( grid_aligned_test )
+{
+  // the boundaries on the cell lines touch the neighbour cells and hold the neighbour centers
+  const double shell[] = { 10.0, 10.0, 20.0, 10.0, 20.0, 15.0, 10.0, 15.0 };
+  const double centers[] = { 4.5, 4.5, 9.5, 4.5, 9.5, 6.5, 4.5, 6.5 };
+
+  std::auto_ptr<te::gm::Polygon> poly(CreatePolygon(shell, 4));
+  std::auto_ptr<te::gm::Polygon> centersPoly(CreatePolygon(centers, 4));
+
+  CheckMask(*poly, te::gm::Envelope(0.0, 0.0, 30.0, 30.0), 1.0);
+  CheckMask(*centersPoly, te::gm::Envelope(0.0, 0.0, 30.0, 30.0), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE( hole_test )
+{
+  const double shell[] = { 1.2, 1.4, 38.3, 1.1, 38.7, 28.2, 1.6, 28.9 };
+  const double hole[] = { 8.4, 6.3, 30.2, 7.7, 24.9, 21.6, 11.3, 19.2 };
+
+  std::auto_ptr<te::gm::Polygon> poly(CreatePolygon(shell, 4, hole, 4));
+
+  CheckMask(*poly, te::gm::Envelope(0.0, 0.0, 40.0, 30.0), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE( multipolygon_test )
+{
+  const double shell1[] = { 2.3, 2.45, 12.7, 3.1, 9.8, 13.6 };
+  const double shell2[] = { 14.3, 12.2, 33.6, 11.8, 35.1, 27.3, 15.4, 26.7 };
+  const double hole2[] = { 20.2, 16.1, 28.4, 16.5, 27.9, 22.3, 21.1, 22.7 };
+
+  // a polygon inside the hole of the other one
+  const double shell3[] = { 23.1, 18.4, 25.7, 18.6, 24.2, 20.9 };
+
+  te::gm::MultiPolygon mpoly(0, te::gm::MultiPolygonType);
+  mpoly.add(CreatePolygon(shell1, 3));
+  mpoly.add(CreatePolygon(shell2, 4, hole2, 4));
+  mpoly.add(CreatePolygon(shell3, 3));
+  mpoly.computeMBR(true);
+
+  CheckMask(mpoly, te::gm::Envelope(0.0, 0.0, 40.0, 30.0), 1.0);
+  CheckMask(mpoly, te::gm::Envelope(0.0, 0.0, 40.0, 30.0), 0.75);
+}
+
+BOOST_AUTO_TEST_CASE( partial_cover_test )
+{
+  // a mask crossing the cellular space bounding box
+  const double shell[] = { -5.3, -4.1, 22.6, 3.8, 45.2, 34.7, 8.9, 21.3 };
+
+  std::auto_ptr<te::gm::Polygon> poly(CreatePolygon(shell, 4));
+
+  CheckMask(*poly, te::gm::Envelope(0.0, 0.0, 40.0, 30.0), 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
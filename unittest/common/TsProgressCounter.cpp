@@ -0,0 +1,152 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+// Unit-Test TerraLib
+#include "TsProgressCounter.h"
+
+// TerraLib
+#include <terralib/common/CounterRegistry.h>
+#include <terralib/common/progress/ProgressCounter.h>
+#include <terralib/common/progress/TaskProgress.h>
+
+// STL
+#include <sstream>
+#include <string>
+
+// Boost
+#include <boost/bind.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/thread.hpp>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TsProgressCounter );
+
+static void PulseTask(te::common::TaskProgress* task, int steps)
+{
+  te::common::ProgressCounter counter(*task, 100);
+
+  for(int i = 0; i < steps; ++i)
+    counter.pulse();
+}
+
+void TsProgressCounter::setUp()
+{
+}
+
+void TsProgressCounter::tearDown()
+{
+}
+
+void TsProgressCounter::tcBatchedPulses()
+{
+  te::common::TaskProgress task("batched", te::common::TaskProgress::UNDEFINED, 1000);
+
+  {
+    te::common::ProgressCounter counter(task, 100);
+
+    for(int i = 0; i < 250; ++i)
+      counter.pulse();
+
+    CPPUNIT_ASSERT_EQUAL(200, task.getCurrentStep());
+    CPPUNIT_ASSERT_EQUAL(20, task.getProportionalValue());
+  }
+
+  CPPUNIT_ASSERT_EQUAL(250, task.getCurrentStep());
+  CPPUNIT_ASSERT_EQUAL(25, task.getProportionalValue());
+
+  task.pulse(750);
+
+  CPPUNIT_ASSERT_EQUAL(1000, task.getCurrentStep());
+  CPPUNIT_ASSERT_EQUAL(100, task.getProportionalValue());
+}
+
+void TsProgressCounter::tcConcurrentPulses()
+{
+  te::common::TaskProgress task("concurrent", te::common::TaskProgress::UNDEFINED, 40000);
+  task.useMultiThread(true);
+
+  boost::thread_group threads;
+
+  for(int i = 0; i < 4; ++i)
+    threads.add_thread(new boost::thread(boost::bind(PulseTask, &task, 9999)));
+
+  threads.join_all();
+
+  for(int i = 0; i < 4; ++i)
+    task.pulse();
+
+  CPPUNIT_ASSERT_EQUAL(40000, task.getCurrentStep());
+  CPPUNIT_ASSERT_EQUAL(100, task.getProportionalValue());
+}
+
+void TsProgressCounter::tcCancel()
+{
+  te::common::TaskProgress task("cancel", te::common::TaskProgress::UNDEFINED, 100);
+
+  te::common::ProgressCounter counter(task, 10);
+
+  for(int i = 0; i < 10; ++i)
+    counter.pulse();
+
+  CPPUNIT_ASSERT(counter.isActive());
+
+  task.cancel();
+
+  CPPUNIT_ASSERT(!counter.isActive());
+
+  for(int i = 0; i < 10; ++i)
+    counter.pulse();
+
+  CPPUNIT_ASSERT_EQUAL(10, task.getCurrentStep());
+}
+
+void TsProgressCounter::tcCounterRegistry()
+{
+  te::common::CounterRegistry& registry = te::common::CounterRegistry::getInstance();
+
+  registry.reset();
+
+  te::common::Counter& items = registry.getCounter("unittest.items");
+
+  CPPUNIT_ASSERT(&items == &registry.getCounter("unittest.items"));
+
+  items.add(5);
+  registry.add("unittest.items", 7);
+  registry.add("unittest.bytes", 1024);
+
+  CPPUNIT_ASSERT_EQUAL(12LL, items.getValue());
+
+  {
+    te::common::ScopedTimer t("unittest.stage");
+  }
+
+  CPPUNIT_ASSERT_EQUAL(1LL, registry.getTimer("unittest.stage").getCount());
+
+  std::stringstream ss(registry.toJSON());
+
+  boost::property_tree::ptree doc;
+  boost::property_tree::read_json(ss, doc);
+
+  CPPUNIT_ASSERT_EQUAL(12LL, doc.get<long long>(boost::property_tree::ptree::path_type("counters/unittest.items", '/')));
+  CPPUNIT_ASSERT_EQUAL(1024LL, doc.get<long long>(boost::property_tree::ptree::path_type("counters/unittest.bytes", '/')));
+  CPPUNIT_ASSERT_EQUAL(1LL, doc.get<long long>(boost::property_tree::ptree::path_type("timers/unittest.stage/count", '/')));
+
+  registry.reset();
+
+  CPPUNIT_ASSERT_EQUAL(0LL, items.getValue());
+}
@@ -0,0 +1,75 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file TsProgressCounter.h
+ 
+  \brief Test suite for the batched progress counters and the counter registry.
+ */
+
+#ifndef __TERRALIB_UNITTEST_COMMON_INTERNAL_PROGRESSCOUNTER_H
+#define __TERRALIB_UNITTEST_COMMON_INTERNAL_PROGRESSCOUNTER_H
+
+// cppUnit
+#include <cppunit/extensions/HelperMacros.h>
+
+/*!
+  \class TsProgressCounter
+
+  \brief Test suite for the batched progress counters and the counter registry.
+ */
+class TsProgressCounter : public CPPUNIT_NS::TestFixture
+{
+// It registers this class as a Test Suit
+  CPPUNIT_TEST_SUITE( TsProgressCounter );
+
+// It registers the class methods as Test Cases belonging to the suit 
+  CPPUNIT_TEST( tcBatchedPulses );
+  CPPUNIT_TEST( tcConcurrentPulses );
+  CPPUNIT_TEST( tcCancel );
+  CPPUNIT_TEST( tcCounterRegistry );
+
+  CPPUNIT_TEST_SUITE_END();
+  
+  public:
+
+// It sets up context before running the test.
+    void setUp();
+
+// It cleann up after the test run.
+    void tearDown();
+
+  protected:
+
+// Test Cases:
+
+    /*! \brief Test Case: the steps are added to the task once per batch and when the counter is destroyed. */
+    void tcBatchedPulses();
+
+    /*! \brief Test Case: several threads pulse the same task. */
+    void tcConcurrentPulses();
+
+    /*! \brief Test Case: a cancelled task is seen by the counters and ignores new steps. */
+    void tcCancel();
+
+    /*! \brief Test Case: the counters and timers are published and dumped as JSON. */
+    void tcCounterRegistry();
+};
+
+#endif  // __TERRALIB_UNITTEST_COMMON_INTERNAL_PROGRESSCOUNTER_H
@@ -31,9 +31,25 @@
 #include <terralib/core/utils/Platform.h>
 #include <terralib/core/Exception.h>
 
+// STL
+#include <string>
+
 // Boost
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace
+{
+  int formatted = 0;
+
+  std::string FormatMessage(const std::string& message)
+  {
+    ++formatted;
+
+    return message;
+  }
+}
 
 BOOST_AUTO_TEST_SUITE(logger_test_case)
 
@@ -70,5 +86,97 @@ BOOST_AUTO_TEST_CASE(configuration_file_logger_test)
   return;
 }
 
+BOOST_AUTO_TEST_CASE(severity_level_test)
+{
+  te::core::Logger& logger = te::core::Logger::instance();
+
+  BOOST_CHECK(logger.isEnabled(te::core::Logger::severity_level::trace));
+
+  logger.setSeverityLevel(te::core::Logger::severity_level::error);
+
+  BOOST_CHECK(!logger.isEnabled(te::core::Logger::severity_level::warning));
+  BOOST_CHECK(logger.isEnabled(te::core::Logger::severity_level::error));
+
+  formatted = 0;
+
+// the message of a disabled level must not be formatted
+  TE_CORE_LOG_WARN("unittest", FormatMessage("Warning log"));
+  BOOST_CHECK_EQUAL(formatted, 0);
+
+#ifdef TERRALIB_LOGGER_ERROR_ENABLED
+  TE_CORE_LOG_ERROR("unittest", FormatMessage("Error log"));
+  BOOST_CHECK_EQUAL(formatted, 1);
+#endif
+
+  logger.setSeverityLevel(te::core::Logger::severity_level::trace);
+
+  return;
+}
+
+BOOST_AUTO_TEST_CASE(async_logger_test)
+{
+  te::core::Logger& logger = te::core::Logger::instance();
+
+  BOOST_CHECK_NO_THROW(logger.addLogger("unittest_async", "log/unit_test_async.log", ""));
+
+  BOOST_CHECK_THROW(logger.startAsync(0), te::InvalidArgumentException);
+
+  logger.startAsync(1024);
+  BOOST_CHECK(logger.isAsync());
+
+  const unsigned long long dropped = logger.getDroppedMessages();
+
+  boost::thread_group threads;
+
+  for(int i = 0; i < 4; ++i)
+  {
+    threads.create_thread([]()
+    {
+      for(int j = 0; j < 100; ++j)
+        te::core::Logger::instance().log("Warning log", "unittest_async", te::core::Logger::severity_level::warning);
+    });
+  }
+
+  threads.join_all();
+
+  logger.flush();
+
+  BOOST_CHECK(boost::filesystem::file_size("log/unit_test_async.log") > 0);
+
+// the queue is larger than the number of messages
+  BOOST_CHECK_EQUAL(logger.getDroppedMessages(), dropped);
+
+  logger.stopAsync();
+  BOOST_CHECK(!logger.isAsync());
+
+  return;
+}
+
+BOOST_AUTO_TEST_CASE(rate_limit_test)
+{
+  te::core::Logger& logger = te::core::Logger::instance();
+
+  logger.setRateLimit("unittest_limited", 10);
+
+  const unsigned long long dropped = logger.getDroppedMessages();
+
+  for(int i = 0; i < 100; ++i)
+    logger.log("Warning log", "unittest_limited", te::core::Logger::severity_level::warning);
+
+// the messages may be split in two seconds
+  BOOST_CHECK(logger.getDroppedMessages() - dropped >= 80);
+
+  logger.setRateLimit("unittest_limited", 0);
+
+  const unsigned long long droppedWithoutLimit = logger.getDroppedMessages();
+
+  for(int i = 0; i < 100; ++i)
+    logger.log("Warning log", "unittest_limited", te::core::Logger::severity_level::warning);
+
+  BOOST_CHECK_EQUAL(logger.getDroppedMessages(), droppedWithoutLimit);
+
+  return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
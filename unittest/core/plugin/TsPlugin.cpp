@@ -255,4 +255,72 @@ BOOST_AUTO_TEST_CASE(plugin_unload_with_dependent_test)
   te::core::plugin::FinalizePluginSystem();
 }
 
+BOOST_AUTO_TEST_CASE(plugin_parallel_load_test)
+{
+  te::core::plugin::InitializePluginSystem();
+
+  std::vector<te::core::PluginInfo> v_pInfo = LoadPluginsInfo();
+
+  // the plugins are not sorted: the manager loads them by dependency levels
+  std::vector<std::string> plugin_names;
+
+  for(const te::core::PluginInfo& pinfo : v_pInfo)
+  {
+    te::core::PluginManager::instance().insert(pinfo);
+    plugin_names.push_back(pinfo.name);
+  }
+
+  BOOST_CHECK_NO_THROW(
+      te::core::PluginManager::instance().load(plugin_names, true, 4));
+
+  for(const std::string& plugin_name : plugin_names)
+    BOOST_CHECK(te::core::PluginManager::instance().isLoaded(plugin_name));
+
+  std::vector<te::core::PluginInfo> pVec =
+      te::core::PluginManager::instance().getLoadedPlugins();
+
+  BOOST_REQUIRE(pVec.size() == 4);
+  BOOST_CHECK(pVec.front().name == "plugin1");
+  BOOST_CHECK(pVec.back().name == "plugin4");
+
+  BOOST_CHECK(te::core::PluginManager::instance().getLoadTimes().size() == 4);
+  BOOST_CHECK(!te::core::plugin::LoadTimeReport().empty());
+
+  te::core::plugin::UnloadAll();
+  te::core::PluginManager::instance().clear();
+  te::core::plugin::FinalizePluginSystem();
+}
+
+BOOST_AUTO_TEST_CASE(plugin_lazy_load_test)
+{
+  te::core::plugin::InitializePluginSystem();
+
+  std::vector<te::core::PluginInfo> v_pInfo = LoadPluginsInfo();
+
+  // plugin 4 depends of plugin 2 and plugin 1, plugin 2 depends of plugin 3
+  v_pInfo[3].provides.push_back("PLUGIN4");
+
+  for(const te::core::PluginInfo& pinfo : v_pInfo)
+    te::core::PluginManager::instance().insert(pinfo);
+
+  BOOST_CHECK(!te::core::PluginManager::instance().resolve("UNKNOWN"));
+  BOOST_CHECK(te::core::PluginManager::instance().getLoadedPlugins().empty());
+
+  BOOST_CHECK(te::core::PluginManager::instance().resolve("PLUGIN4"));
+
+  for(const te::core::PluginInfo& pinfo : v_pInfo)
+    BOOST_CHECK(te::core::PluginManager::instance().isLoaded(pinfo.name));
+
+  for(const te::core::PluginLoadTime& t :
+      te::core::PluginManager::instance().getLoadTimes())
+    BOOST_CHECK(t.on_demand);
+
+  // the plugin is already loaded
+  BOOST_CHECK(!te::core::PluginManager::instance().resolve("PLUGIN4"));
+
+  te::core::plugin::UnloadAll();
+  te::core::PluginManager::instance().clear();
+  te::core::plugin::FinalizePluginSystem();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/dataaccess/dataset/TsDataSetAdapter.cpp
+
+  \brief A test suite for the DataSetAdapter class.
+ */
+
+// TerraLib
+#include <terralib/core/encoding/CharEncoding.h>
+#include <terralib/dataaccess/dataset/AttributeConverters.h>
+#include <terralib/dataaccess/dataset/DataSetAdapter.h>
+#include <terralib/dataaccess/dataset/DataSetType.h>
+#include <terralib/datatype/SimpleData.h>
+#include <terralib/datatype/SimpleProperty.h>
+#include <terralib/datatype/StringProperty.h>
+#include <terralib/geometry/GeometryProperty.h>
+#include <terralib/geometry/Point.h>
+#include <terralib/memory/DataSet.h>
+#include <terralib/memory/DataSetItem.h>
+
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <memory>
+
+namespace
+{
+  te::mem::DataSet* CreateDataSet()
+  {
+    te::da::DataSetType dt("items");
+    dt.add(new te::dt::SimpleProperty("id", te::dt::INT32_TYPE));
+    dt.add(new te::dt::SimpleProperty("val", te::dt::DOUBLE_TYPE));
+    dt.add(new te::dt::StringProperty("name"));
+    dt.add(new te::gm::GeometryProperty("location", 4326, te::gm::PointType));
+
+    te::mem::DataSet* dataset = new te::mem::DataSet(&dt);
+
+    for(int i = 0; i < 50; ++i)
+    {
+      te::mem::DataSetItem* item = new te::mem::DataSetItem(dataset);
+      item->setInt32(0, i);
+
+      if(i % 10)
+        item->setDouble(1, i * 0.5);
+
+      item->setString(2, "n" + boost::lexical_cast<std::string>(i));
+      item->setGeometry(3, new te::gm::Point(i * 2.0, i * 3.0 + 1.0, 4326));
+
+      dataset->add(item);
+    }
+
+    dataset->moveBeforeFirst();
+
+    return dataset;
+  }
+
+  std::vector<std::size_t> Positions(std::size_t pos)
+  {
+    return std::vector<std::size_t>(1, pos);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( datasetadapter_tests )
+
+BOOST_AUTO_TEST_CASE( passthrough_detection_test )
+{
+  std::auto_ptr<te::mem::DataSet> dataset(CreateDataSet());
+
+  te::da::DataSetAdapter adapter(dataset.get());
+
+  adapter.add("id", te::dt::INT32_TYPE, Positions(0), te::da::GenericAttributeConverter);
+  adapter.add("val", te::dt::DOUBLE_TYPE, Positions(1), te::da::GenericAttributeConverter);
+  adapter.add("name", te::dt::STRING_TYPE, Positions(2), te::da::CharEncodingConverter(te::core::EncodingType::UTF8));
+  adapter.add("location", te::dt::GEOMETRY_TYPE, Positions(3), te::da::GenericAttributeConverter);
+
+  // a type change, another encoding, several input properties or another converter must be converted
+  adapter.add("id_str", te::dt::STRING_TYPE, Positions(0), te::da::GenericAttributeConverter);
+  adapter.add("name_latin1", te::dt::STRING_TYPE, Positions(2), te::da::CharEncodingConverter(te::core::EncodingType::LATIN1));
+
+  std::vector<std::size_t> tuple;
+  tuple.push_back(0);
+  tuple.push_back(2);
+  adapter.add("tuple", te::dt::STRING_TYPE, tuple, te::da::TupleToStringConverter);
+
+  adapter.add("x", te::dt::DOUBLE_TYPE, Positions(3), te::da::PointToXConverter);
+
+  BOOST_CHECK(adapter.isPassThrough(0));
+  BOOST_CHECK(adapter.isPassThrough(1));
+  BOOST_CHECK(adapter.isPassThrough(2));
+  BOOST_CHECK(adapter.isPassThrough(3));
+  BOOST_CHECK(!adapter.isPassThrough(4));
+  BOOST_CHECK(!adapter.isPassThrough(5));
+  BOOST_CHECK(!adapter.isPassThrough(6));
+  BOOST_CHECK(!adapter.isPassThrough(7));
+}
+
+BOOST_AUTO_TEST_CASE( passthrough_values_test )
+{
+  std::auto_ptr<te::mem::DataSet> dataset(CreateDataSet());
+
+  te::da::DataSetAdapter adapter(dataset.get());
+
+  adapter.add("id", te::dt::INT32_TYPE, Positions(0), te::da::GenericAttributeConverter);
+  adapter.add("val", te::dt::DOUBLE_TYPE, Positions(1), te::da::GenericAttributeConverter);
+  adapter.add("name", te::dt::STRING_TYPE, Positions(2), te::da::CharEncodingConverter(te::core::EncodingType::UTF8));
+  adapter.add("location", te::dt::GEOMETRY_TYPE, Positions(3), te::da::GenericAttributeConverter);
+  adapter.add("name_latin1", te::dt::STRING_TYPE, Positions(2), te::da::CharEncodingConverter(te::core::EncodingType::LATIN1));
+
+  BOOST_REQUIRE(!adapter.isPassThrough(4));
+
+  std::size_t n = 0;
+
+  adapter.moveBeforeFirst();
+
+  while(adapter.moveNext())
+  {
+    BOOST_CHECK_EQUAL(adapter.getInt32(0), dataset->getInt32(0));
+    BOOST_CHECK_EQUAL(adapter.isNull(1), dataset->isNull(1));
+
+    if(!dataset->isNull(1))
+      BOOST_CHECK_EQUAL(adapter.getDouble(1), dataset->getDouble(1));
+
+    BOOST_CHECK_EQUAL(adapter.getString(2), dataset->getString(2));
+
+    std::auto_ptr<te::gm::Geometry> expected(dataset->getGeometry(3));
+    std::auto_ptr<te::gm::Geometry> geom(adapter.getGeometry(3));
+
+    BOOST_REQUIRE(geom.get() != 0);
+    BOOST_CHECK_EQUAL(geom->getSRID(), expected->getSRID());
+    BOOST_CHECK_EQUAL(static_cast<te::gm::Point*>(geom.get())->getX(), static_cast<te::gm::Point*>(expected.get())->getX());
+    BOOST_CHECK_EQUAL(static_cast<te::gm::Point*>(geom.get())->getY(), static_cast<te::gm::Point*>(expected.get())->getY());
+
+    // the converted property still goes through the converter
+    BOOST_CHECK_EQUAL(adapter.getString(4), dataset->getString(2));
+
+    ++n;
+  }
+
+  BOOST_CHECK_EQUAL(n, dataset->size());
+}
+
+BOOST_AUTO_TEST_CASE( point_converters_test )
+{
+  std::auto_ptr<te::mem::DataSet> dataset(CreateDataSet());
+
+  te::da::DataSetAdapter adapter(dataset.get());
+
+  adapter.add("x", te::dt::DOUBLE_TYPE, Positions(3), te::da::PointToXConverter);
+  adapter.add("y", te::dt::DOUBLE_TYPE, Positions(3), te::da::PointToYConverter);
+
+  BOOST_CHECK(!te::da::GetDoubleAttributeConverter(te::da::PointToXConverter).empty());
+  BOOST_CHECK(!te::da::GetDoubleAttributeConverter(te::da::PointToYConverter).empty());
+  BOOST_CHECK(te::da::GetDoubleAttributeConverter(te::da::GenericAttributeConverter).empty());
+  BOOST_CHECK(te::da::GetDoubleAttributeConverter(te::da::CharEncodingConverter(te::core::EncodingType::UTF8)).empty());
+
+  adapter.moveBeforeFirst();
+
+  while(adapter.moveNext())
+  {
+    // the memory data set returns a new geometry on each read: the point must be alive while its coordinates are read
+    const int i = dataset->getInt32(0);
+
+    BOOST_CHECK_EQUAL(adapter.getDouble(0), i * 2.0);
+    BOOST_CHECK_EQUAL(adapter.getDouble(1), i * 3.0 + 1.0);
+
+    // the generic path, through the allocated values, must agree with the typed one
+    std::auto_ptr<te::dt::AbstractData> x(te::da::PointToXConverter(dataset.get(), Positions(3), te::dt::DOUBLE_TYPE));
+    std::auto_ptr<te::dt::AbstractData> y(te::da::PointToYConverter(dataset.get(), Positions(3), te::dt::DOUBLE_TYPE));
+
+    BOOST_CHECK_EQUAL(static_cast<te::dt::Double*>(x.get())->getValue(), i * 2.0);
+    BOOST_CHECK_EQUAL(static_cast<te::dt::Double*>(y.get())->getValue(), i * 3.0 + 1.0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
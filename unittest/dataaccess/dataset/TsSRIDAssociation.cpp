@@ -0,0 +1,331 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/dataaccess/dataset/TsSRIDAssociation.cpp
+
+  \brief A test suit for the SRID association of geometry batches and the geometry transformation with a shared SRS converter.
+ */
+
+// TerraLib
+#include <terralib/dataaccess/dataset/AttributeConverters.h>
+#include <terralib/geometry/Coord2D.h>
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/GeometryCollection.h>
+#include <terralib/geometry/LinearRing.h>
+#include <terralib/geometry/LineString.h>
+#include <terralib/geometry/Point.h>
+#include <terralib/geometry/Polygon.h>
+#include <terralib/geometry/Utils.h>
+#include <terralib/srs/Config.h>
+#include <terralib/srs/Converter.h>
+#include <terralib/srs/SpatialReferenceSystemManager.h>
+
+// Boost
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  const int sg_utmSRID = 32723;  // WGS 84 / UTM zone 23S
+
+  /* A polygon with a hole over the given longitude and latitude. */
+  te::gm::Polygon* CreatePolygon(double x, double y, int srid)
+  {
+    te::gm::Polygon* polygon = new te::gm::Polygon(0, te::gm::PolygonType, srid);
+
+    for(int r = 0; r < 2; ++r)
+    {
+      const double size = r ? 0.1 : 0.5;
+      const double offset = r ? 0.2 : 0.0;
+
+      te::gm::LinearRing* ring = new te::gm::LinearRing(5, te::gm::LineStringType, srid);
+      ring->setPoint(0, x + offset, y + offset);
+      ring->setPoint(1, x + offset + size, y + offset);
+      ring->setPoint(2, x + offset + size, y + offset + size);
+      ring->setPoint(3, x + offset, y + offset + size);
+      ring->setPoint(4, x + offset, y + offset);
+
+      polygon->push_back(ring);
+    }
+
+    return polygon;
+  }
+
+  /* A point, a line, a polygon and a collection of all of them, with longitude and latitude coordinates. */
+  void CreateGeometries(boost::ptr_vector<te::gm::Geometry>& geoms, int srid)
+  {
+    geoms.push_back(new te::gm::Point(-45.0, -23.0, srid));
+
+    te::gm::LineString* line = new te::gm::LineString(20, te::gm::LineStringType, srid);
+
+    for(std::size_t i = 0; i < line->size(); ++i)
+      line->setPoint(i, -45.5 + i * 0.05, -22.5 - i * 0.02);
+
+    geoms.push_back(line);
+
+    geoms.push_back(CreatePolygon(-44.8, -23.4, srid));
+
+    te::gm::GeometryCollection* collection = new te::gm::GeometryCollection(0, te::gm::GeometryCollectionType, srid);
+    collection->add(new te::gm::Point(-44.2, -22.1, srid));
+    collection->add(static_cast<te::gm::Geometry*>(line->clone()));
+    collection->add(CreatePolygon(-45.3, -22.9, srid));
+
+    geoms.push_back(collection);
+  }
+
+  /* It appends the coordinates of the points, lines and polygons in the geometry. */
+  void GetCoordinates(const te::gm::Geometry* g, std::vector<te::gm::Coord2D>& coords)
+  {
+    if(const te::gm::Point* pt = dynamic_cast<const te::gm::Point*>(g))
+    {
+      coords.push_back(te::gm::Coord2D(pt->getX(), pt->getY()));
+    }
+    else if(const te::gm::LineString* line = dynamic_cast<const te::gm::LineString*>(g))
+    {
+      for(std::size_t i = 0; i < line->size(); ++i)
+        coords.push_back(te::gm::Coord2D(line->getX(i), line->getY(i)));
+    }
+    else if(const te::gm::Polygon* polygon = dynamic_cast<const te::gm::Polygon*>(g))
+    {
+      for(std::size_t i = 0; i < polygon->getNumRings(); ++i)
+        GetCoordinates(polygon->getRingN(i), coords);
+    }
+    else if(const te::gm::GeometryCollection* collection = dynamic_cast<const te::gm::GeometryCollection*>(g))
+    {
+      for(std::size_t i = 0; i < collection->getNumGeometries(); ++i)
+        GetCoordinates(collection->getGeometryN(i), coords);
+    }
+  }
+
+  /* The largest coordinate difference between two geometries with the same structure, or -1 if they do not match. */
+  double GetMaxDifference(const te::gm::Geometry* g1, const te::gm::Geometry* g2)
+  {
+    std::vector<te::gm::Coord2D> coords1;
+    std::vector<te::gm::Coord2D> coords2;
+
+    GetCoordinates(g1, coords1);
+    GetCoordinates(g2, coords2);
+
+    if(coords1.empty() || coords1.size() != coords2.size())
+      return -1.0;
+
+    double maxDiff = 0.0;
+
+    for(std::size_t i = 0; i < coords1.size(); ++i)
+      maxDiff = std::max(maxDiff, std::max(std::abs(coords1[i].x - coords2[i].x), std::abs(coords1[i].y - coords2[i].y)));
+
+    return maxDiff;
+  }
+
+  /* It checks that the geometry MBR bounds exactly the (converted) coordinates. */
+  bool HasUpdatedMBR(const te::gm::Geometry* g)
+  {
+    std::vector<te::gm::Coord2D> coords;
+    GetCoordinates(g, coords);
+
+    te::gm::Envelope e;
+
+    for(std::size_t i = 0; i < coords.size(); ++i)
+      e.Union(te::gm::Envelope(coords[i].x, coords[i].y, coords[i].x, coords[i].y));
+
+    const te::gm::Envelope* mbr = g->getMBR();
+
+    return mbr->m_llx == e.m_llx && mbr->m_lly == e.m_lly && mbr->m_urx == e.m_urx && mbr->m_ury == e.m_ury;
+  }
+
+  /* The UTM conversions need the SRS descriptions of the manager. */
+  void InitSRSManager()
+  {
+    te::srs::SpatialReferenceSystemManager& manager = te::srs::SpatialReferenceSystemManager::getInstance();
+
+    if(!manager.isInitialized())
+      manager.init();
+
+    BOOST_REQUIRE(manager.recognizes(TE_SRS_WGS84));
+    BOOST_REQUIRE(manager.recognizes(sg_utmSRID));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(sridassociation_tests)
+
+BOOST_AUTO_TEST_CASE(associate_batch_without_conversion_test)
+{
+  boost::ptr_vector<te::gm::Geometry> geoms;
+  CreateGeometries(geoms, TE_UNKNOWN_SRS);
+
+  boost::ptr_vector<te::gm::Geometry> originals;
+  CreateGeometries(originals, TE_UNKNOWN_SRS);
+
+  // the null pointers are skipped
+  std::vector<te::gm::Geometry*> batch(1, static_cast<te::gm::Geometry*>(0));
+
+  for(std::size_t i = 0; i < geoms.size(); ++i)
+  {
+    batch.push_back(&geoms[i]);
+    batch.push_back(0);
+  }
+
+  // only the input SRID is associated when there is no output SRID
+  te::da::SRIDAssociation association(TE_SRS_WGS84);
+  BOOST_CHECK_NO_THROW(association.associate(batch));
+
+  for(std::size_t i = 0; i < geoms.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(geoms[i].getSRID(), TE_SRS_WGS84);
+    BOOST_CHECK_EQUAL(GetMaxDifference(&geoms[i], &originals[i]), 0.0);
+  }
+
+  BOOST_CHECK(!association.m_converter.get());
+
+  // and the geometries keep their SRID if the input one is unknown
+  te::da::SRIDAssociation unknown(TE_UNKNOWN_SRS, sg_utmSRID);
+  BOOST_CHECK_NO_THROW(unknown.associate(batch));
+
+  // nor are converted to the same SRID
+  te::da::SRIDAssociation same(TE_SRS_WGS84, TE_SRS_WGS84);
+  BOOST_CHECK_NO_THROW(same.associate(batch));
+
+  for(std::size_t i = 0; i < geoms.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(geoms[i].getSRID(), TE_SRS_WGS84);
+    BOOST_CHECK_EQUAL(GetMaxDifference(&geoms[i], &originals[i]), 0.0);
+  }
+
+  BOOST_CHECK(!unknown.m_converter.get());
+  BOOST_CHECK(!same.m_converter.get());
+
+  std::vector<te::gm::Geometry*> empty;
+  BOOST_CHECK_NO_THROW(association.associate(empty));
+}
+
+BOOST_AUTO_TEST_CASE(associate_batch_with_conversion_test)
+{
+  InitSRSManager();
+
+  boost::ptr_vector<te::gm::Geometry> geoms;
+  CreateGeometries(geoms, TE_UNKNOWN_SRS);
+
+  // the expected values come from the geometry transform, which sets up its own converter
+  boost::ptr_vector<te::gm::Geometry> expected;
+  CreateGeometries(expected, TE_SRS_WGS84);
+
+  std::vector<te::gm::Geometry*> batch;
+
+  for(std::size_t i = 0; i < geoms.size(); ++i)
+  {
+    expected[i].transform(sg_utmSRID);
+
+    batch.push_back(&geoms[i]);
+    batch.push_back(0);
+  }
+
+  te::da::SRIDAssociation association(TE_SRS_WGS84, sg_utmSRID);
+  association.associate(batch);
+
+  // the converter is created once and kept for the next geometries
+  BOOST_REQUIRE(association.m_converter.get());
+
+  const te::srs::Converter* converter = association.m_converter.get();
+
+  for(std::size_t i = 0; i < geoms.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(geoms[i].getSRID(), sg_utmSRID);
+
+    double diff = GetMaxDifference(&geoms[i], &expected[i]);
+
+    BOOST_CHECK_MESSAGE(diff >= 0.0 && diff < 1e-6, "geometry " << i << ", difference " << diff);
+    BOOST_CHECK(HasUpdatedMBR(&geoms[i]));
+  }
+
+  std::auto_ptr<te::gm::Geometry> single(CreatePolygon(-44.8, -23.4, TE_UNKNOWN_SRS));
+  association.associate(single.get());
+
+  BOOST_CHECK(association.m_converter.get() == converter);
+  BOOST_CHECK_EQUAL(GetMaxDifference(single.get(), &geoms[2]), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(transform_test)
+{
+  InitSRSManager();
+
+  te::srs::Converter converter(TE_SRS_WGS84, sg_utmSRID);
+  te::srs::Converter inverse(sg_utmSRID, TE_SRS_WGS84);
+
+  boost::ptr_vector<te::gm::Geometry> geoms;
+  CreateGeometries(geoms, TE_SRS_WGS84);
+
+  boost::ptr_vector<te::gm::Geometry> originals;
+  CreateGeometries(originals, TE_SRS_WGS84);
+
+  for(std::size_t i = 0; i < geoms.size(); ++i)
+  {
+    // the MBR is computed before the transformation, so it must be updated
+    geoms[i].computeMBR(true);
+
+    te::gm::Transform(&geoms[i], converter);
+
+    BOOST_CHECK_EQUAL(geoms[i].getSRID(), sg_utmSRID);
+    BOOST_CHECK(HasUpdatedMBR(&geoms[i]));
+
+    // each coordinate is converted as the converter does it alone
+    std::vector<te::gm::Coord2D> coords;
+    std::vector<te::gm::Coord2D> originalCoords;
+
+    GetCoordinates(&geoms[i], coords);
+    GetCoordinates(&originals[i], originalCoords);
+
+    BOOST_REQUIRE_EQUAL(coords.size(), originalCoords.size());
+
+    for(std::size_t j = 0; j < coords.size(); ++j)
+    {
+      double x = originalCoords[j].x;
+      double y = originalCoords[j].y;
+
+      converter.convert(x, y);
+
+      BOOST_CHECK_EQUAL(coords[j].x, x);
+      BOOST_CHECK_EQUAL(coords[j].y, y);
+    }
+
+    // the parts of a collection are associated to the target SRID too
+    if(te::gm::GeometryCollection* collection = dynamic_cast<te::gm::GeometryCollection*>(&geoms[i]))
+    {
+      for(std::size_t j = 0; j < collection->getNumGeometries(); ++j)
+        BOOST_CHECK_EQUAL(collection->getGeometryN(j)->getSRID(), sg_utmSRID);
+    }
+
+    // and the way back gives the original coordinates
+    te::gm::Transform(&geoms[i], inverse);
+
+    BOOST_CHECK_EQUAL(geoms[i].getSRID(), TE_SRS_WGS84);
+
+    double diff = GetMaxDifference(&geoms[i], &originals[i]);
+
+    BOOST_CHECK_MESSAGE(diff >= 0.0 && diff < 1e-9, "geometry " << i << ", difference " << diff);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
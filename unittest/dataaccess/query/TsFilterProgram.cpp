@@ -0,0 +1,375 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/dataaccess/query/TsFilterProgram.cpp
+
+  \brief A test suite for the FilterProgram class.
+ */
+
+// TerraLib
+#include <terralib/dataaccess/dataset/DataSetType.h>
+#include <terralib/dataaccess/query_h.h>
+#include <terralib/dataaccess/query/FilterProgram.h>
+#include <terralib/dataaccess/query/ST_EnvelopeIntersects.h>
+#include <terralib/datatype/SimpleProperty.h>
+#include <terralib/datatype/StringProperty.h>
+#include <terralib/geometry/GeometryProperty.h>
+#include <terralib/geometry/LinearRing.h>
+#include <terralib/geometry/Point.h>
+#include <terralib/geometry/Polygon.h>
+#include <terralib/memory/ColumnarDataSet.h>
+#include <terralib/memory/DataSet.h>
+#include <terralib/memory/DataSetItem.h>
+#include <terralib/memory/DataSource.h>
+
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <memory>
+
+namespace
+{
+  te::mem::ColumnarDataSet* CreateDataSet()
+  {
+    te::da::DataSetType dt("items");
+    dt.add(new te::dt::SimpleProperty("id", te::dt::INT32_TYPE));
+    dt.add(new te::dt::SimpleProperty("val", te::dt::DOUBLE_TYPE));
+    dt.add(new te::dt::StringProperty("name"));
+    dt.add(new te::dt::SimpleProperty("flag", te::dt::BOOLEAN_TYPE));
+
+    te::mem::ColumnarDataSet* dataset = new te::mem::ColumnarDataSet(&dt);
+
+    for(int i = 0; i < 100; ++i)
+    {
+      dataset->addItem();
+      dataset->setInt32(0, i);
+
+      if(i % 10)
+        dataset->setDouble(1, i * 0.5);
+
+      dataset->setString(2, "n" + boost::lexical_cast<std::string>(i));
+      dataset->setBool(3, i % 2 == 0);
+    }
+
+    return dataset;
+  }
+
+  std::size_t Count(te::da::DataSet* dataset, const te::da::Expression& e)
+  {
+    te::da::FilterProgram program(e, dataset);
+
+    // a small batch size exercises the batch boundaries
+    std::vector<std::size_t> positions;
+    program.select(dataset, positions, 7);
+
+    // the selection must agree with the evaluation item by item
+    std::size_t n = 0;
+
+    dataset->moveBeforeFirst();
+
+    while(dataset->moveNext())
+    {
+      if(program.evaluate(dataset))
+        ++n;
+    }
+
+    BOOST_CHECK_EQUAL(n, positions.size());
+
+    return positions.size();
+  }
+
+  /* A memory dataset that counts the geometries read from it. */
+  class CountingDataSet : public te::mem::DataSet
+  {
+    public:
+
+      CountingDataSet(const te::da::DataSetType* dt)
+        : te::mem::DataSet(dt),
+          m_geometryReads(0)
+      {
+      }
+
+      using te::mem::DataSet::getGeometry;
+
+      std::auto_ptr<te::gm::Geometry> getGeometry(std::size_t i) const
+      {
+        ++m_geometryReads;
+
+        return te::mem::DataSet::getGeometry(i);
+      }
+
+      mutable std::size_t m_geometryReads;
+  };
+
+  te::da::DataSetType* CreatePointsType()
+  {
+    te::da::DataSetType* dt = new te::da::DataSetType("points");
+    dt->add(new te::dt::SimpleProperty("id", te::dt::INT32_TYPE));
+
+    te::gm::GeometryProperty* geomProp = new te::gm::GeometryProperty("geom");
+    geomProp->setGeometryType(te::gm::PointType);
+    dt->add(geomProp);
+
+    return dt;
+  }
+
+  /* The centers of the cells of a 10 x 10 grid of unit cells, the item id is 10 * row + column. */
+  CountingDataSet* CreatePoints(const te::da::DataSetType* dt)
+  {
+    CountingDataSet* dataset = new CountingDataSet(dt);
+
+    for(int id = 0; id < 100; ++id)
+    {
+      te::mem::DataSetItem* item = new te::mem::DataSetItem(dataset);
+      item->setInt32(0, id);
+      item->setGeometry(1, new te::gm::Point(id % 10 + 0.5, id / 10 + 0.5));
+
+      dataset->add(item);
+    }
+
+    return dataset;
+  }
+
+  /* The triangle (0, dy), (10, dy), (0, 10 + dy): with no offset its bounding rectangle covers the whole grid. */
+  te::gm::Polygon* CreateTriangle(double dy = 0.0)
+  {
+    te::gm::LinearRing* ring = new te::gm::LinearRing(4, te::gm::LineStringType);
+    ring->setPoint(0, 0.0, dy);
+    ring->setPoint(1, 10.0, dy);
+    ring->setPoint(2, 0.0, 10.0 + dy);
+    ring->setPoint(3, 0.0, dy);
+
+    te::gm::Polygon* triangle = new te::gm::Polygon(0, te::gm::PolygonType);
+    triangle->push_back(ring);
+
+    return triangle;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( filterprogram_tests )
+
+BOOST_AUTO_TEST_CASE( comparison_test )
+{
+  std::auto_ptr<te::mem::ColumnarDataSet> dataset(CreateDataSet());
+
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::LessThan(te::da::PropertyName("id"), te::da::LiteralInt32(10))), 10);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::GreaterThanOrEqualTo(te::da::PropertyName("val"), te::da::LiteralDouble(25.0))), 45);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::EqualTo(te::da::PropertyName("name"), te::da::LiteralString("n42"))), 1);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::EqualTo(te::da::PropertyName("id"), te::da::LiteralString("5"))), 1);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::EqualTo(te::da::Mul(te::da::PropertyName("id"), te::da::LiteralInt32(2)), te::da::LiteralInt32(10))), 1);
+}
+
+BOOST_AUTO_TEST_CASE( null_test )
+{
+  std::auto_ptr<te::mem::ColumnarDataSet> dataset(CreateDataSet());
+
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::IsNull(new te::da::PropertyName("val"))), 10);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::Not(te::da::IsNull(new te::da::PropertyName("val")))), 90);
+
+  // a comparison with a null value is never satisfied, even negated
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::Not(te::da::GreaterThanOrEqualTo(te::da::PropertyName("val"), te::da::LiteralDouble(25.0)))), 45);
+}
+
+BOOST_AUTO_TEST_CASE( logical_test )
+{
+  std::auto_ptr<te::mem::ColumnarDataSet> dataset(CreateDataSet());
+
+  te::da::Or outside(new te::da::LessThan(te::da::PropertyName("id"), te::da::LiteralInt32(10)),
+                     new te::da::GreaterThan(te::da::PropertyName("id"), te::da::LiteralInt32(89)));
+
+  BOOST_CHECK_EQUAL(Count(dataset.get(), outside), 20);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::Not(outside)), 80);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::And(new te::da::LessThan(te::da::PropertyName("id"), te::da::LiteralInt32(50)),
+                                                     new te::da::PropertyName("flag"))), 25);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::LiteralBool(true)), 100);
+}
+
+BOOST_AUTO_TEST_CASE( like_in_test )
+{
+  std::auto_ptr<te::mem::ColumnarDataSet> dataset(CreateDataSet());
+
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::Like(new te::da::PropertyName("name"), "n1%")), 11);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::Like(new te::da::PropertyName("name"), "n_")), 10);
+
+  te::da::In in("id");
+  in.add(new te::da::LiteralInt32(3));
+  in.add(new te::da::LiteralInt32(7));
+  in.add(new te::da::LiteralInt32(300));
+
+  BOOST_CHECK_EQUAL(Count(dataset.get(), in), 2);
+}
+
+BOOST_AUTO_TEST_CASE( unsupported_test )
+{
+  std::auto_ptr<te::mem::ColumnarDataSet> dataset(CreateDataSet());
+
+  BOOST_CHECK_THROW(te::da::FilterProgram(te::da::EqualTo(te::da::PropertyName("unknown"), te::da::LiteralInt32(1)), dataset.get()),
+                    std::exception);
+}
+
+BOOST_AUTO_TEST_CASE( spatial_test )
+{
+  std::auto_ptr<te::da::DataSetType> dt(CreatePointsType());
+  std::auto_ptr<CountingDataSet> dataset(CreatePoints(dt.get()));
+  std::auto_ptr<te::gm::Polygon> triangle(CreateTriangle());
+
+  te::da::PropertyName geom("geom");
+  te::da::LiteralGeom literal(*triangle);
+
+// 45 points are inside the triangle and 10 on its hypotenuse
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_Intersects(geom, literal)), 55);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_Disjoint(geom, literal)), 45);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_Within(geom, literal)), 45);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_Touches(geom, literal)), 10);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::Not(te::da::ST_Intersects(geom, literal))), 45);
+
+// an envelope literal is compared as a rectangle
+  te::da::LiteralEnvelope envelope(te::gm::Envelope(0.0, 0.0, 5.0, 3.0), 0);
+
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_Intersects(geom, envelope)), 15);
+}
+
+BOOST_AUTO_TEST_CASE( mbr_prefilter_test )
+{
+  std::auto_ptr<te::da::DataSetType> dt(CreatePointsType());
+  std::auto_ptr<CountingDataSet> dataset(CreatePoints(dt.get()));
+  std::auto_ptr<te::gm::Polygon> triangle(CreateTriangle());
+
+  te::da::PropertyName geom("geom");
+  te::da::LiteralGeom literal(*triangle);
+
+// all the points are in the triangle bounding rectangle: only the exact relation rejects the ones beyond the hypotenuse
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_EnvelopeIntersects(geom, literal)), 100);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_Intersects(geom, literal)), 55);
+
+// the rectangle decides the points far from the constant geometry
+  std::auto_ptr<te::gm::Polygon> far(CreateTriangle(-15.0));
+
+  te::da::LiteralGeom farLiteral(*far);
+
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_Intersects(geom, farLiteral)), 0);
+  BOOST_CHECK_EQUAL(Count(dataset.get(), te::da::ST_Disjoint(geom, farLiteral)), 100);
+}
+
+BOOST_AUTO_TEST_CASE( lazy_geometry_test )
+{
+  std::auto_ptr<te::da::DataSetType> dt(CreatePointsType());
+  std::auto_ptr<CountingDataSet> dataset(CreatePoints(dt.get()));
+  std::auto_ptr<te::gm::Polygon> triangle(CreateTriangle());
+
+// the geometries are read only for the items satisfying the attribute operand (the ids 30 to 49)
+  te::da::And filter(new te::da::GreaterThanOrEqualTo(te::da::PropertyName("id"), te::da::LiteralInt32(30)),
+                     new te::da::And(new te::da::LessThan(te::da::PropertyName("id"), te::da::LiteralInt32(50)),
+                                     new te::da::ST_Intersects(new te::da::PropertyName("geom"), new te::da::LiteralGeom(*triangle))));
+
+  te::da::FilterProgram program(filter, dataset.get());
+
+  std::vector<std::size_t> positions;
+
+  dataset->m_geometryReads = 0;
+
+  program.select(dataset.get(), positions, 7);
+
+  BOOST_CHECK_EQUAL(dataset->m_geometryReads, 20);
+
+// reading the geometries moves the dataset, which is restored to the next item of each batch
+  std::vector<std::size_t> expected;
+
+  for(std::size_t id = 30; id < 50; ++id)
+  {
+    if((id % 10) + (id / 10) <= 9)
+      expected.push_back(id);
+  }
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(positions.begin(), positions.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE( memory_transactor_test )
+{
+  std::auto_ptr<te::da::DataSetType> dt(CreatePointsType());
+  std::auto_ptr<CountingDataSet> dataset(CreatePoints(dt.get()));
+  std::auto_ptr<te::gm::Polygon> triangle(CreateTriangle());
+
+  te::mem::DataSource memDataSource("memory:");
+  te::da::DataSource& ds = memDataSource;
+  ds.open();
+
+  std::map<std::string, std::string> options;
+
+  ds.createDataSet(static_cast<te::da::DataSetType*>(dt->clone()), options);
+  dataset->moveBeforeFirst();
+  ds.add("points", dataset.get(), options);
+
+// the spatial filters of getDataSet
+  const te::gm::Envelope e(0.0, 0.0, 5.0, 3.0);
+
+  std::auto_ptr<te::da::DataSet> result = ds.getDataSet("points", "geom", &e, te::gm::INTERSECTS);
+
+  BOOST_REQUIRE(result.get());
+  BOOST_CHECK_EQUAL(result->size(), 15);
+
+  result = ds.getDataSet("points", "geom", triangle.get(), te::gm::WITHIN);
+
+  BOOST_REQUIRE(result.get());
+  BOOST_CHECK_EQUAL(result->size(), 45);
+
+// SELECT * FROM points WHERE id < 10
+  te::da::Fields fields;
+  fields.push_back(new te::da::Field("*"));
+
+  te::da::From from;
+  from.push_back(new te::da::DataSetName("points"));
+
+  te::da::Where where(new te::da::LessThan(te::da::PropertyName("id"), te::da::LiteralInt32(10)));
+
+  result = ds.query(te::da::Select(fields, from, where));
+
+  BOOST_REQUIRE(result.get());
+  BOOST_CHECK_EQUAL(result->size(), 10);
+
+  std::size_t n = 0;
+
+  result->moveBeforeFirst();
+
+  while(result->moveNext())
+  {
+    BOOST_CHECK(result->getInt32("id") < 10);
+    BOOST_CHECK(result->getGeometry("geom").get() != 0);
+    ++n;
+  }
+
+  BOOST_CHECK_EQUAL(n, 10);
+
+// without a filter all the items are returned
+  result = ds.query(te::da::Select(fields, from));
+
+  BOOST_REQUIRE(result.get());
+  BOOST_CHECK_EQUAL(result->size(), 100);
+
+// only the queries selecting all the properties are supported
+  te::da::Fields idField;
+  idField.push_back(new te::da::Field("id"));
+
+  BOOST_CHECK(ds.query(te::da::Select(idField, from, where)).get() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
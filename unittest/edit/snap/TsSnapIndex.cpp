@@ -0,0 +1,139 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/edit/snap/TsSnapIndex.cpp
+
+  \brief A test suit for the Snap Index.
+*/
+
+// TerraLib
+#include "../Config.h"
+#include <terralib/edit/SnapIndex.h>
+
+// STL
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+// Boost
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(snapindex_tests);
+
+BOOST_AUTO_TEST_CASE(nearestVertex_test)
+{
+  te::edit::SnapIndex index;
+
+  // A grid of points, large enough to build the cells
+  std::vector<te::gm::Coord2D> coords;
+
+  for(int i = 0; i < 100; ++i)
+    for(int j = 0; j < 100; ++j)
+      coords.push_back(te::gm::Coord2D(i * 10.0, j * 10.0));
+
+  index.add(&coords[0], coords.size(), false);
+
+  BOOST_CHECK_EQUAL(index.getNumVertices(), 10000);
+  BOOST_CHECK_EQUAL(index.getNumSegments(), 0);
+
+  te::gm::Coord2D result;
+
+  BOOST_CHECK(index.nearestVertex(te::gm::Coord2D(502.0, 497.0), 5.0, result));
+  BOOST_CHECK_EQUAL(result.x, 500.0);
+  BOOST_CHECK_EQUAL(result.y, 500.0);
+
+  BOOST_CHECK(!index.nearestVertex(te::gm::Coord2D(505.0, 505.0), 5.0, result));
+  BOOST_CHECK(!index.nearestVertex(te::gm::Coord2D(-50.0, -50.0), 5.0, result));
+
+  // A vertex added after the build is found too
+  te::gm::Coord2D extra(505.0, 505.0);
+  index.add(&extra, 1, false);
+
+  BOOST_CHECK(index.nearestVertex(te::gm::Coord2D(504.0, 505.0), 5.0, result));
+  BOOST_CHECK_EQUAL(result.x, 505.0);
+}
+
+BOOST_AUTO_TEST_CASE(nearestSegment_test)
+{
+  te::edit::SnapIndex index;
+
+  std::vector<te::gm::Coord2D> coords;
+
+  for(int i = 0; i < 5000; ++i)
+    coords.push_back(te::gm::Coord2D(i * 2.0, (i % 2) * 2.0));
+
+  index.add(&coords[0], coords.size(), true);
+
+  // A long segment crossing the whole extent
+  te::gm::Coord2D diagonal[2] = { te::gm::Coord2D(0.0, 100.0), te::gm::Coord2D(10000.0, 100.0) };
+  index.add(diagonal, 2, true);
+
+  BOOST_CHECK_EQUAL(index.getNumSegments(), 5000);
+
+  te::gm::Coord2D result;
+
+  BOOST_CHECK(index.nearestSegment(te::gm::Coord2D(1001.0, 1.5), 1.0, result));
+  BOOST_CHECK(std::fabs(result.x - 1001.0) < 1.0);
+
+  BOOST_CHECK(index.nearestSegment(te::gm::Coord2D(5000.0, 99.0), 2.0, result));
+  BOOST_CHECK_EQUAL(result.x, 5000.0);
+  BOOST_CHECK_EQUAL(result.y, 100.0);
+
+  BOOST_CHECK(!index.nearestSegment(te::gm::Coord2D(5000.0, 50.0), 2.0, result));
+}
+
+BOOST_AUTO_TEST_CASE(bruteForce_test)
+{
+  te::edit::SnapIndex index;
+
+  std::srand(42);
+
+  std::vector<te::gm::Coord2D> coords;
+
+  for(int i = 0; i < 20000; ++i)
+  {
+    te::gm::Coord2D c(std::rand() % 100000 / 10.0, std::rand() % 100000 / 10.0);
+    coords.push_back(c);
+    index.add(&c, 1, false);
+  }
+
+  for(int k = 0; k < 200; ++k)
+  {
+    te::gm::Coord2D p(std::rand() % 100000 / 10.0, std::rand() % 100000 / 10.0);
+
+    double best = std::numeric_limits<double>::max();
+
+    for(std::size_t i = 0; i < coords.size(); ++i)
+      best = std::min(best, std::sqrt((coords[i].x - p.x) * (coords[i].x - p.x) + (coords[i].y - p.y) * (coords[i].y - p.y)));
+
+    te::gm::Coord2D result;
+
+    bool found = index.nearestVertex(p, 50.0, result);
+
+    BOOST_CHECK_EQUAL(found, best <= 50.0);
+
+    if(found)
+      BOOST_CHECK_CLOSE(std::sqrt((result.x - p.x) * (result.x - p.x) + (result.y - p.y) * (result.y - p.y)), best, 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1351,7 +1351,117 @@ void TsGeometry::tcBasicGeometryMethods()
 void TsGeometry::tcSpatialRelationsMethods()
 {
 //#ifdef TE_COMPILE_ALL
+// a square with a hole: (0 0, 10 0, 10 10, 0 10, 0 0), (4 4, 6 4, 6 6, 4 6, 4 4)
+  te::gm::LinearRing* shell = new te::gm::LinearRing(5, te::gm::LineStringType, 4326);
+  shell->setPoint(0, 0.0, 0.0);
+  shell->setPoint(1, 10.0, 0.0);
+  shell->setPoint(2, 10.0, 10.0);
+  shell->setPoint(3, 0.0, 10.0);
+  shell->setPoint(4, 0.0, 0.0);
+
+  te::gm::LinearRing* hole = new te::gm::LinearRing(5, te::gm::LineStringType, 4326);
+  hole->setPoint(0, 4.0, 4.0);
+  hole->setPoint(1, 6.0, 4.0);
+  hole->setPoint(2, 6.0, 6.0);
+  hole->setPoint(3, 4.0, 6.0);
+  hole->setPoint(4, 4.0, 4.0);
+
+  te::gm::Polygon poly(2, te::gm::PolygonType, 4326);
+  poly.setRingN(0, shell);
+  poly.setRingN(1, hole);
+
+  te::gm::Point inside(2.0, 2.0, 4326);
+  te::gm::Point onBoundary(10.0, 5.0, 4326);
+  te::gm::Point inHole(5.0, 5.0, 4326);
+  te::gm::Point farAway(50.0, 50.0, 4326);
+
+  CPPUNIT_ASSERT(te::gm::LocatePoint(te::gm::Coord2D(2.0, 2.0), poly) == 1);
+  CPPUNIT_ASSERT(te::gm::LocatePoint(te::gm::Coord2D(10.0, 5.0), poly) == 0);
+  CPPUNIT_ASSERT(te::gm::LocatePoint(te::gm::Coord2D(4.0, 5.0), poly) == 0);
+  CPPUNIT_ASSERT(te::gm::LocatePoint(te::gm::Coord2D(5.0, 5.0), poly) == -1);
+  CPPUNIT_ASSERT(te::gm::LocatePoint(te::gm::Coord2D(-1.0, 5.0), poly) == -1);
+
+  CPPUNIT_ASSERT(inside.intersects(&poly));
+  CPPUNIT_ASSERT(poly.intersects(&inside));
+  CPPUNIT_ASSERT(inside.within(&poly));
+  CPPUNIT_ASSERT(poly.contains(&inside));
+  CPPUNIT_ASSERT(inside.touches(&poly) == false);
+
+  CPPUNIT_ASSERT(onBoundary.intersects(&poly));
+  CPPUNIT_ASSERT(onBoundary.within(&poly) == false);
+  CPPUNIT_ASSERT(onBoundary.coveredBy(&poly));
+  CPPUNIT_ASSERT(poly.covers(&onBoundary));
+  CPPUNIT_ASSERT(onBoundary.touches(&poly));
+
+  CPPUNIT_ASSERT(inHole.disjoint(&poly));
+  CPPUNIT_ASSERT(poly.intersects(&inHole) == false);
+
+  CPPUNIT_ASSERT(farAway.disjoint(&poly));
+  CPPUNIT_ASSERT(poly.dWithin(&farAway, 1.0) == false);
+
+// the point location in a multipolygon
+  te::gm::MultiPolygon mpoly(1, te::gm::MultiPolygonType, 4326);
+  mpoly.setGeometryN(0, static_cast<te::gm::Geometry*>(poly.clone()));
+
+  CPPUNIT_ASSERT(mpoly.contains(&inside));
+  CPPUNIT_ASSERT(mpoly.intersects(&inHole) == false);
+
+// line strings: end points are the boundary
+  te::gm::LineString l1(3, te::gm::LineStringType, 4326);
+  l1.setPoint(0, 0.0, 0.0);
+  l1.setPoint(1, 5.0, 5.0);
+  l1.setPoint(2, 10.0, 0.0);
+
+  te::gm::LineString l2(2, te::gm::LineStringType, 4326);
+  l2.setPoint(0, 0.0, 4.0);
+  l2.setPoint(1, 10.0, 4.0);
+
+  te::gm::LineString l3(2, te::gm::LineStringType, 4326);
+  l3.setPoint(0, 0.0, 6.0);
+  l3.setPoint(1, 10.0, 6.0);
+
+  te::gm::Point lineEnd(10.0, 0.0, 4326);
+  te::gm::Point lineInterior(2.5, 2.5, 4326);
+
+  CPPUNIT_ASSERT(te::gm::LocatePoint(te::gm::Coord2D(10.0, 0.0), l1) == 0);
+  CPPUNIT_ASSERT(te::gm::LocatePoint(te::gm::Coord2D(2.5, 2.5), l1) == 1);
+  CPPUNIT_ASSERT(te::gm::LocatePoint(te::gm::Coord2D(2.5, 2.0), l1) == -1);
+
+  CPPUNIT_ASSERT(lineEnd.touches(&l1));
+  CPPUNIT_ASSERT(lineInterior.within(&l1));
+  CPPUNIT_ASSERT(l1.intersects(&l2));
+  CPPUNIT_ASSERT(l1.disjoint(&l3));
+  CPPUNIT_ASSERT(te::gm::SegmentsIntersect(te::gm::Coord2D(0.0, 0.0), te::gm::Coord2D(2.0, 0.0),
+                                           te::gm::Coord2D(1.0, 0.0), te::gm::Coord2D(3.0, 0.0)));
+  CPPUNIT_ASSERT(te::gm::SegmentsIntersect(te::gm::Coord2D(0.0, 0.0), te::gm::Coord2D(1.0, 1.0),
+                                           te::gm::Coord2D(1.0, 1.0), te::gm::Coord2D(2.0, 0.0)));
+  CPPUNIT_ASSERT(te::gm::SegmentsIntersect(te::gm::Coord2D(0.0, 0.0), te::gm::Coord2D(1.0, 1.0),
+                                           te::gm::Coord2D(2.0, 2.0), te::gm::Coord2D(3.0, 3.0)) == false);
+
+// points
+  te::gm::Point samePt(2.0, 2.0, 4326);
+
+  CPPUNIT_ASSERT(inside.intersects(&samePt));
+  CPPUNIT_ASSERT(inside.within(&samePt));
+  CPPUNIT_ASSERT(inside.disjoint(&farAway));
+
+// the cached GEOS representation is released by the setters
+  {
+    te::gm::ScopedGEOSCache cache(l1);
+
+    std::auto_ptr<te::gm::Geometry> l1Clone(static_cast<te::gm::Geometry*>(l1.clone()));
+
+    CPPUNIT_ASSERT(l1.isGEOSCacheEnabled());
+    CPPUNIT_ASSERT(l1.crosses(&l2));
+    CPPUNIT_ASSERT(l1.equals(l1Clone.get()));
+
+    l1.setPoint(1, 5.0, 4.5);
+    l1.computeMBR(false);
+
+    CPPUNIT_ASSERT(l1.equals(l1Clone.get()) == false);
+  }
 
+  CPPUNIT_ASSERT(l1.isGEOSCacheEnabled() == false);
 //#endif
 }
 
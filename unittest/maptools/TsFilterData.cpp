@@ -0,0 +1,168 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+
+/*!
+  \file terralib/unittest/maptools/TsFilterData.cpp
+
+  \brief A test suite for the client side filter of the layer data.
+ */
+
+// TerraLib
+#include <terralib/dataaccess/dataset/DataSetType.h>
+#include <terralib/dataaccess/query_h.h>
+#include <terralib/datatype/SimpleProperty.h>
+#include <terralib/datatype/StringProperty.h>
+#include <terralib/maptools/Utils.h>
+#include <terralib/memory/DataSet.h>
+#include <terralib/memory/DataSetItem.h>
+
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <memory>
+#include <set>
+
+namespace
+{
+  /* A memory dataset that can only be traversed forward, like the datasets of some drivers. */
+  class ForwardOnlyDataSet : public te::mem::DataSet
+  {
+    public:
+
+      ForwardOnlyDataSet(const te::da::DataSetType* dt)
+        : te::mem::DataSet(dt)
+      {
+      }
+
+      te::common::TraverseType getTraverseType() const
+      {
+        return te::common::FORWARDONLY;
+      }
+  };
+
+  void Fill(te::mem::DataSet* dataset)
+  {
+    for(int i = 0; i < 50; ++i)
+    {
+      te::mem::DataSetItem* item = new te::mem::DataSetItem(dataset);
+      item->setInt32(0, i);
+      item->setString(1, "n" + boost::lexical_cast<std::string>(i));
+
+      dataset->add(item);
+    }
+
+    dataset->moveBeforeFirst();
+  }
+
+  te::da::DataSetType* CreateDataSetType()
+  {
+    te::da::DataSetType* dt = new te::da::DataSetType("items");
+    dt->add(new te::dt::SimpleProperty("id", te::dt::INT32_TYPE));
+    dt->add(new te::dt::StringProperty("name"));
+
+    return dt;
+  }
+
+  /* It returns the ids of the filtered items, checking that they are read in the original order. */
+  std::set<int> GetIds(te::da::DataSet* dataset)
+  {
+    std::set<int> ids;
+
+    int last = -1;
+
+    dataset->moveBeforeFirst();
+
+    while(dataset->moveNext())
+    {
+      const int id = dataset->getInt32("id");
+
+      BOOST_CHECK(id > last);
+      BOOST_CHECK_EQUAL(dataset->getString("name"), "n" + boost::lexical_cast<std::string>(id));
+
+      ids.insert(id);
+      last = id;
+    }
+
+    return ids;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( filterData_tests )
+
+BOOST_AUTO_TEST_CASE( randomAccess_test )
+{
+  std::auto_ptr<te::da::DataSetType> dt(CreateDataSetType());
+
+  std::auto_ptr<te::da::DataSet> dataset(new te::mem::DataSet(dt.get()));
+  Fill(static_cast<te::mem::DataSet*>(dataset.get()));
+
+  te::da::Or filter(new te::da::LessThan(te::da::PropertyName("id"), te::da::LiteralInt32(5)),
+                    new te::da::Like(new te::da::PropertyName("name"), "n4_"));
+
+  std::auto_ptr<te::da::DataSet> result = te::map::FilterData(dataset, filter);
+
+  BOOST_REQUIRE(result.get());
+  BOOST_CHECK_EQUAL(result->size(), 15);
+
+  std::set<int> ids = GetIds(result.get());
+
+  BOOST_CHECK_EQUAL(ids.size(), 15);
+  BOOST_CHECK(ids.count(4) == 1 && ids.count(45) == 1 && ids.count(5) == 0);
+}
+
+BOOST_AUTO_TEST_CASE( forwardOnly_test )
+{
+  std::auto_ptr<te::da::DataSetType> dt(CreateDataSetType());
+
+  std::auto_ptr<te::da::DataSet> dataset(new ForwardOnlyDataSet(dt.get()));
+  Fill(static_cast<te::mem::DataSet*>(dataset.get()));
+
+// the items of a dataset that can not be randomly accessed are copied to memory before the selection
+  std::auto_ptr<te::da::DataSet> result = te::map::FilterData(dataset, te::da::GreaterThanOrEqualTo(te::da::PropertyName("id"), te::da::LiteralInt32(40)));
+
+  BOOST_REQUIRE(result.get());
+  BOOST_CHECK_EQUAL(result->size(), 10);
+  BOOST_CHECK_EQUAL(GetIds(result.get()).size(), 10);
+
+// no item satisfies the filter
+  dataset.reset(new ForwardOnlyDataSet(dt.get()));
+  Fill(static_cast<te::mem::DataSet*>(dataset.get()));
+
+  result = te::map::FilterData(dataset, te::da::LessThan(te::da::PropertyName("id"), te::da::LiteralInt32(0)));
+
+  BOOST_REQUIRE(result.get());
+  BOOST_CHECK_EQUAL(result->size(), 0);
+  BOOST_CHECK(!result->moveNext());
+}
+
+BOOST_AUTO_TEST_CASE( unsupported_test )
+{
+  std::auto_ptr<te::da::DataSetType> dt(CreateDataSetType());
+
+  std::auto_ptr<te::da::DataSet> dataset(new te::mem::DataSet(dt.get()));
+  Fill(static_cast<te::mem::DataSet*>(dataset.get()));
+
+  BOOST_CHECK_THROW(te::map::FilterData(dataset, te::da::EqualTo(te::da::PropertyName("unknown"), te::da::LiteralInt32(1))),
+                    std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,326 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+
+/*!
+  \file terralib/unittest/maptools/TsLevelOfDetail.cpp
+
+  \brief A test suite for the generalization of the geometries to the canvas resolution.
+ */
+
+// TerraLib
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/LinearRing.h>
+#include <terralib/geometry/LineString.h>
+#include <terralib/geometry/MultiPolygon.h>
+#include <terralib/geometry/Point.h>
+#include <terralib/geometry/Polygon.h>
+#include <terralib/maptools/AbstractLayerRenderer.h>
+#include <terralib/maptools/Utils.h>
+
+// Boost
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace
+{
+  const int sg_srid = 4326;
+
+  /* A zigzag line with nPoints vertices from x = 0 to x = length. */
+  te::gm::LineString* CreateLine(std::size_t nPoints, double length)
+  {
+    te::gm::LineString* line = new te::gm::LineString(nPoints, te::gm::LineStringType, sg_srid);
+
+    for(std::size_t i = 0; i < nPoints; ++i)
+      line->setPoint(i, length * i / (nPoints - 1), (i % 2) * 0.001 * length);
+
+    return line;
+  }
+
+  /* A closed ring approximating a circle with nPoints distinct vertices. */
+  te::gm::LinearRing* CreateRing(std::size_t nPoints, double cx, double cy, double radius)
+  {
+    te::gm::LinearRing* ring = new te::gm::LinearRing(nPoints + 1, te::gm::LineStringType, sg_srid);
+
+    for(std::size_t i = 0; i < nPoints; ++i)
+    {
+      double angle = 2.0 * 3.14159265358979323846 * i / nPoints;
+
+      ring->setPoint(i, cx + radius * std::cos(angle), cy + radius * std::sin(angle));
+    }
+
+    ring->setPoint(nPoints, cx + radius, cy);
+
+    return ring;
+  }
+
+  te::gm::Polygon* CreatePolygon(std::size_t nPoints, double cx, double cy, double radius)
+  {
+    te::gm::Polygon* polygon = new te::gm::Polygon(2, te::gm::PolygonType, sg_srid);
+
+    polygon->setRingN(0, CreateRing(nPoints, cx, cy, radius));
+    polygon->setRingN(1, CreateRing(nPoints, cx, cy, radius * 0.5));
+
+    return polygon;
+  }
+
+  /* It checks that the vertices of a generalized line are vertices of the original one, in the same order. */
+  bool IsSubsequence(const te::gm::LineString& generalized, const te::gm::LineString& original)
+  {
+    std::size_t j = 0;
+
+    for(std::size_t i = 0; i < generalized.getNPoints(); ++i)
+    {
+      while(j < original.getNPoints() &&
+            (original.getX(j) != generalized.getX(i) || original.getY(j) != generalized.getY(i)))
+        ++j;
+
+      if(j == original.getNPoints())
+        return false;
+
+      ++j;
+    }
+
+    return true;
+  }
+
+  /* The number of distinct grid cells crossed by consecutive runs of vertices, plus the last vertex. */
+  std::size_t CountCellRuns(const te::gm::LineString& line, double cellSize)
+  {
+    std::size_t runs = 1;
+
+    std::pair<double, double> cell(std::floor(line.getX(0) / cellSize), std::floor(line.getY(0) / cellSize));
+
+    for(std::size_t i = 1; i < line.getNPoints() - 1; ++i)
+    {
+      std::pair<double, double> next(std::floor(line.getX(i) / cellSize), std::floor(line.getY(i) / cellSize));
+
+      if(next != cell)
+        ++runs;
+
+      cell = next;
+    }
+
+    return runs + 1;
+  }
+
+  bool CheckRing(const te::gm::LineString& ring, const te::gm::LineString& original)
+  {
+    return ring.getNPoints() >= 4 && ring.isClosed() && IsSubsequence(ring, original);
+  }
+
+  /* A renderer that exposes its level of detail stage. */
+  class TsLevelOfDetailRenderer : public te::map::AbstractLayerRenderer
+  {
+    public:
+
+      /* It sets a canvas of 100 x 100 pixels over the given area. */
+      void setArea(double size)
+      {
+        m_transformer.setTransformationParameters(0.0, 0.0, size, size, 100, 100);
+      }
+
+      bool apply(std::auto_ptr<te::gm::Geometry>& geom)
+      {
+        return applyLevelOfDetail(geom);
+      }
+  };
+}
+
+BOOST_AUTO_TEST_SUITE( levelOfDetail_tests )
+
+BOOST_AUTO_TEST_CASE( generalizeLine_test )
+{
+  std::auto_ptr<te::gm::LineString> original(CreateLine(10001, 100.0));
+
+  const double cellSizes[] = { 0.05, 0.5, 1.0, 5.0, 20.0 };
+
+  std::size_t previous = original->getNPoints();
+
+  for(std::size_t i = 0; i < 5; ++i)
+  {
+    std::auto_ptr<te::gm::LineString> line(static_cast<te::gm::LineString*>(original->clone()));
+
+    te::map::GeneralizeGeometry(line.get(), 0.0, 0.0, cellSizes[i]);
+
+// one vertex is kept for each run of vertices in the same cell, and the first and the last are kept
+    BOOST_CHECK_EQUAL(line->getNPoints(), CountCellRuns(*original, cellSizes[i]));
+    BOOST_CHECK(line->getNPoints() <= previous);
+    BOOST_CHECK(line->getNPoints() >= 2);
+    BOOST_CHECK(IsSubsequence(*line, *original));
+    BOOST_CHECK_EQUAL(line->getX(line->getNPoints() - 1), 100.0);
+
+    previous = line->getNPoints();
+  }
+
+// with a cell of one unit the 10001 vertices are reduced to about one vertex per cell crossed
+  std::auto_ptr<te::gm::LineString> line(static_cast<te::gm::LineString*>(original->clone()));
+
+  te::map::GeneralizeGeometry(line.get(), 0.0, 0.0, 1.0);
+
+  BOOST_CHECK(line->getNPoints() <= 102);
+
+// a zero cell size and a line of two vertices are not changed
+  std::auto_ptr<te::gm::LineString> unchanged(static_cast<te::gm::LineString*>(original->clone()));
+
+  te::map::GeneralizeGeometry(unchanged.get(), 0.0, 0.0, 0.0);
+
+  BOOST_CHECK_EQUAL(unchanged->getNPoints(), original->getNPoints());
+
+  std::auto_ptr<te::gm::LineString> segment(CreateLine(2, 0.1));
+
+  te::map::GeneralizeGeometry(segment.get(), 0.0, 0.0, 1.0);
+
+  BOOST_CHECK_EQUAL(segment->getNPoints(), 2);
+}
+
+BOOST_AUTO_TEST_CASE( generalizeRing_test )
+{
+  std::auto_ptr<te::gm::Polygon> original(CreatePolygon(720, 50.0, 50.0, 40.0));
+
+  const double cellSizes[] = { 0.5, 2.0, 10.0, 30.0, 100.0, 1000.0 };
+
+  for(std::size_t i = 0; i < 6; ++i)
+  {
+    std::auto_ptr<te::gm::Polygon> polygon(static_cast<te::gm::Polygon*>(original->clone()));
+
+    te::map::GeneralizeGeometry(polygon.get(), 0.0, 0.0, cellSizes[i]);
+
+    BOOST_REQUIRE_EQUAL(polygon->getNumRings(), 2);
+
+    for(std::size_t r = 0; r < 2; ++r)
+    {
+      const te::gm::LineString* ring = static_cast<const te::gm::LineString*>(polygon->getRingN(r));
+      const te::gm::LineString* originalRing = static_cast<const te::gm::LineString*>(original->getRingN(r));
+
+      BOOST_CHECK_MESSAGE(CheckRing(*ring, *originalRing), "cell size " << cellSizes[i] << ", ring " << r << ", " << ring->getNPoints() << " vertices");
+      BOOST_CHECK(ring->getNPoints() <= originalRing->getNPoints());
+    }
+  }
+
+// a ring that would be reduced to less than four vertices is kept as it is
+  std::auto_ptr<te::gm::Polygon> collapsed(static_cast<te::gm::Polygon*>(original->clone()));
+
+  te::map::GeneralizeGeometry(collapsed.get(), 0.0, 0.0, 1000.0);
+
+  BOOST_CHECK_EQUAL(collapsed->getRingN(0)->getNPoints(), original->getRingN(0)->getNPoints());
+
+// a closed line is handled as a ring
+  std::auto_ptr<te::gm::LinearRing> closedLine(CreateRing(720, 50.0, 50.0, 40.0));
+  std::auto_ptr<te::gm::LinearRing> originalLine(CreateRing(720, 50.0, 50.0, 40.0));
+
+  te::map::GeneralizeGeometry(closedLine.get(), 0.0, 0.0, 30.0);
+
+  BOOST_CHECK(CheckRing(*closedLine, *originalLine));
+  BOOST_CHECK(closedLine->getNPoints() < originalLine->getNPoints());
+}
+
+BOOST_AUTO_TEST_CASE( generalizeCollection_test )
+{
+  te::gm::MultiPolygon multi(2, te::gm::MultiPolygonType, sg_srid);
+
+  multi.setGeometryN(0, CreatePolygon(720, 50.0, 50.0, 40.0));
+  multi.setGeometryN(1, CreatePolygon(720, 200.0, 50.0, 40.0));
+
+  std::auto_ptr<te::gm::Polygon> original(CreatePolygon(720, 50.0, 50.0, 40.0));
+
+  te::map::GeneralizeGeometry(&multi, 0.0, 0.0, 2.0);
+
+  for(std::size_t i = 0; i < 2; ++i)
+  {
+    const te::gm::Polygon* polygon = static_cast<const te::gm::Polygon*>(multi.getGeometryN(i));
+
+    for(std::size_t r = 0; r < 2; ++r)
+    {
+      const te::gm::LineString* ring = static_cast<const te::gm::LineString*>(polygon->getRingN(r));
+
+      BOOST_CHECK(ring->getNPoints() >= 4 && ring->isClosed());
+      BOOST_CHECK(ring->getNPoints() < original->getRingN(r)->getNPoints());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( applyLevelOfDetail_test )
+{
+// 100 x 100 pixels of one unit
+  TsLevelOfDetailRenderer renderer;
+  renderer.setArea(100.0);
+
+// a sub-pixel polygon is replaced by its envelope
+  std::auto_ptr<te::gm::Geometry> geom(CreatePolygon(720, 10.0, 10.0, 0.3));
+
+  BOOST_CHECK(renderer.apply(geom));
+  BOOST_REQUIRE_EQUAL(geom->getGeomTypeId(), te::gm::PolygonType);
+  BOOST_CHECK_EQUAL(static_cast<te::gm::Polygon*>(geom.get())->getNumRings(), 1);
+  BOOST_CHECK_EQUAL(static_cast<te::gm::Polygon*>(geom.get())->getRingN(0)->getNPoints(), 5);
+  BOOST_CHECK_EQUAL(geom->getSRID(), sg_srid);
+  BOOST_CHECK_CLOSE(geom->getMBR()->getWidth(), 0.6, 1e-6);
+
+// a sub-pixel line is replaced by its diagonal
+  geom.reset(CreateLine(100, 0.5));
+
+  BOOST_CHECK(renderer.apply(geom));
+  BOOST_REQUIRE_EQUAL(geom->getGeomTypeId(), te::gm::LineStringType);
+  BOOST_CHECK_EQUAL(static_cast<te::gm::LineString*>(geom.get())->getNPoints(), 2);
+  BOOST_CHECK_EQUAL(static_cast<te::gm::LineString*>(geom.get())->getX(1), 0.5);
+
+// without the proxy the sub-pixel geometries are culled
+  renderer.setSubPixelProxyEnabled(false);
+
+  geom.reset(CreatePolygon(720, 10.0, 10.0, 0.3));
+  BOOST_CHECK(!renderer.apply(geom));
+
+  geom.reset(CreateLine(100, 0.5));
+  BOOST_CHECK(!renderer.apply(geom));
+
+// the points are always drawn
+  geom.reset(new te::gm::Point(10.0, 10.0, sg_srid));
+  BOOST_CHECK(renderer.apply(geom));
+  BOOST_CHECK_EQUAL(geom->getGeomTypeId(), te::gm::PointType);
+
+// the other geometries are generalized with cells of TE_MAP_GENERALIZATION_TOLERANCE pixels
+  std::auto_ptr<te::gm::Polygon> original(CreatePolygon(720, 50.0, 50.0, 40.0));
+
+  geom.reset(static_cast<te::gm::Geometry*>(original->clone()));
+  BOOST_CHECK(renderer.apply(geom));
+
+  const te::gm::LineString* ring = static_cast<const te::gm::LineString*>(static_cast<te::gm::Polygon*>(geom.get())->getRingN(0));
+  BOOST_CHECK(CheckRing(*ring, *static_cast<const te::gm::LineString*>(original->getRingN(0))));
+  BOOST_CHECK(ring->getNPoints() < original->getRingN(0)->getNPoints());
+
+// at a coarser resolution the same geometry has less vertices
+  renderer.setArea(1000.0);
+
+  std::auto_ptr<te::gm::Geometry> coarse(static_cast<te::gm::Geometry*>(original->clone()));
+  BOOST_CHECK(renderer.apply(coarse));
+  BOOST_CHECK(static_cast<te::gm::Polygon*>(coarse.get())->getRingN(0)->getNPoints() < ring->getNPoints());
+
+// the stage can be turned off
+  renderer.setLevelOfDetailEnabled(false);
+
+  geom.reset(CreatePolygon(720, 10.0, 10.0, 0.3));
+  BOOST_CHECK(renderer.apply(geom));
+  BOOST_CHECK_EQUAL(static_cast<te::gm::Polygon*>(geom.get())->getRingN(0)->getNPoints(), 721);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
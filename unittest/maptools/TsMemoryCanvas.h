@@ -0,0 +1,281 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/maptools/TsMemoryCanvas.h
+
+  \brief A canvas that keeps its image in memory, used by the map tools tests.
+*/
+
+#ifndef __TERRALIB_UNITTEST_MAPTOOLS_INTERNAL_TSMEMORYCANVAS_H
+#define __TERRALIB_UNITTEST_MAPTOOLS_INTERNAL_TSMEMORYCANVAS_H
+
+// TerraLib
+#include <terralib/maptools/Canvas.h>
+
+// STL
+#include <vector>
+
+/*!
+  \class TsMemoryCanvas
+
+  \brief A canvas that only supports clearing, reading and writing RGBA images.
+
+  The other drawing operations are ignored.
+*/
+class TsMemoryCanvas : public te::map::Canvas
+{
+  public:
+
+    TsMemoryCanvas(int w, int h)
+      : m_width(w),
+        m_height(h),
+        m_pixels(static_cast<std::size_t>(w) * static_cast<std::size_t>(h))
+    {
+    }
+
+    const te::color::RGBAColor& getPixel(int x, int y) const
+    {
+      return m_pixels[static_cast<std::size_t>(y) * m_width + x];
+    }
+
+    void setWindow(const double& llx, const double& lly, const double& urx, const double& ury) { }
+
+    void setBackgroundColor(const te::color::RGBAColor& color) { m_background = color; }
+
+    te::color::RGBAColor getBackgroundColor() const { return m_background; }
+
+    void clear() { std::fill(m_pixels.begin(), m_pixels.end(), m_background); }
+
+    void resize(int w, int h)
+    {
+      m_width = w;
+      m_height = h;
+      m_pixels.assign(static_cast<std::size_t>(w) * static_cast<std::size_t>(h), m_background);
+    }
+
+    int getWidth() const { return m_width; }
+
+    int getHeight() const { return m_height; }
+
+    te::color::RGBAColor** getImage(const int x, const int y, const int w, const int h) const
+    {
+      te::color::RGBAColor** rows = new te::color::RGBAColor*[h];
+
+      for(int r = 0; r < h; ++r)
+      {
+        rows[r] = new te::color::RGBAColor[w];
+
+        for(int c = 0; c < w; ++c)
+          rows[r][c] = getPixel(x + c, y + r);
+      }
+
+      return rows;
+    }
+
+    void drawImage(int x, int y, te::color::RGBAColor** src, int w, int h)
+    {
+      for(int r = 0; r < h; ++r)
+      {
+        if(y + r < 0 || y + r >= m_height)
+          continue;
+
+        for(int c = 0; c < w; ++c)
+        {
+          if(x + c >= 0 && x + c < m_width)
+            m_pixels[static_cast<std::size_t>(y + r) * m_width + x + c] = src[r][c];
+        }
+      }
+    }
+
+    void calcAspectRatio(double& llx, double& lly, double& urx, double& ury, const te::map::AlignType hAlign, const te::map::AlignType vAlign) { }
+
+    void calcAspectRatio(te::gm::Envelope* envelope, const te::map::AlignType hAlign, const te::map::AlignType vAlign) { }
+
+    void draw(const te::gm::Geometry* geom) { }
+
+    void draw(const te::gm::Point* point) { }
+
+    void draw(const te::gm::MultiPoint* mpoint) { }
+
+    void draw(const te::gm::LineString* line) { }
+
+    void draw(const te::gm::MultiLineString* mline) { }
+
+    void draw(const te::gm::Polygon* poly) { }
+
+    void draw(const te::gm::MultiPolygon* mpoly) { }
+
+    void draw(const te::gm::GeometryCollection* g) { }
+
+    void draw(const te::gm::MultiSurface* g) { }
+
+    void save(const char* fileName, te::map::ImageType t, int quality, int fg) const { }
+
+    char* getImage(te::map::ImageType t, std::size_t& size, int quality, int fg) const { return 0; }
+
+    void freeImage(char* img) const { }
+
+    void drawImage(char* src, std::size_t size, te::map::ImageType t) { }
+
+    void drawImage(te::color::RGBAColor** src, int w, int h) { }
+
+    void drawImage(int x, int y, char* src, std::size_t size, te::map::ImageType t) { }
+
+    void drawImage(int x, int y, int w, int h, char* src, std::size_t size, te::map::ImageType t) { }
+
+    void drawImage(int x, int y, int w, int h, te::color::RGBAColor** src, int srcw, int srch) { }
+
+    void drawImage(int x, int y, int w, int h, char* src, std::size_t size, te::map::ImageType t, int sx, int sy, int sw, int sh) { }
+
+    void drawImage(int x, int y, int w, int h, te::color::RGBAColor** src, int sx, int sy, int sw, int sh) { }
+
+    void drawImage(int x, int y, te::rst::Raster* src, int opacity) { }
+
+    void drawImage(int x, int y, int w, int h, te::rst::Raster* src, int sx, int sy, int sw, int sh, int opacity) { }
+
+    void drawPixel(int x, int y) { }
+
+    void drawPixel(int x, int y, const te::color::RGBAColor& color) { }
+
+    void drawText(int x, int y, const std::string& txt, float angle, double anchorX, double anchorY, int displacementX, int displacementY) { }
+
+    void drawText(const te::gm::Point* p, const std::string& txt, float angle, double anchorX, double anchorY, int displacementX, int displacementY) { }
+
+    void drawText(const double& x, const double& y, const std::string& txt, float angle, double anchorX, double anchorY, int displacementX, int displacementY) { }
+
+    te::gm::Polygon* getTextBoundary(int x, int y, const std::string& txt, float angle, double anchorX, double anchorY, int displacementX, int displacementY) { return 0; }
+
+    te::gm::Polygon* getTextBoundary(const te::gm::Point* p, const std::string& txt, float angle, double anchorX, double anchorY, int displacementX, int displacementY) { return 0; }
+
+    te::gm::Polygon* getTextBoundary(const double& x, const double& y, const std::string& txt, float angle, double anchorX, double anchorY, int displacementX, int displacementY) { return 0; }
+
+    void setTextColor(const te::color::RGBAColor& color) { }
+
+    void setTextOpacity(int opacity) { }
+
+    void setFontFamily(const std::string& family) { }
+
+    void setTextPointSize(double size) { }
+
+    void setTextStyle(te::se::Font::FontStyleType style) { }
+
+    void setTextWeight(te::se::Font::FontWeightType weight) { }
+
+    void setTextStretch(std::size_t stretch) { }
+
+    void setTextUnderline(bool b) { }
+
+    void setTextOverline(bool b) { }
+
+    void setTextStrikeOut(bool b) { }
+
+    void setTextDecorationColor(const te::color::RGBAColor& color) { }
+
+    void setTextDecorationWidth(int width) { }
+
+    void setTextContourColor(const te::color::RGBAColor& color) { }
+
+    void setTextContourEnabled(bool b) { }
+
+    void setTextContourOpacity(int opacity) { }
+
+    void setTextContourWidth(int width) { }
+
+    void setTextJustification(int justType) { }
+
+    void setTextMultiLineSpacing(int spacing) { }
+
+    void setPointColor(const te::color::RGBAColor& color) { }
+
+    void setPointWidth(int w) { }
+
+    void setPointPattern(te::color::RGBAColor** pattern, int ncols, int nrows) { }
+
+    void setPointPattern(char* pattern, std::size_t size, te::map::ImageType t) { }
+
+    void setPointPatternRotation(const double& angle) { }
+
+    void setPointPatternOpacity(int opacity) { }
+
+    void setLineColor(const te::color::RGBAColor& color) { }
+
+    void setLinePattern(te::color::RGBAColor** pattern, int ncols, int nrows) { }
+
+    void setLinePattern(char* pattern, std::size_t size, te::map::ImageType t) { }
+
+    void setLinePatternRotation(const double& angle) { }
+
+    void setLinePatternOpacity(int opacity) { }
+
+    void setLineWidth(int w) { }
+
+    void setLineDashStyle(te::map::LineDashStyle style) { }
+
+    void setLineDashStyle(const std::vector<double>& style) { }
+
+    void setLineCapStyle(te::map::LineCapStyle style) { }
+
+    void setLineJoinStyle(te::map::LineJoinStyle style) { }
+
+    void setPolygonFillColor(const te::color::RGBAColor& color) { }
+
+    void setPolygonContourColor(const te::color::RGBAColor& color) { }
+
+    void setPolygonFillPattern(te::color::RGBAColor** pattern, int ncols, int nrows) { }
+
+    void setPolygonFillPattern(char* pattern, std::size_t size, te::map::ImageType t) { }
+
+    void setPolygonPatternWidth(int w) { }
+
+    void setPolygonPatternRotation(const double& angle) { }
+
+    void setPolygonPatternOpacity(int opacity) { }
+
+    void setPolygonContourPattern(te::color::RGBAColor** pattern, int ncols, int nrows) { }
+
+    void setPolygonContourPattern(char* pattern, std::size_t size, te::map::ImageType t) { }
+
+    void setPolygonContourWidth(int w) { }
+
+    void setPolygonContourPatternRotation(const double& angle) { }
+
+    void setPolygonContourPatternOpacity(int opacity) { }
+
+    void setPolygonContourDashStyle(te::map::LineDashStyle style) { }
+
+    void setPolygonContourDashStyle(const std::vector<double>& style) { }
+
+    void setPolygonContourCapStyle(te::map::LineCapStyle style) { }
+
+    void setPolygonContourJoinStyle(te::map::LineJoinStyle style) { }
+
+    void setEraseMode() { }
+
+    void setNormalMode() { }
+
+  private:
+
+    int m_width;
+    int m_height;
+    te::color::RGBAColor m_background;
+    std::vector<te::color::RGBAColor> m_pixels;
+};
+
+#endif  // __TERRALIB_UNITTEST_MAPTOOLS_INTERNAL_TSMEMORYCANVAS_H
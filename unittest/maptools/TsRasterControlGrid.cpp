@@ -0,0 +1,124 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+
+/*!
+  \file terralib/unittest/maptools/TsRasterControlGrid.cpp
+
+  \brief A test suite for the interpolated raster coordinates of the canvas pixels.
+ */
+
+// TerraLib
+#include <terralib/geometry/Coord2D.h>
+#include <terralib/geometry/Envelope.h>
+#include <terralib/maptools/Config.h>
+#include <terralib/maptools/RasterControlGrid.h>
+#include <terralib/raster/Grid.h>
+#include <terralib/srs/Converter.h>
+
+// Boost
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  /* The largest distance, in raster pixels, between the interpolated and the exact raster coordinates of the canvas pixels. */
+  double GetMaxError(const te::rst::Grid& canvasGrid, const te::rst::Grid& rasterGrid,
+                     const te::srs::Converter* converter, unsigned int step)
+  {
+    te::map::RasterControlGrid controlGrid(canvasGrid, rasterGrid, converter, step);
+
+    double maxError = 0.0;
+
+    for(unsigned int r = 0; r < canvasGrid.getNumberOfRows(); ++r)
+    {
+      for(unsigned int c = 0; c < canvasGrid.getNumberOfColumns(); ++c)
+      {
+        double x, y;
+
+        if(!controlGrid.get(c, r, x, y))
+          return -1.0;
+
+        te::gm::Coord2D geo = canvasGrid.gridToGeo(c, r);
+
+        if(converter)
+          converter->convert(geo.x, geo.y);
+
+        double ex, ey;
+        rasterGrid.geoToGrid(geo.x, geo.y, ex, ey);
+
+        maxError = std::max(maxError, std::max(std::abs(x - ex), std::abs(y - ey)));
+      }
+    }
+
+    return maxError;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( rasterControlGrid_tests )
+
+BOOST_AUTO_TEST_CASE( sameSRS_test )
+{
+// the canvas size is not a multiple of the steps
+  te::rst::Grid canvasGrid(301u, 203u, new te::gm::Envelope(-45.0, -23.0, -44.0, -22.3), 4326);
+
+// a rotated raster grid: the raster coordinates are still an affine function of the canvas pixels
+  const double geoTrans[] = { -45.2, 0.0011, 0.0003, -22.1, 0.0002, -0.0013 };
+
+  te::rst::Grid rasterGrid(geoTrans, 1000, 800, 4326);
+
+  const unsigned int steps[] = { 1, 7, TE_MAP_RASTER_GRID_STEP, 64 };
+
+  for(std::size_t i = 0; i < 4; ++i)
+  {
+    double maxError = GetMaxError(canvasGrid, rasterGrid, 0, steps[i]);
+
+    BOOST_CHECK_MESSAGE(maxError >= 0.0 && maxError < 1e-6, "step " << steps[i] << ", error " << maxError);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( reprojection_test )
+{
+// a 512 pixels view of about 1 degree over a UTM raster with 30 meters pixels
+  te::rst::Grid canvasGrid(512u, 512u, new te::gm::Envelope(-45.0, -23.0, -44.0, -22.0), 4326);
+
+  te::gm::Coord2D ulc(400000.0, 7570000.0);
+
+  te::rst::Grid rasterGrid(4000, 4000, 30.0, 30.0, &ulc, 32723);
+
+  te::srs::Converter converter;
+  converter.setSourcePJ4txt("+proj=longlat +ellps=WGS84 +datum=WGS84 +no_defs");
+  converter.setTargetPJ4txt("+proj=utm +zone=23 +south +ellps=WGS84 +datum=WGS84 +units=m +no_defs");
+
+// the interpolation error grows with the step but it stays far below a tenth of a raster pixel
+  double maxError = GetMaxError(canvasGrid, rasterGrid, &converter, TE_MAP_RASTER_GRID_STEP);
+
+  BOOST_CHECK(maxError >= 0.0);
+  BOOST_CHECK_MESSAGE(maxError < 0.1, "error " << maxError);
+
+  double exactError = GetMaxError(canvasGrid, rasterGrid, &converter, 1);
+
+  BOOST_CHECK(exactError >= 0.0 && exactError < 1e-6);
+  BOOST_CHECK(exactError <= maxError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,260 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+
+/*!
+  \file terralib/unittest/maptools/TsRasterTransform.cpp
+
+  \brief A test suite for the lookup tables of the raster transformations.
+ */
+
+// TerraLib
+#include <terralib/color/ColorBar.h>
+#include <terralib/datatype/Enums.h>
+#include <terralib/maptools/RasterTransform.h>
+#include <terralib/raster/BandProperty.h>
+#include <terralib/raster/Grid.h>
+#include <terralib/raster/Raster.h>
+#include <terralib/raster/RasterFactory.h>
+
+// Boost
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const unsigned int sg_nCols = 256;
+  const unsigned int sg_nRows = 8;
+  const unsigned int sg_nBands = 4;
+  const double sg_noData = 7.0;
+
+  /* The smallest value and the number of values of each band type with lookup tables. */
+  void GetRange(int type, int& first, int& size)
+  {
+    switch(type)
+    {
+      case te::dt::CHAR_TYPE:
+        first = -128;
+        size = 256;
+      break;
+
+      case te::dt::UCHAR_TYPE:
+        first = 0;
+        size = 256;
+      break;
+
+      case te::dt::INT16_TYPE:
+        first = -32768;
+        size = 65536;
+      break;
+
+      default:
+        first = 0;
+        size = 65536;
+      break;
+    }
+  }
+
+  /*
+    A memory raster whose bands go through the values of the band type.
+    The first pixel is no data in all bands and each band has other no data pixels.
+  */
+  te::rst::Raster* CreateRaster(int type)
+  {
+    std::vector<te::rst::BandProperty*> bands;
+
+    for(unsigned int b = 0; b < sg_nBands; ++b)
+    {
+      te::rst::BandProperty* band = new te::rst::BandProperty(b, type);
+      band->m_blkw = sg_nCols;
+      band->m_blkh = sg_nRows;
+      band->m_nblocksx = 1;
+      band->m_nblocksy = 1;
+      band->m_noDataValue = sg_noData;
+
+      bands.push_back(band);
+    }
+
+    std::map<std::string, std::string> rinfo;
+
+    te::rst::Raster* raster = te::rst::RasterFactory::make("MEM", new te::rst::Grid(sg_nCols, sg_nRows), bands, rinfo);
+
+    int first, size;
+    GetRange(type, first, size);
+
+    const int step = size / 256;
+
+    for(unsigned int b = 0; b < sg_nBands; ++b)
+    {
+      for(unsigned int r = 0; r < sg_nRows; ++r)
+      {
+        for(unsigned int c = 0; c < sg_nCols; ++c)
+        {
+          int i = (c * step + r * 8191 + b * 3001) % size;
+
+          raster->setValue(c, r, static_cast<double>(first + i), b);
+        }
+      }
+
+      raster->setValue(0, 0, sg_noData, b);
+      raster->setValue(b + 1, 1, sg_noData, b);
+    }
+
+    raster->setValue(0, sg_nRows - 1, static_cast<double>(first), 0);
+    raster->setValue(sg_nCols - 1, sg_nRows - 1, static_cast<double>(first + size - 1), 0);
+
+    return raster;
+  }
+
+  /* It sets all the parameters of the transformations, with a stretch that saturates part of the values. */
+  void SetParameters(te::map::RasterTransform& transform, int type)
+  {
+    int first, size;
+    GetRange(type, first, size);
+
+    const double vmin = first + size * 0.1;
+    const double vmax = first + size * 0.8;
+
+    transform.setLinearTransfParameters(vmin, vmax, 0., 255.);
+    transform.setContrastR(1.2);
+    transform.setContrastG(0.8);
+    transform.setContrastB(1.1);
+    transform.setContrastM(0.9);
+    transform.setTransparency(200.);
+
+    transform.setBChannelMapping(2, te::map::RasterTransform::RED_CHANNEL);
+    transform.setBChannelMapping(0, te::map::RasterTransform::GREEN_CHANNEL);
+    transform.setBChannelMapping(1, te::map::RasterTransform::BLUE_CHANNEL);
+    transform.setBChannelMapping(3, te::map::RasterTransform::ALPHA_CHANNEL);
+    transform.setSrcBand(1);
+
+    te::map::RasterTransform::CategorizedMap categorized;
+    categorized[te::map::RasterTransform::RasterThreshold(first, vmin)] = te::color::RGBAColor(255, 0, 0, 255);
+    categorized[te::map::RasterTransform::RasterThreshold(vmin, vmax)] = te::color::RGBAColor(0, 255, 0, 128);
+    transform.setCategorizedMap(categorized);
+
+    te::map::RasterTransform::InterpolatedMap interpolated;
+    interpolated[te::map::RasterTransform::RasterThreshold(vmin, vmax)] = te::color::ColorBar(te::color::RGBAColor(0, 0, 255, 255), te::color::RGBAColor(255, 255, 0, 255), 100);
+    transform.setInterpolatedMap(interpolated);
+
+    te::map::RasterTransform::RecodedMap recoded;
+    recoded[first] = te::color::RGBAColor(1, 2, 3, 255);
+    recoded[first + 1] = te::color::RGBAColor(4, 5, 6, 255);
+    recoded[first + size - 1] = te::color::RGBAColor(7, 8, 9, 255);
+    transform.setRecodedMap(recoded);
+  }
+
+  /* It returns the number of pixels whose lookup table color differs from the color computed by apply. */
+  int CountDifferentColors(te::map::RasterTransform& transform, te::rst::Raster& raster)
+  {
+    const std::vector<std::size_t>& bands = transform.getLUTBands();
+
+    std::vector<double> values(bands.size());
+
+    int differences = 0;
+
+    for(unsigned int r = 0; r < sg_nRows; ++r)
+    {
+      for(unsigned int c = 0; c < sg_nCols; ++c)
+      {
+        for(std::size_t b = 0; b < bands.size(); ++b)
+          raster.getValue(c, r, values[b], bands[b]);
+
+        if(!(transform.applyLUT(&values[0]) == transform.apply(c, r)))
+          ++differences;
+      }
+    }
+
+    return differences;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( rasterTransform_tests )
+
+BOOST_AUTO_TEST_CASE( lookUpTable_test )
+{
+  const int types[] = { te::dt::CHAR_TYPE, te::dt::UCHAR_TYPE, te::dt::INT16_TYPE, te::dt::UINT16_TYPE };
+
+  const te::map::RasterTransform::RasterTransfFunctions functions[] = { te::map::RasterTransform::MONO2THREE_TRANSF,
+                                                                        te::map::RasterTransform::EXTRACT2RGB_TRANSF,
+                                                                        te::map::RasterTransform::RED2THREE_TRANSF,
+                                                                        te::map::RasterTransform::GREEN2THREE_TRANSF,
+                                                                        te::map::RasterTransform::BLUE2THREE_TRANSF,
+                                                                        te::map::RasterTransform::CATEGORIZE_TRANSF,
+                                                                        te::map::RasterTransform::INTERPOLATE_TRANSF,
+                                                                        te::map::RasterTransform::RECODE_TRANSF,
+                                                                        te::map::RasterTransform::EXTRACT2RGBA_TRANSF };
+
+  const std::size_t nBands[] = { 1, 3, 1, 1, 1, 1, 1, 1, 4 };
+
+  for(std::size_t t = 0; t < 4; ++t)
+  {
+    std::auto_ptr<te::rst::Raster> raster(CreateRaster(types[t]));
+    BOOST_REQUIRE(raster.get());
+
+    for(std::size_t f = 0; f < 9; ++f)
+    {
+      te::map::RasterTransform transform(raster.get(), 0);
+
+      SetParameters(transform, types[t]);
+
+      transform.setTransfFunction(functions[f]);
+
+      BOOST_REQUIRE(transform.buildLUT());
+      BOOST_REQUIRE_EQUAL(transform.getLUTBands().size(), nBands[f]);
+
+      BOOST_CHECK_MESSAGE(CountDifferentColors(transform, *raster) == 0, "band type " << types[t] << ", transformation " << functions[f]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( lookUpTableUnsupported_test )
+{
+// the floating point bands have no lookup tables
+  std::auto_ptr<te::rst::Raster> raster(CreateRaster(te::dt::DOUBLE_TYPE));
+  BOOST_REQUIRE(raster.get());
+
+  te::map::RasterTransform transform(raster.get(), 0);
+  transform.setTransfFunction(te::map::RasterTransform::MONO2THREE_TRANSF);
+
+  BOOST_CHECK(!transform.buildLUT());
+  BOOST_CHECK(transform.getLUTBands().empty());
+
+// nor the transformations without a color function
+  std::auto_ptr<te::rst::Raster> ucharRaster(CreateRaster(te::dt::UCHAR_TYPE));
+
+  te::map::RasterTransform band2Band(ucharRaster.get(), 0);
+  band2Band.setTransfFunction(te::map::RasterTransform::BAND2BAND_TRANSF);
+
+  BOOST_CHECK(!band2Band.buildLUT());
+
+// nor a band missing in the raster
+  te::map::RasterTransform missingBand(ucharRaster.get(), 0);
+  missingBand.setTransfFunction(te::map::RasterTransform::MONO2THREE_TRANSF);
+  missingBand.setSrcBand(sg_nBands);
+
+  BOOST_CHECK(!missingBand.buildLUT());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
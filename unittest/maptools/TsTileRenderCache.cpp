@@ -0,0 +1,275 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+
+/*!
+  \file terralib/unittest/maptools/TsTileRenderCache.cpp
+
+  \brief A test suite for the tile render cache.
+ */
+
+// Unit-Test TerraLib
+#include "TsMemoryCanvas.h"
+
+// TerraLib
+#include <terralib/geometry/Envelope.h>
+#include <terralib/maptools/FolderLayer.h>
+#include <terralib/maptools/TileRenderCache.h>
+#include <terralib/maptools/Utils.h>
+
+// Boost
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+  const int sg_tileSize = 16;
+
+  te::map::Canvas* CreateCanvas(int w, int h)
+  {
+    return new TsMemoryCanvas(w, h);
+  }
+
+  /*
+    A layer that paints each tile with a color coding its column, its row and the layer version.
+    It counts the draw calls and the calls that overlap, and it may cancel a given call.
+  */
+  class TsTileLayer : public te::map::FolderLayer
+  {
+    public:
+
+      TsTileLayer(const std::string& id = "tiles")
+        : te::map::FolderLayer(id, "Tiles"),
+          m_draws(0),
+          m_running(0),
+          m_overlaps(0),
+          m_cancelAt(0)
+      {
+      }
+
+      void draw(te::map::Canvas* canvas, const te::gm::Envelope& bbox, int srid, const double& scale, bool* cancel)
+      {
+        if(++m_running > 1)
+          ++m_overlaps;
+
+        const int call = ++m_draws;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        const int col = static_cast<int>(std::floor(bbox.m_llx / sg_tileSize + 0.5));
+        const int row = static_cast<int>(std::floor(bbox.m_lly / sg_tileSize + 0.5));
+
+        canvas->setBackgroundColor(getColor(col, row));
+        canvas->clear();
+
+        if(call == m_cancelAt)
+          *cancel = true;
+
+        --m_running;
+      }
+
+      te::color::RGBAColor getColor(int col, int row) const
+      {
+        return te::color::RGBAColor(col + 8, row + 8, static_cast<int>(getVersion()) + 8 + (getId() == "tiles" ? 0 : 64), 255);
+      }
+
+      std::atomic<int> m_draws;
+      std::atomic<int> m_running;
+      std::atomic<int> m_overlaps;
+      int m_cancelAt;
+  };
+
+  /* It checks that each canvas pixel has the color of the tile that covers it (the world units are pixels). */
+  bool CheckCanvas(const TsMemoryCanvas& canvas, const te::gm::Envelope& bbox, const TsTileLayer& layer)
+  {
+    for(int y = 0; y < canvas.getHeight(); ++y)
+    {
+      for(int x = 0; x < canvas.getWidth(); ++x)
+      {
+        const int col = static_cast<int>(std::floor((bbox.m_llx + x + 0.5) / sg_tileSize));
+        const int row = static_cast<int>(std::floor((bbox.m_ury - y - 0.5) / sg_tileSize));
+
+        if(canvas.getPixel(x, y) != layer.getColor(col, row))
+          return false;
+      }
+    }
+
+    return true;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( tileRenderCache_tests )
+
+BOOST_AUTO_TEST_CASE( pan_test )
+{
+  te::map::TileRenderCache cache(CreateCanvas, sg_tileSize, 64, 4);
+  TsTileLayer layer;
+  TsMemoryCanvas canvas(2 * sg_tileSize, 2 * sg_tileSize);
+  bool cancel = false;
+
+  te::gm::Envelope bbox(0.0, 0.0, 2.0 * sg_tileSize, 2.0 * sg_tileSize);
+
+  cache.draw(&layer, &canvas, bbox, 4326, 0.0, &cancel);
+
+  BOOST_CHECK_EQUAL(layer.m_draws, 4);
+  BOOST_CHECK_EQUAL(cache.size(), 4);
+  BOOST_CHECK(CheckCanvas(canvas, bbox, layer));
+
+// the same view is composed from the cache
+  cache.draw(&layer, &canvas, bbox, 4326, 0.0, &cancel);
+
+  BOOST_CHECK_EQUAL(layer.m_draws, 4);
+
+// panning one tile to the right and one tile down only renders the tiles entering the view
+  bbox = te::gm::Envelope(sg_tileSize, -sg_tileSize, 3.0 * sg_tileSize, sg_tileSize);
+
+  cache.draw(&layer, &canvas, bbox, 4326, 0.0, &cancel);
+
+  BOOST_CHECK_EQUAL(layer.m_draws, 7);
+  BOOST_CHECK_EQUAL(cache.size(), 7);
+  BOOST_CHECK(CheckCanvas(canvas, bbox, layer));
+
+// the draw calls of a layer are serialized
+  BOOST_CHECK_EQUAL(layer.m_overlaps, 0);
+}
+
+BOOST_AUTO_TEST_CASE( version_test )
+{
+  te::map::TileRenderCache cache(CreateCanvas, sg_tileSize, 64, 4);
+  TsTileLayer layer;
+  TsMemoryCanvas canvas(4 * sg_tileSize, 4 * sg_tileSize);
+  bool cancel = false;
+
+  const te::gm::Envelope bbox(0.0, 0.0, 4.0 * sg_tileSize, 4.0 * sg_tileSize);
+
+  cache.draw(&layer, &canvas, bbox, 4326, 0.0, &cancel);
+
+  BOOST_CHECK_EQUAL(layer.m_draws, 16);
+
+// a new layer version discards the tiles of the previous one
+  layer.incrementVersion();
+
+  cache.draw(&layer, &canvas, bbox, 4326, 0.0, &cancel);
+
+  BOOST_CHECK_EQUAL(layer.m_draws, 32);
+  BOOST_CHECK_EQUAL(cache.size(), 16);
+  BOOST_CHECK(CheckCanvas(canvas, bbox, layer));
+
+// another SRS or resolution does not reuse the tiles
+  cache.draw(&layer, &canvas, bbox, 4618, 0.0, &cancel);
+
+  BOOST_CHECK_EQUAL(layer.m_draws, 48);
+
+  cache.invalidate(layer.getId());
+
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+
+  BOOST_CHECK_EQUAL(layer.m_overlaps, 0);
+}
+
+BOOST_AUTO_TEST_CASE( cancel_test )
+{
+// a single worker renders the tiles in order after the first one
+  te::map::TileRenderCache cache(CreateCanvas, sg_tileSize, 64, 1);
+  TsTileLayer layer;
+  TsMemoryCanvas canvas(2 * sg_tileSize, 2 * sg_tileSize);
+  bool cancel = false;
+
+  const te::gm::Envelope bbox(0.0, 0.0, 2.0 * sg_tileSize, 2.0 * sg_tileSize);
+
+// the third tile is cancelled while it is drawn: only the first two are kept
+  layer.m_cancelAt = 3;
+
+  BOOST_CHECK_NO_THROW(cache.draw(&layer, &canvas, bbox, 4326, 0.0, &cancel));
+
+  BOOST_CHECK(cancel);
+  BOOST_CHECK_EQUAL(layer.m_draws, 3);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+
+// the next draw renders the cancelled and the skipped tiles
+  cancel = false;
+  layer.m_cancelAt = 0;
+
+  cache.draw(&layer, &canvas, bbox, 4326, 0.0, &cancel);
+
+  BOOST_CHECK_EQUAL(layer.m_draws, 5);
+  BOOST_CHECK_EQUAL(cache.size(), 4);
+  BOOST_CHECK(CheckCanvas(canvas, bbox, layer));
+}
+
+BOOST_AUTO_TEST_CASE( drawLayers_test )
+{
+  te::map::TileRenderCache cache(CreateCanvas, sg_tileSize, 64, 4);
+  TsTileLayer* top = new TsTileLayer("top");
+  TsTileLayer* bottom = new TsTileLayer("bottom");
+  TsTileLayer* hidden = new TsTileLayer("hidden");
+
+  top->setVisibility(te::map::VISIBLE);
+  bottom->setVisibility(te::map::VISIBLE);
+
+  std::list<te::map::AbstractLayerPtr> layers;
+  layers.push_back(top);
+  layers.push_back(bottom);
+  layers.push_back(hidden);
+
+  TsMemoryCanvas canvas(2 * sg_tileSize, 2 * sg_tileSize);
+  bool cancel = false;
+
+  const te::gm::Envelope bbox(0.0, 0.0, 2.0 * sg_tileSize, 2.0 * sg_tileSize);
+
+// without a cache each visible layer is drawn once
+  te::map::DrawLayers(layers, &canvas, bbox, 4326, 0.0, &cancel);
+
+  BOOST_CHECK_EQUAL(top->m_draws, 1);
+  BOOST_CHECK_EQUAL(bottom->m_draws, 1);
+  BOOST_CHECK_EQUAL(hidden->m_draws, 0);
+
+// with a cache the visible layers are drawn in tiles and the first layer stays on top
+  te::map::DrawLayers(layers, &canvas, bbox, 4326, 0.0, &cancel, &cache);
+
+  BOOST_CHECK_EQUAL(top->m_draws, 5);
+  BOOST_CHECK_EQUAL(bottom->m_draws, 5);
+  BOOST_CHECK_EQUAL(hidden->m_draws, 0);
+  BOOST_CHECK_EQUAL(cache.size(), 8);
+  BOOST_CHECK(CheckCanvas(canvas, bbox, *top));
+
+// an export of the same view reuses the tiles rendered by the previous drawing
+  TsMemoryCanvas exported(2 * sg_tileSize, 2 * sg_tileSize);
+
+  te::map::DrawLayers(layers, &exported, bbox, 4326, 0.0, &cancel, &cache);
+
+  BOOST_CHECK_EQUAL(top->m_draws, 5);
+  BOOST_CHECK_EQUAL(bottom->m_draws, 5);
+  BOOST_CHECK(CheckCanvas(exported, bbox, *top));
+
+// a cancelled drawing does not draw the remaining layers
+  cancel = true;
+  cache.clear();
+
+  te::map::DrawLayers(layers, &canvas, bbox, 4326, 0.0, &cancel, &cache);
+
+  BOOST_CHECK_EQUAL(top->m_draws + bottom->m_draws, 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,196 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file TsColumnarDataSet.cpp
+ 
+  \brief A test suit for the Columnar DataSet class interface.
+
+ */
+
+#include "TsColumnarDataSet.h"
+#include "../Config.h"
+
+#include <terralib/dataaccess/dataset/DataSetType.h>
+#include <terralib/datatype/SimpleData.h>
+#include <terralib/datatype/SimpleProperty.h>
+#include <terralib/datatype/StringProperty.h>
+
+#include <boost/lexical_cast.hpp>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TsColumnarDataSet );
+
+void TsColumnarDataSet::FillDataSet( te::mem::ColumnarDataSet& ds, const int nItems )
+{
+  for( int i = 0 ; i < nItems ; ++i )
+  {
+    ds.addItem();
+    ds.setInt32( 0, i );
+    
+    // every tenth value is left null
+    if( i % 10 )
+      ds.setDouble( 1, i * 0.5 );
+      
+    ds.setString( 2, "n" + boost::lexical_cast< std::string >( i ) );
+    ds.setBool( 3, ( i % 2 ) == 0 );
+  }
+}
+
+static te::da::DataSetType* CreateDataSetType()
+{
+  te::da::DataSetType* dt = new te::da::DataSetType( "columnar" );
+  dt->add( new te::dt::SimpleProperty( "id", te::dt::INT32_TYPE ) );
+  dt->add( new te::dt::SimpleProperty( "val", te::dt::DOUBLE_TYPE ) );
+  dt->add( new te::dt::StringProperty( "name", te::dt::STRING ) );
+  dt->add( new te::dt::SimpleProperty( "flag", te::dt::BOOLEAN_TYPE ) );
+  return dt;
+}
+
+void TsColumnarDataSet::ReadWriteTest()
+{
+  std::auto_ptr< te::da::DataSetType > dt( CreateDataSetType() );
+  
+  te::mem::ColumnarDataSet ds( dt.get() );
+  FillDataSet( ds, 1000 );
+  
+  CPPUNIT_ASSERT( ds.size() == 1000 );
+  CPPUNIT_ASSERT( ds.getNumProperties() == 4 );
+  
+  CPPUNIT_ASSERT( ds.move( 5 ) );
+  CPPUNIT_ASSERT( ds.getInt32( 0 ) == 5 );
+  CPPUNIT_ASSERT( ds.getDouble( 1 ) == 2.5 );
+  CPPUNIT_ASSERT( ds.getString( 2 ) == "n5" );
+  CPPUNIT_ASSERT( !ds.getBool( 3 ) );
+  
+  CPPUNIT_ASSERT( ds.move( 10 ) );
+  CPPUNIT_ASSERT( ds.isNull( 1 ) );
+  CPPUNIT_ASSERT( !ds.isNull( 0 ) );
+  
+  // values are converted as te::da::DataSet does
+  std::auto_ptr< te::dt::AbstractData > value( ds.getValue( 0 ) );
+  CPPUNIT_ASSERT( value->toString() == "10" );
+  
+  ds.setValue( 0, new te::dt::Int32( 77 ) );
+  CPPUNIT_ASSERT( ds.getInt32( 0 ) == 77 );
+  
+  ds.setString( 2, "a longer value" );
+  CPPUNIT_ASSERT( ds.getString( 2 ) == "a longer value" );
+  
+  int count = 0;
+  ds.moveBeforeFirst();
+  while( ds.moveNext() )
+    ++count;
+  CPPUNIT_ASSERT( count == 1000 );
+}
+
+void TsColumnarDataSet::ColumnAccessTest()
+{
+  std::auto_ptr< te::da::DataSetType > dt( CreateDataSetType() );
+  
+  te::mem::ColumnarDataSet ds( dt.get() );
+  FillDataSet( ds, 1000 );
+  
+  CPPUNIT_ASSERT( ds.getNumNulls( 1 ) == 100 );
+  CPPUNIT_ASSERT( ds.getNulls( 1 )[ 20 ] );
+  
+  const boost::int32_t* ids = ds.getInt32Column( 0 );
+  CPPUNIT_ASSERT( ids != 0 );
+  CPPUNIT_ASSERT( ids[ 999 ] == 999 );
+  CPPUNIT_ASSERT( ds.getDoubleColumn( 1 )[ 3 ] == 1.5 );
+  
+  std::vector< double > values;
+  ds.getDoubleValues( 1, values );
+  CPPUNIT_ASSERT( values.size() == 900 );
+  CPPUNIT_ASSERT( values[ 0 ] == 0.5 );
+  
+  std::vector< std::string > names;
+  ds.getStringValues( 2, names );
+  CPPUNIT_ASSERT( names.size() == 1000 );
+  CPPUNIT_ASSERT( names[ 42 ] == "n42" );
+  
+  std::vector< std::string > ids2;
+  ds.getStringValues( 0, ids2 );
+  CPPUNIT_ASSERT( ids2[ 7 ] == "7" );
+}
+
+void TsColumnarDataSet::RemoveCompactTest()
+{
+  std::auto_ptr< te::da::DataSetType > dt( CreateDataSetType() );
+  
+  te::mem::ColumnarDataSet ds( dt.get() );
+  FillDataSet( ds, 100 );
+  
+  CPPUNIT_ASSERT( ds.move( 5 ) );
+  ds.setString( 2, "changed" );
+  ds.setNull( 2 );
+  CPPUNIT_ASSERT( ds.isNull( 2 ) );
+  
+  CPPUNIT_ASSERT( ds.move( 6 ) );
+  ds.setString( 2, "again" );
+  
+  ds.compact();
+  
+  CPPUNIT_ASSERT( ds.move( 5 ) );
+  CPPUNIT_ASSERT( ds.isNull( 2 ) );
+  CPPUNIT_ASSERT( ds.move( 6 ) );
+  CPPUNIT_ASSERT( ds.getString( 2 ) == "again" );
+  CPPUNIT_ASSERT( ds.move( 7 ) );
+  CPPUNIT_ASSERT( ds.getString( 2 ) == "n7" );
+  
+  CPPUNIT_ASSERT( ds.move( 0 ) );
+  ds.remove();
+  CPPUNIT_ASSERT( ds.size() == 99 );
+  CPPUNIT_ASSERT( ds.move( 0 ) );
+  CPPUNIT_ASSERT( ds.getInt32( 0 ) == 1 );
+  
+  ds.add( "extra", te::dt::INT16_TYPE, new te::dt::Int16( 4 ) );
+  CPPUNIT_ASSERT( ds.getNumProperties() == 5 );
+  CPPUNIT_ASSERT( ds.move( 98 ) );
+  CPPUNIT_ASSERT( ds.getInt16( 4 ) == 4 );
+  
+  ds.drop( 4 );
+  CPPUNIT_ASSERT( ds.getNumProperties() == 4 );
+}
+
+void TsColumnarDataSet::CopyTest()
+{
+  std::auto_ptr< te::da::DataSetType > dt( CreateDataSetType() );
+  
+  te::mem::ColumnarDataSet ds( dt.get() );
+  FillDataSet( ds, 100 );
+  
+  te::mem::ColumnarDataSet full( ds );
+  CPPUNIT_ASSERT( full.size() == 100 );
+  CPPUNIT_ASSERT( full.move( 50 ) );
+  CPPUNIT_ASSERT( full.getString( 2 ) == "n50" );
+  
+  std::vector< std::size_t > properties;
+  properties.push_back( 2 );
+  properties.push_back( 0 );
+  
+  ds.moveBeforeFirst();
+  
+  te::mem::ColumnarDataSet sub( ds, properties, 10 );
+  CPPUNIT_ASSERT( sub.size() == 10 );
+  CPPUNIT_ASSERT( sub.getNumProperties() == 2 );
+  CPPUNIT_ASSERT( sub.getPropertyName( 0 ) == "name" );
+  CPPUNIT_ASSERT( sub.move( 3 ) );
+  CPPUNIT_ASSERT( sub.getString( 0 ) == "n3" );
+  CPPUNIT_ASSERT( sub.getInt32( 1 ) == 3 );
+}
@@ -0,0 +1,66 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/ogc-wms/LocalCurlWrapper.h
+
+  \brief A stand-in for a WMS server that answers the GetMap requests locally.
+ */
+
+#include <terralib/ws/core/CurlWrapper.h>
+
+// STL
+#include <string>
+#include <vector>
+
+class LocalCurlWrapper : public te::ws::core::CurlWrapper
+{
+public:
+
+  LocalCurlWrapper()
+    : m_requests(0)
+  {
+  }
+
+  virtual ~LocalCurlWrapper() = default;
+
+  /*! \brief Each URL is answered with a fake image made of the URL itself, or with a service exception if it asks for it. */
+  virtual void get(const std::vector<te::core::URI>& uris,
+                   std::vector<std::string>& buffers,
+                   std::vector<long>& responseCodes,
+                   const std::size_t /*maxConnections*/)
+  {
+    buffers.resize(uris.size());
+    responseCodes.assign(uris.size(), 200);
+
+    for(std::size_t i = 0; i < uris.size(); ++i)
+    {
+      const std::string url = uris[i].uri();
+
+      if(url.find("LAYERS=missing") != std::string::npos)
+        buffers[i] = "<?xml version=\"1.0\"?><ServiceExceptionReport/>";
+      else
+        buffers[i] = "PNG:" + url;
+
+      ++m_requests;
+    }
+  }
+
+  std::size_t m_requests;  //!< The number of requests answered.
+};
@@ -0,0 +1,154 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/ogc-wms/TsCurlWrapper.cpp
+
+  \brief A test suit for the concurrent GET requests of the CurlWrapper, made against local files.
+ */
+
+// TerraLib
+#include <terralib/core/filesystem/FileSystem.h>
+#include <terralib/core/uri/URI.h>
+#include <terralib/ws/core/CurlWrapper.h>
+
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  /* The content of the i-th file: the larger ones are delivered in several write callbacks. */
+  std::string GetContent(std::size_t i)
+  {
+    std::string content = "file " + boost::lexical_cast<std::string>(i) + ":";
+
+    content.append((i % 4) * 100000 + i, static_cast<char>('a' + i % 26));
+
+    return content;
+  }
+
+  /* A directory of files to be fetched through file:// URIs. The URI at missingPos names a file that does not exist. */
+  struct LocalFiles
+  {
+    LocalFiles(std::size_t nFiles, std::size_t missingPos)
+      : m_missingPos(missingPos)
+    {
+      m_dir = te::core::FileSystem::uniquePath(te::core::FileSystem::tempDirectoryPath() + "/curl-files-%%%%-%%%%");
+
+      te::core::FileSystem::createDirectories(m_dir);
+
+      for(std::size_t i = 0; i < nFiles; ++i)
+      {
+        std::string path = m_dir + "/" + boost::lexical_cast<std::string>(i) + ".txt";
+
+        if(i != missingPos)
+        {
+          std::ofstream file(path.c_str(), std::ios::binary);
+          file << GetContent(i);
+
+          m_paths.push_back(path);
+        }
+
+        m_uris.push_back(te::core::URI("file://" + path));
+      }
+    }
+
+    ~LocalFiles()
+    {
+      for(std::size_t i = 0; i < m_paths.size(); ++i)
+        te::core::FileSystem::remove(m_paths[i]);
+
+      te::core::FileSystem::remove(m_dir);
+    }
+
+    std::string m_dir;
+    std::vector<std::string> m_paths;
+    std::size_t m_missingPos;
+    std::vector<te::core::URI> m_uris;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(curl_wrapper)
+
+BOOST_AUTO_TEST_CASE(concurrent_get_test)
+{
+  LocalFiles files(20, 13);
+
+  BOOST_REQUIRE(files.m_uris[0].isValid());
+
+  te::ws::core::CurlWrapper curl;
+
+  // fewer, as many and more connections than requests
+  const std::size_t connections[] = { 1, 3, 8, 20, 64 };
+
+  for(std::size_t c = 0; c < 5; ++c)
+  {
+    std::vector<std::string> buffers(3, "stale");
+    std::vector<long> codes;
+
+    curl.get(files.m_uris, buffers, codes, connections[c]);
+
+    BOOST_REQUIRE_EQUAL(buffers.size(), files.m_uris.size());
+    BOOST_REQUIRE_EQUAL(codes.size(), files.m_uris.size());
+
+    // each answer is written in the buffer of its request, whatever the order the transfers end
+    for(std::size_t i = 0; i < files.m_uris.size(); ++i)
+    {
+      if(i == files.m_missingPos)
+        continue;
+
+      BOOST_CHECK_MESSAGE(buffers[i] == GetContent(i), "request " << i << " with " << connections[c] << " connections");
+    }
+
+    // a failed transfer does not interrupt the others
+    BOOST_CHECK(buffers[files.m_missingPos].empty());
+    BOOST_CHECK_EQUAL(codes[files.m_missingPos], 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(empty_get_test)
+{
+  te::ws::core::CurlWrapper curl;
+
+  std::vector<te::core::URI> uris;
+  std::vector<std::string> buffers(2, "stale");
+  std::vector<long> codes(2, 200);
+
+  BOOST_CHECK_NO_THROW(curl.get(uris, buffers, codes, 8));
+
+  BOOST_CHECK(buffers.empty());
+  BOOST_CHECK(codes.empty());
+
+  // zero connections still makes the requests, one at a time
+  LocalFiles files(2, 2);
+
+  curl.get(files.m_uris, buffers, codes, 0);
+
+  BOOST_REQUIRE_EQUAL(buffers.size(), 2);
+  BOOST_CHECK(buffers[0] == GetContent(0));
+  BOOST_CHECK(buffers[1] == GetContent(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,143 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/ogc-wms/TsWMSTileCache.cpp
+
+  \brief A test suit for the tiled GetMap requests of the WMS Client.
+ */
+
+// TerraLib
+#include <terralib/core/filesystem/FileSystem.h>
+#include <terralib/ws/ogc/wms/client/WMSClient.h>
+#include <terralib/ws/ogc/wms/client/WMSTileCache.h>
+#include "LocalCurlWrapper.h"
+
+// Boost
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <memory>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(wms_tile_cache)
+
+BOOST_AUTO_TEST_CASE(memory_eviction_test)
+{
+  te::ws::ogc::wms::WMSTileCache cache("", 10, 0);
+
+  cache.put("a", "1234");
+  cache.put("b", "5678");
+
+  std::string buffer;
+
+  // "a" becomes the most recently used
+  BOOST_CHECK(cache.get("a", buffer));
+  BOOST_CHECK_EQUAL(buffer, "1234");
+
+  cache.put("c", "9012");
+
+  BOOST_CHECK_EQUAL(cache.getMemorySize(), 8);
+  BOOST_CHECK(cache.get("a", buffer));
+  BOOST_CHECK(!cache.get("b", buffer));
+  BOOST_CHECK(cache.get("c", buffer));
+
+  // larger than the whole cache
+  cache.put("d", "12345678901");
+  BOOST_CHECK(!cache.get("d", buffer));
+}
+
+BOOST_AUTO_TEST_CASE(disk_persistence_test)
+{
+  std::string dir = te::core::FileSystem::uniquePath(te::core::FileSystem::tempDirectoryPath() + "/wms-tiles-%%%%-%%%%");
+
+  {
+    te::ws::ogc::wms::WMSTileCache cache(dir, 1024, 1024);
+
+    cache.put("key1", "tile1");
+    cache.put("key2", "tile2");
+  }
+
+  {
+    // a new cache on the same directory finds the tiles of the previous one
+    te::ws::ogc::wms::WMSTileCache cache(dir, 1024, 1024);
+
+    BOOST_CHECK_EQUAL(cache.getMemorySize(), 0);
+    BOOST_CHECK_EQUAL(cache.getDiskSize(), 20);
+
+    std::string buffer;
+
+    BOOST_CHECK(cache.get("key1", buffer));
+    BOOST_CHECK_EQUAL(buffer, "tile1");
+    BOOST_CHECK(!cache.get("key3", buffer));
+
+    cache.clear();
+
+    BOOST_CHECK_EQUAL(cache.getDiskSize(), 0);
+    BOOST_CHECK(!cache.get("key2", buffer));
+  }
+
+  te::core::FileSystem::remove(dir);
+}
+
+BOOST_AUTO_TEST_CASE(getmaps_test)
+{
+  LocalCurlWrapper* server = new LocalCurlWrapper();
+
+  te::ws::ogc::WMSClient client("", "http://localhost/wms", "1.3.0");
+
+  client.setCurlWrapper(server);
+  client.setTileCache(std::shared_ptr<te::ws::ogc::wms::WMSTileCache>(new te::ws::ogc::wms::WMSTileCache()));
+
+  std::vector<te::ws::ogc::wms::WMSGetMapRequest> requests(4);
+
+  for(std::size_t i = 0; i < requests.size(); ++i)
+  {
+    requests[i].m_layers.push_back(i == 3 ? "missing" : "roads");
+    requests[i].m_boundingBox.m_minX = (double)i;
+    requests[i].m_boundingBox.m_minY = 0.0;
+    requests[i].m_boundingBox.m_maxX = (double)i + 1.0;
+    requests[i].m_boundingBox.m_maxY = 1.0;
+    requests[i].m_width = 256;
+    requests[i].m_height = 256;
+  }
+
+  std::vector<te::ws::ogc::wms::WMSGetMapResponse> responses = client.getMaps(requests);
+
+  BOOST_CHECK_EQUAL(responses.size(), 4);
+  BOOST_CHECK_EQUAL(server->m_requests, 4);
+
+  for(std::size_t i = 0; i < 3; ++i)
+  {
+    BOOST_CHECK_EQUAL(responses[i].m_buffer, "PNG:" + client.buildGetMapUrl(requests[i]));
+    BOOST_CHECK_EQUAL(responses[i].m_size, (int)responses[i].m_buffer.size());
+  }
+
+  // the service exception is not an image
+  BOOST_CHECK_EQUAL(responses[3].m_size, 0);
+
+  // only the failed tile is requested again
+  responses = client.getMaps(requests);
+
+  BOOST_CHECK_EQUAL(server->m_requests, 5);
+  BOOST_CHECK_EQUAL(responses[0].m_buffer, "PNG:" + client.buildGetMapUrl(requests[0]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,182 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+
+/*!
+  \file terralib/unittest/raster/TsPolygonScanline.cpp
+
+  \brief A test suit for the PolygonScanline class.
+ */
+
+// TerraLib
+#include <terralib/raster.h>
+#include <terralib/raster/PolygonScanline.h>
+#include <terralib/geometry.h>
+#include "../Config.h"
+
+// STL
+#include <vector>
+
+// Boost
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE (polygonScanline_tests)
+
+te::gm::LinearRing* createRing(const double* coords, std::size_t nPoints)
+{
+  te::gm::LinearRing* ring = new te::gm::LinearRing(nPoints + 1, te::gm::LineStringType);
+
+  for(std::size_t i = 0; i < nPoints; ++i)
+    ring->setPoint(i, coords[2 * i], coords[2 * i + 1]);
+
+  ring->setPoint(nPoints, coords[0], coords[1]);
+
+  return ring;
+}
+
+bool isInside(const te::gm::Polygon& polygon, double x, double y)
+{
+  bool inside = false;
+
+  for(std::size_t r = 0; r < polygon.getNumRings(); ++r)
+  {
+    const te::gm::LinearRing* ring = static_cast<const te::gm::LinearRing*>(polygon.getRingN(r));
+
+    for(std::size_t i = 0, j = ring->getNPoints() - 1; i < ring->getNPoints(); j = i++)
+    {
+      double xi = ring->getX(i), yi = ring->getY(i);
+      double xj = ring->getX(j), yj = ring->getY(j);
+
+      if(((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi) + xi))
+        inside = !inside;
+    }
+  }
+
+  return inside;
+}
+
+void checkSpans(const te::gm::Polygon& polygon, const te::rst::Grid& grid)
+{
+  te::rst::PolygonScanline scanline(polygon, grid);
+
+  std::vector<te::rst::PolygonScanline::Span> spans;
+
+  for(int row = 0; row < (int)grid.getNumberOfRows(); ++row)
+  {
+    std::vector<bool> expected(grid.getNumberOfColumns(), false);
+
+    for(unsigned int col = 0; col < grid.getNumberOfColumns(); ++col)
+    {
+      double x, y;
+      grid.gridToGeo(col, row, x, y);
+
+      expected[col] = isInside(polygon, x, y);
+    }
+
+    std::vector<bool> found(grid.getNumberOfColumns(), false);
+
+    if(row >= scanline.getFirstRow() && row <= scanline.getLastRow())
+    {
+      scanline.getSpans(row, spans);
+
+      for(std::size_t i = 0; i < spans.size(); ++i)
+      {
+        BOOST_CHECK(spans[i].first <= spans[i].second);
+
+        if(i > 0)
+          BOOST_CHECK(spans[i - 1].second < spans[i].first);
+
+        for(int col = spans[i].first; col <= spans[i].second; ++col)
+          found[col] = true;
+      }
+    }
+
+    for(unsigned int col = 0; col < grid.getNumberOfColumns(); ++col)
+      BOOST_CHECK_MESSAGE(expected[col] == found[col], "row " << row << " column " << col);
+  }
+}
+
+BOOST_AUTO_TEST_CASE (polygonScanlineRectangle_test)
+{
+  te::rst::Grid grid(10u, 10u, new te::gm::Envelope(0.0, 0.0, 10.0, 10.0), 0);
+
+  const double shell[] = { 2.2, 2.2, 7.7, 2.2, 7.7, 6.3, 2.2, 6.3 };
+
+  te::gm::Polygon polygon(0, te::gm::PolygonType);
+  polygon.push_back(createRing(shell, 4));
+
+  te::rst::PolygonScanline scanline(polygon, grid);
+
+  std::vector<te::rst::PolygonScanline::Span> spans;
+
+  BOOST_CHECK_EQUAL(scanline.getFirstRow(), 4);
+  BOOST_CHECK_EQUAL(scanline.getLastRow(), 7);
+
+  scanline.getSpans(5, spans);
+
+  BOOST_CHECK_EQUAL(spans.size(), 1);
+  BOOST_CHECK_EQUAL(spans[0].first, 2);
+  BOOST_CHECK_EQUAL(spans[0].second, 7);
+
+  checkSpans(polygon, grid);
+}
+
+BOOST_AUTO_TEST_CASE (polygonScanlineConcaveWithHole_test)
+{
+  te::rst::Grid grid(40u, 30u, new te::gm::Envelope(-3.0, -2.0, 17.0, 13.0), 0);
+
+  const double shell[] = { -1.3, -0.7, 15.1, 1.2, 9.4, 6.05, 16.2, 12.4, 0.3, 11.1, 4.7, 5.5 };
+  const double hole[] = { 7.1, 2.3, 10.2, 2.9, 8.05, 4.4 };
+
+  te::gm::Polygon polygon(0, te::gm::PolygonType);
+  polygon.push_back(createRing(shell, 6));
+  polygon.push_back(createRing(hole, 3));
+
+  checkSpans(polygon, grid);
+}
+
+BOOST_AUTO_TEST_CASE (polygonScanlineRowsOrder_test)
+{
+  te::rst::Grid grid(20u, 20u, new te::gm::Envelope(0.0, 0.0, 20.0, 20.0), 0);
+
+  const double shell[] = { 1.3, 1.1, 18.7, 4.2, 10.1, 18.9 };
+
+  te::gm::Polygon polygon(0, te::gm::PolygonType);
+  polygon.push_back(createRing(shell, 3));
+
+  te::rst::PolygonScanline scanline(polygon, grid);
+
+  std::vector<te::rst::PolygonScanline::Span> forward;
+  std::vector<te::rst::PolygonScanline::Span> backward;
+
+// rows skipped or requested again must give the same spans
+  for(int row = scanline.getLastRow(); row >= scanline.getFirstRow(); row -= 3)
+  {
+    te::rst::PolygonScanline other(polygon, grid);
+
+    for(int r = scanline.getFirstRow(); r <= row; ++r)
+      other.getSpans(r, forward);
+
+    scanline.getSpans(row, backward);
+
+    BOOST_CHECK(forward == backward);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
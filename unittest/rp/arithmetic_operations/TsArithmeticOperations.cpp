@@ -1023,4 +1023,69 @@ BOOST_AUTO_TEST_CASE(ln_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(multiThreadArithmetic_test)
+{
+  /* Load input raster as a doubles raster */
+
+  std::auto_ptr< te::rst::Raster > rin;
+  loadDoubleRaster( TERRALIB_DATA_DIR"/geotiff/cbers2b_rgb342_crop.tif",
+    rin );
+
+  /* Defining input parameters */
+
+  te::rp::ArithmeticOperations::InputParameters inputParams;
+  inputParams.m_arithmeticString = "( R0:0 + R0:1 ) * 2.5 / R0:2";
+  inputParams.m_normalize = true;
+  inputParams.m_inputRasters.push_back(rin.get());
+
+  /* Executing the algorithm with and without threads */
+
+  te::rp::ArithmeticOperations::OutputParameters serialOutputParams;
+  serialOutputParams.m_rType = "MEM";
+
+  inputParams.m_enableMultiThread = false;
+
+  te::rp::ArithmeticOperations serialInstance;
+
+  BOOST_CHECK(serialInstance.initialize(inputParams));
+  BOOST_CHECK(serialInstance.execute(serialOutputParams));
+
+  te::rp::ArithmeticOperations::OutputParameters threadedOutputParams;
+  threadedOutputParams.m_rType = "MEM";
+
+  inputParams.m_enableMultiThread = true;
+
+  te::rp::ArithmeticOperations threadedInstance;
+
+  BOOST_CHECK(threadedInstance.initialize(inputParams));
+  BOOST_CHECK(threadedInstance.execute(threadedOutputParams));
+
+  /* Both outputs must be equal */
+
+  const te::rst::Raster& serialRaster = *serialOutputParams.m_outputRasterPtr;
+  const te::rst::Raster& threadedRaster = *threadedOutputParams.m_outputRasterPtr;
+
+  BOOST_CHECK_EQUAL( serialRaster.getNumberOfBands(), threadedRaster.getNumberOfBands() );
+
+  unsigned int differentPixels = 0;
+  double serialValue = 0;
+  double threadedValue = 0;
+
+  for( unsigned int band = 0 ; band < serialRaster.getNumberOfBands() ; ++band )
+  {
+    for( unsigned int row = 0 ; row < serialRaster.getNumberOfRows() ; ++row )
+    {
+      for( unsigned int col = 0 ; col < serialRaster.getNumberOfColumns() ; ++col )
+      {
+        serialRaster.getValue( col, row, serialValue, band );
+        threadedRaster.getValue( col, row, threadedValue, band );
+
+        if( serialValue != threadedValue ) ++differentPixels;
+      }
+    }
+  }
+
+  BOOST_CHECK_EQUAL( differentPixels, 0 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
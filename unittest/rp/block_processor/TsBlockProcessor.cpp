@@ -0,0 +1,596 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/rp/block_processor/TsBlockProcessor.cpp
+
+  \brief A test suit for the BlockProcessor and ThreadPool classes.
+*/
+
+// TerraLib
+#include "../Config.h"
+#include <terralib/rp.h>
+#include <terralib/rp/BlockProcessor.h>
+#include <terralib/rp/ThreadPool.h>
+#include <terralib/raster.h>
+
+// Boost
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const unsigned int sg_nRows = 517;
+  const unsigned int sg_nCols = 333;
+
+  /* Creates a double MEM raster with the given blocking scheme. */
+
+  te::rst::Raster* CreateRaster( const unsigned int nBands, const int blkw,
+    const int blkh, const unsigned int nRows = sg_nRows, const unsigned int nCols = sg_nCols )
+  {
+    std::vector< te::rst::BandProperty* > bandsProps;
+
+    for( unsigned int bandIdx = 0 ; bandIdx < nBands ; ++bandIdx )
+    {
+      te::rst::BandProperty* bandPropPtr = new te::rst::BandProperty( bandIdx,
+        te::dt::DOUBLE_TYPE );
+      bandPropPtr->m_blkw = blkw;
+      bandPropPtr->m_blkh = blkh;
+      bandPropPtr->m_nblocksx = ( nCols + blkw - 1 ) / blkw;
+      bandPropPtr->m_nblocksy = ( nRows + blkh - 1 ) / blkh;
+      bandsProps.push_back( bandPropPtr );
+    }
+
+    std::map< std::string, std::string > rInfo;
+
+    return te::rst::RasterFactory::make( "MEM", new te::rst::Grid( nCols,
+      nRows ), bandsProps, rInfo, 0, 0 );
+  }
+
+  void FillRaster( te::rst::Raster& raster )
+  {
+    for( unsigned int band = 0 ; band < raster.getNumberOfBands() ; ++band )
+      for( unsigned int row = 0 ; row < raster.getNumberOfRows() ; ++row )
+        for( unsigned int col = 0 ; col < raster.getNumberOfColumns() ; ++col )
+          raster.setValue( col, row, std::sin( 0.1 * row + 0.37 * col + band ), band );
+  }
+
+  unsigned int CountDifferentPixels( const te::rst::Raster& raster1,
+    const te::rst::Raster& raster2 )
+  {
+    unsigned int differentPixels = 0;
+    double value1 = 0;
+    double value2 = 0;
+
+    for( unsigned int band = 0 ; band < raster1.getNumberOfBands() ; ++band )
+      for( unsigned int row = 0 ; row < raster1.getNumberOfRows() ; ++row )
+        for( unsigned int col = 0 ; col < raster1.getNumberOfColumns() ; ++col )
+        {
+          raster1.getValue( col, row, value1, band );
+          raster2.getValue( col, row, value2, band );
+
+          if( value1 != value2 ) ++differentPixels;
+        }
+
+    return differentPixels;
+  }
+
+  /* Mean over a 5x3 neighbourhood, reading only the halo window. */
+
+  bool MeanBlock( const te::rp::BlockWindow& window, te::rp::BlockContext& context )
+  {
+    const te::rst::Raster& inRaster = context.getInputRaster( 0 );
+    te::rst::Raster& outRaster = context.getOutputRaster();
+    double value = 0;
+
+    for( unsigned int band = 0 ; band < outRaster.getNumberOfBands() ; ++band )
+      for( unsigned int row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
+        for( unsigned int col = window.m_firstCol ; col < window.m_colsBound ; ++col )
+        {
+          double sum = 0;
+          unsigned int count = 0;
+
+          for( int nRow = (int)row - 2 ; nRow <= (int)row + 2 ; ++nRow )
+            for( int nCol = (int)col - 1 ; nCol <= (int)col + 1 ; ++nCol )
+            {
+              if( ( nRow >= (int)window.m_haloFirstRow ) && ( nRow < (int)window.m_haloRowsBound ) &&
+                ( nCol >= (int)window.m_haloFirstCol ) && ( nCol < (int)window.m_haloColsBound ) )
+              {
+                inRaster.getValue( nCol, nRow, value, band );
+                sum += value;
+                ++count;
+              }
+            }
+
+          outRaster.setValue( col, row, sum / (double)count, band );
+        }
+
+    return true;
+  }
+
+  /* Records the windows and the visits of each output pixel. */
+
+  struct WindowsRecorder
+  {
+    boost::mutex m_mutex;
+    std::vector< te::rp::BlockWindow > m_windows;
+    std::vector< unsigned int > m_visits;
+
+    WindowsRecorder() : m_visits( sg_nRows * sg_nCols, 0 ) {}
+
+    bool operator()( const te::rp::BlockWindow& window, te::rp::BlockContext& )
+    {
+      boost::lock_guard< boost::mutex > lock( m_mutex );
+
+      m_windows.push_back( window );
+
+      for( unsigned int row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
+        for( unsigned int col = window.m_firstCol ; col < window.m_colsBound ; ++col )
+          ++m_visits[ row * sg_nCols + col ];
+
+      return true;
+    }
+  };
+
+  /* Counts the calls, cancelling the token or failing at the given call. */
+
+  struct FailingBlock
+  {
+    enum FailureT { CancelT, ReturnFalseT, ThrowT };
+
+    std::atomic< unsigned int > m_calls;
+    unsigned int m_failAt;
+    FailureT m_failure;
+    te::rp::CancellationToken* m_tokenPtr;
+
+    FailingBlock( const unsigned int failAt, const FailureT failure,
+      te::rp::CancellationToken* tokenPtr = 0 )
+    : m_calls( 0 ), m_failAt( failAt ), m_failure( failure ), m_tokenPtr( tokenPtr ) {}
+
+    bool operator()( const te::rp::BlockWindow&, te::rp::BlockContext& )
+    {
+      if( ++m_calls != m_failAt ) return true;
+
+      switch( m_failure )
+      {
+        case CancelT :
+          m_tokenPtr->cancel();
+          return true;
+        case ReturnFalseT :
+          return false;
+        default :
+          throw std::out_of_range( "block failure" );
+      }
+    }
+  };
+
+  /* Sums the first input band, one partial sum per thread. */
+
+  struct SumBlock
+  {
+    std::vector< double > m_sums;
+    std::atomic< unsigned int > m_outputErrors;
+
+    SumBlock( const unsigned int threadsNumber ) : m_sums( threadsNumber, 0.0 ),
+      m_outputErrors( 0 ) {}
+
+    bool operator()( const te::rp::BlockWindow& window, te::rp::BlockContext& context )
+    {
+      const te::rst::Raster& inRaster = context.getInputRaster( 0 );
+      double& sum = m_sums[ context.getThreadIndex() ];
+      double value = 0;
+
+      for( unsigned int row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
+        for( unsigned int col = window.m_firstCol ; col < window.m_colsBound ; ++col )
+        {
+          inRaster.getValue( col, row, value, 0 );
+          sum += value;
+        }
+
+      try
+      {
+        context.getOutputRaster();
+      }
+      catch( ... )
+      {
+        ++m_outputErrors;
+      }
+
+      return true;
+    }
+  };
+
+  bool DoubleBlock( const te::rp::BlockWindow& window, te::rp::BlockContext& context )
+  {
+    const te::rst::Raster& inRaster = context.getInputRaster( 0 );
+    te::rst::Raster& outRaster = context.getOutputRaster();
+    double value = 0;
+
+    for( unsigned int row = window.m_firstRow ; row < window.m_rowsBound ; ++row )
+      for( unsigned int col = window.m_firstCol ; col < window.m_colsBound ; ++col )
+      {
+        inRaster.getValue( col, row, value, 0 );
+        outRaster.setValue( col, row, 2.0 * value, 0 );
+      }
+
+    return true;
+  }
+
+  /* Runs a whole threaded execution from inside the first window of another one. */
+
+  bool NestedBlock( const te::rp::BlockWindow& window, te::rp::BlockContext&,
+    te::rst::Raster* inRasterPtr, te::rst::Raster* outRasterPtr )
+  {
+    if( ( window.m_firstRow != 0 ) || ( window.m_firstCol != 0 ) ) return true;
+
+    te::rp::BlockProcessor processor;
+    processor.setOutputRaster( *outRasterPtr );
+    processor.addInputRaster( *inRasterPtr );
+    processor.setThreadsNumber( 0 );
+
+    return processor.execute( &DoubleBlock );
+  }
+
+  void RunNested( te::rst::Raster* inRasterPtr, te::rst::Raster* outRasterPtr,
+    te::rst::Raster* nestedOutRasterPtr, std::promise< bool >* resultPtr )
+  {
+    te::rp::BlockProcessor processor;
+    processor.setOutputRaster( *outRasterPtr );
+    processor.setThreadsNumber( 0 );
+
+    resultPtr->set_value( processor.execute( boost::bind( &NestedBlock, _1, _2,
+      inRasterPtr, nestedOutRasterPtr ) ) );
+  }
+
+  void CountTask( std::atomic< unsigned int >* countPtr )
+  {
+    ++( *countPtr );
+  }
+
+  void SubmitTasks( std::atomic< unsigned int >* countPtr )
+  {
+    for( unsigned int taskIdx = 0 ; taskIdx < 10 ; ++taskIdx )
+    {
+      te::rp::ThreadPool::getInstance().submit( boost::bind( &CountTask, countPtr ) );
+    }
+
+    ++( *countPtr );
+  }
+}
+
+BOOST_AUTO_TEST_SUITE (blockProcessor_tests)
+
+BOOST_AUTO_TEST_CASE(multiThreadParity_test)
+{
+  // Tiled, one line per block and blocks not dividing the raster
+
+  const int blockSizes[ 3 ][ 2 ] = { { 64, 64 }, { (int)sg_nCols, 1 }, { 50, 37 } };
+
+  for( unsigned int sizeIdx = 0 ; sizeIdx < 3 ; ++sizeIdx )
+  {
+    const int blkw = blockSizes[ sizeIdx ][ 0 ];
+    const int blkh = blockSizes[ sizeIdx ][ 1 ];
+
+    std::auto_ptr< te::rst::Raster > inRasterPtr( CreateRaster( 2, blkw, blkh ) );
+    BOOST_REQUIRE( inRasterPtr.get() );
+    FillRaster( *inRasterPtr );
+
+    std::auto_ptr< te::rst::Raster > serialRasterPtr( CreateRaster( 2, blkw, blkh ) );
+    std::auto_ptr< te::rst::Raster > threadedRasterPtr( CreateRaster( 2, blkw, blkh ) );
+
+    te::rp::BlockProcessor serialProcessor;
+    serialProcessor.setOutputRaster( *serialRasterPtr );
+    serialProcessor.addInputRaster( *inRasterPtr );
+    serialProcessor.setHalo( 2, 1 );
+    serialProcessor.setThreadsNumber( 1 );
+
+    BOOST_CHECK( serialProcessor.execute( &MeanBlock ) );
+
+    te::rp::BlockProcessor threadedProcessor;
+    threadedProcessor.setOutputRaster( *threadedRasterPtr );
+    threadedProcessor.addInputRaster( *inRasterPtr );
+    threadedProcessor.setHalo( 2, 1 );
+    threadedProcessor.setThreadsNumber( 8 );
+
+    BOOST_CHECK( threadedProcessor.execute( &MeanBlock ) );
+
+    BOOST_CHECK_EQUAL( CountDifferentPixels( *serialRasterPtr, *threadedRasterPtr ), 0 );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(haloClipping_test)
+{
+  std::auto_ptr< te::rst::Raster > inRasterPtr( CreateRaster( 1, 50, 37 ) );
+  std::auto_ptr< te::rst::Raster > outRasterPtr( CreateRaster( 1, 50, 37 ) );
+
+  const unsigned int haloRows = 3;
+  const unsigned int haloCols = 60;
+
+  WindowsRecorder recorder;
+
+  te::rp::BlockProcessor processor;
+  processor.setOutputRaster( *outRasterPtr );
+  processor.addInputRaster( *inRasterPtr );
+  processor.setHalo( haloRows, haloCols );
+
+  BOOST_CHECK( processor.execute( boost::ref( recorder ) ) );
+
+  // Each output pixel is processed once
+
+  unsigned int wrongVisits = 0;
+
+  for( unsigned int pixelIdx = 0 ; pixelIdx < recorder.m_visits.size() ; ++pixelIdx )
+  {
+    if( recorder.m_visits[ pixelIdx ] != 1 ) ++wrongVisits;
+  }
+
+  BOOST_CHECK_EQUAL( wrongVisits, 0 );
+
+  // The halo expands the windows and is clipped at the raster edges
+
+  bool firstRowWindow = false;
+  bool lastRowWindow = false;
+
+  for( unsigned int windowIdx = 0 ; windowIdx < recorder.m_windows.size() ; ++windowIdx )
+  {
+    const te::rp::BlockWindow& window = recorder.m_windows[ windowIdx ];
+
+    BOOST_CHECK_EQUAL( window.m_haloFirstRow, ( window.m_firstRow > haloRows ) ?
+      window.m_firstRow - haloRows : 0 );
+    BOOST_CHECK_EQUAL( window.m_haloRowsBound, std::min( window.m_rowsBound + haloRows,
+      sg_nRows ) );
+    BOOST_CHECK_EQUAL( window.m_haloFirstCol, ( window.m_firstCol > haloCols ) ?
+      window.m_firstCol - haloCols : 0 );
+    BOOST_CHECK_EQUAL( window.m_haloColsBound, std::min( window.m_colsBound + haloCols,
+      sg_nCols ) );
+
+    if( window.m_firstRow == 0 ) firstRowWindow = true;
+    if( window.m_rowsBound == sg_nRows ) lastRowWindow = true;
+  }
+
+  BOOST_CHECK( firstRowWindow );
+  BOOST_CHECK( lastRowWindow );
+
+  // An input raster may only be the output raster without halo
+
+  te::rp::BlockProcessor inPlaceProcessor;
+  inPlaceProcessor.setOutputRaster( *outRasterPtr );
+  inPlaceProcessor.addInputRaster( *outRasterPtr );
+  inPlaceProcessor.setHalo( 1, 0 );
+
+  BOOST_CHECK( ! inPlaceProcessor.execute( boost::ref( recorder ) ) );
+}
+
+BOOST_AUTO_TEST_CASE(cancellation_test)
+{
+  // 256x256 blocks: one window per block, 64 windows
+
+  std::auto_ptr< te::rst::Raster > outRasterPtr( CreateRaster( 1, 256, 256, 2048, 2048 ) );
+  const unsigned int windowsNumber = 64;
+
+  FailingBlock countingBlock( 0, FailingBlock::ReturnFalseT );
+
+  te::rp::BlockProcessor countingProcessor;
+  countingProcessor.setOutputRaster( *outRasterPtr );
+
+  BOOST_CHECK( countingProcessor.execute( boost::ref( countingBlock ) ) );
+  BOOST_CHECK_EQUAL( countingBlock.m_calls, windowsNumber );
+
+  // A token cancelled before the execution
+
+  te::rp::CancellationToken cancelledToken;
+  cancelledToken.cancel();
+
+  FailingBlock notCalledBlock( 0, FailingBlock::ReturnFalseT );
+
+  te::rp::BlockProcessor cancelledProcessor;
+  cancelledProcessor.setOutputRaster( *outRasterPtr );
+  cancelledProcessor.setCancellationToken( &cancelledToken );
+
+  BOOST_CHECK( ! cancelledProcessor.execute( boost::ref( notCalledBlock ) ) );
+  BOOST_CHECK_EQUAL( notCalledBlock.m_calls, 0 );
+
+  // A token cancelled by the second window: only the windows already started are processed
+
+  for( unsigned int threadsNumber = 1 ; threadsNumber <= 4 ; threadsNumber += 3 )
+  {
+    te::rp::CancellationToken token;
+    FailingBlock cancellingBlock( 2, FailingBlock::CancelT, &token );
+
+    te::rp::BlockProcessor processor;
+    processor.setOutputRaster( *outRasterPtr );
+    processor.setCancellationToken( &token );
+    processor.setThreadsNumber( threadsNumber );
+
+    BOOST_CHECK( ! processor.execute( boost::ref( cancellingBlock ) ) );
+    BOOST_CHECK( cancellingBlock.m_calls <= 1 + threadsNumber );
+
+    // A block function returning false also stops the execution
+
+    FailingBlock falseBlock( 2, FailingBlock::ReturnFalseT );
+
+    te::rp::BlockProcessor falseProcessor;
+    falseProcessor.setOutputRaster( *outRasterPtr );
+    falseProcessor.setThreadsNumber( threadsNumber );
+
+    BOOST_CHECK( ! falseProcessor.execute( boost::ref( falseBlock ) ) );
+    BOOST_CHECK( falseBlock.m_calls <= 1 + threadsNumber );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(exceptionPropagation_test)
+{
+  std::auto_ptr< te::rst::Raster > outRasterPtr( CreateRaster( 1, 256, 256, 2048, 2048 ) );
+  const unsigned int windowsNumber = 64;
+
+  // The exception thrown by a block function reaches the caller with its own type
+
+  for( unsigned int threadsNumber = 1 ; threadsNumber <= 4 ; threadsNumber += 3 )
+  {
+    FailingBlock throwingBlock( 2, FailingBlock::ThrowT );
+
+    te::rp::BlockProcessor processor;
+    processor.setOutputRaster( *outRasterPtr );
+    processor.setThreadsNumber( threadsNumber );
+
+    BOOST_CHECK_THROW( processor.execute( boost::ref( throwingBlock ) ),
+      std::out_of_range );
+    BOOST_CHECK( throwingBlock.m_calls <= 1 + threadsNumber );
+  }
+
+  // The following executions are not affected
+
+  FailingBlock block( 0, FailingBlock::ThrowT );
+
+  te::rp::BlockProcessor processor;
+  processor.setOutputRaster( *outRasterPtr );
+
+  BOOST_CHECK( processor.execute( boost::ref( block ) ) );
+  BOOST_CHECK_EQUAL( block.m_calls, windowsNumber );
+}
+
+BOOST_AUTO_TEST_CASE(reduction_test)
+{
+  std::auto_ptr< te::rst::Raster > inRasterPtr( CreateRaster( 1, 50, 37 ) );
+  FillRaster( *inRasterPtr );
+
+  double expectedSum = 0;
+  double value = 0;
+
+  for( unsigned int row = 0 ; row < sg_nRows ; ++row )
+    for( unsigned int col = 0 ; col < sg_nCols ; ++col )
+    {
+      inRasterPtr->getValue( col, row, value, 0 );
+      expectedSum += value;
+    }
+
+  // Without an output raster the windows cover the first input raster
+
+  te::rp::BlockProcessor processor;
+  processor.addInputRaster( *inRasterPtr );
+  processor.setThreadsNumber( 4 );
+
+  SumBlock sumBlock( processor.getThreadsNumber() );
+
+  BOOST_CHECK( processor.execute( boost::ref( sumBlock ) ) );
+
+  double sum = 0;
+
+  for( unsigned int threadIdx = 0 ; threadIdx < sumBlock.m_sums.size() ; ++threadIdx )
+  {
+    sum += sumBlock.m_sums[ threadIdx ];
+  }
+
+  BOOST_CHECK_CLOSE( sum, expectedSum, 1e-9 );
+  BOOST_CHECK( sumBlock.m_outputErrors > 0 );
+
+  // Nothing to process
+
+  te::rp::BlockProcessor emptyProcessor;
+
+  BOOST_CHECK( ! emptyProcessor.execute( boost::ref( sumBlock ) ) );
+}
+
+BOOST_AUTO_TEST_CASE(nestedExecution_test)
+{
+  std::auto_ptr< te::rst::Raster > inRasterPtr( CreateRaster( 1, 64, 64 ) );
+  FillRaster( *inRasterPtr );
+
+  // More executions started by the pool workers than workers, each one running another execution
+
+  const unsigned int executionsNumber = 2 * te::rp::ThreadPool::getInstance().getThreadsNumber();
+
+  std::vector< boost::shared_ptr< te::rst::Raster > > outRasters;
+  std::vector< boost::shared_ptr< te::rst::Raster > > nestedOutRasters;
+  std::vector< boost::shared_ptr< std::promise< bool > > > results;
+  std::vector< std::future< bool > > futures;
+
+  for( unsigned int executionIdx = 0 ; executionIdx < executionsNumber ; ++executionIdx )
+  {
+    outRasters.push_back( boost::shared_ptr< te::rst::Raster >( CreateRaster( 1, 64, 64 ) ) );
+    nestedOutRasters.push_back( boost::shared_ptr< te::rst::Raster >( CreateRaster( 1, 64, 64 ) ) );
+    results.push_back( boost::shared_ptr< std::promise< bool > >( new std::promise< bool > ) );
+    futures.push_back( results.back()->get_future() );
+  }
+
+  for( unsigned int executionIdx = 0 ; executionIdx < executionsNumber ; ++executionIdx )
+  {
+    te::rp::ThreadPool::getInstance().submit( boost::bind( &RunNested, inRasterPtr.get(),
+      outRasters[ executionIdx ].get(), nestedOutRasters[ executionIdx ].get(),
+      results[ executionIdx ].get() ) );
+  }
+
+  // A deadlock would keep the futures waiting
+
+  for( unsigned int executionIdx = 0 ; executionIdx < executionsNumber ; ++executionIdx )
+  {
+    BOOST_REQUIRE( futures[ executionIdx ].wait_for( std::chrono::seconds( 120 ) ) ==
+      std::future_status::ready );
+    BOOST_CHECK( futures[ executionIdx ].get() );
+  }
+
+  double inValue = 0;
+  double outValue = 0;
+  inRasterPtr->getValue( sg_nCols - 1, sg_nRows - 1, inValue, 0 );
+  nestedOutRasters.back()->getValue( sg_nCols - 1, sg_nRows - 1, outValue, 0 );
+
+  BOOST_CHECK_EQUAL( outValue, 2.0 * inValue );
+}
+
+BOOST_AUTO_TEST_CASE(threadPool_test)
+{
+  te::rp::ThreadPool& pool = te::rp::ThreadPool::getInstance();
+
+  BOOST_CHECK( pool.getThreadsNumber() > 0 );
+  BOOST_CHECK( ! pool.isWorkerThread() );
+
+  // Tasks submitted by other tasks go to the worker queue and are all executed
+
+  std::atomic< unsigned int > count( 0 );
+
+  for( unsigned int taskIdx = 0 ; taskIdx < 100 ; ++taskIdx )
+  {
+    pool.submit( boost::bind( &SubmitTasks, &count ) );
+  }
+
+  const std::chrono::steady_clock::time_point limit = std::chrono::steady_clock::now() +
+    std::chrono::seconds( 120 );
+
+  while( ( count < 1100 ) && ( std::chrono::steady_clock::now() < limit ) )
+  {
+    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+  }
+
+  BOOST_CHECK_EQUAL( count, 1100 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,9 @@
 #include <terralib/raster.h>
 #include <terralib/memory.h>
 
+// STL
+#include <cstdlib>
+
 // Boost
 #define BOOST_TEST_NO_MAIN
 #include <boost/test/unit_test.hpp>
@@ -305,6 +308,105 @@ BOOST_AUTO_TEST_CASE(MAP_test)
   delete rin;
 }
 
+BOOST_AUTO_TEST_CASE(MAP_threads_test)
+{
+  /* First open the input image */
+
+  std::map<std::string, std::string> rinfo;
+  rinfo["URI"] = TERRALIB_DATA_DIR"/geotiff/cbers2b_rgb342_crop.tif";
+
+  std::unique_ptr< te::rst::Raster > rin( te::rst::RasterFactory::open(rinfo) );
+
+  /* Defining the classes samples */
+
+  te::rp::ClassifierMAPStrategy::Parameters::ClassSamplesContainerT class1Samples;
+  class1Samples.push_back( te::rp::ClassifierMAPStrategy::Parameters::ClassSampleT( 3, 20 ) );
+  class1Samples.push_back( te::rp::ClassifierMAPStrategy::Parameters::ClassSampleT( 3, 81 ) );
+  class1Samples.push_back( te::rp::ClassifierMAPStrategy::Parameters::ClassSampleT( 3, 143 ) );
+  class1Samples[ 0 ][ 1 ] = 190;
+  class1Samples[ 1 ][ 1 ] = 226;
+  class1Samples[ 2 ][ 1 ] = 242;
+
+  te::rp::ClassifierMAPStrategy::Parameters::ClassSamplesContainerT class2Samples;
+  class2Samples.push_back( te::rp::ClassifierMAPStrategy::Parameters::ClassSampleT( 3, 255 ) );
+  class2Samples.push_back( te::rp::ClassifierMAPStrategy::Parameters::ClassSampleT( 3, 168 ) );
+  class2Samples.push_back( te::rp::ClassifierMAPStrategy::Parameters::ClassSampleT( 3, 179 ) );
+  class2Samples[ 0 ][ 2 ] = 245;
+  class2Samples[ 1 ][ 2 ] = 122;
+  class2Samples[ 2 ][ 2 ] = 153;
+
+  te::rp::ClassifierMAPStrategy::Parameters::MClassesSamplesCTPtr allClassesSamples(new te::rp::ClassifierMAPStrategy::Parameters::MClassesSamplesCT());
+  allClassesSamples->insert(te::rp::ClassifierMAPStrategy::Parameters::MClassesSamplesCT::value_type(1, class1Samples));
+  allClassesSamples->insert(te::rp::ClassifierMAPStrategy::Parameters::MClassesSamplesCT::value_type(2, class2Samples));
+
+  /* Input parameters */
+
+  te::rp::Classifier::InputParameters algoInputParameters;
+  algoInputParameters.m_inputRasterPtr = rin.get();
+  algoInputParameters.m_inputRasterBands.push_back(0);
+  algoInputParameters.m_inputRasterBands.push_back(1);
+  algoInputParameters.m_inputRasterBands.push_back(2);
+
+  te::rp::ClassifierMAPStrategy::Parameters classifierparameters;
+  classifierparameters.m_trainSamplesPtr = allClassesSamples;
+
+  algoInputParameters.m_strategyName = "map";
+  algoInputParameters.setClassifierStrategyParams(classifierparameters);
+
+  /* Single threaded execution */
+
+  te::rp::Classifier::OutputParameters singleThreadOutputParameters;
+  singleThreadOutputParameters.m_rType = "MEM";
+
+  {
+    algoInputParameters.m_enableMultiThread = false;
+
+    te::rp::Classifier algorithmInstance;
+
+    BOOST_CHECK( algorithmInstance.initialize(algoInputParameters) );
+    BOOST_CHECK( algorithmInstance.execute(singleThreadOutputParameters) );
+  }
+
+  /* Multi threaded execution */
+
+  te::rp::Classifier::OutputParameters multiThreadOutputParameters;
+  multiThreadOutputParameters.m_rType = "MEM";
+
+  {
+    algoInputParameters.m_enableMultiThread = true;
+
+    te::rp::Classifier algorithmInstance;
+
+    BOOST_CHECK( algorithmInstance.initialize(algoInputParameters) );
+    BOOST_CHECK( algorithmInstance.execute(multiThreadOutputParameters) );
+  }
+
+  /* Both label images must be equal */
+
+  const te::rst::Raster& singleThreadRaster = *singleThreadOutputParameters.m_outputRasterPtr;
+  const te::rst::Raster& multiThreadRaster = *multiThreadOutputParameters.m_outputRasterPtr;
+
+  BOOST_CHECK_EQUAL( singleThreadRaster.getNumberOfRows(), multiThreadRaster.getNumberOfRows() );
+  BOOST_CHECK_EQUAL( singleThreadRaster.getNumberOfColumns(), multiThreadRaster.getNumberOfColumns() );
+
+  double value1 = 0;
+  double value2 = 0;
+  unsigned int differentPixels = 0;
+
+  for( unsigned int row = 0 ; row < singleThreadRaster.getNumberOfRows() ; ++row )
+  {
+    for( unsigned int col = 0 ; col < singleThreadRaster.getNumberOfColumns() ; ++col )
+    {
+      singleThreadRaster.getValue( col, row, value1, 0 );
+      multiThreadRaster.getValue( col, row, value2, 0 );
+
+      if( value1 != value2 ) ++differentPixels;
+    }
+  }
+
+  BOOST_CHECK_EQUAL( differentPixels, 0 );
+}
+
 BOOST_AUTO_TEST_CASE(EM_test)
 {
   /* First open the input image */
@@ -358,6 +460,96 @@ BOOST_AUTO_TEST_CASE(EM_test)
   delete rin;
 }
 
+BOOST_AUTO_TEST_CASE(EM_threads_test)
+{
+  /* First open the input image */
+
+  std::map<std::string, std::string> rinfo;
+  rinfo["URI"] = TERRALIB_DATA_DIR"/geotiff/cbers2b_rgb342_crop.tif";
+
+  std::unique_ptr< te::rst::Raster > rin( te::rst::RasterFactory::open(rinfo) );
+
+  /* Input parameters - fixed initial means so both runs estimate the same clusters */
+
+  te::rp::Classifier::InputParameters algoInputParameters;
+  algoInputParameters.m_inputRasterPtr = rin.get();
+  algoInputParameters.m_inputRasterBands.push_back(0);
+  algoInputParameters.m_inputRasterBands.push_back(1);
+  algoInputParameters.m_inputRasterBands.push_back(2);
+
+  te::rp::ClassifierEMStrategy::Parameters classifierparameters;
+  classifierparameters.m_numberOfClusters = 3;
+  classifierparameters.m_maxIterations = 20;
+  classifierparameters.m_maxInputPoints = 500;
+  classifierparameters.m_epsilon = 15.0;
+  classifierparameters.m_clustersMeans.push_back( std::vector<double>( 3, 40.0 ) );
+  classifierparameters.m_clustersMeans.push_back( std::vector<double>( 3, 120.0 ) );
+  classifierparameters.m_clustersMeans.push_back( std::vector<double>( 3, 200.0 ) );
+
+  algoInputParameters.m_strategyName = "em";
+  algoInputParameters.setClassifierStrategyParams(classifierparameters);
+
+  /* Single threaded execution */
+
+  te::rp::Classifier::OutputParameters singleThreadOutputParameters;
+  singleThreadOutputParameters.m_rType = "MEM";
+
+  {
+    algoInputParameters.m_enableMultiThread = false;
+
+    te::rp::Classifier algorithmInstance;
+
+    srand( 1 );
+
+    BOOST_CHECK( algorithmInstance.initialize(algoInputParameters) );
+    BOOST_CHECK( algorithmInstance.execute(singleThreadOutputParameters) );
+  }
+
+  /* Multi threaded execution */
+
+  te::rp::Classifier::OutputParameters multiThreadOutputParameters;
+  multiThreadOutputParameters.m_rType = "MEM";
+
+  {
+    algoInputParameters.m_enableMultiThread = true;
+
+    te::rp::Classifier algorithmInstance;
+
+    srand( 1 );
+
+    BOOST_CHECK( algorithmInstance.initialize(algoInputParameters) );
+    BOOST_CHECK( algorithmInstance.execute(multiThreadOutputParameters) );
+  }
+
+  /* Both label images must be equal and use only the estimated clusters labels */
+
+  const te::rst::Raster& singleThreadRaster = *singleThreadOutputParameters.m_outputRasterPtr;
+  const te::rst::Raster& multiThreadRaster = *multiThreadOutputParameters.m_outputRasterPtr;
+
+  BOOST_CHECK_EQUAL( singleThreadRaster.getNumberOfRows(), multiThreadRaster.getNumberOfRows() );
+  BOOST_CHECK_EQUAL( singleThreadRaster.getNumberOfColumns(), multiThreadRaster.getNumberOfColumns() );
+
+  double value1 = 0;
+  double value2 = 0;
+  unsigned int differentPixels = 0;
+  unsigned int invalidLabels = 0;
+
+  for( unsigned int row = 0 ; row < singleThreadRaster.getNumberOfRows() ; ++row )
+  {
+    for( unsigned int col = 0 ; col < singleThreadRaster.getNumberOfColumns() ; ++col )
+    {
+      singleThreadRaster.getValue( col, row, value1, 0 );
+      multiThreadRaster.getValue( col, row, value2, 0 );
+
+      if( value1 != value2 ) ++differentPixels;
+      if( value1 > 3.0 ) ++invalidLabels;
+    }
+  }
+
+  BOOST_CHECK_EQUAL( differentPixels, 0 );
+  BOOST_CHECK_EQUAL( invalidLabels, 0 );
+}
+
 BOOST_AUTO_TEST_CASE(SAM_test)
 {
   /* First open the input image */
@@ -300,4 +300,76 @@ BOOST_AUTO_TEST_CASE(decorrelationEnhancementTContrast_test)
   BOOST_CHECK( algorithmInstance.execute( algoOutputParams ) );
 }
 
+BOOST_AUTO_TEST_CASE(multiThreadContrast_test)
+{
+  /* Open input raster */
+
+  std::map<std::string, std::string> inputRasterInfo;
+  inputRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/cbers2b_rgb342_crop.tif";
+
+  boost::shared_ptr< te::rst::Raster > inputRasterPointer( te::rst::RasterFactory::open(
+    inputRasterInfo ) );
+  BOOST_CHECK( inputRasterPointer.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::Contrast::InputParameters algoInputParams;
+
+  algoInputParams.m_type = te::rp::Contrast::InputParameters::HistogramEqualizationContrastT;
+  algoInputParams.m_hECMaxInput.resize( 3, 255 );
+  algoInputParams.m_inRasterPtr = inputRasterPointer.get();
+  algoInputParams.m_inRasterBands.push_back( 0 );
+  algoInputParams.m_inRasterBands.push_back( 1 );
+  algoInputParams.m_inRasterBands.push_back( 2 );
+
+  /* Executing the algorithm with and without threads */
+
+  te::rp::Contrast::OutputParameters serialOutputParams;
+  serialOutputParams.m_createdOutRasterDSType = "MEM";
+
+  algoInputParams.m_enableMultiThread = false;
+
+  te::rp::Contrast serialInstance;
+
+  BOOST_CHECK( serialInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( serialInstance.execute( serialOutputParams ) );
+
+  te::rp::Contrast::OutputParameters threadedOutputParams;
+  threadedOutputParams.m_createdOutRasterDSType = "MEM";
+
+  algoInputParams.m_enableMultiThread = true;
+
+  te::rp::Contrast threadedInstance;
+
+  BOOST_CHECK( threadedInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( threadedInstance.execute( threadedOutputParams ) );
+
+  /* Both outputs must be equal */
+
+  const te::rst::Raster& serialRaster = *serialOutputParams.m_createdOutRasterPtr;
+  const te::rst::Raster& threadedRaster = *threadedOutputParams.m_createdOutRasterPtr;
+
+  BOOST_CHECK_EQUAL( serialRaster.getNumberOfBands(), threadedRaster.getNumberOfBands() );
+
+  unsigned int differentPixels = 0;
+  double serialValue = 0;
+  double threadedValue = 0;
+
+  for( unsigned int band = 0 ; band < serialRaster.getNumberOfBands() ; ++band )
+  {
+    for( unsigned int row = 0 ; row < serialRaster.getNumberOfRows() ; ++row )
+    {
+      for( unsigned int col = 0 ; col < serialRaster.getNumberOfColumns() ; ++col )
+      {
+        serialRaster.getValue( col, row, serialValue, band );
+        threadedRaster.getValue( col, row, threadedValue, band );
+
+        if( serialValue != threadedValue ) ++differentPixels;
+      }
+    }
+  }
+
+  BOOST_CHECK_EQUAL( differentPixels, 0 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -354,4 +354,83 @@ BOOST_AUTO_TEST_CASE(userDefinedWindow_test)
   BOOST_CHECK( algorithmInstance.execute( algoOutputParams ) );
 }
 
+BOOST_AUTO_TEST_CASE(multiThreadFilter_test)
+{
+  /* Openning input raster */
+
+  std::map<std::string, std::string> auxRasterInfo;
+
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/cbers_rgb342_crop1.tif";
+  boost::shared_ptr< te::rst::Raster > inputRasterPtrPointer ( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( inputRasterPtrPointer.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::Filter::InputParameters algoInputParams;
+
+  algoInputParams.m_filterType = te::rp::Filter::InputParameters::MedianFilterT;
+
+  algoInputParams.m_inRasterPtr = inputRasterPtrPointer.get();
+
+  algoInputParams.m_inRasterBands.push_back( 0 );
+  algoInputParams.m_inRasterBands.push_back( 1 );
+  algoInputParams.m_inRasterBands.push_back( 2 );
+
+  algoInputParams.m_iterationsNumber = 2;
+
+  algoInputParams.m_windowH = 5;
+
+  algoInputParams.m_windowW = 5;
+
+  /* Executing the algorithm with and without threads */
+
+  te::rp::Filter::OutputParameters serialOutputParams;
+  serialOutputParams.m_rType = "MEM";
+
+  algoInputParams.m_enableMultiThread = false;
+
+  te::rp::Filter serialInstance;
+
+  BOOST_CHECK( serialInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( serialInstance.execute( serialOutputParams ) );
+
+  te::rp::Filter::OutputParameters threadedOutputParams;
+  threadedOutputParams.m_rType = "MEM";
+
+  algoInputParams.m_enableMultiThread = true;
+
+  te::rp::Filter threadedInstance;
+
+  BOOST_CHECK( threadedInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( threadedInstance.execute( threadedOutputParams ) );
+
+  /* Both outputs must be equal */
+
+  const te::rst::Raster& serialRaster = *serialOutputParams.m_outputRasterPtr;
+  const te::rst::Raster& threadedRaster = *threadedOutputParams.m_outputRasterPtr;
+
+  BOOST_CHECK_EQUAL( serialRaster.getNumberOfBands(), threadedRaster.getNumberOfBands() );
+
+  unsigned int differentPixels = 0;
+  double serialValue = 0;
+  double threadedValue = 0;
+
+  for( unsigned int band = 0 ; band < serialRaster.getNumberOfBands() ; ++band )
+  {
+    for( unsigned int row = 0 ; row < serialRaster.getNumberOfRows() ; ++row )
+    {
+      for( unsigned int col = 0 ; col < serialRaster.getNumberOfColumns() ; ++col )
+      {
+        serialRaster.getValue( col, row, serialValue, band );
+        threadedRaster.getValue( col, row, threadedValue, band );
+
+        if( serialValue != threadedValue ) ++differentPixels;
+      }
+    }
+  }
+
+  BOOST_CHECK_EQUAL( differentPixels, 0 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -172,4 +172,249 @@ BOOST_AUTO_TEST_CASE(wisper_test)
   BOOST_CHECK( algorithmInstance.execute( algoOutputParams ) );
 }
 
+BOOST_AUTO_TEST_CASE(multiThreadIhs_test)
+{
+  /* Opening input raster */
+
+  std::map<std::string, std::string> auxRasterInfo;
+
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/cbers2b_rgb342_crop.tif";
+  boost::shared_ptr< te::rst::Raster > lowResRasterPtr( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( lowResRasterPtr.get() );
+
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/cbers2b_hrc_crop.tif";
+  boost::shared_ptr< te::rst::Raster > highResRasterPtr( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( highResRasterPtr.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::IHSFusion::InputParameters algoInputParams;
+
+  algoInputParams.m_lowResRasterPtr = lowResRasterPtr.get();
+  algoInputParams.m_lowResRasterRedBandIndex = 0;
+  algoInputParams.m_lowResRasterGreenBandIndex = 1;
+  algoInputParams.m_lowResRasterBlueBandIndex = 2;
+  algoInputParams.m_highResRasterPtr = highResRasterPtr.get();
+  algoInputParams.m_highResRasterBand = 0;
+  algoInputParams.m_enableProgress = false;
+  algoInputParams.m_interpMethod = te::rst::Bilinear;
+  algoInputParams.m_RGBMin = 0;
+  algoInputParams.m_RGBMax = 0;
+
+  /* Executing the algorithm with and without threads */
+
+  te::rp::IHSFusion::OutputParameters serialOutputParams;
+  serialOutputParams.m_rType = "MEM";
+
+  algoInputParams.m_enableMultiThread = false;
+
+  te::rp::IHSFusion serialInstance;
+
+  BOOST_CHECK( serialInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( serialInstance.execute( serialOutputParams ) );
+
+  te::rp::IHSFusion::OutputParameters threadedOutputParams;
+  threadedOutputParams.m_rType = "MEM";
+
+  algoInputParams.m_enableMultiThread = true;
+
+  te::rp::IHSFusion threadedInstance;
+
+  BOOST_CHECK( threadedInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( threadedInstance.execute( threadedOutputParams ) );
+
+  /* Both outputs must be equal */
+
+  const te::rst::Raster& serialRaster = *serialOutputParams.m_outputRasterPtr;
+  const te::rst::Raster& threadedRaster = *threadedOutputParams.m_outputRasterPtr;
+
+  BOOST_CHECK_EQUAL( serialRaster.getNumberOfBands(), threadedRaster.getNumberOfBands() );
+
+  unsigned int differentPixels = 0;
+  double serialValue = 0;
+  double threadedValue = 0;
+
+  for( unsigned int band = 0 ; band < serialRaster.getNumberOfBands() ; ++band )
+  {
+    for( unsigned int row = 0 ; row < serialRaster.getNumberOfRows() ; ++row )
+    {
+      for( unsigned int col = 0 ; col < serialRaster.getNumberOfColumns() ; ++col )
+      {
+        serialRaster.getValue( col, row, serialValue, band );
+        threadedRaster.getValue( col, row, threadedValue, band );
+
+        if( serialValue != threadedValue ) ++differentPixels;
+      }
+    }
+  }
+
+  BOOST_CHECK_EQUAL( differentPixels, 0 );
+}
+
+BOOST_AUTO_TEST_CASE(multiThreadPca_test)
+{
+  /* Opening input raster */
+
+  std::map<std::string, std::string> auxRasterInfo;
+
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/cbers2b_rgb342_crop.tif";
+  boost::shared_ptr< te::rst::Raster > lowResRasterPtr( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( lowResRasterPtr.get() );
+
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/cbers2b_hrc_crop.tif";
+  boost::shared_ptr< te::rst::Raster > highResRasterPtr( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( highResRasterPtr.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::PCAFusion::InputParameters algoInputParams;
+
+  algoInputParams.m_lowResRasterPtr = lowResRasterPtr.get();
+  algoInputParams.m_lowResRasterBands.push_back( 0 );
+  algoInputParams.m_lowResRasterBands.push_back( 1 );
+  algoInputParams.m_lowResRasterBands.push_back( 2 );
+  algoInputParams.m_highResRasterPtr = highResRasterPtr.get();
+  algoInputParams.m_highResRasterBand = 0;
+  algoInputParams.m_enableProgress = false;
+  algoInputParams.m_interpMethod = te::rst::NearestNeighbor;
+
+  /* Executing the algorithm with and without threads */
+
+  te::rp::PCAFusion::OutputParameters serialOutputParams;
+  serialOutputParams.m_rType = "MEM";
+
+  algoInputParams.m_enableThreadedProcessing = false;
+
+  te::rp::PCAFusion serialInstance;
+
+  BOOST_CHECK( serialInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( serialInstance.execute( serialOutputParams ) );
+
+  te::rp::PCAFusion::OutputParameters threadedOutputParams;
+  threadedOutputParams.m_rType = "MEM";
+
+  algoInputParams.m_enableThreadedProcessing = true;
+
+  te::rp::PCAFusion threadedInstance;
+
+  BOOST_CHECK( threadedInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( threadedInstance.execute( threadedOutputParams ) );
+
+  /* Both outputs must be equal */
+
+  const te::rst::Raster& serialRaster = *serialOutputParams.m_outputRasterPtr;
+  const te::rst::Raster& threadedRaster = *threadedOutputParams.m_outputRasterPtr;
+
+  BOOST_CHECK_EQUAL( serialRaster.getNumberOfBands(), threadedRaster.getNumberOfBands() );
+
+  unsigned int differentPixels = 0;
+  double serialValue = 0;
+  double threadedValue = 0;
+
+  for( unsigned int band = 0 ; band < serialRaster.getNumberOfBands() ; ++band )
+  {
+    for( unsigned int row = 0 ; row < serialRaster.getNumberOfRows() ; ++row )
+    {
+      for( unsigned int col = 0 ; col < serialRaster.getNumberOfColumns() ; ++col )
+      {
+        serialRaster.getValue( col, row, serialValue, band );
+        threadedRaster.getValue( col, row, threadedValue, band );
+
+        if( serialValue != threadedValue ) ++differentPixels;
+      }
+    }
+  }
+
+  BOOST_CHECK_EQUAL( differentPixels, 0 );
+}
+
+BOOST_AUTO_TEST_CASE(multiThreadWisper_test)
+{
+  /* Opening input raster */
+
+  std::map<std::string, std::string> auxRasterInfo;
+
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/cbers2b_rgb342_crop.tif";
+  boost::shared_ptr< te::rst::Raster > lowResRasterPtr( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( lowResRasterPtr.get() );
+
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/cbers2b_hrc_crop.tif";
+  boost::shared_ptr< te::rst::Raster > highResRasterPtr( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( highResRasterPtr.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::WisperFusion::InputParameters algoInputParams;
+
+  algoInputParams.m_lowResRasterPtr = lowResRasterPtr.get();
+  algoInputParams.m_lowResRasterBands.push_back( 0 );
+  algoInputParams.m_lowResRasterBands.push_back( 1 );
+  algoInputParams.m_lowResRasterBands.push_back( 2 );
+  algoInputParams.m_lowResRasterBandSensors.push_back( te::rp::srf::CBERS2BCCDB3Sensor );
+  algoInputParams.m_lowResRasterBandSensors.push_back( te::rp::srf::CBERS2BCCDB4Sensor );
+  algoInputParams.m_lowResRasterBandSensors.push_back( te::rp::srf::CBERS2BCCDB2Sensor );
+  algoInputParams.m_highResRasterPtr = highResRasterPtr.get();
+  algoInputParams.m_highResRasterBand = 0;
+  algoInputParams.m_hiResRasterBandSensor = te::rp::srf::CBERS2BCCDB5PANSensor;
+  algoInputParams.m_hiResRasterWaveletLevels = 0;
+  algoInputParams.m_enableProgress = false;
+  algoInputParams.m_interpMethod = te::rst::NearestNeighbor;
+  algoInputParams.m_waveletFilterType = te::rp::TriangleWAFilter;
+
+  /* Executing the algorithm with and without threads */
+
+  te::rp::WisperFusion::OutputParameters serialOutputParams;
+  serialOutputParams.m_rType = "MEM";
+
+  algoInputParams.m_enableMultiThread = false;
+
+  te::rp::WisperFusion serialInstance;
+
+  BOOST_CHECK( serialInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( serialInstance.execute( serialOutputParams ) );
+
+  te::rp::WisperFusion::OutputParameters threadedOutputParams;
+  threadedOutputParams.m_rType = "MEM";
+
+  algoInputParams.m_enableMultiThread = true;
+
+  te::rp::WisperFusion threadedInstance;
+
+  BOOST_CHECK( threadedInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( threadedInstance.execute( threadedOutputParams ) );
+
+  /* Both outputs must be equal */
+
+  const te::rst::Raster& serialRaster = *serialOutputParams.m_outputRasterPtr;
+  const te::rst::Raster& threadedRaster = *threadedOutputParams.m_outputRasterPtr;
+
+  BOOST_CHECK_EQUAL( serialRaster.getNumberOfBands(), threadedRaster.getNumberOfBands() );
+
+  unsigned int differentPixels = 0;
+  double serialValue = 0;
+  double threadedValue = 0;
+
+  for( unsigned int band = 0 ; band < serialRaster.getNumberOfBands() ; ++band )
+  {
+    for( unsigned int row = 0 ; row < serialRaster.getNumberOfRows() ; ++row )
+    {
+      for( unsigned int col = 0 ; col < serialRaster.getNumberOfColumns() ; ++col )
+      {
+        serialRaster.getValue( col, row, serialValue, band );
+        threadedRaster.getValue( col, row, threadedValue, band );
+
+        if( serialValue != threadedValue ) ++differentPixels;
+      }
+    }
+  }
+
+  BOOST_CHECK_EQUAL( differentPixels, 0 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
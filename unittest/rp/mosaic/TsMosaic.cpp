@@ -104,6 +104,75 @@ BOOST_AUTO_TEST_CASE(geoReferencedImagesMosaic_test)
   BOOST_CHECK( algorithmInstance.execute( algoOutputParams ) );
 }
 
+BOOST_AUTO_TEST_CASE(geoReferencedImagesTiledMosaic_test)
+{
+  /* Openning input rasters */
+  
+  std::map<std::string, std::string> auxRasterInfo;
+  
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/L5219075_07520040503_r3g2b1.tif";
+  boost::shared_ptr< te::rst::Raster > inputRaster1Pointer ( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( inputRaster1Pointer.get() );
+  
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/L5219076_07620040908_r3g2b1.tif";
+  boost::shared_ptr< te::rst::Raster > inputRaster2Pointer ( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( inputRaster2Pointer.get() );
+  
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/L71218075_07520070614_r3g2b1.tif";
+  boost::shared_ptr< te::rst::Raster > inputRaster3Pointer ( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( inputRaster3Pointer.get() );
+  
+  auxRasterInfo["URI"] = TERRALIB_DATA_DIR "/geotiff/L71218076_07620060814_r3g2b1.tif";
+  boost::shared_ptr< te::rst::Raster > inputRaster4Pointer ( te::rst::RasterFactory::open(
+    auxRasterInfo ) );
+  BOOST_CHECK( inputRaster4Pointer.get() );
+  
+  /* Creating the algorithm parameters */
+  
+  te::rp::GeoMosaic::InputParameters algoInputParams;
+  
+  std::vector< const te::rst::Raster* > rasters;
+  rasters.push_back( inputRaster1Pointer.get() );
+  rasters.push_back( inputRaster2Pointer.get() );
+  rasters.push_back( inputRaster3Pointer.get() );
+  rasters.push_back( inputRaster4Pointer.get() );
+  te::rp::FeederConstRasterVector feeder( rasters );
+  algoInputParams.m_feederRasterPtr = &feeder;
+  
+  std::vector< unsigned int > bands;
+  bands.push_back( 0 );
+  bands.push_back( 1 );
+  bands.push_back( 2 );
+  algoInputParams.m_inputRastersBands.push_back( bands );
+  algoInputParams.m_inputRastersBands.push_back( bands );
+  algoInputParams.m_inputRastersBands.push_back( bands );
+  algoInputParams.m_inputRastersBands.push_back( bands );
+  
+  algoInputParams.m_interpMethod = te::rst::NearestNeighbor;
+  algoInputParams.m_noDataValue = 0;
+  algoInputParams.m_forceInputNoDataValue = true;
+  algoInputParams.m_blendMethod = te::rp::Blender::NoBlendMethod;
+  algoInputParams.m_autoEqualize = true;
+  algoInputParams.m_executionMode = te::rp::GeoMosaic::TiledCompositionMode;
+  algoInputParams.m_priorityRule = te::rp::GeoMosaic::SeamlinePriorityRule;
+
+  te::rp::GeoMosaic::OutputParameters algoOutputParams;
+  
+  algoOutputParams.m_rInfo["URI"] =
+    "terralib_unittest_rp_Mosaic_GeoReferencedImagesTiledMosaic_Test.tif";
+  algoOutputParams.m_rType = "GDAL";
+  
+  /* Executing the algorithm */
+  
+  te::rp::GeoMosaic algorithmInstance;
+  
+  BOOST_CHECK( algorithmInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( algorithmInstance.execute( algoOutputParams ) );
+}
+
 BOOST_AUTO_TEST_CASE(geoReferencedImagesMosaicWithReprojection_test)
 {
   /* Openning input rasters */
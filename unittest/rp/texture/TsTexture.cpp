@@ -33,6 +33,10 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/shared_ptr.hpp>
 
+// STL
+#include <algorithm>
+#include <cmath>
+
 BOOST_AUTO_TEST_SUITE (texture_tests)
 
 BOOST_AUTO_TEST_CASE(GLCM_test)
@@ -70,4 +74,50 @@ BOOST_AUTO_TEST_CASE(GLCM_test)
   delete rin;
 }
 
+BOOST_AUTO_TEST_CASE(multiThreadGLCM_test)
+{
+  /* First open the input image */
+
+  std::map<std::string, std::string> rinfo;
+  rinfo["URI"] = TERRALIB_DATA_DIR"/geotiff/cbers2b_rgb342_crop.tif";
+  boost::shared_ptr< te::rst::Raster > rin( te::rst::RasterFactory::open(rinfo) );
+  BOOST_CHECK( rin.get() );
+
+  double maxPixel, minPixel;
+  te::rst::GetDataTypeRanges(rin->getBandDataType(1), minPixel, maxPixel);
+
+  /* The GLCMs computed with and without threads must be equal, for several displacements and gray levels */
+
+  const int displacements[ 4 ][ 2 ] = { { 1, 0 }, { 0, 1 }, { -1, 1 }, { 2, -3 } };
+
+  te::rp::RasterAttributes serialAttributes;
+  serialAttributes.setEnableMultiThread(false);
+
+  te::rp::RasterAttributes threadedAttributes;
+  threadedAttributes.setEnableMultiThread(true);
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    for (unsigned int gLevels = 16; gLevels <= 256; gLevels *= 16)
+    {
+      boost::numeric::ublas::matrix<double> serialGLCM = serialAttributes.getGLCM(*rin, 1,
+        displacements[i][0], displacements[i][1], minPixel, maxPixel, gLevels);
+      boost::numeric::ublas::matrix<double> threadedGLCM = threadedAttributes.getGLCM(*rin, 1,
+        displacements[i][0], displacements[i][1], minPixel, maxPixel, gLevels);
+
+      BOOST_REQUIRE_EQUAL(serialGLCM.size1(), threadedGLCM.size1());
+      BOOST_REQUIRE_EQUAL(serialGLCM.size2(), threadedGLCM.size2());
+
+      double maxDifference = 0.0;
+
+      for (unsigned int r = 0; r < serialGLCM.size1(); ++r)
+        for (unsigned int c = 0; c < serialGLCM.size2(); ++c)
+          maxDifference = std::max(maxDifference, std::abs(serialGLCM(r, c) - threadedGLCM(r, c)));
+
+      // the partial matrices of the threads are summed in another order
+      BOOST_CHECK(maxDifference < 1e-12);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
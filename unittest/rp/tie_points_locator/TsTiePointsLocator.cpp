@@ -33,6 +33,9 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/shared_ptr.hpp>
 
+// STL
+#include <cmath>
+
 BOOST_AUTO_TEST_SUITE (tiePointsLocator_tests)
 
 void saveImagesAndTiePoints(
@@ -120,6 +123,78 @@ void saveImagesAndTiePoints(
   }
 }
 
+void checkKDForestBruteForceAgreement(
+  const te::rp::TiePointsLocator::InputParameters& inputParams,
+  const unsigned int kdForestMaxChecks,
+  const double kdForestMaxDistanceRatio,
+  const double minTiePointsNumberRatio )
+{
+  /* Brute force matching */
+
+  te::rp::TiePointsLocator::InputParameters bruteForceInputParams = inputParams;
+  bruteForceInputParams.m_featuresMatchingMethod =
+    te::rp::TiePointsLocator::InputParameters::BruteForceFeaturesMatchingMethod;
+
+  te::rp::TiePointsLocator::OutputParameters bruteForceOutputParams;
+
+  te::rp::TiePointsLocator bruteForceInstance;
+
+  BOOST_REQUIRE( bruteForceInstance.initialize( bruteForceInputParams ) );
+  BOOST_REQUIRE( bruteForceInstance.execute( bruteForceOutputParams ) );
+  BOOST_REQUIRE( bruteForceOutputParams.m_transformationPtr.get() );
+  BOOST_REQUIRE( ! bruteForceOutputParams.m_tiePoints.empty() );
+
+  /* KD-Forest matching */
+
+  te::rp::TiePointsLocator::InputParameters kdForestInputParams = inputParams;
+  kdForestInputParams.m_featuresMatchingMethod =
+    te::rp::TiePointsLocator::InputParameters::KDForestFeaturesMatchingMethod;
+  kdForestInputParams.m_kdForestMaxChecks = kdForestMaxChecks;
+  kdForestInputParams.m_kdForestMaxDistanceRatio = kdForestMaxDistanceRatio;
+
+  te::rp::TiePointsLocator::OutputParameters kdForestOutputParams;
+
+  te::rp::TiePointsLocator kdForestInstance;
+
+  BOOST_REQUIRE( kdForestInstance.initialize( kdForestInputParams ) );
+  BOOST_REQUIRE( kdForestInstance.execute( kdForestOutputParams ) );
+  BOOST_REQUIRE( kdForestOutputParams.m_transformationPtr.get() );
+
+  /* Both matchers must find about the same number of tie-points */
+
+  BOOST_CHECK_MESSAGE( ((double)kdForestOutputParams.m_tiePoints.size()) >=
+    ( minTiePointsNumberRatio * ((double)bruteForceOutputParams.m_tiePoints.size()) ),
+    "KD-Forest tie-points:" << kdForestOutputParams.m_tiePoints.size() <<
+    " Brute force tie-points:" << bruteForceOutputParams.m_tiePoints.size() );
+
+  /* The KD-Forest tie-points must agree with the brute force transformation
+     (each set was filtered using m_geomTransfMaxError over its own transformation) */
+
+  const double maxError = 2.0 * inputParams.m_geomTransfMaxError;
+  unsigned int disagreeingTiePointsNumber = 0;
+  double mappedX = 0;
+  double mappedY = 0;
+
+  for( unsigned int tpIdx = 0 ; tpIdx < kdForestOutputParams.m_tiePoints.size() ;
+    ++tpIdx )
+  {
+    const te::gm::GTParameters::TiePoint& tiePoint =
+      kdForestOutputParams.m_tiePoints[ tpIdx ];
+
+    bruteForceOutputParams.m_transformationPtr->directMap( tiePoint.first.x,
+      tiePoint.first.y, mappedX, mappedY );
+
+    if( std::sqrt( ( ( mappedX - tiePoint.second.x ) * ( mappedX - tiePoint.second.x ) ) +
+      ( ( mappedY - tiePoint.second.y ) * ( mappedY - tiePoint.second.y ) ) ) > maxError )
+    {
+      ++disagreeingTiePointsNumber;
+    }
+  }
+
+  BOOST_CHECK_MESSAGE( disagreeingTiePointsNumber == 0, "Disagreeing KD-Forest tie-points:"
+    << disagreeingTiePointsNumber << " of " << kdForestOutputParams.m_tiePoints.size() );
+}
+
 BOOST_AUTO_TEST_CASE(moravecStrategySameImage_test)
 {
   /* Openning input raster */
@@ -422,6 +497,101 @@ BOOST_AUTO_TEST_CASE(moravecStrategyMultipleThreads_test)
   BOOST_CHECK( algoOutputParams.m_tiePoints.size() >= (size_t)700 );
 }
 
+BOOST_AUTO_TEST_CASE(moravecStrategyKDForestMatching_test)
+{
+  /* Openning input raster */
+
+  std::map<std::string, std::string> inputRasterInfo;
+  inputRasterInfo["URI"] = TERRALIB_DATA_DIR
+    "/geotiff/cbers_b2_crop.tif";
+
+  boost::shared_ptr< te::rst::Raster > inputRasterPointer ( te::rst::RasterFactory::open(
+    inputRasterInfo ) );
+  BOOST_CHECK( inputRasterPointer.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::TiePointsLocatorMoravecStrategy::Parameters specPars;
+
+  te::rp::TiePointsLocator::InputParameters algoInputParams;
+  algoInputParams.m_interesPointsLocationStrategyName = "Moravec";
+  algoInputParams.m_inRaster1Ptr = inputRasterPointer.get();
+  algoInputParams.m_inRaster1Bands.push_back( 0 );
+  algoInputParams.m_inRaster2Ptr = inputRasterPointer.get();
+  algoInputParams.m_inRaster2Bands.push_back( 0 );
+  algoInputParams.m_enableMultiThread = true;
+  algoInputParams.m_maxTiePoints = 1000;
+  algoInputParams.m_geomTransfName = "RST";
+  algoInputParams.m_featuresMatchingMethod = 
+    te::rp::TiePointsLocator::InputParameters::KDForestFeaturesMatchingMethod;
+  algoInputParams.setSpecStrategyParams( specPars );
+
+  te::rp::TiePointsLocator::OutputParameters algoOutputParams;
+
+  /* Executing the algorithm */
+
+  te::rp::TiePointsLocator algorithmInstance;
+
+  BOOST_CHECK( algorithmInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( algorithmInstance.execute( algoOutputParams ) );
+
+  /* Saving images and tie-points */
+
+  saveImagesAndTiePoints( *inputRasterPointer, 0, *inputRasterPointer, 0,
+    algoOutputParams.m_tiePoints, "terralib_rp_tiepointslocator_test_MoravecStrategyKDForestMatching" );
+
+  BOOST_CHECK( algoOutputParams.m_tiePoints.size() >= (size_t)700 );
+}
+
+BOOST_AUTO_TEST_CASE(moravecStrategyKDForestBruteForceAgreement_test)
+{
+  /* Openning input rasters */
+
+  std::map<std::string, std::string> inputRasterInfo;
+  inputRasterInfo["URI"] = TERRALIB_DATA_DIR
+    "/geotiff/cbers_b2_crop.tif";
+
+  boost::shared_ptr< te::rst::Raster > inputRasterPointer ( te::rst::RasterFactory::open(
+    inputRasterInfo ) );
+  BOOST_REQUIRE( inputRasterPointer.get() );
+
+  std::map<std::string, std::string> inputRaster2Info;
+  inputRaster2Info["URI"] = TERRALIB_DATA_DIR
+    "/geotiff/cbers_b2_crop_upsampled.tif";
+
+  boost::shared_ptr< te::rst::Raster > inputRaster2Pointer ( te::rst::RasterFactory::open(
+    inputRaster2Info ) );
+  BOOST_REQUIRE( inputRaster2Pointer.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::TiePointsLocatorMoravecStrategy::Parameters specPars;
+
+  te::rp::TiePointsLocator::InputParameters algoInputParams;
+  algoInputParams.m_interesPointsLocationStrategyName = "Moravec";
+  algoInputParams.m_inRaster1Ptr = inputRasterPointer.get();
+  algoInputParams.m_inRaster1Bands.push_back( 0 );
+  algoInputParams.m_inRaster2Ptr = inputRaster2Pointer.get();
+  algoInputParams.m_inRaster2Bands.push_back( 0 );
+  algoInputParams.m_enableMultiThread = true;
+  algoInputParams.m_maxTiePoints = 1000;
+  algoInputParams.m_pixelSizeXRelation = inputRasterPointer->getResolutionX() /
+   inputRaster2Pointer->getResolutionX();
+  algoInputParams.m_pixelSizeYRelation = inputRasterPointer->getResolutionY() /
+   inputRaster2Pointer->getResolutionY();
+  algoInputParams.m_geomTransfName = "RST";
+  algoInputParams.setSpecStrategyParams( specPars );
+
+  /* Exact search without the ratio test: each brute force match is also a KD-Forest match */
+
+  checkKDForestBruteForceAgreement( algoInputParams, 0, 1.0, 0.9 );
+
+  /* Default approximate search: the ratio test discards the ambiguous matches,
+     only the agreement of the remaining tie-points is checked */
+
+  checkKDForestBruteForceAgreement( algoInputParams, 256, 0.8, 0.0 );
+}
+
 BOOST_AUTO_TEST_CASE(moravecStrategyRescaleFactor_test)
 {
   /* Openning input raster */
@@ -769,6 +939,101 @@ BOOST_AUTO_TEST_CASE(surfStrategyMultipleThreads_test)
   BOOST_CHECK( algoOutputParams.m_tiePoints.size() >= (size_t)400 );
 }
 
+BOOST_AUTO_TEST_CASE(surfStrategyKDForestMatching_test)
+{
+  /* Openning input raster */
+
+  std::map<std::string, std::string> inputRasterInfo;
+  inputRasterInfo["URI"] = TERRALIB_DATA_DIR
+    "/geotiff/cbers_b2_crop.tif";
+
+  boost::shared_ptr< te::rst::Raster > inputRasterPointer ( te::rst::RasterFactory::open(
+    inputRasterInfo ) );
+  BOOST_CHECK( inputRasterPointer.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::TiePointsLocatorSURFStrategy::Parameters specPars;
+
+  te::rp::TiePointsLocator::InputParameters algoInputParams;
+  algoInputParams.m_interesPointsLocationStrategyName = "SURF";
+  algoInputParams.m_inRaster1Ptr = inputRasterPointer.get();
+  algoInputParams.m_inRaster1Bands.push_back( 0 );
+  algoInputParams.m_inRaster2Ptr = inputRasterPointer.get();
+  algoInputParams.m_inRaster2Bands.push_back( 0 );
+  algoInputParams.m_enableMultiThread = true;
+  algoInputParams.m_maxTiePoints = 2000;
+  algoInputParams.m_geomTransfName = "RST";
+  algoInputParams.m_featuresMatchingMethod = 
+    te::rp::TiePointsLocator::InputParameters::KDForestFeaturesMatchingMethod;
+  algoInputParams.setSpecStrategyParams( specPars );
+
+  te::rp::TiePointsLocator::OutputParameters algoOutputParams;
+
+  /* Executing the algorithm */
+
+  te::rp::TiePointsLocator algorithmInstance;
+
+  BOOST_CHECK( algorithmInstance.initialize( algoInputParams ) );
+  BOOST_CHECK( algorithmInstance.execute( algoOutputParams ) );
+
+  /* Saving images and tie-points */
+
+  saveImagesAndTiePoints( *inputRasterPointer, 0, *inputRasterPointer, 0,
+    algoOutputParams.m_tiePoints, "terralib_rp_tiepointslocator_test_SurfStrategyKDForestMatching" );
+
+  BOOST_CHECK( algoOutputParams.m_tiePoints.size() >= (size_t)400 );
+}
+
+BOOST_AUTO_TEST_CASE(surfStrategyKDForestBruteForceAgreement_test)
+{
+  /* Openning input rasters */
+
+  std::map<std::string, std::string> inputRasterInfo;
+  inputRasterInfo["URI"] = TERRALIB_DATA_DIR
+    "/geotiff/cbers_b2_crop.tif";
+
+  boost::shared_ptr< te::rst::Raster > inputRasterPointer ( te::rst::RasterFactory::open(
+    inputRasterInfo ) );
+  BOOST_REQUIRE( inputRasterPointer.get() );
+
+  std::map<std::string, std::string> inputRaster2Info;
+  inputRaster2Info["URI"] = TERRALIB_DATA_DIR
+    "/geotiff/cbers_b2_crop_upsampled.tif";
+
+  boost::shared_ptr< te::rst::Raster > inputRaster2Pointer ( te::rst::RasterFactory::open(
+    inputRaster2Info ) );
+  BOOST_REQUIRE( inputRaster2Pointer.get() );
+
+  /* Creating the algorithm parameters */
+
+  te::rp::TiePointsLocatorSURFStrategy::Parameters specPars;
+
+  te::rp::TiePointsLocator::InputParameters algoInputParams;
+  algoInputParams.m_interesPointsLocationStrategyName = "SURF";
+  algoInputParams.m_inRaster1Ptr = inputRasterPointer.get();
+  algoInputParams.m_inRaster1Bands.push_back( 0 );
+  algoInputParams.m_inRaster2Ptr = inputRaster2Pointer.get();
+  algoInputParams.m_inRaster2Bands.push_back( 0 );
+  algoInputParams.m_enableMultiThread = true;
+  algoInputParams.m_maxTiePoints = 2000;
+  algoInputParams.m_pixelSizeXRelation = inputRasterPointer->getResolutionX() /
+   inputRaster2Pointer->getResolutionX();
+  algoInputParams.m_pixelSizeYRelation = inputRasterPointer->getResolutionY() /
+   inputRaster2Pointer->getResolutionY();
+  algoInputParams.m_geomTransfName = "RST";
+  algoInputParams.setSpecStrategyParams( specPars );
+
+  /* Exact search without the ratio test: each brute force match is also a KD-Forest match */
+
+  checkKDForestBruteForceAgreement( algoInputParams, 0, 1.0, 0.9 );
+
+  /* Default approximate search: the ratio test discards the ambiguous matches,
+     only the agreement of the remaining tie-points is checked */
+
+  checkKDForestBruteForceAgreement( algoInputParams, 256, 0.8, 0.0 );
+}
+
 BOOST_AUTO_TEST_CASE(surfStrategyRescaleFactor_test)
 {
   /* Openning input raster */
@@ -24,8 +24,19 @@
 
  */
 
+// TerraLib
+#include <terralib/core/utils/Platform.h>
+#include <terralib/srs/Exception.h>
+#include <terralib/srs/SpatialReferenceSystemCatalog.h>
+#include <terralib/srs/SpatialReferenceSystemManager.h>
+
+// STL
+#include <atomic>
+
 // Boost
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 
 BOOST_AUTO_TEST_SUITE( srs_tests )
 
@@ -34,4 +45,133 @@ BOOST_AUTO_TEST_CASE( createSrs_test )
   /* Create tests here */
 }
 
+BOOST_AUTO_TEST_CASE( srsCatalog_test )
+{
+  std::string jsonf = te::core::FindInTerraLibPath("share/terralib/json/srs_incomplete.json");
+  BOOST_REQUIRE(!jsonf.empty());
+
+  std::string catalogf = (boost::filesystem::temp_directory_path() / "terralib_unittest_srs.bin").string();
+
+  BOOST_CHECK_NO_THROW(te::srs::SpatialReferenceSystemCatalog::build(jsonf, catalogf));
+  BOOST_CHECK(te::srs::SpatialReferenceSystemCatalog::isCatalog(catalogf));
+  BOOST_CHECK(!te::srs::SpatialReferenceSystemCatalog::isCatalog(jsonf));
+
+  {
+    te::srs::SpatialReferenceSystemCatalog catalog(catalogf);
+
+    std::size_t pos = catalog.find(TE_SRS_WGS84, "EPSG");
+    BOOST_REQUIRE(pos != te::srs::SpatialReferenceSystemCatalog::npos);
+    BOOST_CHECK(catalog.getId(pos) == TE_SRS_WGS84);
+    BOOST_CHECK(catalog.getAuthName(pos) == "EPSG");
+    BOOST_CHECK(catalog.getP4Txt(pos).find("+proj=longlat") != std::string::npos);
+    BOOST_CHECK(catalog.findByName(catalog.getName(pos)) != te::srs::SpatialReferenceSystemCatalog::npos);
+    BOOST_CHECK(catalog.find(TE_SRS_WGS84, "USER") == te::srs::SpatialReferenceSystemCatalog::npos);
+
+// the manager gives the same answers from the catalog and from the JSON file
+    te::srs::SpatialReferenceSystemManager& manager = te::srs::SpatialReferenceSystemManager::getInstance();
+
+    manager.init(jsonf);
+    std::string p4txt = manager.getP4Txt(TE_SRS_SAD69);
+    std::string wkt = manager.getWkt(TE_SRS_SAD69);
+    std::size_t size = manager.size();
+
+    manager.init(catalogf);
+    BOOST_CHECK(manager.size() == size);
+    BOOST_CHECK(manager.size() == catalog.size());
+    BOOST_CHECK(manager.getP4Txt(TE_SRS_SAD69) == p4txt);
+    BOOST_CHECK(manager.getWkt(TE_SRS_SAD69) == wkt);
+    BOOST_CHECK(manager.getIdFromP4Txt(p4txt).second == TE_SRS_SAD69);
+
+    BOOST_CHECK_THROW(manager.add("WGS 84", "", "", TE_SRS_WGS84), te::srs::Exception);
+
+    manager.clear();
+  }
+
+  boost::filesystem::remove(catalogf);
+}
+
+BOOST_AUTO_TEST_CASE( srsIterators_test )
+{
+  std::string jsonf = te::core::FindInTerraLibPath("share/terralib/json/srs_incomplete.json");
+  BOOST_REQUIRE(!jsonf.empty());
+
+  std::string catalogf = (boost::filesystem::temp_directory_path() / "terralib_unittest_srs_iterators.bin").string();
+  BOOST_REQUIRE_NO_THROW(te::srs::SpatialReferenceSystemCatalog::build(jsonf, catalogf));
+
+  te::srs::SpatialReferenceSystemManager& manager = te::srs::SpatialReferenceSystemManager::getInstance();
+
+  manager.init(catalogf);
+  BOOST_CHECK(manager.getNewUserDefinedSRID() == "100022");
+
+  manager.add("user srs", "+proj=longlat +ellps=WGS84 +no_defs", "", 200000, "USER");
+  BOOST_CHECK(manager.getNewUserDefinedSRID() == "200001");
+
+  const std::size_t size = manager.size();
+  const std::string p4txt = manager.getP4Txt(TE_SRS_SAD69);
+  const std::string wkt = manager.getWkt(TE_SRS_SAD69);
+
+// the lookups run while the descriptions are iterated: the iteration must not change the manager
+  for(int round = 0; round < 10; ++round)
+  {
+    manager.init(catalogf);
+    manager.add("user srs", "+proj=longlat +ellps=WGS84 +no_defs", "", 200000, "USER");
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> failures(0);
+    std::atomic<int> lookups(0);
+
+    boost::thread_group readers;
+
+    for(int i = 0; i < 4; ++i)
+    {
+      readers.create_thread([&]()
+      {
+        while(!stop)
+        {
+          if(manager.getP4Txt(TE_SRS_SAD69) != p4txt ||
+             manager.getWkt(TE_SRS_SAD69) != wkt ||
+             manager.getIdFromP4Txt(p4txt).second != TE_SRS_SAD69 ||
+             manager.getName(200000, "USER") != "user srs")
+            ++failures;
+
+          ++lookups;
+        }
+      });
+    }
+
+    while(lookups < 100)
+      boost::this_thread::yield();
+
+    std::pair<te::srs::SpatialReferenceSystemManager::iterator,
+              te::srs::SpatialReferenceSystemManager::iterator> its = manager.getIterators();
+
+    std::size_t count = 0;
+    bool foundSAD69 = false;
+    bool foundUser = false;
+
+    for(; its.first != its.second; ++its.first)
+    {
+      ++count;
+
+      if(its.first->m_auth_name == "EPSG" && its.first->m_auth_id == TE_SRS_SAD69)
+        foundSAD69 = (its.first->m_p4txt == p4txt);
+      else if(its.first->m_auth_name == "USER" && its.first->m_auth_id == 200000)
+        foundUser = ((*its.first).m_name == "user srs");
+    }
+
+    stop = true;
+    readers.join_all();
+
+    BOOST_CHECK(count == size);
+    BOOST_CHECK(foundSAD69);
+    BOOST_CHECK(foundUser);
+    BOOST_CHECK(failures == 0);
+    BOOST_CHECK(manager.size() == size);
+  }
+
+  manager.clear();
+
+  boost::filesystem::remove(catalogf);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,336 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/statistics/TsStreamingSummary.cpp
+
+  \brief A test suite for the StreamingSummary class and the streaming summary of datasets.
+ */
+
+// TerraLib
+#include <terralib/dataaccess/dataset/DataSetType.h>
+#include <terralib/datatype/SimpleProperty.h>
+#include <terralib/memory/ColumnarDataSet.h>
+#include <terralib/statistics/core/StreamingSummary.h>
+#include <terralib/statistics/core/SummaryFunctions.h>
+
+// Boost
+#include <boost/random/exponential_distribution.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  /*! It creates skewed values: a mix of an exponential and a normal distribution. */
+  std::vector<double> CreateValues(std::size_t n, unsigned int seed)
+  {
+    boost::random::mt19937 gen(seed);
+    boost::random::exponential_distribution<double> exponential(0.01);
+    boost::random::normal_distribution<double> normal(500.0, 20.0);
+
+    std::vector<double> values(n);
+
+    for(std::size_t i = 0; i < n; ++i)
+      values[i] = (i % 4 == 0) ? normal(gen) : exponential(gen);
+
+    return values;
+  }
+
+  /*! It checks the exact statistics of a summary against a two pass computation. */
+  void CheckExact(const te::stat::StreamingSummary& ss, const std::vector<double>& values)
+  {
+    const double n = static_cast<double>(values.size());
+
+    double sum = 0.0;
+
+    for(std::size_t i = 0; i < values.size(); ++i)
+      sum += values[i];
+
+    const double mean = sum / n;
+
+    double m2 = 0.0;
+
+    for(std::size_t i = 0; i < values.size(); ++i)
+      m2 += (values[i] - mean) * (values[i] - mean);
+
+    BOOST_CHECK_EQUAL(ss.getCount(), values.size());
+    BOOST_CHECK_EQUAL(ss.getMinimum(), *std::min_element(values.begin(), values.end()));
+    BOOST_CHECK_EQUAL(ss.getMaximum(), *std::max_element(values.begin(), values.end()));
+    BOOST_CHECK_CLOSE(ss.getSum(), sum, 1e-9);
+    BOOST_CHECK_CLOSE(ss.getMean(), mean, 1e-9);
+    BOOST_CHECK_CLOSE(ss.getVariance(), m2 / (n - 1.0), 1e-6);
+  }
+
+  /*!
+    It checks the estimated quantiles by their rank in the sorted values: the error is bounded
+    by a fraction of the number of values, lower at the tails. Repeated values take all their ranks.
+  */
+  void CheckQuantiles(const te::stat::StreamingSummary& ss, std::vector<double> values)
+  {
+    std::sort(values.begin(), values.end());
+
+    const double n = static_cast<double>(values.size());
+
+    const double q[] = { 0.001, 0.01, 0.05, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999 };
+
+    for(std::size_t i = 0; i < sizeof(q) / sizeof(double); ++i)
+    {
+      const double tolerance = 0.01 * std::max(4.0 * q[i] * (1.0 - q[i]), 0.05);
+
+      double estimate = ss.getQuantile(q[i]);
+
+      double lower = static_cast<double>(std::lower_bound(values.begin(), values.end(), estimate) - values.begin()) / n;
+      double upper = static_cast<double>(std::upper_bound(values.begin(), values.end(), estimate) - values.begin()) / n;
+
+      BOOST_CHECK_MESSAGE(q[i] >= lower - tolerance && q[i] <= upper + tolerance,
+                          "quantile " << q[i] << " estimated at ranks [" << lower << ", " << upper << "]");
+
+      double value = values[static_cast<std::size_t>(q[i] * n)];
+      double rank = ss.getRank(value) / n;
+
+      lower = static_cast<double>(std::lower_bound(values.begin(), values.end(), value) - values.begin()) / n;
+      upper = static_cast<double>(std::upper_bound(values.begin(), values.end(), value) - values.begin()) / n;
+
+      BOOST_CHECK_MESSAGE(rank >= lower - tolerance && rank <= upper + tolerance,
+                          "rank of quantile " << q[i] << " estimated as " << rank);
+    }
+
+    BOOST_CHECK_EQUAL(ss.getQuantile(0.0), values.front());
+    BOOST_CHECK_EQUAL(ss.getQuantile(1.0), values.back());
+  }
+
+  te::mem::ColumnarDataSet* CreateDataSet(const std::vector<double>& values)
+  {
+    te::da::DataSetType dt("values");
+    dt.add(new te::dt::SimpleProperty("dval", te::dt::DOUBLE_TYPE));
+    dt.add(new te::dt::SimpleProperty("ival", te::dt::INT32_TYPE));
+
+    te::mem::ColumnarDataSet* dataset = new te::mem::ColumnarDataSet(&dt);
+
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+      dataset->addItem();
+
+      // every 100th item is null
+      if(i % 100 == 0)
+        continue;
+
+      dataset->setDouble(0, values[i]);
+      dataset->setInt32(1, static_cast<boost::int32_t>(values[i]));
+    }
+
+    return dataset;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( streamingsummary_tests )
+
+BOOST_AUTO_TEST_CASE( exact_statistics_test )
+{
+  std::vector<double> values = CreateValues(100000, 1);
+
+  // a large offset makes the naive sum of squares lose the variance
+  for(std::size_t i = 0; i < values.size(); ++i)
+    values[i] += 1.0e9;
+
+  te::stat::StreamingSummary ss;
+
+  for(std::size_t i = 0; i < values.size(); ++i)
+    ss.add(values[i]);
+
+  ss.addNull();
+
+  CheckExact(ss, values);
+  BOOST_CHECK_EQUAL(ss.getNullCount(), 1);
+
+  te::stat::StreamingSummary empty;
+
+  BOOST_CHECK_EQUAL(empty.getCount(), 0);
+  BOOST_CHECK_EQUAL(empty.getMinimum(), 0.0);
+  BOOST_CHECK_EQUAL(empty.getVariance(), 0.0);
+  BOOST_CHECK_EQUAL(empty.getQuantile(0.5), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( quantile_accuracy_test )
+{
+  const std::vector<double> values = CreateValues(200000, 2);
+
+  te::stat::StreamingSummary ss;
+
+  for(std::size_t i = 0; i < values.size(); ++i)
+    ss.add(values[i]);
+
+  CheckQuantiles(ss, values);
+
+  std::vector<double> breaks;
+  ss.getQuantileBreaks(4, breaks);
+
+  BOOST_REQUIRE_EQUAL(breaks.size(), 5);
+  BOOST_CHECK_EQUAL(breaks.front(), ss.getMinimum());
+  BOOST_CHECK_EQUAL(breaks.back(), ss.getMaximum());
+  BOOST_CHECK_EQUAL(breaks[2], ss.getQuantile(0.5));
+  BOOST_CHECK(std::is_sorted(breaks.begin(), breaks.end()));
+}
+
+BOOST_AUTO_TEST_CASE( mode_capacity_test )
+{
+  te::stat::StreamingSummary ss(TE_STAT_TDIGEST_COMPRESSION, 10);
+
+  for(int i = 0; i < 10; ++i)
+  {
+    for(int j = 0; j <= i % 5; ++j)
+      ss.add(static_cast<double>(i));
+  }
+
+  // the values 4 and 9 repeat five times
+  BOOST_REQUIRE(ss.hasMode());
+
+  std::vector<double> mode = ss.getMode();
+
+  BOOST_REQUIRE_EQUAL(mode.size(), 2);
+  BOOST_CHECK_EQUAL(mode[0], 4.0);
+  BOOST_CHECK_EQUAL(mode[1], 9.0);
+
+  // values that do not repeat have no mode
+  te::stat::StreamingSummary unique(TE_STAT_TDIGEST_COMPRESSION, 10);
+
+  for(int i = 0; i < 5; ++i)
+    unique.add(static_cast<double>(i));
+
+  BOOST_CHECK(unique.hasMode());
+  BOOST_CHECK(unique.getMode().empty());
+
+  // the eleventh distinct value exceeds the capacity
+  ss.add(10.0);
+
+  BOOST_CHECK(!ss.hasMode());
+  BOOST_CHECK(ss.getMode().empty());
+
+  // the merged summaries exceed the capacity together
+  te::stat::StreamingSummary ss1(TE_STAT_TDIGEST_COMPRESSION, 10);
+  te::stat::StreamingSummary ss2(TE_STAT_TDIGEST_COMPRESSION, 10);
+
+  for(int i = 0; i < 6; ++i)
+  {
+    ss1.add(static_cast<double>(i));
+    ss2.add(static_cast<double>(i + 6));
+  }
+
+  BOOST_CHECK(ss1.hasMode());
+  BOOST_CHECK(ss2.hasMode());
+
+  ss1.merge(ss2);
+
+  BOOST_CHECK(!ss1.hasMode());
+}
+
+BOOST_AUTO_TEST_CASE( merge_test )
+{
+  const std::vector<double> values = CreateValues(150000, 3);
+
+  te::stat::StreamingSummary single;
+
+  for(std::size_t i = 0; i < values.size(); ++i)
+    single.add(values[i]);
+
+  // uneven partial summaries, including an empty one
+  const std::size_t limits[] = { 0, 10, 10, 5000, 70000, 150000 };
+
+  te::stat::StreamingSummary merged;
+
+  for(std::size_t p = 0; p + 1 < sizeof(limits) / sizeof(std::size_t); ++p)
+  {
+    te::stat::StreamingSummary partial;
+
+    for(std::size_t i = limits[p]; i < limits[p + 1]; ++i)
+      partial.add(values[i]);
+
+    partial.addNull();
+
+    merged.merge(partial);
+  }
+
+  CheckExact(merged, values);
+  CheckQuantiles(merged, values);
+
+  BOOST_CHECK_EQUAL(merged.getNullCount(), 5);
+  BOOST_CHECK_CLOSE(merged.getMean(), single.getMean(), 1e-9);
+  BOOST_CHECK_CLOSE(merged.getVariance(), single.getVariance(), 1e-9);
+  BOOST_CHECK_CLOSE(merged.getQuantile(0.5), single.getQuantile(0.5), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE( threaded_dataset_test )
+{
+  const std::vector<double> values = CreateValues(200000, 4);
+
+  std::auto_ptr<te::mem::ColumnarDataSet> dataset(CreateDataSet(values));
+
+  std::vector<double> doubles;
+  std::vector<double> ints;
+
+  for(std::size_t i = 0; i < values.size(); ++i)
+  {
+    if(i % 100 == 0)
+      continue;
+
+    doubles.push_back(values[i]);
+    ints.push_back(static_cast<double>(static_cast<boost::int32_t>(values[i])));
+  }
+
+  // the integer values are discrete: their quantiles are compared with a single pass summary
+  te::stat::StreamingSummary single;
+
+  for(std::size_t i = 0; i < ints.size(); ++i)
+    single.add(ints[i]);
+
+  const std::size_t nThreads[] = { 1, 3, 8 };
+
+  for(std::size_t t = 0; t < sizeof(nThreads) / sizeof(std::size_t); ++t)
+  {
+    // the double column is split among the threads, the integer one is read in blocks
+    te::stat::StreamingSummary dss;
+    te::stat::GetNumericStreamingSummary(dataset.get(), "dval", dss, nThreads[t]);
+
+    te::stat::StreamingSummary iss;
+    te::stat::GetNumericStreamingSummary(dataset.get(), "ival", iss, nThreads[t]);
+
+    CheckExact(dss, doubles);
+    CheckQuantiles(dss, doubles);
+    BOOST_CHECK_EQUAL(dss.getNullCount(), 2000);
+
+    CheckExact(iss, ints);
+    BOOST_CHECK_CLOSE(iss.getQuantile(0.25), single.getQuantile(0.25), 1.0);
+    BOOST_CHECK_CLOSE(iss.getQuantile(0.5), single.getQuantile(0.5), 1.0);
+    BOOST_CHECK_CLOSE(iss.getQuantile(0.9), single.getQuantile(0.9), 1.0);
+    BOOST_CHECK_EQUAL(iss.getNullCount(), 2000);
+  }
+
+  te::stat::StreamingSummary ss;
+
+  BOOST_CHECK_THROW(te::stat::GetNumericStreamingSummary(dataset.get(), "unknown", ss), std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
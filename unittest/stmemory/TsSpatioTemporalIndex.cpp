@@ -0,0 +1,255 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file terralib/unittest/stmemory/TsSpatioTemporalIndex.cpp
+
+  \brief A test suite for the spatio-temporal index of the in-memory observation datasets.
+ */
+
+// TerraLib
+#include <terralib/datatype/DateTimeProperty.h>
+#include <terralib/datatype/SimpleProperty.h>
+#include <terralib/datatype/TimeInstant.h>
+#include <terralib/datatype/TimePeriod.h>
+#include <terralib/geometry/Envelope.h>
+#include <terralib/geometry/Point.h>
+#include <terralib/memory/DataSetItem.h>
+#include <terralib/stmemory/DataSet.h>
+#include <terralib/stmemory/SpatioTemporalIndex.h>
+#include <terralib/stmemory/TemporalRange.h>
+
+// Boost
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  const boost::posix_time::ptime sg_start(boost::gregorian::date(2015, 1, 1));
+
+  te::dt::TimeInstant* CreateInstant(int hour)
+  {
+    return new te::dt::TimeInstant(sg_start + boost::posix_time::hours(hour));
+  }
+
+  te::dt::TimePeriod* CreatePeriod(int firstHour, int lastHour)
+  {
+    return new te::dt::TimePeriod(te::dt::TimeInstant(sg_start + boost::posix_time::hours(firstHour)),
+                                  te::dt::TimeInstant(sg_start + boost::posix_time::hours(lastHour)));
+  }
+
+  /*
+    It creates an observation dataset with an identifier, a geometry and the phenomenon time:
+    an instant or, if periods is true, a period given by a begin and an end time.
+    The times are repeated and inserted out of order, so the index partitions are split around equal times.
+  */
+  te::stmem::DataSet* CreateDataSet(std::size_t nitems, bool periods)
+  {
+    std::vector<std::string> pnames;
+    std::vector<int> ptypes;
+
+    pnames.push_back("id");
+    ptypes.push_back(te::dt::INT32_TYPE);
+    pnames.push_back("location");
+    ptypes.push_back(te::dt::GEOMETRY_TYPE);
+    pnames.push_back("begin");
+    ptypes.push_back(te::dt::DATETIME_TYPE);
+
+    if(periods)
+    {
+      pnames.push_back("end");
+      ptypes.push_back(te::dt::DATETIME_TYPE);
+    }
+
+    te::stmem::DataSet* dataset = new te::stmem::DataSet(pnames, ptypes, 2, periods ? 3 : -1, 1);
+
+    for(std::size_t i = 0; i < nitems; ++i)
+    {
+      // a permutation of the items, with 4 observations at each time
+      const int hour = static_cast<int>((i * 7919) % nitems) / 4;
+
+      te::mem::DataSetItem* item = new te::mem::DataSetItem(dataset);
+
+      item->setInt32(0, static_cast<boost::int32_t>(i));
+      item->setGeometry(1, new te::gm::Point(static_cast<double>((i * 37) % 100), static_cast<double>((i * 53) % 100)));
+
+      if(periods)
+      {
+        // consecutive and disjoint periods
+        item->setDateTime(2, CreateInstant(2 * hour));
+        item->setDateTime(3, CreateInstant(2 * hour + 1));
+      }
+      else
+      {
+        item->setDateTime(2, CreateInstant(hour));
+      }
+
+      dataset->add(item);
+    }
+
+    return dataset;
+  }
+
+  std::vector<boost::int32_t> GetIds(te::stmem::DataSet* dataset)
+  {
+    std::vector<boost::int32_t> ids;
+
+    BOOST_REQUIRE(dataset != 0);
+
+    dataset->moveBeforeFirst();
+
+    while(dataset->moveNext())
+      ids.push_back(dataset->getInt32(0));
+
+    std::sort(ids.begin(), ids.end());
+
+    return ids;
+  }
+
+  /*
+    It checks that the combined filter gives the observations of the spatial filter followed
+    by the temporal one.
+  */
+  void CheckFilter(const te::stmem::DataSet& dataset, const te::gm::Envelope& e,
+                   const te::dt::DateTime* dt, te::dt::TemporalRelation tr)
+  {
+    std::auto_ptr<te::stmem::DataSet> spatial(dataset.filter(&e, te::gm::INTERSECTS));
+    std::auto_ptr<te::stmem::DataSet> expected(spatial->filter(dt, tr));
+    std::auto_ptr<te::stmem::DataSet> result(dataset.filter(&e, te::gm::INTERSECTS, dt, tr));
+
+    std::vector<boost::int32_t> expectedIds = GetIds(expected.get());
+    std::vector<boost::int32_t> resultIds = GetIds(result.get());
+
+    BOOST_CHECK_MESSAGE(expectedIds == resultIds, "temporal relation " << tr << ": " << resultIds.size()
+                                                  << " observations instead of " << expectedIds.size());
+  }
+
+  void CheckRelations(const te::stmem::DataSet& dataset, const te::gm::Envelope& e, const te::dt::DateTime* dt)
+  {
+    CheckFilter(dataset, e, dt, te::dt::AFTER);
+    CheckFilter(dataset, e, dt, te::dt::TemporalRelation(te::dt::AFTER | te::dt::EQUALS));
+    CheckFilter(dataset, e, dt, te::dt::BEFORE);
+    CheckFilter(dataset, e, dt, te::dt::TemporalRelation(te::dt::BEFORE | te::dt::EQUALS));
+    CheckFilter(dataset, e, dt, te::dt::EQUALS);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( spatiotemporalindex_tests )
+
+BOOST_AUTO_TEST_CASE( index_search_test )
+{
+  // a small capacity gives many partitions
+  te::stmem::SpatioTemporalIndex<std::size_t> index(16);
+
+  boost::ptr_vector<te::dt::TimeInstant> times;
+  std::vector<te::gm::Envelope> mbrs;
+
+  for(std::size_t i = 0; i < 1000; ++i)
+  {
+    times.push_back(CreateInstant(static_cast<int>((i * 7919) % 1000) / 3));
+    mbrs.push_back(te::gm::Envelope((i * 37) % 100, (i * 53) % 100, (i * 37) % 100 + 2.0, (i * 53) % 100 + 2.0));
+
+    index.insert(mbrs.back(), &times.back(), i);
+  }
+
+  BOOST_CHECK_EQUAL(index.size(), 1000);
+  BOOST_CHECK(index.getNumberOfPartitions() > 1);
+
+  const te::gm::Envelope e(20.0, 10.0, 70.0, 55.0);
+
+  std::auto_ptr<te::dt::TimePeriod> period(CreatePeriod(40, 200));
+
+  std::vector<te::stmem::TemporalRange> ranges;
+  ranges.push_back(te::stmem::TemporalRange());
+  ranges.push_back(te::stmem::TemporalRange(&times[10], te::dt::AFTER));
+  ranges.push_back(te::stmem::TemporalRange(&times[10], te::dt::BEFORE));
+  ranges.push_back(te::stmem::TemporalRange(&times[10], te::dt::TemporalRelation(te::dt::BEFORE | te::dt::EQUALS)));
+  ranges.push_back(te::stmem::TemporalRange(&times[10], te::dt::EQUALS));
+  ranges.push_back(te::stmem::TemporalRange(period.get(), te::dt::DURING));
+
+  for(std::size_t r = 0; r < ranges.size(); ++r)
+  {
+    std::vector<std::size_t> expected;
+
+    for(std::size_t i = 0; i < times.size(); ++i)
+    {
+      if(mbrs[i].intersects(e) && ranges[r].contains(&times[i]))
+        expected.push_back(i);
+    }
+
+    std::vector<std::size_t> report;
+    BOOST_CHECK_EQUAL(index.search(e, ranges[r], report), expected.size());
+
+    std::sort(report.begin(), report.end());
+
+    BOOST_CHECK_MESSAGE(report == expected, "range " << r);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( instant_filter_test )
+{
+  // more observations than a partition holds
+  std::auto_ptr<te::stmem::DataSet> dataset(CreateDataSet(5000, false));
+
+  const te::gm::Envelope e(20.0, 10.0, 70.0, 55.0);
+
+  // a time of the dataset, a time between the dataset ones and times before and after all of them
+  std::auto_ptr<te::dt::TimeInstant> t1(CreateInstant(300));
+  std::auto_ptr<te::dt::TimeInstant> t2(new te::dt::TimeInstant(sg_start + boost::posix_time::minutes(700 * 60 + 30)));
+  std::auto_ptr<te::dt::TimeInstant> t3(CreateInstant(-10));
+  std::auto_ptr<te::dt::TimeInstant> t4(CreateInstant(5000));
+
+  CheckRelations(*dataset, e, t1.get());
+  CheckRelations(*dataset, e, t2.get());
+  CheckRelations(*dataset, e, t3.get());
+  CheckRelations(*dataset, e, t4.get());
+
+  // all the observations intersect the dataset extent
+  CheckRelations(*dataset, *dataset->getExtent(1), t1.get());
+
+  std::auto_ptr<te::dt::TimePeriod> period(CreatePeriod(250, 1100));
+  CheckFilter(*dataset, e, period.get(), te::dt::DURING);
+
+  // an empty spatial window and an unsupported relation
+  CheckFilter(*dataset, te::gm::Envelope(200.0, 200.0, 300.0, 300.0), t1.get(), te::dt::AFTER);
+  CheckFilter(*dataset, e, t1.get(), te::dt::MEETS);
+}
+
+BOOST_AUTO_TEST_CASE( period_filter_test )
+{
+  std::auto_ptr<te::stmem::DataSet> dataset(CreateDataSet(5000, true));
+
+  const te::gm::Envelope e(20.0, 10.0, 70.0, 55.0);
+
+  // a period of the dataset and a longer period overlapping one of them
+  std::auto_ptr<te::dt::TimePeriod> p1(CreatePeriod(600, 601));
+  std::auto_ptr<te::dt::TimePeriod> p2(CreatePeriod(1201, 1204));
+
+  CheckRelations(*dataset, e, p1.get());
+  CheckRelations(*dataset, e, p2.get());
+  CheckRelations(*dataset, *dataset->getExtent(1), p1.get());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+// Unit-Test TerraLib
+#include "TsCascadedUnion.h"
+
+// TerraLib
+#include <terralib/vp/Utils.h>
+
+// STL
+#include <cmath>
+#include <memory>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TsCascadedUnion);
+
+namespace
+{
+  te::gm::Polygon* CreateSquare(double x, double y, double size)
+  {
+    te::gm::LinearRing* ring = new te::gm::LinearRing(5, te::gm::LineStringType);
+    ring->setPoint(0, x, y);
+    ring->setPoint(1, x + size, y);
+    ring->setPoint(2, x + size, y + size);
+    ring->setPoint(3, x, y + size);
+    ring->setPoint(4, x, y);
+
+    te::gm::Polygon* polygon = new te::gm::Polygon(0, te::gm::PolygonType);
+    polygon->push_back(ring);
+
+    return polygon;
+  }
+
+  double GetArea(const te::gm::Geometry* geom)
+  {
+    const te::gm::Surface* surface = dynamic_cast<const te::gm::Surface*>(geom);
+
+    if(surface)
+      return surface->getArea();
+
+    const te::gm::MultiSurface* multiSurface = dynamic_cast<const te::gm::MultiSurface*>(geom);
+
+    if(multiSurface)
+      return multiSurface->getArea();
+
+    return 0.0;
+  }
+
+  std::size_t GetNumPolygons(const te::gm::Geometry* geom)
+  {
+    const te::gm::GeometryCollection* gc = dynamic_cast<const te::gm::GeometryCollection*>(geom);
+
+    return gc ? gc->getNumGeometries() : 1;
+  }
+}
+
+te::gm::Geometry* TsCascadedUnion::getIterativeUnion(const std::vector<te::gm::Geometry*>& geoms)
+{
+  std::auto_ptr<te::gm::Geometry> result(static_cast<te::gm::Geometry*>(geoms[0]->clone()));
+
+  for(std::size_t i = 1; i < geoms.size(); ++i)
+    result.reset(result->Union(geoms[i]));
+
+  return result.release();
+}
+
+void TsCascadedUnion::tcOverlappingPolygons()
+{
+// 7 x 5 squares of size 10 on a step of 8, each one overlaps its neighbours
+  std::vector<te::gm::Geometry*> geoms;
+
+  for(int row = 0; row < 5; ++row)
+  {
+    for(int col = 0; col < 7; ++col)
+      geoms.push_back(CreateSquare(col * 8.0, row * 8.0, 10.0));
+  }
+
+  std::auto_ptr<te::gm::Geometry> iterative(getIterativeUnion(geoms));
+
+  std::auto_ptr<te::gm::Geometry> cascaded(te::vp::GetCascadedUnion(geoms));
+
+  CPPUNIT_ASSERT(geoms.empty());
+  CPPUNIT_ASSERT(cascaded.get() != 0);
+  CPPUNIT_ASSERT_EQUAL(std::size_t(1), GetNumPolygons(cascaded.get()));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL((6 * 8.0 + 10.0) * (4 * 8.0 + 10.0), GetArea(cascaded.get()), 1e-6);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(GetArea(iterative.get()), GetArea(cascaded.get()), 1e-6);
+  CPPUNIT_ASSERT(cascaded->equals(iterative.get()));
+}
+
+void TsCascadedUnion::tcDisjointPolygons()
+{
+// 6 x 6 squares of size 5 on a step of 10, inserted out of spatial order
+  std::vector<te::gm::Geometry*> geoms;
+
+  for(int i = 0; i < 36; ++i)
+  {
+    const int cell = (i * 7) % 36;
+
+    geoms.push_back(CreateSquare((cell % 6) * 10.0, (cell / 6) * 10.0, 5.0));
+  }
+
+  std::auto_ptr<te::gm::Geometry> iterative(getIterativeUnion(geoms));
+
+  std::auto_ptr<te::gm::Geometry> cascaded(te::vp::GetCascadedUnion(geoms));
+
+  CPPUNIT_ASSERT(geoms.empty());
+  CPPUNIT_ASSERT(cascaded.get() != 0);
+  CPPUNIT_ASSERT_EQUAL(std::size_t(36), GetNumPolygons(cascaded.get()));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(36 * 25.0, GetArea(cascaded.get()), 1e-6);
+  CPPUNIT_ASSERT(cascaded->equals(iterative.get()));
+}
+
+void TsCascadedUnion::tcNullAndEmptyInput()
+{
+  std::vector<te::gm::Geometry*> geoms;
+
+  CPPUNIT_ASSERT(te::vp::GetCascadedUnion(geoms) == 0);
+
+  geoms.push_back(0);
+  geoms.push_back(CreateSquare(0.0, 0.0, 10.0));
+  geoms.push_back(0);
+  geoms.push_back(CreateSquare(5.0, 0.0, 10.0));
+  geoms.push_back(CreateSquare(50.0, 50.0, 1.0));
+
+  std::auto_ptr<te::gm::Geometry> cascaded(te::vp::GetCascadedUnion(geoms));
+
+  CPPUNIT_ASSERT(geoms.empty());
+  CPPUNIT_ASSERT(cascaded.get() != 0);
+  CPPUNIT_ASSERT_EQUAL(std::size_t(2), GetNumPolygons(cascaded.get()));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(151.0, GetArea(cascaded.get()), 1e-6);
+
+  geoms.push_back(0);
+
+  CPPUNIT_ASSERT(te::vp::GetCascadedUnion(geoms) == 0);
+  CPPUNIT_ASSERT(geoms.empty());
+}
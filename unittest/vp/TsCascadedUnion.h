@@ -0,0 +1,83 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file TsCascadedUnion.h
+ 
+  \brief Test suite for the cascaded union used by the vp dissolve operations.
+ */
+
+#ifndef __TERRALIB_UNITTEST_VP_INTERNAL_CASCADEDUNION_H
+#define __TERRALIB_UNITTEST_VP_INTERNAL_CASCADEDUNION_H
+
+// STL
+#include <vector>
+
+//TerraLib 
+#include <terralib/geometry.h>
+
+// cppUnit
+#include <cppunit/extensions/HelperMacros.h>
+
+/*!
+  \class TsCascadedUnion
+
+  \brief Test suite for te::vp::GetCascadedUnion.
+
+  This test suite will check the following:
+  <ul>
+  <li>The cascaded union of overlapping polygons is equal to the iterative union;</li>
+  <li>The cascaded union of disjoint polygons keeps every polygon;</li>
+  <li>Null entries and empty vectors are handled and the input vector is cleared.</li>
+  </ul>
+ */
+class TsCascadedUnion : public CPPUNIT_NS::TestFixture
+{
+// It registers this class as a Test Suit
+  CPPUNIT_TEST_SUITE(TsCascadedUnion);
+
+// It registers the class methods as Test Cases belonging to the suit 
+  CPPUNIT_TEST(tcOverlappingPolygons);
+  CPPUNIT_TEST(tcDisjointPolygons);
+  CPPUNIT_TEST(tcNullAndEmptyInput);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  protected:
+
+// Test Cases:
+
+    /*! \brief Test Case: A grid of overlapping squares, compared against the iterative union. */
+    void tcOverlappingPolygons();
+
+    /*! \brief Test Case: Disjoint squares, compared against the iterative union. */
+    void tcDisjointPolygons();
+
+    /*! \brief Test Case: Null entries are skipped and an empty vector gives a null result. */
+    void tcNullAndEmptyInput();
+
+  private:
+
+    /*!
+      \brief It returns the iterative union (one geometry merged at a time) of a clone of the given geometries.
+    */
+    static te::gm::Geometry* getIterativeUnion(const std::vector<te::gm::Geometry*>& geoms);
+};
+
+#endif  // __TERRALIB_UNITTEST_VP_INTERNAL_CASCADEDUNION_H
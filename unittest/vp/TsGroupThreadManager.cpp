@@ -0,0 +1,139 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+// Unit-Test TerraLib
+#include "TsGroupThreadManager.h"
+
+// TerraLib
+#include <terralib/common/progress/TaskProgress.h>
+#include <terralib/datatype/AbstractData.h>
+#include <terralib/memory/DataSetItem.h>
+#include <terralib/vp/GroupThreadManager.h>
+
+// STL
+#include <map>
+#include <string>
+#include <vector>
+
+// Boost
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TsGroupThreadManager);
+
+namespace
+{
+  const std::size_t sm_groupsNumber = 10;
+
+  std::map<std::string, std::vector<int> > CreateGroups()
+  {
+    std::map<std::string, std::vector<int> > groups;
+
+    for(std::size_t i = 0; i < sm_groupsNumber; ++i)
+      groups[boost::lexical_cast<std::string>(i)] = std::vector<int>(1, static_cast<int>(i));
+
+    return groups;
+  }
+
+// Queues sm_groupsNumber outputs, the i-th one holding i null items so the delivery order can be checked.
+  void Produce(te::vp::GroupThreadManager* manager, boost::mutex* mtx, std::size_t* added)
+  {
+    for(std::size_t i = 0; i < sm_groupsNumber; ++i)
+    {
+      std::vector<te::mem::DataSetItem*> group(i, static_cast<te::mem::DataSetItem*>(0));
+
+      manager->addOutput(group);
+
+      boost::lock_guard<boost::mutex> lock(*mtx);
+      ++(*added);
+    }
+  }
+
+  std::size_t GetAdded(boost::mutex& mtx, const std::size_t& added)
+  {
+    boost::lock_guard<boost::mutex> lock(mtx);
+    return added;
+  }
+}
+
+void TsGroupThreadManager::tcBoundedOutputQueue()
+{
+  std::map<std::string, te::dt::AbstractData*> specificParams;
+
+  te::vp::GroupThreadManager manager(CreateGroups(), 0, 0, 0, 0, 0, specificParams, 2);
+
+  boost::mutex mtx;
+  std::size_t added = 0;
+
+  boost::thread producer(boost::bind(&Produce, &manager, &mtx, &added));
+
+// The producer must stop once the queue holds 2 groups
+  boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+
+  CPPUNIT_ASSERT_EQUAL(std::size_t(2), GetAdded(mtx, added));
+
+// Each delivered group frees room for exactly one more
+  std::vector<te::mem::DataSetItem*> output;
+
+  CPPUNIT_ASSERT(manager.getNextOutput(output));
+  CPPUNIT_ASSERT_EQUAL(std::size_t(0), output.size());
+
+  boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+
+  CPPUNIT_ASSERT_EQUAL(std::size_t(3), GetAdded(mtx, added));
+
+  for(std::size_t i = 1; i < sm_groupsNumber; ++i)
+  {
+    CPPUNIT_ASSERT(manager.getNextOutput(output));
+    CPPUNIT_ASSERT_EQUAL(i, output.size());
+  }
+
+  CPPUNIT_ASSERT(!manager.getNextOutput(output));
+
+  producer.join();
+
+  CPPUNIT_ASSERT_EQUAL(sm_groupsNumber, added);
+}
+
+void TsGroupThreadManager::tcUnboundedOutputQueue()
+{
+  std::map<std::string, te::dt::AbstractData*> specificParams;
+
+  te::vp::GroupThreadManager manager(CreateGroups(), 0, 0, 0, 0, 0, specificParams, 0);
+
+  boost::mutex mtx;
+  std::size_t added = 0;
+
+  boost::thread producer(boost::bind(&Produce, &manager, &mtx, &added));
+
+  producer.join();
+
+  CPPUNIT_ASSERT_EQUAL(sm_groupsNumber, added);
+
+  std::vector<te::mem::DataSetItem*> output;
+
+  for(std::size_t i = 0; i < sm_groupsNumber; ++i)
+  {
+    CPPUNIT_ASSERT(manager.getNextOutput(output));
+    CPPUNIT_ASSERT_EQUAL(i, output.size());
+  }
+
+  CPPUNIT_ASSERT(!manager.getNextOutput(output));
+}
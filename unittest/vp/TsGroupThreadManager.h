@@ -0,0 +1,65 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file TsGroupThreadManager.h
+ 
+  \brief Test suite for the GroupThreadManager class.
+ */
+
+#ifndef __TERRALIB_UNITTEST_VP_INTERNAL_GROUPTHREADMANAGER_H
+#define __TERRALIB_UNITTEST_VP_INTERNAL_GROUPTHREADMANAGER_H
+
+// cppUnit
+#include <cppunit/extensions/HelperMacros.h>
+
+/*!
+  \class TsGroupThreadManager
+
+  \brief Test suite for the GroupThreadManager Class.
+
+  This test suite will check the following:
+  <ul>
+  <li>Producers wait while the bounded output queue is full and resume when the save thread takes a group;</li>
+  <li>Every queued group is delivered, in order, before getNextOutput reports the end.</li>
+  </ul>
+ */
+class TsGroupThreadManager : public CPPUNIT_NS::TestFixture
+{
+// It registers this class as a Test Suit
+  CPPUNIT_TEST_SUITE(TsGroupThreadManager);
+
+// It registers the class methods as Test Cases belonging to the suit 
+  CPPUNIT_TEST(tcBoundedOutputQueue);
+  CPPUNIT_TEST(tcUnboundedOutputQueue);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  protected:
+
+// Test Cases:
+
+    /*! \brief Test Case: A producer fills a queue bounded to 2 groups and waits for the consumer. */
+    void tcBoundedOutputQueue();
+
+    /*! \brief Test Case: A zero bound never blocks the producer. */
+    void tcUnboundedOutputQueue();
+};
+
+#endif  // __TERRALIB_UNITTEST_VP_INTERNAL_GROUPTHREADMANAGER_H
@@ -0,0 +1,289 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+// Unit-Test TerraLib
+#include "TsPartitionedOverlay.h"
+
+// TerraLib
+#include <terralib/datatype/SimpleData.h>
+#include <terralib/memory/DataSet.h>
+#include <terralib/memory/DataSetItem.h>
+#include <terralib/memory/DataSource.h>
+#include <terralib/vp/AlgorithmParams.h>
+#include <terralib/vp/Difference.h>
+#include <terralib/vp/InputParams.h>
+#include <terralib/vp/Intersection.h>
+#include <terralib/vp/Union.h>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TsPartitionedOverlay);
+
+namespace
+{
+  /*
+    A memory data source that does not process spatial filters, like the drivers whose spatial
+    queries return no dataset: the partitioned overlay must read the tiles by scanning the layers.
+  */
+  class NonSpatialDataSource : public te::mem::DataSource
+  {
+    public:
+
+      NonSpatialDataSource()
+        : te::mem::DataSource("memory:")
+      {
+      }
+
+      using te::mem::DataSource::getDataSet;
+
+      std::auto_ptr<te::da::DataSet> getDataSet(const std::string& /*name*/,
+                                                const std::string& /*propertyName*/,
+                                                const te::gm::Envelope* /*e*/,
+                                                te::gm::SpatialRelation /*r*/,
+                                                te::common::TraverseType /*travType*/,
+                                                const te::common::AccessPolicy /*accessPolicy*/)
+      {
+        return std::auto_ptr<te::da::DataSet>(0);
+      }
+  };
+
+  te::gm::Polygon* CreateRectangle(double llx, double lly, double urx, double ury)
+  {
+    te::gm::LinearRing* ring = new te::gm::LinearRing(5, te::gm::LineStringType);
+    ring->setPoint(0, llx, lly);
+    ring->setPoint(1, urx, lly);
+    ring->setPoint(2, urx, ury);
+    ring->setPoint(3, llx, ury);
+    ring->setPoint(4, llx, lly);
+
+    te::gm::Polygon* polygon = new te::gm::Polygon(0, te::gm::PolygonType);
+    polygon->push_back(ring);
+
+    return polygon;
+  }
+
+  te::da::DataSetType* CreateDataSetType(const std::string& name)
+  {
+    te::da::DataSetType* dt = new te::da::DataSetType(name);
+
+    dt->add(new te::dt::SimpleProperty(name + "_fid", te::dt::INT32_TYPE));
+
+    te::gm::GeometryProperty* geomProp = new te::gm::GeometryProperty("geom");
+    geomProp->setGeometryType(te::gm::PolygonType);
+    dt->add(geomProp);
+
+    return dt;
+  }
+
+  void AddFeature(te::mem::DataSet* dataSet, int fid, te::gm::Geometry* geom)
+  {
+    te::mem::DataSetItem* item = new te::mem::DataSetItem(dataSet);
+    item->setInt32(0, fid);
+    item->setGeometry(1, geom);
+
+    dataSet->add(item);
+  }
+
+  double GetArea(const te::gm::Geometry* geom)
+  {
+    const te::gm::Surface* surface = dynamic_cast<const te::gm::Surface*>(geom);
+
+    if(surface)
+      return surface->getArea();
+
+    const te::gm::MultiSurface* multiSurface = dynamic_cast<const te::gm::MultiSurface*>(geom);
+
+    if(multiSurface)
+      return multiSurface->getArea();
+
+    return 0.0;
+  }
+}
+
+void TsPartitionedOverlay::setUp()
+{
+  m_inputDataSource.reset(new NonSpatialDataSource);
+  m_inputDataSource->open();
+
+  m_outputDataSource.reset(new te::mem::DataSource("memory:"));
+  m_outputDataSource->open();
+}
+
+void TsPartitionedOverlay::tearDown()
+{
+  m_firstDataSet.reset();
+  m_secondDataSet.reset();
+  m_firstDataSetType.reset();
+  m_secondDataSetType.reset();
+  m_inputDataSource.reset();
+  m_outputDataSource.reset();
+}
+
+void TsPartitionedOverlay::createLayers(const bool& addStrips)
+{
+  m_firstDataSetType.reset(CreateDataSetType("first"));
+  m_secondDataSetType.reset(CreateDataSetType("second"));
+
+  te::mem::DataSet* firstDataSet = new te::mem::DataSet(m_firstDataSetType.get());
+  te::mem::DataSet* secondDataSet = new te::mem::DataSet(m_secondDataSetType.get());
+
+  m_firstDataSet.reset(firstDataSet);
+  m_secondDataSet.reset(secondDataSet);
+
+// 5 x 5 pairs of overlapping 12 x 12 squares on a step of 20: the quadtree
+// split lines (x or y = 49, 24.5, 73.5, ...) cross the pairs of the middle rows and columns.
+  int fid = 0;
+
+  for(int row = 0; row < 5; ++row)
+  {
+    for(int col = 0; col < 5; ++col)
+    {
+      const double x = col * 20.0;
+      const double y = row * 20.0;
+
+      AddFeature(firstDataSet, fid, CreateRectangle(x, y, x + 12.0, y + 12.0));
+      AddFeature(secondDataSet, fid, CreateRectangle(x + 6.0, y + 6.0, x + 18.0, y + 18.0));
+
+      ++fid;
+    }
+  }
+
+// Strips crossing every tile, overlapping the first and the last rows and columns.
+  if(addStrips)
+  {
+    AddFeature(secondDataSet, fid++, CreateRectangle(1.0, 3.0, 97.0, 4.0));
+    AddFeature(secondDataSet, fid++, CreateRectangle(83.0, 1.0, 84.0, 97.0));
+  }
+
+  std::map<std::string, std::string> options;
+
+  m_inputDataSource->createDataSet(static_cast<te::da::DataSetType*>(m_firstDataSetType->clone()), options);
+  m_inputDataSource->add("first", firstDataSet, options);
+
+  m_inputDataSource->createDataSet(static_cast<te::da::DataSetType*>(m_secondDataSetType->clone()), options);
+  m_inputDataSource->add("second", secondDataSet, options);
+}
+
+std::vector<double> TsPartitionedOverlay::getAreas(const std::string& dataSetName)
+{
+  CPPUNIT_ASSERT_MESSAGE("Output dataset not found: " + dataSetName, m_outputDataSource->dataSetExists(dataSetName));
+
+  std::auto_ptr<te::da::DataSet> dataSet = m_outputDataSource->getDataSet(dataSetName);
+
+  std::size_t geomPos = te::da::GetFirstSpatialPropertyPos(dataSet.get());
+
+  std::vector<double> areas;
+
+  while(dataSet->moveNext())
+  {
+    std::auto_ptr<te::gm::Geometry> geom = dataSet->getGeometry(geomPos);
+
+    areas.push_back(GetArea(geom.get()));
+  }
+
+  std::sort(areas.begin(), areas.end());
+
+  return areas;
+}
+
+void TsPartitionedOverlay::checkOperation(te::vp::Algorithm& memoryAlgorithm, te::vp::Algorithm& partitionedAlgorithm, const std::string& name)
+{
+  std::vector<te::vp::InputParams> inputParams(2);
+
+  inputParams[0].m_inputDataSource = m_inputDataSource;
+  inputParams[0].m_inputDataSetType = m_firstDataSetType.get();
+  inputParams[0].m_inputDataSet = m_firstDataSet.get();
+  inputParams[0].m_inputDataSetName = "first";
+
+  inputParams[1].m_inputDataSource = m_inputDataSource;
+  inputParams[1].m_inputDataSetType = m_secondDataSetType.get();
+  inputParams[1].m_inputDataSet = m_secondDataSet.get();
+  inputParams[1].m_inputDataSetName = "second";
+
+// In memory
+  std::map<std::string, te::dt::AbstractData*> memoryParams;
+
+  te::vp::AlgorithmParams memoryAlgorithmParams;
+  memoryAlgorithmParams.setInputParams(inputParams);
+  memoryAlgorithmParams.setOutputDataSource(m_outputDataSource);
+  memoryAlgorithmParams.setOutputDataSetName(name + "_memory");
+  memoryAlgorithmParams.setSpecificParams(memoryParams);
+
+  CPPUNIT_ASSERT(memoryAlgorithm.executeMemory(&memoryAlgorithmParams));
+
+// Partitioned, in tiles of at most 2 features
+  te::dt::Boolean partitioned(true);
+  te::dt::Int32 maxFeatures(2);
+
+  std::map<std::string, te::dt::AbstractData*> partitionedParams;
+  partitionedParams["PARTITIONED"] = &partitioned;
+  partitionedParams["PARTITION_MAX_FEATURES"] = &maxFeatures;
+
+  te::vp::AlgorithmParams partitionedAlgorithmParams;
+  partitionedAlgorithmParams.setInputParams(inputParams);
+  partitionedAlgorithmParams.setOutputDataSource(m_outputDataSource);
+  partitionedAlgorithmParams.setOutputDataSetName(name + "_partitioned");
+  partitionedAlgorithmParams.setSpecificParams(partitionedParams);
+
+  CPPUNIT_ASSERT(partitionedAlgorithm.executeMemory(&partitionedAlgorithmParams));
+
+// A duplicated or split piece changes the number of features or their areas
+  std::vector<double> memoryAreas = getAreas(name + "_memory");
+  std::vector<double> partitionedAreas = getAreas(name + "_partitioned");
+
+  CPPUNIT_ASSERT(!memoryAreas.empty());
+  CPPUNIT_ASSERT_EQUAL(memoryAreas.size(), partitionedAreas.size());
+
+  for(std::size_t i = 0; i < memoryAreas.size(); ++i)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(memoryAreas[i], partitionedAreas[i], 1e-6);
+}
+
+void TsPartitionedOverlay::tcIntersection()
+{
+  createLayers(true);
+
+  te::vp::Intersection memoryIntersection;
+  te::vp::Intersection partitionedIntersection;
+
+  checkOperation(memoryIntersection, partitionedIntersection, "intersection");
+}
+
+void TsPartitionedOverlay::tcDifference()
+{
+  createLayers(true);
+
+  te::vp::Difference memoryDifference;
+  te::vp::Difference partitionedDifference;
+
+  checkOperation(memoryDifference, partitionedDifference, "difference");
+}
+
+void TsPartitionedOverlay::tcUnion()
+{
+// The in-memory union only handles pairs of overlapping features, so each feature overlaps exactly one other.
+  createLayers(false);
+
+  te::vp::Union memoryUnion;
+  te::vp::Union partitionedUnion;
+
+  checkOperation(memoryUnion, partitionedUnion, "union");
+}
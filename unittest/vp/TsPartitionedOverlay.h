@@ -0,0 +1,121 @@
+/*  Copyright (C) 2008 National Institute For Space Research (INPE) - Brazil.
+
+    This file is part of the TerraLib - a Framework for building GIS enabled applications.
+
+    TerraLib is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    TerraLib is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with TerraLib. See COPYING. If not, write to
+    TerraLib Team at <terralib-team@terralib.org>.
+ */
+
+/*!
+  \file TsPartitionedOverlay.h
+ 
+  \brief Test suite for the partitioned (out-of-core) overlay.
+ */
+
+#ifndef __TERRALIB_UNITTEST_VP_INTERNAL_PARTITIONEDOVERLAY_H
+#define __TERRALIB_UNITTEST_VP_INTERNAL_PARTITIONEDOVERLAY_H
+
+// STL
+#include <string>
+#include <vector>
+
+//TerraLib 
+#include <terralib/dataaccess.h>
+#include <terralib/geometry.h>
+#include <terralib/vp/Algorithm.h>
+
+// cppUnit
+#include <cppunit/extensions/HelperMacros.h>
+
+/*!
+  \class TsPartitionedOverlay
+
+  \brief Test suite for the PARTITIONED execution of the overlay operations.
+
+  The same synthetic layers are processed in memory and partitioned in tiles
+  of at most two features, and both outputs must hold the same pieces. The
+  layers are laid out so the quadtree split lines cross several features and
+  some features span the whole extent, so the pieces crossing the tile borders
+  must be saved once and whole (reference vertex ownership). The input data
+  source does not process spatial filters, so the tiles are read by scanning
+  the layers.
+
+  This test suite will check the following:
+  <ul>
+  <li>Intersection;</li>
+  <li>Difference;</li>
+  <li>Union.</li>
+  </ul>
+ */
+class TsPartitionedOverlay : public CPPUNIT_NS::TestFixture
+{
+// It registers this class as a Test Suit
+  CPPUNIT_TEST_SUITE(TsPartitionedOverlay);
+
+// It registers the class methods as Test Cases belonging to the suit 
+  CPPUNIT_TEST(tcIntersection);
+  CPPUNIT_TEST(tcDifference);
+  CPPUNIT_TEST(tcUnion);
+
+  CPPUNIT_TEST_SUITE_END();
+  
+  public:
+
+// It sets up context before running the test.
+    void setUp();
+
+// It cleann up after the test run.
+    void tearDown();
+
+  protected:
+
+// Test Cases:
+
+    /*! \brief Test Case: Partitioned intersection against the in-memory one, with strips crossing all the tiles. */
+    void tcIntersection();
+
+    /*! \brief Test Case: Partitioned difference against the in-memory one, with strips crossing all the tiles. */
+    void tcDifference();
+
+    /*! \brief Test Case: Partitioned union against the in-memory one, on one-to-one overlapping pairs. */
+    void tcUnion();
+
+  private:
+
+    /*!
+      \brief It creates the input layers in the input data source.
+
+      \param addStrips If true, two strips crossing the whole extent are added to the second layer.
+    */
+    void createLayers(const bool& addStrips);
+
+    /*!
+      \brief It runs the operation in memory and partitioned, checking that both outputs hold the same pieces.
+    */
+    void checkOperation(te::vp::Algorithm& memoryAlgorithm, te::vp::Algorithm& partitionedAlgorithm, const std::string& name);
+
+    /*!
+      \brief It returns the sorted areas of the features of an output dataset.
+    */
+    std::vector<double> getAreas(const std::string& dataSetName);
+
+    te::da::DataSourcePtr m_inputDataSource;
+    te::da::DataSourcePtr m_outputDataSource;
+    std::auto_ptr<te::da::DataSetType> m_firstDataSetType;
+    std::auto_ptr<te::da::DataSetType> m_secondDataSetType;
+    std::auto_ptr<te::da::DataSet> m_firstDataSet;
+    std::auto_ptr<te::da::DataSet> m_secondDataSet;
+};
+
+#endif  // __TERRALIB_UNITTEST_VP_INTERNAL_PARTITIONEDOVERLAY_H